@@ -0,0 +1,129 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   apps/benchmark/performance/CompactInteractionGraph.bench.hh
+///
+/// @brief  Redesigns design_in.pdb once for each storage type of the precomputed interaction
+/// graph's two-body energies (-packing:ig_edge_storage), reporting for each the graph's memory,
+/// the time to fill it and to anneal on it, and how much of the sequence designed with 32-bit
+/// floats the compact storage reproduces.
+
+#include <apps/benchmark/performance/performance_benchmark.hh>
+
+#include <core/conformation/Residue.hh>
+#include <core/import_pose/import_pose.hh>
+#include <core/pack/interaction_graph/InteractionGraphBase.hh>
+#include <core/pack/interaction_graph/InteractionGraphFactory.hh>
+#include <core/pack/pack_rotamers.hh>
+#include <core/pack/packer_neighbors.hh>
+#include <core/pack/rotamer_set/RotamerSets.hh>
+#include <core/pack/task/PackerTask.hh>
+#include <core/pack/task/TaskFactory.hh>
+#include <core/pose/Pose.hh>
+#include <core/scoring/ScoreFunction.hh>
+#include <core/scoring/ScoreFunctionFactory.hh>
+
+#include <numeric/random/random.hh>
+
+#include <utility/graph/Graph.hh>
+#include <utility/vector0.hh>
+#include <utility/vector1.hh>
+
+#include <ObjexxFCL/FArray1D.hh>
+
+class CompactInteractionGraphBenchmark : public PerformanceBenchmark
+{
+public:
+	CompactInteractionGraphBenchmark( std::string name ) : PerformanceBenchmark( name ) {}
+
+	virtual void setUp() {
+		core::import_pose::pose_from_file( start_pose_, "design_in.pdb", core::import_pose::PDB_file );
+		scorefxn_ = core::scoring::get_score_function();
+		(*scorefxn_)( start_pose_ );
+		task_ = core::pack::task::TaskFactory::create_packer_task( start_pose_ );
+	}
+
+	virtual void run( core::Real scaleFactor ) {
+		int reps( 1 * scaleFactor );
+		if ( reps == 0 ) reps = 1;
+		for ( int i = 0; i < reps; ++i ) {
+			std::string float_sequence;
+			for ( std::string const storage : { "float", "half", "fixed16", "fixed8" } ) {
+				std::string const sequence( design( storage ) );
+				if ( storage == std::string( "float" ) ) float_sequence = sequence;
+				set_metric( "recovery_native_" + storage, recovery( sequence, start_pose_.sequence() ) );
+				set_metric( "recovery_float_" + storage, recovery( sequence, float_sequence ) );
+			}
+		}
+	}
+
+	virtual void tearDown() {}
+
+private:
+	/// @brief Pack with the given edge storage, recording the phase times and the graph's memory;
+	/// returns the designed sequence
+	std::string design( std::string const & storage ) {
+		using namespace core::pack;
+
+		core::pose::Pose pose( start_pose_ );
+		task::PackerTaskOP task( task_->clone() );
+		task->set_ig_edge_storage( storage, 10.0 );
+
+		rotamer_set::RotamerSetsOP rotsets( new rotamer_set::RotamerSets );
+		pose.update_residue_neighbors();
+		scorefxn_->setup_for_packing( pose, task->repacking_residues(), task->designing_residues() );
+		utility::graph::GraphOP packer_graph = create_packer_graph( pose, *scorefxn_, task );
+		rotsets->set_task( task );
+		rotsets->initialize_pose_for_rotsets_creation( pose );
+		rotsets->build_rotamers( pose, *scorefxn_, packer_graph );
+		scorefxn_->setup_for_packing_with_rotsets( pose, rotsets );
+		rotsets->prepare_sets_for_packing( pose, *scorefxn_ );
+
+		interaction_graph::AnnealableGraphBaseOP ig;
+		{
+			PhaseTimer timer( *this, "ig_fill_" + storage );
+			ig = interaction_graph::InteractionGraphFactory::create_and_initialize_annealing_graph(
+				*task, *rotsets, pose, *scorefxn_, packer_graph );
+		}
+		interaction_graph::InteractionGraphBaseOP pig( utility::pointer::dynamic_pointer_cast< interaction_graph::InteractionGraphBase >( ig ) );
+		if ( pig ) set_metric( "ig_bytes_" + storage, pig->getTotalMemoryUsage() );
+
+		// Every storage type anneals with the same random numbers
+		numeric::random::rg().set_seed( "mt19937", 1000 );
+		ObjexxFCL::FArray1D_int best_rotamers( pose.size(), 0 );
+		core::PackerEnergy best_energy( 0 );
+		{
+			PhaseTimer timer( *this, "annealing_" + storage );
+			pack_rotamers_run( pose, task, rotsets, ig, utility::vector0< int >(), best_rotamers, best_energy );
+		}
+
+		std::string sequence( start_pose_.sequence() );
+		for ( core::Size ii = 1; ii <= pose.size(); ++ii ) {
+			if ( best_rotamers( ii ) > 0 ) sequence[ ii - 1 ] = rotsets->rotamer( best_rotamers( ii ) )->name1();
+		}
+		return sequence;
+	}
+
+	/// @brief The fraction of positions at which two sequences agree
+	static double recovery( std::string const & sequence, std::string const & reference ) {
+		if ( sequence.empty() || sequence.size() != reference.size() ) return 0.0;
+		core::Size n_same( 0 );
+		for ( core::Size ii = 0; ii < sequence.size(); ++ii ) {
+			if ( sequence[ ii ] == reference[ ii ] ) ++n_same;
+		}
+		return double( n_same ) / sequence.size();
+	}
+
+private:
+	core::pose::Pose start_pose_;
+	core::scoring::ScoreFunctionOP scorefxn_;
+	core::pack::task::PackerTaskOP task_;
+};
+
+CompactInteractionGraphBenchmark CompactInteractionGraph_( "core.pack.interaction_graph.edge_storage_design" );
@@ -0,0 +1,228 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   apps/benchmark/performance/Kernels.bench.hh
+///
+/// @brief  Micro-benchmarks for the hot kernels of scoring and packing, and phase-level
+/// benchmarks of a score call and of a repack, so that a regression in a whole-protocol
+/// benchmark can be traced to the kernel or phase responsible.
+
+#include <apps/benchmark/performance/performance_benchmark.hh>
+
+#include <core/conformation/Residue.hh>
+#include <core/import_pose/import_pose.hh>
+#include <core/pack/interaction_graph/AnnealableGraphBase.hh>
+#include <core/pack/interaction_graph/InteractionGraphFactory.hh>
+#include <core/pack/pack_rotamers.hh>
+#include <core/pack/packer_neighbors.hh>
+#include <core/pack/dunbrack/RotamerLibraryScratchSpace.hh>
+#include <core/pack/rotamer_set/RotamerSets.hh>
+#include <core/pack/rotamers/SingleResidueRotamerLibrary.hh>
+#include <core/pack/rotamers/SingleResidueRotamerLibraryFactory.hh>
+#include <core/pack/task/PackerTask.hh>
+#include <core/pack/task/TaskFactory.hh>
+#include <core/pose/Pose.hh>
+#include <core/scoring/Energies.hh>
+#include <core/scoring/EnergyGraph.hh>
+#include <core/scoring/ScoreFunction.hh>
+#include <core/scoring/ScoreFunctionFactory.hh>
+
+#include <utility/graph/Graph.hh>
+#include <utility/vector0.hh>
+#include <utility/vector1.hh>
+
+#include <ObjexxFCL/FArray1D.hh>
+
+#include <utility>
+
+/// Evaluates the two-body energy of one score term over every neighboring residue pair of
+/// test_in.pdb, bypassing the energy graph, so that only the pair kernel is timed.
+class PairKernelBenchmark : public PerformanceBenchmark
+{
+public:
+	PairKernelBenchmark( std::string name, core::scoring::ScoreType score_type, core::Size base_scale_factor ) :
+		PerformanceBenchmark( name ),
+		score_type_( score_type ),
+		base_scale_factor_( base_scale_factor )
+	{}
+
+	virtual void setUp() {
+		core::import_pose::pose_from_file( pose_, "test_in.pdb", core::import_pose::PDB_file );
+		scorefxn_ = core::scoring::ScoreFunctionOP( new core::scoring::ScoreFunction );
+		scorefxn_->set_weight( score_type_, 1.0 );
+		(*scorefxn_)( pose_ ); // builds the neighbor graph and whatever per-residue data the term caches
+
+		pairs_.clear();
+		core::scoring::EnergyGraph const & energy_graph( pose_.energies().energy_graph() );
+		for ( core::Size ii = 1; ii <= pose_.size(); ++ii ) {
+			for ( utility::graph::Node::EdgeListConstIter
+					iter = energy_graph.get_node( ii )->const_upper_edge_list_begin(),
+					iter_end = energy_graph.get_node( ii )->const_upper_edge_list_end();
+					iter != iter_end; ++iter ) {
+				pairs_.push_back( std::make_pair( ii, (*iter)->get_second_node_ind() ) );
+			}
+		}
+	}
+
+	virtual void run( core::Real scaleFactor ) {
+		core::scoring::EnergyMap emap;
+		for ( int i = 0; i < base_scale_factor_ * scaleFactor; ++i ) {
+			for ( auto const & pair : pairs_ ) {
+				core::conformation::Residue const & rsd1( pose_.residue( pair.first ) );
+				core::conformation::Residue const & rsd2( pose_.residue( pair.second ) );
+				scorefxn_->eval_ci_2b( rsd1, rsd2, pose_, emap );
+				scorefxn_->eval_cd_2b( rsd1, rsd2, pose_, emap );
+			}
+		}
+	}
+
+	virtual void tearDown() {}
+
+private:
+	core::scoring::ScoreType score_type_;
+	core::Size base_scale_factor_;
+	core::pose::Pose pose_;
+	core::scoring::ScoreFunctionOP scorefxn_;
+	utility::vector1< std::pair< core::Size, core::Size > > pairs_;
+};
+
+/// Looks up the Dunbrack energy of every residue of test_in.pdb.
+class DunbrackLookupBenchmark : public PerformanceBenchmark
+{
+public:
+	DunbrackLookupBenchmark( std::string name ) : PerformanceBenchmark( name ), total_energy_( 0 ) {}
+
+	virtual void setUp() {
+		core::import_pose::pose_from_file( pose_, "test_in.pdb", core::import_pose::PDB_file );
+	}
+
+	virtual void run( core::Real scaleFactor ) {
+		using namespace core::pack::rotamers;
+		core::pack::dunbrack::RotamerLibraryScratchSpace scratch;
+		for ( int i = 0; i < 200 * scaleFactor; ++i ) {
+			for ( core::Size ii = 1; ii <= pose_.size(); ++ii ) {
+				core::conformation::Residue const & rsd( pose_.residue( ii ) );
+				SingleResidueRotamerLibraryCOP library( SingleResidueRotamerLibraryFactory::get_instance()->get( rsd.type() ) );
+				if ( library ) total_energy_ += library->rotamer_energy( rsd, pose_, scratch );
+			}
+		}
+	}
+
+	virtual void tearDown() {}
+
+private:
+	core::pose::Pose pose_;
+	core::Real total_energy_; ///< accumulated so that the lookups can't be optimized away
+};
+
+/// Perturbs a backbone torsion and a side chain and rescores, timing separately the AtomTree
+/// refold, the neighbor update, and the energy evaluation of each score call.
+class ScorePhasesBenchmark : public PerformanceBenchmark
+{
+public:
+	ScorePhasesBenchmark( std::string name ) : PerformanceBenchmark( name ) {}
+
+	virtual void setUp() {
+		core::import_pose::pose_from_file( pose_, "test_in.pdb", core::import_pose::PDB_file );
+		scorefxn_ = core::scoring::get_score_function();
+		(*scorefxn_)( pose_ );
+	}
+
+	virtual void run( core::Real scaleFactor ) {
+		core::Size const nres( pose_.size() );
+		for ( int i = 0; i < 100 * scaleFactor; ++i ) {
+			core::Size const bb_pos( 2 + ( 7 * i ) % ( nres - 2 ) );
+			core::Size const sc_pos( 1 + ( 13 * i ) % nres );
+			pose_.set_phi( bb_pos, pose_.phi( bb_pos ) + ( i % 2 ? 3.0 : -3.0 ) );
+			if ( pose_.residue_type( sc_pos ).nchi() > 0 ) {
+				pose_.set_chi( 1, sc_pos, pose_.chi( 1, sc_pos ) + ( i % 2 ? 15.0 : -15.0 ) );
+			}
+			{
+				PhaseTimer timer( *this, "refold" );
+				pose_.residue( nres ).xyz( 1 ); // forces the coordinate update
+			}
+			{
+				PhaseTimer timer( *this, "neighbors" );
+				pose_.update_residue_neighbors();
+			}
+			{
+				PhaseTimer timer( *this, "energies" );
+				(*scorefxn_)( pose_ );
+			}
+		}
+	}
+
+	virtual void tearDown() {}
+
+private:
+	core::pose::Pose pose_;
+	core::scoring::ScoreFunctionOP scorefxn_;
+};
+
+/// Repacks test_in.pdb, timing separately rotamer building, the interaction-graph energy
+/// precalculation, and the simulated-annealing loop.
+class PackerPhasesBenchmark : public PerformanceBenchmark
+{
+public:
+	PackerPhasesBenchmark( std::string name ) : PerformanceBenchmark( name ) {}
+
+	virtual void setUp() {
+		core::import_pose::pose_from_file( start_pose_, "test_in.pdb", core::import_pose::PDB_file );
+		scorefxn_ = core::scoring::get_score_function();
+		(*scorefxn_)( start_pose_ );
+		task_ = core::pack::task::TaskFactory::create_packer_task( start_pose_ );
+		task_->restrict_to_repacking();
+	}
+
+	virtual void run( core::Real scaleFactor ) {
+		using namespace core::pack;
+		for ( int i = 0; i < 1 * scaleFactor; ++i ) {
+			core::pose::Pose pose( start_pose_ );
+			rotamer_set::RotamerSetsOP rotsets( new rotamer_set::RotamerSets );
+			utility::graph::GraphOP packer_graph;
+			{
+				PhaseTimer timer( *this, "rotamer_building" );
+				pose.update_residue_neighbors();
+				scorefxn_->setup_for_packing( pose, task_->repacking_residues(), task_->designing_residues() );
+				packer_graph = create_packer_graph( pose, *scorefxn_, task_ );
+				rotsets->set_task( task_ );
+				rotsets->initialize_pose_for_rotsets_creation( pose );
+				rotsets->build_rotamers( pose, *scorefxn_, packer_graph );
+				scorefxn_->setup_for_packing_with_rotsets( pose, rotsets );
+				rotsets->prepare_sets_for_packing( pose, *scorefxn_ );
+			}
+			interaction_graph::AnnealableGraphBaseOP ig;
+			{
+				PhaseTimer timer( *this, "ig_fill" );
+				ig = interaction_graph::InteractionGraphFactory::create_and_initialize_annealing_graph(
+					*task_, *rotsets, pose, *scorefxn_, packer_graph );
+			}
+			{
+				PhaseTimer timer( *this, "annealing" );
+				ObjexxFCL::FArray1D_int best_rotamers( pose.size() );
+				core::PackerEnergy best_energy( 0 );
+				pack_rotamers_run( pose, task_, rotsets, ig, utility::vector0< int >(), best_rotamers, best_energy );
+			}
+		}
+	}
+
+	virtual void tearDown() {}
+
+private:
+	core::pose::Pose start_pose_;
+	core::scoring::ScoreFunctionOP scorefxn_;
+	core::pack::task::PackerTaskOP task_;
+};
+
+PairKernelBenchmark EtablePairKernel_( "core.scoring.kernel.etable_pair_100x", core::scoring::fa_atr, 100 );
+PairKernelBenchmark HBondPairKernel_( "core.scoring.kernel.hbond_pair_100x", core::scoring::hbond_sc, 100 );
+PairKernelBenchmark LKBallPairKernel_( "core.scoring.kernel.lk_ball_pair_10x", core::scoring::lk_ball_wtd, 10 );
+DunbrackLookupBenchmark DunbrackLookup_( "core.pack.dunbrack.rotamer_energy_200x" );
+ScorePhasesBenchmark ScorePhases_( "core.scoring.phases.refold_neighbors_energies" );
+PackerPhasesBenchmark PackerPhases_( "core.pack.phases.rotamers_ig_annealing" );
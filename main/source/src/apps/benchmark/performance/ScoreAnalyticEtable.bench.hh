@@ -15,6 +15,9 @@
 #include <apps/benchmark/performance/ScoreEach.bench.hh>
 #include <core/scoring/methods/EnergyMethodOptions.hh>
 
+#include <basic/options/option.hh>
+#include <basic/options/keys/score.OptionKeys.gen.hh>
+
 class ScoreAnalyticEtableBenchmark : public ScoreEachBenchmark
 {
 public:
@@ -41,9 +44,37 @@ public:
 	}
 };
 
+/// @brief The same benchmark with the structure-of-arrays residue-pair kernel turned off
+/// (-score:etable_soa_kernel false), for comparison against the default timings above.
+class ScoreAnalyticEtableScalarBenchmark : public ScoreAnalyticEtableBenchmark
+{
+public:
+
+	ScoreAnalyticEtableScalarBenchmark(
+		std::string name,
+		core::scoring::ScoreType score_type,
+		core::Size base_scale_factor
+	) :
+		ScoreAnalyticEtableBenchmark(name, score_type, base_scale_factor)
+	{}
+
+	virtual void setUp() {
+		using namespace basic::options;
+		bool const setting( option[ OptionKeys::score::etable_soa_kernel ]() );
+		// The evaluators read this flag when the energy method is constructed in setUp().
+		option[ OptionKeys::score::etable_soa_kernel ].value( false );
+		ScoreAnalyticEtableBenchmark::setUp();
+		option[ OptionKeys::score::etable_soa_kernel ].value( setting );
+	}
+};
+
 ScoreAnalyticEtableBenchmark Score_analytic_etable_fa_atr_("core.scoring.Score_analytic_etable_100x_fa_atr",fa_atr,100);
 ScoreAnalyticEtableBenchmark Score_analytic_etable_fa_rep_("core.scoring.Score_analytic_etable_100x_fa_rep",fa_rep,100);
 ScoreAnalyticEtableBenchmark Score_analytic_etable_fa_sol_("core.scoring.Score_analytic_etable_100x_fa_sol",fa_sol,100);
 ScoreAnalyticEtableBenchmark Score_analytic_etable_fa_intra_atr_("core.scoring.Score_analytic_etable_100x_fa_intra_atr",fa_intra_atr,100);
 ScoreAnalyticEtableBenchmark Score_analytic_etable_fa_intra_rep_("core.scoring.Score_analytic_etable_100x_fa_intra_rep",fa_intra_rep,100);
 ScoreAnalyticEtableBenchmark Score_analytic_etable_fa_intra_sol_("core.scoring.Score_analytic_etable_100x_fa_intra_sol",fa_intra_sol,100);
+
+ScoreAnalyticEtableScalarBenchmark Score_analytic_etable_scalar_fa_atr_("core.scoring.Score_analytic_etable_scalar_100x_fa_atr",fa_atr,100);
+ScoreAnalyticEtableScalarBenchmark Score_analytic_etable_scalar_fa_rep_("core.scoring.Score_analytic_etable_scalar_100x_fa_rep",fa_rep,100);
+ScoreAnalyticEtableScalarBenchmark Score_analytic_etable_scalar_fa_sol_("core.scoring.Score_analytic_etable_scalar_100x_fa_sol",fa_sol,100);
@@ -6,54 +6,176 @@
 # (c) For more information, see http://www.rosettacommons.org. Questions about this can be
 # (c) addressed to University of Washington CoMotion, email: license@uw.edu.
 
-def load_files():
-	import json
-	new=None
-	from os.path import exists
-	try:
-		new = json.load(  open('_performance_') )
-	except:
-		print 'Missing "_performance_" file'
-	ref=None
+"""Compare two performance_benchmark reports (_performance_ and _old_performance_).
+
+For each benchmark the time per cycle is compared; when both reports carry per-cycle
+statistics, Welch's t-test decides whether the difference is larger than the run-to-run
+noise.  A benchmark regresses when it is slower by more than --threshold and, if it can
+be tested, significant at --alpha.  Per-phase times are compared the same way, without
+the test.  Results go to runtime_diffs.txt (table) and runtime_diffs.json; with --gate the
+exit code is 1 if anything regressed.
+"""
+
+from __future__ import print_function
+
+import argparse
+import json
+import math
+import sys
+
+
+def load(filename):
 	try:
-		ref = json.load( open('_old_performance_') )
-	except:
-		print 'Missing "old_performance_" file'
-	return new, ref
-
-
-def compare_times():
-	new, ref = load_files()
-	runtimes_compare = open('runtime_diffs.txt', 'w')
-	format_string = '%7.1f %7.1f %7.1f %6.2f %s\n'
-	runtimes_compare.write('%7s %7s %7s %6s %s\n' % ("NEW", "REF", "DIFF", "D/R", "TEST"))
-
-	from math import isnan, isinf
-	diffs=[]
-	new_values=[]
-	ref_values=[]
-	for key in set(new.keys() + ref.keys()):
-		if key in new and key in ref:
-			n = new[key]
-			r = ref[key]
-			if isnan(n+r) or isinf(n+r):
-				continue # cannot compare
-			diff = n -r
-			runtimes_compare.write( format_string % (n, r, diff, diff/r, key) )
-			diffs.append(diff)
-			new_values.append(n)
-			ref_values.append(r)
-	new_sum = sum(new_values)
-	ref_sum = sum(ref_values)
-	new_avg = new_sum/float(len(new_values))
-	ref_avg = ref_sum/float(len(ref_values))
-
-	runtimes_compare.write( format_string % (new_sum, ref_sum, new_sum - ref_sum, (new_sum-ref_sum)/ref_sum, 'TOTAL' ))
-	runtimes_compare.write( format_string % (new_avg, ref_avg, new_avg - ref_avg, (new_avg-ref_avg)/ref_avg, 'MEAN' ))
+		with open(filename) as f:
+			return json.load(f)
+	except (IOError, ValueError) as e:
+		print('Unable to read "%s": %s' % (filename, e))
+		return None
+
+
+def normalize(entry):
+	"""Reduce any of the report formats to {'time': per-cycle time, 'stats': (mean, sd, n) or None, 'phases': {}}.
+
+	Raises ValueError for the oldest format, a bare total run time, which has no cycle count.
+	"""
+	if isinstance(entry, (int, float)):  # oldest format: a bare number
+		raise ValueError('total run time without a cycle count (oldest report format); regenerate the report')
+	if isinstance(entry, list):  # old single-benchmark format: [cycles, run_time]
+		cycles, run_time = entry
+		return {'time': run_time / cycles if cycles else float('nan'), 'stats': None, 'phases': {}}
+	cycles = entry.get('cycles', 0)
+	time = entry['run_time'] / cycles if cycles else float('nan')
+	stats = None
+	ct = entry.get('cycle_time')
+	if ct and ct.get('n', 0) > 1:
+		time = ct['mean']
+		stats = (ct['mean'], ct['stddev'], ct['n'])
+	phases = {}
+	for name, seconds in entry.get('phases', {}).items():
+		phases[name] = seconds / cycles if cycles else float('nan')
+	return {'time': time, 'stats': stats, 'phases': phases}
+
+
+def betacf(a, b, x):
+	"""Continued fraction for the regularized incomplete beta function (Lentz's method)."""
+	tiny = 1e-300
+	qab, qap, qam = a + b, a + 1.0, a - 1.0
+	c, d = 1.0, 1.0 - qab * x / qap
+	d = 1.0 / (d if abs(d) > tiny else tiny)
+	h = d
+	for m in range(1, 300):
+		m2 = 2 * m
+		aa = m * (b - m) * x / ((qam + m2) * (a + m2))
+		d = 1.0 + aa * d
+		d = 1.0 / (d if abs(d) > tiny else tiny)
+		c = 1.0 + aa / c
+		c = c if abs(c) > tiny else tiny
+		h *= d * c
+		aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2))
+		d = 1.0 + aa * d
+		d = 1.0 / (d if abs(d) > tiny else tiny)
+		c = 1.0 + aa / c
+		c = c if abs(c) > tiny else tiny
+		delta = d * c
+		h *= delta
+		if abs(delta - 1.0) < 1e-12:
+			break
+	return h
+
+
+def incomplete_beta(a, b, x):
+	if x <= 0.0:
+		return 0.0
+	if x >= 1.0:
+		return 1.0
+	lbeta = math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b) + a * math.log(x) + b * math.log(1.0 - x)
+	if x < (a + 1.0) / (a + b + 2.0):
+		return math.exp(lbeta) * betacf(a, b, x) / a
+	return 1.0 - math.exp(lbeta) * betacf(b, a, 1.0 - x) / b
+
+
+def welch_p_value(new_stats, ref_stats):
+	"""Two-sided p-value of Welch's t-test on (mean, stddev, n) summaries."""
+	m1, s1, n1 = new_stats
+	m2, s2, n2 = ref_stats
+	v1, v2 = s1 * s1 / n1, s2 * s2 / n2
+	if v1 + v2 == 0.0:
+		return 0.0 if m1 != m2 else 1.0
+	t = (m1 - m2) / math.sqrt(v1 + v2)
+	df = (v1 + v2) ** 2 / ((v1 * v1 / (n1 - 1) if n1 > 1 else 0.0) + (v2 * v2 / (n2 - 1) if n2 > 1 else 0.0))
+	return incomplete_beta(df / 2.0, 0.5, df / (df + t * t))
+
+
+def compare(new, ref, threshold, alpha):
+	results = []
+	for key in sorted(set(new.keys()) | set(ref.keys())):
+		if key not in new or key not in ref:
+			continue
+		try:
+			n, r = normalize(new[key]), normalize(ref[key])
+		except ValueError as e:
+			print('Skipping %s: %s' % (key, e))
+			continue
+		if math.isnan(n['time'] + r['time']) or math.isinf(n['time'] + r['time']) or r['time'] == 0.0:
+			continue  # cannot compare
+		rel = (n['time'] - r['time']) / r['time']
+		p = welch_p_value(n['stats'], r['stats']) if n['stats'] and r['stats'] else None
+		significant = p is None or p < alpha
+		status = 'ok'
+		if rel > threshold and significant:
+			status = 'REGRESSION'
+		elif rel < -threshold and significant:
+			status = 'improvement'
+		phases = {}
+		for phase in sorted(set(n['phases']) & set(r['phases'])):
+			np, rp = n['phases'][phase], r['phases'][phase]
+			if rp > 0.0:
+				phases[phase] = {'new': np, 'ref': rp, 'rel': (np - rp) / rp}
+		results.append({'test': key, 'new': n['time'], 'ref': r['time'], 'diff': n['time'] - r['time'],
+			'rel': rel, 'p_value': p, 'status': status, 'phases': phases})
+	return results
+
+
+def write_report(results, table_filename, json_filename):
+	with open(table_filename, 'w') as out:
+		format_string = '%10.4g %10.4g %10.4g %7.2f %8s %-11s %s\n'
+		out.write('%10s %10s %10s %7s %8s %-11s %s\n' % ('NEW', 'REF', 'DIFF', 'D/R', 'P', 'STATUS', 'TEST'))
+		for res in results:
+			p = '%8.2g' % res['p_value'] if res['p_value'] is not None else '-'
+			out.write(format_string % (res['new'], res['ref'], res['diff'], res['rel'], p, res['status'], res['test']))
+			for phase, ph in sorted(res['phases'].items()):
+				out.write(format_string % (ph['new'], ph['ref'], ph['new'] - ph['ref'], ph['rel'], '-', '', '    phase ' + phase))
+		if results:
+			new_sum = sum(res['new'] for res in results)
+			ref_sum = sum(res['ref'] for res in results)
+			out.write(format_string % (new_sum, ref_sum, new_sum - ref_sum, (new_sum - ref_sum) / ref_sum, '-', '', 'TOTAL'))
+			new_avg, ref_avg = new_sum / len(results), ref_sum / len(results)
+			out.write(format_string % (new_avg, ref_avg, new_avg - ref_avg, (new_avg - ref_avg) / ref_avg, '-', '', 'MEAN'))
+	with open(json_filename, 'w') as out:
+		json.dump(results, out, indent=1, sort_keys=True)
+
 
 def main():
-	compare_times()
+	parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+	parser.add_argument('--new', default='_performance_', help='report of the run being tested')
+	parser.add_argument('--ref', default='_old_performance_', help='reference report')
+	parser.add_argument('--threshold', type=float, default=0.05, help='relative slowdown counted as a regression (default 0.05)')
+	parser.add_argument('--alpha', type=float, default=0.05, help='significance level of the t-test (default 0.05)')
+	parser.add_argument('--gate', action='store_true', help='exit with status 1 if any benchmark regressed')
+	args = parser.parse_args()
+
+	new, ref = load(args.new), load(args.ref)
+	if new is None or ref is None:
+		return 1 if args.gate else 0
+
+	results = compare(new, ref, args.threshold, args.alpha)
+	write_report(results, 'runtime_diffs.txt', 'runtime_diffs.json')
+
+	regressions = [res['test'] for res in results if res['status'] == 'REGRESSION']
+	for test in regressions:
+		print('Performance regression: ' + test)
+	return 1 if args.gate and regressions else 0
+
 
-from sys import exit
 if __name__ == "__main__":
-	exit(main())
+	sys.exit(main())
@@ -16,7 +16,11 @@
 
 #include <core/pose/Pose.hh>
 #include <core/import_pose/import_pose.hh>
+#include <core/import_pose/import_pose_options.hh>
+#include <core/io/flat_atom_reader.hh>
+#include <core/io/StructFileRep.hh>
 
+#include <chrono>
 #include <fstream>
 
 #include <utility/vector1.hh>
@@ -52,3 +56,85 @@ public:
 
 	std::string pdb_string_;
 };
+
+/// Reads a set of .pdb files both with the regular reader and with the single-pass reader of
+/// core/io/flat_atom_reader.hh, reporting the throughput of each in files/s and MB/s.  The
+/// "parse" numbers are for reading the atoms alone, without building poses.
+class PDB_BulkReadBenchmark : public PerformanceBenchmark
+{
+public:
+	PDB_BulkReadBenchmark( std::string name ) : PerformanceBenchmark( name ) {}
+
+	virtual void setUp() {
+		files_.clear();
+		contents_.clear();
+		bytes_ = 0;
+		for ( char const * filename : { "test_in.pdb", "test_in2.pdb", "dock_in.pdb", "design_in.pdb", "1bbi_disulf.pdb" } ) {
+			std::ifstream pdb( filename );
+			if ( ! pdb ) continue;
+			std::string contents( ( std::istreambuf_iterator< char >( pdb ) ), std::istreambuf_iterator< char >() );
+			bytes_ += contents.size();
+			files_.push_back( filename );
+			contents_.push_back( contents );
+		}
+	}
+
+	virtual void run( core::Real scaleFactor ) {
+		core::Size reps( (core::Size)( 2 * scaleFactor ) );
+		if ( reps == 0 ) { reps = 1; }
+
+		core::import_pose::ImportPoseOptions options;
+		double regular( 0.0 ), fast( 0.0 ), parse( 0.0 );
+		for ( core::Size i = 0; i < reps; ++i ) {
+			{
+				Clock clock( regular );
+				for ( std::string const & filename : files_ ) {
+					core::import_pose::pose_from_file( pose_, filename, options, false, core::import_pose::PDB_file );
+				}
+			}
+			{
+				Clock clock( fast );
+				for ( std::string const & filename : files_ ) {
+					core::import_pose::pose_from_atom_records_file( pose_, filename, options );
+				}
+			}
+			{
+				Clock clock( parse );
+				for ( std::string const & contents : contents_ ) {
+					core::io::read_flat_atoms_from_pdb_contents( contents.data(), contents.data() + contents.size(), options, atoms_ );
+					core::io::create_sfr_from_flat_atoms( atoms_ );
+				}
+			}
+		}
+		add_phase_time( "regular", regular );
+		add_phase_time( "single_pass", fast );
+		add_phase_time( "single_pass_parse", parse );
+
+		double const n_files( reps * files_.size() ), megabytes( reps * bytes_ / 1.0e6 );
+		set_metric( "regular_files_per_s", n_files / regular );
+		set_metric( "regular_MB_per_s", megabytes / regular );
+		set_metric( "single_pass_files_per_s", n_files / fast );
+		set_metric( "single_pass_MB_per_s", megabytes / fast );
+		set_metric( "single_pass_parse_MB_per_s", megabytes / parse );
+	}
+
+	virtual void tearDown() {}
+
+private:
+	/// Adds the wall-clock time of the enclosing scope to a total
+	class Clock
+	{
+	public:
+		Clock( double & total ) : total_( total ), start_( std::chrono::steady_clock::now() ) {}
+		~Clock() { total_ += std::chrono::duration< double >( std::chrono::steady_clock::now() - start_ ).count(); }
+	private:
+		double & total_;
+		std::chrono::steady_clock::time_point start_;
+	};
+
+	core::pose::Pose pose_;
+	core::io::FlatAtoms atoms_;
+	utility::vector1< std::string > files_;
+	utility::vector1< std::string > contents_;
+	core::Size bytes_;
+};
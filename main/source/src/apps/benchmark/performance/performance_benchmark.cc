@@ -28,6 +28,8 @@
 #include <utility/excn/Exceptions.hh>
 #include <utility/file/file_sys_util.hh>
 #include <utility/exit.hh>
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 
 #include <set>
@@ -85,6 +87,7 @@ LigandDockBenchmark ligand_dock("protocols.ligand_docking.LigandDockProtocol");
 
 #include <apps/benchmark/performance/pdb_io.bench.hh>
 PDB_IOBenchmark PDB_IO_("core.import_pose.pose_from_pdbstring");
+PDB_BulkReadBenchmark PDB_BulkRead_("core.import_pose.pose_from_atom_records_file");
 
 //This benchmark isn't really a good representation of ResidueType performance
 //#include <apps/benchmark/performance/ResidueType.bench.hh>
@@ -96,6 +99,9 @@ XMLParseBenchmark XMLParseBenchmark_("utility_tag_Tag_Create");
 
 #include <apps/benchmark/performance/FastRelax.bench.hh>
 #include <apps/benchmark/performance/InteractionGraph.bench.hh>
+#include <apps/benchmark/performance/CompactInteractionGraph.bench.hh>
+
+#include <apps/benchmark/performance/Kernels.bench.hh>
 
 
 // option key includes
@@ -170,6 +176,7 @@ double PerformanceBenchmark::execute(Real scaleFactor)
 		getrusage(RUSAGE_SELF, &R1);
 		n++;
 		t = R1.ru_utime.tv_sec + R1.ru_utime.tv_usec*1e-6 - R0.ru_utime.tv_sec - R0.ru_utime.tv_usec*1e-6;
+		cycle_times_.push_back( t );
 		scaleFactor -= t;
 	}
 	TR << "Running(U) " << name() << "... Done. Time: " << ( init - scaleFactor ) << ". Times executed:" << n << std::endl;
@@ -181,6 +188,7 @@ double PerformanceBenchmark::execute(Real scaleFactor)
 		run(1);
 		t = clock() - t;
 		t = t / CLOCKS_PER_SEC;
+		cycle_times_.push_back( t );
 		scaleFactor -= t;
 		n++;
 	}
@@ -323,40 +331,80 @@ void PerformanceBenchmark::executeAllBenchmarks(Real scaleFactor)
 }
 
 
-/// Generting report file in python dict format: i.e: { 'Bench1': 1.5, 'Bench2': 1.6 }
+/// Report for one benchmark, e.g.:
+///   {"run_time":120.1, "cycles":57, "cycle_time":{"n":57, "mean":2.1, "stddev":0.04, "min":2.0, "median":2.1},
+///    "phases":{"annealing":80.2, "ig_fill":30.5}, "metrics":{"ig_bytes_half":1.2e+07}}
+/// The cycle-time statistics let compare_times.py decide whether a difference is larger than the noise.
+std::string PerformanceBenchmark::json_report() const
+{
+	char buf[1024];
+
+	std::vector< double > sorted( cycle_times_ );
+	std::sort( sorted.begin(), sorted.end() );
+	double mean = 0, stddev = 0, median = 0, min = 0;
+	if ( ! sorted.empty() ) {
+		for ( double const t : sorted ) mean += t;
+		mean /= sorted.size();
+		for ( double const t : sorted ) stddev += ( t - mean ) * ( t - mean );
+		stddev = sorted.size() > 1 ? std::sqrt( stddev / ( sorted.size() - 1 ) ) : 0.0;
+		median = sorted.size() % 2 ? sorted[ sorted.size() / 2 ] : 0.5 * ( sorted[ sorted.size() / 2 - 1 ] + sorted[ sorted.size() / 2 ] );
+		min = sorted.front();
+	}
+
+	sprintf(buf, "{\"run_time\":%f, \"cycles\":%i, \"cycle_time\":{\"n\":%i, \"mean\":%g, \"stddev\":%g, \"min\":%g, \"median\":%g}",
+		time_, result_, int( sorted.size() ), mean, stddev, min, median );
+	std::string res( buf );
+
+	res += ", \"phases\":{";
+	bool first = true;
+	for ( auto const & phase : phase_times_ ) {
+		sprintf(buf, "%s\"%s\":%f", first ? "" : ", ", phase.first.c_str(), phase.second );
+		res += buf;
+		first = false;
+	}
+	res += "}";
+	if ( ! metrics_.empty() ) {
+		res += ", \"metrics\":{";
+		first = true;
+		for ( auto const & metric : metrics_ ) {
+			sprintf(buf, "%s\"%s\":%g", first ? "" : ", ", metric.first.c_str(), metric.second );
+			res += buf;
+			first = false;
+		}
+		res += "}";
+	}
+	res += "}";
+	return res;
+}
+
+/// Generting report file in JSON format: i.e: { "Bench1": {"run_time":1.5, ...}, "Bench2": {...} }
 ///
 std::string PerformanceBenchmark::getReport()
 {
 	std::vector<PerformanceBenchmark *> & all( allBenchmarks() );
 
-	char buf[1024];
-
 	std::string res = "{\n";
 	for ( Size i = 0; i < all.size(); i++ ) {
 		if ( i != 0 ) res += ",\n"; // special first case
 		PerformanceBenchmark * B = all[i];
-		sprintf(buf, "{\"run_time\":%f, \"cycles\":%i}", B->time_, B->result_ );
-		res += "    \"" + B->name_ + "\":" + std::string(buf);
+		res += "    \"" + B->name_ + "\":" + B->json_report();
 	}
 	res += "\n}\n";
 	return res;
 }
 
 
-/// Generting report file in python dict format: i.e: { 'Bench1': 1.5, 'Bench2': 1.6 }
+/// Generting report file in the same JSON format as getReport(), for a single benchmark
 ///
 std::string PerformanceBenchmark::getOneReport(std::string const & name)
 {
 	std::vector<PerformanceBenchmark *> & all( allBenchmarks() );
 
-	char buf[1024];
-
 	std::string res = "{\n";
 
 	for ( auto B : all ) {
 		if ( B->name() == name ) {
-			sprintf(buf, "[%i, %f]", B->result_, B->time_ );
-			res += "    \"" + B->name_ + "\":" + std::string(buf);
+			res += "    \"" + B->name_ + "\":" + B->json_report();
 		}
 	}
 	res += "\n}\n";
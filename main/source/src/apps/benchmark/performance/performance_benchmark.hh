@@ -17,6 +17,8 @@
 
 #include <core/types.hh>
 #include <basic/Tracer.hh>
+#include <chrono>
+#include <map>
 #include <vector>
 #include <string>
 
@@ -43,6 +45,33 @@ public:
 	double execute(core::Real scaleFactor);
 	std::string name() { return name_; }
 
+	/// Add wall-clock time to a named phase of this benchmark (e.g. "neighbors", "annealing");
+	/// the per-phase totals are reported next to the whole-benchmark timing.
+	void add_phase_time( std::string const & phase, double seconds ) { phase_times_[ phase ] += seconds; }
+
+	/// Record a value other than a time (e.g. bytes of memory, a sequence recovery) under a name;
+	/// the last value set is reported next to the phase times.
+	void set_metric( std::string const & metric, double value ) { metrics_[ metric ] = value; }
+
+	/// Times the enclosing scope as one phase of a benchmark:
+	///     { PhaseTimer t( *this, "annealing" ); ... }
+	class PhaseTimer
+	{
+	public:
+		PhaseTimer( PerformanceBenchmark & benchmark, std::string const & phase ) :
+			benchmark_( benchmark ), phase_( phase ), start_( std::chrono::steady_clock::now() ) {}
+
+		~PhaseTimer() {
+			std::chrono::duration< double > const elapsed( std::chrono::steady_clock::now() - start_ );
+			benchmark_.add_phase_time( phase_, elapsed.count() );
+		}
+
+	private:
+		PerformanceBenchmark & benchmark_;
+		std::string phase_;
+		std::chrono::steady_clock::time_point start_;
+	};
+
 public:
 	static void executeOneBenchmark(
 		std::string const & name,
@@ -52,9 +81,16 @@ public:
 	static std::string getReport();
 	static std::string getOneReport(std::string const & name);
 
+private:
+	/// JSON object with the totals, the statistics of the per-cycle times, the phase times and the metrics
+	std::string json_report() const;
+
 private:
 	int result_;
 	double time_;
+	std::vector< double > cycle_times_; ///< user time of each call to run(1)
+	std::map< std::string, double > phase_times_;
+	std::map< std::string, double > metrics_;
 	std::string name_; ///< name of the benchmark, must corelate to namespace ie: core.pose
 
 	/// function for keepig record of all created benchmark classes.
@@ -21,6 +21,7 @@
 
 #include <protocols/jd2/JobDistributor.hh>
 #include <protocols/jd2/NoOutputJobOutputter.hh>
+#include <protocols/jd2/PrefetchingJobInputter.hh>
 #include <protocols/jd2/SilentFileJobInputter.hh>
 
 #include <protocols/toolbox/DecoySetEvaluation.hh>
@@ -140,9 +141,12 @@ void FitMover::apply( core::pose::Pose &pose ) {
 }
 
 void read_structures( RmsfMoverOP rmsf_tool ) {
-	//get silent-file job-inputter if available
+	//get silent-file job-inputter if available, also from behind -jd2:prefetch_inputs
+	JobInputterOP inputter( JobDistributor::get_instance()->job_inputter() );
+	PrefetchingJobInputterOP prefetching( utility::pointer::dynamic_pointer_cast< protocols::jd2::PrefetchingJobInputter > ( inputter ) );
+	if ( prefetching ) inputter = prefetching->wrapped_inputter();
 	SilentFileJobInputterOP sfd_inputter (
-		utility::pointer::dynamic_pointer_cast< protocols::jd2::SilentFileJobInputter > ( JobDistributor::get_instance()->job_inputter() ) );
+		utility::pointer::dynamic_pointer_cast< protocols::jd2::SilentFileJobInputter > ( inputter ) );
 	if ( sfd_inputter ) {
 		//this allows very fast reading of CA coords
 		io::silent::SilentFileData const& sfd( sfd_inputter->silent_file_data() );
@@ -19,11 +19,17 @@
 #include <core/chemical/ChemicalManager.hh>
 
 #include <protocols/cluster/cluster.hh>
+#include <protocols/cluster/StreamingLeaderCluster.hh>
 #include <protocols/loops/Loops.hh>
 #include <core/import_pose/pose_stream/MetaPoseInputStream.hh>
 #include <core/import_pose/pose_stream/util.hh>
+#include <core/io/silent/SilentFileData.hh>
+#include <core/io/silent/SilentFileOptions.hh>
+#include <core/io/silent/SilentStructFactory.hh>
+#include <core/pose/extra_pose_info_util.hh>
 
 #include <basic/options/option.hh>
+#include <basic/Tracer.hh>
 
 #include <devel/init.hh>
 
@@ -41,6 +47,7 @@
 
 #include <utility/vector1.hh>
 #include <utility/excn/Exceptions.hh>
+#include <utility/string_util.hh>
 
 
 #if defined(WIN32) || defined(__CYGWIN__)
@@ -54,6 +61,85 @@ using namespace core::pose;
 using namespace protocols;
 using namespace basic::options;
 
+static basic::Tracer TR( "apps.public.clustering.cluster" );
+
+/// @brief -cluster:streaming: leader-cluster every input structure as it is read.  Prints
+/// each structure's assignment as it is made, and writes each cluster center as soon as it
+/// is found, as c.<cluster>.0.
+void
+stream_cluster(
+	protocols::cluster::ClusterBase const & measure,
+	core::chemical::ResidueTypeSet const & rsd_set
+) {
+	using namespace basic::options::OptionKeys;
+	using namespace protocols::cluster;
+
+	Real const radius = option[ OptionKeys::cluster::radius ]();
+	if ( radius <= 0 ) utility_exit_with_message( "-cluster:streaming needs a positive -cluster:radius" );
+
+	bool const silent_output = option[ out::file::silent ].user();
+	bool const pdb_output = ! silent_output && ! option[ out::nooutput ]();
+	std::string const prefix = option[ out::prefix ]();
+	core::io::silent::SilentFileOptions opts;
+	core::io::silent::SilentFileData sfd( opts );
+
+	if ( ! option[ in::file::lazy_silent ].user() ) option[ in::file::lazy_silent ].value( true );
+	core::import_pose::pose_stream::MetaPoseInputStream input = core::import_pose::pose_stream::streams_from_cmd_line();
+
+	StreamingLeaderClusterOP clusters;
+	utility::vector1< core::id::AtomID > atoms;
+	utility::vector1< core::chemical::ResidueType const * > residue_types;
+	while ( input.has_another_pose() ) {
+		core::pose::Pose pose;
+		input.fill_pose( pose, rsd_set );
+		std::string const tag = core::pose::extract_tag_from_pose( pose );
+
+		if ( ! clusters ) {
+			if ( ! measure.coordinate_rmsd_atoms( pose, atoms ) ) {
+				utility_exit_with_message( "-cluster:streaming clusters by superimposed CA or backbone RMSD only" );
+			}
+			clusters = utility::pointer::make_shared< StreamingLeaderCluster >( radius, atoms.size() );
+			clusters->n_pivots( option[ OptionKeys::cluster::n_pivots ]() );
+			for ( core::Size ii = 1; ii <= pose.size(); ++ii ) residue_types.push_back( &pose.residue_type( ii ) );
+		}
+		// The atoms were chosen from the first structure
+		bool same_residues( pose.size() == residue_types.size() );
+		for ( core::Size ii = 1; same_residues && ii <= pose.size(); ++ii ) {
+			same_residues = &pose.residue_type( ii ) == residue_types[ ii ];
+		}
+		if ( ! same_residues ) {
+			TR.Warning << "Skipping " << tag << ": its residues differ from those of the first structure" << std::endl;
+			continue;
+		}
+
+		StreamingLeaderCluster::Assignment const assignment( clusters->add( pose, atoms ) );
+		core::Size const cluster = assignment.leader - 1;
+		std::cout << clusters->n_structures() - 1 << " " << tag << "  " << cluster
+			<< "  " << clusters->cluster_size( assignment.leader ) - 1 << "  " << assignment.distance << "\n";
+
+		if ( assignment.new_leader ) {
+			std::string output_name = prefix + "c." + utility::to_string( cluster ) + ".0.pdb";
+			utility::replace_in( output_name, '/', "_" );
+			if ( silent_output ) {
+				core::io::silent::SilentStructOP ss( core::io::silent::SilentStructFactory::get_instance()->get_silent_struct_out( opts ) );
+				ss->fill_struct( pose, output_name );
+				sfd.write_silent_struct( *ss, option[ out::file::silent ]() );
+			} else if ( pdb_output ) {
+				pose.dump_pdb( output_name );
+			}
+		}
+	}
+	std::cout << std::flush;
+
+	if ( ! clusters ) utility_exit_with_message( "Error: no Poses to cluster! Try -in:file:s or -in:file:silent!" );
+	std::cout << "Clustered " << clusters->n_structures() << " structures into " << clusters->n_leaders()
+		<< " clusters at radius " << radius << " with " << clusters->n_rmsd_evaluations() << " RMSD evaluations ("
+		<< clusters->n_rmsd_evaluations() / Real( clusters->n_structures() ) << " per structure)" << std::endl;
+	for ( core::Size ii = 1; ii <= clusters->n_leaders(); ++ii ) {
+		std::cout << "CLUSTER " << ii - 1 << " " << clusters->cluster_size( ii ) << std::endl;
+	}
+}
+
 int
 main( int argc, char * argv [] ) {
 	try {
@@ -81,6 +167,8 @@ main( int argc, char * argv [] ) {
 		option.add_relevant( OptionKeys::cluster::remove_highest_energy_member );
 		option.add_relevant( OptionKeys::cluster::limit_dist_matrix            );
 		option.add_relevant( OptionKeys::cluster::make_ensemble_cst            );
+		option.add_relevant( OptionKeys::cluster::streaming                    );
+		option.add_relevant( OptionKeys::cluster::n_pivots                     );
 		simple_moves::ScoreMover::register_options();
 
 		// initialize core
@@ -117,6 +205,7 @@ main( int argc, char * argv [] ) {
 		std::cout << "                   -cluster:limit_total_structures  <int>      Maximal number of structures in total" << std::endl;
 		std::cout << "                   -cluster:sort_groups_by_energy              Sort clusters by energy." << std::endl;
 		std::cout << "                   -cluster:remove_highest_energy_member       Remove highest energy member of each cluster" << std::endl;
+		std::cout << "                   -cluster:streaming                          Leader-cluster any number of structures one at a time, without a distance matrix" << std::endl;
 		std::cout << "                   -symmetry:symmetric_rmsd       \t\t\t\t\t\t For symmetric systems find the lowest rms by testing all chain combinations. Works only with silent file input that contain symmetry info and with all CA rmsd" << std::endl;
 		std::cout << " Examples: " << std::endl;
 		std::cout << "   cluster -database ~/minirosetta_database -in:file:silent silent.out -in::file::binary_silentfile -in::file::fullatom -native 1a19.pdb " << std::endl;
@@ -182,6 +271,11 @@ main( int argc, char * argv [] ) {
 		}
 
 
+		if ( option[ basic::options::OptionKeys::cluster::streaming ]() ) {
+			stream_cluster( *clustering, *rsd_set );
+			return 0;
+		}
+
 		// Cluster the first up-to-400 structures by calculating a full rms matrix
 		core::import_pose::pose_stream::MetaPoseInputStream input = core::import_pose::pose_stream::streams_from_cmd_line();
 		core::Size max_struct_for_full_rms = option[ basic::options::OptionKeys::cluster::max_rms_matrix ]();
@@ -68,6 +68,7 @@ void register_options() {
 	OPT(frags::allowed_pdb);
 	OPT(frags::denied_pdb);
 	OPT(frags::describe_fragments);
+	OPT(frags::write_compiled_vall);
 	OPT(frags::keep_all_protocol);
 	OPT(frags::bounded_protocol);
 	OPT(frags::quota_protocol);
@@ -749,6 +749,9 @@ Options = Option_Group( '',
 			Option( 'silent_print_all_score_headers', 'Boolean',
 					desc='Print a SCORE header for every SilentStruct in a silent-file',
 					default='false' ),
+			Option( 'silent_indexed', 'Boolean',
+					desc='Write silent files as indexed silent files: the usual silent-file records followed by a tag index and a column-wise block of scores, so that single structures or only the scores can be read without scanning the file.  Indexed silent files are recognized automatically on input.  Only one process may write to a given indexed silent file.  Each write adds an index segment, so jd2 buffers 100 structures per write unless -jd2:buffer_silent_output is given.',
+					default='false' ),
 #			Option( 'silent_decoytime', 'Boolean',
 #					desc='Add time since last silent structure was written to score line',
 #					default = 'false' ),
@@ -1334,6 +1337,7 @@ Options = Option_Group( '',
 	Option_Group( 'jd2',
 		Option('pose_input_stream','Boolean',desc='Use PoseInputStream classes for Pose input', default='false' ),
 		Option('lazy_silent_file_reader','Boolean',desc='use lazy silent file reader in job distributor, read in a structure only when you need to',default='false'),
+		Option('prefetch_inputs','Integer',desc='Build the starting poses of up to this many upcoming jobs on a background thread while the current job runs. Multi-threaded builds with -s/-l or non-lazy -in:file:silent input only; 0 disables',default='0'),
 								#for the Archive it really doesn't matter to finish the last runs.. some stragglers can take up to an 1h to finish...
 								# save the computer time...
 		Option( 'mpi_nowait_for_remaining_jobs','Boolean', desc='exit immediately (not graceful -- not complete) if the last job has been sent out', default='false'),
@@ -1400,6 +1404,7 @@ Options = Option_Group( '',
 		Option( 'input_etables' , 'String', desc="Read etables from files with given prefix" ),
 		Option( 'output_etables', 'String', desc="Write out etables to files with given prefix" ),
 		Option( 'analytic_etable_evaluation', 'Boolean', desc="Instead of interpolating between bins, use an analytic evaluation of the lennard-jones and solvation energies", default="true" ),
+		Option( 'etable_soa_kernel', 'Boolean', desc="When evaluating fa_atr, fa_rep and fa_sol for a residue pair, first gather the second residue's heavy-atom coordinates into contiguous arrays and screen all atom pairs by distance in a vectorizable loop, evaluating the etable only for pairs within the interaction cutoff.  Energies are identical to the atom-by-atom evaluation.", default="true" ),
 		Option( 'put_intra_into_total','Boolean', desc="Put intra-residue terms inside hbond, geom_sol_fast, fa_atr. (Contributions will not show up in hbond_intra, fa_atr_intra_xover4.) Off for proteins by default.", default="false" ),
 		Option( 'include_intra_res_protein','Boolean', desc="Include computation of intra-residue terms for proteins.", default="false" ),
 		Option( 'fa_stack_base_base_only','Boolean', desc="Only calculate fa_stack for RNA base/base.", default="true" ),
@@ -1433,6 +1438,7 @@ Options = Option_Group( '',
 		Option( 'NV_table', 'String', desc="Location of path to potential lookup table", default='scoring/score_functions/NV/neighbor_vector_score.histogram'),
 		Option( 'find_neighbors_3dgrid', 'Boolean', desc="Use a 3D lookup table for doing neighbor calculations.  For spherical, well-distributed conformations, O(N) neighbor detection instead of general O(NlgN)", default='false' ),
 		Option( 'find_neighbors_stripehash', 'Boolean', desc="should be faster than 3dgrid and use 1/8th the memory", default='false' ),
+		Option( 'incremental_neighbor_update', 'Boolean', desc="Between score function evaluations, keep the residue neighbor atoms in a spatial hash, and after a move re-bin and re-query only the residues that moved with respect to the largest unmoved domain instead of redetecting every neighbor pair.  Falls back to full neighbor detection whenever the unmoved residues have changed their coordinates.  Only plain (non-symmetric, non-surface) Energies use it.  Experimental: off by default.", default='false' ),
 		Option( 'seqdep_refene_fname', 'String', desc="Filename for table containing sequence-dependent reference energies" ),
 		Option( 'secondary_seqdep_refene_fname', 'String', desc="Additional filename for table containing sequence-dependent reference energies" ),
 		Option( 'exact_occ_pairwise', 'Boolean', desc="When using occ_sol_exact, compute energies subject to pairwise additivity (not recommended - intended for parameterization / evaluation purposes)", default='false' ),
@@ -1712,6 +1718,18 @@ Options = Option_Group( '',
 			desc='The number of threads to launch in the global thread pool.  All thread-parallelized work will be distributed over these threads.',
 			default='1'
 		), #-multithreading:total_threads
+		Option( 'interaction_graph_threads', 'Integer',
+			desc='The number of threads to request for precomputing the two-body energies of the packer\'s interaction graph.  Must be less than or equal to -multithreading:total_threads.  A value of 0 means to request all available threads.  Ignored in non-multithreaded builds.',
+			lower='0', default='0'
+		), #-multithreading:interaction_graph_threads
+		Option( 'scoring_threads', 'Integer',
+			desc='The number of threads to request when a ScoreFunction evaluates the two-body energies of a pose outside of minimization.  Each thread handles a subset of the residues in the EnergyGraph and long-range energy containers, and the per-residue energies are summed in a fixed order, so results do not depend on the thread count.  A value of 1 (the default) scores in the calling thread only; 0 means to request all available threads.  All enabled energy methods must be threadsafe.  Ignored in non-multithreaded builds.',
+			lower='0', default='1'
+		), #-multithreading:scoring_threads
+		Option( 'minimization_derivative_threads', 'Integer',
+			desc='The number of threads to request when the atom-tree and Cartesian minimizers evaluate the inter-residue derivatives of the minimization graph.  The edges are split into this many blocks, each accumulated into its own buffer and summed in a fixed order, so results do not depend on thread scheduling.  A value of 1 (the default) evaluates derivatives in the calling thread only; 0 means to request all available threads.  All enabled energy methods must be threadsafe.  Ignored in non-multithreaded builds.',
+			lower='0', default='1'
+		), #-multithreading:minimization_derivative_threads
 	), # -multithreading
 
 	# for recon design application ---------------------------------------
@@ -1933,6 +1951,23 @@ Options = Option_Group( '',
 				store RPEs for (~4 KB per rotamer by default)",
 			default='10',
 			),
+		Option( 'ig_edge_storage', 'String',
+			desc="The representation of the two-body energy tables of the precomputed \
+				interaction graphs (PDInteractionGraph and DensePDInteractionGraph) during \
+				simulated annealing.  'float' keeps the 32-bit tables; 'half' stores IEEE \
+				16-bit floats; 'fixed16' and 'fixed8' store 16- and 8-bit integers with a \
+				per-edge scale, after clamping energies to the range given by \
+				-packing:ig_edge_clamp.  The compact forms use 1/2 or 1/4 of the memory \
+				at the cost of rounding the pair energies.",
+			legal=[ 'float', 'half', 'fixed16', 'fixed8' ],
+			default='float',
+			),
+		Option( 'ig_edge_clamp', 'Real',
+			desc="For the fixed-point -packing:ig_edge_storage representations, the largest \
+				magnitude a pair energy may have; larger (typically repulsive) energies \
+				are stored as +/- this value.",
+			default='10.0',
+			),
 		##Option( 'minimalist_ig', 'Boolean',
 		##       desc="DOES NOT YET WORK. Force the packer to use the minimalist interaction graph.  The minimalist \
 		##             interaction graph allocates no space for RPE storage.  It is \
@@ -2359,6 +2394,7 @@ EX_SIX_QUARTER_STEP_STDDEVS   7          +/- 0.25, 0.5, 0.75, 1, 1.25 & 1.5 sd;
 		Option( 'enlarge_H_lj', 'Boolean', desc="Use larger LJ_WDEPTH for Hs to avoid RNA clashes", default='false'),
 		Option( 'no_hbonds_to_ether_oxygens', 'Boolean', desc="no H-bonds to nucleic acid ether oxygens O3', O4', O5' -- deprecated", default='false'),
 		Option( 'unset_acceptor_ether_oxygens', 'Boolean', desc="nucleic acid ether oxygens O3', O4', O5' are not counted as acceptors", default='false'),
+		Option( 'residue_type_set_snapshot', 'Boolean', desc="Cache the ResidueTypes and patches read from the database for each global ResidueTypeSet as a binary snapshot in the database cache directory (see -in:path:database_cache_dir), and restore them from it at startup instead of re-reading the params and patch files.  Snapshots are keyed on the database list files, the contents of the files they name (whose hashes are cached by size and modification time), and the values of the options that affect the types read from them.  Requires a build with extras=serialization.", default='false'),
 	), #-chemical
 
 	# Coarse options
@@ -4510,6 +4546,11 @@ EX_SIX_QUARTER_STEP_STDDEVS   7          +/- 0.25, 0.5, 0.75, 1, 1.25 & 1.5 sd;
 		Option( 'gdtmm', 'Boolean', desc="Cluster by gdtmm instead of RMS", default = 'false' ),
                 Option( 'skip_align', 'Boolean', desc="Cluster without aligning the structures", default = 'false' ),
                 Option( 'max_rms_matrix', 'Integer', desc="Maximum number of structures to use to calculate the full RMSD matrix", default = '400' ),
+		Option( 'coordinate_rmsd', 'Boolean', desc="Compute the RMSD matrix from one array of the CA (or backbone) coordinates of every structure with the batched QCP kernel, in parallel tiles, storing it in single precision. Applies to the superimposed CA and backbone RMSD measures only; others are still computed pose by pose.", default = 'false' ),
+		Option( 'rms_matrix_memory_limit', 'Real', desc="With -cluster:coordinate_rmsd, the largest RMSD matrix (in MB) to hold in memory; a larger one is written to -cluster:rms_matrix_file and memory-mapped", default = '4096' ),
+		Option( 'rms_matrix_file', 'String', desc="Scratch file for an RMSD matrix larger than -cluster:rms_matrix_memory_limit.  By default a uniquely named rms_matrix* file in the current directory, deleted when clustering finishes." ),
+		Option( 'streaming', 'Boolean', desc="Leader-cluster the input one structure at a time, never forming a distance matrix: each structure joins the nearest existing cluster center within -cluster:radius (superimposed CA or backbone RMSD) or else becomes a new center. Silent files are read lazily.", default = 'false' ),
+		Option( 'n_pivots', 'Integer', desc="With -cluster:streaming, the number of cluster centers whose distances bound the distances to all the others", default = '16' ),
                 Option( 'rna_P', 'Boolean', desc="Calculate rmsd from backbone phosphate positions only", default = 'false' ),
 		Option( 'sort_groups_by_energy', 'Boolean', desc="Sort clusters by energy", default = 'false' ),
 		Option( 'sort_groups_by_size', 'Boolean', desc="Sort clusters by energy", default = 'false' ),
@@ -5569,6 +5610,9 @@ EX_SIX_QUARTER_STEP_STDDEVS   7          +/- 0.25, 0.5, 0.75, 1, 1.25 & 1.5 sd;
 #		Option( 'render_sigma', 'Real', default = '2', desc='initially render at this sigma level (extras=graphics build only)'),
 		Option( 'unmask_bb', 'Boolean', default = 'false', desc='Only include sidechain atoms in atom mask'),
 		Option( 'render_density', 'Boolean', default = 'false', desc='render electron density in graphics mode build'),
+		Option( 'fft_threads', 'Integer', default = '0', desc='The number of threads to request for the 3D FFTs of density maps.  A value of 0 means to request all available threads (-multithreading:total_threads).  Ignored in non-multithreaded builds.'),
+		Option( 'bricked_map', 'Boolean', default = 'false', desc='Map the density map file into memory and load it brick by brick as needed, instead of reading the whole map.  Fast density scoring and the allatom density score then only hold the parts of the map near the model, for very large maps.  Only for uncompressed MRC maps covering the unit cell that are not resampled (-edensity::grid_spacing); other maps, and protocols that need the whole map, load the whole map.'),
+		Option( 'brick_size', 'Integer', default = '32', lower = '8', desc='Edge length (in voxels) of the bricks of -edensity::bricked_map maps'),
 	), # -edensity
 
 	## options for enzyme design
@@ -5996,7 +6040,7 @@ EX_SIX_QUARTER_STEP_STDDEVS   7          +/- 0.25, 0.5, 0.75, 1, 1.25 & 1.5 sd;
 
 ## --------------------------  FRAGMENT PICKING --------------
 	Option_Group( 'frags',
-		Option( 'j', 'Integer', desc='Number of threads to use'),
+		Option( 'j', 'Integer', desc='Number of threads to pick fragments with; defaults to -multithreading:total_threads in multi-threaded builds'),
 		Option( 'filter_JC', 'Boolean',
 			desc='Filter J-coupling values in the dynamic range ', default='false'),
 
@@ -6066,6 +6110,7 @@ EX_SIX_QUARTER_STEP_STDDEVS   7          +/- 0.25, 0.5, 0.75, 1, 1.25 & 1.5 sd;
 		Option( 'seqsim_L', 'Real', desc='Secondary structure type prediction multiplier, for use in fragment picking', default='1.0'),
 		Option( 'rama_norm', 'Real', desc='Used to multiply rama table values after normalization, default (0.0) means use raw counts (unnormalized)', default='0.0'),
 		Option( 'describe_fragments','String',desc='Writes scores for all fragments into a file', default=''),
+		Option( 'write_compiled_vall', 'File', desc='Writes the Vall read with -in:file:vall to this file in the compiled binary format. -in:file:vall accepts a compiled Vall too, and maps it instead of parsing it.'),
 		Option( 'picking_old_max_score', 'Real', desc='maximal score allowed for fragments picked by the old vall (used by RosettaRemodel).', default='1000000.0'),
 		Option( 'write_sequence_only', 'Boolean', desc='Fragment picker will output fragment sequences only. This option is for creating structure based sequence profiles using the FragmentCrmsdResDepth score.', default='false'),
 		Option( 'output_silent', 'Boolean', desc='Fragment picker will output fragments into a silent file.', default='false'),
@@ -6238,6 +6283,8 @@ EX_SIX_QUARTER_STEP_STDDEVS   7          +/- 0.25, 0.5, 0.75, 1, 1.25 & 1.5 sd;
 		Option( 'write_all_fa_structs',   'Boolean', default = 'false', desc = 'Write out all structures returned from batch relax' ),
 		Option( 'sandbox',   'Boolean', default = 'false', desc = 'Sand box mode' ),
 		Option( 'create_db', 'Boolean', default = 'false', desc = 'Make database with this loopsize' ),
+		Option( 'write_binary_db', 'Boolean', default = 'false', desc = 'Convert the merged text database in db_path (backbone.db, loopdb.<size>.db) to the binary format read with -lh:mmap_db, then exit' ),
+		Option( 'mmap_db', 'Boolean', default = 'false', desc = 'Read the merged database from the binary files in db_path (backbone.bin, loopdb.<size>.bin) through a read-only memory mapping that all processes on a node share, instead of parsing the text files into each process' ),
 		Option( 'sample_weight_file', 'File', desc = 'Holds the initial per residue sample weights' ),
 		Option( 'radius_size', 'Real',default = '2',desc='tune the radius for hypershell'),
 		# specific for mpi_refinement (above are shared by both loophash & mpi_refinement)
@@ -51,6 +51,10 @@
 #include <core/chemical/Orbital.hh> /* for copying ResidueType */
 #include <core/chemical/ResidueConnection.hh> /* for copying ResidueType */
 #include <core/chemical/residue_support.hh>
+#include <core/chemical/AtomTypeSet.hh>
+#include <core/chemical/ElementSet.hh>
+#include <core/chemical/MMAtomTypeSet.hh>
+#include <core/chemical/orbitals/OrbitalTypeSet.hh>
 
 #include <core/chemical/mmCIF/mmCIFParser.hh>
 
@@ -67,9 +71,13 @@
 #include <utility/sql_database/types.hh>
 
 // C++ headers
+#include <cstdio>
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <set>
+#include <map>
+#include <ctime>
 #include <algorithm>
 
 // option key includes
@@ -77,10 +85,26 @@
 #include <basic/options/keys/chemical.OptionKeys.gen.hh>
 #include <basic/options/keys/in.OptionKeys.gen.hh>
 #include <basic/options/keys/packing.OptionKeys.gen.hh>
+#include <basic/options/keys/corrections.OptionKeys.gen.hh>
+#include <basic/options/keys/score.OptionKeys.gen.hh>
+#include <basic/options/keys/rings.OptionKeys.gen.hh>
 
 #include <utility/vector1.hh>
 #include <utility/tools/make_vector1.hh>
 #include <utility/file/file_sys_util.hh>
+#include <utility/string_util.hh>
+
+#ifdef    SERIALIZATION
+#include <basic/database/open.hh>
+#include <utility/io/MappedFile.hh>
+#include <utility/serialization/serialization.hh>
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/string.hpp>
+#endif // SERIALIZATION
+
+#ifdef MULTI_THREADED
+#include <utility/thread/ReadWriteMutex.hh>
+#endif
 
 using namespace basic::options;
 
@@ -104,11 +128,31 @@ GlobalResidueTypeSet::GlobalResidueTypeSet(
 	set_merge_behavior_manager( utility::pointer::make_shared< MergeBehaviorManager >( directory ) );
 	load_exclude_pdb_component_ids( directory );
 
-	init_restypes_from_database(); // Will also load the sub-typesets
+	// Parsing the database params and patch files dominates startup; restore them from a snapshot if we can.
+	utility::vector1< PatchCOP > snapshot_patches;
+	utility::vector1< MetapatchCOP > snapshot_metapatches;
+	bool const from_snapshot( load_database_snapshot( snapshot_patches, snapshot_metapatches ) );
+
+	if ( ! from_snapshot ) {
+		init_restypes_from_database(); // Will also load the sub-typesets
+	}
+	Size const n_database_types( base_residue_types().size() );
 	init_restypes_from_commandline();
 
 	init_patches_from_commandline(); // Patch resolution is order dependent - allow commandline to overrule
-	init_patches_from_database();
+	Size const n_commandline_patches( patches().size() );
+	Size const n_commandline_metapatches( metapatches().size() );
+	if ( from_snapshot ) {
+		for ( PatchCOP const & p : snapshot_patches ) add_patch( p );
+		for ( MetapatchCOP const & p : snapshot_metapatches ) add_metapatch( p );
+#ifdef MULTI_THREADED
+		utility::thread::WriteLockGuard write_lock( cache_object()->read_write_mutex() );
+#endif
+		cache_object()->clear_cached_maps();
+	} else {
+		init_patches_from_database();
+		write_database_snapshot( n_database_types, n_commandline_patches, n_commandline_metapatches );
+	}
 	deal_with_patch_special_cases();
 
 	// Generate combinations of adducts as specified by the user
@@ -679,6 +723,316 @@ GlobalResidueTypeSet::place_adducts() {
 	}
 }
 
+/// @details Bump this whenever the layout of the snapshot or of its key changes.
+static std::string const DATABASE_SNAPSHOT_FORMAT( "GlobalResidueTypeSet database snapshot v3" );
+
+/// @details Hashing every params and patch file would cost much of what a snapshot saves, so the
+/// SHA-1 of each file is cached next to the snapshots along with its size and modification time,
+/// and only recomputed when either has changed.  As modification times have a resolution of a
+/// second, an entry is not trusted for a file modified no earlier than the entry was hashed: the
+/// file may have been edited again within that second.
+std::map< std::string, std::string >
+GlobalResidueTypeSet::database_file_hashes( utility::vector1< std::string > const & files ) const {
+	struct FileHash {
+		long size;
+		long modified;
+		std::string sha1;
+	};
+
+	std::string const cache_relpath( "chemical/residue_type_sets/" + name() + "." + utility::string_to_sha1( database_directory_ ) + ".rts.hashes" );
+	std::string const cache_filename( basic::database::full_cache_name( cache_relpath, database_directory_ + "residue_types.txt", false ) );
+
+	// The cache is "hashed_at <time>", then one "<size> <mtime> <sha1> <file>" line per file.
+	std::map< std::string, FileHash > cached;
+	long cached_at( -1 );
+	if ( ! cache_filename.empty() && utility::file::file_exists( cache_filename ) ) {
+		utility::io::izstream data( cache_filename.c_str() );
+		std::string tag;
+		if ( data >> tag >> cached_at && tag == "hashed_at" ) {
+			FileHash entry;
+			std::string file;
+			while ( data >> entry.size >> entry.modified >> entry.sha1 && getline( data >> std::ws, file ) ) {
+				cached[ file ] = entry;
+			}
+		} else {
+			cached_at = -1;
+		}
+	}
+
+	long const hashed_at( static_cast< long >( std::time( nullptr ) ) );
+	std::map< std::string, FileHash > current;
+	bool changed( false );
+	for ( std::string const & file : files ) {
+		FileHash entry;
+		entry.size = utility::file::file_size( file );
+		entry.modified = utility::file::file_last_modified( file );
+		auto const found( cached.find( file ) );
+		if ( found != cached.end() && found->second.size == entry.size && found->second.modified == entry.modified
+				&& entry.modified < cached_at ) {
+			entry.sha1 = found->second.sha1;
+		} else {
+			entry.sha1 = utility::string_to_sha1( utility::file_contents( file ) );
+			changed = true;
+		}
+		current[ file ] = entry;
+	}
+	changed = changed || current.size() != cached.size();
+
+	if ( changed ) {
+		// Written to a temporary file and renamed into place, as for the snapshots themselves.
+		std::string const filename( basic::database::full_cache_name( cache_relpath, database_directory_ + "residue_types.txt", true ) );
+		if ( ! filename.empty() ) {
+			std::string const tempname( utility::file::create_temp_filename( utility::file::FileName( filename ).path(), "rts_hashes" ) );
+			bool written( false );
+			{
+				std::ofstream out( tempname.c_str() );
+				out << "hashed_at " << hashed_at << '\n';
+				for ( auto const & file_hash : current ) {
+					out << file_hash.second.size << ' ' << file_hash.second.modified << ' ' << file_hash.second.sha1 << ' ' << file_hash.first << '\n';
+				}
+				written = out.good();
+			}
+			if ( ! written || std::rename( tempname.c_str(), filename.c_str() ) != 0 ) {
+				utility::file::file_delete( tempname );
+			}
+		}
+	}
+
+	std::map< std::string, std::string > hashes;
+	for ( auto const & file_hash : current ) {
+		hashes[ file_hash.first ] = file_hash.second.sha1;
+	}
+	return hashes;
+}
+
+/// @details The key is a plain-text description of the inputs; the snapshot file name carries its
+/// SHA-1, and the full text is stored in the snapshot and compared on load.  It covers the
+/// database list files line by line -- with the SHA-1 of the contents of each file they name, so
+/// that editing a params or patch file invalidates the snapshot -- and the options that change
+/// what is read from them.  Options read before the database is (atom type set adjustments, for
+/// instance) belong in this list just as much as those read by the readers themselves.
+std::string
+GlobalResidueTypeSet::database_snapshot_key() const {
+	using namespace basic::options;
+	using namespace basic::options::OptionKeys;
+
+	utility::vector1< std::string > const list_files( utility::tools::make_vector1< std::string >(
+		"residue_types.txt", "patches.txt", "metapatches.txt" ) );
+	// Each line of the list files, with the file it names (if any).
+	utility::vector1< std::pair< std::string, std::string > > list_lines;
+	utility::vector1< std::string > named_files;
+	for ( std::string const & list_file : list_files ) {
+		utility::io::izstream data( ( database_directory_ + list_file ).c_str() );
+		if ( !data.good() ) {
+			list_lines.push_back( std::make_pair( list_file + " missing", "" ) );
+			continue;
+		}
+		std::string line, entry;
+		while ( getline( data, line ) ) {
+			std::istringstream l( line );
+			if ( l >> entry && entry[0] != '#' && utility::file::file_exists( database_directory_ + entry ) ) {
+				named_files.push_back( database_directory_ + entry );
+				list_lines.push_back( std::make_pair( list_file + ": " + line, database_directory_ + entry ) );
+			} else {
+				list_lines.push_back( std::make_pair( list_file + ": " + line, "" ) );
+			}
+		}
+	}
+	std::map< std::string, std::string > const hashes( database_file_hashes( named_files ) );
+
+	std::ostringstream key;
+	key << DATABASE_SNAPSHOT_FORMAT << '\n';
+	key << "name " << name() << '\n';
+	key << "directory " << database_directory_ << '\n';
+	for ( auto const & line : list_lines ) {
+		key << line.first;
+		if ( ! line.second.empty() ) key << " [" << hashes.at( line.second ) << ']';
+		key << '\n';
+	}
+
+	utility::vector1< utility::options::OptionKey const * > const keys{
+		&OptionKeys::pH::pH_mode, &OptionKeys::in::include_sugars, &OptionKeys::in::include_lipids, &OptionKeys::in::include_surfaces,
+		&OptionKeys::in::missing_density_to_jump, &OptionKeys::in::use_truncated_termini,
+		&OptionKeys::chemical::exclude_patches, &OptionKeys::chemical::include_patches, &OptionKeys::chemical::patch_selectors,
+		&OptionKeys::chemical::add_atom_type_set_parameters, &OptionKeys::chemical::set_atom_properties, &OptionKeys::chemical::clone_atom_types,
+		&OptionKeys::chemical::reassign_atom_types, &OptionKeys::chemical::reassign_icoor, &OptionKeys::chemical::set_atomic_charge,
+		&OptionKeys::chemical::set_patch_atomic_charge, &OptionKeys::chemical::enlarge_H_lj, &OptionKeys::chemical::no_hbonds_to_ether_oxygens,
+		&OptionKeys::chemical::unset_acceptor_ether_oxygens,
+		&OptionKeys::corrections::chemical::alternate_fullatom_ats,
+		&OptionKeys::corrections::chemical::parse_charge, &OptionKeys::corrections::chemical::expand_st_chi2sampling,
+		&OptionKeys::corrections::score::rama_prepro_steep, &OptionKeys::corrections::score::rama_prepro_nobidentate,
+		&OptionKeys::score::symmetric_gly_tables, &OptionKeys::score::ideal_sugars,
+		&OptionKeys::rings::ring_conformer_dbpath };
+	for ( utility::options::OptionKey const * option_key : keys ) {
+		key << option_key->id() << ' ' << ( option[ *option_key ].user() ? "user " : "default " ) << option[ *option_key ].value_string() << '\n';
+	}
+	return key.str();
+}
+
+bool
+GlobalResidueTypeSet::database_snapshot_enabled() const {
+#ifdef SERIALIZATION
+	using namespace basic::options;
+	if ( ! option[ OptionKeys::chemical::residue_type_set_snapshot ] ) return false;
+	// These are applied to every type as it is added to the set (see prep_restype()), so a
+	// restored type would receive them twice.
+	if ( option[ OptionKeys::in::add_orbitals ] || option[ OptionKeys::in::file::assign_gasteiger_atom_types ] ) {
+		TR.Debug << "Not using a snapshot for " << name() << ": incompatible with -add_orbitals and -assign_gasteiger_atom_types" << std::endl;
+		return false;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+std::string
+GlobalResidueTypeSet::database_snapshot_filename( std::string const & key, bool for_writing ) const {
+	return basic::database::full_cache_name( "chemical/residue_type_sets/" + name() + "." + utility::string_to_sha1( key ) + ".rts.bin",
+		database_directory_ + "residue_types.txt", for_writing );
+}
+
+bool
+GlobalResidueTypeSet::load_database_snapshot(
+	utility::vector1< PatchCOP > & database_patches,
+	utility::vector1< MetapatchCOP > & database_metapatches
+) {
+#ifdef SERIALIZATION
+	if ( ! database_snapshot_enabled() ) return false;
+
+	std::string const key( database_snapshot_key() );
+	std::string const filename( database_snapshot_filename( key, false ) );
+	if ( filename.empty() ) return false;
+
+	utility::io::MappedFile snapshot( filename );
+	if ( ! snapshot.is_open() ) return false;
+	utility::io::MemoryStreamBuf buffer( snapshot.data(), snapshot.size() );
+	std::istream in( &buffer );
+
+	TypeSetMode snapshot_mode;
+	std::string atom_types, elements, mm_atom_types, orbital_types;
+	utility::vector1< ResidueTypeOP > restypes;
+	utility::vector1< PatchCOP > patches;
+	utility::vector1< MetapatchCOP > metapatches;
+	try {
+		cereal::BinaryInputArchive arc( in );
+		std::string snapshot_key;
+		arc( snapshot_key );
+		if ( snapshot_key != key ) {
+			TR.Warning << "Ignoring residue type set snapshot " << filename << ": it was written for different inputs." << std::endl;
+			return false;
+		}
+		arc( snapshot_mode, atom_types, elements, mm_atom_types, orbital_types );
+
+		Size n_restypes( 0 ), n_patches( 0 ), n_metapatches( 0 );
+		arc( n_restypes );
+		for ( Size ii = 1; ii <= n_restypes; ++ii ) {
+			// Restore the ResidueTypes themselves, rather than through serialize_residue_type(), which
+			// would look them up in the (still under construction) global set by name.
+			ResidueTypeOP restype( new ResidueType( nullptr, nullptr, nullptr, nullptr ) );
+			arc( *restype );
+			restypes.push_back( restype );
+		}
+		arc( n_patches );
+		for ( Size ii = 1; ii <= n_patches; ++ii ) {
+			PatchOP patch( new Patch );
+			arc( *patch );
+			patches.push_back( patch );
+		}
+		arc( n_metapatches );
+		for ( Size ii = 1; ii <= n_metapatches; ++ii ) {
+			MetapatchOP metapatch( new Metapatch );
+			arc( *metapatch );
+			metapatches.push_back( metapatch );
+		}
+	} catch ( cereal::Exception const & e ) {
+		TR.Warning << "Ignoring unreadable residue type set snapshot " << filename << ": " << e.what() << std::endl;
+		return false;
+	}
+
+	mode( snapshot_mode );
+	ChemicalManager * cm( ChemicalManager::get_instance() );
+	if ( ! atom_types.empty() ) atom_type_set( cm->atom_type_set( atom_types ) );
+	if ( ! elements.empty() ) element_set( cm->element_set( elements ) );
+	if ( ! mm_atom_types.empty() ) mm_atom_type_set( cm->mm_atom_type_set( mm_atom_types ) );
+	if ( ! orbital_types.empty() ) orbital_type_set( cm->orbital_type_set( orbital_types ) );
+	for ( ResidueTypeOP const & restype : restypes ) {
+		add_base_residue_type( restype );
+	}
+	database_patches = patches;
+	database_metapatches = metapatches;
+
+	TR << "Restored " << restypes.size() << " residue types and " << patches.size() << " patches for "
+		<< name() << " from " << filename << std::endl;
+	return true;
+#else
+	(void) database_patches; (void) database_metapatches;
+	return false;
+#endif
+}
+
+/// @details The snapshot is written to a temporary file in the cache directory and renamed into
+/// place, so concurrent processes starting up against the same cache never see a partial file.
+/// Failing to write the snapshot is not an error: the next run simply reads the database again.
+void
+GlobalResidueTypeSet::write_database_snapshot(
+	Size const n_database_types,
+	Size const n_commandline_patches,
+	Size const n_commandline_metapatches
+) const {
+#ifdef SERIALIZATION
+	if ( ! database_snapshot_enabled() ) return;
+
+	std::string const key( database_snapshot_key() );
+	std::string const filename( database_snapshot_filename( key, true ) );
+	if ( filename.empty() ) return;
+
+	std::string const tempname( utility::file::create_temp_filename( utility::file::FileName( filename ).path(), "rts_snapshot" ) );
+	{
+		std::ofstream out( tempname.c_str(), std::ios::out | std::ios::binary );
+		if ( ! out.good() ) {
+			TR.Warning << "Unable to write residue type set snapshot " << tempname << std::endl;
+			return;
+		}
+		cereal::BinaryOutputArchive arc( out );
+		arc( key, mode() );
+		arc( std::string( atom_type_set() ? atom_type_set()->name() : "" ) );
+		arc( std::string( element_set() ? element_set()->name() : "" ) );
+		arc( std::string( mm_atom_type_set() ? mm_atom_type_set()->name() : "" ) );
+		arc( std::string( orbital_type_set() ? orbital_type_set()->name() : "" ) );
+
+		ResidueTypeCOPs const & restypes( base_residue_types() );
+		arc( n_database_types );
+		for ( Size ii = 1; ii <= n_database_types; ++ii ) {
+			arc( *restypes[ ii ] );
+		}
+		utility::vector1< PatchCOP > const all_patches( patches() );
+		arc( Size( all_patches.size() - n_commandline_patches ) );
+		for ( Size ii = n_commandline_patches + 1; ii <= all_patches.size(); ++ii ) {
+			arc( *all_patches[ ii ] );
+		}
+		utility::vector1< MetapatchCOP > const all_metapatches( metapatches() );
+		arc( Size( all_metapatches.size() - n_commandline_metapatches ) );
+		for ( Size ii = n_commandline_metapatches + 1; ii <= all_metapatches.size(); ++ii ) {
+			arc( *all_metapatches[ ii ] );
+		}
+		if ( ! out.good() ) {
+			TR.Warning << "Unable to write residue type set snapshot " << tempname << std::endl;
+			out.close();
+			utility::file::file_delete( tempname );
+			return;
+		}
+	}
+	if ( std::rename( tempname.c_str(), filename.c_str() ) != 0 ) {
+		utility::file::file_delete( tempname );
+		return;
+	}
+	TR << "Wrote residue type set snapshot for " << name() << " to " << filename << std::endl;
+#else
+	(void) n_database_types; (void) n_commandline_patches; (void) n_commandline_metapatches;
+#endif
+}
+
 GlobalResidueTypeSet::~GlobalResidueTypeSet() = default;
 
 //////////////////////////////////////////////////////////////////////////////
@@ -92,6 +92,44 @@ private:
 	void
 	place_adducts();
 
+	/// @brief Whether database snapshots are enabled and usable with the current options.
+	bool
+	database_snapshot_enabled() const;
+
+	/// @brief The SHA-1 of the contents of each of these files, by file name.
+	std::map< std::string, std::string >
+	database_file_hashes( utility::vector1< std::string > const & files ) const;
+
+	/// @brief Describe everything that determines what init_restypes_from_database() and
+	/// init_patches_from_database() produce: the database files, down to the contents of each
+	/// params and patch file, plus the options that affect them; snapshots are only reused when
+	/// this matches exactly.
+	std::string
+	database_snapshot_key() const;
+
+	/// @brief Where the database snapshot for this set lives (or would be written); empty if no
+	/// usable cache location exists.
+	std::string
+	database_snapshot_filename( std::string const & key, bool for_writing ) const;
+
+	/// @brief Restore the ResidueTypes read by init_restypes_from_database() from a snapshot,
+	/// returning the snapshotted database patches and metapatches to be added in their turn.
+	/// @details Returns false, leaving the set untouched, if there is no snapshot for the current
+	/// database and options.
+	bool
+	load_database_snapshot(
+		utility::vector1< PatchCOP > & database_patches,
+		utility::vector1< MetapatchCOP > & database_metapatches );
+
+	/// @brief Write the database-derived portion of the set to a snapshot for later runs.
+	/// @details The first n_database_types base types were read from the database, as were all
+	/// patches and metapatches after the first n_commandline_patches/n_commandline_metapatches.
+	void
+	write_database_snapshot(
+		Size const n_database_types,
+		Size const n_commandline_patches,
+		Size const n_commandline_metapatches ) const;
+
 	//////////////////
 	// public methods
 public:
@@ -105,6 +105,8 @@ namespace conformation {
 
 using namespace ObjexxFCL;
 
+std::atomic< Size > Conformation::last_residue_stamp_( 0 );
+
 // Standard class methods ////////////////////////////////////////////////////////////////////////////////////////////
 
 // default destructor
@@ -185,6 +187,7 @@ Conformation::Conformation( Conformation const & src ) :
 	dof_moved_ = src.dof_moved_;
 	xyz_moved_ = src.xyz_moved_;
 	structure_moved_ = src.structure_moved_;
+	residue_stamps_ = src.residue_stamps_;
 
 	// final update of records -- keep this last:
 	for ( core::Size i=1, imax=parameters_set_.size(); i<=imax; ++i ) {
@@ -255,6 +258,7 @@ Conformation::operator=( Conformation const & src )
 		xyz_moved_ = src.xyz_moved_;
 
 		structure_moved_ = src.structure_moved_;
+		residue_stamps_ = src.residue_stamps_;
 
 		// length may have radically changed, tell length observers to invalidate their data
 		notify_length_obs( LengthEvent( this, LengthEvent::INVALIDATE, 0, 0, nullptr ), false );
@@ -301,6 +305,7 @@ Conformation::clear()
 	dof_moved_.clear();
 	xyz_moved_.clear();
 	chain_endings_.clear();
+	residue_stamps_.clear();
 }
 
 
@@ -744,6 +749,7 @@ Conformation::update_membrane_position( Vector center, Vector normal ) {
 	}
 
 	// Set membrane center
+	note_residue_changed( membrane_info_->membrane_rsd_num() );
 	residues_[ membrane_info_->membrane_rsd_num() ]->set_xyz( membrane::center, center );
 
 	// Set membrane normal
@@ -812,6 +818,12 @@ Conformation::clear_glycan_trees(){
 
 // Trees /////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void
+Conformation::refold_threads( Size nthreads )
+{
+	atom_tree_->refold_threads( nthreads );
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @details setup atom tree as well from the fold tree
 void
@@ -1658,8 +1670,8 @@ Conformation::declare_chemical_bond(
 )
 {
 
-	Residue & rsd1( *residues_[ seqpos1 ] );
-	Residue & rsd2( *residues_[ seqpos2 ] );
+	Residue & rsd1( residue_( seqpos1 ) );
+	Residue & rsd2( residue_( seqpos2 ) );
 
 	// find the connection ids
 	Size const atom1( rsd1.atom_index( atom_name1 ) );
@@ -2676,6 +2688,7 @@ Conformation::set_torsion( TorsionID const & tor_id, Real const setting )
 		atom_tree_->set_dof( dof_id, setting );
 	} else /* BB, CHI, or NU */ {
 		// Update residue torsions.
+		note_residue_changed( tor_id.rsd() );
 		switch (tor_id.type()) {
 		case id::BB :
 			{
@@ -2919,6 +2932,7 @@ Conformation::set_xyz(
 	if ( !atom_tree_->empty() ) atom_tree_->set_xyz( id, position );
 
 	// update residue coords
+	note_residue_changed( id.rsd() );
 	residues_[ id.rsd() ]->set_xyz( id.atomno(), position );
 
 	// notify scoring
@@ -2938,6 +2952,7 @@ Conformation::batch_set_xyz(
 
 	// update residue coords
 	for ( core::Size i=1; i<=ids.size(); ++i ) {
+		note_residue_changed( ids[i].rsd() );
 		residues_[ ids[i].rsd() ]->set_xyz( ids[i].atomno(), positions[i] );
 	}
 
@@ -3056,7 +3071,9 @@ Conformation::update_actcoords()
 {
 	for ( Size ii = 1; ii <= size(); ++ii ) {
 		if ( residues_[ ii ]->requires_actcoord() ) {
+			Vector const actcoord( residues_[ ii ]->actcoord() );
 			residues_[ ii ]->update_actcoord();
+			if ( residues_[ ii ]->actcoord() != actcoord ) note_residue_changed( ii );
 		}
 	}
 }
@@ -3065,6 +3082,7 @@ void
 Conformation::update_actcoord( Size resid )
 {
 	if ( residues_[ resid ]->requires_actcoord() ) {
+		note_residue_changed( resid );
 		residues_[ resid ]->update_actcoord();
 	}
 }
@@ -3483,6 +3501,8 @@ Conformation::update_sequence_numbering(
 	// xyz_moved, dof_moved
 	xyz_moved_.update_sequence_numbering( new_size, old2new );
 	dof_moved_.update_sequence_numbering( new_size, old2new );
+
+	note_all_residues_changed();
 }
 
 
@@ -3642,6 +3662,7 @@ Conformation::residues_replace(
 	int const old_chain = residues_[ seqpos ]->chain();
 	ResidueOP old_residue = residues_[ seqpos ];
 	residues_[ seqpos ] = new_rsd.clone();
+	note_residue_changed( seqpos );
 	residues_[ seqpos ]->seqpos( seqpos );
 	residues_[ seqpos ]->chain( old_chain );
 	residues_[ seqpos ]->copy_residue_connections( *old_residue );
@@ -3711,6 +3732,7 @@ Conformation::residues_insert(
 	Size const newrsd_chain( new_chain ? old_chain + 1 :old_chain );
 
 	residues_.insert( residues_.begin() + (seqpos-1), new_rsd.clone() );
+	note_all_residues_changed();
 	debug_assert( residues_[seqpos]->name() == new_rsd.name() );
 	residues_[ seqpos ]->seqpos( seqpos );
 	residues_[ seqpos ]->chain( newrsd_chain );
@@ -3757,6 +3779,7 @@ Conformation::residues_delete(
 
 	// delete from residues_
 	residues_.erase( residues_.begin()+seqpos-1 );
+	note_all_residues_changed();
 
 	// now renumber things
 	utility::vector1< Size > old2new( old_size, 0 );
@@ -3786,6 +3809,7 @@ void
 Conformation::residues_append( Residue const & new_rsd, bool const start_new_chain, bool const by_jump, std::string const & root_atom, id::NamedAtomID anchor_id)
 {
 	residues_.push_back( new_rsd.clone() );
+	note_all_residues_changed();
 	// ensure that the residue number is set
 	Size const nres( residues_.size() );
 	residues_[ nres ]->seqpos( nres );
@@ -5894,6 +5918,7 @@ Conformation::update_residue_coordinates() const
 void
 Conformation::update_residue_coordinates( Size const seqpos, bool const fire_signal ) const
 {
+	note_residue_changed( seqpos );
 	Residue & rsd( *residues_[ seqpos ] );
 	for ( Size j=1, j_end = rsd.natoms(); j<= j_end; ++j ) {
 		rsd.set_xyz( j, atom_tree_->xyz( AtomID(j,seqpos) ) );
@@ -5950,7 +5975,9 @@ Conformation::update_residue_torsions() const
 	PROF_START( basic::UPDATE_RESIDUE_TORSIONS );
 	for ( Size i=1, i_end = size(); i<= i_end; ++i ) {
 		update_residue_torsions( i, false );
+		Vector const actcoord( residues_[ i ]->actcoord() );
 		residues_[ i ]->update_actcoord();
+		if ( residues_[ i ]->actcoord() != actcoord ) note_residue_changed( i );
 	}
 	PROF_STOP( basic::UPDATE_RESIDUE_TORSIONS );
 
@@ -5965,6 +5992,7 @@ Conformation::update_residue_torsions( Size const seqpos, bool const fire_signal
 	using id::NU;
 
 	Residue & rsd( *residues_[seqpos] );
+	bool changed( false ); // renew the stamp only if a torsion did change
 
 	// mainchain
 	for ( Size j=1, j_end = rsd.mainchain_torsions().size(); j<= j_end; ++j ) {
@@ -5980,24 +6008,33 @@ Conformation::update_residue_torsions( Size const seqpos, bool const fire_signal
 				//TR << "amw torsion " << j << " has atoms " << const_residue_( id1.rsd() ).atom_name(id1.atomno()) << "-" << const_residue_( id2.rsd() ).atom_name(id2.atomno()) << "-" << const_residue_( id3.rsd() ).atom_name(id3.atomno()) << "-" << const_residue_( id4.rsd() ).atom_name(id4.atomno()) << "." << std::endl;
 				//TR << "amw torsion " << j << " has atoms " << id1.atomno() << "-" << id2.atomno() << "-" << id3.atomno() << "-" << id4.atomno() << "." << std::endl;
 				//TR << "amw about to assign torison " << j << " the value " << atom_tree_torsion( TorsionID(seqpos, BB, j)) << std::endl;
-				rsd.mainchain_torsions()[ j ] = atom_tree_torsion( TorsionID(seqpos,BB,j) );
+				Real const setting( atom_tree_torsion( TorsionID(seqpos,BB,j) ) );
+				changed |= ( rsd.mainchain_torsions()[ j ] != setting );
+				rsd.mainchain_torsions()[ j ] = setting;
 			}
 		} else {
 			// normal residue
-			rsd.mainchain_torsions()[ j ] = atom_tree_torsion( TorsionID(seqpos,BB,j) );
+			Real const setting( atom_tree_torsion( TorsionID(seqpos,BB,j) ) );
+			changed |= ( rsd.mainchain_torsions()[ j ] != setting );
+			rsd.mainchain_torsions()[ j ] = setting;
 		}
 	}
 
 	// chi
 	for ( Size j=1, j_end = rsd.nchi(); j<= j_end; ++j ) {
-		rsd.chi()[ j ] = atom_tree_torsion( TorsionID( seqpos, CHI, j ) );
+		Real const setting( atom_tree_torsion( TorsionID( seqpos, CHI, j ) ) );
+		changed |= ( rsd.chi()[ j ] != setting );
+		rsd.chi()[ j ] = setting;
 	}
 
 	// nu
 	Size const n_nus( rsd.n_nus() );
 	for ( core::uint j( 1 ); j <= n_nus; ++j ) {
-		rsd.nus()[ j ] = atom_tree_torsion( TorsionID( seqpos, NU, j ) );
+		Real const setting( atom_tree_torsion( TorsionID( seqpos, NU, j ) ) );
+		changed |= ( rsd.nus()[ j ] != setting );
+		rsd.nus()[ j ] = setting;
 	}
+	if ( changed ) note_residue_changed( seqpos );
 
 	//update orbital coords!
 	this->update_orbital_coords(rsd);
@@ -6040,6 +6077,23 @@ Conformation::add_pseudobond(
 }
 
 
+void
+Conformation::note_residue_changed( Size const seqpos ) const
+{
+	if ( residue_stamps_.size() != residues_.size() ) {
+		note_all_residues_changed();
+	} else {
+		residue_stamps_[ seqpos ] = ++last_residue_stamp_;
+	}
+}
+
+/// @details One new stamp for all residues will do: it is still held by no other conformation.
+void
+Conformation::note_all_residues_changed() const
+{
+	residue_stamps_.assign( residues_.size(), ++last_residue_stamp_ );
+}
+
 void
 Conformation::in_place_copy(
 	Conformation const & src
@@ -6049,12 +6103,15 @@ Conformation::in_place_copy(
 
 	/// BEGIN IN PLACE OPTIMIZATION
 
-	// Do not allocate new residue objects, just reuse the old ones
+	// Do not allocate new residue objects, just reuse the old ones, and skip those that
+	// already hold the same data as their counterparts in src
+	bool const stamps_match( residue_stamps_.size() == size() && src.residue_stamps_.size() == size() );
 	for ( Size ii = 1; ii <= size(); ++ii ) {
 		runtime_assert( & residues_[ ii ]->type() ==  & src.residues_[ ii ]->type() );
 		runtime_assert( residues_[ ii ]->seqpos() == src.residues_[ ii ]->seqpos() );
 		runtime_assert( residues_[ ii ]->chain() == src.residues_[ ii ]->chain() );
 		runtime_assert( residues_[ ii ]->connections_match( *src.residues_[ ii ] ));
+		if ( stamps_match && residue_stamps_[ ii ] == src.residue_stamps_[ ii ] ) continue;
 		for ( Size jj = 1; jj <= residues_[ ii ]->natoms(); ++jj ) {
 			residues_[ ii ]->set_xyz( jj, src.residues_[ ii ]->xyz( jj ) );
 		}
@@ -6062,6 +6119,11 @@ Conformation::in_place_copy(
 		residues_[ ii ]->chi( src.residues_[ ii ]->chi() );
 		residues_[ ii ]->actcoord() = src.residues_[ ii ]->actcoord();
 	}
+	if ( src.residue_stamps_.size() == size() ) {
+		residue_stamps_ = src.residue_stamps_;
+	} else {
+		note_all_residues_changed();
+	}
 
 	/// END IN PLACE OPTIMIZATION
 
@@ -6221,6 +6283,7 @@ core::conformation::Conformation::save( Archive & arc ) const {
 	arc( CEREAL_NVP( dof_moved_ ) ); // AtomID_Mask
 	arc( CEREAL_NVP( xyz_moved_ ) ); // AtomID_Mask
 	arc( CEREAL_NVP( structure_moved_ ) ); // _Bool
+	// EXEMPT residue_stamps_ -- stamps are only unique within one process
 	arc( CEREAL_NVP( secstruct_ ) ); // utility::vector1<char>
 
 	// Don't serialize observers; they cannot readily be tracked when a Conformation is shipped between nodes
@@ -6256,6 +6319,7 @@ core::conformation::Conformation::load( Archive & arc ) {
 	arc( dof_moved_ ); // AtomID_Mask
 	arc( xyz_moved_ ); // AtomID_Mask
 	arc( structure_moved_ ); // _Bool
+	// EXEMPT residue_stamps_
 	arc( secstruct_ ); // utility::vector1<char>
 
 	// Don't deserialize the observer data
@@ -72,6 +72,9 @@
 
 #include <boost/iterator/indirect_iterator.hpp>
 
+// C++ headers
+#include <atomic>
+
 
 #ifdef    SERIALIZATION
 // Cereal headers
@@ -83,6 +86,12 @@ namespace conformation {
 
 
 /// @brief A container of Residues and the kinematics to manage them
+///
+/// @details Copying one Conformation onto another of the same sequence (in_place_copy(),
+/// as MonteCarlo does on every accept and reject) rewrites only the residues whose data
+/// differ, tracked by residue_stamps_.  The AtomTree is still copied in full, and the
+/// Energies, which the Pose copies alongside, are too, so the whole copy still scales
+/// with the size of the pose; only its residue part scales with the number of changes.
 class Conformation : public utility::pointer::ReferenceCount, public utility::pointer::enable_shared_from_this< Conformation >
 {
 	friend class ::ConformationTests; //Needed to allow the ConformationTests to test private member functions of the Conformation class.
@@ -478,6 +487,11 @@ public:  // Trees
 		return *atom_tree_;
 	}
 
+	/// @brief Refold the parts of the AtomTree built from different jumps in up to
+	/// nthreads threads; see AtomTree::refold_threads()
+	void
+	refold_threads( Size nthreads );
+
 
 public:  // Residues
 
@@ -541,7 +555,7 @@ public:  // Residues
 		runtime_assert_string_msg( seqpos <= size(), "Error in core::conformation::Conformation::residue_data(): The sequence position requested was greater than the number of residues in the pose." );
 		if ( residue_coordinates_need_updating_ ) update_residue_coordinates();
 		if ( residue_torsions_need_updating_ )    update_residue_torsions();
-		return *residue_( seqpos ).nonconst_data_ptr();
+		return *residues_[ seqpos ]->nonconst_data_ptr(); // in_place_copy() leaves the data cache be
 	}
 
 	/// @brief access one of the residues, using COP
@@ -1436,14 +1450,24 @@ private:
 	/// with a call to residue(seqpos).
 	/// @note APL -- Conformation should not give out non-const access to its residues even to derived
 	/// classes.  This function should *not* be called by derived classes.
+	/// @note Renews the residue's stamp, as the caller may change it.
 	Residue &
 	residue_( Size seqpos )
 	{
 		debug_assert( seqpos >=1 );
 		debug_assert( seqpos <= size() );
+		note_residue_changed( seqpos );
 		return *residues_[ seqpos ];
 	}
 
+	/// @brief Give a residue a new stamp; see residue_stamps_
+	void
+	note_residue_changed( Size seqpos ) const;
+
+	/// @brief Give every residue a new stamp, e.g. when residues are added or removed
+	void
+	note_all_residues_changed() const;
+
 	/// @brief remap *_moved arrays, sequence numbering in the residues_ arrays, etc, after insertion or deletion of rsds
 	void
 	update_sequence_numbering(
@@ -1660,6 +1684,8 @@ private:  // setting the moved data
 
 
 	/// @brief Optimizing the common case of assigning a conformation to another with the same sequence.
+	/// @details Residues are copied only if their stamps differ; the fold tree and AtomTree
+	/// are copied in full.
 	void
 	in_place_copy(
 		Conformation const & src
@@ -1770,6 +1796,17 @@ private:
 
 	utility::vector1< char > secstruct_;
 
+	/// @brief A stamp per residue, renewed whenever the residue's coordinates, torsions or
+	/// actcoord may change, and copied along with them.
+	/// @details Residues holding the same stamp in two conformations hold the same data, so
+	/// in_place_copy() -- as when MonteCarlo copies a trial pose into its last accepted pose and
+	/// back -- copies only the residues that differ.  A list that does not match the number of
+	/// residues marks every residue as changed.
+	mutable utility::vector1< Size > residue_stamps_;
+
+	/// @brief The last stamp handed out, shared by all conformations
+	static std::atomic< Size > last_residue_stamp_;
+
 	/// @brief ConnectionEvent observers
 	/// @remarks Notification only occurs when there is a change in the state
 	///  of the connection between observers and the Conformation object, e.g.
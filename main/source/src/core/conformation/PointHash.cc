@@ -0,0 +1,109 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/conformation/PointHash.cc
+/// @brief  A persistent spatial hash of indexed points, for incremental neighbor detection
+
+// Unit headers
+#include <core/conformation/PointHash.hh>
+
+// Utility headers
+#include <utility/exit.hh>
+
+// C++ headers
+#include <cmath>
+
+namespace core {
+namespace conformation {
+
+PointHash::PointHash() :
+	cube_side_( 0 )
+{}
+
+PointHash::~PointHash() = default;
+
+void
+PointHash::reset( utility::vector1< PointPosition > const & points, Real cube_side )
+{
+	runtime_assert( cube_side > 0 );
+	clear();
+	cube_side_ = cube_side;
+	points_ = points;
+	point_keys_.resize( points_.size() );
+	index_in_cube_.resize( points_.size() );
+	for ( Size ii = 1; ii <= points_.size(); ++ii ) {
+		insert( ii, cube_key( points_[ ii ] ) );
+	}
+}
+
+void
+PointHash::clear()
+{
+	points_.clear();
+	point_keys_.clear();
+	index_in_cube_.clear();
+	cubes_.clear();
+}
+
+void
+PointHash::move_point( Size id, PointPosition const & xyz )
+{
+	points_[ id ] = xyz;
+	Key const key( cube_key( xyz ) );
+	if ( key == point_keys_[ id ] ) return;
+	remove( id );
+	insert( id, key );
+}
+
+int
+PointHash::cube_index( Real coord ) const
+{
+	return static_cast< int >( std::floor( coord / cube_side_ ) );
+}
+
+/// @details Packs three 21-bit two's-complement cube indices into one integer.
+PointHash::Key
+PointHash::cube_key( int ix, int iy, int iz )
+{
+	Key const mask( ( Key( 1 ) << 21 ) - 1 );
+	return ( ( Key( ix ) & mask ) << 42 ) | ( ( Key( iy ) & mask ) << 21 ) | ( Key( iz ) & mask );
+}
+
+PointHash::Key
+PointHash::cube_key( PointPosition const & xyz ) const
+{
+	return cube_key( cube_index( xyz.x() ), cube_index( xyz.y() ), cube_index( xyz.z() ) );
+}
+
+void
+PointHash::insert( Size id, Key key )
+{
+	utility::vector1< Size > & cube( cubes_[ key ] );
+	cube.push_back( id );
+	point_keys_[ id ] = key;
+	index_in_cube_[ id ] = cube.size();
+}
+
+void
+PointHash::remove( Size id )
+{
+	auto cube_iter( cubes_.find( point_keys_[ id ] ) );
+	debug_assert( cube_iter != cubes_.end() );
+	utility::vector1< Size > & cube( cube_iter->second );
+
+	// Swap the last point in the cube into the removed point's slot
+	Size const last( cube.back() );
+	cube[ index_in_cube_[ id ] ] = last;
+	index_in_cube_[ last ] = index_in_cube_[ id ];
+	cube.pop_back();
+	if ( cube.empty() ) cubes_.erase( cube_iter );
+}
+
+} // namespace conformation
+} // namespace core
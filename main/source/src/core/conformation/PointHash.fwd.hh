@@ -0,0 +1,29 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/conformation/PointHash.fwd.hh
+/// @brief  forward declaration of the persistent spatial hash for incremental neighbor detection
+
+#ifndef INCLUDED_core_conformation_PointHash_fwd_hh
+#define INCLUDED_core_conformation_PointHash_fwd_hh
+
+#include <utility/pointer/owning_ptr.hh>
+
+namespace core {
+namespace conformation {
+
+class PointHash;
+
+typedef utility::pointer::shared_ptr< PointHash > PointHashOP;
+typedef utility::pointer::shared_ptr< PointHash const > PointHashCOP;
+
+} // namespace conformation
+} // namespace core
+
+#endif
@@ -0,0 +1,120 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/conformation/PointHash.hh
+/// @brief  A persistent spatial hash of indexed points, for incremental neighbor detection
+
+#ifndef INCLUDED_core_conformation_PointHash_hh
+#define INCLUDED_core_conformation_PointHash_hh
+
+// Unit headers
+#include <core/conformation/PointHash.fwd.hh>
+
+// Package headers
+#include <core/conformation/find_neighbors.fwd.hh>
+#include <core/types.hh>
+
+// Utility headers
+#include <utility/pointer/ReferenceCount.hh>
+#include <utility/vector1.hh>
+
+// Numeric headers
+#include <numeric/xyzVector.hh>
+
+// C++ headers
+#include <cstdint>
+#include <unordered_map>
+
+namespace core {
+namespace conformation {
+
+/// @brief A uniform grid of cubes, each listing the points that fall inside it, kept
+/// alive between neighbor calculations so that when only a few points move, only those
+/// few are re-binned.
+///
+/// @details Where find_neighbors() rebuilds its octree or grid from scratch and reports
+/// every neighbor pair, the %PointHash is built once and then updated one point at a
+/// time with move_point(); neighbors of a single point are found with
+/// for_each_neighbor(), which visits the 27 cubes around it.  The cube side is fixed at
+/// construction, and neighbor queries may not use a larger cutoff.  Cubes are keyed by
+/// signed integer coordinates, so points may be anywhere within about a million cube
+/// widths of the origin.
+class PointHash : public utility::pointer::ReferenceCount
+{
+public:
+	PointHash();
+	~PointHash() override;
+
+	/// @brief Discard the current contents and bin the given points, with ids 1..N
+	void reset( utility::vector1< PointPosition > const & points, Real cube_side );
+
+	/// @brief Empty the hash; is_empty() is true afterwards
+	void clear();
+
+	bool is_empty() const { return points_.empty(); }
+
+	/// @brief The number of points in the hash
+	Size size() const { return points_.size(); }
+
+	Real cube_side() const { return cube_side_; }
+
+	PointPosition const & point( Size id ) const { return points_[ id ]; }
+
+	/// @brief Update the position of one point, moving it to a new cube if it has left its old one
+	void move_point( Size id, PointPosition const & xyz );
+
+	/// @brief Call f( id, distance_squared ) for every point other than exclude_id within
+	/// cutoff of xyz.  The cutoff must not exceed the cube side.
+	template < class F >
+	void
+	for_each_neighbor( PointPosition const & xyz, Real cutoff, Size exclude_id, F && f ) const
+	{
+		debug_assert( cutoff <= cube_side_ );
+		Real const cutoff_sq( cutoff * cutoff );
+		int const cx( cube_index( xyz.x() ) ), cy( cube_index( xyz.y() ) ), cz( cube_index( xyz.z() ) );
+		for ( int ix = cx - 1; ix <= cx + 1; ++ix ) {
+			for ( int iy = cy - 1; iy <= cy + 1; ++iy ) {
+				for ( int iz = cz - 1; iz <= cz + 1; ++iz ) {
+					auto const cube( cubes_.find( cube_key( ix, iy, iz ) ) );
+					if ( cube == cubes_.end() ) continue;
+					for ( Size const id : cube->second ) {
+						if ( id == exclude_id ) continue;
+						Real const d_sq( xyz.distance_squared( points_[ id ] ) );
+						if ( d_sq <= cutoff_sq ) f( id, d_sq );
+					}
+				}
+			}
+		}
+	}
+
+private:
+	typedef std::uint64_t Key;
+
+	int cube_index( Real coord ) const;
+
+	static Key cube_key( int ix, int iy, int iz );
+
+	Key cube_key( PointPosition const & xyz ) const;
+
+	void insert( Size id, Key key );
+
+	void remove( Size id );
+
+private:
+	Real cube_side_;
+	utility::vector1< PointPosition > points_;
+	utility::vector1< Key > point_keys_;
+	utility::vector1< Size > index_in_cube_; // position of each point in its cube's list
+	std::unordered_map< Key, utility::vector1< Size > > cubes_;
+};
+
+} // namespace conformation
+} // namespace core
+
+#endif
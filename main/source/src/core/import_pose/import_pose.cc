@@ -49,6 +49,7 @@
 #include <core/pack/pack_missing_sidechains.hh>
 #include <core/pack/optimizeH.hh>
 
+#include <core/io/flat_atom_reader.hh>
 #include <core/io/pdb/pdb_reader.hh>
 #include <core/io/pdb/RecordType.hh>
 #include <core/io/silent/SilentFileOptions.hh>
@@ -83,6 +84,7 @@
 #include <utility/exit.hh>
 #include <utility/string_util.hh>
 #include <utility/io/izstream.hh>
+#include <utility/io/MappedFile.hh>
 #include <utility/vector1.hh>
 #include <utility/vector1.functions.hh>
 
@@ -714,6 +716,60 @@ void pose_from_pdb_stream(
 	pose_from_pdbstring( pose, pdb_file_contents, *residue_set, options, filename);
 }
 
+void
+pose_from_atom_records_file(
+	pose::Pose & pose,
+	std::string const & filename,
+	ImportPoseOptions const & options
+) {
+	using namespace chemical;
+
+	utility::io::MappedFile file;
+	io::FlatAtoms atoms;
+	bool const plain_file( filename.find( ' ' ) == std::string::npos &&
+		! boost::algorithm::ends_with( filename, ".gz" ) && ! boost::algorithm::ends_with( filename, ".mmtf" ) &&
+		! boost::algorithm::ends_with( filename, ".srlz" ) );
+	// Anything that yields no atoms -- a serialized pose, an SDF or mol2 file, ... -- is not a
+	// .pdb or mmCIF file, and is left to the regular reader to recognize.
+	if ( ! plain_file || ! file.open( filename ) ||
+			! io::read_flat_atoms_from_file_contents( file.data(), file.data() + file.size(), options, atoms ) ||
+			atoms.atoms.empty() ) {
+		TR.Debug << "Reading " << filename << " with the regular reader." << std::endl;
+		pose_from_file( pose, filename, options, false, Unknown_file );
+		return;
+	}
+	file.close();
+
+	ResidueTypeSetCOP residue_set( options.centroid() ?
+		pose.residue_type_set_for_pose( CENTROID_t ) :
+		pose.residue_type_set_for_pose( FULL_ATOM_t )
+	);
+
+	//fpd If the conformation is not of type core::Conformation, reset it
+	conformation::ConformationOP conformation_op( new conformation::Conformation() );
+	if ( !pose.conformation().same_type_as_me( *conformation_op, true ) ) {
+		pose.set_new_conformation( conformation_op );
+	}
+
+	io::StructFileRepOP sfr( io::create_sfr_from_flat_atoms( atoms ) );
+	sfr->filename() = filename;
+	build_pose( sfr, pose, *residue_set, options );
+
+	// set secondary structure for centroid PDBs
+	if ( residue_set->mode() == CENTROID_t ) {
+		core::pose::set_ss_from_phipsi( pose );
+	}
+}
+
+void
+pose_from_atom_records_file(
+	pose::Pose & pose,
+	std::string const & filename
+) {
+	ImportPoseOptions options;
+	pose_from_atom_records_file( pose, filename, options );
+}
+
 void
 centroid_pose_from_pdb(
 	pose::Pose & pose,
@@ -300,6 +300,27 @@ void pose_from_pdb_stream(
 	ImportPoseOptions const & options
 );
 
+/// @brief Build a pose from just the ATOM/HETATM records of a .pdb or mmCIF file, read in a
+/// single pass over the memory-mapped file (see core/io/flat_atom_reader.hh).
+/// @details For bulk input of structures to score: header records, remarks, LINK and SSBOND
+/// records and the Rosetta-specific extra data (fold trees, comments, ...) are not read.  Files the
+/// single-pass reader cannot handle (gzipped files, options like -new_chain_order) and files in
+/// which it finds no atoms (other formats, such as .srlz, SDF or mol2) are read by pose_from_file()
+/// instead.  This is a separate entry point for bulk-scoring callers; pose_from_file() itself does
+/// not use the single-pass reader.
+void
+pose_from_atom_records_file(
+	pose::Pose & pose,
+	std::string const & filename,
+	ImportPoseOptions const & options
+);
+
+void
+pose_from_atom_records_file(
+	pose::Pose & pose,
+	std::string const & filename
+);
+
 // uses the CENTROID residue_set
 
 /// @brief Reads in data from input PDB  <filename>  and stores it in the Pose
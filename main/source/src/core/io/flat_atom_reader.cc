@@ -0,0 +1,498 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/io/flat_atom_reader.cc
+/// @brief  Single-pass readers of the coordinate records of .pdb and mmCIF files, for bulk input
+
+// Unit headers
+#include <core/io/flat_atom_reader.hh>
+
+// Package headers
+#include <core/io/AtomInformation.hh>
+#include <core/io/StructFileRep.hh>
+#include <core/io/StructFileReaderOptions.hh>
+
+// Basic headers
+#include <basic/Tracer.hh>
+
+// Utility headers
+#include <utility/vector1.hh>
+
+// C++ headers
+#include <cstdlib>
+#include <cstring>
+
+static basic::Tracer TR( "core.io.flat_atom_reader" );
+
+namespace core {
+namespace io {
+
+namespace {
+
+bool
+is_line_end( char c ) {
+	return c == '\n' || c == '\r';
+}
+
+bool
+is_blank( char c ) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/// @brief The end of the line starting at begin
+char const *
+line_end( char const * begin, char const * end ) {
+	char const * pos( begin );
+	while ( pos != end && ! is_line_end( *pos ) ) ++pos;
+	return pos;
+}
+
+// .pdb records //////////////////////////////////////////////////////////////
+
+/// @brief A line of a .pdb file, read as if padded with spaces to any width (as the regular
+/// reader pads lines to 80 columns)
+class PDBLine
+{
+public:
+	PDBLine( char const * begin, char const * end ) : begin_( begin ), length_( end - begin ) {}
+
+	/// @brief The character in a column (1-based)
+	char column( Size col ) const { return col <= length_ ? begin_[ col - 1 ] : ' '; }
+
+	/// @brief Copy the columns [first, last] (1-based, inclusive) and a terminating NUL to out
+	void copy( Size first, Size last, char * out ) const {
+		for ( Size col = first; col <= last; ++col ) *out++ = column( col );
+		*out = '\0';
+	}
+
+	/// @brief Do the columns starting at first read text?
+	bool equals( Size first, char const * text ) const {
+		for ( Size col = first; *text; ++col, ++text ) {
+			if ( column( col ) != *text ) return false;
+		}
+		return true;
+	}
+
+	int to_int( Size first, Size last ) const {
+		char buffer[ 16 ];
+		copy( first, last, buffer );
+		return std::atoi( buffer );
+	}
+
+	double to_double( Size first, Size last ) const {
+		char buffer[ 16 ];
+		copy( first, last, buffer );
+		return std::atof( buffer );
+	}
+
+private:
+	char const * begin_;
+	Size length_;
+};
+
+// mmCIF tokens //////////////////////////////////////////////////////////////
+
+/// @brief A value of an mmCIF file, without its quotes
+struct CIFToken {
+	char const * begin;
+	char const * end;
+	bool quoted;
+
+	Size size() const { return end - begin; }
+
+	bool equals( char const * text ) const {
+		Size const length( std::strlen( text ) );
+		return size() == length && std::strncmp( begin, text, length ) == 0;
+	}
+
+	bool starts_with( char const * text ) const {
+		Size const length( std::strlen( text ) );
+		return size() >= length && std::strncmp( begin, text, length ) == 0;
+	}
+
+	/// @brief Copy the value and a terminating NUL into out, of the given capacity; false if it
+	/// does not fit
+	bool copy( char * out, Size capacity ) const {
+		if ( size() >= capacity ) return false;
+		std::memcpy( out, begin, size() );
+		out[ size() ] = '\0';
+		return true;
+	}
+
+	int to_int() const {
+		char buffer[ 32 ] = "";
+		copy( buffer, sizeof( buffer ) );
+		return std::atoi( buffer );
+	}
+
+	double to_double() const {
+		char buffer[ 32 ] = "";
+		copy( buffer, sizeof( buffer ) );
+		return std::atof( buffer );
+	}
+};
+
+/// @brief Read the next value at or after pos into token, skipping whitespace and comments.
+/// @return 0 at the end of the contents, -1 at a multi-line (semicolon-delimited) text field,
+/// which is not read, and 1 otherwise.
+int
+next_cif_token( char const * contents_begin, char const * & pos, char const * end, CIFToken & token ) {
+	while ( pos != end ) {
+		if ( is_blank( *pos ) ) {
+			++pos;
+		} else if ( *pos == '#' ) {
+			pos = line_end( pos, end );
+		} else {
+			break;
+		}
+	}
+	if ( pos == end ) return 0;
+
+	if ( *pos == ';' && ( pos == contents_begin || is_line_end( pos[ -1 ] ) ) ) return -1;
+
+	if ( *pos == '\'' || *pos == '"' ) {
+		// A quote closes the value only if followed by whitespace
+		char const quote( *pos );
+		char const * const value_begin( ++pos );
+		while ( pos != end && ! is_line_end( *pos ) && ! ( *pos == quote && ( pos + 1 == end || is_blank( pos[ 1 ] ) ) ) ) ++pos;
+		token.begin = value_begin;
+		token.end = pos;
+		token.quoted = true;
+		if ( pos != end && *pos == quote ) ++pos;
+		return 1;
+	}
+
+	token.begin = pos;
+	while ( pos != end && ! is_blank( *pos ) ) ++pos;
+	token.end = pos;
+	token.quoted = false;
+	return 1;
+}
+
+/// @brief Does an (unquoted) token end a loop, i.e. is it a data name or a reserved word?
+bool
+ends_cif_loop( CIFToken const & token ) {
+	if ( token.quoted ) return false;
+	return *token.begin == '_' || token.starts_with( "loop_" ) || token.starts_with( "data_" ) ||
+		token.starts_with( "save_" ) || token.equals( "stop_" ) || token.equals( "global_" );
+}
+
+/// @brief The columns of the _atom_site loop that are read; 0 for absent columns
+struct AtomSiteColumns {
+	Size group_PDB = 0, id = 0, type_symbol = 0;
+	Size label_atom_id = 0, label_alt_id = 0, label_comp_id = 0, label_asym_id = 0, label_seq_id = 0;
+	Size auth_atom_id = 0, auth_comp_id = 0, auth_asym_id = 0, auth_seq_id = 0;
+	Size pdbx_PDB_ins_code = 0, Cartn_x = 0, Cartn_y = 0, Cartn_z = 0;
+	Size occupancy = 0, B_iso_or_equiv = 0, pdbx_PDB_model_num = 0;
+
+	void set( CIFToken const & name, Size column ) {
+		std::string const item( name.begin + 11, name.end ); // after "_atom_site."
+		if ( item == "group_PDB" ) group_PDB = column;
+		else if ( item == "id" ) id = column;
+		else if ( item == "type_symbol" ) type_symbol = column;
+		else if ( item == "label_atom_id" ) label_atom_id = column;
+		else if ( item == "label_alt_id" ) label_alt_id = column;
+		else if ( item == "label_comp_id" ) label_comp_id = column;
+		else if ( item == "label_asym_id" ) label_asym_id = column;
+		else if ( item == "label_seq_id" ) label_seq_id = column;
+		else if ( item == "auth_atom_id" ) auth_atom_id = column;
+		else if ( item == "auth_comp_id" ) auth_comp_id = column;
+		else if ( item == "auth_asym_id" ) auth_asym_id = column;
+		else if ( item == "auth_seq_id" ) auth_seq_id = column;
+		else if ( item == "pdbx_PDB_ins_code" ) pdbx_PDB_ins_code = column;
+		else if ( item == "Cartn_x" ) Cartn_x = column;
+		else if ( item == "Cartn_y" ) Cartn_y = column;
+		else if ( item == "Cartn_z" ) Cartn_z = column;
+		else if ( item == "occupancy" ) occupancy = column;
+		else if ( item == "B_iso_or_equiv" ) B_iso_or_equiv = column;
+		else if ( item == "pdbx_PDB_model_num" ) pdbx_PDB_model_num = column;
+	}
+
+	/// @brief Are the columns the regular reader cannot do without present?
+	bool complete() const {
+		return id && label_alt_id && type_symbol && Cartn_x && Cartn_y && Cartn_z &&
+			( auth_comp_id || label_comp_id ) && ( auth_asym_id || label_asym_id ) && ( auth_seq_id || label_seq_id );
+	}
+};
+
+/// @brief A value with surrounding whitespace removed
+std::string
+stripped( CIFToken const & token ) {
+	char const * begin( token.begin ), * end( token.end );
+	while ( begin != end && is_blank( *begin ) ) ++begin;
+	while ( end != begin && is_blank( end[ -1 ] ) ) --end;
+	return std::string( begin, end );
+}
+
+} // anonymous namespace
+
+
+bool
+is_cif_contents( char const * begin, char const * end ) {
+	char const * pos( begin );
+	while ( pos != end ) {
+		if ( is_blank( *pos ) ) {
+			++pos;
+		} else if ( *pos == '#' ) {
+			pos = line_end( pos, end );
+		} else {
+			return end - pos >= 5 && std::strncmp( pos, "data_", 5 ) == 0;
+		}
+	}
+	return false;
+}
+
+/// @details Mirrors the ATOM/HETATM, MODEL, TER/END and ENDMDL branches of
+/// pdb::create_sfr_from_pdb_records(): lines are split at '\n' or '\r', shorter lines read as
+/// padded with spaces, and the fields converted with atoi()/atof() as there.
+bool
+read_flat_atoms_from_pdb_contents(
+	char const * begin,
+	char const * end,
+	StructFileReaderOptions const & options,
+	FlatAtoms & atoms
+) {
+	atoms.clear();
+	if ( options.new_chain_order() ) return false;
+
+	atoms.atoms.reserve( ( end - begin ) / 81 ); // an upper bound, with one atom per 80-column line
+
+	bool const only_ATOM( options.read_only_ATOM_entries() );
+	int ter_record_count( 0 );
+
+	for ( char const * pos( begin ); pos != end; ) {
+		char const * const eol( line_end( pos, end ) );
+		PDBLine const line( pos, eol );
+		pos = ( eol == end ) ? end : eol + 1;
+
+		bool const is_atom( line.equals( 1, "ATOM  " ) );
+		if ( is_atom || line.equals( 1, "HETATM" ) ) {
+			if ( ! is_atom && only_ATOM ) continue;
+
+			atoms.atoms.emplace_back();
+			FlatAtom & atom( atoms.atoms.back() );
+			atom.isHet = ! is_atom;
+			atom.serial = line.to_int( 7, 11 );
+			line.copy( 13, 16, atom.name );
+			atom.altLoc = line.column( 17 );
+			line.copy( 18, 20, atom.resName );
+			atom.chainID = line.column( 22 );
+			atom.resSeq = line.to_int( 23, 26 );
+			atom.iCode = line.column( 27 );
+
+			bool force_no_occupancy( false );
+			double * const xyz[ 3 ] = { &atom.x, &atom.y, &atom.z };
+			for ( Size ii = 0; ii < 3; ++ii ) {
+				Size const first( 31 + 8 * ii );
+				if ( line.equals( first, "     nan" ) ) {
+					*xyz[ ii ] = 0.0;
+					force_no_occupancy = true;
+				} else {
+					*xyz[ ii ] = line.to_double( first, first + 7 );
+				}
+			}
+			atom.occupancy = line.equals( 55, "      " ) ? 1.0 : line.to_double( 55, 60 );
+			if ( force_no_occupancy ) atom.occupancy = -1.0;
+			atom.temperature = line.to_double( 61, 66 );
+			line.copy( 73, 76, atom.segmentID );
+			line.copy( 77, 78, atom.element );
+			atom.terCount = ter_record_count;
+
+		} else if ( line.equals( 1, "MODEL " ) ) {
+			char serial[ 8 ];
+			line.copy( 11, 14, serial );
+			char const * first( serial ), * last( serial + std::strlen( serial ) );
+			while ( first != last && is_blank( *first ) ) ++first;
+			while ( last != first && is_blank( last[ -1 ] ) ) --last;
+			atoms.modeltag.assign( first, last );
+
+		} else if ( line.equals( 1, "TER   " ) || line.equals( 1, "END   " ) ) {
+			++ter_record_count;
+
+		} else if ( line.equals( 1, "ENDMDL" ) && options.obey_ENDMDL() ) {
+			// Nothing after this changes the atoms read.
+			TR.Debug << "Hit ENDMDL; not reading further coordinate section records." << std::endl;
+			break;
+		}
+	}
+	return true;
+}
+
+/// @details Mirrors the atom_site branch of mmcif::create_sfr_from_cif_file_op(), including
+/// its quirks: the '.' and '?' placeholders are kept as values (but for the insertion code '?'),
+/// and reading stops at the first change of model number.
+bool
+read_flat_atoms_from_cif_contents(
+	char const * begin,
+	char const * end,
+	StructFileReaderOptions const & options,
+	FlatAtoms & atoms
+) {
+	atoms.clear();
+	if ( options.new_chain_order() ) return false;
+
+	// Find the "loop_" line heading the _atom_site loop of the first data block.
+	char const * pos( begin );
+	char const * loop_start( nullptr );
+	Size n_blocks( 0 );
+	bool previous_is_loop( false );
+	while ( pos != end && ! loop_start ) {
+		char const * const eol( line_end( pos, end ) );
+		char const * first( pos );
+		while ( first != eol && is_blank( *first ) ) ++first;
+		if ( first != eol ) {
+			if ( eol - first >= 11 && std::strncmp( first, "_atom_site.", 11 ) == 0 ) {
+				if ( ! previous_is_loop ) return false; // a single atom, as data name-value pairs
+				loop_start = first;
+			} else if ( eol - first >= 5 && std::strncmp( first, "data_", 5 ) == 0 ) {
+				if ( ++n_blocks > 1 ) return false; // the regular reader reads the first block only
+			}
+			previous_is_loop = ( eol - first >= 5 && std::strncmp( first, "loop_", 5 ) == 0 );
+		}
+		if ( ! loop_start ) pos = ( eol == end ) ? end : eol + 1;
+	}
+	if ( ! loop_start ) return false;
+
+	// Column names...
+	AtomSiteColumns columns;
+	Size n_columns( 0 );
+	CIFToken token;
+	int status( 0 );
+	pos = loop_start;
+	while ( ( status = next_cif_token( begin, pos, end, token ) ) == 1 && ! token.quoted && token.starts_with( "_atom_site." ) ) {
+		columns.set( token, ++n_columns );
+	}
+	if ( ! columns.complete() ) return false;
+
+	// ...then the values, row by row.
+	atoms.atoms.reserve( ( end - loop_start ) / 81 );
+
+	bool const only_ATOM( options.read_only_ATOM_entries() );
+	std::vector< CIFToken > row( n_columns + 1 ); // 1-based, as the columns
+	Size n_values( 0 );
+	std::string last_model;
+	for ( ; status == 1 && ! ends_cif_loop( token ); status = next_cif_token( begin, pos, end, token ) ) {
+		row[ ++n_values ] = token;
+		if ( n_values < n_columns ) continue;
+		n_values = 0;
+
+		if ( columns.pdbx_PDB_model_num ) {
+			std::string const model( stripped( row[ columns.pdbx_PDB_model_num ] ) );
+			if ( ! last_model.empty() && last_model != model ) break;
+			last_model = model;
+		}
+
+		bool const is_het( columns.group_PDB && row[ columns.group_PDB ].equals( "HETATM" ) );
+		if ( is_het && only_ATOM ) continue;
+
+		atoms.atoms.emplace_back();
+		FlatAtom & atom( atoms.atoms.back() );
+		atom.isHet = is_het;
+		atom.serial = row[ columns.id ].to_int();
+		atom.name[ 0 ] = '\0';
+		if ( columns.auth_atom_id || columns.label_atom_id ) {
+			if ( ! row[ columns.auth_atom_id ? columns.auth_atom_id : columns.label_atom_id ].copy( atom.name, sizeof( atom.name ) ) ) return false;
+		}
+		CIFToken const & alt_id( row[ columns.label_alt_id ] );
+		atom.altLoc = alt_id.size() > 0 ? *alt_id.begin : 0;
+		if ( ! row[ columns.auth_comp_id ? columns.auth_comp_id : columns.label_comp_id ].copy( atom.resName, sizeof( atom.resName ) ) ) return false;
+
+		atom.chainID = ' ';
+		if ( columns.auth_asym_id && row[ columns.auth_asym_id ].size() > 0 ) {
+			atom.chainID = *row[ columns.auth_asym_id ].begin;
+		} else if ( columns.label_asym_id && row[ columns.label_asym_id ].size() > 0 ) {
+			atom.chainID = *row[ columns.label_asym_id ].begin;
+		}
+		atom.resSeq = row[ columns.auth_seq_id ? columns.auth_seq_id : columns.label_seq_id ].to_int();
+		atom.iCode = ' ';
+		if ( columns.pdbx_PDB_ins_code ) {
+			CIFToken const & ins_code( row[ columns.pdbx_PDB_ins_code ] );
+			if ( ins_code.size() > 0 && *ins_code.begin != '?' ) atom.iCode = *ins_code.begin;
+		}
+
+		atom.x = row[ columns.Cartn_x ].to_double();
+		atom.y = row[ columns.Cartn_y ].to_double();
+		atom.z = row[ columns.Cartn_z ].to_double();
+		atom.occupancy = columns.occupancy ? row[ columns.occupancy ].to_double() : 1.0;
+		atom.temperature = columns.B_iso_or_equiv ? row[ columns.B_iso_or_equiv ].to_double() : 0.0;
+		std::strcpy( atom.segmentID, "    " );
+		if ( ! row[ columns.type_symbol ].copy( atom.element, sizeof( atom.element ) ) ) return false;
+		atom.terCount = 0;
+	}
+	if ( status == -1 ) {
+		TR.Debug << "Multi-line value in the _atom_site loop; leaving it to the regular mmCIF reader." << std::endl;
+		return false;
+	}
+	if ( n_values != 0 ) return false; // a truncated row
+
+	atoms.modeltag = last_model;
+	return true;
+}
+
+bool
+read_flat_atoms_from_file_contents(
+	char const * begin,
+	char const * end,
+	StructFileReaderOptions const & options,
+	FlatAtoms & atoms
+) {
+	if ( is_cif_contents( begin, end ) ) {
+		return read_flat_atoms_from_cif_contents( begin, end, options, atoms );
+	}
+	return read_flat_atoms_from_pdb_contents( begin, end, options, atoms );
+}
+
+StructFileRepOP
+create_sfr_from_flat_atoms( FlatAtoms const & atoms )
+{
+	StructFileRepOP sfr( new StructFileRep );
+	sfr->modeltag() = atoms.modeltag;
+
+	// Chains in order of first appearance, each pre-sized, as a chain ID can only be a char
+	Size chain_index[ 256 ] = { 0 };
+	utility::vector1< Size > chain_sizes;
+	for ( FlatAtom const & atom : atoms.atoms ) {
+		Size & index( chain_index[ static_cast< unsigned char >( atom.chainID ) ] );
+		if ( ! index ) {
+			chain_sizes.push_back( 0 );
+			index = chain_sizes.size();
+		}
+		++chain_sizes[ index ];
+	}
+	sfr->chains().resize( chain_sizes.size() );
+	for ( Size ii = 1; ii <= chain_sizes.size(); ++ii ) {
+		sfr->chains()[ ii - 1 ].reserve( chain_sizes[ ii ] );
+	}
+
+	for ( FlatAtom const & atom : atoms.atoms ) {
+		ChainAtoms & chain( sfr->chains()[ chain_index[ static_cast< unsigned char >( atom.chainID ) ] - 1 ] );
+		chain.emplace_back();
+		AtomInformation & ai( chain.back() );
+		ai.isHet = atom.isHet;
+		ai.serial = atom.serial;
+		ai.name = atom.name;
+		ai.altLoc = atom.altLoc;
+		ai.resName = atom.resName;
+		ai.chainID = atom.chainID;
+		ai.resSeq = atom.resSeq;
+		ai.iCode = atom.iCode;
+		ai.x = atom.x;
+		ai.y = atom.y;
+		ai.z = atom.z;
+		ai.occupancy = atom.occupancy;
+		ai.temperature = atom.temperature;
+		ai.segmentID = atom.segmentID;
+		ai.element = atom.element;
+		ai.terCount = atom.terCount;
+	}
+	return sfr;
+}
+
+} // namespace io
+} // namespace core
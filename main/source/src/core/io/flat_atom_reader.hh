@@ -0,0 +1,108 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/io/flat_atom_reader.hh
+/// @brief  Single-pass readers of the coordinate records of .pdb and mmCIF files, for bulk input
+/// @details The regular readers first turn every line of a .pdb file into a Record (a map of
+/// strings), or a whole mmCIF file into tables of strings, and only then pick the atoms out of
+/// them.  The functions here scan the file contents once, reading the ATOM/HETATM records (or the
+/// rows of the _atom_site loop) straight into an array of fixed-size FlatAtom structs, and ignore
+/// every other record.  Atoms are read exactly as the regular readers read them, so the
+/// StructFileRep made from the array has the same chains as that of the regular reader, minus the
+/// header, remarks, links, etc.
+
+#ifndef INCLUDED_core_io_flat_atom_reader_hh
+#define INCLUDED_core_io_flat_atom_reader_hh
+
+// Package headers
+#include <core/io/StructFileRep.fwd.hh>
+#include <core/io/StructFileReaderOptions.fwd.hh>
+
+// Project headers
+#include <core/types.hh>
+
+// C++ headers
+#include <string>
+#include <vector>
+
+namespace core {
+namespace io {
+
+/// @brief An ATOM or HETATM record, with its text fields in fixed-size, NUL-terminated arrays
+/// @details Text fields keep their padding, as in AtomInformation.  Fields of .pdb records always
+/// fit; an mmCIF value too long for its field makes the reader give up on the file.
+struct FlatAtom {
+	bool isHet;
+	int serial;
+	char name[ 8 ];
+	char altLoc;
+	char resName[ 8 ];
+	char chainID;
+	int resSeq;
+	char iCode;
+	double x, y, z;
+	double occupancy;
+	double temperature;
+	char segmentID[ 8 ];
+	char element[ 4 ];
+	int terCount;
+};
+
+/// @brief The atoms of one file, in file order, and the tag of the (last) model read
+/// @details Reuse one FlatAtoms for a whole batch of files: clear() keeps the capacity of the
+/// array, so that once it has grown to the largest file no more memory is allocated.
+struct FlatAtoms {
+	std::vector< FlatAtom > atoms;
+	std::string modeltag;
+
+	void clear() { atoms.clear(); modeltag.clear(); }
+};
+
+/// @brief Do the contents in [begin, end) look like an mmCIF file (i.e. start with a data_ block)?
+bool
+is_cif_contents( char const * begin, char const * end );
+
+/// @brief Read the ATOM/HETATM records of .pdb file contents in [begin, end) into atoms.
+/// @details Honors read_only_ATOM_entries() and obey_ENDMDL(); returns false (and reads nothing)
+/// if the options ask for what only the regular reader does, i.e. new_chain_order().
+bool
+read_flat_atoms_from_pdb_contents(
+	char const * begin,
+	char const * end,
+	StructFileReaderOptions const & options,
+	FlatAtoms & atoms );
+
+/// @brief Read the rows of the _atom_site loop of mmCIF file contents in [begin, end) into atoms.
+/// @details Reads the first model only, as the regular reader does.  Returns false if there is no
+/// _atom_site loop, if the loop is not a plain table of single-line values (or lacks a mandatory
+/// column), or if the options ask for new_chain_order(); the regular reader should be used then.
+bool
+read_flat_atoms_from_cif_contents(
+	char const * begin,
+	char const * end,
+	StructFileReaderOptions const & options,
+	FlatAtoms & atoms );
+
+/// @brief Read .pdb or mmCIF file contents, whichever they are, into atoms
+bool
+read_flat_atoms_from_file_contents(
+	char const * begin,
+	char const * end,
+	StructFileReaderOptions const & options,
+	FlatAtoms & atoms );
+
+/// @brief Create a representation of structural file data holding just the given atoms,
+/// split into chains as the regular readers split them.
+StructFileRepOP
+create_sfr_from_flat_atoms( FlatAtoms const & atoms );
+
+} // namespace io
+} // namespace core
+
+#endif // INCLUDED_core_io_flat_atom_reader_hh
@@ -0,0 +1,521 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/io/silent/IndexedSilentFile.cc
+/// @brief  A silent-file container with a tag index and a columnar score block
+
+// Unit headers
+#include <core/io/silent/IndexedSilentFile.hh>
+
+// Package headers
+#include <core/io/silent/SilentFileData.hh>
+
+// Basic headers
+#include <basic/Tracer.hh>
+
+// Utility headers
+#include <utility/excn/Exceptions.hh>
+#include <utility/exit.hh>
+#include <utility/file/FileName.hh>
+#include <utility/file/file_sys_util.hh>
+#include <utility/io/MappedFile.hh>
+
+// C++ headers
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <sstream>
+
+static basic::Tracer tr( "core.io.silent.IndexedSilentFile" );
+
+namespace core {
+namespace io {
+namespace silent {
+
+namespace {
+
+char const MAGIC[] = "RSILIDX2";
+Size const MAGIC_SIZE = 8;
+Size const TRAILER_SIZE = 8 + MAGIC_SIZE;
+
+void
+write_uint( std::ostream & out, uint64_t value, Size const nbytes ) {
+	char bytes[ 8 ];
+	for ( Size ii = 0; ii < nbytes; ++ii ) {
+		bytes[ ii ] = static_cast< char >( ( value >> ( 8 * ii ) ) & 0xff );
+	}
+	out.write( bytes, nbytes );
+}
+
+void
+write_string( std::ostream & out, std::string const & str ) {
+	write_uint( out, str.size(), 4 );
+	out.write( str.data(), str.size() );
+}
+
+void
+write_float( std::ostream & out, Real const value ) {
+	float const single( static_cast< float >( value ) );
+	uint32_t bits;
+	std::memcpy( &bits, &single, sizeof( bits ) );
+	write_uint( out, bits, 4 );
+}
+
+/// @brief Bounds-checked little-endian reader over the mapped index
+class IndexCursor {
+public:
+	IndexCursor( char const * begin, char const * end ) : pos_( begin ), end_( end ), ok_( true ) {}
+
+	bool ok() const { return ok_; }
+
+	uint64_t
+	read_uint( Size const nbytes ) {
+		if ( ! ok_ || Size( end_ - pos_ ) < nbytes ) { ok_ = false; return 0; }
+		uint64_t value( 0 );
+		for ( Size ii = 0; ii < nbytes; ++ii ) {
+			value |= uint64_t( static_cast< unsigned char >( pos_[ ii ] ) ) << ( 8 * ii );
+		}
+		pos_ += nbytes;
+		return value;
+	}
+
+	std::string
+	read_string() {
+		Size const length( read_uint( 4 ) );
+		if ( ! ok_ || Size( end_ - pos_ ) < length ) { ok_ = false; return ""; }
+		std::string const str( pos_, length );
+		pos_ += length;
+		return str;
+	}
+
+	Real
+	read_float() {
+		uint32_t const bits( static_cast< uint32_t >( read_uint( 4 ) ) );
+		float single;
+		std::memcpy( &single, &bits, sizeof( single ) );
+		return single;
+	}
+
+private:
+	char const * pos_;
+	char const * end_;
+	bool ok_;
+};
+
+Real nan() { return std::numeric_limits< Real >::quiet_NaN(); }
+
+/// @brief Read only the tail of a file: if it starts with the magic and ends with a complete
+/// segment trailer, return true and set its size.  Does not read any index.
+bool
+ends_with_trailer( std::string const & filename, Size & size ) {
+	std::ifstream in( filename.c_str(), std::ios::in | std::ios::binary );
+	if ( ! in.good() ) return false;
+	char magic[ MAGIC_SIZE ];
+	in.read( magic, MAGIC_SIZE );
+	if ( in.gcount() != std::streamsize( MAGIC_SIZE ) || std::memcmp( magic, MAGIC, MAGIC_SIZE ) != 0 ) return false;
+
+	in.seekg( 0, std::ios::end );
+	size = Size( in.tellg() );
+	if ( size < MAGIC_SIZE + TRAILER_SIZE ) return false;
+	char trailer[ TRAILER_SIZE ];
+	in.seekg( size - TRAILER_SIZE );
+	in.read( trailer, TRAILER_SIZE );
+	if ( in.gcount() != std::streamsize( TRAILER_SIZE ) || std::memcmp( trailer + 8, MAGIC, MAGIC_SIZE ) != 0 ) return false;
+
+	// The trailer points at its index, which starts with the end of the previous segment
+	Size const index_offset( IndexCursor( trailer, trailer + 8 ).read_uint( 8 ) );
+	if ( index_offset < MAGIC_SIZE || index_offset + 8 > size - TRAILER_SIZE ) return false;
+	char link[ 8 ];
+	in.seekg( index_offset );
+	in.read( link, 8 );
+	return in.gcount() == 8 && IndexCursor( link, link + 8 ).read_uint( 8 ) < index_offset;
+}
+
+}
+
+IndexedSilentFile::IndexedSilentFile() = default;
+
+IndexedSilentFile::IndexedSilentFile( std::string const & filename )
+{
+	open( filename );
+}
+
+IndexedSilentFile::~IndexedSilentFile() = default;
+
+bool
+IndexedSilentFile::open( std::string const & filename ) {
+	clear();
+	filename_ = filename;
+	file_ = utility::pointer::make_shared< utility::io::MappedFile >( filename );
+	if ( ! file_->is_open() || ! read_index() ) {
+		clear();
+		return false;
+	}
+	return true;
+}
+
+bool
+IndexedSilentFile::is_open() const {
+	return file_ != nullptr;
+}
+
+void
+IndexedSilentFile::clear() {
+	file_.reset();
+	clear_index();
+}
+
+void
+IndexedSilentFile::clear_index() {
+	end_offset_ = 0;
+	tags_.clear();
+	offsets_.clear();
+	lengths_.clear();
+	tag_index_.clear();
+	score_names_.clear();
+	score_columns_.clear();
+	score_index_.clear();
+}
+
+/// @details Normally the last segment's trailer ends the file.  If it does not -- a writer
+/// died part way through an append -- the last complete trailer before the end of the file is
+/// used instead, so the structures appended before the failed write remain readable.
+bool
+IndexedSilentFile::read_index() {
+	char const * data( file_->data() );
+	Size const size( file_->size() );
+	if ( size < MAGIC_SIZE || std::memcmp( data, MAGIC, MAGIC_SIZE ) != 0 ) {
+		return false;
+	}
+	if ( read_segments( size ) ) return true;
+
+	for ( Size end = size - 1; end >= MAGIC_SIZE + TRAILER_SIZE; --end ) {
+		if ( std::memcmp( data + end - MAGIC_SIZE, MAGIC, MAGIC_SIZE ) != 0 ) continue;
+		if ( read_segments( end ) ) {
+			tr.Warning << "Ignoring " << size - end << " bytes of incomplete data at the end of indexed silent file " << filename_ << std::endl;
+			return true;
+		}
+	}
+	tr.Error << "No complete index found in indexed silent file " << filename_ << std::endl;
+	return false;
+}
+
+/// @details Collects the chain of index segments ending with the trailer that ends at
+/// trailer_end, then reads them in file order.  Leaves the index empty on failure.
+bool
+IndexedSilentFile::read_segments( Size const trailer_end ) {
+	char const * data( file_->data() );
+	if ( trailer_end < MAGIC_SIZE + TRAILER_SIZE ||
+			std::memcmp( data + trailer_end - MAGIC_SIZE, MAGIC, MAGIC_SIZE ) != 0 ) {
+		return false;
+	}
+
+	// Walk back along the chain; each index block starts with the end of the previous segment.
+	utility::vector1< std::pair< Size, Size > > segments; // index offset, end of index
+	Size segment_end( trailer_end );
+	while ( segment_end != 0 ) {
+		if ( segment_end < MAGIC_SIZE + TRAILER_SIZE ||
+				std::memcmp( data + segment_end - MAGIC_SIZE, MAGIC, MAGIC_SIZE ) != 0 ) {
+			return false;
+		}
+		Size const index_end( segment_end - TRAILER_SIZE );
+		IndexCursor trailer( data + index_end, data + segment_end );
+		Size const index_offset( trailer.read_uint( 8 ) );
+		if ( index_offset < MAGIC_SIZE || index_offset + 8 > index_end ) return false;
+		IndexCursor link( data + index_offset, data + index_end );
+		Size const previous_end( link.read_uint( 8 ) );
+		if ( previous_end >= index_offset ) return false;
+		segments.push_back( std::make_pair( index_offset, index_end ) );
+		segment_end = previous_end;
+	}
+
+	for ( Size ii = segments.size(); ii >= 1; --ii ) {
+		if ( ! read_segment( segments[ ii ].first, segments[ ii ].second ) ) {
+			clear_index();
+			return false;
+		}
+	}
+	for ( utility::vector1< Real > & column : score_columns_ ) {
+		column.resize( tags_.size(), nan() );
+	}
+	end_offset_ = trailer_end;
+	return true;
+}
+
+bool
+IndexedSilentFile::read_segment( Size const index_offset, Size const index_end ) {
+	char const * data( file_->data() );
+	IndexCursor index( data + index_offset, data + index_end );
+	index.read_uint( 8 ); // end of the previous segment
+	Size const first_row( tags_.size() );
+	Size const nrecords( index.read_uint( 8 ) );
+	for ( Size ii = 1; ii <= nrecords && index.ok(); ++ii ) {
+		tags_.push_back( index.read_string() );
+		offsets_.push_back( index.read_uint( 8 ) );
+		lengths_.push_back( index.read_uint( 8 ) );
+		if ( offsets_.back() < MAGIC_SIZE || offsets_.back() + lengths_.back() > index_offset ) {
+			return false;
+		}
+		tag_index_[ tags_.back() ] = tags_.size();
+	}
+
+	Size const ncolumns( index.read_uint( 4 ) );
+	for ( Size ii = 1; ii <= ncolumns && index.ok(); ++ii ) {
+		std::string const name( index.read_string() );
+		auto iter( score_index_.find( name ) );
+		if ( iter == score_index_.end() ) {
+			score_names_.push_back( name );
+			score_columns_.push_back( utility::vector1< Real >() );
+			iter = score_index_.insert( std::make_pair( name, score_names_.size() ) ).first;
+		}
+		utility::vector1< Real > & column( score_columns_[ iter->second ] );
+		column.resize( first_row, nan() );
+		for ( Size jj = 1; jj <= nrecords; ++jj ) {
+			column.push_back( index.read_float() );
+		}
+	}
+	return index.ok();
+}
+
+bool
+IndexedSilentFile::has_tag( std::string const & tag ) const {
+	return tag_index_.count( tag ) != 0;
+}
+
+std::pair< char const *, Size >
+IndexedSilentFile::record_bytes( Size const index ) const {
+	return std::make_pair( file_->data() + offsets_[ index ], lengths_[ index ] );
+}
+
+std::string
+IndexedSilentFile::record( std::string const & tag ) const {
+	auto const iter( tag_index_.find( tag ) );
+	if ( iter == tag_index_.end() ) {
+		throw CREATE_EXCEPTION( utility::excn::BadInput, "Tag " + tag + " not found in indexed silent file " + filename_ );
+	}
+	std::pair< char const *, Size > const bytes( record_bytes( iter->second ) );
+	return std::string( bytes.first, bytes.second );
+}
+
+bool
+IndexedSilentFile::read_structures(
+	utility::vector1< std::string > const & tags,
+	SilentFileData & sfd,
+	bool throw_exception_on_bad_structs
+) const {
+	utility::vector1< Size > indices;
+	utility::vector1< std::string > record_tags;
+	if ( tags.empty() ) {
+		for ( Size ii = 1; ii <= tags_.size(); ++ii ) indices.push_back( ii );
+	} else {
+		for ( std::string const & tag : tags ) {
+			auto const iter( tag_index_.find( tag ) );
+			if ( iter == tag_index_.end() ) {
+				if ( throw_exception_on_bad_structs ) {
+					throw CREATE_EXCEPTION( utility::excn::BadInput, "Tag " + tag + " not found in indexed silent file " + filename_ );
+				}
+				tr.Error << "Tag " << tag << " not found in indexed silent file " << filename_ << std::endl;
+				return false;
+			}
+			indices.push_back( iter->second );
+		}
+	}
+
+	bool success( true );
+	for ( Size const index : indices ) {
+		std::pair< char const *, Size > const bytes( record_bytes( index ) );
+		utility::io::MemoryStreamBuf buffer( bytes.first, bytes.second );
+		std::istream in( &buffer );
+		utility::vector1< std::string > const wanted( 1, tags_[ index ] );
+		success = sfd.read_stream( in, wanted, throw_exception_on_bad_structs, filename_ ) && success;
+	}
+	return success;
+}
+
+bool
+IndexedSilentFile::has_score( std::string const & score_name ) const {
+	return score_index_.count( score_name ) != 0;
+}
+
+utility::vector1< Real > const &
+IndexedSilentFile::score_column( std::string const & score_name ) const {
+	auto const iter( score_index_.find( score_name ) );
+	if ( iter == score_index_.end() ) {
+		throw CREATE_EXCEPTION( utility::excn::BadInput, "Score " + score_name + " not found in indexed silent file " + filename_ );
+	}
+	return score_columns_[ iter->second ];
+}
+
+Real
+IndexedSilentFile::score( std::string const & tag, std::string const & score_name ) const {
+	auto const tag_iter( tag_index_.find( tag ) );
+	auto const score_iter( score_index_.find( score_name ) );
+	if ( tag_iter == tag_index_.end() || score_iter == score_index_.end() ) return nan();
+	return score_columns_[ score_iter->second ][ tag_iter->second ];
+}
+
+bool
+IndexedSilentFile::is_indexed_silent_file( std::string const & filename ) {
+	std::ifstream in( filename.c_str(), std::ios::in | std::ios::binary );
+	if ( ! in.good() ) return false;
+	char magic[ MAGIC_SIZE ];
+	in.read( magic, MAGIC_SIZE );
+	return in.gcount() == std::streamsize( MAGIC_SIZE ) && std::memcmp( magic, MAGIC, MAGIC_SIZE ) == 0;
+}
+
+/// @details The header SCORE line is the one whose last column is "description"; the
+/// values are on the following SCORE line ending in the record's tag.  Non-numeric
+/// values are stored as NaN.
+void
+IndexedSilentFile::scores_from_record(
+	std::string const & text,
+	std::string const & tag,
+	utility::vector1< std::string > & names,
+	utility::vector1< Real > & values
+) {
+	names.clear();
+	values.clear();
+
+	std::istringstream in( text );
+	std::string line;
+	utility::vector1< std::string > header;
+	while ( std::getline( in, line ) ) {
+		if ( line.compare( 0, 6, "SCORE:" ) != 0 ) continue;
+		std::istringstream words( line.substr( 6 ) );
+		utility::vector1< std::string > columns;
+		std::string word;
+		while ( words >> word ) columns.push_back( word );
+		if ( columns.empty() ) continue;
+
+		if ( columns.back() == "description" ) {
+			header = columns;
+		} else if ( columns.back() == tag && ! header.empty() ) {
+			Size const ncolumns( std::min( header.size(), columns.size() ) - 1 );
+			for ( Size ii = 1; ii <= ncolumns; ++ii ) {
+				std::istringstream value_stream( columns[ ii ] );
+				Real value;
+				if ( !( value_stream >> value ) ) value = nan();
+				names.push_back( header[ ii ] );
+				values.push_back( value );
+			}
+			return;
+		}
+	}
+}
+
+/// @details A new file is written under a temporary name and renamed into place.  An existing
+/// file is only ever extended: the new records, an index segment covering just those records,
+/// and a new trailer are written after its current end, so the cost of an append does not
+/// depend on the size of the file, and a failed append cannot damage what was already there.
+/// Only the file's last trailer is read to link the new segment to the previous one; the
+/// whole index is read only to recover from an incomplete earlier append.
+void
+IndexedSilentFile::append_records(
+	std::string const & filename,
+	utility::vector1< Record > const & records
+) {
+	if ( records.empty() ) return;
+
+	Size previous_end( 0 );
+	Size write_offset( MAGIC_SIZE );
+	bool const existed( utility::file::file_exists( filename ) && utility::file::file_size( filename ) > 0 );
+	if ( existed ) {
+		Size size( 0 );
+		if ( ends_with_trailer( filename, size ) ) {
+			previous_end = size;
+			write_offset = size;
+		} else {
+			IndexedSilentFile const existing( filename );
+			if ( ! existing.is_open() ) {
+				throw CREATE_EXCEPTION( utility::excn::BadInput, "Cannot append to " + filename + ": it is not a readable indexed silent file." );
+			}
+			previous_end = existing.end_offset_;
+			write_offset = existing.file_->size();
+		}
+	}
+
+	std::string write_name( filename );
+	if ( ! existed ) {
+		std::string dir( utility::file::FileName( filename ).path() );
+		if ( dir.empty() ) dir = ".";
+		write_name = utility::file::create_temp_filename( dir, "indexed_silent" );
+	}
+	std::ofstream out( write_name.c_str(), existed ?
+		std::ios::out | std::ios::app | std::ios::binary :
+		std::ios::out | std::ios::trunc | std::ios::binary );
+	if ( ! out.good() ) {
+		utility_exit_with_message( "Could not make " + write_name );
+	}
+	if ( ! existed ) {
+		out.write( MAGIC, MAGIC_SIZE );
+	}
+
+	utility::vector1< Size > offsets;
+	utility::vector1< std::string > score_names;
+	utility::vector1< utility::vector1< Real > > score_columns;
+	std::map< std::string, Size > score_index;
+	utility::vector1< std::string > names;
+	utility::vector1< Real > values;
+	for ( Record const & record : records ) {
+		out.write( record.second.data(), record.second.size() );
+		offsets.push_back( write_offset );
+		write_offset += record.second.size();
+
+		Size const row( offsets.size() );
+		scores_from_record( record.second, record.first, names, values );
+		for ( Size ii = 1; ii <= names.size(); ++ii ) {
+			auto iter( score_index.find( names[ ii ] ) );
+			if ( iter == score_index.end() ) {
+				score_names.push_back( names[ ii ] );
+				score_columns.push_back( utility::vector1< Real >( row - 1, nan() ) );
+				iter = score_index.insert( std::make_pair( names[ ii ], score_names.size() ) ).first;
+			}
+			utility::vector1< Real > & column( score_columns[ iter->second ] );
+			column.resize( row, nan() );
+			column[ row ] = values[ ii ];
+		}
+	}
+	for ( utility::vector1< Real > & column : score_columns ) {
+		column.resize( records.size(), nan() );
+	}
+
+	Size const index_offset( write_offset );
+	write_uint( out, previous_end, 8 );
+	write_uint( out, records.size(), 8 );
+	for ( Size ii = 1; ii <= records.size(); ++ii ) {
+		write_string( out, records[ ii ].first );
+		write_uint( out, offsets[ ii ], 8 );
+		write_uint( out, records[ ii ].second.size(), 8 );
+	}
+	write_uint( out, score_names.size(), 4 );
+	for ( Size ii = 1; ii <= score_names.size(); ++ii ) {
+		write_string( out, score_names[ ii ] );
+		for ( Real const value : score_columns[ ii ] ) {
+			write_float( out, value );
+		}
+	}
+	write_uint( out, index_offset, 8 );
+	out.write( MAGIC, MAGIC_SIZE );
+	out.close();
+
+	if ( out.fail() ) {
+		if ( ! existed ) utility::file::file_delete( write_name );
+		utility_exit_with_message( "Error writing indexed silent file " + filename );
+	}
+	if ( ! existed && std::rename( write_name.c_str(), filename.c_str() ) != 0 ) {
+		utility::file::file_delete( write_name );
+		utility_exit_with_message( "Could not move " + write_name + " to " + filename );
+	}
+}
+
+} // namespace silent
+} // namespace io
+} // namespace core
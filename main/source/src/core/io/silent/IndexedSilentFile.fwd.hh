@@ -0,0 +1,31 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/io/silent/IndexedSilentFile.fwd.hh
+/// @brief  forward declaration of the indexed silent-file container
+
+#ifndef INCLUDED_core_io_silent_IndexedSilentFile_fwd_hh
+#define INCLUDED_core_io_silent_IndexedSilentFile_fwd_hh
+
+#include <utility/pointer/owning_ptr.hh>
+
+namespace core {
+namespace io {
+namespace silent {
+
+class IndexedSilentFile;
+
+typedef utility::pointer::shared_ptr< IndexedSilentFile > IndexedSilentFileOP;
+typedef utility::pointer::shared_ptr< IndexedSilentFile const > IndexedSilentFileCOP;
+
+} // namespace silent
+} // namespace io
+} // namespace core
+
+#endif
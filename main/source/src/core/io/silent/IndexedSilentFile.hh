@@ -0,0 +1,171 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/io/silent/IndexedSilentFile.hh
+/// @brief  A silent-file container with a tag index and a columnar score block, for
+/// reading single structures or only the scores out of very large files.
+
+#ifndef INCLUDED_core_io_silent_IndexedSilentFile_hh
+#define INCLUDED_core_io_silent_IndexedSilentFile_hh
+
+// Unit headers
+#include <core/io/silent/IndexedSilentFile.fwd.hh>
+
+// Package headers
+#include <core/io/silent/SilentFileData.fwd.hh>
+#include <core/types.hh>
+
+// Utility headers
+#include <utility/io/MappedFile.fwd.hh>
+#include <utility/pointer/ReferenceCount.hh>
+#include <utility/vector1.hh>
+
+// C++ headers
+#include <map>
+#include <string>
+#include <utility>
+
+namespace core {
+namespace io {
+namespace silent {
+
+/// @brief An indexed silent file holds the same per-structure silent-file text as an
+/// ordinary silent file (so every SilentStruct type can be stored), but adds a footer
+/// index so that a structure can be read by tag with a single seek, and the scores of
+/// every structure can be read without touching any coordinates.
+///
+/// @details Layout; all integers are little-endian, and "magic" is the eight-byte string
+/// "RSILIDX2".  The file starts with the magic and is followed by one segment per append:
+///
+///   magic
+///   segment 1 .. segment S:
+///     record 1 .. record N     -- silent-file text (header, SCORE and structure lines)
+///     index:
+///       uint64 end of the previous segment (0 for the first)
+///       uint64 N
+///       N x { uint32 tag length, tag, uint64 record offset, uint64 record length }
+///       uint32 C               -- number of score columns in this segment
+///       C x { uint32 name length, name, N x float32 value (NaN if absent) }
+///     uint64 index offset
+///     magic
+///
+/// The file is opened through utility::io::MappedFile, so only the index and the
+/// records actually requested are paged in; the segments' indices are merged on open.
+/// Appending only ever adds a segment after the end of the file, so its cost does not
+/// depend on the size of the file, and a writer that dies part way through leaves the
+/// earlier segments readable (see read_index()).  Files must have a single writer at a
+/// time.  Because the records are plain silent-file text, a file whose index was lost
+/// can still be salvaged.
+class IndexedSilentFile : public utility::pointer::ReferenceCount
+{
+public:
+	typedef std::pair< std::string, std::string > Record; // tag, silent-file text
+
+public:
+	/// @brief Construct a closed %IndexedSilentFile
+	IndexedSilentFile();
+
+	/// @brief Construct and open; check is_open() for success
+	explicit IndexedSilentFile( std::string const & filename );
+
+	~IndexedSilentFile() override;
+
+	/// @brief Map the file and read its index.  Returns false if the file cannot be
+	/// read or is not an indexed silent file.
+	bool open( std::string const & filename );
+
+	bool is_open() const;
+
+	std::string const & filename() const { return filename_; }
+
+	/// @brief The number of records in the file
+	Size size() const { return tags_.size(); }
+
+	/// @brief All tags, in file order
+	utility::vector1< std::string > const & tags() const { return tags_; }
+
+	bool has_tag( std::string const & tag ) const;
+
+	/// @brief The silent-file text stored for a tag (the last record, if the tag repeats)
+	std::string record( std::string const & tag ) const;
+
+	/// @brief Parse the records with the given tags -- all records, if tags is empty --
+	/// into sfd, exactly as SilentFileData::read_stream() would from an ordinary file.
+	bool
+	read_structures(
+		utility::vector1< std::string > const & tags,
+		SilentFileData & sfd,
+		bool throw_exception_on_bad_structs
+	) const;
+
+	/// @brief The names of the score columns
+	utility::vector1< std::string > const & score_names() const { return score_names_; }
+
+	bool has_score( std::string const & score_name ) const;
+
+	/// @brief One value per record, in file order; NaN where a record lacks the score
+	utility::vector1< Real > const & score_column( std::string const & score_name ) const;
+
+	/// @brief The given score of the given tag; NaN if the record lacks it
+	Real score( std::string const & tag, std::string const & score_name ) const;
+
+public:
+	/// @brief Does the file exist and start with the indexed silent-file magic?
+	static bool is_indexed_silent_file( std::string const & filename );
+
+	/// @brief Append records to an indexed silent file, creating it if it does not exist.
+	/// @details Each call adds one index segment, so batching records into fewer calls
+	/// keeps the index compact.
+	static void append_records( std::string const & filename, utility::vector1< Record > const & records );
+
+	/// @brief Extract the score columns from the SCORE lines of a record's text
+	static void
+	scores_from_record(
+		std::string const & text,
+		std::string const & tag,
+		utility::vector1< std::string > & names,
+		utility::vector1< Real > & values );
+
+private:
+	/// @brief Parse the index at the end of the mapped file
+	bool read_index();
+
+	/// @brief Parse the chain of segment indices whose last trailer ends at trailer_end
+	bool read_segments( Size trailer_end );
+
+	/// @brief Add the entries of one segment's index to the merged index
+	bool read_segment( Size index_offset, Size index_end );
+
+	void clear();
+
+	void clear_index();
+
+	std::pair< char const *, Size > record_bytes( Size index ) const;
+
+private:
+	std::string filename_;
+	utility::io::MappedFileOP file_;
+	/// @brief The end of the last complete segment
+	Size end_offset_ = 0;
+
+	utility::vector1< std::string > tags_;
+	utility::vector1< Size > offsets_;
+	utility::vector1< Size > lengths_;
+	std::map< std::string, Size > tag_index_;
+
+	utility::vector1< std::string > score_names_;
+	utility::vector1< utility::vector1< Real > > score_columns_;
+	std::map< std::string, Size > score_index_;
+};
+
+} // namespace silent
+} // namespace io
+} // namespace core
+
+#endif
@@ -32,6 +32,7 @@
 #include <core/io/silent/SilentStruct.hh>
 #include <core/io/silent/BinarySilentStruct.hh>
 #include <core/io/silent/SilentFileData.hh>
+#include <core/io/silent/IndexedSilentFile.hh>
 #include <core/io/silent/SilentStructFactory.hh>
 #include <core/io/silent/EnergyNames.hh>
 #include <core/io/silent/SharedSilentData.hh>
@@ -219,6 +220,17 @@ bool SilentFileData::read_tags_fast(
 	utility::vector1< std::string > & tags_in_file
 ) const {
 
+	if ( IndexedSilentFile::is_indexed_silent_file( filename ) ) {
+		IndexedSilentFile const indexed( filename );
+		if ( !indexed.is_open() ) {
+			utility_exit_with_message(
+				"ERROR: Unable to read the index of silent_input file: '" + filename + "'"
+			);
+		}
+		tags_in_file.insert( tags_in_file.end(), indexed.tags().begin(), indexed.tags().end() );
+		return true;
+	}
+
 	utility::io::izstream data( filename.c_str() );
 	if ( !data.good() ) {
 		utility_exit_with_message(
@@ -426,6 +438,13 @@ bool SilentFileData::write_silent_struct(
 	using namespace basic::options;
 	using namespace basic::options::OptionKeys;
 
+	if ( writes_indexed( filename, bWriteScoreOnly ) ) {
+		utility::vector1< IndexedSilentFile::Record > records;
+		records.push_back( std::make_pair( s.decoy_tag(), indexed_record_text( s, bWriteScoreOnly ) ) );
+		IndexedSilentFile::append_records( filename, records );
+		return true;
+	}
+
 	utility::io::ozstream output;
 
 	std::stringstream header;
@@ -535,6 +554,25 @@ bool SilentFileData::write_silent_struct(
 	return success;
 }
 
+bool SilentFileData::writes_indexed(
+	std::string const & filename,
+	bool bWriteScoreOnly
+) const {
+	return ( options_.write_indexed() && !bWriteScoreOnly ) || IndexedSilentFile::is_indexed_silent_file( filename );
+}
+
+/// @details Every record starts with its own SEQUENCE and SCORE header lines (even for
+/// score-only output), so that it can be parsed on its own by read_stream().
+std::string SilentFileData::indexed_record_text(
+	SilentStruct & s,
+	bool bWriteScoreOnly
+) const {
+	std::ostringstream text;
+	s.print_header( text );
+	write_silent_struct( s, text, bWriteScoreOnly );
+	return text.str();
+}
+
 void SilentFileData::write_comment(
 	std::ostream & out,
 	std::string const & line
@@ -556,6 +594,15 @@ void SilentFileData::write_all(
 ) const {
 	if ( begin() == end() ) return;
 
+	if ( writes_indexed( filename, bWriteScoreOnly ) ) {
+		utility::vector1< IndexedSilentFile::Record > records;
+		for ( const_iterator iter = begin(), it_end = end(); iter != it_end; ++iter ) {
+			records.push_back( std::make_pair( iter->decoy_tag(), indexed_record_text( **iter, bWriteScoreOnly ) ) );
+		}
+		IndexedSilentFile::append_records( filename, records );
+		return;
+	}
+
 	utility::io::ozstream output;
 
 	if ( begin() != end() ) {
@@ -678,6 +725,23 @@ SilentFileData::_read_file(
 	bool throw_exception_on_bad_structs /*default false*/
 ) {
 	bool success = false; // default value for the early return statements
+
+	// Indexed silent files are read record by record, seeking straight to the wanted tags.
+	if ( IndexedSilentFile::is_indexed_silent_file( filename ) ) {
+		IndexedSilentFile const indexed( filename );
+		if ( !indexed.is_open() ) {
+			if ( throw_exception_on_bad_structs ) {
+				throw CREATE_EXCEPTION(utility::excn::BadInput, "Unable to read the index of silent_input file: '" + filename + "'" );
+			} else {
+				utility_exit_with_message(
+					"ERROR:: Unable to read the index of silent_input file: '" +
+					filename + "'"
+				);
+			}
+		}
+		return indexed.read_structures( tags, *this, throw_exception_on_bad_structs );
+	}
+
 	utility::io::izstream data( filename.c_str() );
 	if ( !data.good() ) {
 		if ( throw_exception_on_bad_structs ) {
@@ -417,6 +417,15 @@ private:
 	/// @author Vikram K. Mulligan (vmullig@uw.edu).
 	void lines_from_header_line_collection( std::map< SilentFileHeaderLine, std::string> const & header_lines, utility::vector1< std::string> & all_lines ) const;
 
+	/// @brief Should structures written to this file go to an indexed silent file?
+	/// @details True for files that already are indexed, and for new full structures if
+	/// the options ask for indexed output.
+	bool writes_indexed( std::string const & filename, bool bWriteScoreOnly ) const;
+
+	/// @brief The self-contained silent-file text (header included) stored for one
+	/// structure in an indexed silent file.
+	std::string indexed_record_text( SilentStruct & s, bool bWriteScoreOnly ) const;
+
 public:
 	/// @brief Iterator class for SilentFileData container.
 	class iterator {
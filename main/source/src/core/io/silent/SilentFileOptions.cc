@@ -95,6 +95,7 @@ void SilentFileOptions::read_from_options( utility::options::OptionCollection co
 	force_silent_bitflip_on_read_set_ = options[ in::file::force_silent_bitflip_on_read ].user();
 	force_silent_bitflip_on_read_ = options[ in::file::force_silent_bitflip_on_read ];
 	print_all_score_headers_ = options[ out::file::silent_print_all_score_headers ];
+	write_indexed_ = options[ out::file::silent_indexed ];
 
 	binary_output_ = options[ rna::denovo::out::binary_output ] || options[ rna::vary_geometry ] || options[ rna::denovo::close_loops ] || ( options[ in::file::silent_struct_type ].value() == "binary_rna" );
 }
@@ -129,6 +130,7 @@ void SilentFileOptions::read_from_tag( utility::tag::TagCOP tag )
 	force_silent_bitflip_on_read_set_ = tag->hasOption( "force_silent_bitflip_on_read" );
 	force_silent_bitflip_on_read_ = tag->getOption< bool >( "force_silent_bitflip_on_read", false );
 	print_all_score_headers_ = tag->getOption< bool >( "print_all_score_headers", false );
+	write_indexed_ = tag->getOption< bool >( "write_indexed", false );
 
 	binary_output_ = tag->getOption< bool >( "binary_output", true ) || tag->getOption< bool >( "vary_geometry", true );
 }
@@ -150,6 +152,7 @@ void SilentFileOptions::list_read_options( utility::options::OptionKeyList & rea
 		+ in::file::silent_select_range_start
 		+ in::file::silent_struct_type
 		+ out::file::silent_print_all_score_headers
+		+ out::file::silent_indexed
 		+ out::file::silent_struct_type
 		+ out::file::weight_silent_scores
 		+ out::user_tag
@@ -206,7 +209,8 @@ void SilentFileOptions::append_attributes_for_tag_parsing(
 		" basically multiplies 'select_range_start' when defining which structure to start on", "1" )
 		+ Attr::attribute_w_default( "force_silent_bitflip_on_read", xsct_rosetta_bool, "Force bit-flipping when reading binary silent files."
 		"  This is useful if files are produced on a little-endian system and read on a big-endian system.", "false" )
-		+ Attr::attribute_w_default( "print_all_score_headers", xsct_rosetta_bool, "Print a SCORE header for every SilentStruct in a silent-file", "false" );
+		+ Attr::attribute_w_default( "print_all_score_headers", xsct_rosetta_bool, "Print a SCORE header for every SilentStruct in a silent-file", "false" )
+		+ Attr::attribute_w_default( "write_indexed", xsct_rosetta_bool, "Write silent files with a tag index and a column-wise score block, for fast random access by tag", "false" );
 }
 
 bool
@@ -347,6 +351,12 @@ SilentFileOptions::print_all_score_headers() const
 	return print_all_score_headers_;
 }
 
+bool
+SilentFileOptions::write_indexed() const
+{
+	return write_indexed_;
+}
+
 void
 SilentFileOptions::keep_input_scores( bool setting )
 {
@@ -447,6 +457,12 @@ SilentFileOptions::print_all_score_headers( bool setting )
 	print_all_score_headers_ = setting;
 }
 
+void
+SilentFileOptions::write_indexed( bool setting )
+{
+	write_indexed_ = setting;
+}
+
 
 } // namespace
 } // namespace
@@ -481,6 +497,7 @@ core::io::silent::SilentFileOptions::save( Archive & arc ) const {
 	arc( CEREAL_NVP( force_silent_bitflip_on_read_set_ ) ); // _Bool
 	arc( CEREAL_NVP( force_silent_bitflip_on_read_ ) ); // _Bool
 	arc( CEREAL_NVP( print_all_score_headers_ ) ); // _Bool
+	arc( CEREAL_NVP( write_indexed_ ) ); // _Bool
 	arc( CEREAL_NVP( binary_output_ ) ); // _Bool
 }
 
@@ -511,6 +528,7 @@ core::io::silent::SilentFileOptions::load( Archive & arc ) {
 	arc( force_silent_bitflip_on_read_set_ ); // _Bool
 	arc( force_silent_bitflip_on_read_ ); // _Bool
 	arc( print_all_score_headers_ ); // _Bool
+	arc( write_indexed_ ); // _Bool
 	arc( binary_output_ ); // _Bool
 }
 
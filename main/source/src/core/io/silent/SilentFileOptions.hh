@@ -78,6 +78,7 @@ public:
 	bool force_silent_bitflip_on_read_set() const;
 	bool force_silent_bitflip_on_read() const;
 	bool print_all_score_headers() const;
+	bool write_indexed() const;
 	bool binary_output() const { return binary_output_; }
 
 	void keep_input_scores( bool setting );
@@ -96,6 +97,7 @@ public:
 	void select_range_mul( int setting );
 	void force_silent_bitflip_on_read( bool setting );
 	void print_all_score_headers( bool setting );
+	void write_indexed( bool setting );
 	void set_binary_output( bool setting ) { binary_output_ = setting; }
 
 private:
@@ -131,6 +133,7 @@ private:
 	bool force_silent_bitflip_on_read_set_;
 	bool force_silent_bitflip_on_read_;
 	bool print_all_score_headers_;
+	bool write_indexed_;
 
 #ifdef    SERIALIZATION
 public:
@@ -42,6 +42,15 @@
 #include <utility/assert.hh>
 #include <utility/vector1.hh>
 
+// C++ headers
+#include <unordered_map>
+
+#ifdef MULTI_THREADED
+#include <basic/thread_manager/RosettaThreadManager.hh>
+#include <utility/pointer/memory.hh>
+#include <functional>
+#endif
+
 
 #ifdef SERIALIZATION
 // Utility serialization headers
@@ -79,7 +88,11 @@ AtomTree::AtomTree(
 	internal_coords_need_updating_( false ),
 	xyz_coords_need_updating_( false ),
 	topological_match_to_( /* 0 */ ),
-	external_coordinate_residues_changed_( utility::pointer::make_shared< ResidueCoordinateChangeList >() )
+	external_coordinate_residues_changed_( utility::pointer::make_shared< ResidueCoordinateChangeList >() ),
+	refold_threads_( 1 ),
+	n_refolds_( 0 ),
+	n_atoms_refolded_( 0 ),
+	n_atoms_last_refold_( 0 )
 {
 	replace_tree( new_atom_pointer, from_xyz );
 	external_coordinate_residues_changed_->total_residue( new_atom_pointer.size() );
@@ -92,7 +105,11 @@ AtomTree::AtomTree():
 	internal_coords_need_updating_( false ),
 	xyz_coords_need_updating_( false ),
 	topological_match_to_( /* 0 */ ),
-	external_coordinate_residues_changed_( utility::pointer::make_shared< ResidueCoordinateChangeList >() )
+	external_coordinate_residues_changed_( utility::pointer::make_shared< ResidueCoordinateChangeList >() ),
+	refold_threads_( 1 ),
+	n_refolds_( 0 ),
+	n_atoms_refolded_( 0 ),
+	n_atoms_last_refold_( 0 )
 {}
 
 /// @brief Destructor
@@ -113,7 +130,11 @@ AtomTree::AtomTree( AtomTree const & src ) :
 	internal_coords_need_updating_( false ),
 	xyz_coords_need_updating_( false ),
 	topological_match_to_( /* 0 */ ),
-	external_coordinate_residues_changed_( utility::pointer::make_shared< ResidueCoordinateChangeList >() )
+	external_coordinate_residues_changed_( utility::pointer::make_shared< ResidueCoordinateChangeList >() ),
+	refold_threads_( 1 ),
+	n_refolds_( 0 ),
+	n_atoms_refolded_( 0 ),
+	n_atoms_last_refold_( 0 )
 {
 	*this = src;
 }
@@ -1230,6 +1251,7 @@ AtomTree::operator=( AtomTree const & src )
 		(*external_coordinate_residues_changed_) = (*src.external_coordinate_residues_changed_);
 
 	}
+	refold_threads_ = src.refold_threads_;
 
 	if ( !utility::pointer::equal(topological_match_to_, (&src)) ) {
 		AtomTreeCOP topological_match_to( topological_match_to_.lock() );
@@ -1361,15 +1383,35 @@ AtomTree::update_xyz_coords() const
 		if ( !root_ ) utility_exit_with_message("phil how did we get here-2?");
 
 		PROF_START( basic::ATOM_TREE_UPDATE_XYZ_COORDS ); // profiling
+		Size const n_atoms_marked( external_coordinate_residues_changed_->n_atoms_marked() );
 		for ( Size ii = 1; ii <= dof_changeset_.size(); ++ii ) {
 			if ( dof_changeset_[ ii ].reached_ ) continue;
 			atom_pointer_[ dof_changeset_[ ii ].atomid_ ]->dfs( dof_changeset_, *external_coordinate_residues_changed_, ii );
 		}
+		n_atoms_last_refold_ = external_coordinate_residues_changed_->n_atoms_marked() - n_atoms_marked;
+		n_atoms_refolded_ += n_atoms_last_refold_;
+		++n_refolds_;
 
-		for ( Size ii = 1; ii <= dof_changeset_.size(); ++ii ) {
-			if ( dof_changeset_[ ii ].reached_ ) continue;
-			//std::cout << "Refold from " << dof_changeset_[ ii ].atomid_.rsd() << std::endl; // << " " << dof_changeset_[ ii ].atomid_.atomno() << " " << dof_changeset_[ ii ].reached_ << std::endl;
-			atom_pointer_[ dof_changeset_[ ii ].atomid_ ]->update_xyz_coords(); // it must find its own stub.
+		utility::vector1< utility::vector1< Size > > groups;
+#ifdef MULTI_THREADED
+		if ( refold_threads_ > 1 ) group_refold_roots( groups );
+#endif
+		if ( groups.size() > 1 ) {
+#ifdef MULTI_THREADED
+			utility::vector1< basic::thread_manager::RosettaThreadFunctionOP > work_vector;
+			work_vector.reserve( groups.size() );
+			for ( Size ii = 1; ii <= groups.size(); ++ii ) {
+				work_vector.push_back( utility::pointer::make_shared< basic::thread_manager::RosettaThreadFunction >(
+					std::bind( &AtomTree::refold_from_dof_changes, this, std::cref( groups[ ii ] ) ) ) );
+			}
+			basic::thread_manager::RosettaThreadManager::get_instance()->do_work_vector_in_threads( work_vector, refold_threads_ );
+#endif
+		} else {
+			for ( Size ii = 1; ii <= dof_changeset_.size(); ++ii ) {
+				if ( dof_changeset_[ ii ].reached_ ) continue;
+				//std::cout << "Refold from " << dof_changeset_[ ii ].atomid_.rsd() << std::endl; // << " " << dof_changeset_[ ii ].atomid_.atomno() << " " << dof_changeset_[ ii ].reached_ << std::endl;
+				atom_pointer_[ dof_changeset_[ ii ].atomid_ ]->update_xyz_coords(); // it must find its own stub.
+			}
 		}
 		dof_changeset_.clear();
 		PROF_STOP ( basic::ATOM_TREE_UPDATE_XYZ_COORDS );
@@ -1381,6 +1423,72 @@ AtomTree::update_xyz_coords() const
 	}
 }
 
+/// @details A refold root reads the coordinates of its ancestors up to the nearest jump atom
+/// (and of that jump atom's first children, which define its stub) and writes only atoms in
+/// its own subtree, the subtrees of its younger siblings included.  Roots below different
+/// jump atoms therefore touch disjoint atoms, save for a root that is itself a jump atom,
+/// which reads its input stub from the far side of its jump and so is grouped with the
+/// jump atom above it.  The walks up the tree remember the jump atom they found, so that
+/// no atom is passed twice.
+void
+AtomTree::group_refold_roots( utility::vector1< utility::vector1< Size > > & groups ) const
+{
+	using tree::Atom;
+
+	groups.clear();
+	std::unordered_map< Atom const *, Atom const * > jump_above;
+	std::unordered_map< Atom const *, Size > group_of_jump;
+	utility::vector1< Atom const * > path;
+	for ( Size ii = 1; ii <= dof_changeset_.size(); ++ii ) {
+		if ( dof_changeset_[ ii ].reached_ ) continue;
+		Atom const * atom( atom_pointer_[ dof_changeset_[ ii ].atomid_ ].get() );
+		if ( atom->is_jump() ) atom = atom->raw_parent();
+
+		Atom const * jump( nullptr ); // stays null above the root of the tree
+		path.clear();
+		while ( atom ) {
+			auto const known( jump_above.find( atom ) );
+			if ( known != jump_above.end() ) {
+				jump = known->second;
+				break;
+			}
+			if ( atom->is_jump() ) {
+				jump = atom;
+				break;
+			}
+			path.push_back( atom );
+			atom = atom->raw_parent();
+		}
+		for ( Atom const * on_path : path ) jump_above[ on_path ] = jump;
+
+		auto const group( group_of_jump.insert( std::make_pair( jump, groups.size() + 1 ) ) );
+		if ( group.second ) groups.push_back( utility::vector1< Size >() );
+		groups[ group.first->second ].push_back( ii );
+	}
+}
+
+void
+AtomTree::refold_from_dof_changes( utility::vector1< Size > const & changes ) const
+{
+	for ( Size const ii : changes ) {
+		atom_pointer_[ dof_changeset_[ ii ].atomid_ ]->update_xyz_coords(); // it must find its own stub.
+	}
+}
+
+void
+AtomTree::refold_threads( Size nthreads )
+{
+	refold_threads_ = std::max( nthreads, Size( 1 ) );
+}
+
+void
+AtomTree::reset_refold_counters()
+{
+	n_refolds_ = 0;
+	n_atoms_refolded_ = 0;
+	n_atoms_last_refold_ = 0;
+}
+
 /// @brief The AtomTree provides to the Conformation object a list of residues
 /// whose xyz coordinates have changed.  When the Conformation has finished reading off
 /// residues that have changed from the AtomTree, and has copied the coordinates of
@@ -2085,6 +2193,8 @@ core::kinematics::AtomTree::save( Archive & arc ) const {
 	//arc( CEREAL_NVP( topological_observers_ ) ); // utility::vector1<AtomTreeCAP>
 	arc( CEREAL_NVP( dof_changeset_ ) ); // AtomDOFChangeSet
 	arc( CEREAL_NVP( external_coordinate_residues_changed_ ) ); // ResidueCoordinateChangeListOP
+	arc( CEREAL_NVP( refold_threads_ ) ); // Size
+	// EXEMPT n_refolds_ n_atoms_refolded_ n_atoms_last_refold_
 }
 
 /// @brief Automatically generated deserialization method
@@ -2101,6 +2211,8 @@ core::kinematics::AtomTree::load( Archive & arc ) {
 	//arc( topological_observers_ ); // utility::vector1<AtomTreeCAP>
 	arc( dof_changeset_ ); // AtomDOFChangeSet
 	arc( external_coordinate_residues_changed_ ); // ResidueCoordinateChangeListOP
+	arc( refold_threads_ ); // Size
+	// EXEMPT n_refolds_ n_atoms_refolded_ n_atoms_last_refold_
 }
 
 SAVE_AND_LOAD_SERIALIZABLE( core::kinematics::AtomTree );
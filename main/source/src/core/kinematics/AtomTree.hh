@@ -326,6 +326,47 @@ public: // Methods
 	void
 	note_coordinate_change_registered() const;
 
+	/// @brief Refold the parts of the tree built from different jumps in up to this many threads.
+	/// @details The DOF changes made since the last refold are collected and refolded together,
+	/// starting only at those changed atoms that are not downstream of another one.  These
+	/// starting atoms are grouped by the jump that builds them; groups touch disjoint atoms,
+	/// so each is refolded in a thread of its own.  The default, 1, refolds serially.  Has no
+	/// effect on builds without threads.
+	void
+	refold_threads( Size nthreads );
+
+	Size
+	refold_threads() const
+	{
+		return refold_threads_;
+	}
+
+	/// @brief The number of times DOF changes were refolded into coordinates since construction
+	/// or the last reset_refold_counters()
+	Size
+	n_refolds() const
+	{
+		return n_refolds_;
+	}
+
+	/// @brief The number of atoms placed by those refolds, as counted by the search for the
+	/// atoms to refold from (which visits a changed atom twice if it is reached from another)
+	Size
+	n_atoms_refolded() const
+	{
+		return n_atoms_refolded_;
+	}
+
+	/// @brief The number of atoms placed by the latest refold
+	Size
+	n_atoms_last_refold() const
+	{
+		return n_atoms_last_refold_;
+	}
+
+	void
+	reset_refold_counters();
+
 public: // Properties
 
 	/// @brief is there any atom in the tree yet?
@@ -581,6 +622,15 @@ private: // Methods
 	void
 	update_xyz_coords() const;
 
+	/// @brief  Group the refold roots in dof_changeset_ -- the changed atoms not reached by
+	/// the dfs from another -- by the jump atom whose subtree holds everything they read and write
+	void
+	group_refold_roots( utility::vector1< utility::vector1< Size > > & groups ) const;
+
+	/// @brief  Refold from each of the given dof_changeset_ entries, in order
+	void
+	refold_from_dof_changes( utility::vector1< Size > const & changes ) const;
+
 
 	/// @brief  Notify self of new tree topology
 	/// Useful if we move to caching some things that depend on the tree
@@ -628,6 +678,14 @@ private: // Fields
 	/// time the owning Conformation object has asked for an update.
 	ResidueCoordinateChangeListOP external_coordinate_residues_changed_;
 
+	/// @brief The number of threads to refold independent subtrees in
+	Size refold_threads_;
+
+	/// @brief Refold counters; see n_refolds()
+	mutable Size n_refolds_;
+	mutable Size n_atoms_refolded_;
+	mutable Size n_atoms_last_refold_;
+
 	/// @ (SOON) A list of residues that have had DOF changes since the last
 	/// time the owning Conformation object has asked for an update.
 	//ResidueCoordinateChangeListOP internal_coordinate_residues_changed_;
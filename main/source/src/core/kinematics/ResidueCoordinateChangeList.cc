@@ -38,7 +38,8 @@ namespace kinematics {
 ResidueCoordinateChangeList::ResidueCoordinateChangeList()
 :
 	ReferenceCount(),
-	total_residue_( 0 )
+	total_residue_( 0 ),
+	n_atoms_marked_( 0 )
 {
 }
 
@@ -117,6 +118,7 @@ ResidueCoordinateChangeList::clear()
 void
 ResidueCoordinateChangeList::mark_residue_moved( id::AtomID atid )
 {
+	++n_atoms_marked_;
 	mark_residue_moved( atid.rsd() );
 }
 
@@ -165,6 +167,7 @@ core::kinematics::ResidueCoordinateChangeList::save( Archive & arc ) const {
 	arc( CEREAL_NVP( changed_residues_ ) ); // ResidueIndexList
 	arc( CEREAL_NVP( residue_change_id_ ) ); // utility::vector1<Size>
 	arc( CEREAL_NVP( total_residue_ ) ); // Size
+	// EXEMPT n_atoms_marked_
 }
 
 /// @brief Automatically generated deserialization method
@@ -174,6 +177,7 @@ core::kinematics::ResidueCoordinateChangeList::load( Archive & arc ) {
 	arc( changed_residues_ ); // ResidueIndexList
 	arc( residue_change_id_ ); // utility::vector1<Size>
 	arc( total_residue_ ); // Size
+	// EXEMPT n_atoms_marked_
 }
 
 SAVE_AND_LOAD_SERIALIZABLE( core::kinematics::ResidueCoordinateChangeList );
@@ -86,6 +86,13 @@ public:
 	ResidueListIterator
 	residues_moved_end() const;
 
+	/// @brief The number of times an atom has been marked as moved, over the lifetime of
+	/// this list; the AtomTree counts the atoms it refolds with it.
+	Size
+	n_atoms_marked() const {
+		return n_atoms_marked_;
+	}
+
 private:
 	/// @brief O(N) -- used in assert statements in debug mode
 	bool
@@ -100,6 +107,8 @@ private:
 
 	Size total_residue_;
 
+	Size n_atoms_marked_;
+
 #ifdef    SERIALIZATION
 public:
 	template< class Archive > void save( Archive & arc ) const;
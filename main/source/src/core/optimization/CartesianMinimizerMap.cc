@@ -14,6 +14,7 @@
 
 // Unit headers
 #include <core/optimization/CartesianMinimizerMap.hh>
+#include <core/scoring/MinimizationGraph.hh>
 
 
 // Project headers
@@ -52,6 +53,13 @@ CartesianMinimizerMap::~CartesianMinimizerMap() {
 	moving_torsionids_.clear();
 }
 
+scoring::MinEdgeDerivativeScratch &
+CartesianMinimizerMap::edge_derivative_scratch()
+{
+	if ( ! edge_derivative_scratch_ ) edge_derivative_scratch_ = utility::pointer::make_shared< scoring::MinEdgeDerivativeScratch >();
+	return *edge_derivative_scratch_;
+}
+
 
 /////////////////////////////////////////////////////////////////////////////
 void
@@ -31,6 +31,7 @@
 #include <core/kinematics/MoveMap.fwd.hh>
 #include <core/id/AtomID_Map.hh>
 #include <core/scoring/DerivVectorPair.hh>
+#include <core/scoring/MinimizationGraph.fwd.hh>
 
 
 #include <utility/vector1.hh>
@@ -125,6 +126,17 @@ public:
 		return atom_derivatives_[ resid ];
 	}
 
+	/// @brief The derivative arrays for all residues, indexed by residue and then atom
+	utility::vector1< utility::vector1< core::scoring::DerivVectorPair > > &
+	all_atom_derivatives() {
+		return atom_derivatives_;
+	}
+
+	/// @brief Thread count and buffers for the threaded edge derivative evaluation, created on
+	/// first use and kept for the life of this map
+	scoring::MinEdgeDerivativeScratch &
+	edge_derivative_scratch();
+
 	void
 	zero_stored_derivs();
 
@@ -147,6 +159,8 @@ private:
 
 	utility::vector1< utility::vector1< core::scoring::DerivVectorPair > > atom_derivatives_;
 
+	scoring::MinEdgeDerivativeScratchOP edge_derivative_scratch_;
+
 	/// list of all moving torsions: dof ids and torsion ids
 	/// we don't need all the info from dof_node, just this
 	utility::vector1<id::DOF_ID> moving_dofids_;
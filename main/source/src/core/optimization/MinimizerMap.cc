@@ -13,6 +13,7 @@
 
 // Unit headers
 #include <core/optimization/MinimizerMap.hh>
+#include <core/scoring/MinimizationGraph.hh>
 
 
 // Project headers
@@ -60,6 +61,13 @@ MinimizerMap::~MinimizerMap()
 	clear_dof_nodes();
 }
 
+scoring::MinEdgeDerivativeScratch &
+MinimizerMap::edge_derivative_scratch()
+{
+	if ( ! edge_derivative_scratch_ ) edge_derivative_scratch_ = utility::pointer::make_shared< scoring::MinEdgeDerivativeScratch >();
+	return *edge_derivative_scratch_;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // this will only work properly if the DOFs are sorted in decreasing
 // depth
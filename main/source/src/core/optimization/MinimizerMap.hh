@@ -31,6 +31,7 @@
 #include <core/id/AtomID_Map.hh>
 #include <core/id/DOF_ID_Map.hh>
 #include <core/scoring/DerivVectorPair.hh>
+#include <core/scoring/MinimizationGraph.fwd.hh>
 
 // Rosetta headers
 // #include <util_basic.hh>
@@ -235,6 +236,17 @@ public:
 		return atom_derivatives_[ resid ];
 	}
 
+	/// @brief The derivative arrays for all residues, indexed by residue and then atom
+	utility::vector1< utility::vector1< DerivVectorPair > > &
+	all_atom_derivatives() {
+		return atom_derivatives_;
+	}
+
+	/// @brief Thread count and buffers for the threaded edge derivative evaluation, created on
+	/// first use and kept for the life of this map
+	scoring::MinEdgeDerivativeScratch &
+	edge_derivative_scratch();
+
 private:
 
 	/// deletes and clears dof_nodes_
@@ -257,6 +269,8 @@ private:
 
 	utility::vector1< utility::vector1< DerivVectorPair > > atom_derivatives_;
 
+	scoring::MinEdgeDerivativeScratchOP edge_derivative_scratch_;
+
 }; // MinimizerMap
 
 
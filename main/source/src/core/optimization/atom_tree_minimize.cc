@@ -251,21 +251,7 @@ atom_tree_get_atompairE_deriv(
 	}
 
 	/// 2. eval inter-residue derivatives
-	for ( utility::graph::Node::EdgeListConstIter
-			edgeit = mingraph->const_edge_list_begin(), edgeit_end = mingraph->const_edge_list_end();
-			edgeit != edgeit_end; ++edgeit ) {
-		auto const & minedge = static_cast< MinimizationEdge const & > ( (**edgeit) );
-		Size const rsd1ind = minedge.get_first_node_ind();
-		Size const rsd2ind = minedge.get_second_node_ind();
-		conformation::Residue const & rsd1( pose.residue( rsd1ind ));
-		conformation::Residue const & rsd2( pose.residue( rsd2ind ));
-		ResSingleMinimizationData const & r1_min_data( mingraph->get_minimization_node( rsd1ind )->res_min_data() );
-		ResSingleMinimizationData const & r2_min_data( mingraph->get_minimization_node( rsd2ind )->res_min_data() );
-
-		eval_atom_derivatives_for_minedge( minedge, rsd1, rsd2,
-			r1_min_data, r2_min_data, pose, scorefxn.weights(),
-			min_map.atom_derivatives( rsd1ind ), min_map.atom_derivatives( rsd2ind ));
-	}
+	eval_atom_derivatives_for_minedges( *mingraph, pose, scorefxn.weights(), false, min_map.edge_derivative_scratch(), min_map.all_atom_derivatives() );
 
 	for ( auto iter = min_map.begin(), iter_e = min_map.end();
 			iter != iter_e; ++iter ) {
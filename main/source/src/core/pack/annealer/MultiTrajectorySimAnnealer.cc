@@ -0,0 +1,433 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/pack/annealer/MultiTrajectorySimAnnealer.cc
+/// @brief  Annealer that runs several independent or replica-exchange trajectories over one
+/// precomputed interaction graph and reports the best few rotamer assignments.
+
+// Unit Headers
+#include <core/pack/annealer/MultiTrajectorySimAnnealer.hh>
+
+// Package Headers
+#include <core/pack/interaction_graph/PrecomputedPairEnergiesInteractionGraph.hh>
+#include <core/pack/rotamer_set/FixbbRotamerSets.hh>
+
+#include <basic/Tracer.hh>
+#include <basic/options/option.hh>
+#include <basic/options/keys/multithreading.OptionKeys.gen.hh>
+
+#include <numeric/random/random.hh>
+
+#include <utility/exit.hh>
+
+#ifdef MULTI_THREADED
+#include <basic/thread_manager/RosettaThreadManager.hh>
+#include <utility/pointer/memory.hh>
+#include <functional>
+#endif
+
+// C++ headers
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace ObjexxFCL;
+
+static basic::Tracer TR( "core.pack.annealer.MultiTrajectorySimAnnealer" );
+
+namespace core {
+namespace pack {
+namespace annealer {
+
+/// @brief The private state of one annealing trajectory
+struct MultiTrajectorySimAnnealer::Trajectory {
+	Size index = 0;
+	std::mt19937 rng;
+	utility::vector1< int > state;
+	utility::vector1< int > best_state;
+	core::PackerEnergy energy = 0.0;
+	core::PackerEnergy best_energy = 0.0;
+	core::PackerEnergy temperature = 0.0;
+	int jump = 0;
+	bool quench = false;
+	utility::vector1< core::PackerEnergy > loopenergy;
+	utility::vector0< int > quench_order;
+
+	double uniform() { return std::uniform_real_distribution< double >( 0.0, 1.0 )( rng ); }
+};
+
+MultiTrajectorySimAnnealer::MultiTrajectorySimAnnealer(
+	utility::vector0< int > & rot_to_pack,
+	FArray1D_int & bestrotamer_at_seqpos,
+	core::PackerEnergy & bestenergy,
+	bool start_with_current, // start simulation with current rotamers
+	PrecomputedPairEnergiesInteractionGraphOP ig,
+	FixbbRotamerSetsCOP rotamer_sets,
+	FArray1_int & current_rot_index,
+	bool calc_rot_freq,
+	FArray1D< core::PackerEnergy > & rot_freq
+):
+	RotamerAssigningAnnealer(
+	rot_to_pack,
+	(int) rot_to_pack.size(),
+	bestrotamer_at_seqpos,
+	bestenergy,
+	start_with_current, // start simulation with current rotamers
+	rotamer_sets,
+	current_rot_index,
+	calc_rot_freq,
+	rot_freq
+	),
+	ig_( ig ),
+	n_trajectories_( 1 ),
+	n_best_( 1 ),
+	replica_exchange_( false ),
+	nthreads_( 0 ),
+	outeriterations_( 0 ),
+	inneriterations_( 0 ),
+	n_exchanges_( 0 )
+{
+	if ( calc_rot_freq ) {
+		TR.Warning << "Rotamer frequencies are not calculated by the MultiTrajectorySimAnnealer" << std::endl;
+	}
+}
+
+MultiTrajectorySimAnnealer::~MultiTrajectorySimAnnealer() = default;
+
+void MultiTrajectorySimAnnealer::n_trajectories( Size setting ) { n_trajectories_ = std::max( setting, Size( 1 ) ); }
+Size MultiTrajectorySimAnnealer::n_trajectories() const { return n_trajectories_; }
+void MultiTrajectorySimAnnealer::n_best( Size setting ) { n_best_ = std::max( setting, Size( 1 ) ); }
+Size MultiTrajectorySimAnnealer::n_best() const { return n_best_; }
+void MultiTrajectorySimAnnealer::replica_exchange( bool setting ) { replica_exchange_ = setting; }
+bool MultiTrajectorySimAnnealer::replica_exchange() const { return replica_exchange_; }
+void MultiTrajectorySimAnnealer::nthreads( Size setting ) { nthreads_ = setting; }
+Size MultiTrajectorySimAnnealer::nthreads() const { return nthreads_; }
+
+utility::vector1< MultiTrajectorySimAnnealer::Assignment > const &
+MultiTrajectorySimAnnealer::best_assignments() const { return best_assignments_; }
+
+Size MultiTrajectorySimAnnealer::n_exchanges() const { return n_exchanges_; }
+
+void MultiTrajectorySimAnnealer::run()
+{
+	best_assignments_.clear();
+	n_exchanges_ = 0;
+
+	ig_->prepare_for_simulated_annealing();
+	ig_->blanket_assign_state_0();
+
+	if ( num_rots_to_pack() == 0 ) return;
+
+	// prepare_for_simulated_annealing() may drop empty edges, so read the graph afterwards
+	snapshot_graph();
+
+	setup_iterations();
+	outeriterations_ = std::max( get_outeriterations(), 1 );
+	inneriterations_ = get_inneriterations();
+
+	// Seeds are drawn in trajectory order from the thread's generator before any work is
+	// handed out, so the outcome does not depend on the thread count.
+	utility::vector1< Trajectory > trajectories( n_trajectories_ );
+	for ( Size ii = 1; ii <= n_trajectories_; ++ii ) {
+		trajectories[ ii ].index = ii;
+		trajectories[ ii ].rng.seed( numeric::random::rg().random_range( 0, std::numeric_limits< int >::max() - 1 ) );
+		initialize_trajectory( trajectories[ ii ] );
+	}
+	std::mt19937 exchange_rng( numeric::random::rg().random_range( 0, std::numeric_limits< int >::max() - 1 ) );
+
+#ifdef MULTI_THREADED
+	Size const nthreads( nthreads_ == 0 ? Size( basic::options::option[ basic::options::OptionKeys::multithreading::total_threads ]() ) : nthreads_ );
+#endif
+
+	for ( int nn = 1; nn <= outeriterations_; ++nn ) {
+#ifdef MULTI_THREADED
+		utility::vector1< basic::thread_manager::RosettaThreadFunctionOP > work_vector;
+		work_vector.reserve( n_trajectories_ );
+		for ( Size ii = 1; ii <= n_trajectories_; ++ii ) {
+			work_vector.push_back( utility::pointer::make_shared< basic::thread_manager::RosettaThreadFunction >(
+				std::bind( &MultiTrajectorySimAnnealer::anneal_outer_iteration, this, std::ref( trajectories[ ii ] ), nn ) ) );
+		}
+		basic::thread_manager::RosettaThreadManager::get_instance()->do_work_vector_in_threads( work_vector, nthreads );
+#else
+		for ( Size ii = 1; ii <= n_trajectories_; ++ii ) {
+			anneal_outer_iteration( trajectories[ ii ], nn );
+		}
+#endif
+		if ( replica_exchange_ && nn < outeriterations_ ) {
+			attempt_replica_exchanges( trajectories, nn, exchange_rng );
+		}
+	}
+
+	collect_best_assignments( trajectories );
+}
+
+/// @details Caches, per node, the node's one-body table and the list of its edges, so that
+/// the trajectories can read the energies without touching the graph's own (stateful)
+/// bookkeeping.
+void MultiTrajectorySimAnnealer::snapshot_graph()
+{
+	using namespace interaction_graph;
+
+	int const nnodes = ig_->get_num_nodes();
+	nodes_.assign( nnodes, nullptr );
+	neighbors_.assign( nnodes, utility::vector1< NeighborEdge >() );
+	states_for_node_.assign( nnodes, utility::vector1< int >() );
+
+	PrecomputedPairEnergiesInteractionGraph const & ig( *ig_ );
+	for ( int ii = 1; ii <= nnodes; ++ii ) {
+		nodes_[ ii ] = static_cast< PrecomputedPairEnergiesNode const * >( ig.get_node( ii ) );
+	}
+	for ( auto iter = ig.get_edge_list_begin(); iter != ig.get_edge_list_end(); ++iter ) {
+		auto const * edge = static_cast< PrecomputedPairEnergiesEdge const * >( *iter );
+		int const first = edge->get_first_node_ind();
+		int const second = edge->get_second_node_ind();
+		neighbors_[ first ].push_back( NeighborEdge{ second, edge, true } );
+		neighbors_[ second ].push_back( NeighborEdge{ first, edge, false } );
+	}
+
+	for ( Size ii = 0; ii < num_rots_to_pack(); ++ii ) {
+		int const rot = rot_to_pack()[ ii ];
+		states_for_node_[ rotamer_sets()->moltenres_for_rotamer( rot ) ].push_back( rotamer_sets()->rotid_on_moltenresidue( rot ) );
+	}
+	for ( int ii = 1; ii <= nnodes; ++ii ) {
+		if ( states_for_node_[ ii ].empty() ) {
+			utility_exit_with_message( "MultiTrajectorySimAnnealer: no pickable rotamers for molten residue " + std::to_string( ii ) );
+		}
+	}
+}
+
+/// @brief The energy of a node in the given state with its neighbors in their current states
+core::PackerEnergy
+MultiTrajectorySimAnnealer::node_energy( Trajectory const & traj, int node, int state ) const
+{
+	core::PackerEnergy energy = nodes_[ node ]->get_one_body_energy( state );
+	for ( NeighborEdge const & nbr : neighbors_[ node ] ) {
+		int const other_state = traj.state[ nbr.other_node ];
+		energy += nbr.node_is_first ?
+			nbr.edge->get_two_body_energy( state, other_state ) :
+			nbr.edge->get_two_body_energy( other_state, state );
+	}
+	return energy;
+}
+
+core::PackerEnergy
+MultiTrajectorySimAnnealer::total_energy( Trajectory const & traj ) const
+{
+	core::PackerEnergy energy = 0.0;
+	for ( Size ii = 1; ii <= nodes_.size(); ++ii ) {
+		energy += nodes_[ ii ]->get_one_body_energy( traj.state[ ii ] );
+		for ( NeighborEdge const & nbr : neighbors_[ ii ] ) {
+			if ( nbr.node_is_first ) {
+				energy += nbr.edge->get_two_body_energy( traj.state[ ii ], traj.state[ nbr.other_node ] );
+			}
+		}
+	}
+	return energy;
+}
+
+/// @details Every node is given a state up front -- the current rotamer if starting with the
+/// current rotamers and one is available, a random pickable state otherwise -- so that the
+/// energy of every substitution is defined.
+void MultiTrajectorySimAnnealer::initialize_trajectory( Trajectory & traj ) const
+{
+	Size const nnodes = nodes_.size();
+	traj.state.assign( nnodes, 0 );
+	for ( Size ii = 1; ii <= nnodes; ++ii ) {
+		utility::vector1< int > const & states( states_for_node_[ ii ] );
+		traj.state[ ii ] = states[ 1 + static_cast< Size >( states.size() * traj.uniform() ) % states.size() ];
+	}
+	if ( start_with_current() ) {
+		for ( Size ii = 1; ii <= current_rot_index().size(); ++ii ) {
+			int const rot = current_rot_index()( ii );
+			if ( rot < 1 || rot > (int) rotamer_sets()->nrotamers() ) continue;
+			traj.state[ rotamer_sets()->moltenres_for_rotamer( rot ) ] = rotamer_sets()->rotid_on_moltenresidue( rot );
+		}
+	}
+	traj.energy = total_energy( traj );
+	traj.best_state = traj.state;
+	traj.best_energy = traj.energy;
+	traj.loopenergy.assign( outeriterations_, 0.0 );
+	traj.quench_order = rot_to_pack();
+	traj.temperature = get_hightemp();
+	traj.jump = 0;
+	traj.quench = false;
+}
+
+/// @details Independent trajectories follow SimAnnealerBase::setup_temperature, reheating
+/// when the energy stops dropping; replicas keep a fixed rung of a geometric ladder.
+void MultiTrajectorySimAnnealer::setup_trajectory_temperature( Trajectory & traj, int nn ) const
+{
+	core::PackerEnergy const high = get_hightemp();
+	core::PackerEnergy const low = get_lowtemp();
+
+	if ( nn == outeriterations_ && ! get_disallow_quench() ) {
+		traj.quench = true;
+		traj.temperature = low;
+	} else if ( replica_exchange_ ) {
+		core::PackerEnergy const fraction = n_trajectories_ == 1 ? 0.0 :
+			core::PackerEnergy( traj.index - 1 ) / ( n_trajectories_ - 1 );
+		traj.temperature = low * std::pow( high / low, fraction );
+	} else if ( traj.jump > 3 ) {
+		core::PackerEnergy const avgloopE = ( traj.loopenergy[ nn - 4 ] + traj.loopenergy[ nn - 3 ] + traj.loopenergy[ nn - 2 ] ) / 3.0;
+		if ( ( traj.loopenergy[ nn - 1 ] - avgloopE ) > -1.0 ) {
+			traj.temperature = high;
+			traj.jump = 1;
+		} else {
+			traj.temperature = ( high - low ) * std::exp( -core::PackerEnergy( traj.jump ) ) + low;
+			++traj.jump;
+		}
+	} else {
+		traj.temperature = ( high - low ) * std::exp( -core::PackerEnergy( traj.jump ) ) + low;
+		++traj.jump;
+	}
+}
+
+/// @details Mirrors SimAnnealerBase::pass_metropolis, with the trajectory's temperature and generator
+bool MultiTrajectorySimAnnealer::pass_metropolis(
+	Trajectory & traj,
+	core::PackerEnergy previous_energy,
+	core::PackerEnergy delta_energy
+) const
+{
+	if ( traj.quench ) return delta_energy < 0;
+
+	core::PackerEnergy const rg_uniform( traj.uniform() );
+	if ( delta_energy < 0 ) return true;
+
+	core::PackerEnergy lnprob = delta_energy / traj.temperature;
+	if ( previous_energy > 1.0 ) {
+		lnprob /= previous_energy;
+	}
+	return lnprob < 10.0 && std::exp( -lnprob ) > rg_uniform;
+}
+
+/// @details One temperature step of one trajectory.  Reads only the snapshot of the graph
+/// and writes only to traj, so the trajectories of an outer iteration may run concurrently.
+void MultiTrajectorySimAnnealer::anneal_outer_iteration( Trajectory & traj, int nn ) const
+{
+	setup_trajectory_temperature( traj, nn );
+	if ( traj.quench ) {
+		traj.state = traj.best_state;
+		traj.energy = traj.best_energy;
+	}
+
+	int const nrots = traj.quench_order.size();
+	for ( int n = 1; n <= inneriterations_; ++n ) {
+		int ranrotamer;
+		if ( traj.quench ) {
+			// pass through all rotamers before repeating one
+			int const num = ( n - 1 ) % nrots;
+			if ( num == 0 ) std::shuffle( traj.quench_order.begin(), traj.quench_order.end(), traj.rng );
+			ranrotamer = traj.quench_order[ num ];
+		} else {
+			ranrotamer = traj.quench_order[ std::min( static_cast< int >( nrots * traj.uniform() ), nrots - 1 ) ];
+		}
+
+		int const node = rotamer_sets()->moltenres_for_rotamer( ranrotamer );
+		int const new_state = rotamer_sets()->rotid_on_moltenresidue( ranrotamer );
+		int const prev_state = traj.state[ node ];
+		if ( new_state == prev_state ) continue;
+
+		core::PackerEnergy const previous_energy_for_node = node_energy( traj, node, prev_state );
+		core::PackerEnergy const delta_energy = node_energy( traj, node, new_state ) - previous_energy_for_node;
+
+		if ( pass_metropolis( traj, previous_energy_for_node, delta_energy ) ) {
+			traj.state[ node ] = new_state;
+			traj.energy += delta_energy;
+			if ( traj.energy < traj.best_energy ) {
+				traj.best_state = traj.state;
+				traj.best_energy = traj.energy;
+			}
+		}
+	}
+	traj.loopenergy[ nn ] = traj.energy;
+}
+
+/// @details Alternates between pairing (1,2),(3,4),... and (2,3),(4,5),... so that an
+/// assignment can travel the whole ladder.
+void MultiTrajectorySimAnnealer::attempt_replica_exchanges(
+	utility::vector1< Trajectory > & trajectories,
+	int nn,
+	std::mt19937 & exchange_rng
+)
+{
+	std::uniform_real_distribution< double > uniform( 0.0, 1.0 );
+	for ( Size ii = 1 + ( nn + 1 ) % 2; ii + 1 <= n_trajectories_; ii += 2 ) {
+		Trajectory & lower( trajectories[ ii ] );
+		Trajectory & upper( trajectories[ ii + 1 ] );
+		core::PackerEnergy const log_accept = ( 1.0 / lower.temperature - 1.0 / upper.temperature ) * ( lower.energy - upper.energy );
+		if ( log_accept >= 0 || uniform( exchange_rng ) < std::exp( log_accept ) ) {
+			std::swap( lower.state, upper.state );
+			std::swap( lower.energy, upper.energy );
+			++n_exchanges_;
+		}
+	}
+}
+
+/// @details Each trajectory's best assignment is rescored by the interaction graph; the
+/// distinct ones are kept, lowest energy first, and the graph is left in the lowest.
+void MultiTrajectorySimAnnealer::collect_best_assignments( utility::vector1< Trajectory > const & trajectories )
+{
+	utility::vector1< Size > order( trajectories.size() );
+	for ( Size ii = 1; ii <= order.size(); ++ii ) order[ ii ] = ii;
+	std::stable_sort( order.begin(), order.end(), [&trajectories]( Size a, Size b ) {
+		return trajectories[ a ].best_energy < trajectories[ b ].best_energy;
+		} );
+
+	int const nnodes = nodes_.size();
+	FArray1D_int network_state( nnodes, 0 );
+	utility::vector1< utility::vector1< int > const * > kept_states;
+	for ( Size const ii : order ) {
+		if ( best_assignments_.size() == n_best_ ) break;
+		Trajectory const & traj( trajectories[ ii ] );
+		bool duplicate = false;
+		for ( auto const * kept : kept_states ) {
+			if ( *kept == traj.best_state ) { duplicate = true; break; }
+		}
+		if ( duplicate ) continue;
+		kept_states.push_back( &traj.best_state );
+
+		for ( int jj = 1; jj <= nnodes; ++jj ) network_state( jj ) = traj.best_state[ jj ];
+		core::PackerEnergy const energy = ig_->set_network_state( network_state );
+		if ( std::abs( energy - traj.best_energy ) > 1e-3 * std::max( core::PackerEnergy( 1.0 ), std::abs( energy ) ) ) {
+			TR.Warning << "Trajectory " << ii << " energy " << traj.best_energy << " differs from the interaction graph's "
+				<< energy << "; does the graph hold non-pairwise terms?" << std::endl;
+		}
+
+		Assignment assignment;
+		assignment.energy = energy;
+		assignment.rotamer_at_seqpos = bestrotamer_at_seqpos();
+		for ( int jj = 1; jj <= nnodes; ++jj ) {
+			assignment.rotamer_at_seqpos( rotamer_sets()->moltenres_2_resid( jj ) ) =
+				rotamer_sets()->moltenres_rotid_2_rotid( jj, traj.best_state[ jj ] );
+		}
+		assignment.trajectory = ii;
+		best_assignments_.push_back( assignment );
+	}
+
+	std::stable_sort( best_assignments_.begin(), best_assignments_.end(), []( Assignment const & a, Assignment const & b ) {
+		return a.energy < b.energy;
+		} );
+
+	Assignment const & best( best_assignments_[ 1 ] );
+	bestenergy() = best.energy;
+	bestrotamer_at_seqpos() = best.rotamer_at_seqpos;
+	for ( int jj = 1; jj <= nnodes; ++jj ) {
+		network_state( jj ) = rotamer_sets()->rotid_on_moltenresidue( best.rotamer_at_seqpos( rotamer_sets()->moltenres_2_resid( jj ) ) );
+	}
+	ig_->set_network_state( network_state );
+
+	TR.Debug << "Annealed " << n_trajectories_ << " trajectories; best energy " << best.energy
+		<< ", kept " << best_assignments_.size() << " distinct assignments" << std::endl;
+}
+
+}//end namespace annealer
+}//end namespace pack
+}//end namespace core
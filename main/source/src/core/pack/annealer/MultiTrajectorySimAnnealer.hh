@@ -0,0 +1,168 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/pack/annealer/MultiTrajectorySimAnnealer.hh
+/// @brief  Annealer that runs several independent or replica-exchange trajectories over one
+/// precomputed interaction graph and reports the best few rotamer assignments.
+
+#ifndef INCLUDED_core_pack_annealer_MultiTrajectorySimAnnealer_hh
+#define INCLUDED_core_pack_annealer_MultiTrajectorySimAnnealer_hh
+
+// Unit Headers
+#include <core/pack/annealer/MultiTrajectorySimAnnealer.fwd.hh>
+
+// Package Headers
+#include <core/pack/annealer/RotamerAssigningAnnealer.hh>
+
+#include <core/pack/interaction_graph/PrecomputedPairEnergiesInteractionGraph.fwd.hh>
+
+#include <core/pack/rotamer_set/FixbbRotamerSets.fwd.hh>
+
+// ObjexxFCL headers
+#include <ObjexxFCL/FArray1D.hh>
+
+// Utility headers
+#include <utility/vector0.hh>
+#include <utility/vector1.hh>
+
+// C++ headers
+#include <random>
+
+namespace core {
+namespace pack {
+namespace annealer {
+
+/// @brief Runs n_trajectories simulated-annealing trajectories at once over a single
+/// precomputed interaction graph, so that a library of low-energy designs costs one
+/// interaction-graph fill rather than one per design.
+///
+/// @details The graph's node and edge energy tables are only read, never written, so the
+/// trajectories share them; each trajectory keeps its own state-per-node array, running
+/// energy, temperature schedule and random number generator.  The trajectories advance
+/// in lock step one outer iteration (temperature step) at a time, and in multithreaded
+/// builds the trajectories of an outer iteration are run in the RosettaThreadManager's
+/// threads.  Each trajectory's generator is seeded from numeric::random::rg() before
+/// annealing starts, so the results depend on the Rosetta seed but not on the number of
+/// threads.
+///
+/// In the default, independent, mode every trajectory follows the FixbbSimAnnealer
+/// temperature schedule, including its reheating.  In replica-exchange mode trajectory i
+/// instead holds a fixed temperature on a geometric ladder between the low and the high
+/// temperature, and after each outer iteration neighboring replicas attempt to swap
+/// their assignments with the usual parallel-tempering criterion; every replica is
+/// quenched in the final outer iteration.
+///
+/// Energies are evaluated from the pairwise-decomposable tables, so the annealer is meant
+/// for graphs without non-pairwise terms.  The reported energies are recomputed by the
+/// interaction graph itself once annealing ends.  The best assignment of each trajectory
+/// is kept; best_assignments() holds up to n_best of them, distinct and lowest energy
+/// first, and the lowest is also written to bestrotamer_at_seqpos and bestenergy as with
+/// the other annealers.  Rotamer-frequency calculation and FixbbSimAnnealer's
+/// virtual-water heuristic are not supported.
+class MultiTrajectorySimAnnealer : public RotamerAssigningAnnealer
+{
+public:
+	typedef interaction_graph::PrecomputedPairEnergiesInteractionGraphOP PrecomputedPairEnergiesInteractionGraphOP;
+
+	/// @brief One rotamer assignment found by the annealer
+	struct Assignment {
+		core::PackerEnergy energy;
+		/// @brief The rotamer index (into the RotamerSets) at each packed residue
+		ObjexxFCL::FArray1D_int rotamer_at_seqpos;
+		/// @brief The trajectory (replica slot, in replica-exchange mode) that found it
+		Size trajectory;
+	};
+
+public:
+	MultiTrajectorySimAnnealer(
+		utility::vector0< int > & rot_to_pack,
+		ObjexxFCL::FArray1D_int & bestrotamer_at_seqpos,
+		core::PackerEnergy & bestenergy,
+		bool start_with_current, // start simulation with current rotamers
+		PrecomputedPairEnergiesInteractionGraphOP ig,
+		FixbbRotamerSetsCOP rotamer_sets,
+		ObjexxFCL::FArray1_int & current_rot_index,
+		bool calc_rot_freq,
+		ObjexxFCL::FArray1D< core::PackerEnergy > & rot_freq
+	);
+
+	~MultiTrajectorySimAnnealer() override;
+
+	void run() override;
+
+	void n_trajectories( Size setting );
+	Size n_trajectories() const;
+
+	/// @brief The number of distinct assignments to report; at most n_trajectories
+	void n_best( Size setting );
+	Size n_best() const;
+
+	void replica_exchange( bool setting );
+	bool replica_exchange() const;
+
+	/// @brief The number of threads to request; 0 means -multithreading:total_threads
+	void nthreads( Size setting );
+	Size nthreads() const;
+
+	/// @brief The distinct best assignments, lowest energy first; filled by run()
+	utility::vector1< Assignment > const & best_assignments() const;
+
+	/// @brief The number of accepted replica swaps in the last run()
+	Size n_exchanges() const;
+
+private:
+	struct Trajectory;
+
+	/// @brief One entry in a node's neighbor list; the edge's tables are indexed
+	/// [ lower-node state, upper-node state ].
+	struct NeighborEdge {
+		int other_node;
+		interaction_graph::PrecomputedPairEnergiesEdge const * edge;
+		bool node_is_first;
+	};
+
+	void snapshot_graph();
+
+	core::PackerEnergy node_energy( Trajectory const & traj, int node, int state ) const;
+	core::PackerEnergy total_energy( Trajectory const & traj ) const;
+
+	void initialize_trajectory( Trajectory & traj ) const;
+	void setup_trajectory_temperature( Trajectory & traj, int outer_iteration ) const;
+	bool pass_metropolis( Trajectory & traj, core::PackerEnergy previous_energy, core::PackerEnergy delta_energy ) const;
+	void anneal_outer_iteration( Trajectory & traj, int outer_iteration ) const;
+	void attempt_replica_exchanges( utility::vector1< Trajectory > & trajectories, int outer_iteration, std::mt19937 & exchange_rng );
+
+	void collect_best_assignments( utility::vector1< Trajectory > const & trajectories );
+
+private:
+	PrecomputedPairEnergiesInteractionGraphOP ig_;
+
+	Size n_trajectories_;
+	Size n_best_;
+	bool replica_exchange_;
+	Size nthreads_;
+
+	int outeriterations_;
+	int inneriterations_;
+
+	utility::vector1< interaction_graph::PrecomputedPairEnergiesNode const * > nodes_;
+	utility::vector1< utility::vector1< NeighborEdge > > neighbors_;
+	utility::vector1< utility::vector1< int > > states_for_node_;
+
+	utility::vector1< Assignment > best_assignments_;
+	Size n_exchanges_;
+
+	MultiTrajectorySimAnnealer( MultiTrajectorySimAnnealer const & rhs );
+};
+
+}//end namespace annealer
+}//end namespace pack
+}//end namespace core
+
+#endif
@@ -272,6 +272,7 @@ void SimAnnealerBase::set_hightemp( core::PackerEnergy high) { hightemp_ = high;
 void SimAnnealerBase::set_lowtemp( core::PackerEnergy low) { lowtemp_ = low; }
 
 void SimAnnealerBase::set_disallow_quench( bool const & setting ){ disallow_quench_ = setting; }
+bool SimAnnealerBase::get_disallow_quench() const { return disallow_quench_; }
 
 ////////////////////////////////////////////////////////////////////////////////
 ///
@@ -77,6 +77,7 @@ public:
 	bool get_start_with_current() const;
 	bool get_calc_rot_freq() const;
 	void set_disallow_quench( bool const & setting );
+	bool get_disallow_quench() const;
 
 	void set_hightemp( core::PackerEnergy );
 	void set_lowtemp( core::PackerEnergy );
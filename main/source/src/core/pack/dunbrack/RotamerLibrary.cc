@@ -51,6 +51,8 @@
 #include <utility/string_util.hh>
 #include <utility/io/izstream.hh>
 #include <utility/io/ozstream.hh>
+#include <utility/io/MappedFile.hh>
+#include <utility/pointer/memory.hh>
 #include <utility/thread/threadsafe_creation.hh>
 #include <utility/vector1.hh>
 #include <utility/file/file_sys_util.hh>
@@ -61,6 +63,7 @@
 // C++ Headers
 #include <string>
 #include <iostream>
+#include <sstream>
 #if defined(WIN32) || defined(__CYGWIN__)
 #include <io.h>
 #include <sys/stat.h>
@@ -365,14 +368,16 @@ void rotamer_from_chi_02(Real4 const & chi, chemical::AA const res, Size nchi,
 // removed pser and rna
 
 RotamerLibrary::RotamerLibrary():
-	aa_libraries_( chemical::num_canonical_aas ) // Resize with default (empty OP) constructor
+	aa_libraries_( chemical::num_canonical_aas ), // Resize with default (empty OP) constructor
+	binary_library_extents_( chemical::num_canonical_aas, std::make_pair( Size( 0 ), Size( 0 ) ) )
 {
 	this->initialize_from_options( basic::options::option );
 	this->create_fa_dunbrack_libraries();
 }
 
 RotamerLibrary::RotamerLibrary( utility::options::OptionCollection const & options ) :
-	aa_libraries_( chemical::num_canonical_aas ) // Resize with default (empty OP) constructor
+	aa_libraries_( chemical::num_canonical_aas ), // Resize with default (empty OP) constructor
+	binary_library_extents_( chemical::num_canonical_aas, std::make_pair( Size( 0 ), Size( 0 ) ) )
 {
 	this->initialize_from_options( options );
 	this->create_fa_dunbrack_libraries();
@@ -483,12 +488,29 @@ RotamerLibrary::add_residue_library(
 SingleResidueRotamerLibraryCOP
 RotamerLibrary::get_library_by_aa( chemical::AA const & aa ) const
 {
-	if ( (Size) aa <= aa_libraries_.size() ) {
-		return aa_libraries_[ aa ];
+	if ( (Size) aa > aa_libraries_.size() ) {
+		TR.Error << "Cannot get fullatom Dunbrack rotamer library of type " << aa << ": not a canonical amino acid." << std::endl;
+		utility_exit_with_message("Cannot get non-canonical fullatom Dunbrack library.");
+		return SingleResidueRotamerLibraryCOP();
 	}
-	TR.Error << "Cannot get fullatom Dunbrack rotamer library of type " << aa << ": not a canonical amino acid." << std::endl;
-	utility_exit_with_message("Cannot get non-canonical fullatom Dunbrack library.");
-	return SingleResidueRotamerLibraryCOP();
+
+	{ // Scope for read lock
+#ifdef MULTI_THREADED
+		utility::thread::ReadLockGuard readlock( aa_libraries_mutex_ );
+#endif
+		if ( aa_libraries_[ aa ] || binary_library_extents_[ aa ].second == 0 ) {
+			return aa_libraries_[ aa ];
+		}
+	} // End scope for read lock
+
+#ifdef MULTI_THREADED
+	utility::thread::WriteLockGuard writelock( aa_libraries_mutex_ );
+#endif
+	// Check again -- another thread may have loaded it between the release of the read lock and the write lock.
+	if ( ! aa_libraries_[ aa ] ) {
+		load_library_from_binary( aa );
+	}
+	return aa_libraries_[ aa ];
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -881,10 +903,14 @@ std::string RotamerLibrary::get_binary_name_10(bool for_writing /*=false*/ ) con
 ///    repaired ( prob <= 1e-6 not prob == 0 ) 1/12/15 Andy Watkins
 /// Version 24: Changed to templating on number of bbs, can't prove that this isn't needed 1/15/15 Andy Watkins
 /// Version 25: Fixed input bug that was definitely having real effects 1/22/15 Andy Watkins
+/// Version 26: Index of (aa, nbytes) pairs ahead of the per-aa data, so that the file can be
+///    memory-mapped and each amino acid's library deserialized on first use.
+/// Version 27: Rotameric tables stored as the arrays that hold them, aligned, so that they can be
+///    used in place in the memory-mapped file.
 Size
 RotamerLibrary::current_binary_format_version_id_02() const
 {
-	return 25;
+	return 27;
 }
 
 /// @details Version number for binary format.  See comments for 02 version.
@@ -903,10 +929,14 @@ RotamerLibrary::current_binary_format_version_id_02() const
 /// Version 6: Changed to templating on number of bbs, can't prove that this isn't needed 1/15/15 Andy Watkins
 /// Version 7: Fixed input bug that was definitely having real effects 1/22/15 Andy Watkins
 /// Version 8: Update to beta_nov16 corrected library 3/2017 fpd
+/// Version 9: Index of (aa, nbytes) pairs ahead of the per-aa data, so that the file can be
+///    memory-mapped and each amino acid's library deserialized on first use.
+/// Version 10: Rotameric tables stored as the arrays that hold them, aligned, so that they can be
+///    used in place in the memory-mapped file.
 Size
 RotamerLibrary::current_binary_format_version_id_10() const
 {
-	return 8;
+	return 10;
 }
 
 void RotamerLibrary::create_fa_dunbrack_libraries_from_ASCII() {
@@ -1008,24 +1038,13 @@ void RotamerLibrary::create_fa_dunbrack_libraries_02_from_binary() {
 
 	std::string binary_filename = get_binary_name_02();
 	TR << "Using Dunbrack library binary file '" << binary_filename << "'." << std::endl;
-	utility::io::izstream binlib(binary_filename.c_str(),
-		std::ios::in | std::ios::binary);
 
-	if ( !binlib ) {
-		utility_exit_with_message(
-			"Could not open binary Dunbrack02 file from database -- how did this happen?");
-	}
-
-	/// READ PREABMLE
+	/// PREABMLE
 	/// Even if binary file should change its structure in the future, version number should always be
-	/// the first piece of data in the file.
-	boost::int32_t version(0);
-	binlib.read((char*) &version, sizeof(boost::int32_t));
-	/// END PREABMLE
-
-	debug_assert( static_cast< Size > (version) == current_binary_format_version_id_02() );
+	/// the first piece of data in the file.  It has already been checked by binary_is_up_to_date_02().
+	Size const preamble_nbytes = sizeof(boost::int32_t);
 
-	read_from_binary( binlib );
+	map_binary_libraries( binary_filename, preamble_nbytes );
 
 	clock_t stoptime = clock();
 	TR << "Dunbrack library took "
@@ -1190,7 +1209,8 @@ void RotamerLibrary::create_fa_dunbrack_libraries_10_from_binary() {
 
 	/// READ PREABMLE
 	/// Even if binary file should change its structure in the future, version number should always be
-	/// the first piece of data in the file.
+	/// the first piece of data in the file.  Only the preamble is read through the stream; the
+	/// libraries that follow it are read out of the memory-mapped file.
 	boost::int32_t version(0);
 	binlib.read((char*) &version, sizeof(boost::int32_t));
 
@@ -1217,14 +1237,12 @@ void RotamerLibrary::create_fa_dunbrack_libraries_10_from_binary() {
 		+ n_semirot_arrays_read_of_Reals * n_semirotameric_aas
 		* sizeof(Real);
 
-	//binlib.seekg( bytes_to_skip, std::ios::cur ); //seekg not available for izstream...
+	binlib.close();
 
-	auto * temp_buffer = new char[bytes_to_skip];
-	binlib.read(temp_buffer, bytes_to_skip);
-	delete[] temp_buffer;
+	Size const preamble_nbytes = 3 * sizeof(boost::int32_t) + bytes_to_skip;
 	/// END PREABMLE
 
-	read_from_binary(binlib);
+	map_binary_libraries( binary_filename, preamble_nbytes );
 
 	clock_t stoptime = clock();
 	TR << "Dunbrack 2010 library took "
@@ -1265,7 +1283,7 @@ void RotamerLibrary::write_binary_fa_dunbrack_libraries_02() const {
 		binlib.write((char*) &version, sizeof(boost::int32_t));
 		/// END PREABMLE
 
-		write_to_binary(binlib);
+		write_to_binary( binlib, sizeof(boost::int32_t) );
 		binlib.close();
 
 		// Move the temporary file to its permanent location
@@ -1361,7 +1379,10 @@ void RotamerLibrary::write_binary_fa_dunbrack_libraries_10() const {
 
 		/// END PREABMLE
 
-		write_to_binary(binlib);
+		Size const preamble_nbytes = 3 * sizeof(boost::int32_t)
+			+ ( 2 * nrotameric + 5 * nsemirotameric ) * sizeof(boost::int32_t)
+			+ nsemirotameric * sizeof(Real);
+		write_to_binary( binlib, preamble_nbytes );
 		binlib.close();
 
 		// Move the temporary file to its permanent location
@@ -2135,24 +2156,18 @@ RotamerLibrary::initialize_dun02_aa_parameters(
 
 }
 
-/// @brief Generic "write out a library to binary" which has a straightforward
-/// nlibraries (aa, aa_data)* format.  Works for both 02 and 08 libraries.  The
-/// kind of aa_data written is left to the discression of the SinResDunLib
-/// derived classes.
-void RotamerLibrary::write_to_binary(utility::io::ozstream & out) const {
-
-	Size count_libraries( 0 );
-	for ( core::Size ii(1); ii <= aa_libraries_.size(); ++ii ) {
-		SingleResidueDunbrackLibraryCOP srdl =
-			utility::pointer::dynamic_pointer_cast< SingleResidueDunbrackLibrary const > ( aa_libraries_[ ii ] );
-
-		if ( srdl ) ++count_libraries; /// write out only the dunbrack libraries.
-	}
-
-	/// 1. How many libraries?
-	boost::int32_t const nlibraries = count_libraries;
-	out.write((char*) &nlibraries, sizeof(boost::int32_t));
-
+/// @brief Generic "write out a library to binary" which has an indexed
+/// nlibraries (aa, nbytes)* (aa_data)* format.  Works for both 02 and 08 libraries.
+/// The kind of aa_data written is left to the discression of the SinResDunLib
+/// derived classes; the index of byte counts lets the reader locate any one
+/// amino acid's data without deserializing the ones in front of it.  Each aa_data
+/// is padded to start at a multiple of BINARY_LIBRARY_ALIGNMENT bytes into the file
+/// (preamble_nbytes having been written ahead of this), so that the libraries can
+/// align their tables for use in place in the memory-mapped file.
+void RotamerLibrary::write_to_binary( utility::io::ozstream & out, Size const preamble_nbytes ) const {
+
+	utility::vector1< boost::int32_t > which_aas;
+	utility::vector1< std::string > aa_data;
 	for ( core::Size ii(1); ii <= aa_libraries_.size(); ++ii ) {
 		SingleResidueDunbrackLibraryCOP srdl =
 			utility::pointer::dynamic_pointer_cast< SingleResidueDunbrackLibrary const > ( aa_libraries_[ii] );
@@ -2161,49 +2176,122 @@ void RotamerLibrary::write_to_binary(utility::io::ozstream & out) const {
 			continue; /// write out only the dunbrack libraries.
 		}
 
-		/// 2. Amino acid type of next library
-		boost::int32_t const which_aa( srdl->aa() );
-		out.write( (char*) &which_aa, sizeof( boost::int32_t ) );
+		which_aas.push_back( srdl->aa() );
+		std::ostringstream srdl_out( std::ios::out | std::ios::binary );
+		srdl->write_to_binary( srdl_out );
+		aa_data.push_back( srdl_out.str() );
+	}
+
+	/// 1. How many libraries?
+	boost::int32_t const nlibraries = which_aas.size();
+	out.write((char*) &nlibraries, sizeof(boost::int32_t));
 
-		/// 3. Data for this amino acid type.
-		srdl->write_to_binary(out);
+	/// 2. Index: the amino acid type of each library and the number of bytes of its data
+	for ( core::Size ii(1); ii <= which_aas.size(); ++ii ) {
+		boost::int64_t const nbytes( aa_data[ ii ].size() );
+		out.write( (char*) &which_aas[ ii ], sizeof( boost::int32_t ) );
+		out.write( (char*) &nbytes, sizeof( boost::int64_t ) );
+	}
+
+	/// 3. Data for each amino acid type, in index order.
+	Size offset = preamble_nbytes + sizeof(boost::int32_t) + which_aas.size() * ( sizeof(boost::int32_t) + sizeof(boost::int64_t) );
+	for ( core::Size ii(1); ii <= aa_data.size(); ++ii ) {
+		std::string const padding( binary_library_padding( offset ), '\0' );
+		out.write( padding.c_str(), padding.size() );
+		out.write( aa_data[ ii ].c_str(), aa_data[ ii ].size() );
+		offset += padding.size() + aa_data[ ii ].size();
 	}
 
 }
 
 /// @details Generic binary file reader.  Intended to work for both 02 and 08 Libraries.
-/// If a "preamble" starts the binary format, the input stream to this function must have already
-/// been walked past it.  Somewhat circularly, the preamble is anything in the binary file that
-/// leads the "nlibraries (aa, aa_data)*" format perscribed in this function.
-void RotamerLibrary::read_from_binary(utility::io::izstream & in) {
-
-	using namespace boost;
+/// preamble_nbytes is the length of the "preamble" at the start of the binary file, i.e.
+/// everything that leads the "nlibraries (aa, nbytes)* (aa_data)*" format written by
+/// write_to_binary().  The file is memory-mapped and only the index is read here; each
+/// amino acid's library is read by load_library_from_binary() on first request, so
+/// a process only pays for the libraries it uses.  The rotameric tables, the bulk of
+/// each library, are then used in place in the mapping, and so are shared between all
+/// of the processes on a node; the rest of each library is copied into the process.
+void RotamerLibrary::map_binary_libraries( std::string const & binary_filename, Size const preamble_nbytes ) {
+
+	utility::io::MappedFileOP binlib( utility::pointer::make_shared< utility::io::MappedFile >( binary_filename ) );
+	if ( ! binlib->is_open() ) {
+		utility_exit_with_message( "Could not open binary Dunbrack library file '" + binary_filename + "' -- how did this happen?" );
+	}
 
-	DunbrackAAParameterSet dps( dun10_ ? DunbrackAAParameterSet::get_dun10_aa_parameters() : DunbrackAAParameterSet::get_dun02_aa_parameters() );
+	Size const index_entry_nbytes = sizeof(boost::int32_t) + sizeof(boost::int64_t);
+	if ( binlib->size() < preamble_nbytes + sizeof(boost::int32_t) ) {
+		utility_exit_with_message( "Binary Dunbrack library file '" + binary_filename + "' is truncated." );
+	}
 
-	// We need to cast the aa to an RT.
-	chemical::ResidueTypeSetCOP rts = chemical::ChemicalManager::get_instance()->residue_type_set( chemical::FA_STANDARD );
+	utility::io::MemoryStreamBuf buf( binlib->data() + preamble_nbytes, binlib->size() - preamble_nbytes );
+	std::istream in( &buf );
 
 	/// 1. How many libraries?
 	boost::int32_t nlibraries(0);
 	in.read((char*) &nlibraries, sizeof(boost::int32_t));
-	for ( Size ii = 1; ii <= Size(nlibraries); ++ii ) {
+	Size const data_start = preamble_nbytes + sizeof(boost::int32_t) + nlibraries * index_entry_nbytes;
+	if ( nlibraries < 0 || Size(nlibraries) > chemical::num_canonical_aas || data_start > binlib->size() ) {
+		utility_exit_with_message( "Binary Dunbrack library file '" + binary_filename + "' has a corrupt index." );
+	}
 
-		/// 2.  Which amino acid is next in the binary file?
+	/// 2. Index
+	Size offset = data_start;
+	for ( Size ii = 1; ii <= Size(nlibraries); ++ii ) {
 		boost::int32_t which_aa32(chemical::aa_unk);
+		boost::int64_t nbytes(0);
 		in.read((char*) &which_aa32, sizeof(boost::int32_t));
-		auto which_aa(static_cast<AA>(which_aa32));
+		in.read((char*) &nbytes, sizeof(boost::int64_t));
+		if ( which_aa32 < 1 || Size(which_aa32) > chemical::num_canonical_aas || nbytes <= 0 || offset + nbytes > binlib->size() ) {
+			utility_exit_with_message( "Binary Dunbrack library file '" + binary_filename + "' has a corrupt index." );
+		}
+		offset += binary_library_padding( offset );
+		if ( offset + nbytes > binlib->size() ) {
+			utility_exit_with_message( "Binary Dunbrack library file '" + binary_filename + "' has a corrupt index." );
+		}
+		binary_library_extents_[ which_aa32 ] = std::make_pair( offset, Size( nbytes ) );
+		offset += nbytes;
+	}
 
-		//TR << "amw reading binlib for " << which_aa << std::endl;
+	binary_libraries_ = binlib;
+}
+
+void RotamerLibrary::load_library_from_binary( AA const aa ) const {
+
+	debug_assert( binary_libraries_ );
+	Size const offset = binary_library_extents_[ aa ].first;
+	Size const nbytes = binary_library_extents_[ aa ].second;
+	if ( nbytes == 0 ) return;
+
+	DunbrackAAParameterSet dps( dun10_ ? DunbrackAAParameterSet::get_dun10_aa_parameters() : DunbrackAAParameterSet::get_dun02_aa_parameters() );
+
+	// We need to cast the aa to an RT.
+	chemical::ResidueTypeSetCOP rts = chemical::ChemicalManager::get_instance()->residue_type_set( chemical::FA_STANDARD );
+
+	//TR << "amw reading binlib for " << aa << std::endl;
+
+	/// 3. Read the data associated with that amino acid.
+	core::chemical::ResidueType const & rt( *( rts->get_representative_type_aa( aa ) ) );
+	SingleResidueDunbrackLibraryOP single_lib = create_srdl( rt, dps, rt.is_beta_aa() );
+	if ( !single_lib ) {
+		utility_exit_with_message( "Error reading single residue rotamer library for " + name_from_aa( aa ) );
+	}
+
+	single_lib->read_from_mapped_binary( binary_libraries_, offset, nbytes );
+	aa_libraries_[ aa ] = single_lib;
+}
+
+/// @details The number of bytes needed to bring data at this offset into the binary file to a
+/// multiple of BINARY_LIBRARY_ALIGNMENT.
+Size RotamerLibrary::binary_library_padding( Size const offset ) {
+	return ( BINARY_LIBRARY_ALIGNMENT - offset % BINARY_LIBRARY_ALIGNMENT ) % BINARY_LIBRARY_ALIGNMENT;
+}
 
-		/// 3. Read the data associated with that amino acid.
-		core::chemical::ResidueType const & rt( *( rts->get_representative_type_aa( which_aa ) ) );
-		SingleResidueDunbrackLibraryOP single_lib = create_srdl( rt, dps, rt.is_beta_aa() );
-		if ( !single_lib ) {
-			utility_exit_with_message( "Error reading single residue rotamer library for " + name_from_aa( which_aa ) );
+void RotamerLibrary::load_all_libraries_from_binary() {
+	for ( Size ii = 1; ii <= aa_libraries_.size(); ++ii ) {
+		if ( ! aa_libraries_[ ii ] ) {
+			load_library_from_binary( AA( ii ) );
 		}
-		single_lib->read_from_binary(in);
-		add_residue_library(which_aa, single_lib);
 	}
 }
 
@@ -2226,10 +2314,13 @@ RotamerLibrary::validate_dunbrack_binary() {
 
 	// We need to offload the existing rotamer libraries, and then reload them from ASCII
 	// Entries in libraries_ and aa_libraries_ will be over-written on reload
-	// Need to make a copy of aa_libraries, and then zero out the originals so they can be reloaded
+	// Need to make a copy of aa_libraries (after pulling in any not yet read from the binary),
+	// and then zero out the originals so they can be reloaded
+	load_all_libraries_from_binary();
 	utility::vector1 < SingleResidueRotamerLibraryCOP > aa_libraries_copy( aa_libraries_ );
 	for ( core::Size aa( 1 ); aa <= core::chemical::num_canonical_aas; ++aa ) {
 		aa_libraries_[ aa ] = nullptr;
+		binary_library_extents_[ aa ] = std::make_pair( Size( 0 ), Size( 0 ) );
 	}
 
 	TR << "Comparing ASCII version of Dunbrack library to binary version at " << binary_name << std::endl;
@@ -42,12 +42,18 @@
 #include <utility/SingletonBase.hh>
 #include <utility/io/ozstream.fwd.hh>
 #include <utility/io/izstream.fwd.hh>
+#include <utility/io/MappedFile.fwd.hh>
 #include <utility/options/OptionCollection.fwd.hh>
 
 // Numeric headers
 
 // C++ headers
 #include <map>
+#include <utility>
+
+#ifdef MULTI_THREADED
+#include <utility/thread/ReadWriteMutex.hh>
+#endif
 
 #include <utility/vector1.hh>
 
@@ -183,6 +189,11 @@ public:
 	// SingleResidueRotamerLibraryCOP
 	// get_rsd_library( chemical::ResidueType const & rsd_type ) const;
 
+	/// @brief The fullatom library for a canonical amino acid.
+	/// @details When the libraries were read from the binary file, each amino acid's
+	/// library is read out of the memory-mapped file the first time it is requested
+	/// here.  Its rotameric tables stay in the mapping, shared with the other processes
+	/// on the node that map the same file.  Threadsafe.
 	rotamers::SingleResidueRotamerLibraryCOP
 	get_library_by_aa( chemical::AA const & aa ) const;
 
@@ -351,14 +362,35 @@ public:
 	);
 
 private:
+	/// @brief Write the index and the per-amino-acid libraries, following a preamble of
+	/// preamble_nbytes already written to out.
 	void
-	write_to_binary( utility::io::ozstream & out ) const;
+	write_to_binary( utility::io::ozstream & out, Size const preamble_nbytes ) const;
+
+	/// @brief Padding needed to align a library's data at this offset into the binary file
+	static
+	Size
+	binary_library_padding( Size const offset );
 
-	/// @brief Initialize the RotamerLibrary from the stored binary
+	/// @brief The alignment of each amino acid's data within the binary file, in bytes
+	static Size const BINARY_LIBRARY_ALIGNMENT = 16;
+
+	/// @brief Initialize the RotamerLibrary from the stored binary: memory-map the file and
+	/// read the per-amino-acid index that follows its preamble (preamble_nbytes long).
+	/// The libraries themselves are deserialized on demand by get_library_by_aa().
 	/// @details Invoked through constructor.
 	/// Not threadsafe in itself. Do not call directly.
 	void
-	read_from_binary( utility::io::izstream & in );
+	map_binary_libraries( std::string const & binary_filename, Size const preamble_nbytes );
+
+	/// @brief Read the library for an amino acid out of the mapped binary file.
+	/// In multithreaded builds the caller must hold the write lock on aa_libraries_mutex_.
+	void
+	load_library_from_binary( AA const aa ) const;
+
+	/// @brief Deserialize every library that has not yet been requested from the mapped binary file.
+	void
+	load_all_libraries_from_binary();
 
 
 	RotamerLibrary();
@@ -395,10 +427,22 @@ private:
 	/////////////////////////////
 	// Data members
 
-	// NOTE: If you make the data in this singleton mutable,
-	// you will need to add a ReadWriteMutex to make it threadsafe.
+	// NOTE: aa_libraries_ is filled lazily from binary_libraries_ (see get_library_by_aa()),
+	// so it is mutable and guarded by aa_libraries_mutex_.
+
+	mutable utility::vector1< rotamers::SingleResidueRotamerLibraryCOP > aa_libraries_;
 
-	utility::vector1< rotamers::SingleResidueRotamerLibraryCOP > aa_libraries_;
+	/// @brief The memory-mapped binary file from which the libraries not yet in aa_libraries_ are read.
+	utility::io::MappedFileCOP binary_libraries_;
+
+	/// @brief The byte offset and length of each amino acid's library within binary_libraries_;
+	/// a length of zero means the binary file holds no library for that amino acid.
+	utility::vector1< std::pair< Size, Size > > binary_library_extents_;
+
+#ifdef MULTI_THREADED
+	/// @brief Guards aa_libraries_ while libraries are being loaded from binary_libraries_.
+	mutable utility::thread::ReadWriteMutex aa_libraries_mutex_;
+#endif
 	typedef utility::vector1< rotamers::SingleResidueRotamerLibraryCOP > library_iterator;
 
 };
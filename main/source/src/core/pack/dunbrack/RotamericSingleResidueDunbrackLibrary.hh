@@ -31,6 +31,7 @@
 // ObjexxFCL Headers
 #include <ObjexxFCL/FArray1D.hh>
 #include <ObjexxFCL/FArray2D.hh>
+#include <ObjexxFCL/FArray2P.hh>
 //#include <ObjexxFCL/FArray3D.hh>
 
 #include <utility/vector1.hh>
@@ -186,8 +187,8 @@ public:
 	void
 	write_to_file( utility::io::ozstream &out ) const override;
 
-	virtual void write_to_binary( utility::io::ozstream & out ) const override;
-	virtual void read_from_binary( utility::io::izstream & in ) override;
+	virtual void write_to_binary( std::ostream & out ) const override;
+	virtual void read_from_binary( std::istream & in ) override;
 
 	/// @brief Comparison operator, mainly intended to use in ASCII/binary comparsion tests
 	/// Values tested should parallel those used in the read_from_binary() function.
@@ -278,9 +279,10 @@ public:
 protected:
 	/// Read and write access for derived classes and parser class
 
-	typename ObjexxFCL::FArray2D< PackedDunbrackRotamer< T, N > > const &
+	/// @details Read from the memory-mapped binary file in place, if the library was read from one
+	typename ObjexxFCL::FArray2< PackedDunbrackRotamer< T, N > > const &
 	rotamers() const {
-		return rotamers_;
+		return rotamer_table();
 	}
 
 	typename ObjexxFCL::FArray2D< PackedDunbrackRotamer< T, N > > &
@@ -288,9 +290,10 @@ protected:
 		return rotamers_;
 	}
 
-	ObjexxFCL::FArray2D< Size > const &
+	/// @details Read from the memory-mapped binary file in place, if the library was read from one
+	ObjexxFCL::FArray2< Size > const &
 	packed_rotno_2_sorted_rotno() const {
-		return packed_rotno_2_sorted_rotno_;
+		return sorted_rotno_table();
 	}
 
 	ObjexxFCL::FArray2D< Size > &
@@ -537,6 +540,28 @@ protected:
 	void setup_entropy_correction();
 	void setup_entropy_correction() const;
 
+private:
+
+	/// @brief Padding needed in the binary format to align a table at this stream position
+	static Size table_padding( std::streamoff const position );
+
+	/// @brief The alignment of the tables within the binary format, in bytes
+	static Size const TABLE_ALIGNMENT = 16;
+
+	/// @brief rotamers_, or the same table in the memory-mapped binary file it was read from
+	typename ObjexxFCL::FArray2< PackedDunbrackRotamer< T, N > > const &
+	rotamer_table() const {
+		if ( mapped_tables_ ) return mapped_rotamers_;
+		return rotamers_;
+	}
+
+	/// @brief packed_rotno_2_sorted_rotno_, or the same table in the memory-mapped binary file
+	ObjexxFCL::FArray2< Size > const &
+	sorted_rotno_table() const {
+		if ( mapped_tables_ ) return mapped_packed_rotno_2_sorted_rotno_;
+		return packed_rotno_2_sorted_rotno_;
+	}
+
 private:
 
 	/// The (chi_mean, chi_sd, packed_rotno, and prob) data for the chi dihedrals
@@ -550,6 +575,13 @@ private:
 	/// given a phi/psi.  Indexed by (bb_bin_index, packed_rotno ).
 	ObjexxFCL::FArray2D< Size > packed_rotno_2_sorted_rotno_;
 
+	/// When read from a memory-mapped binary file, the two tables above are left empty and these
+	/// proxies view them in the mapping instead; the pages are then shared by every process on
+	/// the node that maps the same file.
+	typename ObjexxFCL::FArray2P< PackedDunbrackRotamer< T, N > > mapped_rotamers_;
+	ObjexxFCL::FArray2P< Size > mapped_packed_rotno_2_sorted_rotno_;
+	utility::io::MappedFileCOP mapped_tables_;
+
 	// Entropy correction
 	utility::fixedsizearray1< ObjexxFCL::FArray1D< Real >, ( 1 << N ) > ShannonEntropy_n_derivs_;
 
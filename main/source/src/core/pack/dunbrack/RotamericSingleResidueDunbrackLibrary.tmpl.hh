@@ -97,6 +97,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <list>
 #include <string>
@@ -791,13 +792,13 @@ RotamericSingleResidueDunbrackLibrary< T, N >::assign_random_rotamer(
 	Size count = 0;
 	while ( random_prob > 0 ) {
 		Size index = make_index< N >( N_BB_BINS, bb_bin );
-		packed_rotno = rotamers_( index, ++count ).packed_rotno();
+		packed_rotno = rotamer_table()( index, ++count ).packed_rotno();
 		interpolate_rotamers( scratch, packed_rotno, bb_bin, bb_bin_next, bb_alpha, interpolated_rotamer );
 		random_prob -= interpolated_rotamer.rotamer_probability();
 		//loop condition might end up satisfied even if we've walked through all possible rotamers
 		// if the chosen random number was nearly 1
 		// (and interpolation introduced a tiny bit of numerical noise).
-		if ( count == rotamers_.size2() ) break;
+		if ( count == rotamer_table().size2() ) break;
 	}
 	assign_chi_for_interpolated_rotamer( interpolated_rotamer, rsd, RG, new_chi_angles, perturb_from_rotamer_center );
 
@@ -872,7 +873,7 @@ RotamericSingleResidueDunbrackLibrary< T, N >::find_another_representative_for_u
 	get_bb_bins( bbs, bb_bin, bb_bin_next, bb_alpha );
 
 	Size index = make_index< N >( N_BB_BINS, bb_bin );
-	Size packed_rotno = rotamers_( index, 1 ).packed_rotno();
+	Size packed_rotno = rotamer_table()( index, 1 ).packed_rotno();
 	packed_rotno_2_rotwell( packed_rotno, rotwell );
 	return packed_rotno;
 }
@@ -962,7 +963,7 @@ RotamericSingleResidueDunbrackLibrary< T, N >::best_rotamer_energy(
 		utility::fixedsizearray1< Size, (1 << N ) > packed_rotnos;
 		for ( Size indi = 1; indi <= num_packed_rots; ++indi ) {
 			Size index = make_conditional_index< N >( N_BB_BINS, indi, bb_bin_next, bb_bin );
-			packed_rotnos[ indi ] = rotamers_( index, 1 ).packed_rotno();
+			packed_rotnos[ indi ] = rotamer_table()( index, 1 ).packed_rotno();
 		}
 
 		// Interpolate each packed rotamer.
@@ -1123,13 +1124,13 @@ RotamericSingleResidueDunbrackLibrary< T, N >::interpolate_rotamers(
 	for ( Size sri = 1; sri <= ( 1 << N ); ++sri ) {
 		Size const index( make_conditional_index< N >( N_BB_BINS, sri, bb_bin_next, bb_bin ) );
 		Size const packed_rotno_next( ( canonical_aa_ && canonicals_use_voronoi_ ) || ( !canonical_aa_ && noncanonicals_use_voronoi_ ) ? make_conditional_packed_rotno_index( this_bb_index, index, packed_rotno, chi, use_chi ) : packed_rotno );
-		sorted_rotno[ sri ] = packed_rotno_2_sorted_rotno_( index, packed_rotno_next );
-		rot.push_back( rotamers_( index, sorted_rotno[ sri ] ) );
-		for ( Size i = 1; i <= T; ++i ) rot[ sri ].chi_mean( i ) = rotamers_( index, sorted_rotno[ sri ] ).chi_mean( i );
-		for ( Size i = 1; i <= T; ++i ) rot[ sri ].chi_sd(   i ) = rotamers_( index, sorted_rotno[ sri ] ).chi_sd(   i );
-		rot[ sri ].rotamer_probability() = rotamers_( index, sorted_rotno[ sri ] ).rotamer_probability();
+		sorted_rotno[ sri ] = sorted_rotno_table()( index, packed_rotno_next );
+		rot.push_back( rotamer_table()( index, sorted_rotno[ sri ] ) );
+		for ( Size i = 1; i <= T; ++i ) rot[ sri ].chi_mean( i ) = rotamer_table()( index, sorted_rotno[ sri ] ).chi_mean( i );
+		for ( Size i = 1; i <= T; ++i ) rot[ sri ].chi_sd(   i ) = rotamer_table()( index, sorted_rotno[ sri ] ).chi_sd(   i );
+		rot[ sri ].rotamer_probability() = rotamer_table()( index, sorted_rotno[ sri ] ).rotamer_probability();
 		for ( Size di = 1; di <= ( 1 << N ); ++di ) {
-			n_derivs[ di ][ sri ] = static_cast< Real >( rotamers_( index, sorted_rotno[ sri ] ).n_derivs()[ di ] );
+			n_derivs[ di ][ sri ] = static_cast< Real >( rotamer_table()( index, sorted_rotno[ sri ] ).n_derivs()[ di ] );
 		}
 		rotprob[ sri ] = static_cast< Real >( rot[ sri ].rotamer_probability() );
 		if ( rotprob[ sri ] <= 1e-6 ) rotprob[ sri ] = 1e-6;
@@ -1231,13 +1232,13 @@ RotamericSingleResidueDunbrackLibrary< T, N >::make_conditional_packed_rotno_ind
 ) const {
 	if ( original_bb_index == bb_index ) return packed_rotno;
 
-	PackedDunbrackRotamer< T, N > const &cur_rot( rotamers_( original_bb_index, packed_rotno_2_sorted_rotno_( original_bb_index, packed_rotno ) ) );
+	PackedDunbrackRotamer< T, N > const &cur_rot( rotamer_table()( original_bb_index, sorted_rotno_table()( original_bb_index, packed_rotno ) ) );
 
 	core::Real min_distsq(0);
 	bool first(true);
 	core::Size lowest_rotindex(0);
-	for ( core::Size i(1), imax(rotamers_.size2()); i<=imax; ++i ) {
-		PackedDunbrackRotamer< T, N > const &comparison_rot( rotamers_( bb_index, packed_rotno_2_sorted_rotno_( bb_index, i ) ) );
+	for ( core::Size i(1), imax(rotamer_table().size2()); i<=imax; ++i ) {
+		PackedDunbrackRotamer< T, N > const &comparison_rot( rotamer_table()( bb_index, sorted_rotno_table()( bb_index, i ) ) );
 		core::Real distsq(0);
 		for ( core::Size j(1); j <= T; ++j ) {
 			if ( !use_chi ) {
@@ -1351,7 +1352,7 @@ RotamericSingleResidueDunbrackLibrary< T, N >::fill_rotamer_vector(
 		++count_rotamers_built;
 
 		Size index = make_index< N >( N_BB_BINS, bb_bin );
-		Size const packed_rotno00 = rotamers_( index, count_rotamers_built ).packed_rotno();
+		Size const packed_rotno00 = rotamer_table()( index, count_rotamers_built ).packed_rotno();
 		PackedDunbrackRotamer< T, N, Real > interpolated_rotamer;
 		interpolate_rotamers( scratch, packed_rotno00, bb_bin, bb_bin_next, bb_alpha, interpolated_rotamer );
 
@@ -1386,7 +1387,7 @@ RotamericSingleResidueDunbrackLibrary< T, N >::get_all_rotamer_samples(
 	for ( Size ii = 1; ii <= n_rots; ++ii ) {
 		// Iterate through rotamaers in decreasing order of probabilities
 		Size index = make_index< N > ( N_BB_BINS, bb_bin );
-		Size const packed_rotno00 = rotamers_( index, ii ).packed_rotno();
+		Size const packed_rotno00 = rotamer_table()( index, ii ).packed_rotno();
 		PackedDunbrackRotamer< T, N, Real > interpolated_rotamer;
 		interpolate_rotamers( scratch, packed_rotno00, bb_bin, bb_bin_next, bb_alpha, interpolated_rotamer );
 
@@ -1420,16 +1421,16 @@ RotamericSingleResidueDunbrackLibrary< T, N >::get_probability_for_rotamer(
 
 	Size ind00 = make_index< N >( N_BB_BINS, bb_bin );
 	utility::fixedsizearray1< Real, n_rot > interp_probs;
-	rot.push_back( rotamers_( ind00, rot_ind ) );
-	rot[ 1 ].rotamer_probability() = rotamers_( ind00, rot_ind ).rotamer_probability();
+	rot.push_back( rotamer_table()( ind00, rot_ind ) );
+	rot[ 1 ].rotamer_probability() = rotamer_table()( ind00, rot_ind ).rotamer_probability();
 	interp_probs[ 1 ] = static_cast< Real >( rot[ 1 ].rotamer_probability() );
 	Size const packed_rotno00 = rot[ 1 ].packed_rotno();
 
 	for ( Size indi = 2; indi <= n_rot; ++indi ) {
 		Size index = make_conditional_index< N >( N_BB_BINS, indi, bb_bin_next, bb_bin );
-		sorted_rotno[ indi ] = packed_rotno_2_sorted_rotno_( index, packed_rotno00 );
-		rot.push_back( rotamers_( index, sorted_rotno[ indi ] ) );
-		rot[ indi ].rotamer_probability() = rotamers_( index, sorted_rotno[ indi ] ).rotamer_probability();
+		sorted_rotno[ indi ] = sorted_rotno_table()( index, packed_rotno00 );
+		rot.push_back( rotamer_table()( index, sorted_rotno[ indi ] ) );
+		rot[ indi ].rotamer_probability() = rotamer_table()( index, sorted_rotno[ indi ] ).rotamer_probability();
 		interp_probs[ indi ] = static_cast< Real >( rot[ indi ].rotamer_probability() );
 	}
 
@@ -1470,7 +1471,7 @@ RotamericSingleResidueDunbrackLibrary< T, N >::get_rotamer(
 	get_bb_bins( bbs, bb_bin, bb_bin_next, bb_alpha );
 
 	Size index = make_index< N >( N_BB_BINS, bb_bin );
-	PackedDunbrackRotamer< T, N > const & rot00( rotamers_( index, rot_ind ) );
+	PackedDunbrackRotamer< T, N > const & rot00( rotamer_table()( index, rot_ind ) );
 	Size const packed_rotno00 = rot00.packed_rotno();
 	PackedDunbrackRotamer< T, N, Real > interpolated_rotamer;
 	interpolate_rotamers( scratch, packed_rotno00, bb_bin, bb_bin_next, bb_alpha, interpolated_rotamer );
@@ -1858,214 +1859,78 @@ RotamericSingleResidueDunbrackLibrary< T, N >::write_to_file( utility::io::ozstr
 	utility_exit_with_message("Unimplemented!");
 }
 
+/// @details The two tables are written as the bytes of the arrays that hold them, preceded by the
+/// sizes of their elements and padded to start at a multiple of TABLE_ALIGNMENT bytes from the start
+/// of the library's data, so that read_from_binary() can use them in place in a memory-mapped file.
+/// Like the floating point values it always held, the file is specific to the platform it was
+/// written on.
 template < Size T, Size N >
 void
-RotamericSingleResidueDunbrackLibrary< T, N >::write_to_binary( utility::io::ozstream & out ) const
+RotamericSingleResidueDunbrackLibrary< T, N >::write_to_binary( std::ostream & out ) const
 {
-	using namespace boost;
-
 	parent::write_to_binary( out );
 
-	/// 1. rotamers_
-	{
-		Size const ntotalrot = product( N_BB_BINS ) * parent::n_packed_rots();
-		Size const ntotalchi = ntotalrot * T;
-		///a. means
-		DunbrackReal * rotamer_means = new DunbrackReal[ ntotalchi ];
-		// b. standard deviations
-		DunbrackReal * rotamer_stdvs = new DunbrackReal[ ntotalchi ];
-		// c. rotamer probabilities
-		DunbrackReal * rotamer_probs = new DunbrackReal[ ntotalrot ];
-		// d. bicubic polynomial parameters
-		utility::vector1< DunbrackReal * > rotamer_negln_n_derivs( 1 << N );
-		for ( Size initi = 1; initi <= ( 1 << N ); ++initi ) {
-			rotamer_negln_n_derivs[ initi ] = new DunbrackReal[ ntotalrot ];
-		}
-
-		// e. packed rotamer numbers
-		DunbrackReal * packed_rotnos = new DunbrackReal[ ntotalrot ];
-
-		Size count_chi( 0 ), count_rots( 0 );
-		for ( Size ii = 1; ii <= parent::n_packed_rots(); ++ii ) {
-			utility::fixedsizearray1< Size, (N+1) > bb_bin( 1 );
-			utility::fixedsizearray1< Size, (N+1) > bb_bin_maxes( 1 );
-			for ( Size i = 1; i <= N; ++i ) bb_bin_maxes = N_BB_BINS[i];
-			Size p = 1;
-			while ( bb_bin[ N + 1 ] == 1 ) {
-
-				Size bb_rot_index = make_index< N >( N_BB_BINS, bb_bin );
-
-				for ( Size ll = 1; ll <= T; ++ll ) {
-					rotamer_means[ count_chi ] = rotamers_( bb_rot_index, ii ).chi_mean( ll );
-					rotamer_stdvs[ count_chi ] = rotamers_( bb_rot_index, ii ).chi_sd( ll );
-					++count_chi;
-				}
-				rotamer_probs[ count_rots ] = rotamers_( bb_rot_index, ii ).rotamer_probability();
-				for ( Size deriv_i = 1; deriv_i <= ( 1 << N ); ++deriv_i ) {
-					rotamer_negln_n_derivs[ deriv_i ][ count_rots ] = rotamers_( bb_rot_index, ii ).n_derivs()[ deriv_i ];
-				}
+	Size const ntotalrot = product( N_BB_BINS ) * parent::n_packed_rots();
+	boost::int32_t const rotamer_nbytes( sizeof( PackedDunbrackRotamer< T, N > ) );
+	boost::int32_t const sorted_rotno_nbytes( sizeof( Size ) );
+	out.write( (char*) &rotamer_nbytes, sizeof( boost::int32_t ) );
+	out.write( (char*) &sorted_rotno_nbytes, sizeof( boost::int32_t ) );
 
-				packed_rotnos[ count_rots ] = rotamers_( bb_rot_index, ii ).packed_rotno();
-				++count_rots;
-
-				bb_bin[ 1 ]++;
-				while ( bb_bin[ p ] == bb_bin_maxes[p]+1 ) {
-					bb_bin[ p ] = 1;
-					if ( p < bb_bin.size() ) {
-						bb_bin[ ++p ]++;
-						if ( bb_bin[ p ] != bb_bin_maxes[p]+1 ) p = 1;
-					} else {
-						break;
-					}
-				}
-			}
-		}
-		out.write( (char*) rotamer_means, ntotalchi * sizeof( DunbrackReal ));
-		out.write( (char*) rotamer_stdvs, ntotalchi * sizeof( DunbrackReal ));
-		out.write( (char*) rotamer_probs, ntotalrot * sizeof( DunbrackReal ));
-		for ( Size writei = 1; writei <= ( 1 << N ); ++writei ) {
-			out.write( (char*) rotamer_negln_n_derivs[ writei ], ntotalrot * sizeof( DunbrackReal ));
-		}
+	std::string const padding( table_padding( out.tellp() ), '\0' );
+	out.write( padding.c_str(), padding.size() );
 
-		out.write( (char*) packed_rotnos, ntotalrot * sizeof( DunbrackReal ));
-		delete [] rotamer_means;
-		delete [] rotamer_stdvs;
-		delete [] rotamer_probs;
-		for ( Size writei = 1; writei <= ( 1 << N ); ++writei ) {
-			delete[] rotamer_negln_n_derivs[ writei ];
-		}
-		delete [] packed_rotnos;
-	}
+	/// 1. rotamers_
+	debug_assert( Size( rotamer_table().size() ) == ntotalrot );
+	out.write( (char const *) &rotamer_table()[ 0 ], ntotalrot * sizeof( PackedDunbrackRotamer< T, N > ) );
 
 	/// 2. packed_rotno_to_sorted_rotno_
-	{
-		Size const ntotalpackedrots = product( N_BB_BINS ) * parent::n_packed_rots();
-		boost::int32_t * packed_rotno_2_sorted_rotno = new boost::int32_t[ ntotalpackedrots ];
-		Size count( 0 );
-		for ( Size ii = 1; ii <= parent::n_packed_rots(); ++ii ) {
-			utility::fixedsizearray1< Size, (N+1) > bb_bin( 1 );
-			utility::fixedsizearray1< Size, (N+1) > bb_bin_maxes( 1 );
-			for ( Size i = 1; i <= N; ++i ) bb_bin_maxes = N_BB_BINS[i];
-			Size p = 1;
-			while ( bb_bin[ N + 1 ] == 1 ) {
-
-				packed_rotno_2_sorted_rotno[ count ] = packed_rotno_2_sorted_rotno_( make_index< N >( N_BB_BINS, bb_bin ), ii );
-				++count;
-
-				bb_bin[ 1 ]++;
-				while ( bb_bin[ p ] == bb_bin_maxes[p]+1 ) {
-					bb_bin[ p ] = 1;
-					bb_bin[ ++p ]++;
-					if ( bb_bin[ p ] != bb_bin_maxes[p]+1 ) p = 1;
-				}
-			}
-		}
-		out.write( (char*) packed_rotno_2_sorted_rotno, ntotalpackedrots * sizeof( boost::int32_t ) );
-		delete [] packed_rotno_2_sorted_rotno;
-	}
+	debug_assert( Size( sorted_rotno_table().size() ) == ntotalrot );
+	out.write( (char const *) &sorted_rotno_table()[ 0 ], ntotalrot * sizeof( Size ) );
 }
 
+/// @details When reading through SingleResidueDunbrackLibrary::read_from_mapped_binary(), the
+/// tables are not copied: mapped_rotamers_ and mapped_packed_rotno_2_sorted_rotno_ view them in
+/// the mapping.  Otherwise (or if the mapping is not suitably aligned) they are read into
+/// rotamers_ and packed_rotno_2_sorted_rotno_.
 template < Size T, Size N >
 void
-RotamericSingleResidueDunbrackLibrary< T, N >::read_from_binary( utility::io::izstream & in )
+RotamericSingleResidueDunbrackLibrary< T, N >::read_from_binary( std::istream & in )
 {
 	parent::read_from_binary( in );
-	Size n_rot_bins = product( N_BB_BINS );
-	/// 1. rotamers_
-	{
-		Size const ntotalrot = n_rot_bins * parent::n_packed_rots();
-		Size const ntotalchi = ntotalrot * T;
-		rotamers_.dimension( n_rot_bins, parent::n_packed_rots(), PackedDunbrackRotamer< T, N >() );
-
-		///a. means
-		DunbrackReal * rotamer_means = new DunbrackReal[ ntotalchi ];
-		// b. standard deviations
-		DunbrackReal * rotamer_stdvs = new DunbrackReal[ ntotalchi ];
-		// c. rotamer probabilities
-		DunbrackReal * rotamer_probs = new DunbrackReal[ ntotalrot ];
-		// d. bicubic polynomial parameters
-		utility::vector1< DunbrackReal * > rotamer_negln_n_derivs( 1 << N );
-
-		in.read( (char*) rotamer_means, ntotalchi * sizeof( DunbrackReal ));
-		in.read( (char*) rotamer_stdvs, ntotalchi * sizeof( DunbrackReal ));
-		in.read( (char*) rotamer_probs, ntotalrot * sizeof( DunbrackReal ));
-		for ( Size initi = 1; initi <= ( 1 << N ); ++initi ) {
-			rotamer_negln_n_derivs[ initi ] = new DunbrackReal[ ntotalrot ];
-			in.read( (char*) rotamer_negln_n_derivs[ initi ], ntotalrot * sizeof( DunbrackReal ));
-		}
-		// e. packed rotamer numbers
-		DunbrackReal * packed_rotnos = new DunbrackReal[ ntotalrot ];
-
-		in.read( (char*) packed_rotnos, ntotalrot * sizeof( DunbrackReal ));
-
-		Size count_chi( 0 ), count_rots( 0 );
-		for ( Size ii = 1; ii <= parent::n_packed_rots(); ++ii ) {
-
-			utility::fixedsizearray1< Size, (N+1) > bb_bin( 1 );
-			utility::fixedsizearray1< Size, (N+1) > bb_bin_maxes( 1 );
-			for ( Size i = 1; i <= N; ++i ) bb_bin_maxes = N_BB_BINS[i];
-			Size p = 1;
-			while ( bb_bin[ N + 1 ] == 1 ) {
-
-				Size bb_rot_index = make_index< N >( N_BB_BINS, bb_bin );
-				for ( Size ll = 1; ll <= T; ++ll ) {
-					rotamers_( bb_rot_index, ii ).chi_mean( ll ) = rotamer_means[ count_chi ];
-					rotamers_( bb_rot_index, ii ).chi_sd(  ll ) = rotamer_stdvs[ count_chi ];
-					++count_chi;
-				}
-				rotamers_( bb_rot_index, ii ).rotamer_probability() = rotamer_probs[ count_rots ];
-				for ( Size deriv_i = 1; deriv_i <= ( 1 << N ); ++deriv_i ) {
-					rotamers_( bb_rot_index, ii ).n_derivs()[ deriv_i ] = rotamer_negln_n_derivs[ deriv_i ][ count_rots ];
-				}
-				rotamers_( bb_rot_index, ii ).packed_rotno( ( Size ) packed_rotnos[ count_rots ] );
-
-				++count_rots;
-
-				bb_bin[ 1 ]++;
-				while ( bb_bin[ p ] == bb_bin_maxes[p]+1 ) {
-					bb_bin[ p ] = 1;
-					bb_bin[ ++p ]++;
-					if ( bb_bin[ p ] != bb_bin_maxes[p]+1 ) p = 1;
-				}
-			}
-		}
-
-		delete [] rotamer_means;
-		delete [] rotamer_stdvs;
-		delete [] rotamer_probs;
-		for ( Size deli = 1; deli <= ( 1 << N ); ++deli ) {
-			delete [] rotamer_negln_n_derivs[ deli ];
-		}
-		delete [] packed_rotnos;
+	Size const n_rot_bins = product( N_BB_BINS );
+	Size const ntotalrot = n_rot_bins * parent::n_packed_rots();
+
+	boost::int32_t rotamer_nbytes( 0 ), sorted_rotno_nbytes( 0 );
+	in.read( (char*) &rotamer_nbytes, sizeof( boost::int32_t ) );
+	in.read( (char*) &sorted_rotno_nbytes, sizeof( boost::int32_t ) );
+	if ( ! in ) return;
+	if ( Size( rotamer_nbytes ) != sizeof( PackedDunbrackRotamer< T, N > ) || Size( sorted_rotno_nbytes ) != sizeof( Size ) ) {
+		utility_exit_with_message( "The binary Dunbrack library for " + core::chemical::name_from_aa( aa() )
+			+ " was written on a platform with a different data layout; remove the binary file to have it regenerated." );
 	}
+	in.seekg( table_padding( in.tellg() ), std::ios::cur );
+
+	char const * mapped( parent::mapped_binary_at( in ) );
+	if ( mapped && reinterpret_cast< std::uintptr_t >( mapped ) % alignof( PackedDunbrackRotamer< T, N > ) == 0 ) {
+		// Check that the whole of both tables lies within the library's data before pointing at them.
+		in.seekg( ntotalrot * ( sizeof( PackedDunbrackRotamer< T, N > ) + sizeof( Size ) ), std::ios::cur );
+		if ( ! in ) return;
+		rotamers_.clear();
+		packed_rotno_2_sorted_rotno_.clear();
+		mapped_rotamers_.attach( *reinterpret_cast< PackedDunbrackRotamer< T, N > const * >( mapped ) );
+		mapped_rotamers_.dimension( n_rot_bins, parent::n_packed_rots() );
+		mapped_packed_rotno_2_sorted_rotno_.attach( *reinterpret_cast< Size const * >( mapped + ntotalrot * sizeof( PackedDunbrackRotamer< T, N > ) ) );
+		mapped_packed_rotno_2_sorted_rotno_.dimension( n_rot_bins, parent::n_packed_rots() );
+		mapped_tables_ = parent::mapped_binary();
+	} else {
+		/// 1. rotamers_
+		rotamers_.dimension( n_rot_bins, parent::n_packed_rots(), PackedDunbrackRotamer< T, N >() );
+		in.read( (char*) &rotamers_[ 0 ], ntotalrot * sizeof( PackedDunbrackRotamer< T, N > ) );
 
-	/// 2. packed_rotno_to_sorted_rotno_
-	{
-		Size const ntotalpackedrots = n_rot_bins * parent::n_packed_rots();
-		boost::int32_t * packed_rotno_2_sorted_rotno = new boost::int32_t[ ntotalpackedrots ];
-		in.read( (char*) packed_rotno_2_sorted_rotno, ntotalpackedrots * sizeof( boost::int32_t ) );
-		Size count( 0 );
+		/// 2. packed_rotno_to_sorted_rotno_
 		packed_rotno_2_sorted_rotno_.dimension( n_rot_bins, parent::n_packed_rots() );
-		for ( Size ii = 1; ii <= parent::n_packed_rots(); ++ii ) {
-
-			utility::fixedsizearray1< Size, (N+1) > bb_bin( 1 );
-			utility::fixedsizearray1< Size, (N+1) > bb_bin_maxes( 1 );
-			for ( Size i = 1; i <= N; ++i ) bb_bin_maxes = N_BB_BINS[i];
-			Size p = 1;
-			while ( bb_bin[ N + 1 ] == 1 ) {
-
-				packed_rotno_2_sorted_rotno_( make_index< N >( N_BB_BINS, bb_bin ), ii ) = packed_rotno_2_sorted_rotno[ count ];
-				++count;
-
-				bb_bin[ 1 ]++;
-				while ( bb_bin[ p ] == bb_bin_maxes[p]+1 ) {
-					bb_bin[ p ] = 1;
-					bb_bin[ ++p ]++;
-					if ( bb_bin[ p ] != bb_bin_maxes[p]+1 ) p = 1;
-				}
-			}
-		}
-		delete [] packed_rotno_2_sorted_rotno;
+		in.read( (char*) &packed_rotno_2_sorted_rotno_[ 0 ], ntotalrot * sizeof( Size ) );
+		mapped_tables_ = nullptr;
 	}
 
 	/// Entropy setup once reading is finished
@@ -2074,6 +1939,15 @@ RotamericSingleResidueDunbrackLibrary< T, N >::read_from_binary( utility::io::iz
 	}
 }
 
+/// @details The number of bytes needed to bring a table at this position in the stream to a
+/// multiple of TABLE_ALIGNMENT.
+template < Size T, Size N >
+Size
+RotamericSingleResidueDunbrackLibrary< T, N >::table_padding( std::streamoff const position )
+{
+	return ( TABLE_ALIGNMENT - Size( position ) % TABLE_ALIGNMENT ) % TABLE_ALIGNMENT;
+}
+
 /// @brief Comparison operator, mainly intended to use in ASCII/binary comparsion tests
 /// Values tested should parallel those used in the read_from_binary() function.
 template < Size T, Size N >
@@ -2111,8 +1985,8 @@ RotamericSingleResidueDunbrackLibrary< T, N >::operator ==( SingleResidueRotamer
 		while ( bb_bin[ N + 1 ] == 1 ) {
 			Size bb_rot_index = make_index< N >( N_BB_BINS, bb_bin );
 
-			PackedDunbrackRotamer< T, N > const & this_rot( rotamers_( bb_rot_index, ii ) );
-			PackedDunbrackRotamer< T, N > const & other_rot( other.rotamers_( bb_rot_index, ii ) );
+			PackedDunbrackRotamer< T, N > const & this_rot( rotamer_table()( bb_rot_index, ii ) );
+			PackedDunbrackRotamer< T, N > const & other_rot( other.rotamer_table()( bb_rot_index, ii ) );
 			for ( Size ll = 1; ll <= T; ++ll ) {
 				if ( ! numeric::equal_by_epsilon( this_rot.chi_mean( ll ), other_rot.chi_mean( ll ), ANGLE_DELTA ) ) {
 					TR.Debug << "Comparsion failure in " << core::chemical::name_from_aa( aa() )
@@ -2165,10 +2039,10 @@ RotamericSingleResidueDunbrackLibrary< T, N >::operator ==( SingleResidueRotamer
 		Size p = 1;
 		while ( bb_bin[ N + 1 ] == 1 ) {
 			Size bb_rot_index = make_index< N >( N_BB_BINS, bb_bin );
-			if ( packed_rotno_2_sorted_rotno_( bb_rot_index, ii ) != packed_rotno_2_sorted_rotno_( bb_rot_index, ii ) ) {
+			if ( sorted_rotno_table()( bb_rot_index, ii ) != other.sorted_rotno_table()( bb_rot_index, ii ) ) {
 				TR.Debug << "Comparsion failure in " << core::chemical::name_from_aa( aa() )
 					<< " packed_rotno_2_sorted_rotno " << bb_bin[1] << " " << bb_bin[2] << " " << ii << " - "
-					<< packed_rotno_2_sorted_rotno_( bb_rot_index, ii ) << " vs. " << other.packed_rotno_2_sorted_rotno_( bb_rot_index, ii ) << std::endl;
+					<< sorted_rotno_table()( bb_rot_index, ii ) << " vs. " << other.sorted_rotno_table()( bb_rot_index, ii ) << std::endl;
 				equal = false;
 			}
 
@@ -2215,13 +2089,13 @@ RotamericSingleResidueDunbrackLibrary< T, N >::setup_entropy_correction()
 		// especially for semi-rotameric amino acids
 		Real psum( 0.0 );
 		for ( Size ii = 1; ii <= parent::n_packed_rots(); ++ii ) {
-			psum += rotamers_( bb_rot_index, ii ).rotamer_probability();
+			psum += rotamer_table()( bb_rot_index, ii ).rotamer_probability();
 		}
 
 		// The values actually stored are positive sign ( == negative entropy )
 		// which corresponds to Free energy contribution by Entropy
 		for ( Size ii = 1; ii <= parent::n_packed_rots(); ++ii ) {
-			ShannonEntropy_n_derivs_[ 1 ]( bb_rot_index ) += -rotamers_( bb_rot_index, ii ).n_derivs()[ 1 ] * rotamers_( bb_rot_index, ii ).rotamer_probability() / psum;
+			ShannonEntropy_n_derivs_[ 1 ]( bb_rot_index ) += -rotamer_table()( bb_rot_index, ii ).n_derivs()[ 1 ] * rotamer_table()( bb_rot_index, ii ).rotamer_probability() / psum;
 		}
 
 		bb_bin[ 1 ]++;
@@ -2539,6 +2413,7 @@ template < Size T, Size N >
 Size RotamericSingleResidueDunbrackLibrary< T, N >::memory_usage_dynamic() const
 {
 	Size total = parent::memory_usage_dynamic(); // recurse to parent.
+	// Tables viewed in a memory-mapped binary file are shared, and not counted.
 	total += rotamers_.size() * sizeof( PackedDunbrackRotamer< T, N > );
 	total += packed_rotno_2_sorted_rotno_.size() * sizeof( Size ); // could make these shorts or chars!
 	//total += max_rotprob_.size() * sizeof( DunbrackReal );
@@ -2575,8 +2450,8 @@ RotamericSingleResidueDunbrackLibrary< T, N >::get_rotamer_from_chi_static_voron
 	core::Real dist_sq(0.0), lowest_dist_sq(0.0);
 	PackedDunbrackRotamer< T, N > const * lowest_rotamer( nullptr ); //Temporary use of raw pointer is simplest here.  Note that ownership of object pointed to is not an issue.
 	bool first(true);
-	for ( core::Size irot(1), irotmax(rotamers_.size2()); irot<=irotmax; ++irot ) {
-		PackedDunbrackRotamer< T, N > const &cur_rot( rotamers_( bb_index, irot ) );
+	for ( core::Size irot(1), irotmax(rotamer_table().size2()); irot<=irotmax; ++irot ) {
+		PackedDunbrackRotamer< T, N > const &cur_rot( rotamer_table()( bb_index, irot ) );
 		//std::cout << "**-**-**-** Considering packed_rotno=" << cur_rot.packed_rotno() << std::endl; //DELETE ME
 		dist_sq = 0;
 		for ( core::Size ichi(1); ichi<=T; ++ichi ) {
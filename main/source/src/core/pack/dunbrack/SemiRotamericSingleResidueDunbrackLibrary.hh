@@ -339,7 +339,7 @@ public:
 	void
 	write_to_file( utility::io::ozstream & out ) const override;
 
-	virtual void write_to_binary( utility::io::ozstream & out ) const override;
+	virtual void write_to_binary( std::ostream & out ) const override;
 
 	/// @brief Initialize either a backbone-independent or a backbone-dependent SRSRDL
 	/// from the set of four files which describe both (not all files are read).
@@ -359,7 +359,7 @@ public:
 		utility::io::izstream & in_continmin_bbdep
 	);
 
-	virtual void read_from_binary( utility::io::izstream & in ) override;
+	virtual void read_from_binary( std::istream & in ) override;
 
 	/// @brief Comparison operator, mainly intended to use in ASCII/binary comparsion tests
 	/// Values tested should parallel those used in the read_from_binary() function.
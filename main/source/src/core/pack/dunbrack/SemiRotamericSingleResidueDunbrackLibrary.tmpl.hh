@@ -950,7 +950,7 @@ SemiRotamericSingleResidueDunbrackLibrary< T, N >::write_to_file( utility::io::o
 
 template < Size T, Size N >
 void
-SemiRotamericSingleResidueDunbrackLibrary< T, N >::write_to_binary( utility::io::ozstream & out ) const
+SemiRotamericSingleResidueDunbrackLibrary< T, N >::write_to_binary( std::ostream & out ) const
 {
 	using namespace boost;
 	parent::write_to_binary( out );
@@ -1098,7 +1098,7 @@ SemiRotamericSingleResidueDunbrackLibrary< T, N >::write_to_binary( utility::io:
 
 template < Size T, Size N >
 void
-SemiRotamericSingleResidueDunbrackLibrary< T, N >::read_from_binary( utility::io::izstream & in )
+SemiRotamericSingleResidueDunbrackLibrary< T, N >::read_from_binary( std::istream & in )
 {
 	using namespace boost;
 	parent::read_from_binary( in );
@@ -44,12 +44,16 @@
 // Utility headers
 #include <utility/exit.hh>
 #include <utility/io/izstream.hh>
+#include <utility/io/MappedFile.hh>
 #include <utility/io/ozstream.hh>
 #include <utility/vector1.hh>
 
 // Numeric headers
 #include <numeric/random/random.hh>
 
+// C++ headers
+#include <sstream>
+
 
 namespace core {
 namespace pack {
@@ -424,7 +428,7 @@ SingleResidueDunbrackLibrary::packed_rotno_2_rotwell( Size const packed_rotno )
 
 
 void
-SingleResidueDunbrackLibrary::write_to_binary( utility::io::ozstream & out ) const
+SingleResidueDunbrackLibrary::write_to_binary( std::ostream & out ) const
 {
 	using namespace boost;
 	/// 1. n_packed_rots_
@@ -467,7 +471,7 @@ SingleResidueDunbrackLibrary::write_to_binary( utility::io::ozstream & out ) con
 }
 
 void
-SingleResidueDunbrackLibrary::read_from_binary( utility::io::izstream & in )
+SingleResidueDunbrackLibrary::read_from_binary( std::istream & in )
 {
 
 	/// 1. n_packed_rots_
@@ -512,6 +516,34 @@ SingleResidueDunbrackLibrary::read_from_binary( utility::io::izstream & in )
 	packed_rotno_conversion_data_current_ = true;
 }
 
+void
+SingleResidueDunbrackLibrary::read_from_mapped_binary(
+	utility::io::MappedFileCOP const & file,
+	Size const offset,
+	Size const nbytes
+)
+{
+	utility::io::MemoryStreamBuf buf( file->data() + offset, nbytes );
+	std::istream in( &buf );
+	mapped_binary_ = file;
+	mapped_binary_begin_ = file->data() + offset;
+	read_from_binary( in );
+	mapped_binary_ = nullptr;
+	mapped_binary_begin_ = nullptr;
+	if ( ! in ) {
+		utility_exit_with_message( "Error reading single residue rotamer library for " + chemical::name_from_aa( aa_ ) + " from " + file->filename() );
+	}
+}
+
+char const *
+SingleResidueDunbrackLibrary::mapped_binary_at( std::istream & in ) const
+{
+	if ( ! mapped_binary_begin_ ) return nullptr;
+	std::streampos const pos( in.tellg() );
+	if ( pos < 0 ) return nullptr;
+	return mapped_binary_begin_ + static_cast< std::streamoff >( pos );
+}
+
 /// @brief Comparison operator, mainly intended to use in ASCII/binary comparsion tests
 /// Values tested should parallel those used in the read_from_binary() function.
 bool
@@ -855,9 +887,9 @@ INIT(  FIVE,  FIVE )
 	rotamers::RotamerVector rv;
 	ChiVector chiv;
 
-	utility::io::ozstream os;
+	std::ostringstream os;
 	utility::io::ozstream ozs;
-	utility::io::izstream is;
+	std::istringstream is;
 
 	utility::vector1< Real > chi; utility::vector1< Size > rot;
 
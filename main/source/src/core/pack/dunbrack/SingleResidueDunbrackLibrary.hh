@@ -26,6 +26,7 @@
 // Utility Headers
 #include <utility/assert.hh>
 #include <utility/io/izstream.fwd.hh>
+#include <utility/io/MappedFile.fwd.hh>
 #include <utility/io/ozstream.fwd.hh>
 #include <utility/excn/Exceptions.hh>
 #include <utility/string_util.hh>
@@ -35,6 +36,8 @@
 
 #include <utility/vector1.hh>
 
+#include <iosfwd>
+
 
 namespace core {
 namespace pack {
@@ -83,8 +86,14 @@ public:
 
 public:
 
-	virtual void write_to_binary( utility::io::ozstream & out ) const;
-	virtual void read_from_binary( utility::io::izstream & in );
+	virtual void write_to_binary( std::ostream & out ) const;
+	virtual void read_from_binary( std::istream & in );
+
+	/// @brief Read the library from the nbytes of a memory-mapped binary file at offset, as
+	/// written by write_to_binary().  Derived classes may keep their largest tables in place
+	/// in the mapping rather than copying them (see mapped_binary_at()); the file then stays
+	/// mapped for as long as the library lives.
+	void read_from_mapped_binary( utility::io::MappedFileCOP const & file, Size const offset, Size const nbytes );
 
 	/// @brief Return all of the rotamer sample data given a particular phi/psi.
 	/// For N-terminus residues, hand in the phi value SingleResidueDunbrackLibrary::PHI_NEUTRAL and
@@ -194,6 +203,14 @@ protected:
 	/// Read access for the derived class
 	bool dun_entropy_correction() const { return dun_entropy_correction_; }
 
+	/// @brief The file being read by read_from_mapped_binary(); null when reading any other way.
+	utility::io::MappedFileCOP const & mapped_binary() const { return mapped_binary_; }
+
+	/// @brief Where in mapped_binary() the next byte to be read from in lies; null when reading
+	/// any other way.  Derived classes reading a table of trivially-copyable values from in may
+	/// instead use it in place here, and skip over it in the stream.
+	char const * mapped_binary_at( std::istream & in ) const;
+
 	/// Worker functions available to the derived classes
 
 	virtual Size memory_usage_static() const = 0;
@@ -546,6 +563,10 @@ private:
 	utility::vector1< Size > packed_rotno_2_rotno_;
 	utility::vector1< utility::vector1< Size > > packed_rotno_2_rotwell_;
 
+	/// The file and the start of the stream being read by read_from_mapped_binary()
+	utility::io::MappedFileCOP mapped_binary_;
+	char const * mapped_binary_begin_ = nullptr;
+
 };
 
 
@@ -179,7 +179,9 @@ public:
 	/// @param aa_offset - [in] - offset into sparse matrix.  Node2 does not need
 	///   to know what this offset represents; it only needs to know that it must
 	///   provide this data to this method.
-	/// @param sparse_matrix - [in] - the sparse matrix that this method reads from
+	/// @param sparse_matrix - [in] - the sparse matrix that this method reads from; a
+	///   FArray1 or any table with the same 1-based layout, e.g. a CompactEnergyTable
+	template < class Table >
 	static
 	inline
 	value_type
@@ -189,7 +191,7 @@ public:
 		SparseMatrixIndex const & ind2,
 		int ind2num_states_per_aatype,
 		int aa_offset,
-		ObjexxFCL::FArray1< value_type > const & sparse_matrix
+		Table const & sparse_matrix
 	)
 	{
 		if ( aa_offset == -1 ) {
@@ -218,8 +220,10 @@ public:
 	/// @param aa_offset - [in] - offset into sparse matrix.  Node1 does not need
 	///   to know what this offset represents; it only needs to know that it must
 	///   provide this data to this method.
-	/// @param sparse_matrix - [in] - the sparse matrix that this method reads from
+	/// @param sparse_matrix - [in] - the sparse matrix that this method reads from; a
+	///   FArray1 or any table with the same 1-based layout, e.g. a CompactEnergyTable
 	///
+	template < class Table >
 	static
 	inline
 	value_type
@@ -229,7 +233,7 @@ public:
 		int ind1_node_state_offset_minus_1,
 		int ind2_num_states_per_aatype,
 		int aa_offset,
-		ObjexxFCL::FArray1< value_type > const & sparse_matrix
+		Table const & sparse_matrix
 	)
 	{
 
@@ -243,6 +247,21 @@ public:
 		return sparse_matrix( index );
 	}
 
+	/// @brief retrieves the value for a pair of states from a table with this sparse
+	/// matrix's layout -- e.g. a compacted copy of its values -- rather than from the
+	/// values held by this sparse matrix.
+	template < class Table >
+	inline
+	value_type
+	get( SparseMatrixIndex const & ind1, SparseMatrixIndex const & ind2, Table const & table )
+	const
+	{
+		int offset = get_offset( ind1, ind2);
+		if ( offset == -1 ) return (value_type) 0;
+
+		return table( offset + get_submatrix_index(ind1, ind2) );
+	}
+
 	/// @brief how many values are stored in this sparse matrix?  Valid indices are 1 to size() for the
 	/// operator [] method
 	int
@@ -463,6 +482,18 @@ public:
 		int node1aa,
 		int node2aa
 	) const
+	{
+		return get_aa_submatrix_energies( node1aa, node2aa, sparse_matrix_ );
+	}
+
+	/// @brief the amino-acid-pair submatrix of a table with this sparse matrix's layout
+	template < class Table >
+	ObjexxFCL::FArray2D< value_type >
+	get_aa_submatrix_energies(
+		int node1aa,
+		int node2aa,
+		Table const & table
+	) const
 	{
 		ObjexxFCL::FArray2D< value_type > submatrix(
 			second_node_num_states_per_aatype_[ node2aa ],
@@ -473,14 +504,52 @@ public:
 			submatrix = value_type( 0 );
 		} else {
 			int const nvals = submatrix.size();
-			for ( int li_src = offset, li_dest = 0; li_dest < nvals ; ++li_dest, ++li_src ) {
-				submatrix[ li_dest ] = sparse_matrix_[ li_src ];
+			for ( int li_src = offset + 1, li_dest = 0; li_dest < nvals ; ++li_dest, ++li_src ) {
+				submatrix[ li_dest ] = table( li_src );
 			}
 		}
 
 		return submatrix;
 	}
 
+	/// @brief read access to the stored values, e.g. to make a compacted copy of them
+	inline
+	ObjexxFCL::FArray1D< value_type > const &
+	values() const
+	{
+		return sparse_matrix_;
+	}
+
+	/// @brief deallocates the stored values but keeps the amino-acid-neighbor offsets, so
+	/// that lookups can continue through a copy of the values held elsewhere; the values
+	/// must be restored before this sparse matrix is read from or written to again.
+	inline
+	void
+	release_values()
+	{
+		sparse_matrix_.clear();
+	}
+
+	/// @brief whether release_values() has been called since the values were last restored
+	inline
+	bool
+	values_released() const
+	{
+		return table_size_ != 0 && sparse_matrix_.size() == 0;
+	}
+
+	/// @brief reallocates the values dropped by release_values() and fills them from a
+	/// table with this sparse matrix's layout
+	template < class Table >
+	void
+	restore_values( Table const & table )
+	{
+		sparse_matrix_.dimension( table_size_ );
+		for ( int ii = 1; ii <= table_size_; ++ii ) {
+			sparse_matrix_( ii ) = table( ii );
+		}
+	}
+
 
 	////////////////////////////////////////////////////////////////////////////////
 	///
@@ -0,0 +1,220 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/pack/interaction_graph/CompactEnergyTable.cc
+/// @brief  A read-mostly table of two-body energies stored in 16 or 8 bits per entry
+
+// Unit headers
+#include <core/pack/interaction_graph/CompactEnergyTable.hh>
+
+// ObjexxFCL headers
+#include <ObjexxFCL/FArray1.hh>
+#include <ObjexxFCL/FArray2.hh>
+
+// Utility headers
+#include <utility/exit.hh>
+#include <utility/backtrace.hh>
+
+// C++ headers
+#include <algorithm>
+#include <cmath>
+
+namespace core {
+namespace pack {
+namespace interaction_graph {
+
+std::string
+edge_energy_storage_name( EdgeEnergyStorage storage )
+{
+	switch ( storage ) {
+	case float_edge_storage : return "float";
+	case half_edge_storage : return "half";
+	case fixed16_edge_storage : return "fixed16";
+	case fixed8_edge_storage : return "fixed8";
+	}
+	return "unknown";
+}
+
+EdgeEnergyStorage
+edge_energy_storage_from_name( std::string const & name )
+{
+	for ( int ii = 1; ii <= n_edge_energy_storages; ++ii ) {
+		if ( edge_energy_storage_name( EdgeEnergyStorage( ii ) ) == name ) return EdgeEnergyStorage( ii );
+	}
+	utility_exit_with_message( "Unrecognized interaction-graph edge storage \"" + name + "\"; expected float, half, fixed16 or fixed8" );
+	return float_edge_storage;
+}
+
+CompactEnergyTable::CompactEnergyTable() :
+	storage_( float_edge_storage ),
+	size_( 0 ),
+	size1_( 0 ),
+	step_( 0.0f )
+{}
+
+void
+CompactEnergyTable::encode(
+	EdgeEnergyStorage storage,
+	ObjexxFCL::FArray1< float > const & energies,
+	float clamp
+)
+{
+	encode_values( storage, energies, clamp );
+	size1_ = size_;
+}
+
+void
+CompactEnergyTable::encode(
+	EdgeEnergyStorage storage,
+	ObjexxFCL::FArray2< float > const & energies,
+	float clamp
+)
+{
+	encode_values( storage, energies, clamp );
+	size1_ = energies.size1();
+}
+
+void
+CompactEnergyTable::clear()
+{
+	storage_ = float_edge_storage;
+	size_ = size1_ = 0;
+	step_ = 0.0f;
+	std::vector< std::int16_t >().swap( values16_ );
+	std::vector< std::int8_t >().swap( values8_ );
+}
+
+float
+CompactEnergyTable::max_magnitude() const
+{
+	switch ( storage_ ) {
+	case fixed8_edge_storage : return std::abs( step_ ) * 127;
+	case fixed16_edge_storage : return std::abs( step_ ) * 32767;
+	default : return 65504.0f;
+	}
+}
+
+void
+CompactEnergyTable::decode( ObjexxFCL::FArray1< float > & energies ) const
+{
+	decode_values( energies );
+}
+
+void
+CompactEnergyTable::decode( ObjexxFCL::FArray2< float > & energies ) const
+{
+	decode_values( energies );
+}
+
+void
+CompactEnergyTable::scale( float factor )
+{
+	if ( storage_ == half_edge_storage ) {
+		for ( auto & value : values16_ ) {
+			value = float_to_half( half_to_float( value ) * factor );
+		}
+	} else {
+		step_ *= factor;
+	}
+}
+
+unsigned int
+CompactEnergyTable::memory_in_bytes() const
+{
+	return values16_.capacity() * sizeof( std::int16_t ) + values8_.capacity() * sizeof( std::int8_t );
+}
+
+std::int16_t
+CompactEnergyTable::float_to_half( float value )
+{
+	std::uint32_t bits;
+	std::memcpy( &bits, &value, sizeof( float ) );
+	std::uint16_t const sign = ( bits >> 16 ) & 0x8000;
+	std::uint32_t const magnitude_bits = bits & 0x7fffffff;
+
+	std::uint16_t half;
+	if ( magnitude_bits > 0x7f800000 ) {
+		half = 0x7e00; // NaN
+	} else if ( magnitude_bits >= 0x477fe000 ) {
+		half = 0x7bff; // 65504 -- no infinities
+	} else if ( magnitude_bits < 0x38800000 ) {
+		// Below the smallest normal half, 2^-14: a subnormal half counts multiples of 2^-24
+		float magnitude;
+		std::memcpy( &magnitude, &magnitude_bits, sizeof( float ) );
+		half = std::uint16_t( std::nearbyint( magnitude * 16777216.0f ) );
+	} else {
+		// Rebias the exponent from 127 to 15 and round the mantissa to 10 bits, to nearest even;
+		// a carry out of the mantissa correctly increments the exponent.
+		std::uint32_t const rebiased = magnitude_bits - ( ( 127 - 15 ) << 23 );
+		half = std::uint16_t( rebiased >> 13 );
+		std::uint32_t const remainder = rebiased & 0x1fff;
+		if ( remainder > 0x1000 || ( remainder == 0x1000 && ( half & 1 ) ) ) ++half;
+	}
+	return std::int16_t( half | sign );
+}
+
+template < class FArray >
+void
+CompactEnergyTable::encode_values(
+	EdgeEnergyStorage storage,
+	FArray const & energies,
+	float clamp
+)
+{
+	clear();
+	if ( storage == float_edge_storage ) return;
+
+	storage_ = storage;
+	size_ = energies.size();
+
+	if ( storage_ == half_edge_storage ) {
+		values16_.resize( size_ );
+		for ( int ii = 0; ii < size_; ++ii ) {
+			values16_[ ii ] = float_to_half( energies[ ii ] );
+		}
+		return;
+	}
+
+	float const max_int = storage_ == fixed16_edge_storage ? 32767.0f : 127.0f;
+	float max_abs( 0.0f );
+	for ( int ii = 0; ii < size_; ++ii ) {
+		max_abs = std::max( max_abs, std::min( std::abs( energies[ ii ] ), clamp ) );
+	}
+	step_ = max_abs > 0.0f ? max_abs / max_int : 1.0f;
+	float const inv_step = 1.0f / step_;
+
+	if ( storage_ == fixed16_edge_storage ) {
+		values16_.resize( size_ );
+	} else {
+		values8_.resize( size_ );
+	}
+	for ( int ii = 0; ii < size_; ++ii ) {
+		float const clamped = std::max( -clamp, std::min( energies[ ii ], clamp ) );
+		float const quantized = std::max( -max_int, std::min( std::nearbyint( clamped * inv_step ), max_int ) );
+		if ( storage_ == fixed16_edge_storage ) {
+			values16_[ ii ] = std::int16_t( quantized );
+		} else {
+			values8_[ ii ] = std::int8_t( quantized );
+		}
+	}
+}
+
+template < class FArray >
+void
+CompactEnergyTable::decode_values( FArray & energies ) const
+{
+	debug_assert( int( energies.size() ) == size_ );
+	for ( int ii = 0; ii < size_; ++ii ) {
+		energies[ ii ] = operator () ( ii + 1 );
+	}
+}
+
+} // namespace interaction_graph
+} // namespace pack
+} // namespace core
@@ -0,0 +1,37 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/pack/interaction_graph/CompactEnergyTable.fwd.hh
+/// @brief  Forward declaration of the compact two-body energy table and its storage types
+
+
+#ifndef INCLUDED_core_pack_interaction_graph_CompactEnergyTable_fwd_hh
+#define INCLUDED_core_pack_interaction_graph_CompactEnergyTable_fwd_hh
+
+namespace core {
+namespace pack {
+namespace interaction_graph {
+
+/// @brief How the precomputed interaction graphs hold their two-body energies
+/// during simulated annealing
+enum EdgeEnergyStorage {
+	float_edge_storage = 1, // 32-bit floats; the default
+	half_edge_storage,      // IEEE 754 16-bit floats
+	fixed16_edge_storage,   // 16-bit integers with a per-edge scale
+	fixed8_edge_storage,    // 8-bit integers with a per-edge scale
+	n_edge_energy_storages = fixed8_edge_storage
+};
+
+class CompactEnergyTable;
+
+} // namespace interaction_graph
+} // namespace pack
+} // namespace core
+
+#endif
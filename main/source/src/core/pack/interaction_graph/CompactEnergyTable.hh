@@ -0,0 +1,147 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/pack/interaction_graph/CompactEnergyTable.hh
+/// @brief  A read-mostly table of two-body energies stored in 16 or 8 bits per entry
+
+#ifndef INCLUDED_core_pack_interaction_graph_CompactEnergyTable_hh
+#define INCLUDED_core_pack_interaction_graph_CompactEnergyTable_hh
+
+// Unit headers
+#include <core/pack/interaction_graph/CompactEnergyTable.fwd.hh>
+
+// ObjexxFCL headers
+#include <ObjexxFCL/FArray1.fwd.hh>
+#include <ObjexxFCL/FArray2.fwd.hh>
+
+// C++ headers
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace core {
+namespace pack {
+namespace interaction_graph {
+
+/// @brief The option-string name of a storage type: "float", "half", "fixed16" or "fixed8"
+std::string
+edge_energy_storage_name( EdgeEnergyStorage storage );
+
+/// @brief The storage type for an option-string name; exits on an unrecognized name
+EdgeEnergyStorage
+edge_energy_storage_from_name( std::string const & name );
+
+/// @brief Holds a copy of an edge's two-body energy table in half-precision floats or in
+/// 16- or 8-bit fixed point, for the precomputed interaction graphs to read during
+/// simulated annealing in place of their 32-bit tables.
+///
+/// @details The table is indexed exactly as the table it was encoded from: 1-based
+/// linear indices for a FArray1 (the layout of the AminoAcidNeighborSparseMatrix), and
+/// (i,j) for a FArray2.  The fixed-point forms use one step size per table, max|e| / 32767
+/// or max|e| / 127, after clamping every energy to [-clamp, clamp]; zero is represented
+/// exactly, and the rounding error of any entry is at most half a step.  Half-precision
+/// floats need no clamp (other than to their largest finite value, 65504) and carry about
+/// three significant decimal digits.
+class CompactEnergyTable
+{
+public:
+	CompactEnergyTable();
+
+	/// @brief Replace the contents with the given energies in the given storage.  Encoding
+	/// as float_edge_storage leaves the table empty.
+	void encode( EdgeEnergyStorage storage, ObjexxFCL::FArray1< float > const & energies, float clamp );
+	void encode( EdgeEnergyStorage storage, ObjexxFCL::FArray2< float > const & energies, float clamp );
+
+	/// @brief Deallocate; the table reads as empty
+	void clear();
+
+	bool empty() const { return size_ == 0; }
+	int size() const { return size_; }
+	EdgeEnergyStorage storage() const { return storage_; }
+
+	/// @brief The step size of the fixed-point storage types
+	float step() const { return step_; }
+
+	/// @brief The largest magnitude the table can represent
+	float max_magnitude() const;
+
+	/// @brief Decode every entry into energies, which must already have the table's dimensions
+	void decode( ObjexxFCL::FArray1< float > & energies ) const;
+	void decode( ObjexxFCL::FArray2< float > & energies ) const;
+
+	/// @brief Multiply every entry by a constant.  Exact for the fixed-point types, which
+	/// only rescale their step; the half-precision entries are rounded again.
+	void scale( float factor );
+
+	/// @brief The number of bytes spent on the entries
+	unsigned int memory_in_bytes() const;
+
+	/// @brief The entry at a 1-based linear index
+	inline
+	float
+	operator () ( int index ) const
+	{
+		switch ( storage_ ) {
+		case fixed8_edge_storage :
+			return step_ * values8_[ index - 1 ];
+		case fixed16_edge_storage :
+			return step_ * values16_[ index - 1 ];
+		default :
+			return half_to_float( values16_[ index - 1 ] );
+		}
+	}
+
+	/// @brief The entry at (i,j) of a table encoded from a FArray2
+	inline
+	float
+	operator () ( int i, int j ) const
+	{
+		return operator () ( ( j - 1 ) * size1_ + i );
+	}
+
+public:
+	/// @brief Round to the nearest IEEE 754 half-precision float; magnitudes beyond the
+	/// largest finite half, 65504, are clamped to it
+	static std::int16_t float_to_half( float value );
+
+	static inline
+	float
+	half_to_float( std::int16_t half )
+	{
+		// Shift the exponent and mantissa into place and let a multiplication by 2^112
+		// correct the exponent bias; this handles subnormal halves too.
+		std::uint32_t const bits = std::uint32_t( std::uint16_t( half ) & 0x7fff ) << 13;
+		float magnitude;
+		std::memcpy( &magnitude, &bits, sizeof( float ) );
+		magnitude *= 5.192296858534828e+33f; // 2^112
+		return ( half & 0x8000 ) ? -magnitude : magnitude;
+	}
+
+private:
+	template < class FArray >
+	void encode_values( EdgeEnergyStorage storage, FArray const & energies, float clamp );
+
+	template < class FArray >
+	void decode_values( FArray & energies ) const;
+
+private:
+	EdgeEnergyStorage storage_;
+	int size_;
+	int size1_;
+	float step_;
+	std::vector< std::int16_t > values16_;
+	std::vector< std::int8_t > values8_;
+};
+
+} // namespace interaction_graph
+} // namespace pack
+} // namespace core
+
+#endif
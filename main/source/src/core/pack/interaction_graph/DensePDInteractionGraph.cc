@@ -52,6 +52,7 @@ namespace interaction_graph {
 DensePDNode::DensePDNode(InteractionGraphBase * owner, int node_id, int num_states) :
 	PrecomputedPairEnergiesNode( owner, node_id, num_states ),
 	one_body_energies_(num_states + 1, 0.0f),
+	edge_tables_compacted_( false ),
 	current_state_( 0 ),
 	curr_state_one_body_energy_( core::PackerEnergy( 0.0 )),
 	curr_state_total_energy_( core::PackerEnergy( 0.0 )),
@@ -276,8 +277,16 @@ void DensePDNode::update_internal_vectors()
 	edge_matrix_ptrs_.reserve( get_num_incident_edges() + 1);
 	edge_matrix_ptrs_.emplace_back( ); //occupy the 0th position
 
+	edge_tables_compacted_ = get_dpdig_owner()->edge_energy_storage() != float_edge_storage;
+	compact_edge_tables_.assign( get_num_incident_edges() + 1, nullptr );
+
 	for ( int ii = 1; ii <= get_num_incident_edges(); ++ii ) {
-		edge_matrix_ptrs_.push_back( get_incident_dpd_edge(ii)->get_edge_table_ptr() );
+		if ( edge_tables_compacted_ ) {
+			compact_edge_tables_[ ii ] = get_incident_dpd_edge(ii)->get_compact_edge_table();
+			edge_matrix_ptrs_.emplace_back( );
+		} else {
+			edge_matrix_ptrs_.push_back( get_incident_dpd_edge(ii)->get_edge_table_ptr() );
+		}
 	}
 
 	curr_state_two_body_energies_.resize( get_num_incident_edges() + 1);
@@ -343,6 +352,7 @@ DensePDNode::count_dynamic_memory() const
 	dynamic_memory += one_body_energies_.size() * sizeof( core::PackerEnergy );
 	dynamic_memory += neighbors_curr_state_.size() * sizeof( int );
 	dynamic_memory += edge_matrix_ptrs_.size() * sizeof ( FArray2A< core::PackerEnergy > );
+	dynamic_memory += compact_edge_tables_.size() * sizeof ( CompactEnergyTable const * );
 	dynamic_memory += curr_state_two_body_energies_.size() * sizeof ( core::PackerEnergy );
 	dynamic_memory += alternate_state_two_body_energies_.size() * sizeof ( core::PackerEnergy );
 	dynamic_memory += NodeBase::count_dynamic_memory();
@@ -387,6 +397,7 @@ void DensePDEdge::add_to_two_body_energy
 	core::PackerEnergy const energy
 )
 {
+	restore_two_body_energies();
 	two_body_energies_(state2, state1) += edge_weight() * energy;
 	energies_updated_since_last_prep_for_simA_ = true;
 	return;
@@ -403,6 +414,7 @@ void DensePDEdge::add_to_two_body_energies
 	FArray2< core::PackerEnergy > const & res_res_energy_array
 )
 {
+	restore_two_body_energies();
 	debug_assert( res_res_energy_array.size1() == two_body_energies_.size1() );
 	debug_assert( res_res_energy_array.size2() == two_body_energies_.size2() );
 	for ( Size ii = 1, iie = two_body_energies_.size1(); ii <= iie; ++ii ) {
@@ -431,6 +443,7 @@ void DensePDEdge::set_two_body_energy
 	core::PackerEnergy const energy
 )
 {
+	restore_two_body_energies();
 	two_body_energies_( state2, state1 ) = edge_weight() * energy;
 	energies_updated_since_last_prep_for_simA_ = true;
 	return;
@@ -449,6 +462,7 @@ void DensePDEdge::clear_two_body_energy
 	int const state2
 )
 {
+	restore_two_body_energies();
 	two_body_energies_(state2,state1) = 0.0f;
 	energies_updated_since_last_prep_for_simA_ = true;
 	return;
@@ -461,6 +475,7 @@ void DensePDEdge::clear_two_body_energy
 /// @param state2 - [in] - state index for the node with the larger index
 core::PackerEnergy DensePDEdge::get_two_body_energy( int const state1, int const state2) const
 {
+	if ( ! compact_two_body_energies_.empty() ) return compact_two_body_energies_( state2, state1 );
 	return two_body_energies_(state2, state1);
 }
 
@@ -474,11 +489,39 @@ void DensePDEdge::declare_energies_final()
 /// @brief looks at all pair energies, and if they are all 0, deletes itself
 void DensePDEdge::prepare_for_simulated_annealing()
 {
-	if ( ! energies_updated_since_last_prep_for_simA_ ) return;
+	if ( energies_updated_since_last_prep_for_simA_ ) {
+		energies_updated_since_last_prep_for_simA_ = false;
+		if ( pd_edge_table_all_zeros() ) {
+			delete this;
+			return;
+		}
+	}
+	update_two_body_energy_storage();
+}
 
-	energies_updated_since_last_prep_for_simA_ = false;
+/// @details Since declare_energies_final() prepares each edge as soon as its energies
+/// have been computed, at most one edge's float table needs to be held at once alongside
+/// the compacted tables.
+void DensePDEdge::update_two_body_energy_storage()
+{
+	EdgeEnergyStorage const storage = get_dpdig_owner()->edge_energy_storage();
+	if ( storage == float_edge_storage ) {
+		restore_two_body_energies();
+		return;
+	}
+	if ( compact_two_body_energies_.storage() == storage ) return;
+
+	restore_two_body_energies();
+	compact_two_body_energies_.encode( storage, two_body_energies_, get_dpdig_owner()->edge_energy_clamp() );
+	two_body_energies_.clear();
+}
 
-	if ( pd_edge_table_all_zeros() ) delete this;
+void DensePDEdge::restore_two_body_energies()
+{
+	if ( compact_two_body_energies_.empty() ) return;
+	two_body_energies_.dimension( get_num_states_for_node( 1 ), get_num_states_for_node( 0 ) );
+	compact_two_body_energies_.decode( two_body_energies_ );
+	compact_two_body_energies_.clear();
 }
 
 /// @brief returns the two body energy corresponding to the current states assigned to
@@ -517,6 +560,8 @@ DensePDEdge::acknowledge_state_change
 
 	if (  one_node_in_zero_state ) {
 		curr_state_energy_ = 0;
+	} else if ( ! compact_two_body_energies_.empty() ) {
+		curr_state_energy_ = compact_two_body_energies_( nodes_curr_states[ 1 ], nodes_curr_states[ 0 ] );
 	} else {
 		curr_state_energy_ = two_body_energies_( nodes_curr_states[ 1 ], nodes_curr_states[ 0 ] );
 	}
@@ -553,15 +598,23 @@ void DensePDEdge::acknowledge_state_zeroed( int node_ind )
 /// @brief Returns a reference to the first element in the dense two-body energy
 /// table.  Used to create a proxy array on the nodes for cache efficiency.
 FArray2A< core::PackerEnergy > DensePDEdge::get_edge_table_ptr() {
+	restore_two_body_energies();
 	return FArray2A< core::PackerEnergy >( two_body_energies_( 1, 1 ),
 		get_num_states_for_node( 1 ),
 		get_num_states_for_node( 0 ) );
 }
 
 
+CompactEnergyTable const *
+DensePDEdge::get_compact_edge_table() const
+{
+	return compact_two_body_energies_.empty() ? nullptr : & compact_two_body_energies_;
+}
+
 /// @brief returns the memory usage of the two body energy table for this edge
 int DensePDEdge::get_two_body_table_size() const
 {
+	if ( ! compact_two_body_energies_.empty() ) return compact_two_body_energies_.size();
 	return two_body_energies_.size();
 }
 
@@ -579,6 +632,7 @@ DensePDEdge::count_dynamic_memory() const
 {
 	unsigned int dynamic_memory = 0;
 	dynamic_memory += two_body_energies_.size() * sizeof( core::PackerEnergy );
+	dynamic_memory += compact_two_body_energies_.memory_in_bytes();
 	dynamic_memory += EdgeBase::count_dynamic_memory();
 	return dynamic_memory;
 }
@@ -598,7 +652,11 @@ DensePDEdge::set_edge_weight( Real weight )
 		utility_exit_with_message( "Error: set edge weight to 0 not a legal operation.  Delete this edge instead" );
 	}
 	Real rescale = weight / edge_weight();
-	two_body_energies_ *=  rescale;
+	if ( ! compact_two_body_energies_.empty() ) {
+		compact_two_body_energies_.scale( rescale );
+	} else {
+		two_body_energies_ *=  rescale;
+	}
 	curr_state_energy_ *= rescale;
 	edge_weight( weight ); // set base-class data
 
@@ -607,6 +665,11 @@ DensePDEdge::set_edge_weight( Real weight )
 ObjexxFCL::FArray2D< core::PackerEnergy >
 DensePDEdge::get_aa_submatrix_energies() const
 {
+	if ( ! compact_two_body_energies_.empty() ) {
+		ObjexxFCL::FArray2D< core::PackerEnergy > energies( get_num_states_for_node( 1 ), get_num_states_for_node( 0 ) );
+		compact_two_body_energies_.decode( energies );
+		return energies;
+	}
 	return two_body_energies_;
 }
 
@@ -615,6 +678,7 @@ DensePDEdge::swap_edge_energies(
 	ObjexxFCL::FArray2D< core::PackerEnergy > & new_edge_table
 )
 {
+	restore_two_body_energies();
 	if ( two_body_energies_.size1() != new_edge_table.size1() ) {
 		utility_exit_with_message( "swap_edge_energies failed as size1 does not match: two_body_energies_.size1()= "
 			+ utility::to_string( two_body_energies_.size1() ) + " new_edge_table.size1()= "
@@ -632,6 +696,7 @@ void
 DensePDEdge::prepare_for_simulated_annealing_no_deletion()
 {
 	energies_updated_since_last_prep_for_simA_ = false;
+	update_two_body_energy_storage();
 }
 
 void
@@ -639,6 +704,12 @@ DensePDEdge::declare_energies_final_no_deletion(){}
 
 bool DensePDEdge::pd_edge_table_all_zeros()
 {
+	if ( ! compact_two_body_energies_.empty() ) {
+		for ( int ii = 1; ii <= compact_two_body_energies_.size(); ++ii ) {
+			if ( compact_two_body_energies_( ii ) != 0.0f ) { return false; }
+		}
+		return true;
+	}
 	unsigned int const num_energies = two_body_energies_.size();
 	for ( unsigned int ii = 0; ii < num_energies; ++ii ) {
 		if ( two_body_energies_[ ii ] != 0.0f ) { return false; }
@@ -661,9 +732,18 @@ DensePDInteractionGraph::DensePDInteractionGraph(int num_nodes) :
 	num_commits_since_last_update_(0),
 	total_energy_current_state_assignment_(0),
 	total_energy_alternate_state_assignment_(0),
-	node_considering_alt_state_( -1 )
+	node_considering_alt_state_( -1 ),
+	edge_energy_storage_( float_edge_storage ),
+	edge_energy_clamp_( 10.0 )
 {}
 
+void
+DensePDInteractionGraph::set_edge_energy_storage( EdgeEnergyStorage storage, core::PackerEnergy clamp )
+{
+	edge_energy_storage_ = storage;
+	edge_energy_clamp_ = clamp;
+}
+
 /// @brief The DensePDIG only needs to know how many states each node has.
 /// This function causes the downstream instantiation of the DensePDNodes.
 void
@@ -27,6 +27,7 @@
 
 #include <core/pack/interaction_graph/InteractionGraphBase.hh>
 #include <core/pack/interaction_graph/PrecomputedPairEnergiesInteractionGraph.hh>
+#include <core/pack/interaction_graph/CompactEnergyTable.hh>
 
 //STL Headers
 #include <list>
@@ -149,10 +150,28 @@ private:
 	inline DensePDInteractionGraph       * get_dpdig_owner();
 	inline DensePDInteractionGraph const * get_dpdig_owner() const;
 
+	template < class EdgeTable >
+	inline
+	void project_alt_state_two_body_energies( std::vector< EdgeTable > const & edge_tables );
+
+	static
+	inline
+	ObjexxFCL::FArray2A< core::PackerEnergy > const &
+	edge_table( ObjexxFCL::FArray2A< core::PackerEnergy > const & table ) { return table; }
+
+	static
+	inline
+	CompactEnergyTable const &
+	edge_table( CompactEnergyTable const * table ) { return *table; }
+
 	std::vector< core::PackerEnergy > one_body_energies_;
 
 	std::vector< int > neighbors_curr_state_;
 	std::vector< ObjexxFCL::FArray2A< core::PackerEnergy > > edge_matrix_ptrs_;
+	/// @brief the edges' compacted tables, used in place of edge_matrix_ptrs_ when the
+	/// graph holds its edge energies in one of the compact storage types
+	std::vector< CompactEnergyTable const * > compact_edge_tables_;
+	bool edge_tables_compacted_;
 
 	int current_state_;
 	core::PackerEnergy curr_state_one_body_energy_;
@@ -213,12 +232,13 @@ public:
 	);
 	void acknowledge_state_zeroed( int node_ind );
 
+	template < class Table >
 	static
 	inline
 	core::PackerEnergy get_alternate_state_energy(
 		int first_node_state,
 		int second_node_state,
-		ObjexxFCL::FArray2< core::PackerEnergy > & edge_energy_table
+		Table const & edge_energy_table
 	);
 
 	inline void acknowledge_substitution(
@@ -230,6 +250,10 @@ public:
 	int get_two_body_table_size() const;
 	ObjexxFCL::FArray2A< core::PackerEnergy > get_edge_table_ptr();
 
+	/// @brief The compacted copy of the two-body energy table, or 0 if the edge holds its
+	/// energies as floats.  Used in place of get_edge_table_ptr() by the nodes.
+	CompactEnergyTable const * get_compact_edge_table() const;
+
 	unsigned int count_static_memory() const override;
 	unsigned int count_dynamic_memory() const override;
 
@@ -260,7 +284,16 @@ private:
 	inline DensePDInteractionGraph       * get_dpdig_owner();
 	inline DensePDInteractionGraph const * get_dpdig_owner() const;
 
+	/// @brief Encode the two-body energies in the owner's edge-energy storage type and
+	/// deallocate the float table, or restore the float table if the owner asks for floats.
+	void update_two_body_energy_storage();
+
+	/// @brief If the energies are held compactly, restore the float table so that it
+	/// may be modified; called by every method that writes to the table.
+	void restore_two_body_energies();
+
 	ObjexxFCL::FArray2D< core::PackerEnergy > two_body_energies_; //Dense matrix
+	CompactEnergyTable compact_two_body_energies_;
 	core::PackerEnergy curr_state_energy_;
 	bool energies_updated_since_last_prep_for_simA_;
 
@@ -316,6 +349,14 @@ public:
 	virtual unsigned int count_static_memory() const;
 	virtual unsigned int count_dynamic_memory() const;
 
+	/// @brief Hold the edges' two-body energies in the given storage type during simulated
+	/// annealing; the fixed-point types clamp energies to [-clamp, clamp].  Should be set
+	/// before the energies are computed, so that each edge's table is compacted as soon as
+	/// its energies are declared final.
+	void set_edge_energy_storage( EdgeEnergyStorage storage, core::PackerEnergy clamp = 10.0 );
+	EdgeEnergyStorage edge_energy_storage() const { return edge_energy_storage_; }
+	core::PackerEnergy edge_energy_clamp() const { return edge_energy_clamp_; }
+
 	/// @brief Override the InteractionGraphBase class's implementation of this function
 	/// to return 'true'.
 	virtual
@@ -376,6 +417,9 @@ private:
 	core::PackerEnergy total_energy_alternate_state_assignment_;
 	int node_considering_alt_state_;
 
+	EdgeEnergyStorage edge_energy_storage_;
+	core::PackerEnergy edge_energy_clamp_;
+
 	static const int COMMIT_LIMIT_BETWEEN_UPDATES = 1024; // 2^10
 
 	//no default constructor, uncopyable
@@ -465,13 +509,14 @@ void DensePDNode::acknowledge_neighbors_state_substitution(
 /// @param first_node_alt_state - [in] - the alternate state for the lower-indexed node
 /// @param second_node_orig_state - [in] - the current state for the higher-indexed node
 /// @param edge_energy_table - [in] - the proxy FArray pointing at the edge table
-///  connecting the two nodes.
+///  connecting the two nodes, or the edge's CompactEnergyTable.
+template < class Table >
 inline
 core::PackerEnergy
 DensePDEdge::get_alternate_state_energy(
 	int first_node_state,
 	int second_node_state,
-	ObjexxFCL::FArray2< core::PackerEnergy > & edge_energy_table
+	Table const & edge_energy_table
 )
 {
 	if ( first_node_state == 0 || second_node_state == 0 ) {
@@ -511,6 +556,36 @@ DensePDEdge::acknowledge_substitution(
 	);
 }
 
+/// @brief the two loops of project_deltaE_for_substitution, over the edges' float tables
+/// or over their compacted tables
+template < class EdgeTable >
+inline
+void
+DensePDNode::project_alt_state_two_body_energies( std::vector< EdgeTable > const & edge_tables )
+{
+	for ( int ii = 1; ii <= get_num_edges_to_smaller_indexed_nodes(); ++ii ) {
+
+		alternate_state_two_body_energies_[ ii ] =
+			DensePDEdge::get_alternate_state_energy(
+			neighbors_curr_state_[ii],
+			alternate_state_,
+			edge_table( edge_tables[ii] )
+		);
+		alternate_state_total_energy_ += alternate_state_two_body_energies_[ ii ];
+	}
+
+	for ( int ii = get_num_edges_to_smaller_indexed_nodes() + 1;
+			ii <= get_num_incident_edges(); ++ii ) {
+		alternate_state_two_body_energies_[ ii ] =
+			DensePDEdge::get_alternate_state_energy(
+			alternate_state_,
+			neighbors_curr_state_[ii],
+			edge_table( edge_tables[ii] )
+		);
+		alternate_state_total_energy_ += alternate_state_two_body_energies_[ ii ];
+	}
+}
+
 /// @brief returns the change in energy that would be induced by switching this node
 /// from its current state into another state
 ///
@@ -546,26 +621,10 @@ DensePDNode::project_deltaE_for_substitution(
 	prev_energy_for_node = curr_state_total_energy_;
 
 
-	for ( int ii = 1; ii <= get_num_edges_to_smaller_indexed_nodes(); ++ii ) {
-
-		alternate_state_two_body_energies_[ ii ] =
-			DensePDEdge::get_alternate_state_energy(
-			neighbors_curr_state_[ii],
-			alternate_state_,
-			edge_matrix_ptrs_[ii]
-		);
-		alternate_state_total_energy_ += alternate_state_two_body_energies_[ ii ];
-	}
-
-	for ( int ii = get_num_edges_to_smaller_indexed_nodes() + 1;
-			ii <= get_num_incident_edges(); ++ii ) {
-		alternate_state_two_body_energies_[ ii ] =
-			DensePDEdge::get_alternate_state_energy(
-			alternate_state_,
-			neighbors_curr_state_[ii],
-			edge_matrix_ptrs_[ii]
-		);
-		alternate_state_total_energy_ += alternate_state_two_body_energies_[ ii ];
+	if ( edge_tables_compacted_ ) {
+		project_alt_state_two_body_energies( compact_edge_tables_ );
+	} else {
+		project_alt_state_two_body_energies( edge_matrix_ptrs_ );
 	}
 
 	//std::cerr<< "..done" << std::endl;
@@ -187,7 +187,12 @@ InteractionGraphFactory::create_interaction_graph(
 						return double_lazy_ig;
 					} else {
 						T << "Instantiating PDInteractionGraph" << std::endl;
-						return utility::pointer::make_shared< PDInteractionGraph >( the_task.num_to_be_packed() );
+						PDInteractionGraphOP pdig( new PDInteractionGraph( the_task.num_to_be_packed() ) );
+						if ( the_task.ig_edge_storage() != "float" ) {
+							T << "Storing two-body energies as " << the_task.ig_edge_storage() << std::endl;
+							pdig->set_edge_energy_storage( edge_energy_storage_from_name( the_task.ig_edge_storage() ), the_task.ig_edge_clamp() );
+						}
+						return pdig;
 					}
 				}
 			}
@@ -210,7 +215,12 @@ InteractionGraphFactory::create_interaction_graph(
 	//This will also trigger if there are no rotamers
 
 	T << "Instantiating DensePDInteractionGraph" << std::endl;
-	return utility::pointer::make_shared< DensePDInteractionGraph >( the_task.num_to_be_packed() );
+	DensePDInteractionGraphOP dpdig( new DensePDInteractionGraph( the_task.num_to_be_packed() ) );
+	if ( the_task.ig_edge_storage() != "float" ) {
+		T << "Storing two-body energies as " << the_task.ig_edge_storage() << std::endl;
+		dpdig->set_edge_energy_storage( edge_energy_storage_from_name( the_task.ig_edge_storage() ), the_task.ig_edge_clamp() );
+	}
+	return dpdig;
 
 }
 
@@ -58,6 +58,7 @@ PDNode::PDNode(InteractionGraphBase * owner, int node_id, int num_states) :
 	num_states_for_aatype_( num_aa_types_, 0 ),
 	sparse_mat_info_for_state_( num_states + 1),
 	one_body_energies_(num_states + 1, 0.0f),
+	edge_tables_compacted_( false ),
 	current_state_( 0 ),
 	curr_state_total_energy_( 0.0 ),
 	alternate_state_is_being_considered_( false )
@@ -359,6 +360,12 @@ void PDNode::update_internal_vectors()
 	edge_matrix_ptrs_.reserve( get_num_incident_edges() + 1);
 	edge_matrix_ptrs_.emplace_back( ); //occupy the 0th position
 
+	// Edges hold their energies either as floats or compactly, as the owner graph directs;
+	// an edge without any two-body energies reads from an empty table, which is never indexed.
+	static CompactEnergyTable const empty_compact_table;
+	edge_tables_compacted_ = get_pdig_owner()->edge_energy_storage() != float_edge_storage;
+	compact_edge_tables_.assign( get_num_incident_edges() + 1, &empty_compact_table );
+
 	aa_offsets_for_edges_.dimension(
 		num_aa_types_, get_num_incident_edges(), num_aa_types_);
 	num_states_for_aa_type_for_higher_indexed_neighbor_.dimension(
@@ -379,7 +386,11 @@ void PDNode::update_internal_vectors()
 		// that's been default constructed (the default constructor just sets the internal pointers to NULL) to the
 		// edge_matrix_ptrs_. (ronj)
 		int edge_table_size = get_incident_pd_edge(ii)->get_two_body_table_size();
-		if ( edge_table_size != 0 ) {
+		if ( edge_tables_compacted_ ) {
+			CompactEnergyTable const * compact_table = get_incident_pd_edge(ii)->get_compact_edge_table();
+			if ( compact_table ) compact_edge_tables_[ ii ] = compact_table;
+			edge_matrix_ptrs_.emplace_back( );
+		} else if ( edge_table_size != 0 ) {
 			float & edge_table_ref = get_incident_pd_edge(ii)->get_edge_table_ptr();
 			edge_matrix_ptrs_.emplace_back( edge_table_ref );
 			edge_matrix_ptrs_[ii].dimension( edge_table_size );
@@ -511,6 +522,7 @@ PDNode::count_dynamic_memory() const
 	total_memory += neighbors_curr_state_.size() * sizeof( int );
 	total_memory += neighbors_curr_state_sparse_info_.size() * sizeof( SparseMatrixIndex );
 	total_memory += edge_matrix_ptrs_.size() * sizeof( ObjexxFCL::FArray1A< core::PackerEnergy > );
+	total_memory += compact_edge_tables_.size() * sizeof( CompactEnergyTable const * );
 
 	total_memory += curr_state_two_body_energies_.size() * sizeof( float );
 	total_memory += alternate_state_two_body_energies_.size() * sizeof( float );
@@ -813,6 +825,7 @@ PDEdge::~PDEdge() = default;
 ///
 void PDEdge::set_sparse_aa_info(ObjexxFCL::FArray2_bool const & sparse_conn_info)
 {
+	restore_two_body_energies();
 	two_body_energies_.set_sparse_aa_info( sparse_conn_info );
 	energies_updated_since_last_prep_for_simA_ = true;
 }
@@ -831,6 +844,7 @@ bool PDEdge::get_sparse_aa_info( int node1aa, int node2aa ) const
 ///
 void PDEdge::force_aa_neighbors(int node1aa, int node2aa)
 {
+	restore_two_body_energies();
 	two_body_energies_.force_aa_neighbors( node1aa, node2aa );
 	energies_updated_since_last_prep_for_simA_ = true;
 }
@@ -843,6 +857,7 @@ void PDEdge::force_aa_neighbors(int node1aa, int node2aa)
 ///
 void PDEdge::force_all_aa_neighbors()
 {
+	restore_two_body_energies();
 	two_body_energies_.force_all_aa_neighbors();
 	energies_updated_since_last_prep_for_simA_ = true;
 }
@@ -859,6 +874,7 @@ void PDEdge::add_to_two_body_energy
 	float const energy
 )
 {
+	restore_two_body_energies();
 	two_body_energies_.add(
 		get_pd_node(0)->get_sparse_mat_info_for_state(state1),
 		get_pd_node(1)->get_sparse_mat_info_for_state(state2),
@@ -880,6 +896,7 @@ void PDEdge::add_to_two_body_energies
 	ObjexxFCL::FArray2< core::PackerEnergy > const & res_res_energy_array
 )
 {
+	restore_two_body_energies();
 	for ( int ii = 1; ii <= get_num_states_for_node(0); ++ii ) {
 		SparseMatrixIndex const & state1_sparse_info = get_pd_node(0)
 			->get_sparse_mat_info_for_state( ii );
@@ -912,6 +929,7 @@ void PDEdge::set_two_body_energy
 	float const energy
 )
 {
+	restore_two_body_energies();
 	two_body_energies_.set(
 		get_pd_node(0)->get_sparse_mat_info_for_state(state1),
 		get_pd_node(1)->get_sparse_mat_info_for_state(state2),
@@ -935,6 +953,7 @@ void PDEdge::clear_two_body_energy
 	int const state2
 )
 {
+	restore_two_body_energies();
 	two_body_energies_.set(
 		get_pd_node(0)->get_sparse_mat_info_for_state(state1),
 		get_pd_node(1)->get_sparse_mat_info_for_state(state2),
@@ -952,6 +971,12 @@ void PDEdge::clear_two_body_energy
 ///
 float PDEdge::get_two_body_energy( int const state1, int const state2) const
 {
+	if ( ! compact_two_body_energies_.empty() ) {
+		return two_body_energies_.get(
+			get_pd_node(0)->get_sparse_mat_info_for_state(state1),
+			get_pd_node(1)->get_sparse_mat_info_for_state(state2),
+			compact_two_body_energies_ );
+	}
 	return two_body_energies_.get(
 		get_pd_node(0)->get_sparse_mat_info_for_state(state1),
 		get_pd_node(1)->get_sparse_mat_info_for_state(state2));
@@ -1038,6 +1063,11 @@ PDEdge::acknowledge_state_change
 
 	if (  one_node_in_zero_state ) {
 		curr_state_energy_ = 0;
+	} else if ( ! compact_two_body_energies_.empty() ) {
+		curr_state_energy_ = two_body_energies_.get(
+			nodes_curr_states_sparse_info[0],
+			nodes_curr_states_sparse_info[1],
+			compact_two_body_energies_ );
 	} else {
 		curr_state_energy_ = two_body_energies_.get(
 			nodes_curr_states_sparse_info[0],
@@ -1096,9 +1126,16 @@ PDEdge::get_second_node_num_states_per_aa()
 ///
 float & PDEdge::get_edge_table_ptr() {
 	//std::cout << "PDEdge: get_edge_table_ptr(): two_body_energies_.size(): " << two_body_energies_.get_table_size() << std::endl;
+	restore_two_body_energies();
 	return two_body_energies_.getMatrixPointer();
 }
 
+CompactEnergyTable const *
+PDEdge::get_compact_edge_table() const
+{
+	return compact_two_body_energies_.empty() ? nullptr : & compact_two_body_energies_;
+}
+
 unsigned int
 PDEdge::count_static_memory() const
 {
@@ -1109,7 +1146,11 @@ unsigned int
 PDEdge::count_dynamic_memory() const
 {
 	unsigned int total_memory = 0;
-	total_memory += two_body_energies_.get_table_size() * sizeof( int );
+	if ( two_body_energies_.values_released() ) {
+		total_memory += compact_two_body_energies_.memory_in_bytes();
+	} else {
+		total_memory += two_body_energies_.get_table_size() * sizeof( int );
+	}
 	total_memory += two_body_energies_.get_offset_table_size_in_bytes();
 	total_memory += EdgeBase::count_dynamic_memory();
 	return total_memory;
@@ -1121,6 +1162,9 @@ PDEdge::get_aa_submatrix_energies(
 	int node2aa
 ) const
 {
+	if ( ! compact_two_body_energies_.empty() ) {
+		return two_body_energies_.get_aa_submatrix_energies( node1aa, node2aa, compact_two_body_energies_ );
+	}
 	return two_body_energies_.get_aa_submatrix_energies( node1aa, node2aa );
 }
 
@@ -1137,7 +1181,11 @@ void
 PDEdge::set_edge_weight( Real weight )
 {
 	Real rescale = weight / edge_weight();
-	two_body_energies_.scale( rescale );
+	if ( ! compact_two_body_energies_.empty() ) {
+		compact_two_body_energies_.scale( rescale );
+	} else {
+		two_body_energies_.scale( rescale );
+	}
 	edge_weight( weight ); // set base-class data
 }
 
@@ -1377,12 +1425,39 @@ void PDEdge::declare_energies_final_no_deletion()
 /// @brief - allow derived class to prep this class for simA, but guarantee no call to delete this;
 void PDEdge::prepare_for_simulated_annealing_no_deletion() //hook for derived classes
 {
-	if ( ! energies_updated_since_last_prep_for_simA_ ) return;
+	if ( energies_updated_since_last_prep_for_simA_ ) {
+		//std::cout << "PDEdge: prepare_for_simulated_annealing_no_deletion(): two_body_energies table size before drop call: " << two_body_energies_.get_table_size() << std::endl;
+		two_body_energies_.drop_zero_submatrices_where_possible();
+		//std::cout << "PDEdge: prepare_for_simulated_annealing_no_deletion(): two_body_energies table size after drop call: " << two_body_energies_.get_table_size() << std::endl;
+		energies_updated_since_last_prep_for_simA_ = false;
+	}
+	update_two_body_energy_storage();
+}
+
+/// @details Called once the zero submatrices have been dropped, so only the retained
+/// submatrices are encoded.  Since declare_energies_final() prepares each edge as soon as
+/// its energies have been computed, at most one edge's float table needs to be held at
+/// once alongside the compacted tables.
+void PDEdge::update_two_body_energy_storage()
+{
+	EdgeEnergyStorage const storage = get_pdig_owner()->edge_energy_storage();
+	if ( storage == float_edge_storage ) {
+		restore_two_body_energies();
+		return;
+	}
+	if ( two_body_energies_.get_table_size() == 0 ) return;
+	if ( compact_two_body_energies_.storage() == storage ) return;
+
+	restore_two_body_energies();
+	compact_two_body_energies_.encode( storage, two_body_energies_.values(), get_pdig_owner()->edge_energy_clamp() );
+	two_body_energies_.release_values();
+}
 
-	//std::cout << "PDEdge: prepare_for_simulated_annealing_no_deletion(): two_body_energies table size before drop call: " << two_body_energies_.get_table_size() << std::endl;
-	two_body_energies_.drop_zero_submatrices_where_possible();
-	//std::cout << "PDEdge: prepare_for_simulated_annealing_no_deletion(): two_body_energies table size after drop call: " << two_body_energies_.get_table_size() << std::endl;
-	energies_updated_since_last_prep_for_simA_ = false;
+void PDEdge::restore_two_body_energies()
+{
+	if ( compact_two_body_energies_.empty() ) return;
+	two_body_energies_.restore_values( compact_two_body_energies_ );
+	compact_two_body_energies_.clear();
 }
 
 //// @brief - if edge table is empty, returns true -- assumes
@@ -1404,6 +1479,7 @@ bool PDEdge::pd_edge_table_all_zeros() const
 ///
 void PDEdge::drop_small_submatrices_where_possible( float epsilon )
 {
+	restore_two_body_energies();
 	two_body_energies_.drop_small_submatrices_where_possible( epsilon );
 	return;
 }
@@ -1438,9 +1514,18 @@ PDInteractionGraph::PDInteractionGraph(int num_nodes) :
 	num_aa_types_( -1 ), num_commits_since_last_update_(0),
 	total_energy_current_state_assignment_(0),
 	total_energy_alternate_state_assignment_(0),
-	node_considering_alt_state_( -1 )
+	node_considering_alt_state_( -1 ),
+	edge_energy_storage_( float_edge_storage ),
+	edge_energy_clamp_( 10.0 )
 {}
 
+void
+PDInteractionGraph::set_edge_energy_storage( EdgeEnergyStorage storage, core::PackerEnergy clamp )
+{
+	edge_energy_storage_ = storage;
+	edge_energy_clamp_ = clamp;
+}
+
 void
 PDInteractionGraph::initialize( pack_basic::RotamerSetsBase const & rot_sets_base )
 {
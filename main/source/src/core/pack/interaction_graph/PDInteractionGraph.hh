@@ -23,6 +23,7 @@
 #include <core/pack/interaction_graph/PrecomputedPairEnergiesInteractionGraph.hh>
 #include <core/pack/interaction_graph/SparseMatrixIndex.hh>
 #include <core/pack/interaction_graph/AminoAcidNeighborSparseMatrix.hh>
+#include <core/pack/interaction_graph/CompactEnergyTable.hh>
 
 #include <core/types.hh>
 
@@ -189,6 +190,20 @@ private:
 	inline
 	PDInteractionGraph * get_pdig_owner();
 
+	template < class EdgeTable >
+	inline
+	void project_alt_state_two_body_energies( std::vector< EdgeTable > const & edge_tables );
+
+	static
+	inline
+	ObjexxFCL::FArray1A< core::PackerEnergy > const &
+	edge_table( ObjexxFCL::FArray1A< core::PackerEnergy > const & table ) { return table; }
+
+	static
+	inline
+	CompactEnergyTable const &
+	edge_table( CompactEnergyTable const * table ) { return *table; }
+
 	int num_aa_types_;
 	utility::vector1< int > num_states_for_aatype_;
 	std::vector< SparseMatrixIndex > sparse_mat_info_for_state_;
@@ -199,6 +214,10 @@ private:
 	std::vector< int > neighbors_curr_state_;
 	std::vector< SparseMatrixIndex > neighbors_curr_state_sparse_info_;
 	std::vector< ObjexxFCL::FArray1A< core::PackerEnergy > > edge_matrix_ptrs_;
+	/// @brief the edges' compacted tables, used in place of edge_matrix_ptrs_ when the
+	/// graph holds its edge energies in one of the compact storage types
+	std::vector< CompactEnergyTable const * > compact_edge_tables_;
+	bool edge_tables_compacted_;
 
 
 	int current_state_;
@@ -261,6 +280,7 @@ public:
 	/// "unassigned" state.
 	void acknowledge_state_zeroed( int node_ind );
 
+	template < class Table >
 	static
 	inline
 	core::PackerEnergy get_alternate_state_energy_first_node(
@@ -270,9 +290,10 @@ public:
 		int first_node_state_offset_minus_1,
 		int second_node_curr_num_states_per_aatype,
 		int aa_neighbor_offset,
-		ObjexxFCL::FArray1< core::PackerEnergy > & edge_energy_table
+		Table const & edge_energy_table
 	);
 
+	template < class Table >
 	static
 	inline
 	core::PackerEnergy get_alternate_state_energy_second_node(
@@ -282,7 +303,7 @@ public:
 		SparseMatrixIndex const & second_node_alternate_state_sparse_info,
 		int second_node_alt_state_num_states_per_aatype,
 		int aa_neighbor_offset,
-		ObjexxFCL::FArray1< core::PackerEnergy > & edge_energy_table
+		Table const & edge_energy_table
 	);
 
 	inline void acknowledge_substitution(
@@ -304,6 +325,10 @@ public:
 	int get_two_body_table_size() const;
 	core::PackerEnergy & get_edge_table_ptr();
 
+	/// @brief The compacted copy of the two-body energy table, or 0 if the edge holds its
+	/// energies as floats.  Used in place of get_edge_table_ptr() by the nodes.
+	CompactEnergyTable const * get_compact_edge_table() const;
+
 	unsigned int count_static_memory() const override;
 	unsigned int count_dynamic_memory() const override;
 
@@ -321,10 +346,18 @@ protected:
 	void declare_energies_final_no_deletion();
 	void prepare_for_simulated_annealing_no_deletion();
 	bool pd_edge_table_all_zeros() const;
-	AminoAcidNeighborSparseMatrix< core::PackerEnergy > & two_body_energies() { return two_body_energies_; }
+	AminoAcidNeighborSparseMatrix< core::PackerEnergy > & two_body_energies() { restore_two_body_energies(); return two_body_energies_; }
 
 private:
 
+	/// @brief Encode the two-body energies in the owner's edge-energy storage type and
+	/// release the float table, or restore the float table if the owner asks for floats.
+	void update_two_body_energy_storage();
+
+	/// @brief If the energies are held compactly, restore the float table so that it
+	/// may be modified; called by every method that writes to the table.
+	void restore_two_body_energies();
+
 	inline
 	PDNode const * get_pd_node( int index ) const;
 
@@ -343,6 +376,7 @@ private:
 private: // Data
 
 	AminoAcidNeighborSparseMatrix< core::PackerEnergy > two_body_energies_;
+	CompactEnergyTable compact_two_body_energies_;
 	core::PackerEnergy curr_state_energy_;
 	bool energies_updated_since_last_prep_for_simA_;
 
@@ -390,6 +424,14 @@ public:
 	virtual unsigned int count_static_memory() const;
 	virtual unsigned int count_dynamic_memory() const;
 
+	/// @brief Hold the edges' two-body energies in the given storage type during simulated
+	/// annealing; the fixed-point types clamp energies to [-clamp, clamp].  Edges compact
+	/// their tables as their energies are declared final, so this should be set before the
+	/// energies are computed; set it later and the tables are converted when the graph is
+	/// next prepared for simulated annealing.
+	void set_edge_energy_storage( EdgeEnergyStorage storage, core::PackerEnergy clamp = 10.0 );
+	EdgeEnergyStorage edge_energy_storage() const { return edge_energy_storage_; }
+	core::PackerEnergy edge_energy_clamp() const { return edge_energy_clamp_; }
 
 	/*
 	//Methods for I/O
@@ -491,6 +533,8 @@ private:
 	core::PackerEnergy total_energy_alternate_state_assignment_;
 	int node_considering_alt_state_;
 
+	EdgeEnergyStorage edge_energy_storage_;
+	core::PackerEnergy edge_energy_clamp_;
 
 	//variables for I/O
 	int num_nodes_in_file_;
@@ -579,8 +623,9 @@ PDEdge::get_pdig_owner()
 /// @param aa_neighbor_offset - [in] - offset for the amino-acid neighbor pair for
 ///    the sparse two-body energy table
 /// @param edge_energy_table - [in] - the proxy FArray pointing at the edge table
-///   connecting the two nodes.
+///   connecting the two nodes, or the edge's CompactEnergyTable.
 ///
+template < class Table >
 inline
 float
 PDEdge::get_alternate_state_energy_first_node(
@@ -590,7 +635,7 @@ PDEdge::get_alternate_state_energy_first_node(
 	int first_node_state_offset_minus_1,
 	int second_node_curr_num_states_per_aatype,
 	int aa_neighbor_offset,
-	ObjexxFCL::FArray1< core::PackerEnergy > & edge_energy_table
+	Table const & edge_energy_table
 )
 {
 
@@ -655,8 +700,9 @@ PDEdge::acknowledge_substitution(
 /// @param aa_neighbor_offset - [in] - offset for the amino-acid neighbor pair for
 ///   the sparse two-body energy table
 /// @param edge_energy_table - [in] - the proxy FArray pointing at the edge table
-///   connecting the two nodes.
+///   connecting the two nodes, or the edge's CompactEnergyTable.
 ///
+template < class Table >
 inline
 float
 PDEdge::get_alternate_state_energy_second_node(
@@ -666,7 +712,7 @@ PDEdge::get_alternate_state_energy_second_node(
 	SparseMatrixIndex const & second_node_alternate_state_sparse_info,
 	int second_node_alt_state_num_states_per_aatype,
 	int aa_neighbor_offset,
-	ObjexxFCL::FArray1< core::PackerEnergy > & edge_energy_table
+	Table const & edge_energy_table
 )
 {
 
@@ -710,37 +756,13 @@ void PDNode::acknowledge_neighbors_state_substitution(
 	return;
 }
 
-/// @detais iterates across the incident edges for a node in two phases:
-/// in the first phase, it examines edges leading to higher-indexed nodes
-/// in the second phase, it examines edges leading to smaller-indexed nodes.
-/// for cache efficiency, all of the amino-acid-neighbor-offset information
-/// that each edge calculates is stored on the nodes themselves.  The edges
-/// are never touched; rather, their private information is stored on the nodes
-/// and handed to static member functions of the PDEdge class.  This "store
-/// edge information on the nodes" strategy gives me performance equivalent
-/// to the previous energy2b lookup tables.
-///
-/// @param alternate_state - [in] - the alternate state to consider
-/// @param previous_energy_for_node - [out] - the old energy1b/energy2b sum for this
-/// node; used by simulate annealing.
+/// @brief the two loops of project_deltaE_for_substitution, over the edges' float tables
+/// or over their compacted tables
+template < class EdgeTable >
 inline
-float
-PDNode::project_deltaE_for_substitution(
-	int alternate_state,
-	float & prev_energy_for_node
-)
+void
+PDNode::project_alt_state_two_body_energies( std::vector< EdgeTable > const & edge_tables )
 {
-
-	alternate_state_is_being_considered_ = true;
-	//std::cout << "proj_deltaE: node -  " << get_node_index() << " alt state " << alternate_state << "...";
-
-	alternate_state_ = alternate_state;
-	alt_state_sparse_mat_info_ = sparse_mat_info_for_state_[ alternate_state];
-	alternate_state_one_body_energy_ = one_body_energies_[ alternate_state ];
-	//std::cout << "alternate_state_one_body_energy_: " << alternate_state_one_body_energy_ << std::endl;
-	alternate_state_total_energy_ = alternate_state_one_body_energy_;
-	prev_energy_for_node = curr_state_total_energy_;
-
 	int alt_state_num_states_per_aa_type =
 		num_states_for_aatype_[ alt_state_sparse_mat_info_.get_aa_type() ];
 	int alt_state_for_aa_type_minus_1 =
@@ -766,7 +788,7 @@ PDNode::project_deltaE_for_substitution(
 			aa_neighb_linear_index_offset +
 			neighbors_curr_state_sparse_info_[ii].get_aa_type()
 			],
-			edge_matrix_ptrs_[ii]
+			edge_table( edge_tables[ii] )
 		);
 		alternate_state_total_energy_ += alternate_state_two_body_energies_[ ii ];
 		//if ( alternate_state_two_body_energies_[ ii ] != 0.0 ) {
@@ -795,13 +817,51 @@ PDNode::project_deltaE_for_substitution(
 			aa_neighb_linear_index_offset +
 			neighbors_curr_state_sparse_info_[ii].get_aa_type()
 			],
-			edge_matrix_ptrs_[ii]
+			edge_table( edge_tables[ii] )
 		);
 		alternate_state_total_energy_ += alternate_state_two_body_energies_[ ii ];
 		//if ( alternate_state_two_body_energies_[ ii ] != 0.0 ) {
 		// std::cout << "( " << get_index_of_adjacent_node( ii ) << " , " << alternate_state_two_body_energies_[ ii ] <<" ) ";
 		//}
 	}
+}
+
+/// @detais iterates across the incident edges for a node in two phases:
+/// in the first phase, it examines edges leading to higher-indexed nodes
+/// in the second phase, it examines edges leading to smaller-indexed nodes.
+/// for cache efficiency, all of the amino-acid-neighbor-offset information
+/// that each edge calculates is stored on the nodes themselves.  The edges
+/// are never touched; rather, their private information is stored on the nodes
+/// and handed to static member functions of the PDEdge class.  This "store
+/// edge information on the nodes" strategy gives me performance equivalent
+/// to the previous energy2b lookup tables.
+///
+/// @param alternate_state - [in] - the alternate state to consider
+/// @param previous_energy_for_node - [out] - the old energy1b/energy2b sum for this
+/// node; used by simulate annealing.
+inline
+float
+PDNode::project_deltaE_for_substitution(
+	int alternate_state,
+	float & prev_energy_for_node
+)
+{
+
+	alternate_state_is_being_considered_ = true;
+	//std::cout << "proj_deltaE: node -  " << get_node_index() << " alt state " << alternate_state << "...";
+
+	alternate_state_ = alternate_state;
+	alt_state_sparse_mat_info_ = sparse_mat_info_for_state_[ alternate_state];
+	alternate_state_one_body_energy_ = one_body_energies_[ alternate_state ];
+	//std::cout << "alternate_state_one_body_energy_: " << alternate_state_one_body_energy_ << std::endl;
+	alternate_state_total_energy_ = alternate_state_one_body_energy_;
+	prev_energy_for_node = curr_state_total_energy_;
+
+	if ( edge_tables_compacted_ ) {
+		project_alt_state_two_body_energies( compact_edge_tables_ );
+	} else {
+		project_alt_state_two_body_energies( edge_matrix_ptrs_ );
+	}
 
 	//std::cerr<< "..done" << std::endl;
 
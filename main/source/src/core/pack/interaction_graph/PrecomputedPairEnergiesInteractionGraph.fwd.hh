@@ -21,6 +21,8 @@ namespace core {
 namespace pack {
 namespace interaction_graph {
 
+class PrecomputedPairEnergiesNode;
+class PrecomputedPairEnergiesEdge;
 class PrecomputedPairEnergiesInteractionGraph;
 
 typedef utility::pointer::shared_ptr< PrecomputedPairEnergiesInteractionGraph > PrecomputedPairEnergiesInteractionGraphOP;
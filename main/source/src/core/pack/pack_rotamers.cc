@@ -24,8 +24,13 @@
 
 #include <core/pack/annealer/AnnealerFactory.hh>
 #include <core/pack/annealer/SimAnnealerBase.hh>
+#include <core/pack/annealer/MultiTrajectorySimAnnealer.hh>
 #include <core/pack/interaction_graph/InteractionGraphFactory.hh>
 #include <core/pack/interaction_graph/AnnealableGraphBase.hh>
+#include <core/pack/interaction_graph/PrecomputedPairEnergiesInteractionGraph.hh>
+#include <core/pack/interaction_graph/PDInteractionGraph.hh>
+#include <core/pack/interaction_graph/DensePDInteractionGraph.hh>
+#include <core/pack/interaction_graph/DoubleDensePDInteractionGraph.hh>
 
 //#include <core/kinematics/FoldTree.hh>
 //#include <core/kinematics/Jump.hh>
@@ -52,6 +57,10 @@
 #include <utility/vector0.hh>
 #include <utility/vector1.hh>
 
+// C++ headers
+#include <algorithm>
+#include <typeinfo>
+
 using namespace ObjexxFCL;
 
 namespace core {
@@ -312,6 +321,91 @@ pack_rotamers_run(
 	PROF_STOP( basic::SIMANNEALING );
 }
 
+/// @details Checks the exact type: the surface, hpatch and NPD-hbond graphs derive from these
+/// classes but add energies that are not pairwise, which the shared-graph annealer would drop.
+bool
+graph_supports_multiple_trajectory_annealer( interaction_graph::AnnealableGraphBase const & ig ) {
+	using namespace interaction_graph;
+	std::type_info const & type( typeid( ig ) );
+	return type == typeid( PDInteractionGraph ) || type == typeid( DensePDInteractionGraph )
+		|| type == typeid( DoubleDensePDInteractionGraph );
+}
+
+/// @details The fallback path (special annealers, graphs with energies that are not pairwise,
+/// or graphs that compute energies on the fly) reruns pack_rotamers_run on the same graph,
+/// so it too fills the graph only once.
+void
+pack_rotamers_run_multiple_trajectories(
+	pose::Pose const & pose,
+	task::PackerTaskCOP task,
+	rotamer_set::FixbbRotamerSetsCOP rotsets,
+	interaction_graph::AnnealableGraphBaseOP ig,
+	Size const n_trajectories,
+	Size const n_best,
+	bool const replica_exchange,
+	utility::vector1< std::pair< core::PackerEnergy, ObjexxFCL::FArray1D_int > > & results
+)
+{
+	using namespace annealer;
+	using namespace interaction_graph;
+
+	results.clear();
+
+	PrecomputedPairEnergiesInteractionGraphOP pd_ig;
+	if ( graph_supports_multiple_trajectory_annealer( *ig ) ) {
+		pd_ig = utility::pointer::dynamic_pointer_cast< PrecomputedPairEnergiesInteractionGraph >( ig );
+	}
+	bool const special_annealer = task->keep_sequence_symmetry() || task->rotamer_couplings_exist()
+		|| task->rotamer_links_exist() || task->multi_cool_annealer();
+
+	if ( pd_ig && ! special_annealer ) {
+		utility::vector0< int > rot_to_pack;
+		FArray1D_int bestrotamer_at_seqpos( pose.size() );
+		core::PackerEnergy bestenergy( 0.0 );
+		FArray1D_int current_rot_index( pose.size(), 0 );
+		FArray1D< core::PackerEnergy > rot_freq( ig->get_num_total_states(), 0.0 );
+
+		MultiTrajectorySimAnnealer annealer( rot_to_pack, bestrotamer_at_seqpos, bestenergy, false,
+			pd_ig, rotsets, current_rot_index, false, rot_freq );
+		if ( task->low_temp()  > 0.0 ) annealer.set_lowtemp(  task->low_temp()  );
+		if ( task->high_temp() > 0.0 ) annealer.set_hightemp( task->high_temp() );
+		annealer.set_disallow_quench( task->disallow_quench() );
+		annealer.n_trajectories( n_trajectories );
+		annealer.n_best( n_best );
+		annealer.replica_exchange( replica_exchange );
+
+		PROF_START( basic::SIMANNEALING );
+		annealer.run();
+		PROF_STOP( basic::SIMANNEALING );
+
+		for ( MultiTrajectorySimAnnealer::Assignment const & assignment : annealer.best_assignments() ) {
+			results.push_back( std::make_pair( assignment.energy, assignment.rotamer_at_seqpos ) );
+		}
+		return;
+	}
+
+	if ( replica_exchange ) {
+		tt.Warning << "Replica exchange needs a graph of precomputed, purely pairwise energies and a task without "
+			"sequence symmetry, rotamer couplings, rotamer links or the multi-cool annealer; "
+			"running independent trajectories instead." << std::endl;
+	}
+	for ( Size ii = 1; ii <= n_trajectories; ++ii ) {
+		FArray1D_int bestrotamer_at_seqpos( pose.size() );
+		core::PackerEnergy bestenergy( 0.0 );
+		pack_rotamers_run( pose, task, rotsets, ig, utility::vector0< int >(), bestrotamer_at_seqpos, bestenergy );
+		bool duplicate = false;
+		for ( auto const & result : results ) {
+			if ( result.second == bestrotamer_at_seqpos ) { duplicate = true; break; }
+		}
+		if ( ! duplicate ) results.push_back( std::make_pair( bestenergy, bestrotamer_at_seqpos ) );
+	}
+	std::stable_sort( results.begin(), results.end(),
+		[]( std::pair< core::PackerEnergy, FArray1D_int > const & a, std::pair< core::PackerEnergy, FArray1D_int > const & b ) {
+		return a.first < b.first;
+		} );
+	if ( results.size() > n_best ) results.resize( n_best );
+}
+
 /// @brief Provide the opportunity to clean up cached data from the pose or scorefunction after packing.
 /// @details This should be called after pack_rotamers_run.  It is called from the pack_rotamers() function.
 /// @author Vikram K. Mulligan (vmullig@uw.edu).
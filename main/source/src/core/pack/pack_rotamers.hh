@@ -118,6 +118,31 @@ pack_rotamers_run(
 	core::PackerEnergy & bestenergy
 );
 
+/// @brief Can the trajectories of pack_rotamers_run_multiple_trajectories() share this graph?
+/// True only for the graphs of purely pairwise, precomputed energies (PDInteractionGraph,
+/// DensePDInteractionGraph and DoubleDensePDInteractionGraph).
+bool
+graph_supports_multiple_trajectory_annealer( interaction_graph::AnnealableGraphBase const & ig );
+
+/// @brief Run n_trajectories annealing trajectories over one interaction graph and return
+/// up to n_best distinct rotamer assignments with their energies, lowest energy first.
+/// This function does not modify the input pose.
+/// @details With a graph of precomputed, purely pairwise energies and a task that needs no special
+/// annealer, the trajectories share the graph and run in parallel (see
+/// annealer::MultiTrajectorySimAnnealer), independently or as replica exchange.  Otherwise
+/// the task's usual annealer is run n_trajectories times in turn.
+void
+pack_rotamers_run_multiple_trajectories(
+	pose::Pose const & pose,
+	task::PackerTaskCOP task,
+	rotamer_set::FixbbRotamerSetsCOP rotsets,
+	interaction_graph::AnnealableGraphBaseOP ig,
+	Size const n_trajectories,
+	Size const n_best,
+	bool const replica_exchange,
+	utility::vector1< std::pair< core::PackerEnergy, ObjexxFCL::FArray1D_int > > & results
+);
+
 /// @brief Provide the opportunity to clean up cached data from the pose or scorefunction after packing.
 /// @details This should be called after pack_rotamers_run.  It is called from the pack_rotamers() function.
 /// @author Vikram K. Mulligan (vmullig@uw.edu).
@@ -49,6 +49,7 @@
 #include <basic/Tracer.hh>
 
 // C++
+#include <algorithm>
 #include <fstream>
 #include <ctime>
 
@@ -56,9 +57,18 @@
 #include <ObjexxFCL/FArray2D.hh>
 
 #include <utility/vector1.hh>
+
 #include <basic/options/option.hh>
 #include <basic/options/keys/packing.OptionKeys.gen.hh>
 
+#ifdef MULTI_THREADED
+#include <basic/options/keys/multithreading.OptionKeys.gen.hh>
+#include <basic/thread_manager/RosettaThreadManager.hh>
+#include <utility/pointer/memory.hh>
+#include <functional>
+#include <mutex>
+#endif
+
 
 static basic::Tracer TR( "core.pack.rotamer_set.RotamerSets", basic::t_info );
 
@@ -500,9 +510,12 @@ RotamerSets::precompute_two_body_energies(
 	//std::clock_t starttime = clock();
 
 	// Two body energies
+	// First, collect the short-ranged edges.  The pair energy tables for these are independent of
+	// one another and can be filled in any order (or concurrently); they are then added to the
+	// interaction graph in this fixed order so that the result does not depend on the thread count.
 	//scoring::EnergyGraph const & energy_graph( pose.energies().energy_graph() );
+	utility::vector1< std::pair< uint, uint > > sr_edges;
 	for ( uint ii = 1; ii <= nmoltenres_; ++ ii ) {
-		//tt << "pairenergies for ii: " << ii << '\n';
 		uint const ii_resid = moltenres_2_resid_[ ii ];
 		//when design comes online, we will want to iterate across
 		//neighbors defined by a larger interaction cutoff
@@ -513,26 +526,80 @@ RotamerSets::precompute_two_body_energies(
 			uint const jj_resid = (*uli)->get_second_node_ind();
 			uint const jj = resid_2_moltenres_[ jj_resid ]; //pretend we're iterating over jj >= ii
 			if ( jj == 0 ) continue; // Andrew, remove this magic number!
+			sr_edges.push_back( std::make_pair( ii, jj ) );
+		}
+	}
 
-			FArray2D< core::PackerEnergy > pair_energy_table(
-				nrotamers_for_moltenres_[ jj ],
-				nrotamers_for_moltenres_[ ii ], 0.0 );
-
-			RotamerSetCOP ii_rotset = set_of_rotamer_sets_[ ii ];
-			RotamerSetCOP jj_rotset = set_of_rotamer_sets_[ jj ];
-
-			scfxn.evaluate_rotamer_pair_energies(
-				*ii_rotset, *jj_rotset, pose, pair_energy_table );
+	auto add_sr_edge = [&]( Size const ee, FArray2D< core::PackerEnergy > & pair_energy_table ) {
+		uint const ii = sr_edges[ ee ].first;
+		uint const jj = sr_edges[ ee ].second;
 
-			pig->add_edge( ii, jj );
-			pig->add_to_two_body_energies_for_edge( ii, jj, pair_energy_table );
+		pig->add_edge( ii, jj );
+		pig->add_to_two_body_energies_for_edge( ii, jj, pair_energy_table );
+		pair_energy_table.clear(); // release the table as soon as the graph has its copy
 
-			if ( finalize_edges && ! scfxn.any_lr_residue_pair_energy(pose, ii, jj) ) {
-				pig->declare_edge_energies_final( ii, jj );
+		if ( finalize_edges && ! scfxn.any_lr_residue_pair_energy(pose, ii, jj) ) {
+			pig->declare_edge_energies_final( ii, jj );
+		}
+	};
+
+#ifdef MULTI_THREADED
+	{
+		using namespace basic::options;
+		using namespace basic::options::OptionKeys;
+
+		Size nthreads( option[ multithreading::interaction_graph_threads ]() );
+		if ( nthreads == 0 ) nthreads = option[ multithreading::total_threads ]();
+
+		// Energy methods keep per-pair state in mutable members while they score a rotamer pair
+		// (e.g. HBondEnergy's residue ids and neighbor counts, EtableEnergy's evaluators), so no two
+		// threads may score with the same ScoreFunction.  Each work unit borrows a clone from a
+		// pool of at most nthreads of them and returns it when done.
+		utility::vector1< ScoreFunctionOP > idle_scfxns;
+		std::mutex idle_scfxns_mutex;
+		auto compute_sr_edge = [&]( Size const ee, FArray2D< core::PackerEnergy > & pair_energy_table ) {
+			ScoreFunctionOP edge_scfxn;
+			{
+				std::lock_guard< std::mutex > lock( idle_scfxns_mutex );
+				if ( ! idle_scfxns.empty() ) {
+					edge_scfxn = idle_scfxns.back();
+					idle_scfxns.pop_back();
+				}
 			}
+			if ( ! edge_scfxn ) edge_scfxn = scfxn.clone();
+			compute_two_body_energy_table_for_edge( pose, *edge_scfxn, sr_edges[ ee ].first, sr_edges[ ee ].second, pair_energy_table );
+			std::lock_guard< std::mutex > lock( idle_scfxns_mutex );
+			idle_scfxns.push_back( edge_scfxn );
+		};
+
+		// Fill the tables a bounded chunk at a time, so that no more than chunk_size tables are
+		// held outside of the interaction graph at once.
+		Size const chunk_size( 4 * std::max< Size >( nthreads, 1 ) );
+		utility::vector1< FArray2D< core::PackerEnergy > > pair_energy_tables;
+		utility::vector1< basic::thread_manager::RosettaThreadFunctionOP > work_vector;
+		for ( Size chunk_begin = 1; chunk_begin <= sr_edges.size(); chunk_begin += chunk_size ) {
+			Size const chunk_end( std::min( sr_edges.size(), chunk_begin + chunk_size - 1 ) );
+			pair_energy_tables.resize( chunk_end - chunk_begin + 1 );
+			work_vector.clear();
+			for ( Size ee = chunk_begin; ee <= chunk_end; ++ee ) {
+				work_vector.push_back( utility::pointer::make_shared< basic::thread_manager::RosettaThreadFunction >(
+					std::bind( compute_sr_edge, ee, std::ref( pair_energy_tables[ ee - chunk_begin + 1 ] ) ) ) );
+			}
+			basic::thread_manager::RosettaThreadManager::get_instance()->do_work_vector_in_threads( work_vector, nthreads );
 
+			for ( Size ee = chunk_begin; ee <= chunk_end; ++ee ) {
+				add_sr_edge( ee, pair_energy_tables[ ee - chunk_begin + 1 ] );
+			}
 		}
 	}
+#else
+	// Serially, each table goes into the graph as soon as it is computed.
+	FArray2D< core::PackerEnergy > pair_energy_table;
+	for ( Size ee = 1; ee <= sr_edges.size(); ++ee ) {
+		compute_two_body_energy_table_for_edge( pose, scfxn, sr_edges[ ee ].first, sr_edges[ ee ].second, pair_energy_table );
+		add_sr_edge( ee, pair_energy_table );
+	}
+#endif
 
 	// Iterate across the long range energy functions and use the iterators generated
 	// by the LRnergy container object
@@ -580,6 +647,25 @@ RotamerSets::precompute_two_body_energies(
 	//std::cout << "Precompute rotamer pair energies took " << ((double) stoptime - starttime)/CLOCKS_PER_SEC << " seconds" << std::endl;
 }
 
+void
+RotamerSets::compute_two_body_energy_table_for_edge(
+	pose::Pose const & pose,
+	scoring::ScoreFunction const & scfxn,
+	uint const ii,
+	uint const jj,
+	FArray2D< core::PackerEnergy > & pair_energy_table
+) const
+{
+	pair_energy_table.dimension( nrotamers_for_moltenres_[ jj ], nrotamers_for_moltenres_[ ii ] );
+	pair_energy_table = 0.0;
+
+	RotamerSetCOP ii_rotset = set_of_rotamer_sets_[ ii ];
+	RotamerSetCOP jj_rotset = set_of_rotamer_sets_[ jj ];
+
+	scfxn.evaluate_rotamer_pair_energies(
+		*ii_rotset, *jj_rotset, pose, pair_energy_table );
+}
+
 void
 RotamerSets::prepare_otf_graph(
 	pose::Pose const & pose,
@@ -43,6 +43,9 @@
 
 #include <utility/vector1.hh>
 
+// ObjexxFCL Headers
+#include <ObjexxFCL/FArray2D.fwd.hh>
+
 
 #ifdef    SERIALIZATION
 // Cereal headers
@@ -223,6 +226,19 @@ public:
 	);
 
 private:
+	/// @brief Fill the rotamer pair energy table for the (short-ranged) edge between molten
+	/// residues ii and jj.
+	/// @details Writes only to the table passed in, so calls for different edges may safely run
+	/// concurrently.  Used as the unit of work when the two-body energies are precomputed in threads.
+	void
+	compute_two_body_energy_table_for_edge(
+		pose::Pose const & pose,
+		scoring::ScoreFunction const & scfxn,
+		uint const ii,
+		uint const jj,
+		ObjexxFCL::FArray2D< core::PackerEnergy > & pair_energy_table
+	) const;
+
 	/// @brief Marks all protein vertices in the on-the-fly interaction graph as ones
 	/// that should distinguish between the backbones and sidechains.  Then, adds edges to
 	/// the on-the-fly interaction graph between neighboring RotamerSets,
@@ -137,6 +137,12 @@ public:
 	virtual void decrease_double_lazy_ig_memlimit( Size nbytes_for_rpes ) = 0;
 	virtual Size double_lazy_ig_memlimit() const = 0;
 
+	/// @brief Store the two-body energies of the precomputed interaction graphs as "float",
+	/// "half", "fixed16" or "fixed8", clamping to [-clamp, clamp] for the fixed-point types
+	virtual void set_ig_edge_storage( std::string const & storage, Real clamp ) = 0;
+	virtual std::string const & ig_edge_storage() const = 0;
+	virtual Real ig_edge_clamp() const = 0;
+
 	virtual void or_multi_cool_annealer( bool setting ) = 0;
 	virtual bool multi_cool_annealer() const = 0;
 
@@ -143,6 +143,11 @@ PackerTask_::update_commutative(
 	double_lazy_ig_ |= o.double_lazy_ig_;
 	dlig_mem_limit_ = std::min( dlig_mem_limit_, o.dlig_mem_limit_ );
 
+	if ( o.ig_edge_storage_ != "float" ) {
+		ig_edge_storage_ = o.ig_edge_storage_;
+		ig_edge_clamp_ = o.ig_edge_clamp_;
+	}
+
 	multi_cool_annealer_ |= o.multi_cool_annealer_;
 	mca_history_size_ = std::max( mca_history_size_, o.mca_history_size_ );
 
@@ -533,6 +538,28 @@ Size PackerTask_::double_lazy_ig_memlimit() const
 	return dlig_mem_limit_;
 }
 
+void PackerTask_::set_ig_edge_storage( std::string const & storage, Real clamp )
+{
+	if ( storage != "float" && storage != "half" && storage != "fixed16" && storage != "fixed8" ) {
+		utility_exit_with_message( "Unrecognized interaction-graph edge storage \"" + storage + "\"; expected float, half, fixed16 or fixed8" );
+	}
+	if ( clamp <= 0 ) {
+		utility_exit_with_message( "The interaction-graph edge-energy clamp must be positive" );
+	}
+	ig_edge_storage_ = storage;
+	ig_edge_clamp_ = clamp;
+}
+
+std::string const & PackerTask_::ig_edge_storage() const
+{
+	return ig_edge_storage_;
+}
+
+Real PackerTask_::ig_edge_clamp() const
+{
+	return ig_edge_clamp_;
+}
+
 /// @brief read only the command line options for extra rotamer building;
 PackerTask &
 PackerTask_::initialize_extra_rotamer_flags_from_command_line()
@@ -693,6 +720,9 @@ PackerTask_::initialize_from_options( utility::options::OptionCollection const &
 	if ( options[ packing::double_lazy_ig ] && ! optimize_H_ ) {
 		or_double_lazy_ig( true );
 	}
+	if ( options[ packing::ig_edge_storage ].user() ) {
+		set_ig_edge_storage( options[ packing::ig_edge_storage ], options[ packing::ig_edge_clamp ] );
+	}
 	if ( options[ packing::multi_cool_annealer ].user()  ) {
 		or_multi_cool_annealer( true );
 		increase_multi_cool_annealer_history_size( options[ packing::multi_cool_annealer ] );
@@ -751,6 +781,8 @@ PackerTask::list_options_read( utility::options::OptionKeyList & read_options )
 		+ packing::linmem_ig
 		+ packing::lazy_ig
 		+ packing::double_lazy_ig
+		+ packing::ig_edge_storage
+		+ packing::ig_edge_clamp
 		+ packing::multi_cool_annealer
 		+ packing::sequence_symmetric_annealer
 		+ packing::fix_his_tautomer
@@ -1128,6 +1160,8 @@ core::pack::task::PackerTask_::save( Archive & arc ) const {
 	arc( CEREAL_NVP( lazy_ig_ ) ); // _Bool
 	arc( CEREAL_NVP( double_lazy_ig_ ) ); // _Bool
 	arc( CEREAL_NVP( dlig_mem_limit_ ) ); // Size
+	arc( CEREAL_NVP( ig_edge_storage_ ) ); // std::string
+	arc( CEREAL_NVP( ig_edge_clamp_ ) ); // Real
 	arc( CEREAL_NVP( multi_cool_annealer_ ) ); // _Bool
 	arc( CEREAL_NVP( keep_sequence_symmetry_ ) ); // _Bool
 	arc( CEREAL_NVP( mca_history_size_ ) ); // Size
@@ -1162,6 +1196,8 @@ core::pack::task::PackerTask_::load( Archive & arc ) {
 	arc( lazy_ig_ ); // _Bool
 	arc( double_lazy_ig_ ); // _Bool
 	arc( dlig_mem_limit_ ); // Size
+	arc( ig_edge_storage_ ); // std::string
+	arc( ig_edge_clamp_ ); // Real
 	arc( multi_cool_annealer_ ); // _Bool
 	arc( keep_sequence_symmetry_ ); // _Bool
 	arc( mca_history_size_ ); // Size
@@ -194,6 +194,17 @@ public:
 	/// signifies an unrestricted limit.
 	virtual Size double_lazy_ig_memlimit() const;
 
+	/// @brief Have the PDInteractionGraph and DensePDInteractionGraph hold their two-body
+	/// energies in 16-bit floats ("half") or 16- or 8-bit fixed point ("fixed16", "fixed8")
+	/// instead of 32-bit floats ("float", the default) during simulated annealing.  The
+	/// fixed-point types clamp energies to [-clamp, clamp].  Other interaction graphs ignore
+	/// this setting.
+	virtual void set_ig_edge_storage( std::string const & storage, Real clamp );
+	/// @brief the edge-energy storage type for the precomputed interaction graphs
+	virtual std::string const & ig_edge_storage() const;
+	/// @brief the clamp for the fixed-point edge-energy storage types
+	virtual Real ig_edge_clamp() const;
+
 
 	/// @brief if setting == true, turns on MultiCoolAnnealer -- so long as rotamer couplings are not
 	///also turned on.
@@ -481,6 +492,9 @@ private:
 	bool double_lazy_ig_ = false;
 	Size dlig_mem_limit_ = 0;
 
+	std::string ig_edge_storage_ = "float";
+	Real ig_edge_clamp_ = 10.0;
+
 	bool multi_cool_annealer_ = false;
 	Size mca_history_size_ = 1;
 
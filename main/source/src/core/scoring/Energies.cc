@@ -35,6 +35,7 @@
 
 // Project Headers
 #include <core/conformation/PointGraph.hh>
+#include <core/conformation/PointHash.hh>
 #include <core/conformation/find_neighbors.hh>
 
 #include <core/pose/Pose.hh>
@@ -45,6 +46,9 @@
 // ObjexxFCL headers
 #include <ObjexxFCL/format.hh>
 
+// C++ headers
+#include <typeinfo>
+
 // Numeric headers
 #include <numeric/numeric.functions.hh>
 
@@ -52,6 +56,10 @@
 #include <utility/exit.hh>
 #include <utility/string_util.hh>
 
+// C++ headers
+#include <algorithm>
+#include <map>
+
 //Auto Headers
 #include <utility/vector1.hh>
 //Auto Headers
@@ -62,6 +70,7 @@
 
 #include <basic/options/option.hh>
 #include <basic/options/keys/docking.OptionKeys.gen.hh>
+#include <basic/options/keys/score.OptionKeys.gen.hh>
 
 
 static basic::Tracer tr( "core.scoring.Energies" );
@@ -107,7 +116,8 @@ Energies::Energies()
 	energy_state_( BAD ),
 	graph_state_( BAD ),
 	data_cache_( EnergiesCacheableDataType::num_cacheable_data_types ),
-	point_graph_( /* 0 */ )
+	point_graph_( /* 0 */ ),
+	neighbor_hash_( /* 0 */ )
 {}
 
 
@@ -140,7 +150,8 @@ Energies::Energies( Energies const & other )
 	energy_state_( other.energy_state_ ),
 	graph_state_( other.graph_state_ ),
 	data_cache_( other.data_cache_ ),
-	point_graph_( /* 0 */ )
+	point_graph_( /* 0 */ ),
+	neighbor_hash_( other.neighbor_hash_ )
 {
 	copy_nblists( other );
 	copy_context_graphs( other );
@@ -183,6 +194,7 @@ Energies::operator = ( Energies const & rhs )
 	copy_lr_energy_containers( rhs );
 
 	/// NOTE: point_graph_ is intentionally not copied here ////
+	neighbor_hash_ = rhs.neighbor_hash_;
 
 	return *this;
 }
@@ -1172,6 +1184,22 @@ Energies::update_neighbor_links(
 	//std::cout << "update_neighbor_links: interaction dist: " << scorefxn_info_->max_atomic_interaction_distance() <<
 	// std::endl;
 
+	bool const ligand_ensemble( basic::options::option[ basic::options::OptionKeys::docking::ligand::ligand_ensemble ].user() &&
+		basic::options::option[ basic::options::OptionKeys::docking::ligand::ligand_ensemble ]() != 0 );
+
+	utility::vector1< ContextGraphOP > context_graphs_present;
+	for ( uint ii = 1, ii_end = context_graphs_.size(); ii <= ii_end; ++ii ) {
+		if ( context_graphs_[ ii ] ) context_graphs_present.push_back( context_graphs_[ ii ] );
+	}
+
+	bool const all_moved( energy_graph_->num_edges() == 0 );
+	bool const incremental( basic::options::option[ basic::options::OptionKeys::score::incremental_neighbor_update ]()
+		&& supports_incremental_neighbor_update() );
+	if ( incremental && ! all_moved && update_neighbor_links_incrementally(
+			pose, neighbor_cutoff( pose ), context_graphs_present, ligand_ensemble ) ) {
+		return;
+	}
+
 	if ( point_graph_ == nullptr ) {
 		point_graph_ = utility::pointer::make_shared< core::conformation::PointGraph >();
 	}
@@ -1180,71 +1208,137 @@ Energies::update_neighbor_links(
 	// According to the domain map, add some of the edges detected by the octree to
 	// the energy graph and to the context graphs
 
-	bool all_moved( energy_graph_->num_edges() == 0 );
-
-	utility::vector1< ContextGraphOP > context_graphs_present;
-	for ( uint ii = 1, ii_end = context_graphs_.size(); ii <= ii_end; ++ii ) {
-		if ( context_graphs_[ ii ] ) context_graphs_present.push_back( context_graphs_[ ii ] );
-	}
-
 	for ( uint ii = 1, ii_end = pose.size(); ii <= ii_end; ++ii ) {
 
 		int const ii_map( domain_map_(ii) );
 		bool const ii_moved( ii_map == 0 || all_moved );
 
-		Distance const iiradius( pose.residue_type( ii ).nbr_radius() );
-		Distance const ii_intxn_radius( iiradius +
-			scorefxn_info_->max_atomic_interaction_distance() );
-
 		for ( core::conformation::PointGraph::UpperEdgeListConstIter
 				ii_iter = point_graph_->get_vertex( ii ).upper_edge_list_begin(),
 				ii_end_iter = point_graph_->get_vertex( ii ).upper_edge_list_end();
 				ii_iter != ii_end_iter; ++ii_iter ) {
 			uint const jj = ii_iter->upper_vertex();
 			if ( ( domain_map_(jj) != ii_map ) || ii_moved ) {
+				add_neighbor_edges( pose, ii, jj, ii_iter->data().dsq(), context_graphs_present, ligand_ensemble );
+			}
+		}
+	}
 
-				Distance const jjradius( pose.residue_type( jj ).nbr_radius() );
-				DistanceSquared const square_distance( ii_iter->data().dsq() );
+	// Remember where every neighbor atom is, so that the next update can re-bin only
+	// the residues that move.
+	if ( incremental ) {
+		utility::vector1< conformation::PointPosition > points( pose.size() );
+		for ( uint ii = 1, ii_end = pose.size(); ii <= ii_end; ++ii ) {
+			points[ ii ] = point_graph_->get_vertex( ii ).data().xyz();
+		}
+		if ( ! neighbor_hash_ || neighbor_hash_.use_count() > 1 ) {
+			neighbor_hash_ = utility::pointer::make_shared< conformation::PointHash >();
+		}
+		neighbor_hash_->reset( points, std::max( neighbor_cutoff( pose ), Distance( 1.0 ) ) );
+	} else {
+		neighbor_hash_ = nullptr;
+	}
+}
 
+void
+Energies::add_neighbor_edges(
+	pose::Pose const & pose,
+	Size lower,
+	Size upper,
+	DistanceSquared dsq,
+	utility::vector1< ContextGraphOP > const & context_graphs_present,
+	bool ligand_ensemble
+)
+{
+	debug_assert( lower < upper );
 
-				//check for option to see if its multi-ligand docking, if it is then do not add edge if
-				//both residues are ligands
-				//put remaining code in else statement
-				core::Real ligand_ensemble_wt = 0;
-				if ( basic::options::option[ basic::options::OptionKeys::docking::ligand::ligand_ensemble ].user() ) {
-					ligand_ensemble_wt = basic::options::option[ basic::options::OptionKeys::docking::ligand::ligand_ensemble ]();
-				}
+	// with multi-ligand docking, ligands do not interact with each other
+	if ( ligand_ensemble && pose.residue_type( lower ).is_ligand() && pose.residue_type( upper ).is_ligand() ) return;
 
-				if ( ligand_ensemble_wt != 0 ) {
-					if ( pose.residue_type(ii).is_ligand() && pose.residue_type(jj).is_ligand() ) {}
-					// How about we simply make sure the radii sum is positive instead of paying for a sqrt
-					// if ( std::sqrt( square_distance ) < ( ii_intxn_radius + jj_res.nbr_radius() ) ) {
-					else if ( ii_intxn_radius + jjradius > 0 ) {
-						if ( square_distance < (ii_intxn_radius + jjradius )*(ii_intxn_radius + jjradius ) ) {
-							energy_graph_->add_energy_edge( ii, jj, square_distance );
-						}
-						for ( uint kk = 1; kk <= context_graphs_present.size(); ++kk ) {
-							context_graphs_present[ kk ]->conditionally_add_edge( ii, jj, square_distance );
-						}
-					}
-
-				} else {
-
-					//How about we simply make sure the radii sum is positive instead of paying for a sqrt
-					if ( ii_intxn_radius + jjradius > 0 ) {
-						if ( square_distance < (ii_intxn_radius + jjradius )*(ii_intxn_radius + jjradius ) ) {
-							energy_graph_->add_energy_edge( ii, jj, square_distance );
-						}
-						for ( uint kk = 1; kk <= context_graphs_present.size(); ++kk ) {
-							context_graphs_present[ kk ]->conditionally_add_edge( ii, jj, square_distance );
-						}
-					}
-				}
-			}
+	Distance const lower_intxn_radius( pose.residue_type( lower ).nbr_radius() +
+		scorefxn_info_->max_atomic_interaction_distance() );
+	Distance const upper_radius( pose.residue_type( upper ).nbr_radius() );
+
+	// How about we simply make sure the radii sum is positive instead of paying for a sqrt
+	if ( lower_intxn_radius + upper_radius > 0 ) {
+		if ( dsq < ( lower_intxn_radius + upper_radius )*( lower_intxn_radius + upper_radius ) ) {
+			energy_graph_->add_energy_edge( lower, upper, dsq );
+		}
+		for ( uint kk = 1; kk <= context_graphs_present.size(); ++kk ) {
+			context_graphs_present[ kk ]->conditionally_add_edge( lower, upper, dsq );
 		}
 	}
 }
 
+/// @details The residues that have not moved with respect to each other already have the
+/// right edges between them (prepare_neighbor_graphs() only deleted the edges between
+/// residues that moved relative to one another), so the only pairs to detect are those
+/// where at least one residue lies outside the largest rigid domain in the domain map.
+/// That domain must also be where the hash last saw it -- its neighbor atoms must have
+/// exactly the coordinates recorded in the hash -- or else every residue would need to be
+/// re-binned.  The residues outside it are re-binned, and each is used to query the 27
+/// cubes around it, so the work is proportional to the number of residues that moved,
+/// plus one O(N) pass over the domain map to find them.
+bool
+Energies::update_neighbor_links_incrementally(
+	pose::Pose const & pose,
+	Distance neighbor_cutoff,
+	utility::vector1< ContextGraphOP > const & context_graphs_present,
+	bool ligand_ensemble
+)
+{
+	if ( ! neighbor_hash_ || neighbor_hash_->size() != pose.size() ) return false;
+	if ( neighbor_cutoff > neighbor_hash_->cube_side() ) return false;
+
+	// Find the largest rigid domain.
+	std::map< int, Size > domain_sizes;
+	for ( uint ii = 1, ii_end = pose.size(); ii <= ii_end; ++ii ) {
+		if ( domain_map_( ii ) != 0 ) ++domain_sizes[ domain_map_( ii ) ];
+	}
+	if ( domain_sizes.empty() ) return false;
+	int reference_domain( 0 );
+	Size reference_size( 0 );
+	for ( auto const & domain : domain_sizes ) {
+		if ( domain.second > reference_size ) {
+			reference_domain = domain.first;
+			reference_size = domain.second;
+		}
+	}
+
+	utility::vector1< Size > moved;
+	moved.reserve( pose.size() - reference_size );
+	for ( uint ii = 1, ii_end = pose.size(); ii <= ii_end; ++ii ) {
+		if ( domain_map_( ii ) != reference_domain ) {
+			moved.push_back( ii );
+		} else if ( pose.residue( ii ).nbr_atom_xyz() != neighbor_hash_->point( ii ) ) {
+			return false;
+		}
+	}
+
+	if ( neighbor_hash_.use_count() > 1 ) {
+		neighbor_hash_ = utility::pointer::make_shared< conformation::PointHash >( *neighbor_hash_ );
+	}
+	for ( Size const ii : moved ) {
+		neighbor_hash_->move_point( ii, pose.residue( ii ).nbr_atom_xyz() );
+	}
+
+	for ( Size const ii : moved ) {
+		int const ii_map( domain_map_( ii ) );
+		neighbor_hash_->for_each_neighbor( neighbor_hash_->point( ii ), neighbor_cutoff, ii,
+			[&]( Size jj, DistanceSquared dsq ) {
+				int const jj_map( domain_map_( jj ) );
+				if ( jj_map != reference_domain ) {
+					// Both residues moved: visit the pair once, and only if they moved
+					// with respect to each other.
+					if ( jj < ii ) return;
+					if ( ii_map != 0 && ii_map == jj_map ) return;
+				}
+				add_neighbor_edges( pose, std::min( ii, jj ), std::max( ii, jj ), dsq, context_graphs_present, ligand_ensemble );
+			} );
+	}
+	return true;
+}
+
 /// @brief determine distance cutoff threshold based on scorefxn_info_ and
 /// then add edges to the PointGraph class
 void
@@ -1252,15 +1346,25 @@ Energies::fill_point_graph( pose::Pose const & pose, conformation::PointGraphOP
 
 	core::conformation::residue_point_graph_from_conformation( pose.conformation(), *pg );
 
+	// Stuarts O( n log n ) octree algorithm
+	core::conformation::find_neighbors<core::conformation::PointGraphVertexData,core::conformation::PointGraphEdgeData>( pg, neighbor_cutoff( pose ) );
+}
+
+/// @details Derived classes such as SurfaceEnergies override fill_point_graph(), which the
+/// incremental path would bypass, so they keep the full path unless they opt in.
+bool
+Energies::supports_incremental_neighbor_update() const {
+	return typeid( *this ) == typeid( Energies );
+}
+
+Distance
+Energies::neighbor_cutoff( pose::Pose const & pose ) const {
 	Distance const max_pair_radius = pose::pose_max_nbr_radius( pose );
 	Distance const energy_neighbor_cutoff = 2 * max_pair_radius + scorefxn_info_->max_atomic_interaction_distance();
 
 	Distance const context_cutoff = max_context_neighbor_cutoff_;
 
-	Distance const neighbor_cutoff = numeric::max( energy_neighbor_cutoff, context_cutoff );
-
-	// Stuarts O( n log n ) octree algorithm
-	core::conformation::find_neighbors<core::conformation::PointGraphVertexData,core::conformation::PointGraphEdgeData>( pg, neighbor_cutoff );
+	return numeric::max( energy_neighbor_cutoff, context_cutoff );
 }
 
 void Energies::copy_nblists( Energies const & other )
@@ -42,6 +42,7 @@
 #include <core/pose/Pose.fwd.hh>
 
 #include <core/conformation/PointGraph.fwd.hh>
+#include <core/conformation/PointHash.fwd.hh>
 
 #include <core/id/AtomID.fwd.hh>
 #include <core/id/AtomID_Mask.fwd.hh>
@@ -609,6 +610,13 @@ protected:
 		return domain_map_(pos);
 	}
 
+	/// @brief May update_neighbor_links() take the incremental path, which detects
+	/// neighbors without calling fill_point_graph()?  True only for Energies itself;
+	/// a derived class must override this to opt in, and may do so only if it
+	/// neither overrides fill_point_graph() nor depends on its being called.
+	virtual
+	bool supports_incremental_neighbor_update() const;
+
 
 	/////////////////////////////////////////////////////////////////////////////
 	/////////////////////////////////////////////////////////////////////////////
@@ -687,6 +695,35 @@ private:
 	virtual
 	void fill_point_graph( pose::Pose const & pose, conformation::PointGraphOP pg ) const;
 
+	/// @brief The distance within which fill_point_graph() looks for neighbors:
+	/// enough for both the energy graph and every required context graph.
+	Distance neighbor_cutoff( pose::Pose const & pose ) const;
+
+	/// @brief Add the edge between two neighboring residues to the energy graph (if
+	/// their interaction spheres overlap) and to each of the given context graphs
+	/// (if they are within its cutoff).
+	void
+	add_neighbor_edges(
+		pose::Pose const & pose,
+		Size lower,
+		Size upper,
+		DistanceSquared dsq,
+		utility::vector1< ContextGraphOP > const & context_graphs_present,
+		bool ligand_ensemble
+	);
+
+	/// @brief Add the neighbor edges for the residues that have moved since the last
+	/// update, by re-binning only those residues in the persistent neighbor_hash_.
+	/// Returns false, without touching any graph, if the hash can't be used; then
+	/// every neighbor must be redetected from scratch.
+	bool
+	update_neighbor_links_incrementally(
+		pose::Pose const & pose,
+		Distance neighbor_cutoff,
+		utility::vector1< ContextGraphOP > const & context_graphs_present,
+		bool ligand_ensemble
+	);
+
 	/// @brief During Energies copy-ctor and assignment operator, copy over the
 	/// neighbor lists objects (clone them).
 	void copy_nblists( Energies const & other );
@@ -806,6 +843,12 @@ private:
 	/// Its purpose is solely to improve performance and the data is used
 	/// only inside the neighbor calculation function call.
 	conformation::PointGraphOP point_graph_;
+
+	/// The neighbor-atom coordinates as of the last neighbor update, binned into cubes,
+	/// so that the next update need only re-bin the residues that moved.  Shared between
+	/// copies of an Energies object and cloned before it is modified, so that copying a
+	/// Pose (e.g. in MonteCarlo) does not pay for copying the hash; not serialized.
+	conformation::PointHashOP neighbor_hash_;
 #ifdef    SERIALIZATION
 public:
 	template< class Archive > void save( Archive & arc ) const;
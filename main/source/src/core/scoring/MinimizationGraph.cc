@@ -18,6 +18,19 @@
 #include <core/scoring/methods/EnergyMethod.hh>
 #include <core/scoring/methods/OneBodyEnergy.hh>
 #include <core/scoring/methods/TwoBodyEnergy.hh>
+#include <core/scoring/DerivVectorPair.hh>
+
+// Project Headers
+#include <core/conformation/Residue.hh>
+#include <core/pose/Pose.hh>
+
+#ifdef MULTI_THREADED
+#include <basic/options/option.hh>
+#include <basic/options/keys/multithreading.OptionKeys.gen.hh>
+#include <basic/thread_manager/RosettaThreadManager.hh>
+#include <utility/pointer/memory.hh>
+#include <functional>
+#endif
 
 // Numeric headers
 
@@ -933,6 +946,121 @@ eval_weighted_atom_derivatives_for_minedge(
 	}
 }
 
+MinEdgeDerivativeScratch::MinEdgeDerivativeScratch() :
+	nthreads_( 1 )
+{
+#ifdef MULTI_THREADED
+	using namespace basic::options;
+	nthreads_ = option[ OptionKeys::multithreading::minimization_derivative_threads ]();
+	if ( nthreads_ == 0 ) nthreads_ = option[ OptionKeys::multithreading::total_threads ]();
+#endif
+}
+
+utility::vector1< utility::vector1< utility::vector1< DerivVectorPair > > > &
+MinEdgeDerivativeScratch::zeroed_block_derivatives(
+	Size const nblocks,
+	utility::vector1< utility::vector1< DerivVectorPair > > const & atom_derivatives
+) {
+	block_derivatives_.resize( nblocks );
+	for ( Size bb = 1; bb <= nblocks; ++bb ) {
+		block_derivatives_[ bb ].resize( atom_derivatives.size() );
+		for ( Size ii = 1; ii <= atom_derivatives.size(); ++ii ) {
+			utility::vector1< DerivVectorPair > & block_res_derivs( block_derivatives_[ bb ][ ii ] );
+			block_res_derivs.resize( atom_derivatives[ ii ].size() );
+			for ( DerivVectorPair & deriv : block_res_derivs ) deriv = DerivVectorPair();
+		}
+	}
+	return block_derivatives_;
+}
+
+/// @brief Evaluate the derivatives for edges[ first ] through edges[ last ] into atom_derivatives.
+void
+eval_atom_derivatives_for_minedge_range(
+	MinimizationGraph const & mingraph,
+	utility::vector1< MinimizationEdge const * > const & edges,
+	Size const first,
+	Size const last,
+	pose::Pose const & pose,
+	EnergyMap const & respair_weights,
+	bool const weighted,
+	utility::vector1< utility::vector1< DerivVectorPair > > & atom_derivatives
+) {
+	for ( Size ii = first; ii <= last; ++ii ) {
+		MinimizationEdge const & minedge( *edges[ ii ] );
+		Size const rsd1ind = minedge.get_first_node_ind();
+		Size const rsd2ind = minedge.get_second_node_ind();
+		conformation::Residue const & rsd1( pose.residue( rsd1ind ));
+		conformation::Residue const & rsd2( pose.residue( rsd2ind ));
+		ResSingleMinimizationData const & r1_min_data( mingraph.get_minimization_node( rsd1ind )->res_min_data() );
+		ResSingleMinimizationData const & r2_min_data( mingraph.get_minimization_node( rsd2ind )->res_min_data() );
+
+		if ( weighted ) {
+			eval_weighted_atom_derivatives_for_minedge( minedge, rsd1, rsd2,
+				r1_min_data, r2_min_data, pose, respair_weights,
+				atom_derivatives[ rsd1ind ], atom_derivatives[ rsd2ind ] );
+		} else {
+			eval_atom_derivatives_for_minedge( minedge, rsd1, rsd2,
+				r1_min_data, r2_min_data, pose, respair_weights,
+				atom_derivatives[ rsd1ind ], atom_derivatives[ rsd2ind ] );
+		}
+	}
+}
+
+void
+eval_atom_derivatives_for_minedges(
+	MinimizationGraph const & mingraph,
+	pose::Pose const & pose,
+	EnergyMap const & respair_weights,
+	bool const weighted,
+	MinEdgeDerivativeScratch & scratch,
+	utility::vector1< utility::vector1< DerivVectorPair > > & atom_derivatives
+) {
+	utility::vector1< MinimizationEdge const * > edges;
+	edges.reserve( mingraph.num_edges() );
+	for ( auto edgeit = mingraph.const_edge_list_begin(), edgeit_end = mingraph.const_edge_list_end();
+			edgeit != edgeit_end; ++edgeit ) {
+		edges.push_back( static_cast< MinimizationEdge const * > ( *edgeit ) );
+	}
+	Size const nedges( edges.size() );
+
+	Size const nblocks( std::min( std::max( scratch.nthreads(), Size( 1 ) ), nedges ) );
+	if ( nblocks <= 1 ) {
+		eval_atom_derivatives_for_minedge_range( mingraph, edges, 1, nedges, pose, respair_weights, weighted, atom_derivatives );
+		return;
+	}
+
+	// Each block accumulates into its own zeroed copy of the derivative arrays.
+	utility::vector1< utility::vector1< utility::vector1< DerivVectorPair > > > & block_derivatives(
+		scratch.zeroed_block_derivatives( nblocks, atom_derivatives ) );
+
+#ifdef MULTI_THREADED
+	utility::vector1< basic::thread_manager::RosettaThreadFunctionOP > work_vector;
+	work_vector.reserve( nblocks );
+	for ( Size bb = 1; bb <= nblocks; ++bb ) {
+		Size const first( ( bb - 1 ) * nedges / nblocks + 1 );
+		Size const last( bb * nedges / nblocks );
+		work_vector.push_back( utility::pointer::make_shared< basic::thread_manager::RosettaThreadFunction >(
+			std::bind( &eval_atom_derivatives_for_minedge_range, std::cref( mingraph ), std::cref( edges ),
+			first, last, std::cref( pose ), std::cref( respair_weights ), weighted, std::ref( block_derivatives[ bb ] ) ) ) );
+	}
+	basic::thread_manager::RosettaThreadManager::get_instance()->do_work_vector_in_threads( work_vector, nblocks );
+#else
+	for ( Size bb = 1; bb <= nblocks; ++bb ) {
+		eval_atom_derivatives_for_minedge_range( mingraph, edges, ( bb - 1 ) * nedges / nblocks + 1, bb * nedges / nblocks,
+			pose, respair_weights, weighted, block_derivatives[ bb ] );
+	}
+#endif
+
+	for ( Size ii = 1; ii <= atom_derivatives.size(); ++ii ) {
+		for ( Size jj = 1; jj <= atom_derivatives[ ii ].size(); ++jj ) {
+			for ( Size bb = 1; bb <= nblocks; ++bb ) {
+				atom_derivatives[ ii ][ jj ].f1() += block_derivatives[ bb ][ ii ][ jj ].f1();
+				atom_derivatives[ ii ][ jj ].f2() += block_derivatives[ bb ][ ii ][ jj ].f2();
+			}
+		}
+	}
+}
+
 void
 eval_res_pair_energy_for_minedge(
 	MinimizationEdge const & min_edge,
@@ -23,10 +23,13 @@ namespace scoring {
 class MinimizationNode;
 class MinimizationEdge;
 class MinimizationGraph;
+class MinEdgeDerivativeScratch;
 
 typedef utility::pointer::shared_ptr< MinimizationGraph > MinimizationGraphOP;
 typedef utility::pointer::shared_ptr< MinimizationGraph const > MinimizationGraphCOP;
 
+typedef utility::pointer::shared_ptr< MinEdgeDerivativeScratch > MinEdgeDerivativeScratchOP;
+
 } //namespace scoring
 } //namespace core
 
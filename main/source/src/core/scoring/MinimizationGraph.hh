@@ -18,7 +18,7 @@
 #include <core/scoring/MinimizationGraph.fwd.hh>
 
 // Package Headers
-#include <core/scoring/DerivVectorPair.fwd.hh>
+#include <core/scoring/DerivVectorPair.hh>
 #include <core/scoring/MinimizationData.hh>
 #include <core/scoring/EnergyMap.hh>
 #include <core/scoring/methods/EnergyMethod.fwd.hh>
@@ -564,6 +564,46 @@ eval_weighted_atom_derivatives_for_minedge(
 	utility::vector1< DerivVectorPair > & r2atom_derivs
 );
 
+/// @brief The state eval_atom_derivatives_for_minedges keeps between calls: the thread count,
+/// read once from -multithreading:minimization_derivative_threads, and the per-block derivative
+/// buffers, which are allocated on first use and only zeroed on later calls.  The minimizer maps
+/// own one of these for the length of a minimization.
+class MinEdgeDerivativeScratch
+{
+public:
+	MinEdgeDerivativeScratch();
+
+	/// @brief The number of blocks the edges are split into (always 1 in non-multithreaded builds)
+	Size nthreads() const { return nthreads_; }
+	void nthreads( Size setting ) { nthreads_ = setting; }
+
+	/// @brief Zeroed derivative arrays for nblocks blocks, each shaped like atom_derivatives
+	utility::vector1< utility::vector1< utility::vector1< DerivVectorPair > > > &
+	zeroed_block_derivatives( Size nblocks, utility::vector1< utility::vector1< DerivVectorPair > > const & atom_derivatives );
+
+private:
+	Size nthreads_;
+	utility::vector1< utility::vector1< utility::vector1< DerivVectorPair > > > block_derivatives_;
+};
+
+/// @brief Evaluate the inter-residue derivatives for every edge in the minimization graph,
+/// accumulating them into atom_derivatives (indexed by residue, then atom).  If weighted is
+/// true, each edge's derivatives are scaled by its dweight (as in
+/// eval_weighted_atom_derivatives_for_minedge).  In multithreaded builds, the edges are split
+/// into scratch.nthreads() contiguous blocks that are evaluated concurrently, each into its own
+/// buffer; the buffers are summed in block order afterwards, so the result depends only on the
+/// thread count and not on thread scheduling.  A thread count of 1, or a non-multithreaded build,
+/// evaluates the edges in the calling thread exactly as a serial loop would.
+void
+eval_atom_derivatives_for_minedges(
+	MinimizationGraph const & mingraph,
+	pose::Pose const & pose,
+	EnergyMap const & respair_weights,
+	bool const weighted,
+	MinEdgeDerivativeScratch & scratch,
+	utility::vector1< utility::vector1< DerivVectorPair > > & atom_derivatives
+);
+
 /// @brief Deprecated
 /*void
 eval_atom_deriv_for_minedge(
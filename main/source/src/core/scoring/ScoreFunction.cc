@@ -76,6 +76,13 @@
 #include <basic/init.hh>
 #endif
 
+#ifdef MULTI_THREADED
+#include <basic/options/option.hh>
+#include <basic/thread_manager/RosettaThreadManager.hh>
+#include <utility/pointer/memory.hh>
+#include <functional>
+#endif
+
 // Numeric headers
 #include <numeric/random/DistributionSampler.hh>
 
@@ -84,6 +91,7 @@
 #include <utility/io/GeneralFileManager.hh>
 #include <utility/options/OptionCollection.hh>
 #include <utility/options/keys/OptionKeyList.hh>
+#include <basic/options/keys/multithreading.OptionKeys.gen.hh>
 #include <utility/vector1.hh>
 
 // ObjexxFCL Headers
@@ -131,6 +139,7 @@ void
 ScoreFunction::list_options_read( utility::options::OptionKeyList & option_list )
 {
 	methods::EnergyMethodOptions::list_options_read( option_list );
+	option_list + basic::options::OptionKeys::multithreading::scoring_threads;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -176,6 +185,7 @@ ScoreFunction::reset( utility::options::OptionCollection const & options )
 	energy_method_options_ = utility::pointer::make_shared< methods::EnergyMethodOptions >( options );
 	initialize_methods_arrays();
 	weights_.clear();
+	scoring_threads_ = options[ basic::options::OptionKeys::multithreading::scoring_threads ]();
 }
 
 
@@ -655,6 +665,7 @@ ScoreFunction::assign( ScoreFunction const & src )
 	score_function_info_ = utility::pointer::make_shared< ScoreFunctionInfo >( *src.score_function_info_ );
 
 	any_intrares_energies_ = src.any_intrares_energies_;
+	scoring_threads_ = src.scoring_threads_;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1307,6 +1318,13 @@ ScoreFunction::asym_eval_twobody_neighbor_energies(
 	// not mark the edges as having had their energies computed
 	bool const minimizing( energies.use_nblist() );
 
+#ifdef MULTI_THREADED
+	if ( ! minimizing && scoring_threads_ != 1 ) {
+		threaded_eval_twobody_neighbor_energies( pose, nullptr );
+		return;
+	}
+#endif
+
 	if ( minimizing ) {
 		/// When minimizing, do not touch the EnergyGraph -- leave it fixed
 		MinimizationGraphCOP g = energies.minimization_graph();
@@ -1403,6 +1421,13 @@ ScoreFunction::sym_eval_twobody_neighbor_energies( pose::Pose & pose ) const {
 	// not mark the edges as having had their energies computed
 	bool const minimizing( energies.use_nblist() );
 
+#ifdef MULTI_THREADED
+	if ( ! minimizing && scoring_threads_ != 1 ) {
+		threaded_eval_twobody_neighbor_energies( pose, &symm_info );
+		return;
+	}
+#endif
+
 	if ( minimizing ) {
 		/// When minimizing, do not touch the EnergyGraph -- leave it fixed
 		MinimizationGraphCOP g = symm_energies.minimization_graph();
@@ -1509,6 +1534,13 @@ ScoreFunction::asym_eval_long_range_twobody_energies( pose::Pose & pose ) const
 	bool const minimizing( pose.energies().use_nblist() );
 	if ( minimizing ) return; // long range energies are handled as part of the 2-body energies in the minimization graph
 
+#ifdef MULTI_THREADED
+	if ( scoring_threads_ != 1 ) {
+		threaded_eval_long_range_twobody_energies( pose, nullptr );
+		return;
+	}
+#endif
+
 	for ( auto const & ci_lr_2b_method : ci_lr_2b_methods_ ) {
 
 		LREnergyContainerOP lrec = pose.energies().nonconst_long_range_container( ci_lr_2b_method->long_range_type() );
@@ -1584,6 +1616,13 @@ ScoreFunction::sym_eval_long_range_twobody_energies( pose::Pose & pose ) const {
 		dynamic_cast<SymmetricConformation &> ( pose.conformation()) );
 	SymmetryInfoCOP symm_info( SymmConf.Symmetry_Info() );
 
+#ifdef MULTI_THREADED
+	if ( scoring_threads_ != 1 ) {
+		threaded_eval_long_range_twobody_energies( pose, symm_info.get() );
+		return;
+	}
+#endif
+
 	auto & total_energies(const_cast< EnergyMap & > (pose.energies().total_energies()));
 
 	for ( auto iter=ci_lr_2b_methods_begin(),
@@ -1647,6 +1686,186 @@ ScoreFunction::sym_eval_long_range_twobody_energies( pose::Pose & pose ) const {
 	}
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+/// @details Each residue's upper edges form one work unit, summed into that residue's own EnergyMap.
+/// The per-residue sums are then added to the total in residue order, so the result depends only on
+/// the EnergyGraph and not on the number of threads or the order in which the work units run.
+/// In non-multithreaded builds the work units are simply run in order in the calling thread.
+void
+ScoreFunction::threaded_eval_twobody_neighbor_energies(
+	pose::Pose & pose,
+	conformation::symmetry::SymmetryInfo const * symm_info
+) const {
+	Energies & energies( pose.energies() );
+	auto & total_energies( const_cast< EnergyMap & > ( energies.total_energies() ) );
+	EnergyGraph & energy_graph( energies.energy_graph() );
+
+	Size const nres( pose.size() );
+	utility::vector1< EnergyMap > residue_emaps( nres );
+
+#ifdef MULTI_THREADED
+	utility::vector1< basic::thread_manager::RosettaThreadFunctionOP > work_vector;
+	work_vector.reserve( nres );
+	for ( Size ii = 1; ii <= nres; ++ii ) {
+		work_vector.push_back( utility::pointer::make_shared< basic::thread_manager::RosettaThreadFunction >(
+			std::bind( &ScoreFunction::eval_twobody_neighbor_energies_for_residue, this, std::cref( pose ),
+			std::ref( energy_graph ), symm_info, ii, std::ref( residue_emaps[ ii ] ) ) ) );
+	}
+	Size const nthreads( scoring_threads_ == 0 ? basic::options::option[ basic::options::OptionKeys::multithreading::total_threads ]() : scoring_threads_ );
+	basic::thread_manager::RosettaThreadManager::get_instance()->do_work_vector_in_threads( work_vector, nthreads );
+#else
+	for ( Size ii = 1; ii <= nres; ++ii ) {
+		eval_twobody_neighbor_energies_for_residue( pose, energy_graph, symm_info, ii, residue_emaps[ ii ] );
+	}
+#endif
+
+	for ( Size ii = 1; ii <= nres; ++ii ) {
+		total_energies.accumulate( residue_emaps[ ii ], ci_2b_types() );
+		total_energies.accumulate( residue_emaps[ ii ], cd_2b_types() );
+	}
+}
+
+void
+ScoreFunction::eval_twobody_neighbor_energies_for_residue(
+	pose::Pose const & pose,
+	EnergyGraph & energy_graph,
+	conformation::symmetry::SymmetryInfo const * symm_info,
+	Size const ii,
+	EnergyMap & emap
+) const {
+	EnergyMap tbemap;
+	conformation::Residue const & resl( pose.residue( ii ) );
+	for ( utility::graph::Graph::EdgeListIter
+			iru  = energy_graph.get_node( ii )->upper_edge_list_begin(),
+			irue = energy_graph.get_node( ii )->upper_edge_list_end();
+			iru != irue; ++iru ) {
+		auto & edge( static_cast< EnergyEdge & > (**iru) );
+
+		Size const jj( edge.get_second_node_ind() );
+		conformation::Residue const & resu( pose.residue( jj ) );
+		tbemap.zero( cd_2b_types() );
+		tbemap.zero( ci_2b_types() );
+
+		// the context-dependent guys can't be cached, so they are always reevaluated
+		eval_cd_2b( resl, resu, pose, tbemap );
+		if ( symm_info ) {
+			for ( Size kk = 1; kk <= cd_2b_types().size(); ++kk ) {
+				tbemap[ cd_2b_types()[ kk ]] *= symm_info->score_multiply( ii, jj );
+			}
+		}
+
+		if ( edge.energies_not_yet_computed() ) {
+			eval_ci_2b( resl, resu, pose, tbemap );
+			if ( symm_info ) {
+				for ( Size kk = 1; kk <= ci_2b_types().size(); ++kk ) {
+					tbemap[ ci_2b_types()[ kk ]] *= symm_info->score_multiply( ii, jj );
+				}
+			}
+			edge.store_active_energies( tbemap );
+			edge.mark_energies_computed();
+		} else {
+			/// Read the CI energies from the edge, as they are still valid;
+			for ( Size kk = 1; kk <= ci_2b_types().size(); ++kk ) {
+				tbemap[ ci_2b_types()[ kk ]] = edge[ ci_2b_types()[ kk ] ];
+			}
+
+			/// Save the freshly computed CD energies on the edge
+			edge.store_active_energies( tbemap, cd_2b_types() );
+		}
+
+		emap.accumulate( tbemap, ci_2b_types() );
+		emap.accumulate( tbemap, cd_2b_types() );
+	}
+}
+
+/// @details One work unit per (long-range method, residue) pair.  As with the short-ranged energies,
+/// each work unit sums into its own EnergyMap and these are added to the total in a fixed order
+/// (context-independent methods, then context-dependent ones; residues in order within each method).
+void
+ScoreFunction::threaded_eval_long_range_twobody_energies(
+	pose::Pose & pose,
+	conformation::symmetry::SymmetryInfo const * symm_info
+) const {
+	auto & total_energies( const_cast< EnergyMap & > ( pose.energies().total_energies() ) );
+	Size const nres( pose.size() );
+
+	// Collect the methods (and their containers) that have anything to score.
+	utility::vector1< methods::LongRangeTwoBodyEnergy const * > lr_methods;
+	utility::vector1< LREnergyContainerOP > lrecs;
+	utility::vector1< bool > context_independent;
+	for ( auto const & ci_lr_2b_method : ci_lr_2b_methods_ ) {
+		LREnergyContainerOP lrec = pose.energies().nonconst_long_range_container( ci_lr_2b_method->long_range_type() );
+		if ( !lrec || lrec->empty() ) continue; // only score non-empty energies.
+		lr_methods.push_back( ci_lr_2b_method.get() );
+		lrecs.push_back( lrec );
+		context_independent.push_back( true );
+	}
+	for ( auto const & cd_lr_2b_method : cd_lr_2b_methods_ ) {
+		LREnergyContainerOP lrec = pose.energies().nonconst_long_range_container( cd_lr_2b_method->long_range_type() );
+		lr_methods.push_back( cd_lr_2b_method.get() );
+		lrecs.push_back( lrec );
+		context_independent.push_back( false );
+	}
+	if ( lr_methods.empty() ) return;
+
+	utility::vector1< EnergyMap > unit_emaps( lr_methods.size() * nres );
+
+#ifdef MULTI_THREADED
+	utility::vector1< basic::thread_manager::RosettaThreadFunctionOP > work_vector;
+	work_vector.reserve( unit_emaps.size() );
+	for ( Size mm = 1; mm <= lr_methods.size(); ++mm ) {
+		for ( Size ii = 1; ii <= nres; ++ii ) {
+			work_vector.push_back( utility::pointer::make_shared< basic::thread_manager::RosettaThreadFunction >(
+				std::bind( &ScoreFunction::eval_long_range_twobody_energies_for_residue, this, std::cref( pose ),
+				std::cref( *lr_methods[ mm ] ), std::ref( *lrecs[ mm ] ), context_independent[ mm ], symm_info, ii,
+				std::ref( unit_emaps[ ( mm - 1 ) * nres + ii ] ) ) ) );
+		}
+	}
+	Size const nthreads( scoring_threads_ == 0 ? basic::options::option[ basic::options::OptionKeys::multithreading::total_threads ]() : scoring_threads_ );
+	basic::thread_manager::RosettaThreadManager::get_instance()->do_work_vector_in_threads( work_vector, nthreads );
+#else
+	for ( Size mm = 1; mm <= lr_methods.size(); ++mm ) {
+		for ( Size ii = 1; ii <= nres; ++ii ) {
+			eval_long_range_twobody_energies_for_residue( pose, *lr_methods[ mm ], *lrecs[ mm ], context_independent[ mm ],
+				symm_info, ii, unit_emaps[ ( mm - 1 ) * nres + ii ] );
+		}
+	}
+#endif
+
+	for ( Size kk = 1; kk <= unit_emaps.size(); ++kk ) {
+		total_energies += unit_emaps[ kk ];
+	}
+}
+
+void
+ScoreFunction::eval_long_range_twobody_energies_for_residue(
+	pose::Pose const & pose,
+	methods::LongRangeTwoBodyEnergy const & lr_method,
+	LREnergyContainer & lrec,
+	bool const context_independent,
+	conformation::symmetry::SymmetryInfo const * symm_info,
+	Size const ii,
+	EnergyMap & emap
+) const {
+	for ( ResidueNeighborIteratorOP
+			rni = lrec.upper_neighbor_iterator_begin( ii ),
+			rniend = lrec.upper_neighbor_iterator_end( ii );
+			(*rni) != (*rniend); ++(*rni) ) {
+		EnergyMap pair_emap;
+		if ( context_independent && rni->energy_computed() ) {
+			rni->retrieve_energy( pair_emap );
+		} else {
+			Size const jj = rni->upper_neighbor_id();
+			lr_method.residue_pair_energy( pose.residue( ii ), pose.residue( jj ), pose, *this, pair_emap );
+			if ( symm_info ) pair_emap *= symm_info->score_multiply( ii, jj );
+			rni->save_energy( pair_emap );
+			if ( context_independent ) rni->mark_energy_computed();
+		}
+		emap += pair_emap;
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void
 ScoreFunction::eval_onebody_energies( pose::Pose & pose ) const
@@ -3756,6 +3975,7 @@ core::scoring::ScoreFunction::save( Archive & arc ) const {
 	arc( CEREAL_NVP( name_ ) ); // std::string
 	arc( CEREAL_NVP( weights_ ) ); // EnergyMap
 	arc( CEREAL_NVP( energy_method_options_ ) ); // methods::EnergyMethodOptionsOP
+	arc( CEREAL_NVP( scoring_threads_ ) ); // Size
 
 	// The following data members are basically derived from the ones above, and
 	// therefore, should not be serialized
@@ -3774,6 +3994,7 @@ core::scoring::ScoreFunction::load( Archive & arc ) {
 	arc( name_ ); // std::string
 	arc( weights_ ); // EnergyMap
 	arc( energy_method_options_ ); // methods::EnergyMethodOptionsOP
+	arc( scoring_threads_ ); // Size
 
 	// The following data members are basically derived from the ones above, and
 	// therefore, should not be serialized
@@ -31,6 +31,7 @@
 #include <core/kinematics/MinimizerMapBase.fwd.hh>
 #include <core/conformation/Residue.fwd.hh>
 #include <core/conformation/RotamerSetBase.fwd.hh>
+#include <core/conformation/symmetry/SymmetryInfo.fwd.hh>
 #include <core/pack_basic/RotamerSetsBase.fwd.hh>
 
 // Package headers
@@ -726,6 +727,62 @@ protected:
 	void
 	sym_eval_long_range_twobody_energies( pose::Pose & pose ) const;
 
+	/// @brief Evaluate the short-ranged two-body energies for all EnergyGraph edges, distributing the
+	/// residues over scoring_threads() threads.  Not used during minimization.
+	/// @details symm_info is nullptr for asymmetric poses.  Each residue's upper edges are summed into
+	/// their own EnergyMap, and these are added to the pose's total energies in residue order.
+	void
+	threaded_eval_twobody_neighbor_energies(
+		pose::Pose & pose,
+		conformation::symmetry::SymmetryInfo const * symm_info
+	) const;
+
+	/// @brief Evaluate (or, for context-independent terms, retrieve) the two-body energies for the
+	/// upper edges of residue ii in the EnergyGraph, storing them on the edges and adding them to
+	/// emap.  Touches only the edges of residue ii, so calls for different residues may run concurrently.
+	void
+	eval_twobody_neighbor_energies_for_residue(
+		pose::Pose const & pose,
+		EnergyGraph & energy_graph,
+		conformation::symmetry::SymmetryInfo const * symm_info,
+		Size const ii,
+		EnergyMap & emap
+	) const;
+
+	/// @brief Evaluate the long-range two-body energies, distributing the (method, residue) pairs
+	/// over scoring_threads() threads and summing them in a fixed order.  Not used during minimization.
+	void
+	threaded_eval_long_range_twobody_energies(
+		pose::Pose & pose,
+		conformation::symmetry::SymmetryInfo const * symm_info
+	) const;
+
+	/// @brief Evaluate the long-range two-body energies of one method for the upper neighbors of
+	/// residue ii, storing them in the container and adding them to emap.  Context-independent
+	/// energies that have already been computed are retrieved rather than recomputed.
+	void
+	eval_long_range_twobody_energies_for_residue(
+		pose::Pose const & pose,
+		methods::LongRangeTwoBodyEnergy const & lr_method,
+		LREnergyContainer & lrec,
+		bool const context_independent,
+		conformation::symmetry::SymmetryInfo const * symm_info,
+		Size const ii,
+		EnergyMap & emap
+	) const;
+
+public:
+
+	/// @brief The number of threads requested when scoring two-body energies outside of minimization.
+	/// @details 1 means to score in the calling thread; 0 means to request all threads in the global pool.
+	/// Initialized from -multithreading:scoring_threads.  Only has an effect in multithreaded builds.
+	inline Size scoring_threads() const { return scoring_threads_; }
+
+	/// @brief Set the number of threads requested when scoring two-body energies outside of minimization.
+	/// @details 1 means to score in the calling thread; 0 means to request all threads in the global pool.
+	/// All enabled energy methods must be threadsafe for a value other than 1 to be used.
+	inline void set_scoring_threads( Size const setting ) { scoring_threads_ = setting; }
+
 public:
 
 	AllMethodsIterator
@@ -1283,6 +1340,9 @@ private:
 	bool any_intrares_energies_;
 	TWO_B_Methods ci_2b_intrares_;
 	TWO_B_Methods cd_2b_intrares_;
+
+	/// @brief Threads to request for two-body scoring outside of minimization (1 = serial, 0 = all).
+	Size scoring_threads_ = 1;
 #ifdef    SERIALIZATION
 public:
 	template< class Archive > void save( Archive & arc ) const;
@@ -0,0 +1,349 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/scoring/electron_density/DensityBricks.cc
+/// @brief  Density maps and spline coefficients that are read or computed brick by brick, as needed
+
+// Unit headers
+#include <core/scoring/electron_density/DensityBricks.hh>
+
+// Package headers
+#include <core/scoring/electron_density/SplineInterp.hh>
+
+// Numeric headers
+#include <numeric/fourier/FFT.hh>
+#include <numeric/fourier/kiss_fft.hh>
+
+// Utility headers
+#include <utility/Binary_Util.hh>
+#include <utility/exit.hh>
+#include <utility/io/MappedFile.hh>
+
+// C++ headers
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace core {
+namespace scoring {
+namespace electron_density {
+
+namespace {
+
+/// @brief x modulo n, in [0,n)
+inline
+int
+wrap( int const x, int const n ) {
+	int const r( x % n );
+	return r < 0 ? r + n : r;
+}
+
+/// @brief The 0-based grid points of an axis of n points for the 0-based box positions 0..extent-1
+/// starting at lo
+std::vector< int >
+wrapped_axis( int const lo, int const extent, int const n ) {
+	std::vector< int > points( extent );
+	for ( int i = 0; i < extent; ++i ) points[ i ] = wrap( lo + i, n );
+	return points;
+}
+
+}
+
+/////////////////////////////////////
+// DensityBricks
+
+DensityBricks::DensityBricks(
+	utility::io::MappedFileCOP file,
+	core::Size const data_offset,
+	int const crs_extent[ 3 ],
+	int const xyz2crs[ 3 ],
+	bool const swap,
+	int const brick_size
+) :
+	file_( file ),
+	data_( file->data() + data_offset ),
+	swap_( swap ),
+	brick_size_( brick_size )
+{
+	core::Size const crs_stride[ 3 ] = {
+		sizeof( float ),
+		sizeof( float ) * crs_extent[ 0 ],
+		sizeof( float ) * crs_extent[ 0 ] * crs_extent[ 1 ] };
+	for ( int d = 0; d < 3; ++d ) {
+		dims_[ d ] = crs_extent[ xyz2crs[ d ] ];
+		stride_[ d ] = crs_stride[ xyz2crs[ d ] ];
+		nbricks_[ d ] = ( dims_[ d ] + brick_size_ - 1 ) / brick_size_;
+	}
+	if ( data_offset + sizeof( float ) * dims_[ 0 ] * dims_[ 1 ] * dims_[ 2 ] > file->size() ) {
+		utility_exit_with_message( "Density map " + file->filename() + " is smaller than its header says." );
+	}
+	bricks_.reset( nbricks_[ 0 ] * nbricks_[ 1 ] * nbricks_[ 2 ] );
+}
+
+DensityBricks::~DensityBricks() = default;
+
+float
+DensityBricks::file_voxel( int const x, int const y, int const z ) const {
+	// swapped as an integer: swapping the bytes of a float in place breaks strict aliasing
+	std::uint32_t bits;
+	std::memcpy( &bits, data_ + x * stride_[ 0 ] + y * stride_[ 1 ] + z * stride_[ 2 ], sizeof( bits ) );
+	if ( swap_ ) utility::swap4_aligned( &bits, 1 );
+	float value;
+	std::memcpy( &value, &bits, sizeof( value ) );
+	return value;
+}
+
+utility::pointer::shared_ptr< std::vector< float > const >
+DensityBricks::load_brick( int const bx, int const by, int const bz ) const {
+	int const B( brick_size_ );
+	utility::pointer::shared_ptr< std::vector< float > > brick( new std::vector< float >( B * B * B, 0.0 ) );
+	int const x0( bx * B ), y0( by * B ), z0( bz * B );
+	int const nx( std::min( B, dims_[ 0 ] - x0 ) ), ny( std::min( B, dims_[ 1 ] - y0 ) ), nz( std::min( B, dims_[ 2 ] - z0 ) );
+	for ( int z = 0; z < nz; ++z ) {
+		for ( int y = 0; y < ny; ++y ) {
+			float * row( &(*brick)[ ( z * B + y ) * B ] );
+			for ( int x = 0; x < nx; ++x ) {
+				row[ x ] = file_voxel( x0 + x, y0 + y, z0 + z );
+			}
+		}
+	}
+	return brick;
+}
+
+float
+DensityBricks::voxel( int const x, int const y, int const z ) const {
+	int const B( brick_size_ );
+	int const bx( ( x - 1 ) / B ), by( ( y - 1 ) / B ), bz( ( z - 1 ) / B );
+	std::vector< float > const & brick( bricks_.get(
+		bx + nbricks_[ 0 ] * ( by + nbricks_[ 1 ] * bz ),
+		[&]() { return load_brick( bx, by, bz ); } ) );
+	return brick[ ( ( z - 1 - bz * B ) * B + ( y - 1 - by * B ) ) * B + ( x - 1 - bx * B ) ];
+}
+
+void
+DensityBricks::read_box(
+	numeric::xyzVector< int > const & lo,
+	numeric::xyzVector< int > const & extent,
+	core::Real const shift,
+	ObjexxFCL::FArray3D< double > & box
+) const {
+	debug_assert( box.u1() >= extent[ 0 ] && box.u2() >= extent[ 1 ] && box.u3() >= extent[ 2 ] );
+	std::vector< int > const xs( wrapped_axis( lo[ 0 ], extent[ 0 ], dims_[ 0 ] ) );
+	std::vector< int > const ys( wrapped_axis( lo[ 1 ], extent[ 1 ], dims_[ 1 ] ) );
+	std::vector< int > const zs( wrapped_axis( lo[ 2 ], extent[ 2 ], dims_[ 2 ] ) );
+	for ( int k = 0; k < extent[ 2 ]; ++k ) {
+		for ( int j = 0; j < extent[ 1 ]; ++j ) {
+			for ( int i = 0; i < extent[ 0 ]; ++i ) {
+				box( i + 1, j + 1, k + 1 ) = file_voxel( xs[ i ], ys[ j ], zs[ k ] ) - shift;
+			}
+		}
+	}
+}
+
+void
+DensityBricks::read_map( ObjexxFCL::FArray3D< float > & map ) const {
+	map.dimension( dims_[ 0 ], dims_[ 1 ], dims_[ 2 ] );
+	for ( int z = 0; z < dims_[ 2 ]; ++z ) {
+		for ( int y = 0; y < dims_[ 1 ]; ++y ) {
+			for ( int x = 0; x < dims_[ 0 ]; ++x ) {
+				map( x + 1, y + 1, z + 1 ) = file_voxel( x, y, z );
+			}
+		}
+	}
+}
+
+void
+DensityBricks::convolve_box(
+	numeric::xyzVector< int > const & lo,
+	numeric::xyzVector< int > const & radius,
+	core::Real const shift,
+	KernelFunction const & kernel,
+	numeric::fourier::FFTJobRunner const & runner,
+	ObjexxFCL::FArray4D< double > & samples
+) const {
+	numeric::xyzVector< int > const extent( samples.u1(), samples.u2(), samples.u3() );
+
+	// the map is read from read_lo on, for read_extent points, into the corner of a box of padded points;
+	// sample i of the box along an axis is then at box point at[i]
+	numeric::xyzVector< int > read_lo, read_extent, padded;
+	std::vector< int > at[ 3 ];
+	for ( int d = 0; d < 3; ++d ) {
+		if ( extent[ d ] + 2 * radius[ d ] >= dims_[ d ] ) {
+			read_lo[ d ] = 0;
+			read_extent[ d ] = padded[ d ] = dims_[ d ];
+			at[ d ] = wrapped_axis( lo[ d ], extent[ d ], dims_[ d ] );
+		} else {
+			read_lo[ d ] = lo[ d ] - radius[ d ];
+			read_extent[ d ] = extent[ d ] + 2 * radius[ d ];
+			padded[ d ] = numeric::fourier::kiss_fft_next_fast_size( read_extent[ d ] );
+			at[ d ] = wrapped_axis( radius[ d ], extent[ d ], padded[ d ] );
+		}
+	}
+
+	ObjexxFCL::FArray3D< double > rho( padded[ 0 ], padded[ 1 ], padded[ 2 ], 0.0 );
+	read_box( read_lo, read_extent, shift, rho );
+
+	ObjexxFCL::FArray3D< std::complex< double > > Frho, Fconv;
+	numeric::fourier::fft3( rho, Frho, runner );
+
+	ObjexxFCL::FArray3D< double > kernel_s( padded[ 0 ], padded[ 1 ], padded[ 2 ] ), conv;
+	for ( int s = 1; s <= samples.u4(); ++s ) {
+		kernel_s = 0.0;
+		kernel( s, kernel_s );
+		numeric::fourier::fft3( kernel_s, Fconv, runner );
+		for ( core::Size i = 0; i < Fconv.size(); ++i ) Fconv[ i ] *= Frho[ i ];
+		numeric::fourier::ifft3( Fconv, conv, runner );
+
+		for ( int k = 0; k < extent[ 2 ]; ++k ) {
+			for ( int j = 0; j < extent[ 1 ]; ++j ) {
+				for ( int i = 0; i < extent[ 0 ]; ++i ) {
+					samples( i + 1, j + 1, k + 1, s ) = conv( at[ 0 ][ i ] + 1, at[ 1 ][ j ] + 1, at[ 2 ][ k ] + 1 );
+				}
+			}
+		}
+	}
+}
+
+void
+DensityBricks::compute_stats( core::Real & mean, core::Real & min, core::Real & max, core::Real & stdev ) const {
+	core::Real sum=0, sum2=0;
+	max = -std::numeric_limits< core::Real >::max();
+	min = std::numeric_limits< core::Real >::max();
+
+	for ( int z = 0; z < dims_[ 2 ]; ++z ) {
+		for ( int y = 0; y < dims_[ 1 ]; ++y ) {
+			for ( int x = 0; x < dims_[ 0 ]; ++x ) {
+				float const value( file_voxel( x, y, z ) );
+				sum += value;
+				sum2 += value*value;
+				max = std::max( max, (core::Real)value );
+				min = std::min( min, (core::Real)value );
+			}
+		}
+	}
+
+	core::Size const N( dims_[ 0 ] * dims_[ 1 ] * dims_[ 2 ] );
+	mean = 0.0;
+	stdev = 1.0;
+	if ( N>0 ) {
+		mean = sum/N;
+	}
+	if ( sum2/N-mean*mean > 0 ) {
+		stdev = sqrt( sum2/N-mean*mean );
+	}
+}
+
+/////////////////////////////////////
+// SplineBricks
+
+SplineBricks::SplineBricks(
+	numeric::xyzVector< int > const & dims,
+	core::Size const nslab,
+	int const brick_size,
+	SampleFunction const & samples
+) :
+	dims_( dims ),
+	nslab_( nslab ),
+	brick_size_( brick_size ),
+	samples_( samples )
+{
+	for ( int d = 0; d < 3; ++d ) {
+		nbricks_[ d ] = ( dims_[ d ] + brick_size_ - 1 ) / brick_size_;
+	}
+	bricks_.reset( nbricks_[ 0 ] * nbricks_[ 1 ] * nbricks_[ 2 ] );
+}
+
+SplineBricks::~SplineBricks() = default;
+
+utility::pointer::shared_ptr< ObjexxFCL::FArray4D< double > const >
+SplineBricks::compute_brick( numeric::xyzVector< int > const & b ) const {
+	// a brick interpolates the points of its core, which needs the coefficients from 2 points before
+	// the core to 2 points past it; those come from a box HALO points larger on each side (or the whole axis)
+	numeric::xyzVector< int > core_lo, core_extent, lo, extent;
+	std::vector< int > at[ 3 ];
+	for ( int d = 0; d < 3; ++d ) {
+		core_lo[ d ] = b[ d ] * brick_size_;
+		core_extent[ d ] = std::min( brick_size_, dims_[ d ] - core_lo[ d ] );
+		if ( core_extent[ d ] + 4 + 2 * HALO >= dims_[ d ] ) {
+			lo[ d ] = 0;
+			extent[ d ] = dims_[ d ];
+			at[ d ] = wrapped_axis( core_lo[ d ] - 2, core_extent[ d ] + 4, dims_[ d ] );
+		} else {
+			lo[ d ] = core_lo[ d ] - 2 - HALO;
+			extent[ d ] = core_extent[ d ] + 4 + 2 * HALO;
+			at[ d ] = wrapped_axis( HALO, core_extent[ d ] + 4, extent[ d ] );
+		}
+	}
+
+	ObjexxFCL::FArray4D< double > coeffs( extent[ 0 ], extent[ 1 ], extent[ 2 ], nslab_ );
+	samples_( lo, coeffs );
+	int dims[ 4 ] = { (int)nslab_, extent[ 2 ], extent[ 1 ], extent[ 0 ] };
+	SplineInterp::compute_coefficients4( &coeffs[ 0 ], dims );
+
+	utility::pointer::shared_ptr< ObjexxFCL::FArray4D< double > > brick( new ObjexxFCL::FArray4D< double >(
+		core_extent[ 0 ] + 4, core_extent[ 1 ] + 4, core_extent[ 2 ] + 4, nslab_ ) );
+	for ( int s = 1; s <= (int)nslab_; ++s ) {
+		for ( int k = 0; k < core_extent[ 2 ] + 4; ++k ) {
+			for ( int j = 0; j < core_extent[ 1 ] + 4; ++j ) {
+				for ( int i = 0; i < core_extent[ 0 ] + 4; ++i ) {
+					(*brick)( i + 1, j + 1, k + 1, s ) = coeffs( at[ 0 ][ i ] + 1, at[ 1 ][ j ] + 1, at[ 2 ][ k ] + 1, s );
+				}
+			}
+		}
+	}
+	return brick;
+}
+
+ObjexxFCL::FArray4D< double > const &
+SplineBricks::locate( numeric::xyzVector< core::Real > const & idxX, core::Real const slab, double X[ 4 ] ) const {
+	numeric::xyzVector< int > b;
+	for ( int d = 0; d < 3; ++d ) {
+		core::Real x( std::fmod( idxX[ d ] - 1.0, (core::Real)dims_[ d ] ) );
+		if ( x < 0 ) x += dims_[ d ];
+		int const point( std::min( (int)x, dims_[ d ] - 1 ) );
+		b[ d ] = point / brick_size_;
+		// the brick's coefficients start 2 points before its core
+		X[ 3 - d ] = x - b[ d ] * brick_size_ + 2;
+	}
+	X[ 0 ] = slab - 1.0;
+	return bricks_.get(
+		b[ 0 ] + nbricks_[ 0 ] * ( b[ 1 ] + nbricks_[ 1 ] * b[ 2 ] ),
+		[&]() { return compute_brick( b ); } );
+}
+
+core::Real
+SplineBricks::interp( core::Real const slab, numeric::xyzVector< core::Real > const & idxX ) const {
+	double X[ 4 ];
+	ObjexxFCL::FArray4D< double > const & coeffs( locate( idxX, slab, X ) );
+	int dims[ 4 ] = { coeffs.u4(), coeffs.u3(), coeffs.u2(), coeffs.u1() };
+	return SplineInterp::interp4( &coeffs[ 0 ], dims, X );
+}
+
+void
+SplineBricks::dinterp(
+	numeric::xyzVector< core::Real > const & idxX,
+	core::Real const slab,
+	numeric::xyzVector< core::Real > & gradX,
+	core::Real & gradSlab
+) const {
+	double X[ 4 ];
+	ObjexxFCL::FArray4D< double > const & coeffs( locate( idxX, slab, X ) );
+	int dims[ 4 ] = { coeffs.u4(), coeffs.u3(), coeffs.u2(), coeffs.u1() };
+	double grad[ 4 ] = { 0, 0, 0, 0 };
+	SplineInterp::grad4( &grad[ 0 ], &coeffs[ 0 ], dims, X );
+	gradX = numeric::xyzVector< core::Real >( grad[ 3 ], grad[ 2 ], grad[ 1 ] );
+	gradSlab = grad[ 0 ];
+}
+
+} // namespace electron_density
+} // namespace scoring
+} // namespace core
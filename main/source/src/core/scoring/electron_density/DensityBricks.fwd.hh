@@ -0,0 +1,35 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/scoring/electron_density/DensityBricks.fwd.hh
+/// @brief  Bricked density map forward declarations
+
+#ifndef INCLUDED_core_scoring_electron_density_DensityBricks_fwd_hh
+#define INCLUDED_core_scoring_electron_density_DensityBricks_fwd_hh
+
+// Utility headers
+#include <utility/pointer/owning_ptr.hh>
+
+namespace core {
+namespace scoring {
+namespace electron_density {
+
+class DensityBricks;
+typedef utility::pointer::shared_ptr< DensityBricks > DensityBricksOP;
+typedef utility::pointer::shared_ptr< DensityBricks const > DensityBricksCOP;
+
+class SplineBricks;
+typedef utility::pointer::shared_ptr< SplineBricks > SplineBricksOP;
+typedef utility::pointer::shared_ptr< SplineBricks const > SplineBricksCOP;
+
+} // namespace electron_density
+} // namespace scoring
+} // namespace core
+
+#endif
@@ -0,0 +1,274 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/scoring/electron_density/DensityBricks.hh
+/// @brief  Density maps and spline coefficients that are read or computed brick by brick, as needed
+
+#ifndef INCLUDED_core_scoring_electron_density_DensityBricks_hh
+#define INCLUDED_core_scoring_electron_density_DensityBricks_hh
+
+// Unit headers
+#include <core/scoring/electron_density/DensityBricks.fwd.hh>
+
+// Project headers
+#include <core/types.hh>
+
+// Numeric headers
+#include <numeric/fourier/FFT3DPlan.fwd.hh>
+#include <numeric/xyzVector.hh>
+
+// Utility headers
+#include <utility/io/MappedFile.fwd.hh>
+#include <utility/pointer/ReferenceCount.hh>
+#ifdef MULTI_THREADED
+#include <utility/thread/ReadWriteMutex.hh>
+#endif
+
+// ObjexxFCL headers
+#include <ObjexxFCL/FArray3D.hh>
+#include <ObjexxFCL/FArray4D.hh>
+
+// C++ headers
+#include <functional>
+#include <vector>
+
+namespace core {
+namespace scoring {
+namespace electron_density {
+
+/// @brief A table of bricks, each made the first time it is asked for and then kept.  Safe to use
+/// from several threads at once in multithreaded builds.
+template< class Brick >
+class BrickCache {
+public:
+	typedef utility::pointer::shared_ptr< Brick const > BrickCOP;
+
+	BrickCache() : n_loaded_( 0 ) {}
+
+	/// @brief Forget all bricks and make room for nbricks
+	void
+	reset( core::Size const nbricks ) {
+		bricks_.assign( nbricks, BrickCOP() );
+		n_loaded_ = 0;
+	}
+
+	/// @brief The brick with 0-based index, made by load() if it has not been made yet
+	template< class Loader >
+	Brick const &
+	get( core::Size const index, Loader const & load ) const {
+		{
+#ifdef MULTI_THREADED
+			utility::thread::ReadLockGuard read_lock( mutex_ );
+#endif
+			if ( bricks_[ index ] ) return *bricks_[ index ];
+		}
+		// made without holding the lock, so that other threads may read their bricks meanwhile
+		BrickCOP const brick( load() );
+#ifdef MULTI_THREADED
+		utility::thread::WriteLockGuard write_lock( mutex_ );
+#endif
+		if ( ! bricks_[ index ] ) {
+			bricks_[ index ] = brick;
+			++n_loaded_;
+		}
+		return *bricks_[ index ];
+	}
+
+	core::Size
+	n_loaded() const {
+#ifdef MULTI_THREADED
+		utility::thread::ReadLockGuard read_lock( mutex_ );
+#endif
+		return n_loaded_;
+	}
+
+private:
+	mutable std::vector< BrickCOP > bricks_;
+	mutable core::Size n_loaded_;
+#ifdef MULTI_THREADED
+	mutable utility::thread::ReadWriteMutex mutex_;
+#endif
+};
+
+/// @brief The voxels of an MRC/CCP4 map file, read through a memory mapping of the file.
+///
+/// @details The map is never read as a whole.  voxel() loads the brick (brick_size^3 voxels) that holds
+/// the voxel the first time it is asked for, so only the bricks near the model are ever loaded.
+/// read_box() and convolve_box() read the voxels they need straight from the mapping without keeping
+/// them, and compute_stats() streams through the whole file once.  The grid covers the unit cell,
+/// and all boxes wrap around it periodically.
+class DensityBricks : public utility::pointer::ReferenceCount
+{
+public:
+	/// @brief Fills kernel (of the dimensions given by the caller, and zeroed) with the convolution
+	/// kernel of a slab.  Offsets from the center wrap around as in an FFT: offset 0 is at (1,1,1) and
+	/// offset -1 at the last point of each axis.
+	typedef std::function< void ( core::Size const slab, ObjexxFCL::FArray3D< double > & kernel ) > KernelFunction;
+
+public:
+	/// @brief The voxels of a map in file, as 32-bit floats starting at byte data_offset, stored column
+	/// first, then row, then section.  crs_extent is the number of columns, rows and sections, and
+	/// xyz2crs gives the crs axis (0, 1 or 2) of each of x, y and z.  The floats are byte swapped if swap.
+	DensityBricks(
+		utility::io::MappedFileCOP file,
+		core::Size const data_offset,
+		int const crs_extent[ 3 ],
+		int const xyz2crs[ 3 ],
+		bool const swap,
+		int const brick_size
+	);
+
+	~DensityBricks() override;
+
+	/// @brief The size of the map along x, y and z
+	numeric::xyzVector< int > const & dims() const { return dims_; }
+
+	int brick_size() const { return brick_size_; }
+
+	/// @brief The density at grid point (x,y,z), 1-based as in an FArray3D
+	float
+	voxel( int const x, int const y, int const z ) const;
+
+	/// @brief The density minus shift at the first extent points of the box that starts at the 0-based
+	/// grid point lo, into box (which must be at least that large)
+	void
+	read_box(
+		numeric::xyzVector< int > const & lo,
+		numeric::xyzVector< int > const & extent,
+		core::Real const shift,
+		ObjexxFCL::FArray3D< double > & box
+	) const;
+
+	/// @brief Read the whole map
+	void
+	read_map( ObjexxFCL::FArray3D< float > & map ) const;
+
+	/// @brief The periodic convolution of the map, minus shift, with the kernel of each slab, at the
+	/// box of samples' dimensions (x, y, z, slab) that starts at the 0-based grid point lo.
+	///
+	/// @details The kernels must be zero beyond radius voxels from their center along each axis.  The
+	/// box is read with a margin of radius voxels, padded to a size with small prime factors, and
+	/// convolved by FFT; along axes where the margin would cover the whole map, the whole axis is used,
+	/// and the convolution is that of the whole map.
+	void
+	convolve_box(
+		numeric::xyzVector< int > const & lo,
+		numeric::xyzVector< int > const & radius,
+		core::Real const shift,
+		KernelFunction const & kernel,
+		numeric::fourier::FFTJobRunner const & runner,
+		ObjexxFCL::FArray4D< double > & samples
+	) const;
+
+	/// @brief The mean, minimum, maximum and standard deviation of the map, as in
+	/// ElectronDensity::computeStats()
+	void
+	compute_stats( core::Real & mean, core::Real & min, core::Real & max, core::Real & stdev ) const;
+
+	/// @brief The number of bricks loaded so far
+	core::Size
+	n_loaded_bricks() const {
+		return bricks_.n_loaded();
+	}
+
+private:
+	/// @brief The density at 0-based grid point (x,y,z), from the file
+	float
+	file_voxel( int const x, int const y, int const z ) const;
+
+	/// @brief Read the brick of 0-based brick coordinates (bx,by,bz) from the file
+	utility::pointer::shared_ptr< std::vector< float > const >
+	load_brick( int const bx, int const by, int const bz ) const;
+
+private:
+	utility::io::MappedFileCOP file_;
+	char const * data_;
+	numeric::xyzVector< int > dims_;
+	// bytes between neighbouring voxels along x, y and z in the file
+	core::Size stride_[ 3 ];
+	bool swap_;
+
+	int brick_size_;
+	numeric::xyzVector< int > nbricks_;
+	BrickCache< std::vector< float > > bricks_;
+};
+
+/// @brief The cubic B-spline coefficients of a periodic map with any number of slabs (the slab index
+/// being the first, non-periodic interpolation axis of SplineInterp::interp4), as computed by
+/// spline_coeffs() for a whole FArray4D, but computed brick by brick the first time they are needed.
+///
+/// @details The coefficients of a brick come from the samples of a box HALO voxels larger on each side
+/// than the points the brick interpolates.  The spline prefilter is an infinite (recursive) filter
+/// whose response falls off as 0.268^n, so these coefficients agree with those of the whole map to
+/// about 1e-8 of the largest sample.  Along axes too short for that, the box is the whole axis, and
+/// the coefficients are those of the whole map.  A map of one slab is interpolated like a 3D map.
+class SplineBricks : public utility::pointer::ReferenceCount
+{
+public:
+	/// @brief Fills samples (of the dimensions given by the caller: x, y, z, slab) with the map at the
+	/// box that starts at the 0-based grid point lo; the box may wrap around the map.
+	typedef std::function< void ( numeric::xyzVector< int > const & lo, ObjexxFCL::FArray4D< double > & samples ) > SampleFunction;
+
+	/// @brief The extra samples on each side of a brick
+	static int const HALO = 14;
+
+public:
+	SplineBricks(
+		numeric::xyzVector< int > const & dims,
+		core::Size const nslab,
+		int const brick_size,
+		SampleFunction const & samples
+	);
+
+	~SplineBricks() override;
+
+	/// @brief The spline at slab (1-based) and at point idxX in index space, as interp_spline() of the
+	/// coefficients of the whole map
+	core::Real
+	interp( core::Real const slab, numeric::xyzVector< core::Real > const & idxX ) const;
+
+	/// @brief The gradient of the spline, as interp_dspline() of the coefficients of the whole map
+	void
+	dinterp(
+		numeric::xyzVector< core::Real > const & idxX,
+		core::Real const slab,
+		numeric::xyzVector< core::Real > & gradX,
+		core::Real & gradSlab
+	) const;
+
+	/// @brief The number of bricks computed so far
+	core::Size
+	n_loaded_bricks() const {
+		return bricks_.n_loaded();
+	}
+
+private:
+	/// @brief The coefficients of the brick that holds point idxX, and the 0-based coordinates
+	/// of the point in those coefficients, slab first as SplineInterp wants them
+	ObjexxFCL::FArray4D< double > const &
+	locate( numeric::xyzVector< core::Real > const & idxX, core::Real const slab, double X[ 4 ] ) const;
+
+	/// @brief Compute the coefficients of the brick of 0-based brick coordinates b
+	utility::pointer::shared_ptr< ObjexxFCL::FArray4D< double > const >
+	compute_brick( numeric::xyzVector< int > const & b ) const;
+
+private:
+	numeric::xyzVector< int > dims_;
+	core::Size nslab_;
+	int brick_size_;
+	numeric::xyzVector< int > nbricks_;
+	SampleFunction samples_;
+	BrickCache< ObjexxFCL::FArray4D< double > > bricks_;
+};
+
+} // namespace electron_density
+} // namespace scoring
+} // namespace core
+
+#endif
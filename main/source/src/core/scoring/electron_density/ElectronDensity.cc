@@ -13,6 +13,7 @@
 
 // Unit Headers
 #include <core/scoring/electron_density/ElectronDensity.hh>
+#include <core/scoring/electron_density/DensityBricks.hh>
 #include <core/scoring/electron_density/util.hh>
 
 #ifdef WIN32
@@ -57,6 +58,7 @@
 #include <core/id/AtomID.hh>
 #include <utility/vector1.hh>
 #include <utility/excn/Exceptions.hh>
+#include <utility/io/MappedFile.hh>
 #include <core/scoring/EnergyGraph.hh>
 
 // Utility headers
@@ -68,12 +70,18 @@
 // C++ headers
 #include <fstream>
 #include <limits>
+#include <queue>
+#include <unordered_map>
 #include <complex>
 
 #ifndef WIN32
 #include <pthread.h>
 #endif
 
+#ifdef MULTI_THREADED
+#include <mutex>
+#endif
+
 namespace core {
 namespace scoring {
 namespace electron_density {
@@ -88,6 +96,11 @@ static basic::Tracer TR( "core.scoring.electron_density.ElectronDensity" );
 pthread_mutex_t density_map_db_mut_ = PTHREAD_MUTEX_INITIALIZER;
 #endif
 
+#ifdef MULTI_THREADED
+// serialize get_data() reading a bricked map into the (mutable) dense array
+static std::mutex bricked_map_read_mutex_;
+#endif
+
 using namespace core;
 using namespace basic::options;
 
@@ -353,6 +366,7 @@ void ElectronDensity::mapSphericalSamples (
 	numeric::xyzVector< core::Real > center,
 	core::Real laplacian_offset
 ) {
+	load_dense_map();
 
 	// make sure map is loaded
 	if ( !isLoaded_ ) {
@@ -453,6 +467,8 @@ core::Real ElectronDensity::matchCentroidPose(
 	core::conformation::symmetry::SymmetryInfoCOP symmInfo /*=NULL*/,
 	bool cacheCCs /* = false */)
 {
+	load_dense_map();
+
 	using namespace numeric::statistics;
 
 	// make sure map is loaded
@@ -657,6 +673,24 @@ core::Real ElectronDensity::matchCentroidPose(
 }
 
 
+namespace {
+
+// the (1-based) points of a map axis of n points, on a grid of n_grid points, within radius points of the
+//    (1-based, periodic) position c, in order; all the points if they do not fit that window
+void
+points_near( core::Real c, int radius, int n, int n_grid, utility::vector1< int > & points ) {
+	points.clear();
+	int lo = (int)std::floor( c ) - radius - 1, hi = (int)std::ceil( c ) + radius + 1;
+	if ( n != n_grid || hi-lo+1 >= n ) {
+		for ( int x=1; x<=n; ++x ) points.push_back( x );
+		return;
+	}
+	for ( int x=lo; x<=hi; ++x ) points.push_back( pos_mod( x-1, n ) + 1 );
+	std::sort( points.begin(), points.end() );
+}
+
+}
+
 /////////////////////////////////////
 /// Match a residue to the density map, returning correlation coefficient between
 ///    map and pose
@@ -673,13 +707,13 @@ core::Real ElectronDensity::matchPose(
 		return 0.0;
 	}
 
-	ObjexxFCL::FArray3D< double >  rho_calc, inv_rho_mask;
-	rho_calc.dimension(density.u1() , density.u2() , density.u3());
-	inv_rho_mask.dimension(density.u1() , density.u2() , density.u3());
-	for ( int i=0; i<density.u1()*density.u2()*density.u3(); ++i ) {
-		rho_calc[i]=0.0;
-		inv_rho_mask[i]=1.0;
-	}
+	// rho_calc and the mask are only kept at the voxels within the mask of some atom (their slots)
+	numeric::xyzVector< int > dims( map_dims() );
+	numeric::xyzVector< int > radius( mask_radius( ATOM_MASK+ATOM_MASK_PADDING, grid_ ) );
+	std::unordered_map< int, int > voxel_slot;
+	utility::vector1< int > slot_voxel;
+	utility::vector1< core::Real > rho_calc, inv_rho_mask;
+	utility::vector1< int > points_x, points_y, points_z;
 
 	int nres = pose.size(); //reses.size();
 	numeric::xyzVector< core::Real > cartX, fracX;
@@ -739,8 +773,11 @@ core::Real ElectronDensity::matchPose(
 			atm_idx[i][j][1] = pos_mod (fracX[1]*grid_[1] - origin_[1] + 1 , (double)grid_[1]);
 			atm_idx[i][j][2] = pos_mod (fracX[2]*grid_[2] - origin_[2] + 1 , (double)grid_[2]);
 
+			points_near( atm_idx[i][j][0], radius[0], dims[0], grid_[0], points_x );
+			points_near( atm_idx[i][j][1], radius[1], dims[1], grid_[1], points_y );
+			points_near( atm_idx[i][j][2], radius[2], dims[2], grid_[2], points_z );
 
-			for ( int z=1; z<=density.u3(); ++z ) {
+			for ( int z : points_z ) {
 				atm_j[2] = z;
 				del_ij[2] = (atm_idx[i][j][2] - atm_j[2]) / grid_[2];
 				// wrap-around??
@@ -750,7 +787,7 @@ core::Real ElectronDensity::matchPose(
 				del_ij[0] = del_ij[1] = 0.0;
 				if ( (f2c*del_ij).length_squared() > (ATOM_MASK+ATOM_MASK_PADDING)*(ATOM_MASK+ATOM_MASK_PADDING) ) continue;
 
-				for ( int y=1; y<=density.u2(); ++y ) {
+				for ( int y : points_y ) {
 					atm_j[1] = y;
 
 					// early exit?
@@ -761,7 +798,7 @@ core::Real ElectronDensity::matchPose(
 					del_ij[0] = 0.0;
 					if ( (f2c*del_ij).length_squared() > (ATOM_MASK+ATOM_MASK_PADDING)*(ATOM_MASK+ATOM_MASK_PADDING) ) continue;
 
-					for ( int x=1; x<=density.u1(); ++x ) {
+					for ( int x : points_x ) {
 						atm_j[0] = x;
 
 						// early exit?
@@ -779,12 +816,19 @@ core::Real ElectronDensity::matchPose(
 						core::Real sigmoid_msk = exp( d2 - (ATOM_MASK)*(ATOM_MASK)  );
 						core::Real inv_msk = 1/(1+sigmoid_msk);
 
-						rho_calc(x,y,z) += atm;
-						inv_rho_mask(x,y,z) *= (1 - inv_msk);
+						int idx = (z-1)*dims[1]*dims[0] + (y-1)*dims[0] + x-1;
+						auto slot = voxel_slot.insert( std::make_pair( idx, (int)slot_voxel.size()+1 ) );
+						if ( slot.second ) {
+							slot_voxel.push_back( idx );
+							rho_calc.push_back( 0.0 );
+							inv_rho_mask.push_back( 1.0 );
+						}
+						int const slot_idx = slot.first->second;
 
-						if ( ! cacheCCs )  continue;
+						rho_calc[slot_idx] += atm;
+						inv_rho_mask[slot_idx] *= (1 - inv_msk);
 
-						int idx = (z-1)*density.u2()*density.u1() + (y-1)*density.u1() + x-1;
+						if ( ! cacheCCs )  continue;
 
 						core::Real eps_i = (1-inv_msk), inv_eps_i;
 						if ( eps_i == 0 ) { // divide-by-zero
@@ -793,7 +837,7 @@ core::Real ElectronDensity::matchPose(
 							inv_eps_i = 1/eps_i;
 						}
 
-						rho_dx_pt[i][j].push_back  ( idx );
+						rho_dx_pt[i][j].push_back  ( slot_idx );
 						rho_dx_atm[i][j].push_back ( (-2*k*atm)*cart_del_ij );
 						rho_dx_mask[i][j].push_back( (-2*sigmoid_msk*inv_msk*inv_msk*inv_eps_i)*cart_del_ij );
 					}
@@ -808,10 +852,23 @@ core::Real ElectronDensity::matchPose(
 	core::Real sumO2_i=0.0, sumC2_i=0.0, varC_i=0, varO_i=0;
 	core::Real clc_x, obs_x, eps_x;
 
-	for ( int x=0; x<density.u1()*density.u2()*density.u3(); ++x ) {
+	// in the order of the voxels of the map (voxels outside every mask add nothing)
+	utility::vector1< int > slots( slot_voxel.size() );
+	for ( int x=1; x<=(int)slots.size(); ++x ) slots[x] = x;
+	std::sort( slots.begin(), slots.end(), [&slot_voxel]( int a, int b ) { return slot_voxel[a] < slot_voxel[b]; } );
+
+	utility::vector1< core::Real > obs( slot_voxel.size() );
+	for ( int x : slots ) {
+		int idx = slot_voxel[x];
+		if ( bricks_ ) {
+			obs[x] = bricks_->voxel( idx % dims[0] + 1, (idx / dims[0]) % dims[1] + 1, idx / (dims[0]*dims[1]) + 1 );
+		} else {
+			obs[x] = density[idx];
+		}
+
 		// fetch this point
 		clc_x = rho_calc[x];
-		obs_x = density[x];
+		obs_x = obs[x];
 		eps_x = 1-inv_rho_mask[x]; //1/(1+exp( (0.01-rho_calc(x,y,z)) * 1000 ));  // sigmoidal
 
 		// SMOOTHED
@@ -864,7 +921,7 @@ core::Real ElectronDensity::matchPose(
 			for ( int n=1; n<=npoints; ++n ) {
 				const int x(rho_dx_pt_ij[n]);
 				clc_x = rho_calc[x];
-				obs_x = density[x];
+				obs_x = obs[x];
 				core::Real inv_eps_x = inv_rho_mask[x];
 
 				numeric::xyzVector<double> del_mask = inv_eps_x*rho_dx_mask_ij[n];
@@ -899,6 +956,8 @@ ElectronDensity::getResolutionBins(
 	utility::vector1< core::Real > &resbins,
 	utility::vector1< core::Size > &counts,
 	bool S2_bin/*=false*/ ) {
+	load_dense_map();
+
 	Real min_allowed = sqrt(S2( density.u1()/2, density.u2()/2, density.u3()/2 ));
 	Real max_allowed = std::min( sqrt(S2( 1,0,0 )), sqrt(S2( 0,1,0 )) );
 	max_allowed = std::min( max_allowed, sqrt(S2( 0,0,1 )) );
@@ -957,6 +1016,7 @@ ElectronDensity::getIntensities(
 	core::Real minreso,
 	utility::vector1< core::Real > &Imap,
 	bool S2_bin/*=false*/ ) {
+	load_dense_map();
 
 	Real min_allowed = sqrt(S2( density.u1()/2, density.u2()/2, density.u3()/2 ));
 	Real max_allowed = std::min( sqrt(S2( 1,0,0 )), sqrt(S2( 0,1,0 )) );
@@ -1026,6 +1086,8 @@ ElectronDensity::getFSC(
 	core::Size nbuckets, core::Real maxreso, core::Real minreso,
 	utility::vector1< core::Real >& FSC,
 	bool S2_bin/*=false*/) {
+	load_dense_map();
+
 	Real min_allowed = sqrt(S2( density.u1()/2, density.u2()/2, density.u3()/2 ));
 	Real max_allowed = std::min( sqrt(S2( 1,0,0 )), sqrt(S2( 0,1,0 )) );
 	max_allowed = std::min( max_allowed, sqrt(S2( 0,0,1 )) );
@@ -1094,6 +1156,8 @@ ElectronDensity::getPhaseError(
 	core::Size nbuckets, core::Real maxreso, core::Real minreso,
 	utility::vector1< core::Real >& phaseError,
 	bool S2_bin/*=false*/) {
+	load_dense_map();
+
 	Real min_allowed = sqrt(S2( density.u1()/2, density.u2()/2, density.u3()/2 ));
 	Real max_allowed = std::min( sqrt(S2( 1,0,0 )), sqrt(S2( 0,1,0 )) );
 	max_allowed = std::min( max_allowed, sqrt(S2( 0,0,1 )) );
@@ -1166,7 +1230,9 @@ ElectronDensity::scaleIntensities(
 	utility::vector1< core::Real > scale_i,
 	core::Real maxreso, core::Real minreso,
 	bool S2_bin/*=false*/ ) {
-	if ( Fdensity_.u1() == 0 ) numeric::fourier::fft3(density, Fdensity_);
+	load_dense_map();
+
+	if ( Fdensity_.u1() == 0 ) numeric::fourier::fft3(density, Fdensity_, fft_job_runner());
 	Size nbuckets = scale_i.size();
 
 	Real min_allowed = sqrt(S2( density.u1()/2, density.u2()/2, density.u3()/2 ));
@@ -1216,7 +1282,7 @@ ElectronDensity::scaleIntensities(
 			}
 		}
 	}
-	numeric::fourier::ifft3(Fdensity_, density);
+	numeric::fourier::ifft3(Fdensity_, density, fft_job_runner());
 
 	// clear derived data
 	density_change_trigger();
@@ -1225,7 +1291,9 @@ ElectronDensity::scaleIntensities(
 
 void
 ElectronDensity::reciprocalSpaceFilter( core::Real maxreso, core::Real minreso, core::Real fadewidth ) {
-	numeric::fourier::fft3(density, Fdensity_);
+	load_dense_map();
+
+	numeric::fourier::fft3(density, Fdensity_, fft_job_runner());
 
 	//int H,K,L;
 	for ( int z=1; z<=(int)density.u3(); ++z ) {
@@ -1256,7 +1324,7 @@ ElectronDensity::reciprocalSpaceFilter( core::Real maxreso, core::Real minreso,
 			}
 		}
 	}
-	numeric::fourier::ifft3(Fdensity_, density);
+	numeric::fourier::ifft3(Fdensity_, density, fft_job_runner());
 
 	// clear derived data
 	density_change_trigger();
@@ -1265,6 +1333,8 @@ ElectronDensity::reciprocalSpaceFilter( core::Real maxreso, core::Real minreso,
 
 core::Real
 ElectronDensity::getRSCC( ObjexxFCL::FArray3D< double > const &density2,  ObjexxFCL::FArray3D< double > const &mask) {
+	load_dense_map();
+
 	runtime_assert( density.u1()==density2.u1() && density.u2()==density2.u2() && density.u3()==density2.u3() );
 
 	core::Real sumC_i=0, sumO_i=0, sumCO_i=0, vol_i=0, CC_i=0;
@@ -1293,7 +1363,8 @@ ElectronDensity::getRSCC( ObjexxFCL::FArray3D< double > const &density2,  Objexx
 
 core::Real
 ElectronDensity::maxNominalRes() {
-	Real S = (1/sqrt(3.)) * sqrt(S2( density.u1()/2, density.u2()/2, density.u3()/2 ));
+	numeric::xyzVector< int > dims( map_dims() );
+	Real S = (1/sqrt(3.)) * sqrt(S2( dims[0]/2, dims[1]/2, dims[2]/2 ));
 	return 1.0/S;
 }
 
@@ -1307,6 +1378,7 @@ ElectronDensity::calcRhoC(
 	core::Real fixed_mask_B /* = -1 */,
 	core::Real B_upper_limit /* = 600 */,
 	core::Real force_mask /*=-1*/ ) {
+	load_dense_map();
 
 	// get rho_c
 	rhoC.dimension(density.u1() , density.u2() , density.u3());
@@ -1417,7 +1489,7 @@ ElectronDensity::calcRhoC(
 
 	// bandlimit mask at 'radius'
 	ObjexxFCL::FArray3D< std::complex<double> > Fmask;
-	numeric::fourier::fft3(mask, Fmask);
+	numeric::fourier::fft3(mask, Fmask, fft_job_runner());
 	//int H,K,L;
 	for ( int z=1; z<=(int)grid_[2]; ++z ) {
 		int H = (z < (int)grid_[2]/2) ? z-1 : z-grid_[2] - 1;
@@ -1433,7 +1505,7 @@ ElectronDensity::calcRhoC(
 			}
 		}
 	}
-	numeric::fourier::ifft3(Fmask, mask);
+	numeric::fourier::ifft3(Fmask, mask, fft_job_runner());
 }
 
 
@@ -1462,6 +1534,114 @@ void ElectronDensity::setup_fastscoring_first_time(core::pose::Pose const &pose)
 }
 
 
+namespace {
+
+// the offset from the kernel center of (1-based) point i of a kernel axis of m points, on a map axis of n points:
+//    as in an FFT of the whole map if m==n, otherwise wrapped about the middle of the kernel;
+//    false if the kernel of the whole map lacks that offset
+bool
+fastdens_kernel_offset( int i, int m, int n, int & offset ) {
+	if ( m == n ) {
+		offset = ( i < n/2 ) ? i-1 : i-n-1;
+		return true;
+	}
+	offset = ( i-1 <= m/2 ) ? i-1 : i-1-m;
+	return offset <= n/2-2 && offset >= n/2-n-1;
+}
+
+// mask of the fast density kernel of blurring constant k
+core::Real
+fastdens_mask_sq( core::Real k ) {
+	core::Real C = pow(k, 1.5);
+	return (1.0/k) * (std::log( C ) - std::log(1e-4));  // very generous mask (rho<1e-5)
+}
+
+// fill rhoc (zeroed) with the fast density kernel of blurring constant k
+//    the kernel need not be the size of the map (fastgrid); offsets then wrap about its middle
+void
+fastdens_kernel(
+	core::Real k,
+	numeric::xyzMatrix< core::Real > const & f2c,
+	numeric::xyzVector< int > const & fastgrid,
+	core::Real VV,
+	utility::vector1< core::Real > const & fastdens_params,
+	ObjexxFCL::FArray3D< double > & rhoc
+) {
+	if ( k <= 0 ) return;
+
+	core::Real C = pow(k, 1.5);
+	core::Real ATOM_MASK_SQ = fastdens_mask_sq( k );
+	core::Real scale = std::pow( k, -fastdens_params[1] ) - fastdens_params[2];
+
+	numeric::xyzVector< core::Real > del_ij;
+	int offset;
+	for ( int z=1; z<=rhoc.u3(); ++z ) {
+		if ( !fastdens_kernel_offset( z, rhoc.u3(), fastgrid[2], offset ) ) continue;
+		del_ij[2] = ((core::Real)offset) / fastgrid[2];
+		del_ij[0] = del_ij[1] = 0.0;
+		if ( (f2c*del_ij).length_squared() > ATOM_MASK_SQ ) continue;  // early exit
+		for ( int y=1; y<=rhoc.u2(); ++y ) {
+			if ( !fastdens_kernel_offset( y, rhoc.u2(), fastgrid[1], offset ) ) continue;
+			del_ij[1] = ((core::Real)offset) / fastgrid[1];
+			del_ij[0] = 0.0;
+			if ( (f2c*del_ij).length_squared() > ATOM_MASK_SQ ) continue;  // early exit
+			for ( int x=1; x<=rhoc.u1(); ++x ) {
+				if ( !fastdens_kernel_offset( x, rhoc.u1(), fastgrid[0], offset ) ) continue;
+				del_ij[0] = ((core::Real)offset) / fastgrid[0];
+				numeric::xyzVector< core::Real > cart_del_ij = (f2c*del_ij);
+				core::Real d2 = (cart_del_ij).length_squared();
+				if ( d2 <= ATOM_MASK_SQ ) {
+					// standardize density & convert to an approximate CC
+					// this has been minimally tuned but might be improved
+					rhoc(x,y,z) = C*VV*exp(-k*d2) * scale;
+				}
+			}
+		}
+	}
+}
+
+}
+
+// the blurring constant of a temperature bin of the fast density score
+core::Real
+ElectronDensity::fastdens_bin_k( core::Size kbin ) const {
+	core::Real k = (kbin-1)*kstep_ + kmin_;
+
+	if ( nkbins_ == 1 ) {
+		OneGaussianScattering S = get_A( "C" );
+		k = std::min ( S.k(0), 4*M_PI*M_PI/effectiveB );
+	}
+
+	if ( k>0 ) {
+		k = std::min ( k, 4*M_PI*M_PI/minimumB );
+	}
+	return k;
+}
+
+bool
+ElectronDensity::fastdens_ready() const {
+	if ( bricks_ ) return fastdens_bricks_ != nullptr;
+	return fastdens_score.u1()*fastdens_score.u2()*fastdens_score.u3()*fastdens_score.u4() != 0;
+}
+
+core::Real
+ElectronDensity::fastdens_interp( core::Real kbin, numeric::xyzVector< core::Real > const & idxX ) {
+	if ( fastdens_bricks_ ) return fastdens_bricks_->interp( kbin, idxX );
+	return interp_spline( fastdens_score , kbin, idxX );
+}
+
+void
+ElectronDensity::fastdens_dinterp(
+	numeric::xyzVector< core::Real > const & idxX, core::Real kbin,
+	numeric::xyzVector< core::Real > & gradX, core::Real & gradKbin
+) {
+	if ( fastdens_bricks_ ) {
+		fastdens_bricks_->dinterp( idxX, kbin, gradX, gradKbin );
+		return;
+	}
+	interp_dspline( fastdens_score , idxX , kbin, gradX, gradKbin );
+}
+
 void ElectronDensity::setup_fastscoring_first_time(Real scalefactor) {
 	fastgrid = grid_;
 	fastorigin = origin_;
@@ -1475,14 +1655,6 @@ void ElectronDensity::setup_fastscoring_first_time(Real scalefactor) {
 		fastdens_params.push_back( 0.6 );
 	}
 
-	ObjexxFCL::FArray3D< double > rhoc, fastdens_score_i;
-	ObjexxFCL::FArray3D< std::complex<double> > Frhoo, Frhoc;
-	rhoc.dimension(fastgrid[0], fastgrid[1], fastgrid[2]);
-
-	fastdens_score.dimension( density.u1(), density.u2(), density.u3(), nkbins_);
-
-	core::Real max_val = 0.0, min_val = 0.0;
-
 	// compute k limits (corresponding to B=0 and B=1000)
 	OneGaussianScattering S_C = get_A( "C" );
 	OneGaussianScattering S_O = get_A( "O" );
@@ -1499,66 +1671,28 @@ void ElectronDensity::setup_fastscoring_first_time(Real scalefactor) {
 		kstep_ = 0.0;
 	}
 
-	numeric::fourier::fft3(density, Frhoo);
-
-	for ( uint kbin = nkbins_; kbin >= 1; --kbin ) {
-		rhoc = 0.0;
-		numeric::xyzVector< core::Real > del_ij;
-		core::Real k = (kbin-1)*kstep_ + kmin_;
+	if ( bricks_ ) {
+		setup_fastscoring_bricked( scalefactor, fastdens_params );
+		return;
+	}
 
-		if ( nkbins_ == 1 ) {
-			OneGaussianScattering S = get_A( "C" );
-			//numeric::xyzVector< core::Real > del_ij;
-			k = std::min ( S.k(0), 4*M_PI*M_PI/effectiveB );
-		}
+	ObjexxFCL::FArray3D< double > rhoc, fastdens_score_i;
+	ObjexxFCL::FArray3D< std::complex<double> > Frhoo, Frhoc;
+	rhoc.dimension(fastgrid[0], fastgrid[1], fastgrid[2]);
 
-		if ( k>0 ) {
-			k = std::min ( k, 4*M_PI*M_PI/minimumB );
+	fastdens_score.dimension( density.u1(), density.u2(), density.u3(), nkbins_);
 
-			core::Real C = pow(k, 1.5);
-			core::Real ATOM_MASK_SQ = (1.0/k) * (std::log( C ) - std::log(1e-4));  // very generous mask (rho<1e-5)
-			core::Real VV = voxel_volume();
+	core::Real max_val = 0.0, min_val = 0.0;
 
-			for ( int z=1; z<=(int)fastgrid[2]; ++z ) {
-				if ( z < (int)fastgrid[2]/2 ) {
-					del_ij[2] = ((core::Real)z - 1.0) / fastgrid[2];
-				} else {
-					del_ij[2] = (((core::Real)z - fastgrid[2] - 1.0)) / fastgrid[2];
-				}
-				del_ij[0] = del_ij[1] = 0.0;
-				if ( (f2c*del_ij).length_squared() > ATOM_MASK_SQ ) continue;  // early exit
-				for ( int y=1; y<=(int)fastgrid[1]; ++y ) {
-					if ( y < (int)fastgrid[1]/2 ) {
-						del_ij[1] = ((core::Real)y - 1.0) / fastgrid[1] ;
-					} else {
-						del_ij[1] = (((core::Real)y - fastgrid[1] - 1.0)) / fastgrid[1];
-					}
-					del_ij[0] = 0.0;
-					if ( (f2c*del_ij).length_squared() > ATOM_MASK_SQ ) continue;  // early exit
-					for ( int x=1; x<=(int)fastgrid[0]; ++x ) {
-						if ( x < (int)fastgrid[0]/2 ) {
-							del_ij[0] = ((core::Real)x - 1.0) / fastgrid[0];
-						} else {
-							del_ij[0] = (((core::Real)x - fastgrid[0] - 1.0)) / fastgrid[0];
-						}
-						numeric::xyzVector< core::Real > cart_del_ij = (f2c*del_ij);
-						core::Real d2 = (cart_del_ij).length_squared();
-						if ( d2 <= ATOM_MASK_SQ ) {
-							rhoc(x,y,z) = C*VV*exp(-k*d2);
-						}
-					}
-				}
-			}
+	numeric::fourier::fft3(density, Frhoo, fft_job_runner());
 
-			// standardize density & convert to an approximate CC
-			// this has been minimally tuned but might be improved
-			for ( int i=0; i<fastgrid[0]*fastgrid[1]*fastgrid[2]; ++i ) {
-				rhoc[i] = rhoc[i] * (std::pow( k, -fastdens_params[1] ) - fastdens_params[2]);
-			}
-		}
+	for ( uint kbin = nkbins_; kbin >= 1; --kbin ) {
+		rhoc = 0.0;
+		core::Real k = fastdens_bin_k( kbin );
+		fastdens_kernel( k, f2c, fastgrid, voxel_volume(), fastdens_params, rhoc );
 
 		// ffts
-		numeric::fourier::fft3(rhoc, Frhoc);
+		numeric::fourier::fft3(rhoc, Frhoc, fft_job_runner());
 		Frhoc(1,1,1) = Frhoo(1,1,1) = 0.0;
 
 		TR << "Bin " << kbin << ":  B(C/N/O/S)=" << S_C.B(k) << " / " << S_N.B(k) << " / " << S_O.B(k) << " / " <<
@@ -1573,7 +1707,7 @@ void ElectronDensity::setup_fastscoring_first_time(Real scalefactor) {
 				}
 			}
 		}
-		numeric::fourier::ifft3( Frhoc , fastdens_score_i );
+		numeric::fourier::ifft3( Frhoc , fastdens_score_i, fft_job_runner() );
 
 		// copy to big array
 		for ( int i=1; i<=density.u1(); i++ ) {
@@ -1625,8 +1759,76 @@ void ElectronDensity::setup_fastscoring_first_time(Real scalefactor) {
 }
 
 
+// fast density scoring data of a bricked map
+//    the scores are computed brick by brick, as needed, by FFT convolution of the bricks (and a margin as wide
+//    as the kernel) with the kernel; their normalization needs the scores of the whole map, which are streamed
+//    block by block but not kept
+void ElectronDensity::setup_fastscoring_bricked(Real scalefactor, utility::vector1< core::Real > const & fastdens_params) {
+	DensityBricksCOP const bricks( bricks_ );
+	numeric::xyzVector< int > const dims( bricks->dims() );
+
+	utility::vector1< core::Real > ks( nkbins_ );
+	core::Real max_mask_sq = 0.0;
+	for ( uint kbin = 1; kbin <= nkbins_; ++kbin ) {
+		ks[kbin] = fastdens_bin_k( kbin );
+		if ( ks[kbin] > 0 ) max_mask_sq = std::max( max_mask_sq, fastdens_mask_sq( ks[kbin] ) );
+		TR << "Bin " << kbin << ":  B(C/N/O/S)=" << get_A( "C" ).B(ks[kbin]) << " / " << get_A( "N" ).B(ks[kbin]) << " / "
+			<< get_A( "O" ).B(ks[kbin]) << " / " << get_A( "S" ).B(ks[kbin]) << std::endl;
+	}
+	numeric::xyzVector< int > const radius( mask_radius( std::sqrt( max_mask_sq ), fastgrid ) );
+
+	numeric::xyzMatrix< core::Real > const f2c_copy( f2c );
+	numeric::xyzVector< int > const grid_copy( fastgrid );
+	core::Real const VV = voxel_volume();
+	DensityBricks::KernelFunction const kernel(
+		[=]( core::Size slab, ObjexxFCL::FArray3D< double > & rhoc ) {
+			fastdens_kernel( ks[slab], f2c_copy, grid_copy, VV, fastdens_params, rhoc );
+		} );
+
+	// normalization
+	//    [0.5% -- 99.5%] in min temp bin
+	core::Size cutat = 5;
+	std::priority_queue< core::Real > lowest;
+	std::priority_queue< core::Real, std::vector< core::Real >, std::greater< core::Real > > highest;
+	core::Size const top_bin( nkbins_ );
+	DensityBricks::KernelFunction const top_kernel(
+		[&kernel,top_bin]( core::Size, ObjexxFCL::FArray3D< double > & rhoc ) { kernel( top_bin, rhoc ); } );
+	int const block = 4*bricks->brick_size();
+	ObjexxFCL::FArray4D< double > scores_i;
+	numeric::xyzVector< int > lo;
+	for ( lo[2] = 0; lo[2] < dims[2]; lo[2] += block ) {
+		for ( lo[1] = 0; lo[1] < dims[1]; lo[1] += block ) {
+			for ( lo[0] = 0; lo[0] < dims[0]; lo[0] += block ) {
+				scores_i.dimension( std::min( block, dims[0]-lo[0] ), std::min( block, dims[1]-lo[1] ), std::min( block, dims[2]-lo[2] ), 1 );
+				bricks->convolve_box( lo, radius, dens_mean, top_kernel, fft_job_runner(), scores_i );
+				for ( core::Size i=0; i<scores_i.size(); ++i ) {
+					lowest.push( scores_i[i] );
+					if ( lowest.size() > cutat ) lowest.pop();
+					highest.push( scores_i[i] );
+					if ( highest.size() > cutat ) highest.pop();
+				}
+			}
+		}
+	}
+	core::Real min_val = lowest.empty() ? 0.0 : lowest.top();
+	core::Real max_val = highest.empty() ? 0.0 : highest.top();
+
+	core::Real mu=0.0, sigma=0.5*scalefactor*(max_val-min_val);
+	core::Real const shift( dens_mean );
+	fastdens_bricks_ = SplineBricksOP( new SplineBricks( dims, nkbins_, bricks->brick_size(),
+		[bricks,radius,shift,kernel,mu,sigma]( numeric::xyzVector< int > const & lo, ObjexxFCL::FArray4D< double > & samples ) {
+			bricks->convolve_box( lo, radius, shift, kernel, numeric::fourier::FFTJobRunner(), samples );
+			for ( core::Size i=0; i<samples.size(); ++i ) {
+				samples[i] = (samples[i]-mu)/sigma;
+			}
+		} ) );
+}
+
+
 // use a pose to rescale the fastscoring bins so they correspond to RSCC
 void ElectronDensity::rescale_fastscoring_temp_bins(core::pose::Pose const &pose, bool initBs) {
+	load_dense_map();
+
 	if ( fastdens_score.u1()*fastdens_score.u2()*fastdens_score.u3()*fastdens_score.u4() == 0 ) {
 		setup_fastscoring_first_time(pose);
 	}
@@ -1884,6 +2086,8 @@ core::Real ElectronDensity::matchRes(
 	core::conformation::symmetry::SymmetryInfoCOP symmInfo /*=NULL*/,
 	bool cacheCCs /* = false */
 ) {
+	load_dense_map();
+
 	// make sure map is loaded
 	if ( !isLoaded_ ) {
 		TR.Error << "ElectronDensity::matchRes called but no map is loaded!\n";
@@ -2275,7 +2479,7 @@ ElectronDensity::matchResFast(
 		return 0.0;
 	}
 
-	if ( fastdens_score.u1()*fastdens_score.u2()*fastdens_score.u3()*fastdens_score.u4() == 0 ) {
+	if ( !fastdens_ready() ) {
 		setup_fastscoring_first_time(pose);
 	}
 
@@ -2312,7 +2516,7 @@ ElectronDensity::matchResFast(
 		idxX = numeric::xyzVector<core::Real>( fracX[0]*fastgrid[0] - fastorigin[0] + 1,
 			fracX[1]*fastgrid[1] - fastorigin[1] + 1,
 			fracX[2]*fastgrid[2] - fastorigin[2] + 1);
-		core::Real score_i = interp_spline( fastdens_score , kbin, idxX );
+		core::Real score_i = fastdens_interp( kbin, idxX );
 		core::Real W = sig_j.a(  ) / 6.0;
 		if ( i>rsd.last_backbone_atom() ) {
 			W *= sc_scale;
@@ -2339,7 +2543,7 @@ ElectronDensity::matchAtomFast(
 		return 0.0;
 	}
 
-	if ( fastdens_score.u1()*fastdens_score.u2()*fastdens_score.u3()*fastdens_score.u4() == 0 ) {
+	if ( !fastdens_ready() ) {
 		setup_fastscoring_first_time(pose);
 	}
 
@@ -2376,7 +2580,7 @@ ElectronDensity::matchAtomFast(
 	idxX = numeric::xyzVector<core::Real>( fracX[0]*fastgrid[0] - fastorigin[0] + 1,
 		fracX[1]*fastgrid[1] - fastorigin[1] + 1,
 		fracX[2]*fastgrid[2] - fastorigin[2] + 1);
-	core::Real score_i = interp_spline( fastdens_score , kbin, idxX );
+	core::Real score_i = fastdens_interp( kbin, idxX );
 	core::Real W = sig_j.a(  ) / 6.0;
 	score += W*score_i;
 
@@ -2395,7 +2599,7 @@ ElectronDensity::matchPointFast(
 		return 0.0;
 	}
 
-	if ( fastdens_score.u1()*fastdens_score.u2()*fastdens_score.u3()*fastdens_score.u4() == 0 ) {
+	if ( !fastdens_ready() ) {
 		setup_fastscoring_first_time(0.1);
 	}
 
@@ -2405,7 +2609,7 @@ ElectronDensity::matchPointFast(
 	idxX[0] = pos_mod (fracX[0]*fastgrid[0] - fastorigin[0] + 1 , (double)fastgrid[0]);
 	idxX[1] = pos_mod (fracX[1]*fastgrid[1] - fastorigin[1] + 1 , (double)fastgrid[1]);
 	idxX[2] = pos_mod (fracX[2]*fastgrid[2] - fastorigin[2] + 1 , (double)fastgrid[2]);
-	core::Real score_i = interp_spline( fastdens_score , kbin, idxX );
+	core::Real score_i = fastdens_interp( kbin, idxX );
 
 	return score_i;
 }
@@ -2422,7 +2626,7 @@ ElectronDensity::dCCdx_PointFast(
 		return;
 	}
 
-	if ( fastdens_score.u1()*fastdens_score.u2()*fastdens_score.u3()*fastdens_score.u4() == 0 ) {
+	if ( !fastdens_ready() ) {
 		setup_fastscoring_first_time(0.1);
 	}
 
@@ -2434,7 +2638,7 @@ ElectronDensity::dCCdx_PointFast(
 	idxX[0] = pos_mod (fracX[0]*fastgrid[0] - fastorigin[0] + 1 , (double)fastgrid[0]);
 	idxX[1] = pos_mod (fracX[1]*fastgrid[1] - fastorigin[1] + 1 , (double)fastgrid[1]);
 	idxX[2] = pos_mod (fracX[2]*fastgrid[2] - fastorigin[2] + 1 , (double)fastgrid[2]);
-	interp_dspline( fastdens_score , idxX, kbin,  dCCdX_grid, dkbin );
+	fastdens_dinterp( idxX, kbin, dCCdX_grid, dkbin );
 
 	dCCdX[0] = dCCdX_grid[0]*c2f(1,1)*fastgrid[0] + dCCdX_grid[1]*c2f(2,1)*fastgrid[1] + dCCdX_grid[2]*c2f(3,1)*fastgrid[2];
 	dCCdX[1] = dCCdX_grid[0]*c2f(1,2)*fastgrid[0] + dCCdX_grid[1]*c2f(2,2)*fastgrid[1] + dCCdX_grid[2]*c2f(3,2)*fastgrid[2];
@@ -2456,7 +2660,7 @@ void ElectronDensity::dCCdx_fastRes(
 		return;
 	}
 
-	if ( fastdens_score.u1()*fastdens_score.u2()*fastdens_score.u3()*fastdens_score.u4() == 0 ) {
+	if ( !fastdens_ready() ) {
 		setup_fastscoring_first_time(pose);
 	}
 
@@ -2486,7 +2690,7 @@ void ElectronDensity::dCCdx_fastRes(
 	core::Real dkbin;
 
 	core::Real W = sig_j.a(  ) / 6.0;
-	interp_dspline( fastdens_score , idxX, kbin,  dCCdX_grid, dkbin );
+	fastdens_dinterp( idxX, kbin, dCCdX_grid, dkbin );
 	dCCdX[0] = W*dCCdX_grid[0]*c2f(1,1)*fastgrid[0] + W*dCCdX_grid[1]*c2f(2,1)*fastgrid[1] + W*dCCdX_grid[2]*c2f(3,1)*fastgrid[2];
 	dCCdX[1] = W*dCCdX_grid[0]*c2f(1,2)*fastgrid[0] + W*dCCdX_grid[1]*c2f(2,2)*fastgrid[1] + W*dCCdX_grid[2]*c2f(3,2)*fastgrid[2];
 	dCCdX[2] = W*dCCdX_grid[0]*c2f(1,3)*fastgrid[0] + W*dCCdX_grid[1]*c2f(2,3)*fastgrid[1] + W*dCCdX_grid[2]*c2f(3,3)*fastgrid[2];
@@ -2506,7 +2710,7 @@ ElectronDensity::dCCdB_fastRes(
 		return 0;
 	}
 
-	if ( fastdens_score.u1()*fastdens_score.u2()*fastdens_score.u3()*fastdens_score.u4() == 0 ) {
+	if ( !fastdens_ready() ) {
 		setup_fastscoring_first_time(pose);
 	}
 
@@ -2536,7 +2740,7 @@ ElectronDensity::dCCdB_fastRes(
 
 	numeric::xyzVector<core::Real> dCCdX_grid;
 	core::Real dscore_dkbin=0.0, dscore_dk;
-	interp_dspline( fastdens_score , idxX, kbin,  dCCdX_grid, dscore_dkbin );
+	fastdens_dinterp( idxX, kbin, dCCdX_grid, dscore_dkbin );
 	dscore_dk = dscore_dkbin / kstep_;
 
 	core::Real W = sig_j.a(  ) / 6.0;
@@ -2552,6 +2756,8 @@ ElectronDensity::dCCdBs(
 	utility::vector1< core::Real>  & dE_dvars,
 	ObjexxFCL::FArray3D< double > &maskC
 ) {
+	load_dense_map();
+
 	// 1 get rhoc
 	core::scoring::electron_density::poseCoords litePose;
 
@@ -2775,6 +2981,18 @@ ElectronDensity::readMRCandResize(
 	core::Real reso,
 	core::Real gridSpacing
 ) {
+	// a bricked map is read through a mapping of the file, which it then keeps
+	if ( basic::options::option[ basic::options::OptionKeys::edensity::bricked_map ]() ) {
+		utility::io::MappedFileOP mapped( new utility::io::MappedFile( mapfile ) );
+		if ( !mapped->is_open() ) {
+			TR.Error << "Error opening MRC map " << mapfile << ".  Not loading map." << std::endl;
+			return false;
+		}
+		utility::io::MemoryStreamBuf buf( mapped->data(), mapped->size() );
+		std::istream mapin( &buf );
+		return readMRCandResize(mapin, mapfile, reso, gridSpacing, mapped);
+	}
+
 	std::ifstream mapin(mapfile.c_str() , std::ios::binary | std::ios::in );
 	bool const isLoaded( readMRCandResize(mapin, mapfile, reso, gridSpacing) );
 	mapin.close();
@@ -2782,14 +3000,25 @@ ElectronDensity::readMRCandResize(
 	return isLoaded;
 }
 
-// ElectronDensity::readMRC(std::istream mapfile)
-//      read an MRC/CCP4 density map
 bool
 ElectronDensity::readMRCandResize(
 	std::istream & mapin,
 	std::string mapfile,
 	core::Real reso,
 	core::Real gridSpacing
+) {
+	return readMRCandResize(mapin, mapfile, reso, gridSpacing, utility::io::MappedFileCOP());
+}
+
+// ElectronDensity::readMRC(std::istream mapfile)
+//      read an MRC/CCP4 density map; if mapped is the mapping of the map file, read it brick by brick
+bool
+ElectronDensity::readMRCandResize(
+	std::istream & mapin,
+	std::string mapfile,
+	core::Real reso,
+	core::Real gridSpacing,
+	utility::io::MappedFileCOP mapped
 ) {
 	char mapString[4], symData[81];
 
@@ -2949,44 +3178,60 @@ ElectronDensity::readMRCandResize(
 	vol_zsize = extent[zIndex];
 	vol_xySize = vol_xsize * vol_ysize;
 
+	// a map covering the unit cell, at the sampling of the file, may be left in the file and read brick by brick
+	bricks_.reset();
+	if ( mapped ) {
+		if ( vol_xsize == grid[0] && vol_ysize == grid[1] && vol_zsize == grid[2] && gridSpacing <= 0 ) {
+			int const brick_size( basic::options::option[ basic::options::OptionKeys::edensity::brick_size ]() );
+			TR << " Reading the map brick by brick (" << brick_size << "^3 voxels)" << std::endl;
+			density.clear();
+			bricks_ = DensityBricksOP( new DensityBricks( mapped, dataOffset, extent, xyz2crs, swap, brick_size ) );
+		} else {
+			TR.Warning << "Only uncompressed maps covering the unit cell, that are not resampled, can be read brick by brick.  "
+				<< "Loading the whole map." << std::endl;
+		}
+	}
+
 	// coord = <col, row, sec>
 	// extent = <colSize, rowSize, secSize>
-	rowdata = new float[extent[0]];
-	mapin.seekg(dataOffset, std::ios::beg);
-
-	// 'alloc' changes ordering of "extent"
-	density.dimension( vol_xsize,vol_ysize,vol_zsize );
-
-	for ( coord[2] = 1; coord[2] <= extent[2]; coord[2]++ ) {
-		for ( coord[1] = 1; coord[1] <= extent[1]; coord[1]++ ) {
-			// Read an entire row of data from the file, then write it into the
-			// datablock with the correct slice ordering.
-			if ( mapin.eof() ) {
-				TR.Error << "Unexpected end-of-file. Not loading map." << std::endl;
-				delete [] rowdata;
-				return false;
-			}
-			if ( mapin.fail() ) {
-				TR.Error << "Problem reading the file. Not loading map." << std::endl;
-				delete [] rowdata;
-				return false;
-			}
-			if ( !mapin.read( reinterpret_cast< char* >(rowdata), sizeof(float)*extent[0]) ) {
-				TR << "Error reading data row. Not loading map." << std::endl;
-				delete [] rowdata;
-				return false;
-			}
+	if ( !bricks_ ) {
+		rowdata = new float[extent[0]];
+		mapin.seekg(dataOffset, std::ios::beg);
+
+		// 'alloc' changes ordering of "extent"
+		density.dimension( vol_xsize,vol_ysize,vol_zsize );
+
+		for ( coord[2] = 1; coord[2] <= extent[2]; coord[2]++ ) {
+			for ( coord[1] = 1; coord[1] <= extent[1]; coord[1]++ ) {
+				// Read an entire row of data from the file, then write it into the
+				// datablock with the correct slice ordering.
+				if ( mapin.eof() ) {
+					TR.Error << "Unexpected end-of-file. Not loading map." << std::endl;
+					delete [] rowdata;
+					return false;
+				}
+				if ( mapin.fail() ) {
+					TR.Error << "Problem reading the file. Not loading map." << std::endl;
+					delete [] rowdata;
+					return false;
+				}
+				if ( !mapin.read( reinterpret_cast< char* >(rowdata), sizeof(float)*extent[0]) ) {
+					TR << "Error reading data row. Not loading map." << std::endl;
+					delete [] rowdata;
+					return false;
+				}
 
-			for ( coord[0] = 1; coord[0] <= extent[0]; coord[0]++ ) {
-				density( coord[xyz2crs[0]], coord[xyz2crs[1]], coord[xyz2crs[2]]) = rowdata[coord[0]-1];
+				for ( coord[0] = 1; coord[0] <= extent[0]; coord[0]++ ) {
+					density( coord[xyz2crs[0]], coord[xyz2crs[1]], coord[xyz2crs[2]]) = rowdata[coord[0]-1];
+				}
 			}
 		}
-	}
 
-	if ( swap == 1 ) {
-		swap4_aligned( &density[0], vol_xySize * vol_zsize);
+		if ( swap == 1 ) {
+			swap4_aligned( &density[0], vol_xySize * vol_zsize);
+		}
+		delete [] rowdata;
 	}
-	delete [] rowdata;
 
 	origin_[0] = origin[xyz2crs[0]];
 	origin_[1] = origin[xyz2crs[1]];
@@ -3084,7 +3329,7 @@ ElectronDensity::readMRCandResize(
 // expand density to cover complete unit cell
 // maintain origin
 void ElectronDensity::expandToUnitCell() {
-	numeric::xyzVector< int > extent( density.u1(), density.u2(), density.u3() );
+	numeric::xyzVector< int > extent( map_dims() );
 
 	// if it already covers unit cell do nothing
 	if ( grid_[0] == extent[0] && grid_[1] == extent[1] && grid_[2] == extent[2] ) {
@@ -3196,6 +3441,8 @@ void ElectronDensity::initializeSymmOps( utility::vector1< std::string > const &
 
 
 bool ElectronDensity::writeMRC(std::string mapfilename) {
+	load_dense_map();
+
 	std::fstream outx( (mapfilename).c_str() , std::ios::binary | std::ios::out );
 
 	float buff_f;
@@ -3288,12 +3535,36 @@ bool ElectronDensity::writeMRC(std::string mapfilename) {
 	return true;
 }
 
+core::Real
+ElectronDensity::get(int i, int j, int k) {
+	if ( bricks_ ) return bricks_->voxel( i, j, k );
+	return density(i,j,k);
+}
+
+SplineBricks const &
+ElectronDensity::coeffs_density_bricks() {
+	if ( !coeffs_density_bricks_ ) {
+		DensityBricksCOP const bricks( bricks_ );
+		coeffs_density_bricks_ = SplineBricksOP( new SplineBricks( bricks->dims(), 1, bricks->brick_size(),
+			[bricks]( numeric::xyzVector< int > const & lo, ObjexxFCL::FArray4D< double > & samples ) {
+				ObjexxFCL::FArray3D< double > box( samples.u1(), samples.u2(), samples.u3() );
+				bricks->read_box( lo, numeric::xyzVector< int >( samples.u1(), samples.u2(), samples.u3() ), 0.0, box );
+				for ( core::Size i = 0; i < box.size(); ++i ) samples[ i ] = box[ i ];
+			} ) );
+	}
+	return *coeffs_density_bricks_;
+}
+
 core::Real
 ElectronDensity::get(numeric::xyzVector<core::Real> X) {
 	if ( !isLoaded_ ) {
 		utility_exit_with_message("ElectronDensity::get_interp_dens called but no map is loaded!");
 	}
 
+	if ( bricks_ ) {
+		return coeffs_density_bricks().interp( 1.0, X );
+	}
+
 	if ( coeffs_density_.u1()*coeffs_density_.u2()*coeffs_density_.u3() == 0 ) {
 		spline_coeffs( density , coeffs_density_ );
 	}
@@ -3307,6 +3578,13 @@ ElectronDensity::grad(numeric::xyzVector<core::Real> X) {
 		utility_exit_with_message("ElectronDensity::get_interp_dens called but no map is loaded!");
 	}
 
+	if ( bricks_ ) {
+		numeric::xyzVector< core::Real > gradX;
+		core::Real gradSlab;
+		coeffs_density_bricks().dinterp( X, 1.0, gradX, gradSlab );
+		return gradX;
+	}
+
 	if ( coeffs_density_.u1()*coeffs_density_.u2()*coeffs_density_.u3() == 0 ) {
 		spline_coeffs( density , coeffs_density_ );
 	}
@@ -3336,24 +3614,78 @@ ElectronDensity::set_voxel_spacing( numeric::xyzVector<core::Real> apix ) {
 	//fpd no need for full density change trigger, just invalidate a few things
 	// Fdensity_ and coeffs_density_ are still valid
 	fastdens_score.clear();
+	fastdens_bricks_.reset();
 	fastgrid = numeric::xyzVector< core::Real >(0,0,0);
 }
 
 
 void ElectronDensity::density_change_trigger() {
 	fastdens_score.clear();
+	fastdens_bricks_.reset();
 	fastgrid = numeric::xyzVector< core::Real >(0,0,0);
 
 	Fdensity_.clear();
 	coeffs_density_.clear();
+	coeffs_density_bricks_.reset();
 
 	computeStats();
-	computeGradients();  // visualization only
+	if ( !bricks_ ) computeGradients();  // visualization only
+}
+
+// read all of a bricked map into density, once, leaving scoring bricked
+ObjexxFCL::FArray3D< float > const &
+ElectronDensity::get_data() const {
+	if ( !bricks_ ) return density;
+
+#ifdef MULTI_THREADED
+	std::lock_guard< std::mutex > lock( bricked_map_read_mutex_ );
+#endif
+	if ( density.size() == 0 ) {
+		numeric::xyzVector< int > const dims( bricks_->dims() );
+		TR.Warning << "Reading all of the bricked map (" << dims[0] << " x " << dims[1] << " x " << dims[2] << ", "
+			<< ( Size( dims[0] ) * dims[1] * dims[2] * sizeof( float ) ) / ( 1024 * 1024 )
+			<< " MB) into memory, which this protocol needs; the bricks are kept too." << std::endl;
+		bricks_->read_map( density );
+	}
+	return density;
+}
+
+// load all of a bricked map into density
+void ElectronDensity::load_dense_map() {
+	if ( !bricks_ ) return;
+
+	if ( density.size() == 0 ) {
+		TR.Warning << "Loading all of the bricked map (" << bricks_->dims()[0] << " x " << bricks_->dims()[1] << " x "
+			<< bricks_->dims()[2] << "), which this protocol needs." << std::endl;
+		bricks_->read_map( density );
+	}
+	bricks_.reset();
+	density_change_trigger();
+}
+
+numeric::xyzVector< int >
+ElectronDensity::map_dims() const {
+	if ( bricks_ ) return bricks_->dims();
+	return numeric::xyzVector< int >( density.u1(), density.u2(), density.u3() );
+}
+
+// grid points of grid within mask (A) of a point, along each axis:
+//    the extent of the sphere along fractional axis d is mask*|row d of c2f|
+numeric::xyzVector< int >
+ElectronDensity::mask_radius( core::Real mask, numeric::xyzVector< int > const & grid ) const {
+	numeric::xyzVector< int > radius;
+	for ( int d=0; d<3; ++d ) {
+		core::Real const rowlen = std::sqrt( square( c2f(d+1,1) ) + square( c2f(d+1,2) ) + square( c2f(d+1,3) ) );
+		radius[d] = (int) std::ceil( mask * rowlen * grid[d] );
+	}
+	return radius;
 }
 
 /////////////////////////////////////
 // resize a map (using FFT-interpolation)
 void ElectronDensity::resize( core::Real approxGridSpacing ) {
+	load_dense_map();
+
 	// potentially expand map to cover entire unit cell
 	if ( grid_[0] != density.u1() || grid_[1] != density.u2() || grid_[2] != density.u3() ) {
 		TR.Error << "resize() not supported for maps not covering the entire unit cell."<< std::endl;
@@ -3444,6 +3776,11 @@ void ElectronDensity::computeGradients() {
 /////////////////////////////////////
 // compute map statistics
 void ElectronDensity::computeStats() {
+	if ( bricks_ ) {
+		bricks_->compute_stats( dens_mean, dens_min, dens_max, dens_stdev );
+		return;
+	}
+
 	core::Real sum=0, sum2=0;
 	dens_max = -std::numeric_limits< core::Real >::max();
 	dens_min = std::numeric_limits< core::Real >::max();
@@ -22,10 +22,12 @@
 #include <core/scoring/electron_density/util.hh>
 #include <core/scoring/electron_density/xray_scattering.hh>
 #include <core/scoring/electron_density/ElectronDensity.fwd.hh>
+#include <core/scoring/electron_density/DensityBricks.fwd.hh>
 #include <core/conformation/symmetry/SymmetryInfo.hh>
 
 // Utility headers
 #include <utility/exit.hh>
+#include <utility/io/MappedFile.fwd.hh>
 
 // ObjexxFCL Headers
 #include <ObjexxFCL/FArray3D.hh>
@@ -380,12 +382,23 @@ public:
 		scoring_mask_.clear();
 	}
 
-	///@brief  access raw density data
-	inline ObjexxFCL::FArray3D< float > const & get_data() const { return density; };
+	///@brief  access raw density data; a bricked map is first read whole into memory (it stays
+	///   bricked for scoring)
+	///@details  the first call on a bricked map allocates the full dense map (4 bytes per voxel) on top
+	///   of the bricks and logs its size; the read is locked, so concurrent callers see one copy.
+	///   Callers that own the map and no longer need the bricks should call load_dense_map() instead.
+	ObjexxFCL::FArray3D< float > const & get_data() const;
+
+	///@brief  is the map read brick by brick from the map file, as needed? (-edensity::bricked_map)
+	inline bool is_bricked() const { return bricks_ != nullptr; }
+
+	///@brief  load all of a bricked map, which is then no longer bricked (does nothing for other maps)
+	void load_dense_map();
 
 	///@brief  set raw density data.  Assumes new map sampling grid same as current
 	template <class Q>
 	inline void set_data(ObjexxFCL::FArray3D< Q > const & density_in) {
+		load_dense_map();
 		runtime_assert(density.u1() == density_in.u1());
 		runtime_assert(density.u2() == density_in.u2());
 		runtime_assert(density.u3() == density_in.u3());
@@ -395,7 +408,7 @@ public:
 
 	///@brief get the density at a grid point
 	core::Real
-	get(int i, int j, int k) { return density(i,j,k); }
+	get(int i, int j, int k);
 
 	///@brief get the interpolated density at a point _in index space_
 	core::Real
@@ -506,10 +519,24 @@ public:
 	numeric::xyzVector<core::Real> dens_grad ( numeric::xyzVector<core::Real> const & idxX ) const;
 
 private:
+	/// @brief Load an MRC density map; if mapped is the mapping of the map file, read it brick by brick
+	bool readMRCandResize(
+		std::istream & mapin,
+		std::string mapfile,
+		core::Real reso,
+		core::Real gridSpacing,
+		utility::io::MappedFileCOP mapped );
+
 	/// @brief The function is called everytime the density changes
 	void
 	density_change_trigger();
 
+	/// @brief the size of the map along x, y and z (whether or not it is bricked)
+	numeric::xyzVector< int > map_dims() const;
+
+	/// @brief the number of grid points (of the given grid) along each axis within mask (A) of a point
+	numeric::xyzVector< int > mask_radius( core::Real mask, numeric::xyzVector< int > const & grid ) const;
+
 	// smooth an intensity spectrum
 	void
 	smooth_intensities(utility::vector1< core::Real > &) const;
@@ -525,13 +552,27 @@ private:
 	// setup fast density scoring data
 	void setup_fastscoring_first_time(core::pose::Pose const &pose);
 	void setup_fastscoring_first_time(Real scalefactor);
+	void setup_fastscoring_bricked(Real scalefactor, utility::vector1< core::Real > const & fastdens_params);
+
+	// the blurring constant k of a temperature bin of the fast density score (0 if none)
+	core::Real fastdens_bin_k( core::Size kbin ) const;
+
+	// fast density scoring data: are they set up?  and the score and its gradient, from fastdens_score or the bricks
+	bool fastdens_ready() const;
+	core::Real fastdens_interp( core::Real kbin, numeric::xyzVector< core::Real > const & idxX );
+	void fastdens_dinterp(
+		numeric::xyzVector< core::Real > const & idxX, core::Real kbin,
+		numeric::xyzVector< core::Real > & gradX, core::Real & gradKbin );
+
+	// spline coefficients of the density of a bricked map
+	SplineBricks const & coeffs_density_bricks();
 
 	// get Fdrho_d(xyz)
 	// compute if not already computed
 	utility::vector1< ObjexxFCL::FArray3D< std::complex<double> > * > getFdrhoc( OneGaussianScattering S );
 
 	// volume of 1 voxel
-	double voxel_volume( ) {
+	double voxel_volume( ) const {
 		return V / (grid_[0]*grid_[1]*grid_[2]);
 	}
 
@@ -540,12 +581,20 @@ private:
 	bool isLoaded_;
 
 	// the density data array and spline coeffs
-	ObjexxFCL::FArray3D< float > density;
+	//     ... mutable so that get_data() can read a bricked map into it on demand
+	mutable ObjexxFCL::FArray3D< float > density;
 	ObjexxFCL::FArray3D< double > coeffs_density_;
 
 	// fft of density -- only used in FSC calc
 	ObjexxFCL::FArray3D< std::complex<double> > Fdensity_;
 
+	// a bricked map (-edensity::bricked_map) is read from the mapped map file brick by brick, as needed,
+	//   and density is left empty until get_data() is called; the spline coefficients of the density and of the fast density score
+	//   are then computed brick by brick too
+	DensityBricksOP bricks_;
+	SplineBricksOP coeffs_density_bricks_;
+	SplineBricksOP fastdens_bricks_;
+
 	// Controllable parameters
 	std::map< core::Size, bool > scoring_mask_;
 	core::Real reso_, ATOM_MASK, CA_MASK, force_apix_on_map_load_, SC_scaling_;
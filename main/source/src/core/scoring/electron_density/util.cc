@@ -38,6 +38,11 @@
 // option key includes
 #include <basic/options/keys/edensity.OptionKeys.gen.hh>
 #include <basic/options/keys/patterson.OptionKeys.gen.hh>
+#include <basic/options/keys/multithreading.OptionKeys.gen.hh>
+
+#ifdef MULTI_THREADED
+#include <basic/thread_manager/RosettaThreadManager.hh>
+#endif
 
 #include <utility/vector1.hh>
 
@@ -185,21 +190,42 @@ void conj_map_times(ObjexxFCL::FArray3D< std::complex<double> > & map_product, O
 //∑[A(x) * B(y-x)] over y
 ObjexxFCL::FArray3D< double > convolute_maps( ObjexxFCL::FArray3D< double > const & mapA, ObjexxFCL::FArray3D< double > const & mapB) {
 
+	numeric::fourier::FFTJobRunner const runner( fft_job_runner() );
+
 	ObjexxFCL::FArray3D< std::complex<double> > FmapA;
-	numeric::fourier::fft3(mapA, FmapA);
+	numeric::fourier::fft3(mapA, FmapA, runner);
 
 	ObjexxFCL::FArray3D< std::complex<double> > FmapB;
-	numeric::fourier::fft3(mapB, FmapB);
+	numeric::fourier::fft3(mapB, FmapB, runner);
 
 	ObjexxFCL::FArray3D< std::complex<double> > Fconv_map;
 	conj_map_times(Fconv_map, FmapB, FmapA );
 
 	ObjexxFCL::FArray3D< double > conv_map;
-	numeric::fourier::ifft3(Fconv_map , conv_map);
+	numeric::fourier::ifft3(Fconv_map , conv_map, runner);
 
 	return conv_map;
 }
 
+numeric::fourier::FFTJobRunner
+fft_job_runner() {
+#ifdef MULTI_THREADED
+	Size nthreads( basic::options::option[ basic::options::OptionKeys::edensity::fft_threads ]() );
+	if ( nthreads == 0 ) nthreads = basic::options::option[ basic::options::OptionKeys::multithreading::total_threads ]();
+	if ( nthreads > 1 ) {
+		return [nthreads]( utility::vector1< std::function< void () > > const & jobs ) {
+			utility::vector1< basic::thread_manager::RosettaThreadFunctionOP > work_vector;
+			work_vector.reserve( jobs.size() );
+			for ( auto const & job : jobs ) {
+				work_vector.push_back( utility::pointer::make_shared< basic::thread_manager::RosettaThreadFunction >( job ) );
+			}
+			basic::thread_manager::RosettaThreadManager::get_instance()->do_work_vector_in_threads( work_vector, nthreads );
+		};
+	}
+#endif
+	return numeric::fourier::FFTJobRunner();
+}
+
 
 /// 4D interpolants
 
@@ -126,6 +126,10 @@ void conj_map_times(ObjexxFCL::FArray3D< std::complex<double> > & map_product, O
 
 ObjexxFCL::FArray3D< double > convolute_maps( ObjexxFCL::FArray3D< double > const & mapA, ObjexxFCL::FArray3D< double > const & mapB) ;
 
+/// @brief A runner for the slab jobs of the 3D FFTs of density maps: the jobs are run on the thread pool,
+///   in -edensity:fft_threads threads (all threads if 0).  Runs in the calling thread in non-multithreaded builds.
+numeric::fourier::FFTJobRunner fft_job_runner();
+
 
 /// 4d interpolants
 core::Real interp_spline(
@@ -202,15 +206,12 @@ void resample(
 
 	newDensity.dimension( newDims[0], newDims[1], newDims[2] );
 
-	// convert map to complex<double>
 	ObjexxFCL::FArray3D< std::complex<double> > Foldmap, Fnewmap;
 	Fnewmap.dimension( newDims[0], newDims[1], newDims[2] );
 
 	// fft
-	ObjexxFCL::FArray3D< std::complex<double> > cplx_density;
-	cplx_density.dimension( density.u1() , density.u2() , density.u3() );
-	for ( int i=0; i<density.u1()*density.u2()*density.u3(); ++i ) cplx_density[i] = (double)density[i];
-	numeric::fourier::fft3(cplx_density, Foldmap);
+	numeric::fourier::FFTJobRunner const runner( fft_job_runner() );
+	numeric::fourier::fft3(density, Foldmap, runner);
 
 	// reshape (handles both shrinking and growing in each dimension)
 	for ( int i=0; i<Fnewmap.u1()*Fnewmap.u2()*Fnewmap.u3(); ++i ) Fnewmap[i] = std::complex<double>(0,0);
@@ -265,7 +266,7 @@ void resample(
 	}
 
 	// ifft
-	numeric::fourier::ifft3(Fnewmap, newDensity);
+	numeric::fourier::ifft3(Fnewmap, newDensity, runner);
 }
 
 
@@ -355,7 +355,11 @@ EtableEvaluator::EtableEvaluator( Etable const & etable ) :
 	st_atr_( fa_atr),
 	st_rep_( fa_rep ),
 	st_sol_( fa_sol ),
-	hydrogen_interaction_cutoff2_( etable.hydrogen_interaction_cutoff2() )
+	hydrogen_interaction_cutoff2_( etable.hydrogen_interaction_cutoff2() ),
+	// Pairs are evaluated out to max_dis2 + epsilon, and their hydrogens are visited out to
+	// the hydrogen interaction cutoff; anything beyond both contributes nothing.
+	heavyatom_screen_cutoff2_( std::max( etable.max_dis2() + etable.epsilon(), etable.hydrogen_interaction_cutoff2() ) ),
+	use_soa_kernel_( basic::options::option[ basic::options::OptionKeys::score::etable_soa_kernel ]() )
 {}
 
 EtableEvaluator::~EtableEvaluator() = default;
@@ -116,6 +116,31 @@ public:
 		return hydrogen_interaction_cutoff2_;
 	}
 
+	/// @brief The square distance beyond which a pair of heavy atoms neither interacts
+	/// nor has attached hydrogens that could interact.  Used by the structure-of-arrays
+	/// residue-pair kernel to screen out atom pairs before any etable evaluation.
+	inline
+	Real
+	heavyatom_screen_cutoff2() const
+	{
+		return heavyatom_screen_cutoff2_;
+	}
+
+	/// @brief Should the residue-pair energy functions in atom_pair_energy_inline.hh use the
+	/// structure-of-arrays distance screen?  Read from the -score:etable_soa_kernel flag.
+	inline
+	bool
+	use_soa_kernel() const
+	{
+		return use_soa_kernel_;
+	}
+
+	void
+	use_soa_kernel( bool const setting )
+	{
+		use_soa_kernel_ = setting;
+	}
+
 	/// @brief A Virtual function for the evaluation of an interaction energy of an atom with
 	/// a hydrogen atom. Not to be confused with the importantly non-virtual function defined
 	/// in each of the subclasses that templated atom-pair-energy-inline functions invoke
@@ -207,6 +232,8 @@ private:
 	ScoreType st_sol_;
 
 	Real hydrogen_interaction_cutoff2_;
+	Real heavyatom_screen_cutoff2_;
+	bool use_soa_kernel_;
 };
 
 
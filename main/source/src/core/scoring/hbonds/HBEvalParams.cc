@@ -0,0 +1,82 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/scoring/hbonds/HBEvalParams.cc
+/// @brief  The fade intervals and polynomials of an HBEvalType, flattened into plain values
+
+// Unit headers
+#include <core/scoring/hbonds/HBEvalParams.hh>
+
+// Package headers
+#include <core/scoring/hbonds/FadeInterval.hh>
+#include <core/scoring/hbonds/polynomial.hh>
+
+// Utility headers
+#include <utility/exit.hh>
+
+namespace core {
+namespace scoring {
+namespace hbonds {
+
+HBFadeParams::HBFadeParams() :
+	min0( 0.0 ),
+	fmin( 0.0 ),
+	fmax( 0.0 ),
+	max0( 0.0 ),
+	dfade_min( 0.0 ),
+	dfade_max( 0.0 ),
+	smooth( false )
+{}
+
+/// @details The slopes are computed as in the FadeInterval constructor.  For the zero-width
+/// "fade_zero" interval they are infinite rather than zero, but then no x ever falls on a ramp.
+HBFadeParams::HBFadeParams( FadeInterval const & fade ) :
+	min0( fade.get_min0() ),
+	fmin( fade.get_fmin() ),
+	fmax( fade.get_fmax() ),
+	max0( fade.get_max0() ),
+	dfade_min( 1.0/static_cast<double>( fade.get_fmin() - fade.get_min0() ) ),
+	dfade_max( 1.0/static_cast<double>( fade.get_max0() - fade.get_fmax() ) ),
+	smooth( fade.get_smooth() )
+{}
+
+HBPolyParams::HBPolyParams() :
+	xmin( 0.0 ),
+	xmax( 0.0 ),
+	min_val( 0.0 ),
+	max_val( 0.0 ),
+	degree( 0 )
+{
+	for ( double & c : coefficients ) c = 0.0;
+}
+
+HBPolyParams::HBPolyParams( Polynomial_1d const & poly ) :
+	xmin( poly.xmin() ),
+	xmax( poly.xmax() ),
+	min_val( poly.min_val() ),
+	max_val( poly.max_val() ),
+	degree( poly.degree() )
+{
+	if ( degree > MAX_DEGREE || poly.coefficients().size() != degree ) {
+		utility_exit_with_message( "HBond polynomial " + poly.name() + " has more coefficients than the hbond evaluation supports" );
+	}
+	for ( double & c : coefficients ) c = 0.0;
+	for ( Size ii = 1; ii <= degree; ++ii ) {
+		coefficients[ first_coefficient() + ii - 1 ] = poly.coefficients()[ ii ];
+	}
+}
+
+HBEvalParams::HBEvalParams() :
+	defined( false ),
+	use_cosAHD( true )
+{}
+
+} // hbonds
+} // scoring
+} // core
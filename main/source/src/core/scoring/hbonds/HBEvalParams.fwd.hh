@@ -0,0 +1,28 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/scoring/hbonds/HBEvalParams.fwd.hh
+/// @brief  The fade intervals and polynomials of an HBEvalType, forward declarations
+
+#ifndef INCLUDED_core_scoring_hbonds_HBEvalParams_fwd_hh
+#define INCLUDED_core_scoring_hbonds_HBEvalParams_fwd_hh
+
+namespace core {
+namespace scoring {
+namespace hbonds {
+
+struct HBFadeParams;
+struct HBPolyParams;
+struct HBEvalParams;
+
+} // hbonds
+} // scoring
+} // core
+
+#endif
@@ -0,0 +1,147 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/scoring/hbonds/HBEvalParams.hh
+/// @brief  The fade intervals and polynomials of an HBEvalType, flattened into plain values
+///         for the inner loops of the hbond energy evaluation
+
+#ifndef INCLUDED_core_scoring_hbonds_HBEvalParams_hh
+#define INCLUDED_core_scoring_hbonds_HBEvalParams_hh
+
+// Unit headers
+#include <core/scoring/hbonds/HBEvalParams.fwd.hh>
+
+// Package headers
+#include <core/scoring/hbonds/FadeInterval.fwd.hh>
+#include <core/scoring/hbonds/polynomial.fwd.hh>
+
+// Project headers
+#include <core/types.hh>
+
+namespace core {
+namespace scoring {
+namespace hbonds {
+
+/// @brief The parameters of a FadeInterval.  value_deriv() gives the values of
+/// FadeInterval::value_deriv(), up to rounding, but without branches, so that a loop of calls for many hbonds
+/// can be vectorized.
+struct HBFadeParams {
+
+	HBFadeParams();
+
+	explicit
+	HBFadeParams( FadeInterval const & fade );
+
+	inline
+	void
+	value_deriv( double const x, double & val, double & deriv ) const
+	{
+		//JSS  5 intervals --a-b---c-d--
+		double const zmin( ( x - min0 ) * dfade_min );
+		double const zmax( ( x - fmax ) * dfade_max );
+		double const rise_val( smooth ? zmin*zmin*(3-2*zmin) : zmin );            // in (min0,fmin)
+		double const rise_deriv( smooth ? -6*zmin*(zmin-1)*dfade_min : dfade_min );
+		double const fall_val( smooth ? zmax*zmax*(2*zmax-3) + 1 : ( max0 - x ) * dfade_max ); // in (fmax,max0)
+		double const fall_deriv( smooth ? 6*zmax*(zmax-1)*dfade_max : -dfade_max );
+		bool const rising( x <= fmax );
+		bool const outside( rising ? x <= min0 : x >= max0 );
+		bool const flat( rising && x >= fmin );
+		val = outside ? 0.0 : ( flat ? 1.0 : ( rising ? rise_val : fall_val ) );
+		deriv = ( outside || flat ) ? 0.0 : ( rising ? rise_deriv : fall_deriv );
+	}
+
+	Real min0;
+	Real fmin;
+	Real fmax;
+	Real max0;
+	double dfade_min;
+	double dfade_max;
+	bool smooth;
+};
+
+/// @brief The parameters of a Polynomial_1d, with the coefficients right-aligned in an array of
+/// fixed length.  value_deriv() gives the values of Polynomial_1d::operator(), up to rounding:
+/// the leading zeros leave the value and derivative at exactly zero until the first coefficient.
+struct HBPolyParams {
+
+	/// @brief The most coefficients a polynomial in HBPoly1D.csv can have
+	static Size const MAX_DEGREE = 11;
+
+	HBPolyParams();
+
+	explicit
+	HBPolyParams( Polynomial_1d const & poly );
+
+	/// @brief The index of the first (highest order) coefficient of the polynomial
+	inline
+	Size
+	first_coefficient() const {
+		return MAX_DEGREE - degree;
+	}
+
+	inline
+	void
+	value_deriv( double const x, double & value, double & deriv ) const
+	{
+		double v( 0.0 ), d( 0.0 );
+		for ( Size ii = first_coefficient(); ii < MAX_DEGREE; ++ii ) {
+			(d *= x) += v;
+			(v *= x) += coefficients[ ii ];
+		}
+		clamp( x, v, d, value, deriv );
+	}
+
+	/// @brief Replace the value of the polynomial outside of its domain with the boundary values
+	inline
+	void
+	clamp( double const x, double const v, double const d, double & value, double & deriv ) const
+	{
+		bool const below( x <= xmin ), above( x >= xmax );
+		value = below ? min_val : ( above ? max_val : v );
+		deriv = ( below || above ) ? 0.0 : d;
+	}
+
+	double xmin;
+	double xmax;
+	double min_val;
+	double max_val;
+	Size degree;
+	double coefficients[ MAX_DEGREE ];
+};
+
+/// @brief All the fade intervals and polynomials of one HBEvalType; see hbond_compute_energy()
+struct HBEvalParams {
+
+	HBEvalParams();
+
+	/// @brief Have the parameters of this HBEvalType been read from the database?
+	bool defined;
+
+	/// @brief Are the AHD polynomials in cosine space (hbgd_cosAHD) rather than in angle space (hbgd_AHD)?
+	bool use_cosAHD;
+
+	HBFadeParams AHdist_short_fade;
+	HBFadeParams AHdist_long_fade;
+	HBFadeParams cosBAH_fade;
+	HBFadeParams cosBAH2_fade;
+	HBFadeParams cosAHD_fade;
+
+	HBPolyParams AHdist_poly;
+	HBPolyParams cosBAH_short_poly;
+	HBPolyParams cosBAH_long_poly;
+	HBPolyParams cosBAH2_poly;
+	HBPolyParams cosAHD_short_poly;
+	HBPolyParams cosAHD_long_poly;
+};
+
+} // hbonds
+} // scoring
+} // core
+
+#endif
@@ -0,0 +1,354 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/scoring/hbonds/HBondBatch.cc
+/// @brief  Batched evaluation of many donor/acceptor pairs
+
+// Unit headers
+#include <core/scoring/hbonds/HBondBatch.hh>
+
+// Package headers
+#include <core/scoring/hbonds/constants.hh>
+#include <core/scoring/hbonds/HBEvalParams.hh>
+#include <core/scoring/hbonds/HBondDatabase.hh>
+#include <core/scoring/hbonds/HBondOptions.hh>
+#include <core/scoring/hbonds/hbonds_geom.hh>
+#include <core/scoring/DerivVectorPair.hh>
+
+// Basic headers
+#include <basic/Tracer.hh>
+#include <basic/options/option.hh>
+#include <basic/options/keys/score.OptionKeys.gen.hh>
+
+// Utility headers
+#include <utility/exit.hh>
+
+// Numeric headers
+#include <numeric/constants.hh>
+
+// ObjexxFCL headers
+#include <ObjexxFCL/format.hh>
+
+// C++ headers
+#include <algorithm>
+#include <cmath>
+
+static basic::Tracer TR( "core.scoring.hbonds.HBondBatch" );
+
+namespace core {
+namespace scoring {
+namespace hbonds {
+
+HBondBatch::HBondBatch() = default;
+
+HBondBatch::~HBondBatch() = default;
+
+void
+HBondBatch::clear()
+{
+	hbt_.clear();
+	hatm_.clear();
+	aatm_.clear();
+	Dxyz_.clear();
+	Hxyz_.clear();
+	Axyz_.clear();
+	Bxyz_.clear();
+	B2xyz_.clear();
+}
+
+void
+HBondBatch::add(
+	HBEvalTuple const & hbt,
+	Size const hatm,
+	Size const aatm,
+	Vector const & Dxyz,
+	Vector const & Hxyz,
+	Vector const & Axyz,
+	Vector const & Bxyz,
+	Vector const & B2xyz
+) {
+	hbt_.push_back( hbt );
+	hatm_.push_back( hatm );
+	aatm_.push_back( aatm );
+	Dxyz_.push_back( Dxyz );
+	Hxyz_.push_back( Hxyz );
+	Axyz_.push_back( Axyz );
+	Bxyz_.push_back( Bxyz );
+	B2xyz_.push_back( B2xyz );
+}
+
+/// @details Follows hb_energy_deriv() and hb_energy_deriv_u2() through hbond_compute_energy(),
+/// but one stage at a time for all the pairs.
+void
+HBondBatch::evaluate(
+	HBondDatabase const & database,
+	HBondOptions const & hbondoptions,
+	bool const evaluate_derivative
+) {
+	using namespace basic::options;
+	using namespace basic::options::OptionKeys;
+
+	Size const n( size() );
+	energy_.assign( n, MAX_HB_ENERGY + 1.0f );
+	derivs_.resize( n );
+	if ( n == 0 ) return;
+
+	set_unit_vectors( hbondoptions );
+	compute_geometry();
+
+	// Read once per batch rather than once per hbond
+	bool const hbond_new_sp3_acc( option[ score::hbond_new_sp3_acc ]() );
+	double const fade_factor( option[ score::hbond_fade ].value() );
+
+	// The pairs that pass the cutoffs of hbond_compute_energy become the lanes of the polynomial evaluation
+	lane_pair_.clear();
+	lane_params_.clear();
+	lane_softmax_.clear();
+	lane_chi_.clear();
+	lane_AHD_.clear();
+	lane_AHdis_.clear();
+	lane_xD_.clear();
+	lane_xH_.clear();
+	lane_xH2_.clear();
+	lane_xAHD_.clear();
+	for ( Size ii = 0; ii < n; ++ii ) {
+		if ( ! in_range_[ ii ] ) continue;
+		Real const AHdis( AHdis_[ ii ] ), xD( xD_[ ii ] ), xH( xH_[ ii ] ), xH2( xH2_[ ii ] );
+		HBEvalTuple const & hbt( hbt_[ ii + 1 ] );
+
+		if ( std::abs(xD) > 1.0 || std::abs(xH) > 1.0 || std::abs(xH2) > 1.0 ) {
+			TR.Warning << "invalid angle value in hbond_compute_energy:"
+				<< " xH = " << ObjexxFCL::format::SS( xH ) << " xD = " << ObjexxFCL::format::SS( xD )
+				<< " xH2 = " << ObjexxFCL::format::SS( xH2 ) << std::endl;
+			continue;
+		}
+		if ( AHdis > MAX_R || AHdis < MIN_R || xH < MIN_xH || xD < MIN_xD ||
+				xH > MAX_xH || xH2 > MAX_xH || xD > MAX_xD ) {
+			continue;
+		}
+		if ( hbond_excludes_ether_oxygen( hbondoptions, hbt ) ) continue;
+
+		HBEvalParams const & params( database.eval_params_lookup( hbt.eval_type() ) );
+		Real AHD(-1234);
+		if ( ! params.use_cosAHD ) {
+			AHD = numeric::constants::d::pi-acos(static_cast<double>(xD));
+		}
+
+		lane_pair_.push_back( ii );
+		lane_params_.push_back( &params );
+		lane_softmax_.push_back( hbond_uses_softmax( hbondoptions, hbt, hbond_new_sp3_acc ) );
+		lane_chi_.push_back( hb_acceptor_chi( hbondoptions, hbt, Hxyz_[ ii + 1 ], Axyz_[ ii + 1 ], PBxyz_[ ii + 1 ], B2xyz_[ ii + 1 ] ) );
+		lane_AHD_.push_back( AHD );
+		lane_AHdis_.push_back( AHdis );
+		lane_xD_.push_back( xD );
+		lane_xH_.push_back( xH );
+		lane_xH2_.push_back( xH2 );
+		lane_xAHD_.push_back( params.use_cosAHD ? static_cast<double>(xD) : AHD );
+	}
+	Size const nlanes( lane_pair_.size() );
+	if ( nlanes == 0 ) return;
+
+	evaluate_fades( &HBEvalParams::AHdist_short_fade, lane_AHdis_, FSr_, dFSr_ );
+	evaluate_fades( &HBEvalParams::AHdist_long_fade, lane_AHdis_, FLr_, dFLr_ );
+	evaluate_fades( &HBEvalParams::cosBAH_fade, lane_xH_, FxH_, dFxH_ );
+	evaluate_fades( &HBEvalParams::cosBAH2_fade, lane_xH2_, FxH2_, dFxH2_ );
+	evaluate_fades( &HBEvalParams::cosAHD_fade, lane_xD_, FxD_, dFxD_ );
+
+	// All lanes get their polynomials evaluated, even those that hbond_terms_out_of_range() drops below
+	evaluate_polynomials( &HBEvalParams::AHdist_poly, lane_AHdis_, Pr_, dPr_ );
+	evaluate_polynomials( &HBEvalParams::cosBAH_short_poly, lane_xH_, PSxH_, dPSxH_ );
+	evaluate_polynomials( &HBEvalParams::cosBAH_long_poly, lane_xH_, PLxH_, dPLxH_ );
+	evaluate_polynomials( &HBEvalParams::cosBAH2_poly, lane_xH2_, PxH2_, dPxH2_ );
+	evaluate_polynomials( &HBEvalParams::cosAHD_short_poly, lane_xAHD_, PSxD_, dPSxD_ );
+	evaluate_polynomials( &HBEvalParams::cosAHD_long_poly, lane_xAHD_, PLxD_, dPLxD_ );
+
+	for ( Size kk = 0; kk < nlanes; ++kk ) {
+		Size const ii( lane_pair_[ kk ] + 1 );
+		HBEvalParams const & params( *lane_params_[ kk ] );
+		bool const use_softmax( lane_softmax_[ kk ] );
+
+		HBondTerms terms;
+		terms.FSr = FSr_[ kk ]; terms.dFSr = dFSr_[ kk ];
+		terms.FLr = FLr_[ kk ]; terms.dFLr = dFLr_[ kk ];
+		terms.FxH = FxH_[ kk ]; terms.dFxH = dFxH_[ kk ];
+		terms.FxH2 = FxH2_[ kk ]; terms.dFxH2 = dFxH2_[ kk ];
+		terms.FxD = FxD_[ kk ]; terms.dFxD = dFxD_[ kk ];
+		if ( hbond_terms_out_of_range( params, terms, use_softmax, lane_AHdis_[ kk ], lane_xH_[ kk ], lane_xD_[ kk ], lane_AHD_[ kk ] ) ) {
+			continue;
+		}
+		terms.Pr = Pr_[ kk ]; terms.dPr = dPr_[ kk ];
+		terms.PSxH = PSxH_[ kk ]; terms.dPSxH = dPSxH_[ kk ];
+		terms.PLxH = PLxH_[ kk ]; terms.dPLxH = dPLxH_[ kk ];
+		terms.PxH2 = PxH2_[ kk ]; terms.dPxH2 = dPxH2_[ kk ];
+		terms.PSxD = PSxD_[ kk ]; terms.dPSxD = dPSxD_[ kk ];
+		terms.PLxD = PLxD_[ kk ]; terms.dPLxD = dPLxD_[ kk ];
+
+		Real energy;
+		bool apply_chi_torsion_penalty( false );
+		Real dE_dr( 0.0 ), dE_dxD( 0.0 ), dE_dxH( 0.0 ), dE_dxH2( 0.0 ), dE_dBAH( 0.0 ), dE_dchi( 0.0 );
+		hbond_energy_from_terms( database, hbondoptions, hbt_[ ii ], use_softmax, params.use_cosAHD, fade_factor,
+			lane_xH_[ kk ], lane_chi_[ kk ], lane_AHD_[ kk ], terms, evaluate_derivative,
+			energy, apply_chi_torsion_penalty, dE_dr, dE_dxD, dE_dxH, dE_dxH2, dE_dBAH, dE_dchi );
+		energy_[ ii ] = energy;
+
+		if ( ! evaluate_derivative || energy >= MAX_HB_ENERGY ) continue;
+		hb_deriv_vectors( hbderiv_ABE_GO, params.use_cosAHD ? hbgd_cosAHD : hbgd_AHD, apply_chi_torsion_penalty,
+			dE_dr, dE_dxD, dE_dxH, dE_dxH2, dE_dBAH, dE_dchi, lane_chi_[ kk ],
+			Hxyz_[ ii ], Dxyz_[ ii ], Axyz_[ ii ], PBxyz_[ ii ], B2xyz_[ ii ], derivs_[ ii ] );
+	}
+}
+
+/// @details As in hb_energy_deriv(): a pair whose H-D distance is out of range gets a zero
+/// energy and zero derivatives (and so is reported as an hbond by callers that only check
+/// the energy against MAX_HB_ENERGY, as before).
+void
+HBondBatch::set_unit_vectors( HBondOptions const & hbondoptions )
+{
+	Size const n( size() );
+	PBxyz_.resize( n );
+	for ( std::vector< double > * v : { &hx_, &hy_, &hz_, &ax_, &ay_, &az_, &hdx_, &hdy_, &hdz_,
+			&bax_, &bay_, &baz_, &b2ax_, &b2ay_, &b2az_ } ) {
+		v->resize( n );
+	}
+	in_range_.assign( n, 1 );
+
+	for ( Size ii = 1; ii <= n; ++ii ) {
+		Size const jj( ii - 1 );
+		Vector HDunit;
+		if ( ! hb_donor_unit_vector( Dxyz_[ ii ], Hxyz_[ ii ], HDunit ) ) {
+			energy_[ ii ] = 0.0;
+			derivs_[ ii ] = ZERO_DERIV2D;
+			in_range_[ jj ] = 0;
+			// Keep the arrays defined for the vectorized loop
+			HDunit = Vector( 0.0 );
+		}
+
+		if ( hbt_[ ii ].eval_type() == hbe_UNKNOWN ) {
+			TR.Error << "Unknown HBEvalType for " << hbt_[ ii ] << std::endl;
+			utility_exit_with_message("Cannot compute derivative for hbond interaction");
+		}
+		Vector BAunit( 0.0 ), B2Aunit( 0.0 );
+		if ( in_range_[ jj ] ) {
+			make_hbBasetoAcc_unitvector( hbondoptions, get_hbe_acc_hybrid( hbt_[ ii ].eval_type() ),
+				Axyz_[ ii ], Bxyz_[ ii ], B2xyz_[ ii ], PBxyz_[ ii ], BAunit, B2Aunit );
+		}
+
+		Vector const & H( Hxyz_[ ii ] ), & A( Axyz_[ ii ] );
+		hx_[ jj ] = H.x(); hy_[ jj ] = H.y(); hz_[ jj ] = H.z();
+		ax_[ jj ] = A.x(); ay_[ jj ] = A.y(); az_[ jj ] = A.z();
+		hdx_[ jj ] = HDunit.x(); hdy_[ jj ] = HDunit.y(); hdz_[ jj ] = HDunit.z();
+		bax_[ jj ] = BAunit.x(); bay_[ jj ] = BAunit.y(); baz_[ jj ] = BAunit.z();
+		b2ax_[ jj ] = B2Aunit.x(); b2ay_[ jj ] = B2Aunit.y(); b2az_[ jj ] = B2Aunit.z();
+	}
+}
+
+/// @details The arithmetic of hb_energy_deriv_u2(), in the same order, over all pairs.
+/// The early returns there become a mask; note that a NaN passes all of the cutoffs there.
+void
+HBondBatch::compute_geometry()
+{
+	Size const n( size() );
+	AHdis_.resize( n );
+	xD_.resize( n );
+	xH_.resize( n );
+	xH2_.resize( n );
+
+	double const * const hx( hx_.data() ), * const hy( hy_.data() ), * const hz( hz_.data() );
+	double const * const ax( ax_.data() ), * const ay( ay_.data() ), * const az( az_.data() );
+	double const * const hdx( hdx_.data() ), * const hdy( hdy_.data() ), * const hdz( hdz_.data() );
+	double const * const bax( bax_.data() ), * const bay( bay_.data() ), * const baz( baz_.data() );
+	double const * const b2ax( b2ax_.data() ), * const b2ay( b2ay_.data() ), * const b2az( b2az_.data() );
+	double * const AHdis( AHdis_.data() ), * const xD( xD_.data() ), * const xH( xH_.data() ), * const xH2( xH2_.data() );
+	char * const in_range( in_range_.data() );
+
+	for ( Size ii = 0; ii < n; ++ii ) {
+		//car A->H unit vector, distance
+		Real const AHx( hx[ ii ] - ax[ ii ] ), AHy( hy[ ii ] - ay[ ii ] ), AHz( hz[ ii ] - az[ ii ] );
+		Real const AHdis2( ( AHx * AHx ) + ( AHy * AHy ) + ( AHz * AHz ) );
+		Real const dis( std::sqrt( AHdis2 ) );
+		Real const inv_AHdis = 1.0f / dis;
+		Real const ux( AHx * inv_AHdis ), uy( AHy * inv_AHdis ), uz( AHz * inv_AHdis );
+
+		//BW cosines of angle at donor, proton; see hb_energy_deriv_u2() on the minimum with 1
+		Real const cD( std::min( Real(1.0), ( ux * hdx[ ii ] ) + ( uy * hdy[ ii ] ) + ( uz * hdz[ ii ] ) ) );
+		Real const cH( std::min( Real(1.0), ( bax[ ii ] * ux ) + ( bay[ ii ] * uy ) + ( baz[ ii ] * uz ) ) );
+		Real const cH2( std::min( Real(1.0), ( b2ax[ ii ] * ux ) + ( b2ay[ ii ] * uy ) + ( b2az[ ii ] * uz ) ) );
+
+		bool const out( AHdis2 > MAX_R2 || AHdis2 < MIN_R2 || cD < MIN_xD || cD > MAX_xD ||
+			cH < MIN_xH || cH > MAX_xH || cH2 < MIN_xH || cH2 > MAX_xH );
+		AHdis[ ii ] = dis;
+		xD[ ii ] = cD;
+		xH[ ii ] = cH;
+		xH2[ ii ] = cH2;
+		in_range[ ii ] = in_range[ ii ] && ! out;
+	}
+}
+
+void
+HBondBatch::evaluate_fades(
+	HBFadeParams HBEvalParams::* fade,
+	std::vector< double > const & x,
+	std::vector< double > & value,
+	std::vector< double > & deriv
+) const {
+	Size const nlanes( lane_params_.size() );
+	value.resize( nlanes );
+	deriv.resize( nlanes );
+	for ( Size kk = 0; kk < nlanes; ++kk ) {
+		( lane_params_[ kk ]->*fade ).value_deriv( x[ kk ], value[ kk ], deriv[ kk ] );
+	}
+}
+
+/// @details The coefficients of all lanes are gathered into a matrix, one row per power with
+/// the lanes along the row, so that each step of Horner's rule is one pass over contiguous
+/// arrays.  A lane of lower degree than the others starts at exactly zero; see HBPolyParams.
+void
+HBondBatch::evaluate_polynomials(
+	HBPolyParams HBEvalParams::* poly,
+	std::vector< double > const & x,
+	std::vector< double > & value,
+	std::vector< double > & deriv
+) {
+	Size const nlanes( lane_params_.size() );
+	value.resize( nlanes );
+	deriv.resize( nlanes );
+
+	Size first( HBPolyParams::MAX_DEGREE );
+	for ( Size kk = 0; kk < nlanes; ++kk ) {
+		first = std::min( first, ( lane_params_[ kk ]->*poly ).first_coefficient() );
+	}
+	Size const nsteps( HBPolyParams::MAX_DEGREE - first );
+	coefficients_.resize( nsteps * nlanes );
+	for ( Size kk = 0; kk < nlanes; ++kk ) {
+		double const * const c( ( lane_params_[ kk ]->*poly ).coefficients + first );
+		for ( Size step = 0; step < nsteps; ++step ) {
+			coefficients_[ step * nlanes + kk ] = c[ step ];
+		}
+	}
+
+	horner_value_.assign( nlanes, 0.0 );
+	horner_deriv_.assign( nlanes, 0.0 );
+	double * const v( horner_value_.data() ), * const d( horner_deriv_.data() );
+	double const * const xx( x.data() );
+	for ( Size step = 0; step < nsteps; ++step ) {
+		double const * const c( coefficients_.data() + step * nlanes );
+		for ( Size kk = 0; kk < nlanes; ++kk ) {
+			(d[ kk ] *= xx[ kk ]) += v[ kk ];
+			(v[ kk ] *= xx[ kk ]) += c[ kk ];
+		}
+	}
+
+	for ( Size kk = 0; kk < nlanes; ++kk ) {
+		( lane_params_[ kk ]->*poly ).clamp( xx[ kk ], v[ kk ], d[ kk ], value[ kk ], deriv[ kk ] );
+	}
+}
+
+} // hbonds
+} // scoring
+} // core
@@ -0,0 +1,192 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/scoring/hbonds/HBondBatch.hh
+/// @brief  Batched evaluation of many donor/acceptor pairs
+
+#ifndef INCLUDED_core_scoring_hbonds_HBondBatch_hh
+#define INCLUDED_core_scoring_hbonds_HBondBatch_hh
+
+// Unit headers
+#include <core/scoring/hbonds/HBondBatch.fwd.hh>
+
+// Package headers
+#include <core/scoring/hbonds/HBEvalParams.fwd.hh>
+#include <core/scoring/hbonds/HBEvalTuple.hh>
+#include <core/scoring/hbonds/HBondDatabase.fwd.hh>
+#include <core/scoring/hbonds/HBondOptions.fwd.hh>
+#include <core/scoring/hbonds/types.hh>
+
+// Project headers
+#include <core/types.hh>
+
+// Utility headers
+#include <utility/pointer/ReferenceCount.hh>
+#include <utility/vector1.hh>
+
+// C++ headers
+#include <vector>
+
+namespace core {
+namespace scoring {
+namespace hbonds {
+
+/// @brief Evaluates the hbond energies (and derivatives) of many donor/acceptor pairs at once.
+///
+/// @details Collect the candidate pairs of a residue pair with add(), in the order they would
+/// have been passed to hb_energy_deriv(), then call evaluate() and read back the energy and
+/// f1/f2 vectors of each pair.  The energies and derivatives are those of hb_energy_deriv(),
+/// up to rounding: once vectorized, the arithmetic may be contracted or reordered.  Instead of
+/// evaluating one pair at a time from distance to derivatives, evaluate() runs each stage over
+/// all pairs: the A-H distances and the angle cosines, then each fade interval and each
+/// polynomial, over arrays (structure-of-arrays) with the pairs in the inner loop and without
+/// branches, so that the compiler can vectorize them; the polynomial coefficients of the pairs
+/// are gathered so that Horner's rule steps through all pairs at once.  Only the pairs that
+/// survive the distance and angle cutoffs go on to the polynomials.
+///
+/// Used for residue-pair scoring and derivatives.  The packer's rotamer tries do not use it:
+/// the trie traversal scores each atom pair as it reaches it and folds the energy straight
+/// into sums shared by every rotamer pair below that point in the two tries, so there is no
+/// batch of independent pairs to hand over without giving up that sharing.
+///
+/// The arrays are kept between evaluations, so keep one HBondBatch per thread and reuse it.
+class HBondBatch : public utility::pointer::ReferenceCount
+{
+public:
+	HBondBatch();
+	~HBondBatch() override;
+
+	/// @brief Forget the pairs of the last batch, keeping the allocated arrays
+	void
+	clear();
+
+	/// @brief Add a donor/acceptor pair; the arguments are those of hb_energy_deriv(), plus
+	/// the indices of the hydrogen and acceptor atoms in their residues, for the caller's use.
+	void
+	add(
+		HBEvalTuple const & hbt,
+		Size const hatm,
+		Size const aatm,
+		Vector const & Dxyz, // donor coords
+		Vector const & Hxyz, // proton
+		Vector const & Axyz, // acceptor
+		Vector const & Bxyz, // acceptor base
+		Vector const & B2xyz // 2nd acceptor base for ring & SP3 acceptors
+	);
+
+	Size
+	size() const {
+		return hbt_.size();
+	}
+
+	/// @brief Evaluate the energies of all pairs, and their f1/f2 vectors if evaluate_derivative
+	void
+	evaluate(
+		HBondDatabase const & database,
+		HBondOptions const & hbondoptions,
+		bool const evaluate_derivative
+	);
+
+	HBEvalTuple const &
+	hbt( Size const ii ) const {
+		return hbt_[ ii ];
+	}
+
+	Size
+	hatm( Size const ii ) const {
+		return hatm_[ ii ];
+	}
+
+	Size
+	aatm( Size const ii ) const {
+		return aatm_[ ii ];
+	}
+
+	/// @brief The energy of a pair; not an hbond if >= MAX_HB_ENERGY
+	Real
+	energy( Size const ii ) const {
+		return energy_[ ii ];
+	}
+
+	/// @brief The f1/f2 vectors of a pair that forms an hbond, if evaluated with derivatives
+	HBondDerivs const &
+	derivs( Size const ii ) const {
+		return derivs_[ ii ];
+	}
+
+private:
+	/// @brief The H-D and A-B unit vectors of each pair; drops pairs with a bad H-D distance
+	void
+	set_unit_vectors( HBondOptions const & hbondoptions );
+
+	/// @brief A-H distance and angle cosines of all pairs; drops those outside the cutoffs
+	void
+	compute_geometry();
+
+	/// @brief Evaluate one of the fade intervals of each lane
+	void
+	evaluate_fades(
+		HBFadeParams HBEvalParams::* fade,
+		std::vector< double > const & x,
+		std::vector< double > & value,
+		std::vector< double > & deriv
+	) const;
+
+	/// @brief Evaluate one of the polynomials of each lane: Horner's rule over all lanes at once
+	void
+	evaluate_polynomials(
+		HBPolyParams HBEvalParams::* poly,
+		std::vector< double > const & x,
+		std::vector< double > & value,
+		std::vector< double > & deriv
+	);
+
+private:
+	// The pairs, 1-based
+	utility::vector1< HBEvalTuple > hbt_;
+	utility::vector1< Size > hatm_;
+	utility::vector1< Size > aatm_;
+	utility::vector1< Vector > Dxyz_;
+	utility::vector1< Vector > Hxyz_;
+	utility::vector1< Vector > Axyz_;
+	utility::vector1< Vector > Bxyz_;
+	utility::vector1< Vector > B2xyz_;
+
+	// Results, 1-based
+	utility::vector1< Real > energy_;
+	utility::vector1< HBondDerivs > derivs_;
+
+	// The pseudo-base of each acceptor, 1-based
+	utility::vector1< Vector > PBxyz_;
+
+	// Per pair, 0-based: the H and A coordinates, the H->D, B->A and B2->A unit vectors,
+	// and the A-H distance and angle cosines
+	std::vector< double > hx_, hy_, hz_, ax_, ay_, az_;
+	std::vector< double > hdx_, hdy_, hdz_, bax_, bay_, baz_, b2ax_, b2ay_, b2az_;
+	std::vector< double > AHdis_, xD_, xH_, xH2_;
+	std::vector< char > in_range_;
+
+	// Per lane (pair that passed the cutoffs), 0-based
+	std::vector< Size > lane_pair_;
+	std::vector< HBEvalParams const * > lane_params_;
+	std::vector< char > lane_softmax_;
+	std::vector< double > lane_chi_, lane_AHD_, lane_AHdis_, lane_xD_, lane_xH_, lane_xH2_, lane_xAHD_;
+	std::vector< double > FSr_, dFSr_, FLr_, dFLr_, FxH_, dFxH_, FxH2_, dFxH2_, FxD_, dFxD_;
+	std::vector< double > Pr_, dPr_, PSxH_, dPSxH_, PLxH_, dPLxH_, PxH2_, dPxH2_, PSxD_, dPSxD_, PLxD_, dPLxD_;
+
+	// Horner's rule scratch: coefficients gathered lane-fastest, and partial value/derivative
+	std::vector< double > coefficients_;
+	std::vector< double > horner_value_, horner_deriv_;
+};
+
+} // hbonds
+} // scoring
+} // core
+
+#endif
@@ -15,6 +15,7 @@
 
 // Unit Headers
 #include <core/scoring/hbonds/HBondDatabase.hh>
+#include <core/scoring/hbonds/HBEvalParams.hh>
 
 // Package Headers
 #include <core/scoring/hbonds/types.hh>
@@ -103,7 +104,8 @@ HBondDatabase::HBondDatabase():
 	chi_poly_lookup_(HB_EVAL_TYPE_COUNT, nullptr),
 	don_strength_lookup_(hbdon_MAX, 1.0),
 	acc_strength_lookup_(hbacc_MAX, 1.0),
-	weight_type_lookup_(HB_EVAL_TYPE_COUNT, hbw_NONE)
+	weight_type_lookup_(HB_EVAL_TYPE_COUNT, hbw_NONE),
+	eval_params_lookup_(HB_EVAL_TYPE_COUNT)
 {
 	HBondOptions hb_options; // default ctor reads options system, initializes default parameters tag from which this database will initialize itself.
 	params_database_tag_ = hb_options.params_database_tag();
@@ -135,7 +137,8 @@ HBondDatabase::HBondDatabase(
 	chi_poly_lookup_(HB_EVAL_TYPE_COUNT, nullptr),
 	don_strength_lookup_(hbdon_MAX, 1.0),
 	acc_strength_lookup_(hbacc_MAX, 1.0),
-	weight_type_lookup_(HB_EVAL_TYPE_COUNT, hbw_NONE)
+	weight_type_lookup_(HB_EVAL_TYPE_COUNT, hbw_NONE),
+	eval_params_lookup_(HB_EVAL_TYPE_COUNT)
 {
 	initialize();
 }
@@ -165,7 +168,8 @@ HBondDatabase::HBondDatabase(
 	chi_poly_lookup_(src.chi_poly_lookup_),
 	don_strength_lookup_(hbdon_MAX, 1.0),
 	acc_strength_lookup_(hbacc_MAX, 1.0),
-	weight_type_lookup_(src.weight_type_lookup_)
+	weight_type_lookup_(src.weight_type_lookup_),
+	eval_params_lookup_(src.eval_params_lookup_)
 {}
 
 HBondDatabaseCOP
@@ -218,6 +222,8 @@ HBondDatabase::initialize()
 	initialize_don_strength();
 	initialize_acc_strength();
 
+	initialize_eval_params();
+
 	initialized_ = true;
 }
 
@@ -229,6 +235,38 @@ HBondDatabase::initialized() const
 }
 
 
+/// @details Called after the evaluation types are read; types that were not defined
+/// in HBEval.csv are left undefined.
+void
+HBondDatabase::initialize_eval_params()
+{
+	for ( Size hbe = 1; hbe <= HB_EVAL_TYPE_COUNT; ++hbe ) {
+		HBEvalParams & params( eval_params_lookup_[ hbe ] );
+		params = HBEvalParams();
+		if ( ! AHdist_short_fade_lookup_[ hbe ] || ! AHdist_long_fade_lookup_[ hbe ] ||
+				! cosBAH_fade_lookup_[ hbe ] || ! cosBAH2_fade_lookup_[ hbe ] || ! cosAHD_fade_lookup_[ hbe ] ||
+				! AHdist_poly_lookup_[ hbe ] || ! cosBAH_short_poly_lookup_[ hbe ] || ! cosBAH_long_poly_lookup_[ hbe ] ||
+				! cosBAH2_poly_lookup_[ hbe ] || ! cosAHD_short_poly_lookup_[ hbe ] || ! cosAHD_long_poly_lookup_[ hbe ] ) {
+			continue;
+		}
+		params.defined = true;
+		params.use_cosAHD = cosAHD_short_poly_lookup_[ hbe ]->geometric_dimension() == hbgd_cosAHD;
+
+		params.AHdist_short_fade = HBFadeParams( *AHdist_short_fade_lookup_[ hbe ] );
+		params.AHdist_long_fade = HBFadeParams( *AHdist_long_fade_lookup_[ hbe ] );
+		params.cosBAH_fade = HBFadeParams( *cosBAH_fade_lookup_[ hbe ] );
+		params.cosBAH2_fade = HBFadeParams( *cosBAH2_fade_lookup_[ hbe ] );
+		params.cosAHD_fade = HBFadeParams( *cosAHD_fade_lookup_[ hbe ] );
+
+		params.AHdist_poly = HBPolyParams( *AHdist_poly_lookup_[ hbe ] );
+		params.cosBAH_short_poly = HBPolyParams( *cosBAH_short_poly_lookup_[ hbe ] );
+		params.cosBAH_long_poly = HBPolyParams( *cosBAH_long_poly_lookup_[ hbe ] );
+		params.cosBAH2_poly = HBPolyParams( *cosBAH2_poly_lookup_[ hbe ] );
+		params.cosAHD_short_poly = HBPolyParams( *cosAHD_short_poly_lookup_[ hbe ] );
+		params.cosAHD_long_poly = HBPolyParams( *cosAHD_long_poly_lookup_[ hbe ] );
+	}
+}
+
 void
 HBondDatabase::initialize_HBFadeInterval()
 {
@@ -1146,6 +1184,29 @@ HBondDatabase::acc_strength(
 	return acc_strength_lookup_[acc_chem_type];
 }
 
+/// @details use get_hbond_evaluation_type(...) or HBEval_lookup(...)
+///determine hb_eval_type.
+HBEvalParams const &
+HBondDatabase::eval_params_lookup(
+	Size const hb_eval_type
+) const {
+	if ( hb_eval_type < 1 || hb_eval_type > HB_EVAL_TYPE_COUNT ) {
+		stringstream message;
+		message << "HBond eval type '" << hb_eval_type
+			<< "' is out side of the valid range (1," << HB_EVAL_TYPE_COUNT << ")";
+		utility_exit_with_message(message.str());
+	}
+	HBEvalParams const & p(eval_params_lookup_[hb_eval_type]);
+
+	if ( !p.defined ) {
+		stringstream message;
+		message << "No fade intervals and polynomials have been defined for hb eval type '"
+			<< hb_eval_type << "'" << endl;
+		utility_exit_with_message(message.str());
+	}
+	return p;
+}
+
 /// @details use get_hbond_evaluation_type(...) or HBEval_lookup(...)
 ///determine hb_eval_type.
 HBondWeightType
@@ -19,6 +19,7 @@
 #include <core/scoring/hbonds/HBondDatabase.fwd.hh>
 
 // Project Headers
+#include <core/scoring/hbonds/HBEvalParams.hh>
 #include <core/scoring/hbonds/polynomial.fwd.hh>
 #include <core/scoring/hbonds/types.hh>
 
@@ -96,6 +97,10 @@ public:
 	void
 	initialize_HBFadeInterval();
 
+	/// @brief flatten the fade intervals and polynomials of each evaluation type
+	void
+	initialize_eval_params();
+
 	/// @brief find polynomial function given name
 	FadeIntervalCOP
 	HBFadeInterval_from_name( std::string const & name ) const;
@@ -160,6 +165,11 @@ public:
 	Real
 	acc_strength( HBAccChemType const ac_chem_type ) const;
 
+	/// @brief all fade intervals and polynomials of an evaluation type, flattened for the
+	/// inner loops of hbond_compute_energy() and HBondBatch
+	HBEvalParams const &
+	eval_params_lookup( Size const hb_eval_type ) const;
+
 	/// @brief find weight type for evaluation type
 	HBondWeightType
 	weight_type_lookup( Size const hb_eval_type ) const;
@@ -223,6 +233,7 @@ private:
 	utility::vector1< Real > don_strength_lookup_;
 	utility::vector1< Real > acc_strength_lookup_;
 	utility::vector1< HBondWeightType > weight_type_lookup_;
+	utility::vector1< HBEvalParams > eval_params_lookup_;
 
 	static std::map< const std::string, HBondDatabaseCOP > initialized_databases_;
 
@@ -21,6 +21,7 @@
 #include <core/scoring/Energies.hh>
 #include <core/scoring/EnergiesCacheableDataType.hh>
 #include <core/scoring/hbonds/HBEvalTuple.hh>
+#include <core/scoring/hbonds/HBondBatch.hh>
 #include <core/scoring/hbonds/HBondSet.hh>
 #include <core/scoring/hbonds/hbonds.hh>
 #include <core/scoring/hbonds/hbonds_geom.hh>
@@ -73,6 +74,7 @@
 #include <core/id/types.hh>
 #include <core/scoring/hbonds/HBondDatabase.hh>
 #include <utility/vector1.hh>
+#include <utility/thread/backwards_thread_local.hh>
 #include <boost/unordered_map.hpp>
 
 #include <basic/Tracer.hh>
@@ -706,80 +708,53 @@ HBondEnergy::hbond_derivs_1way(
 	bool is_intra_res = (don_rsd.seqpos() == acc_rsd.seqpos());
 	if ( is_intra_res && !calculate_intra_res_hbonds( don_rsd, hbond_set.hbond_options() ) ) return;
 
-	// <f1,f2> -- derivative vectors
-	HBondDerivs deriv;
+	static THREAD_LOCAL HBondBatch batch;
+	batch.clear();
+	add_hbond_candidates_1way( don_rsd, acc_rsd, false, exclude_bsc, exclude_scb, false, batch );
+	batch.evaluate( *database, *options_, true /*eval deriv*/ );
 
-	for ( Size const hatm : don_rsd.Hpos_polar() ) {
-		Size const datm(don_rsd.atom_base(hatm));
-		bool datm_is_bb = don_rsd.atom_is_backbone(datm);
+	for ( Size kk = 1; kk <= batch.size(); ++kk ) {
+		Real const unweighted_energy( batch.energy( kk ) );
+		if ( unweighted_energy >= MAX_HB_ENERGY ) continue;
+		HBEvalTuple const & hbe_type( batch.hbt( kk ) );
+		Size const hatm( batch.hatm( kk ) ), aatm( batch.aatm( kk ) );
 
-		Vector const & hatm_xyz( don_rsd.atom(hatm).xyz() );
-		Vector const & datm_xyz( don_rsd.atom(datm).xyz() );
+		//pba buggy?
+		Real weighted_energy = // evn weight * weight-set[ hbtype ] weight
+			(! hbond_set.hbond_options().use_hb_env_dep() ? 1 :
+			get_environment_dependent_weight(hbe_type, don_nb, acc_nb, hbond_set.hbond_options() )) *
+			hb_eval_type_weight( hbe_type.eval_type(), weights, is_intra_res, hbond_set.hbond_options().put_intra_into_total() );
+		weighted_energy *= ssdep_weight_factor;
 
-		for ( Size const aatm : acc_rsd.accpt_pos() ) {
-
-			if ( acc_rsd.atom_is_backbone(aatm) ) {
-				if ( ! datm_is_bb && exclude_bsc ) continue; // if the donor is sc, the acceptor bb, and exclude_b(a)sc(d)
-			} else {
-				if ( datm_is_bb && exclude_scb ) continue; // if the donor is bb, the acceptor sc, and exclude_sc(a)b(d)
-			}
-
-			// rough filter for existance of hydrogen bond
-			if ( hatm_xyz.distance_squared( acc_rsd.xyz( aatm ) ) > MAX_R2 ) continue;
-
-			Real unweighted_energy( 0.0 );
-
-			HBEvalTuple hbe_type( datm, don_rsd, aatm, acc_rsd);
-
-			int const base ( acc_rsd.atom_base( aatm ) );
-			int const base2( acc_rsd.abase2( aatm ) );
-			debug_assert( base2 > 0 && base != base2 );
-
-			hb_energy_deriv( *database, *options_, hbe_type, datm_xyz, hatm_xyz,
-				acc_rsd.atom(aatm ).xyz(),
-				acc_rsd.atom(base ).xyz(),
-				acc_rsd.atom(base2).xyz(),
-				unweighted_energy, true /*eval deriv*/, deriv);
-
-			if ( unweighted_energy >= MAX_HB_ENERGY ) continue;
+		// hydrate/SPaDES protocol
+		// don't consider hb env dependency if hybrid hb env dependency and hb is near wat
+		if ( hbond_set.hbond_options().water_hybrid_sf() && bond_near_wat ) {
+			weighted_energy = hb_eval_type_weight( hbe_type.eval_type(), weights, is_intra_res);
+		}
 
-			//pba buggy?
-			Real weighted_energy = // evn weight * weight-set[ hbtype ] weight
-				(! hbond_set.hbond_options().use_hb_env_dep() ? 1 :
-				get_environment_dependent_weight(hbe_type, don_nb, acc_nb, hbond_set.hbond_options() )) *
+		// Readjust hydrogen bonding depth dependent weight based on z positions
+		// Relying on nonzero thickness which should really be true here!!!
+		if ( thickness_ != 0 || options_->Mbhbond() || options_->mphbond()  ) {
+			weighted_energy = get_membrane_depth_dependent_weight(normal_, center_, thickness_,
+				steepness_, don_nb, acc_nb, don_rsd.atom( hatm ).xyz(), acc_rsd.atom(aatm ).xyz()) *
 				hb_eval_type_weight( hbe_type.eval_type(), weights, is_intra_res, hbond_set.hbond_options().put_intra_into_total() );
-			weighted_energy *= ssdep_weight_factor;
-
-			// hydrate/SPaDES protocol
-			// don't consider hb env dependency if hybrid hb env dependency and hb is near wat
-			if ( hbond_set.hbond_options().water_hybrid_sf() && bond_near_wat ) {
-				weighted_energy = hb_eval_type_weight( hbe_type.eval_type(), weights, is_intra_res);
-			}
-
-			// Readjust hydrogen bonding depth dependent weight based on z positions
-			// Relying on nonzero thickness which should really be true here!!!
-			if ( thickness_ != 0 || options_->Mbhbond() || options_->mphbond()  ) {
-				weighted_energy = get_membrane_depth_dependent_weight(normal_, center_, thickness_,
-					steepness_, don_nb, acc_nb, hatm_xyz, acc_rsd.atom(aatm ).xyz()) *
-					hb_eval_type_weight( hbe_type.eval_type(), weights, is_intra_res, hbond_set.hbond_options().put_intra_into_total() );
-			}
+		}
 
-			HBDerivAssigner assigner( *options_, hbe_type, don_rsd, hatm, acc_rsd, aatm );
-			for ( Size ii = 1; ii <= n_hb_atoms; ++ii ) {
-				auto ii_which = which_atom_in_hbond(ii);
-				if ( assigner.ind( ii_which ) == 0 ) continue;
-				AssignmentScaleAndDerivVectID ii_asadvi = assigner.assignment( ii_which );
-				if ( ii_asadvi.dvect_id_ == which_hb_unassigned ) continue;
-				DerivVectorPair ii_deriv = ii_asadvi.scale_ * weighted_energy * deriv.deriv( ii_asadvi.dvect_id_ );
-				if ( ii <= which_last_donor_atm ) {
-					don_atom_derivs[ assigner.ind( ii_which ) ] += ii_deriv;
-				} else {
-					acc_atom_derivs[ assigner.ind( ii_which ) ] += ii_deriv;
-				}
+		HBDerivAssigner assigner( *options_, hbe_type, don_rsd, hatm, acc_rsd, aatm );
+		for ( Size ii = 1; ii <= n_hb_atoms; ++ii ) {
+			auto ii_which = which_atom_in_hbond(ii);
+			if ( assigner.ind( ii_which ) == 0 ) continue;
+			AssignmentScaleAndDerivVectID ii_asadvi = assigner.assignment( ii_which );
+			if ( ii_asadvi.dvect_id_ == which_hb_unassigned ) continue;
+			DerivVectorPair ii_deriv = ii_asadvi.scale_ * weighted_energy * batch.derivs( kk ).deriv( ii_asadvi.dvect_id_ );
+			if ( ii <= which_last_donor_atm ) {
+				don_atom_derivs[ assigner.ind( ii_which ) ] += ii_deriv;
+			} else {
+				acc_atom_derivs[ assigner.ind( ii_which ) ] += ii_deriv;
 			}
+		}
 
-		} // loop over acceptors
-	} // loop over donors
+	} // loop over hbonds
 }
 
 void
@@ -1523,7 +1498,8 @@ HBondEnergy::create_rotamer_trie(
 
 /// @brief code to evaluate a hydrogen bond energy for the trie that
 /// didn't belong in the header itself -- it certainly does enough work
-/// such that inlining it would not likely produce a speedup.
+/// such that inlining it would not likely produce a speedup.  One pair at a time,
+/// not through HBondBatch: see the HBondBatch class notes.
 Energy
 HBondEnergy::drawn_out_heavyatom_hydrogenatom_energy(
 	hbtrie::HBAtom const & at1, // atom 1 is the heavy atom, the acceptor
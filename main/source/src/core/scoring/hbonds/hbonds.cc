@@ -22,6 +22,7 @@
 #include <core/scoring/hbonds/hbonds_geom.hh>
 #include <core/scoring/hbonds/HBondOptions.hh>
 #include <core/scoring/hbonds/HBondDatabase.hh>
+#include <core/scoring/hbonds/HBondBatch.hh>
 
 // // Project headers
 #include <core/conformation/Residue.hh>
@@ -49,6 +50,7 @@
 #include <core/conformation/membrane/MembraneInfo.hh>
 
 #include <utility/vector1.hh>
+#include <utility/thread/backwards_thread_local.hh>
 #include <basic/options/keys/OptionKeys.hh>
 #include <basic/options/option.hh>
 #include <basic/options/keys/hydrate.OptionKeys.gen.hh>
@@ -428,34 +430,17 @@ fill_hbond_set_by_AHdist_threshold(
 }
 
 
-/// @details identify_hbonds_1way is overloaded to either add HBond objects to
-/// an HBondSet or to accumulate energy into a EnergyMap
-/// object.  This is done for performance reasons.  The allocation of
-/// the temporary HBondSet on the heap causes a substatial slow down.
 void
-identify_hbonds_1way(
-	HBondDatabase const & database,
+add_hbond_candidates_1way(
 	conformation::Residue const & don_rsd,
 	conformation::Residue const & acc_rsd,
-	Size const don_nb,
-	Size const acc_nb,
-	bool const evaluate_derivative,
 	bool const exclude_bb,  /* exclude if acc=bb and don=bb */
 	bool const exclude_bsc, /* exclude if acc=bb and don=sc */
 	bool const exclude_scb, /* exclude if acc=sc and don=bb */
 	bool const exclude_sc,  /* exclude if acc=sc and don=sc */
-	// output
-	HBondSet & hbond_set,
-	Real ssdep_weight_factor,
-	bool bond_near_wat
+	HBondBatch & batch
 )
 {
-	debug_assert( don_rsd.seqpos() != acc_rsd.seqpos() );
-
-	// <f1,f2> -- derivative vectors
-	//std::pair< Vector, Vector > deriv( Vector(0.0), Vector(0.0 ) );
-	HBondDerivs derivs;
-
 	for ( Size const hatm : don_rsd.Hpos_polar() ) {
 
 		Size const datm(don_rsd.atom_base(hatm));
@@ -487,60 +472,24 @@ identify_hbonds_1way(
 			// rough filter for existence of hydrogen bond
 			if ( hatm_xyz.distance_squared( acc_rsd.xyz( aatm ) ) > MAX_R2 ) continue;
 
-			Real unweighted_energy( 0.0 );
-
-			HBEvalTuple hbe_type( datm, don_rsd, aatm, acc_rsd);
-
 			int const base ( acc_rsd.atom_base( aatm ) );
 			int const base2( acc_rsd.abase2( aatm ) );
 			debug_assert( base2 > 0 && base != base2 );
 
-			//std::cout << "about to evaluate " << acc_rsd.atom_name(aatm ) << " " << acc_rsd.atom_name(base ) << acc_rsd.atom_name(base2) << std::endl;
-			//std::cout << "coords " << acc_rsd.atom(aatm ) << "\t" << acc_rsd.atom(base ) << "\t" << acc_rsd.atom(base2) << std::endl;
-			//std::cout << "seqpos " << don_rsd.seqpos() << "\t" << acc_rsd.seqpos() << std::endl;
-
-			// Just skip nans for now?
-			/*if ( acc_rsd.atom(aatm ).xyz().x() != acc_rsd.atom(aatm ).xyz().x() ) continue;
-			if ( acc_rsd.atom(aatm ).xyz().y() != acc_rsd.atom(aatm ).xyz().y() ) continue;
-			if ( acc_rsd.atom(aatm ).xyz().z() != acc_rsd.atom(aatm ).xyz().z() ) continue;
-			if ( acc_rsd.atom(base ).xyz().x() != acc_rsd.atom(base ).xyz().x() ) continue;
-			if ( acc_rsd.atom(base ).xyz().y() != acc_rsd.atom(base ).xyz().y() ) continue;
-			if ( acc_rsd.atom(base ).xyz().z() != acc_rsd.atom(base ).xyz().z() ) continue;
-			if ( acc_rsd.atom(base2).xyz().x() != acc_rsd.atom(base2).xyz().x() ) continue;
-			if ( acc_rsd.atom(base2).xyz().y() != acc_rsd.atom(base2).xyz().y() ) continue;
-			if ( acc_rsd.atom(base2).xyz().z() != acc_rsd.atom(base2).xyz().z() ) continue;
-			*/
-			//std::cout << "not skipping... " << std::endl;
-
-			hb_energy_deriv( database, hbond_set.hbond_options(),
-				hbe_type, datm_xyz, hatm_xyz,
+			batch.add( HBEvalTuple( datm, don_rsd, aatm, acc_rsd ), hatm, aatm, datm_xyz, hatm_xyz,
 				acc_rsd.atom(aatm ).xyz(),
 				acc_rsd.atom(base ).xyz(),
-				acc_rsd.atom(base2).xyz(),
-				unweighted_energy, evaluate_derivative, derivs);
-
-			if ( unweighted_energy >= MAX_HB_ENERGY ) continue;
-
-			Real environmental_weight
-				(!hbond_set.hbond_options().use_hb_env_dep() ? 1 :
-				get_environment_dependent_weight(hbe_type, don_nb, acc_nb, hbond_set.hbond_options()));
-
-			// hydrate/SPaDES protocol for when bond is near water
-			if ( hbond_set.hbond_options().water_hybrid_sf() && bond_near_wat ) environmental_weight = 1;
-
-			Real ssdep_weight = (get_hbond_weight_type(hbe_type.eval_type())==hbw_SR_BB) ?  ssdep_weight_factor : 1.0;
-
-			//////
-			// now we have identified a hbond -> append it into the hbond_set
-			hbond_set.append_hbond( hatm, don_rsd, aatm, acc_rsd,
-				hbe_type, unweighted_energy, environmental_weight*ssdep_weight, derivs );
-
-			//////
-
+				acc_rsd.atom(base2).xyz() );
 		} // loop over acceptors
 	} // loop over donors
 }
 
+/// @details identify_hbonds_1way is overloaded to either add HBond objects to
+/// an HBondSet or to accumulate energy into a EnergyMap
+/// object.  This is done for performance reasons.  The allocation of
+/// the temporary HBondSet on the heap causes a substatial slow down.
+/// The candidate pairs of the two residues are evaluated together in an
+/// HBondBatch, kept per thread so that its arrays are not reallocated.
 void
 identify_hbonds_1way(
 	HBondDatabase const & database,
@@ -553,120 +502,123 @@ identify_hbonds_1way(
 	bool const exclude_bsc, /* exclude if acc=bb and don=sc */
 	bool const exclude_scb, /* exclude if acc=sc and don=bb */
 	bool const exclude_sc,  /* exclude if acc=sc and don=sc */
-	HBondOptions const & options,
 	// output
-	EnergyMap & emap,
+	HBondSet & hbond_set,
 	Real ssdep_weight_factor,
 	bool bond_near_wat
 )
 {
 	debug_assert( don_rsd.seqpos() != acc_rsd.seqpos() );
 
-	// <f1,f2> -- derivative vectors
-	//std::pair< Vector, Vector > deriv( Vector(0.0), Vector(0.0 ) );
-	HBondDerivs derivs;
+	static THREAD_LOCAL HBondBatch batch;
+	batch.clear();
+	add_hbond_candidates_1way( don_rsd, acc_rsd, exclude_bb, exclude_bsc, exclude_scb, exclude_sc, batch );
+	batch.evaluate( database, hbond_set.hbond_options(), evaluate_derivative );
 
-	for ( Size const hatm : don_rsd.Hpos_polar() ) {
+	for ( Size ii = 1; ii <= batch.size(); ++ii ) {
+		Real const unweighted_energy( batch.energy( ii ) );
+		if ( unweighted_energy >= MAX_HB_ENERGY ) continue;
+		HBEvalTuple const & hbe_type( batch.hbt( ii ) );
 
-		Size const datm(don_rsd.atom_base(hatm));
-		bool datm_is_bb = don_rsd.atom_is_backbone(datm);
-		if ( datm_is_bb ) {
-			if ( exclude_bb && exclude_scb ) continue;
-		} else {
-			if ( exclude_sc && exclude_bsc ) continue;
-		}
-		Vector const & hatm_xyz(don_rsd.atom(hatm).xyz());
-		Vector const & datm_xyz(don_rsd.atom(datm).xyz());
+		Real environmental_weight
+			(!hbond_set.hbond_options().use_hb_env_dep() ? 1 :
+			get_environment_dependent_weight(hbe_type, don_nb, acc_nb, hbond_set.hbond_options()));
 
-		for ( Size const aatm : acc_rsd.accpt_pos() ) {
-
-			if ( acc_rsd.atom_is_backbone(aatm) ) {
-				if ( datm_is_bb ) {
-					if ( exclude_bb ) continue;
-				} else {
-					if ( exclude_bsc ) continue;
-				}
-			} else {
-				if ( datm_is_bb ) {
-					if ( exclude_scb ) continue;
-				} else {
-					if ( exclude_sc ) continue;
-				}
-			}
+		// hydrate/SPaDES protocol for when bond is near water
+		if ( hbond_set.hbond_options().water_hybrid_sf() && bond_near_wat ) environmental_weight = 1;
 
-			// rough filter for existence of hydrogen bond
-			if ( hatm_xyz.distance_squared( acc_rsd.xyz( aatm ) ) > MAX_R2 ) continue;
+		Real ssdep_weight = (get_hbond_weight_type(hbe_type.eval_type())==hbw_SR_BB) ?  ssdep_weight_factor : 1.0;
 
-			Real unweighted_energy( 0.0 );
+		//////
+		// now we have identified a hbond -> append it into the hbond_set
+		hbond_set.append_hbond( batch.hatm( ii ), don_rsd, batch.aatm( ii ), acc_rsd,
+			hbe_type, unweighted_energy, environmental_weight*ssdep_weight, batch.derivs( ii ) );
 
-			HBEvalTuple hbe_type( datm, don_rsd, aatm, acc_rsd);
+		//////
 
-			int const base ( acc_rsd.atom_base( aatm ) );
-			int const base2( acc_rsd.abase2( aatm ) );
-			debug_assert( base2 > 0 && base != base2 );
+	} // loop over hbonds
+}
 
-			//std::cout << "about to evaluate " << acc_rsd.atom_name(aatm ) << " " << acc_rsd.atom_name(base ) << acc_rsd.atom_name(base2) << std::endl;
-			//std::cout << "coords " << acc_rsd.atom(aatm ) << "\t" << acc_rsd.atom(base ) << "\t" << acc_rsd.atom(base2) << std::endl;
-			//std::cout << "seqpos " << don_rsd.seqpos() << "\t" << acc_rsd.seqpos() << std::endl;
+void
+identify_hbonds_1way(
+	HBondDatabase const & database,
+	conformation::Residue const & don_rsd,
+	conformation::Residue const & acc_rsd,
+	Size const don_nb,
+	Size const acc_nb,
+	bool const evaluate_derivative,
+	bool const exclude_bb,  /* exclude if acc=bb and don=bb */
+	bool const exclude_bsc, /* exclude if acc=bb and don=sc */
+	bool const exclude_scb, /* exclude if acc=sc and don=bb */
+	bool const exclude_sc,  /* exclude if acc=sc and don=sc */
+	HBondOptions const & options,
+	// output
+	EnergyMap & emap,
+	Real ssdep_weight_factor,
+	bool bond_near_wat
+)
+{
+	debug_assert( don_rsd.seqpos() != acc_rsd.seqpos() );
 
-			hb_energy_deriv( database, options, hbe_type, datm_xyz, hatm_xyz,
-				acc_rsd.atom(aatm ).xyz(),
-				acc_rsd.atom(base ).xyz(),
-				acc_rsd.atom(base2).xyz(),
-				unweighted_energy, evaluate_derivative, derivs);
+	static THREAD_LOCAL HBondBatch batch;
+	batch.clear();
+	add_hbond_candidates_1way( don_rsd, acc_rsd, exclude_bb, exclude_bsc, exclude_scb, exclude_sc, batch );
+	batch.evaluate( database, options, evaluate_derivative );
 
-			if ( unweighted_energy >= MAX_HB_ENERGY ) continue;
+	for ( Size ii = 1; ii <= batch.size(); ++ii ) {
+		Real const unweighted_energy( batch.energy( ii ) );
+		if ( unweighted_energy >= MAX_HB_ENERGY ) continue;
+		HBEvalTuple const & hbe_type( batch.hbt( ii ) );
 
-			Real environmental_weight
-				(!options.use_hb_env_dep() ? 1 :
-				get_environment_dependent_weight(hbe_type, don_nb, acc_nb, options));
-			// hydrate/SPaDES protocol for when bond is near water
-			if ( options.water_hybrid_sf() && bond_near_wat ) environmental_weight = 1;
+		Real environmental_weight
+			(!options.use_hb_env_dep() ? 1 :
+			get_environment_dependent_weight(hbe_type, don_nb, acc_nb, options));
+		// hydrate/SPaDES protocol for when bond is near water
+		if ( options.water_hybrid_sf() && bond_near_wat ) environmental_weight = 1;
 
-			////////
-			// now we have identified an hbond -> accumulate its energy
+		////////
+		// now we have identified an hbond -> accumulate its energy
 
-			Real hbE = unweighted_energy /*raw energy*/ * environmental_weight /*env-dep-wt*/;
+		Real hbE = unweighted_energy /*raw energy*/ * environmental_weight /*env-dep-wt*/;
 
-			// hydrate/SPaDES protocol scoring function
-			if ( options.water_hybrid_sf() ) {
-				if ( ( don_rsd.name() == "TP3" && acc_rsd.name() != "TP3") || ( acc_rsd.name() == "TP3" && don_rsd.name() != "TP3" ) ) {
-					static core::scoring::func::FuncOP smoothed_step ( new core::scoring::func::SmoothStepFunc( -0.55,-0.45 ) );
-					emap[ wat_entropy ] += 1.0 - smoothed_step->func( unweighted_energy );
-				}
-				if ( (don_rsd.name() == "TP3" || acc_rsd.name() == "TP3") ) {
-					emap[ hbond_wat ] += hbE;
-					continue;
-				}
+		// hydrate/SPaDES protocol scoring function
+		if ( options.water_hybrid_sf() ) {
+			if ( ( don_rsd.name() == "TP3" && acc_rsd.name() != "TP3") || ( acc_rsd.name() == "TP3" && don_rsd.name() != "TP3" ) ) {
+				static core::scoring::func::FuncOP smoothed_step ( new core::scoring::func::SmoothStepFunc( -0.55,-0.45 ) );
+				emap[ wat_entropy ] += 1.0 - smoothed_step->func( unweighted_energy );
 			}
-
-			emap[ hbond ] += hbE;
-			switch(get_hbond_weight_type(hbe_type.eval_type())){
-			case hbw_NONE:
-			case hbw_SR_BB :
-				emap[hbond_sr_bb] += ssdep_weight_factor*hbE; break;
-			case hbw_LR_BB :
-				emap[hbond_lr_bb] += hbE; break;
-			case hbw_SR_BB_SC :
-				//Note this is double counting if both hbond_bb_sc and hbond_sr_bb_sc have nonzero weight!
-				emap[hbond_bb_sc] += hbE;
-				emap[hbond_sr_bb_sc] += hbE; break;
-			case hbw_LR_BB_SC :
-				//Note this is double counting if both hbond_bb_sc and hbond_sr_bb_sc have nonzero weight!
-				emap[hbond_bb_sc] += hbE;
-				emap[hbond_lr_bb_sc] += hbE; break;
-			case hbw_SC :
-				emap[hbond_sc] += hbE; break;
-			default :
-				tr.Fatal << "energy from unexpected HB type "
-					<< hbe_type.eval_type() << std::endl;
-				utility_exit_with_message("Unexpected HB type encountered.");
-				break;
+			if ( (don_rsd.name() == "TP3" || acc_rsd.name() == "TP3") ) {
+				emap[ hbond_wat ] += hbE;
+				continue;
 			}
-			/////////
+		}
 
-		} // loop over acceptors
-	} // loop over donors
+		emap[ hbond ] += hbE;
+		switch(get_hbond_weight_type(hbe_type.eval_type())){
+		case hbw_NONE:
+		case hbw_SR_BB :
+			emap[hbond_sr_bb] += ssdep_weight_factor*hbE; break;
+		case hbw_LR_BB :
+			emap[hbond_lr_bb] += hbE; break;
+		case hbw_SR_BB_SC :
+			//Note this is double counting if both hbond_bb_sc and hbond_sr_bb_sc have nonzero weight!
+			emap[hbond_bb_sc] += hbE;
+			emap[hbond_sr_bb_sc] += hbE; break;
+		case hbw_LR_BB_SC :
+			//Note this is double counting if both hbond_bb_sc and hbond_sr_bb_sc have nonzero weight!
+			emap[hbond_bb_sc] += hbE;
+			emap[hbond_lr_bb_sc] += hbE; break;
+		case hbw_SC :
+			emap[hbond_sc] += hbE; break;
+		default :
+			tr.Fatal << "energy from unexpected HB type "
+				<< hbe_type.eval_type() << std::endl;
+			utility_exit_with_message("Unexpected HB type encountered.");
+			break;
+		}
+		/////////
+
+	} // loop over hbonds
 }
 
 void
@@ -691,115 +643,68 @@ identify_hbonds_1way(
 {
 	debug_assert( don_rsd.seqpos() != acc_rsd.seqpos() );
 
-	// <f1,f2> -- derivative vectors
-	//std::pair< Vector, Vector > deriv( Vector(0.0), Vector(0.0 ) );
-	HBondDerivs derivs;
-
-	for ( Size const hatm : don_rsd.Hpos_polar() ) {
-
-		Size const datm(don_rsd.atom_base(hatm));
-		bool datm_is_bb = don_rsd.atom_is_backbone(datm);
-
-		if ( datm_is_bb ) {
-			if ( exclude_bb && exclude_scb ) continue;
-		} else {
-			if ( exclude_sc && exclude_bsc ) continue;
-		}
-		Vector const & hatm_xyz(don_rsd.atom(hatm).xyz());
-		Vector const & datm_xyz(don_rsd.atom(datm).xyz());
-
-		for ( Size const aatm : acc_rsd.accpt_pos() ) {
-
-			if ( acc_rsd.atom_is_backbone(aatm) ) {
-				if ( datm_is_bb ) {
-					if ( exclude_bb ) continue;
-				} else {
-					if ( exclude_bsc ) continue;
-				}
-			} else {
-				if ( datm_is_bb ) {
-					if ( exclude_scb ) continue;
-				} else {
-					if ( exclude_sc ) continue;
-				}
+	static THREAD_LOCAL HBondBatch batch;
+	batch.clear();
+	add_hbond_candidates_1way( don_rsd, acc_rsd, exclude_bb, exclude_bsc, exclude_scb, exclude_sc, batch );
+	batch.evaluate( database, options, evaluate_derivative );
+
+	for ( Size ii = 1; ii <= batch.size(); ++ii ) {
+		Real const unweighted_energy( batch.energy( ii ) );
+		if ( unweighted_energy >= MAX_HB_ENERGY ) continue;
+		HBEvalTuple const & hbe_type( batch.hbt( ii ) );
+		//std::cout << std::endl << "Found a hydrogen bond" << std::endl;
+		num_hbonds[don_rsd.seqpos()]++;
+		num_hbonds[acc_rsd.seqpos()]++;
+
+		Real environmental_weight
+			(!options.use_hb_env_dep() ? 1 :
+			get_environment_dependent_weight(hbe_type, don_nb, acc_nb, options));
+		// hydrate/SPaDES protocol for when bond is near water
+		if ( options.water_hybrid_sf() && bond_near_wat ) environmental_weight = 1;
+
+		////////
+		// now we have identified an hbond -> accumulate its energy
+
+		Real hbE = unweighted_energy /*raw energy*/ * environmental_weight /*env-dep-wt*/;
+
+		// hydrate/SPaDES protocol scoring function
+		if ( options.water_hybrid_sf() ) {
+			if ( ( don_rsd.name() == "TP3" && acc_rsd.name() != "TP3") || ( acc_rsd.name() == "TP3" && don_rsd.name() != "TP3" ) ) {
+				static core::scoring::func::FuncOP smoothed_step ( new core::scoring::func::SmoothStepFunc( -0.55,-0.45 ) );
+				emap[ wat_entropy ] += 1.0 - smoothed_step->func( unweighted_energy );
 			}
-
-			// rough filter for existence of hydrogen bond
-			if ( hatm_xyz.distance_squared( acc_rsd.xyz( aatm ) ) > MAX_R2 ) continue;
-
-			Real unweighted_energy( 0.0 );
-
-			HBEvalTuple hbe_type( datm, don_rsd, aatm, acc_rsd);
-
-			int const base ( acc_rsd.atom_base( aatm ) );
-			int const base2( acc_rsd.abase2( aatm ) );
-			debug_assert( base2 > 0 && base != base2 );
-
-			//std::cout << "about to evaluate " << acc_rsd.atom_name(aatm ) << " " << acc_rsd.atom_name(base ) << acc_rsd.atom_name(base2) << std::endl;
-			//std::cout << "coords " << acc_rsd.atom(aatm ) << "\t" << acc_rsd.atom(base ) << "\t" << acc_rsd.atom(base2) << std::endl;
-			//std::cout << "seqpos " << don_rsd.seqpos() << "\t" << acc_rsd.seqpos() << std::endl;
-
-			hb_energy_deriv( database, options, hbe_type, datm_xyz, hatm_xyz,
-				acc_rsd.atom(aatm ).xyz(),
-				acc_rsd.atom(base ).xyz(),
-				acc_rsd.atom(base2).xyz(),
-				unweighted_energy, evaluate_derivative, derivs);
-
-			if ( unweighted_energy >= MAX_HB_ENERGY ) continue;
-			//std::cout << std::endl << "Found a hydrogen bond" << std::endl;
-			num_hbonds[don_rsd.seqpos()]++;
-			num_hbonds[acc_rsd.seqpos()]++;
-
-			Real environmental_weight
-				(!options.use_hb_env_dep() ? 1 :
-				get_environment_dependent_weight(hbe_type, don_nb, acc_nb, options));
-			// hydrate/SPaDES protocol for when bond is near water
-			if ( options.water_hybrid_sf() && bond_near_wat ) environmental_weight = 1;
-
-			////////
-			// now we have identified an hbond -> accumulate its energy
-
-			Real hbE = unweighted_energy /*raw energy*/ * environmental_weight /*env-dep-wt*/;
-
-			// hydrate/SPaDES protocol scoring function
-			if ( options.water_hybrid_sf() ) {
-				if ( ( don_rsd.name() == "TP3" && acc_rsd.name() != "TP3") || ( acc_rsd.name() == "TP3" && don_rsd.name() != "TP3" ) ) {
-					static core::scoring::func::FuncOP smoothed_step ( new core::scoring::func::SmoothStepFunc( -0.55,-0.45 ) );
-					emap[ wat_entropy ] += 1.0 - smoothed_step->func( unweighted_energy );
-				}
-				if ( (don_rsd.name() == "TP3" || acc_rsd.name() == "TP3") ) {
-					emap[ hbond_wat ] += hbE;
-					continue;
-				}
+			if ( (don_rsd.name() == "TP3" || acc_rsd.name() == "TP3") ) {
+				emap[ hbond_wat ] += hbE;
+				continue;
 			}
+		}
 
-			emap[ hbond ] += hbE;
-			switch(get_hbond_weight_type(hbe_type.eval_type())){
-			case hbw_NONE:
-			case hbw_SR_BB :
-				emap[hbond_sr_bb] += ssdep_weight_factor*hbE; break;
-			case hbw_LR_BB :
-				emap[hbond_lr_bb] += hbE; break;
-			case hbw_SR_BB_SC :
-				//Note this is double counting if both hbond_bb_sc and hbond_sr_bb_sc have nonzero weight!
-				emap[hbond_bb_sc] += hbE;
-				emap[hbond_sr_bb_sc] += hbE; break;
-			case hbw_LR_BB_SC :
-				//Note this is double counting if both hbond_bb_sc and hbond_sr_bb_sc have nonzero weight!
-				emap[hbond_bb_sc] += hbE;
-				emap[hbond_lr_bb_sc] += hbE; break;
-			case hbw_SC :
-				emap[hbond_sc] += hbE; break;
-			default :
-				tr.Fatal << "energy from unexpected HB type "
-					<< hbe_type.eval_type() << std::endl;
-				utility_exit_with_message("Unexpected HB type encountered.");
-				break;
-			}
-			/////////
+		emap[ hbond ] += hbE;
+		switch(get_hbond_weight_type(hbe_type.eval_type())){
+		case hbw_NONE:
+		case hbw_SR_BB :
+			emap[hbond_sr_bb] += ssdep_weight_factor*hbE; break;
+		case hbw_LR_BB :
+			emap[hbond_lr_bb] += hbE; break;
+		case hbw_SR_BB_SC :
+			//Note this is double counting if both hbond_bb_sc and hbond_sr_bb_sc have nonzero weight!
+			emap[hbond_bb_sc] += hbE;
+			emap[hbond_sr_bb_sc] += hbE; break;
+		case hbw_LR_BB_SC :
+			//Note this is double counting if both hbond_bb_sc and hbond_sr_bb_sc have nonzero weight!
+			emap[hbond_bb_sc] += hbE;
+			emap[hbond_lr_bb_sc] += hbE; break;
+		case hbw_SC :
+			emap[hbond_sc] += hbE; break;
+		default :
+			tr.Fatal << "energy from unexpected HB type "
+				<< hbe_type.eval_type() << std::endl;
+			utility_exit_with_message("Unexpected HB type encountered.");
+			break;
+		}
+		/////////
 
-		} // loop over acceptors
-	} // loop over donors
+	} // loop over hbonds
 }
 
 
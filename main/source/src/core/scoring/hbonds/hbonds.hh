@@ -18,6 +18,7 @@
 // Package Headers
 #include <core/scoring/hbonds/types.hh>
 #include <core/scoring/hbonds/HBEvalTuple.hh>
+#include <core/scoring/hbonds/HBondBatch.fwd.hh>
 #include <core/scoring/hbonds/HBondDatabase.fwd.hh>
 #include <core/scoring/hbonds/HBondOptions.fwd.hh>
 #include <core/scoring/hbonds/HBondSet.fwd.hh>
@@ -184,6 +185,19 @@ get_hbond_energies(
 HBondSet const & hbond_set,
 EnergyMap & emap);*/
 
+/// @brief Add to the batch the donor/acceptor pairs of the two residues that identify_hbonds_1way
+/// evaluates: those not excluded by the bb/sc flags and with the H-A distance under the cutoff
+void
+add_hbond_candidates_1way(
+	conformation::Residue const & don_rsd,
+	conformation::Residue const & acc_rsd,
+	bool const exclude_bb,
+	bool const exclude_bsc,
+	bool const exclude_scb,
+	bool const exclude_sc,
+	HBondBatch & batch
+);
+
 void
 identify_hbonds_1way(
 	HBondDatabase const & database,
@@ -21,6 +21,7 @@
 #include <core/scoring/hbonds/FadeInterval.hh>
 #include <core/scoring/hbonds/HBEvalTuple.hh>
 #include <core/scoring/hbonds/HBondDatabase.hh>
+#include <core/scoring/hbonds/HBEvalParams.hh>
 #include <core/scoring/hbonds/HBondTypeManager.hh>
 #include <core/scoring/hbonds/polynomial.hh>
 #include <core/scoring/DerivVectorPair.hh>
@@ -954,16 +955,84 @@ hbond_compute_energy(
 	}
 
 	// rhiju -- prevent O4', O3', O5' hbonds that aren't really seen in RNA structures. may want to separate RNA vs. DNA?
-	if ( hbondoptions.exclude_ether_oxygens() ) {
-		if ( hbt.acc_type() == hbacc_PES_DNA || hbt.acc_type() == hbacc_PES_RNA ||
-				hbt.acc_type() == hbacc_RRI_DNA || hbt.acc_type() == hbacc_RRI_RNA ) return;
+	if ( hbond_excludes_ether_oxygen( hbondoptions, hbt ) ) return;
+
+	bool const use_softmax = hbond_uses_softmax( hbondoptions, hbt,
+		basic::options::option[ basic::options::OptionKeys::score::hbond_new_sp3_acc ]() );
+
+	// The function takes in single precision and computes in double
+	// precision To help numeric stability
+	auto const dAHdis = static_cast<double>(AHdis);
+	auto const dxD    = static_cast<double>(xD);
+	auto const dxH    = static_cast<double>(xH);
+	auto const dxH2   = static_cast<double>(xH2);
+	HBondTerms terms;
+
+	HBEvalParams const & params( database.eval_params_lookup( hbe ) );
+	params.AHdist_short_fade.value_deriv(AHdis, terms.FSr, terms.dFSr);
+	params.AHdist_long_fade.value_deriv(AHdis, terms.FLr, terms.dFLr);
+	params.cosBAH_fade.value_deriv(xH, terms.FxH, terms.dFxH);
+	params.cosBAH2_fade.value_deriv(xH2, terms.FxH2, terms.dFxH2);
+	params.cosAHD_fade.value_deriv(xD, terms.FxD, terms.dFxD);
+
+	// add these checks, of course, to the hbeval reading
+	bool const use_cosAHD = params.use_cosAHD;
+	AHD_geometric_dimension = use_cosAHD ? hbgd_cosAHD : hbgd_AHD;
+
+	Real AHD(-1234);
+	if ( ! use_cosAHD ) {
+		AHD = numeric::constants::d::pi-acos(dxD); // spare this calculation if were evaluating the polynomial in cosine space
+	}
+
+	if ( hbond_terms_out_of_range( params, terms, use_softmax, dAHdis, dxH, dxD, AHD ) ) {
+		energy = MAX_HB_ENERGY + Real(1.0);
+		return;
 	}
 
+	params.AHdist_poly.value_deriv(dAHdis, terms.Pr, terms.dPr);
+	params.cosBAH_short_poly.value_deriv(dxH, terms.PSxH, terms.dPSxH);
+	params.cosBAH_long_poly.value_deriv(dxH, terms.PLxH, terms.dPLxH);
+	params.cosBAH2_poly.value_deriv(dxH2, terms.PxH2, terms.dPxH2);
+	if ( use_cosAHD ) {
+		params.cosAHD_short_poly.value_deriv(dxD, terms.PSxD, terms.dPSxD);
+		params.cosAHD_long_poly.value_deriv(dxD, terms.PLxD, terms.dPLxD);
+	} else {
+		params.cosAHD_short_poly.value_deriv(AHD, terms.PSxD, terms.dPSxD);
+		params.cosAHD_long_poly.value_deriv(AHD, terms.PLxD, terms.dPLxD);
+	}
+
+	//double fade_factor = 1.0; // larger == stiffer fade
+	double const fade_factor = basic::options::option[ basic::options::OptionKeys::score::hbond_fade ].value();
+
+	// NOTE: if any deriv parameter omitted, we don't compute derivatives.
+	bool const evaluate_deriv( &dE_dxH != &DUMMY_DERIV );
+
+	hbond_energy_from_terms( database, hbondoptions, hbt, use_softmax, use_cosAHD, fade_factor,
+		xH, chi, AHD, terms, evaluate_deriv, energy, apply_chi_torsion_penalty,
+		dE_dr, dE_dxD, dE_dxH, dE_dxH2, dE_dBAH, dE_dchi );
+}
+
+bool
+hbond_excludes_ether_oxygen(
+	HBondOptions const & hbondoptions,
+	HBEvalTuple const & hbt
+) {
+	return hbondoptions.exclude_ether_oxygens() &&
+		( hbt.acc_type() == hbacc_PES_DNA || hbt.acc_type() == hbacc_PES_RNA ||
+		hbt.acc_type() == hbacc_RRI_DNA || hbt.acc_type() == hbacc_RRI_RNA );
+}
+
+bool
+hbond_uses_softmax(
+	HBondOptions const & hbondoptions,
+	HBEvalTuple const & hbt,
+	bool const hbond_new_sp3_acc
+) {
 	// fpd -- use softmax for sp3 acceptors?
 	bool use_softmax = false;
 	if ( hbondoptions.measure_sp3acc_BAH_from_hvy() ) {
 		// *optionally* use for all sp3 acceptors
-		if ( basic::options::option[ basic::options::OptionKeys::score::hbond_new_sp3_acc ]() && get_hbe_acc_hybrid(hbe) == chemical::SP3_HYBRID ) {
+		if ( hbond_new_sp3_acc && get_hbe_acc_hybrid(hbt.eval_type()) == chemical::SP3_HYBRID ) {
 			use_softmax = true;
 		}
 		// *always* use for water acceptors
@@ -971,95 +1040,84 @@ hbond_compute_energy(
 			use_softmax=true;
 		}
 	}
+	return use_softmax;
+}
 
-
-	// The function takes in single precision and computes in double
-	// precision To help numeric stability
-	auto const dAHdis = static_cast<double>(AHdis);
-	auto const dxD    = static_cast<double>(xD);
-	auto const dxH    = static_cast<double>(xH);
-	auto const dxH2   = static_cast<double>(xH2);
-	double  Pr(0.0),  PSxD(0.0),  PSxH(0.0),  PLxD(0.0),  PLxH(0.0),  PxH2(0.0); // values of polynomials
-	double dPr(0.0), dPSxD(0.0), dPSxH(0.0), dPLxD(0.0), dPLxH(0.0), dPxH2(0.0); // derivatives of polynomials
-	double  FSr(0.0),  FLr(0.0),  FxD(0.0),  FxH(0.0),  FxH2(0.0); // values of fading intervals
-	double dFSr(0.0), dFLr(0.0), dFxD(0.0), dFxH(0.0), dFxH2(0.0); // derivatives of fading intervals
-
-
-	database.AHdist_short_fade_lookup( hbe )->value_deriv(AHdis, FSr, dFSr);
-	database.AHdist_long_fade_lookup( hbe )->value_deriv(AHdis, FLr, dFLr);
-	database.cosBAH_fade_lookup( hbe )->value_deriv(xH, FxH, dFxH);
-	database.cosBAH2_fade_lookup( hbe )->value_deriv(xH2, FxH2, dFxH2);
-	database.cosAHD_fade_lookup( hbe )->value_deriv(xD, FxD, dFxD);
-
-	double const acc_don_scale = database.acc_strength( hbt.acc_type() ) * database.don_strength( hbt.don_type() );
-
-	if ( FSr == Real(0.0) && FLr == Real(0.0) ) {
+bool
+hbond_terms_out_of_range(
+	HBEvalParams const & params,
+	HBondTerms const & terms,
+	bool const use_softmax,
+	double const dAHdis,
+	double const dxH,
+	double const dxD,
+	Real const AHD
+) {
+	if ( terms.FSr == Real(0.0) && terms.FLr == Real(0.0) ) {
 		// is dAHdis out of range for both its fade function and its polynnomials?  Then set energy > MAX_HB_ENERGY.
-		if ( dAHdis < database.AHdist_poly_lookup( hbe )->xmin() ||
-				dAHdis > database.AHdist_poly_lookup( hbe )->xmax() ) {
-			energy = MAX_HB_ENERGY + Real(1.0);
-			return;
+		if ( dAHdis < params.AHdist_poly.xmin ||
+				dAHdis > params.AHdist_poly.xmax ) {
+			return true;
 		}
 	}
 
-	if ( FxH == Real(0.0) || (use_softmax && FxH2 == Real(0.0)) ) {
+	if ( terms.FxH == Real(0.0) || (use_softmax && terms.FxH2 == Real(0.0)) ) {
 		// is xH out of range for both its fade function and its polynnomials?  Then set energy > MAX_HB_ENERGY.
-		if ( ( dxH < database.cosBAH_short_poly_lookup( hbe )->xmin() && dxH < database.cosBAH_long_poly_lookup( hbe )->xmin() ) ||
-				( dxH > database.cosBAH_short_poly_lookup( hbe )->xmax() && dxH > database.cosBAH_long_poly_lookup( hbe )->xmax() ) ) {
-			energy = MAX_HB_ENERGY + Real(1.0);
-			return;
+		if ( ( dxH < params.cosBAH_short_poly.xmin && dxH < params.cosBAH_long_poly.xmin ) ||
+				( dxH > params.cosBAH_short_poly.xmax && dxH > params.cosBAH_long_poly.xmax ) ) {
+			return true;
 		}
 	}
 
-	// add these checks, of course, to the hbeval reading
-	debug_assert( database.cosAHD_short_poly_lookup(hbe)->geometric_dimension() == database.cosAHD_long_poly_lookup(hbe)->geometric_dimension() );
-	bool const use_cosAHD = database.cosAHD_short_poly_lookup(hbe)->geometric_dimension() == hbgd_cosAHD;
-	AHD_geometric_dimension = use_cosAHD ? hbgd_cosAHD : hbgd_AHD;
-	debug_assert( use_cosAHD || database.cosAHD_short_poly_lookup(hbe)->geometric_dimension() == hbgd_AHD );
-
-	Real AHD(-1234);
-	if ( ! use_cosAHD ) {
-		AHD = numeric::constants::d::pi-acos(dxD); // spare this calculation if were evaluating the polynomial in cosine space
-	}
-
-	if ( FxD == Real(0.0) ) {
+	if ( terms.FxD == Real(0.0) ) {
 		// is xD out of range for both its fade function and its polynnomials?  Then set energy > MAX_HB_ENERGY.
-		if ( use_cosAHD ) {
-			if ( ( dxD < database.cosAHD_short_poly_lookup( hbe )->xmin() && dxD < database.cosAHD_long_poly_lookup( hbe )->xmin() ) ||
-					( dxD > database.cosAHD_short_poly_lookup( hbe )->xmax() && dxD > database.cosAHD_long_poly_lookup( hbe )->xmax() ) ) {
-				energy = MAX_HB_ENERGY + Real(1.0);
-				return;
+		if ( params.use_cosAHD ) {
+			if ( ( dxD < params.cosAHD_short_poly.xmin && dxD < params.cosAHD_long_poly.xmin ) ||
+					( dxD > params.cosAHD_short_poly.xmax && dxD > params.cosAHD_long_poly.xmax ) ) {
+				return true;
 			}
 		} else {
-			if ( ( AHD < database.cosAHD_short_poly_lookup( hbe )->xmin() && AHD < database.cosAHD_long_poly_lookup( hbe )->xmin() ) ||
-					( AHD > database.cosAHD_short_poly_lookup( hbe )->xmax() && AHD > database.cosAHD_long_poly_lookup( hbe )->xmax() ) ) {
-				energy = MAX_HB_ENERGY + Real(1.0);
-				return;
+			if ( ( AHD < params.cosAHD_short_poly.xmin && AHD < params.cosAHD_long_poly.xmin ) ||
+					( AHD > params.cosAHD_short_poly.xmax && AHD > params.cosAHD_long_poly.xmax ) ) {
+				return true;
 			}
 		}
 	}
+	return false;
+}
 
-	(*database.AHdist_poly_lookup( hbe ))(dAHdis, Pr, dPr);
-	(*database.cosBAH_short_poly_lookup( hbe ))(dxH, PSxH, dPSxH);
-	(*database.cosBAH_long_poly_lookup( hbe ))(dxH, PLxH, dPLxH);
-	(*database.cosBAH2_poly_lookup( hbe ))(dxH2, PxH2, dPxH2);
-	if ( use_cosAHD ) {
-		(*database.cosAHD_short_poly_lookup( hbe ))(dxD, PSxD, dPSxD);
-		(*database.cosAHD_long_poly_lookup( hbe ))(dxD, PLxD, dPLxD);
-	} else {
-		(*database.cosAHD_short_poly_lookup( hbe ))(AHD, PSxD, dPSxD);
-		(*database.cosAHD_long_poly_lookup( hbe ))(AHD, PLxD, dPLxD);
-	}
+void
+hbond_energy_from_terms(
+	HBondDatabase const & database,
+	HBondOptions const & hbondoptions,
+	HBEvalTuple const & hbt,
+	bool const use_softmax,
+	bool const use_cosAHD,
+	double const fade_factor,
+	Real const xH,
+	Real const chi,
+	Real const AHD,
+	HBondTerms const & t,
+	bool const evaluate_deriv,
+	Real & energy,
+	bool & apply_chi_torsion_penalty,
+	Real & dE_dr,
+	Real & dE_dxD,
+	Real & dE_dxH,
+	Real & dE_dxH2,
+	Real & dE_dBAH,
+	Real & dE_dchi
+) {
+	HBEvalType const hbe = hbt.eval_type();
+	double const acc_don_scale = database.acc_strength( hbt.acc_type() ) * database.don_strength( hbt.don_type() );
 
-	//double fade_factor = 1.0; // larger == stiffer fade
 	double exp1 = 0, exp2 = 0;
-	double fade_factor = basic::options::option[ basic::options::OptionKeys::score::hbond_fade ].value();
 	if ( !use_softmax ) {
-		energy = Pr*FxD*FxH + FSr*(PSxD*FxH + FxD*PSxH) + FLr*(PLxD*FxH + FxD*PLxH);
+		energy = t.Pr*t.FxD*t.FxH + t.FSr*(t.PSxD*t.FxH + t.FxD*t.PSxH) + t.FLr*(t.PLxD*t.FxH + t.FxD*t.PLxH);
 	} else {
 		// fade between both angles
-		double energy1 = Pr*FxD*FxH  + FSr*(PSxD*FxH + FxD*PSxH)  + FLr*(PLxD*FxH + FxD*PLxH);
-		double energy2 = Pr*FxD*FxH2 + FSr*(PSxD*FxH2 + FxD*PxH2) + FLr*(PLxD*FxH2 + FxD*PxH2);
+		double energy1 = t.Pr*t.FxD*t.FxH  + t.FSr*(t.PSxD*t.FxH + t.FxD*t.PSxH)  + t.FLr*(t.PLxD*t.FxH + t.FxD*t.PLxH);
+		double energy2 = t.Pr*t.FxD*t.FxH2 + t.FSr*(t.PSxD*t.FxH2 + t.FxD*t.PxH2) + t.FLr*(t.PLxD*t.FxH2 + t.FxD*t.PxH2);
 
 		//FPD: new way
 		exp1 = exp(energy1*fade_factor);
@@ -1090,8 +1148,7 @@ hbond_compute_energy(
 	// dE_dBAH *= acc_don_scale; // moved inside chi energy computations
 	// dE_dchi *= acc_don_scale;
 
-	// NOTE: if any deriv parameter omitted, we don't compute derivatives.
-	if ( &dE_dxH == &DUMMY_DERIV ) {
+	if ( ! evaluate_deriv ) {
 		if ( hbondoptions.fade_energy() ) {
 			fade_energy(energy);
 		}
@@ -1100,36 +1157,36 @@ hbond_compute_energy(
 
 	if ( !use_softmax ) {
 		// old version
-		dE_dr =  dPr*FxD*FxH + dFSr*(PSxD*FxH + FxD*PSxH) + dFLr*(PLxD*FxH + FxD*PLxH);
+		dE_dr =  t.dPr*t.FxD*t.FxH + t.dFSr*(t.PSxD*t.FxH + t.FxD*t.PSxH) + t.dFLr*(t.PLxD*t.FxH + t.FxD*t.PLxH);
 		dE_dr *= acc_don_scale;
 
 		if ( use_cosAHD ) {
-			dE_dxD = dFxD*(Pr*FxH + FLr*PLxH + FSr*PSxH) + FxH*(FSr*dPSxD + FLr*dPLxD);
+			dE_dxD = t.dFxD*(t.Pr*t.FxH + t.FLr*t.PLxH + t.FSr*t.PSxH) + t.FxH*(t.FSr*t.dPSxD + t.FLr*t.dPLxD);
 		} else {
 			/// the fade function is still evaluated in cosine space, so its derivatives have to
 			/// be converted to units of dE/dAHD by multiplying dE/dcosAHD by sin(AHD)
 			/// the polynomial's derivatives, on the other hand, is already in units of dE/dAHD
-			dE_dxD = dFxD*(Pr*FxH + FLr*PLxH + FSr*PSxH)*sin(AHD) + FxH*(FSr*dPSxD + FLr*dPLxD);
+			dE_dxD = t.dFxD*(t.Pr*t.FxH + t.FLr*t.PLxH + t.FSr*t.PSxH)*sin(AHD) + t.FxH*(t.FSr*t.dPSxD + t.FLr*t.dPLxD);
 		}
 		dE_dxD *= acc_don_scale;
 
-		dE_dxH = dFxH*(Pr*FxD + FLr*PLxD + FSr*PSxD) + FxD*(FSr*dPSxH + FLr*dPLxH);
+		dE_dxH = t.dFxH*(t.Pr*t.FxD + t.FLr*t.PLxD + t.FSr*t.PSxD) + t.FxD*(t.FSr*t.dPSxH + t.FLr*t.dPLxH);
 		dE_dxH *= acc_don_scale;
 	} else {
 		// fpd - a bit more complicated with the fade ...
-		double dE1_dr = dPr*FxD*FxH + dFSr*(PSxD*FxH + FxD*PSxH) + dFLr*(PLxD*FxH + FxD*PLxH);
-		double dE2_dr = dPr*FxD*FxH2 + dFSr*(PSxD*FxH2 + FxD*PxH2) + dFLr*(PLxD*FxH2 + FxD*PxH2);
+		double dE1_dr = t.dPr*t.FxD*t.FxH + t.dFSr*(t.PSxD*t.FxH + t.FxD*t.PSxH) + t.dFLr*(t.PLxD*t.FxH + t.FxD*t.PLxH);
+		double dE2_dr = t.dPr*t.FxD*t.FxH2 + t.dFSr*(t.PSxD*t.FxH2 + t.FxD*t.PxH2) + t.dFLr*(t.PLxD*t.FxH2 + t.FxD*t.PxH2);
 		double dE1_dxD, dE2_dxD;
 		if ( use_cosAHD ) {
-			dE1_dxD = dFxD*(Pr*FxH + FLr*PLxH + FSr*PSxH) + FxH*(FSr*dPSxD + FLr*dPLxD);
-			dE2_dxD = dFxD*(Pr*FxH2 + FLr*PxH2 + FSr*PxH2) + FxH2*(FSr*dPSxD + FLr*dPLxD);
+			dE1_dxD = t.dFxD*(t.Pr*t.FxH + t.FLr*t.PLxH + t.FSr*t.PSxH) + t.FxH*(t.FSr*t.dPSxD + t.FLr*t.dPLxD);
+			dE2_dxD = t.dFxD*(t.Pr*t.FxH2 + t.FLr*t.PxH2 + t.FSr*t.PxH2) + t.FxH2*(t.FSr*t.dPSxD + t.FLr*t.dPLxD);
 		} else {
-			dE1_dxD = dFxD*(Pr*FxH + FLr*PLxH + FSr*PSxH)*sin(AHD) + FxH*(FSr*dPSxD + FLr*dPLxD);
-			dE2_dxD = dFxD*(Pr*FxH2 + FLr*PxH2 + FSr*PxH2)*sin(AHD) + FxH2*(FSr*dPSxD + FLr*dPLxD);
+			dE1_dxD = t.dFxD*(t.Pr*t.FxH + t.FLr*t.PLxH + t.FSr*t.PSxH)*sin(AHD) + t.FxH*(t.FSr*t.dPSxD + t.FLr*t.dPLxD);
+			dE2_dxD = t.dFxD*(t.Pr*t.FxH2 + t.FLr*t.PxH2 + t.FSr*t.PxH2)*sin(AHD) + t.FxH2*(t.FSr*t.dPSxD + t.FLr*t.dPLxD);
 		}
 
-		double dE1_dxH    = dFxH*(Pr*FxD + FLr*PLxD + FSr*PSxD) + FxD*(FSr*dPSxH + FLr*dPLxH);
-		double dE2_dxH2   = dFxH2*(Pr*FxD + FLr*PLxD + FSr*PSxD) + FxD*(FSr*dPxH2 + FLr*dPxH2);
+		double dE1_dxH    = t.dFxH*(t.Pr*t.FxD + t.FLr*t.PLxD + t.FSr*t.PSxD) + t.FxD*(t.FSr*t.dPSxH + t.FLr*t.dPLxH);
+		double dE2_dxH2   = t.dFxH2*(t.Pr*t.FxD + t.FLr*t.PLxD + t.FSr*t.PSxD) + t.FxD*(t.FSr*t.dPxH2 + t.FLr*t.dPxH2);
 
 		dE_dr = (exp1*dE1_dr + exp2*dE2_dr) / (fade_factor*(exp1+exp2));
 		dE_dxD = (exp1*dE1_dxD + exp2*dE2_dxD) / (fade_factor*(exp1+exp2));
@@ -1288,17 +1345,7 @@ hb_energy_deriv_u2(
 	if ( xH2 < MIN_xH ) return;
 	if ( xH2 > MAX_xH ) return;
 
-	Real chi( 0 );
-	if ( hbondoptions.use_sp2_chi_penalty() &&
-			get_hbe_acc_hybrid( hbt.eval_type() ) == chemical::SP2_HYBRID &&
-			B2xyz != Vector(-1.0, -1.0, -1.0) ) {
-		chi = numeric::dihedral_radians( Hxyz, Axyz, Bxyz, B2xyz );
-	} else if ( hbondoptions.measure_sp3acc_BAH_from_hvy() &&
-			( hbt.acc_type() == hbacc_AHX || hbt.acc_type() == hbacc_HXL ) ) {
-		/// Bxyz really is the heavy atom base and B2xyz really is the hydroxyl hydrogen
-		/// this is guaranteed by the hbond_measure_sp3acc_BAH_from_hvy flag.
-		chi = numeric::dihedral_radians( Hxyz, Axyz, Bxyz, B2xyz );
-	}
+	Real const chi( hb_acceptor_chi( hbondoptions, hbt, Hxyz, Axyz, Bxyz, B2xyz ) );
 	//std::cout << " hb_energy_deriv_u2" <<
 	// " h  =(" << Hxyz.x() << " " << Hxyz.y() << " " << Hxyz.z() << ")\n" <<
 	// " d  =(" << Dxyz.x() << " " << Dxyz.y() << " " << Dxyz.z() << ")\n" <<
@@ -1339,6 +1386,53 @@ hb_energy_deriv_u2(
 
 	if ( energy >= MAX_HB_ENERGY ) return;
 
+	hb_deriv_vectors( deriv_type, AHD_geometric_dimension, apply_chi_torsion_penalty,
+		dE_dr, dE_dxD, dE_dxH, dE_dxH2, dE_dBAH, dE_dchi, chi,
+		Hxyz, Dxyz, Axyz, Bxyz, B2xyz, deriv );
+}
+
+Real
+hb_acceptor_chi(
+	HBondOptions const & hbondoptions,
+	HBEvalTuple const & hbt,
+	Vector const & Hxyz,
+	Vector const & Axyz,
+	Vector const & Bxyz,
+	Vector const & B2xyz
+) {
+	Real chi( 0 );
+	if ( hbondoptions.use_sp2_chi_penalty() &&
+			get_hbe_acc_hybrid( hbt.eval_type() ) == chemical::SP2_HYBRID &&
+			B2xyz != Vector(-1.0, -1.0, -1.0) ) {
+		chi = numeric::dihedral_radians( Hxyz, Axyz, Bxyz, B2xyz );
+	} else if ( hbondoptions.measure_sp3acc_BAH_from_hvy() &&
+			( hbt.acc_type() == hbacc_AHX || hbt.acc_type() == hbacc_HXL ) ) {
+		/// Bxyz really is the heavy atom base and B2xyz really is the hydroxyl hydrogen
+		/// this is guaranteed by the hbond_measure_sp3acc_BAH_from_hvy flag.
+		chi = numeric::dihedral_radians( Hxyz, Axyz, Bxyz, B2xyz );
+	}
+	return chi;
+}
+
+void
+hb_deriv_vectors(
+	HBDerivType const deriv_type,
+	HBGeoDimType const AHD_geometric_dimension,
+	bool const apply_chi_torsion_penalty,
+	Real const dE_dr,
+	Real const dE_dxD,
+	Real const dE_dxH,
+	Real const dE_dxH2,
+	Real const dE_dBAH,
+	Real const dE_dchi,
+	Real chi, // overwritten by the dihedral derivative functions
+	Vector const & Hxyz,
+	Vector const & Dxyz,
+	Vector const & Axyz,
+	Vector const & Bxyz,
+	Vector const & B2xyz,
+	HBondDerivs & deriv
+) {
 	deriv.h_deriv.f1() = deriv.h_deriv.f2() = Vector(0.0);
 	deriv.acc_deriv.f1() = deriv.acc_deriv.f2() = Vector(0.0);
 	deriv.don_deriv.f1() = deriv.don_deriv.f2() = Vector(0.0);
@@ -1496,6 +1590,53 @@ hb_energy_deriv_u2(
 }
 
 
+
+bool
+hb_donor_unit_vector(
+	Vector const & Dxyz,
+	Vector const & Hxyz,
+	Vector & HDunit
+) {
+	//car  H->D unit vector, dis2
+	HDunit = Dxyz - Hxyz;
+	Real const HDdis2( HDunit.length_squared() );
+
+	// NaN check
+	if ( ! utility::isfinite( HDdis2 ) ) {
+		std::string const warning( "NAN occurred in H-bonding calculations!" );
+		PyAssert(false, warning); // allows for better error handling from within Python
+		tr.Error << warning << std::endl;
+		tr.Error << "Dxyz " << Dxyz << "  Hxyz " << Hxyz << std::endl;
+		print_backtrace( warning.c_str() );
+
+#ifndef BOINC
+		bool fail_on_bad_hbond = basic::options::option[ basic::options::OptionKeys::in::file::fail_on_bad_hbond ]();
+		if ( fail_on_bad_hbond ) {
+			throw( CREATE_EXCEPTION(utility::excn::Exception, warning ) );
+			// AMW: cppcheck flags this as unnecessary; I am keeping it just in case
+			// because BOINC is important
+			utility_exit();
+		}
+#endif
+	}
+
+	if ( HDdis2 < 0.64 || HDdis2 > 1.5625 ) { // .8 to 1.25A
+		if ( true ) {
+			// this warning was runlevel dependent
+			if ( tr.Debug.visible() ) {
+				tr.Debug << "hb_energy_deriv has H(" << Hxyz(1) << ","
+					<< Hxyz(2)<< "," << Hxyz(3) << ") D(" << Dxyz(1) << "," << Dxyz(2)
+					<< "," << Dxyz(3) << ")  distance out of range " << std::sqrt( HDdis2 ) << std::endl;
+			}
+		}
+		return false;
+	}
+
+	Real const inv_HDdis = 1.0f / std::sqrt( HDdis2 );
+	HDunit *= inv_HDdis;
+	return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// @remarks See comments on helper function above.
@@ -1550,39 +1691,8 @@ hb_energy_deriv(
 	//Objexx: Local arrays declared static for speed
 	//JSS all early exits are in helper above, so this version of the function is deprecated.
 	//These unit vectors are invariant for hbonded pairs and can be precalculated.
-	//car  H->D unit vector, dis2
 	Vector HDunit;
-	HDunit = Dxyz - Hxyz;
-	Real const HDdis2( HDunit.length_squared() );
-
-	// NaN check
-	if ( ! utility::isfinite( HDdis2 ) ) {
-		std::string const warning( "NAN occurred in H-bonding calculations!" );
-		PyAssert(false, warning); // allows for better error handling from within Python
-		tr.Error << warning << std::endl;
-		tr.Error << "Dxyz " << Dxyz << "  Hxyz " << Hxyz << std::endl;
-		print_backtrace( warning.c_str() );
-
-#ifndef BOINC
-		bool fail_on_bad_hbond = basic::options::option[ basic::options::OptionKeys::in::file::fail_on_bad_hbond ]();
-		if ( fail_on_bad_hbond ) {
-			throw( CREATE_EXCEPTION(utility::excn::Exception, warning ) );
-			// AMW: cppcheck flags this as unnecessary; I am keeping it just in case
-			// because BOINC is important
-			utility_exit();
-		}
-#endif
-	}
-
-	if ( HDdis2 < 0.64 || HDdis2 > 1.5625 ) { // .8 to 1.25A
-		if ( true ) {
-			// this warning was runlevel dependent
-			if ( tr.Debug.visible() ) {
-				tr.Debug << "hb_energy_deriv has H(" << Hxyz(1) << ","
-					<< Hxyz(2)<< "," << Hxyz(3) << ") D(" << Dxyz(1) << "," << Dxyz(2)
-					<< "," << Dxyz(3) << ")  distance out of range " << std::sqrt( HDdis2 ) << std::endl;
-			}
-		}
+	if ( ! hb_donor_unit_vector( Dxyz, Hxyz, HDunit ) ) {
 		energy = 0.0;
 		//deriv.first = Vector( 0.0 );
 		//deriv.second = Vector( 0.0 );
@@ -1590,9 +1700,6 @@ hb_energy_deriv(
 		return;
 	}
 
-	Real const inv_HDdis = 1.0f / std::sqrt( HDdis2 );
-	HDunit *= inv_HDdis;
-
 	//car  B->A unit vector
 	Vector BAunit( 0.0 ), B2Aunit( 0.0 );
 	// the pseudo-base xyz coordinate
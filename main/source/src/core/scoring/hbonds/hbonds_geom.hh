@@ -17,6 +17,7 @@
 // Package headers
 #include <core/scoring/DerivVectorPair.fwd.hh>
 
+#include <core/scoring/hbonds/HBEvalParams.fwd.hh>
 #include <core/scoring/hbonds/HBEvalTuple.hh>
 #include <core/scoring/hbonds/HBondDatabase.fwd.hh>
 #include <core/scoring/hbonds/HBondOptions.hh>
@@ -118,6 +119,112 @@ hbond_compute_energy(
 	Real & dchipen_dchi = DUMMY_DERIV
 );
 
+/// @brief The values and derivatives of the polynomials and of the fade intervals of an hbond
+/// in each of its geometric dimensions; see hbond_compute_energy()
+struct HBondTerms {
+	double  Pr = 0.0,  PSxD = 0.0,  PSxH = 0.0,  PLxD = 0.0,  PLxH = 0.0,  PxH2 = 0.0; // values of polynomials
+	double dPr = 0.0, dPSxD = 0.0, dPSxH = 0.0, dPLxD = 0.0, dPLxH = 0.0, dPxH2 = 0.0; // derivatives of polynomials
+	double  FSr = 0.0,  FLr = 0.0,  FxD = 0.0,  FxH = 0.0,  FxH2 = 0.0; // values of fading intervals
+	double dFSr = 0.0, dFLr = 0.0, dFxD = 0.0, dFxH = 0.0, dFxH2 = 0.0; // derivatives of fading intervals
+};
+
+/// @brief Are hbonds to this (RNA/DNA ether oxygen) acceptor turned off?
+bool
+hbond_excludes_ether_oxygen(
+	HBondOptions const & hbondoptions,
+	HBEvalTuple const & hbt
+);
+
+/// @brief Should the energy be a softmax over the BAH and B2AH angles (sp3 acceptors with
+/// the BAH angle measured from the heavy atom)?  hbond_new_sp3_acc is the value of -score:hbond_new_sp3_acc.
+bool
+hbond_uses_softmax(
+	HBondOptions const & hbondoptions,
+	HBEvalTuple const & hbt,
+	bool const hbond_new_sp3_acc
+);
+
+/// @brief Is the hbond outside of both the fade interval and the polynomials of one of
+/// its geometric dimensions?  Needs only the fade interval values of the terms.
+bool
+hbond_terms_out_of_range(
+	HBEvalParams const & params,
+	HBondTerms const & terms,
+	bool const use_softmax,
+	double const dAHdis,
+	double const dxH,
+	double const dxD,
+	Real const AHD
+);
+
+/// @brief The last step of hbond_compute_energy(): combine the evaluated polynomials and fade
+/// intervals into the energy, add the chi torsion penalty, and, if evaluate_deriv, compute
+/// the derivatives with respect to the geometric dimensions.
+void
+hbond_energy_from_terms(
+	HBondDatabase const & database,
+	HBondOptions const & hbondoptions,
+	HBEvalTuple const & hbt,
+	bool const use_softmax,
+	bool const use_cosAHD,
+	double const fade_factor,
+	Real const xH,
+	Real const chi,
+	Real const AHD,
+	HBondTerms const & terms,
+	bool const evaluate_deriv,
+	Real & energy,
+	bool & apply_chi_torsion_penalty,
+	Real & dE_dr,
+	Real & dE_dxD,
+	Real & dE_dxH,
+	Real & dE_dxH2,
+	Real & dE_dBAH,
+	Real & dE_dchi
+);
+
+/// @brief The unit vector from the hydrogen toward the donor; false if the H-D distance is
+/// outside of [0.8, 1.25] A, in which case hb_energy_deriv() gives a zero energy
+bool
+hb_donor_unit_vector(
+	Vector const & Dxyz,
+	Vector const & Hxyz,
+	Vector & HDunit
+);
+
+/// @brief The AB2-AB-A-H dihedral of the chi torsion penalty, or zero if the penalty does not apply
+Real
+hb_acceptor_chi(
+	HBondOptions const & hbondoptions,
+	HBEvalTuple const & hbt,
+	Vector const & Hxyz,
+	Vector const & Axyz,
+	Vector const & Bxyz,
+	Vector const & B2xyz
+);
+
+/// @brief The f1/f2 vectors of the atoms of an hbond, from the derivatives of its energy
+/// with respect to the geometric dimensions; the derivative step of hb_energy_deriv_u2()
+void
+hb_deriv_vectors(
+	HBDerivType const deriv_type,
+	HBGeoDimType const AHD_geometric_dimension,
+	bool const apply_chi_torsion_penalty,
+	Real const dE_dr,
+	Real const dE_dxD,
+	Real const dE_dxH,
+	Real const dE_dxH2,
+	Real const dE_dBAH,
+	Real const dE_dchi,
+	Real chi,
+	Vector const & Hxyz,
+	Vector const & Dxyz,
+	Vector const & Axyz,
+	Vector const & Bxyz,
+	Vector const & B2xyz,
+	HBondDerivs & deriv
+);
+
 
 /// @brief Evaluate the hydrogen bond energy and derivatives after having first calculated
 /// the HD and BA *u*nit vectors
@@ -388,6 +388,11 @@ struct HBondDerivs {
 		return h_deriv;
 	}
 
+	DerivVectorPair const &
+	deriv( which_atom_in_hbond which ) const {
+		return const_cast< HBondDerivs & >( *this ).deriv( which );
+	}
+
 	DerivVectorPair don_deriv;    // derivative vectors for the heavyatom donor for a hydrogen
 	DerivVectorPair h_deriv;      // derivative vectors for the hydrogen forming a hydrogen bond
 	DerivVectorPair acc_deriv;    // derivative vectors for the heavyatom acceptor for a hydrogen
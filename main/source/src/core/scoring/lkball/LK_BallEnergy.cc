@@ -831,12 +831,20 @@ LK_BallEnergy::prepare_rotamers_for_packing(
 	/// create a rotamer set info object
 	LKB_RotamerSetInfoOP info( new LKB_RotamerSetInfo );
 
+	// place the waters of all rotamers in one pass
+	WaterBatchBuilder waters;
 	for ( Size n=1; n<= rotamer_set.num_rotamers(); ++n ) {
-		conformation::ResidueOP rot( rotamer_set.nonconst_rotamer(n) );
-		LKB_ResidueInfoOP rotinfo( new LKB_ResidueInfo( *rot, false ) );
-		rot->nonconst_data_ptr()->set( conformation::residue_datacache::LK_BALL_INFO, rotinfo->clone() ); // DataCache::set() does not clone
+		LKB_ResidueInfoOP rotinfo( new LKB_ResidueInfo );
+		rotinfo->initialize( rotamer_set.rotamer(n)->type() );
+		waters.add( *rotinfo, *rotamer_set.rotamer(n) );
 		info->append( rotinfo );
 	}
+	waters.build();
+
+	for ( Size n=1; n<= rotamer_set.num_rotamers(); ++n ) {
+		conformation::ResidueOP rot( rotamer_set.nonconst_rotamer(n) );
+		rot->nonconst_data_ptr()->set( conformation::residue_datacache::LK_BALL_INFO, (*info)[ n ].clone() ); // DataCache::set() does not clone
+	}
 
 	rotamer_set.data().set( conformation::RotamerSetCacheableDataType::LK_BALL_ROTAMER_SET_INFO, info );
 
@@ -50,6 +50,8 @@
 #include <utility/io/izstream.hh>
 #include <utility/tools/make_vector1.hh>
 
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 
 // #include <utility/vector1.functions.hh> // HACK
@@ -451,7 +453,14 @@ WaterBuilderForRestype::WaterBuilderForRestype(
 		water_offset_for_atom_[ ii ] = n_waters_;
 		n_waters_for_atom_[ ii ] = ii_nwaters;
 		n_waters_ += ii_nwaters;
+		for ( WaterBuilder const & builder : builders[ ii ] ) {
+			stub_atoms_.push_back( builder.atom1() );
+			stub_atoms_.push_back( builder.atom2() );
+			stub_atoms_.push_back( builder.atom3() );
+		}
 	}
+	std::sort( stub_atoms_.begin(), stub_atoms_.end() );
+	stub_atoms_.erase( std::unique( stub_atoms_.begin(), stub_atoms_.end() ), stub_atoms_.end() );
 }
 
 
@@ -637,6 +646,9 @@ LKB_ResidueInfo::build_waters( Residue const & rsd, bool compute_derivs )
 
 	if ( !has_waters_ ) return;
 
+	// The waters only move when the atoms they are built from do
+	if ( waters_current( rsd ) && ( derivs_current_ || !compute_derivs ) ) return;
+
 	if ( compute_derivs ) {
 		dwater_datom_ready_ = true;
 		dwater_datom1_.resize( water_builders_->n_waters() );
@@ -658,6 +670,29 @@ LKB_ResidueInfo::build_waters( Residue const & rsd, bool compute_derivs )
 			}
 		}
 	}
+	record_stub_xyz( rsd );
+	derivs_current_ = compute_derivs;
+}
+
+bool
+LKB_ResidueInfo::waters_current( Residue const & rsd ) const
+{
+	utility::vector1< Size > const & stub_atoms( water_builders_->stub_atoms() );
+	if ( stub_xyz_.size() != stub_atoms.size() ) return false;
+	for ( Size ii = 1; ii <= stub_atoms.size(); ++ii ) {
+		if ( stub_xyz_[ ii ] != rsd.xyz( stub_atoms[ ii ] ) ) return false;
+	}
+	return true;
+}
+
+void
+LKB_ResidueInfo::record_stub_xyz( Residue const & rsd )
+{
+	utility::vector1< Size > const & stub_atoms( water_builders_->stub_atoms() );
+	stub_xyz_.resize( stub_atoms.size() );
+	for ( Size ii = 1; ii <= stub_atoms.size(); ++ii ) {
+		stub_xyz_[ ii ] = rsd.xyz( stub_atoms[ ii ] );
+	}
 }
 
 WaterBuilders const &
@@ -696,6 +731,8 @@ LKB_ResidueInfo::initialize( ResidueType const & rsd )
 	water_builders_ = LKBallDatabase::get_instance()->get_water_builder_for_restype( rsd );
 	waters_.resize( water_builders_->n_waters(), Vector( 0.0 ) );
 	has_waters_ = waters_.size() > 0;
+	stub_xyz_.clear();
+	derivs_current_ = false;
 
 }
 
@@ -729,6 +766,94 @@ LKB_ResidueInfo::matches_residue_type( chemical::ResidueType const & rsd_type )
 chemical::ResidueType const &
 LKB_ResidueInfo::residue_type() const { return *rsd_type_; }
 
+/////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////
+
+WaterBatchBuilder::WaterBatchBuilder() = default;
+
+void
+WaterBatchBuilder::add( LKB_ResidueInfo & info, Residue const & rsd )
+{
+	if ( !info.matches_residue_type( rsd.type() ) ) {
+		utility_exit_with_message("WaterBatchBuilder::add: mismatch: "+info.residue_type().name()+" "+rsd.type().name() );
+	}
+	if ( !info.has_waters() || info.waters_current( rsd ) ) return;
+
+	WaterBuilderForRestype const & builders( *info.water_builders_ );
+	for ( Size ii=1; ii <= rsd.nheavyatoms(); ++ii ) {
+		Size ii_offset = builders.water_offset_for_atom()[ ii ];
+		WaterBuilders const & ii_water_builders( builders.builders()[ ii ] );
+		for ( Size jj=1, jj_end = ii_water_builders.size(); jj <= jj_end; ++jj ) {
+			WaterBuilder const & builder( ii_water_builders[ jj ] );
+			Vector const & a1( rsd.xyz( builder.atom1() ) ), & a2( rsd.xyz( builder.atom2() ) ), & a3( rsd.xyz( builder.atom3() ) );
+			dest_.push_back( & info.waters_[ jj + ii_offset ] );
+			builder_.push_back( & builder );
+			rsd_.push_back( & rsd );
+			a1x_.push_back( a1.x() ); a1y_.push_back( a1.y() ); a1z_.push_back( a1.z() );
+			a2x_.push_back( a2.x() ); a2y_.push_back( a2.y() ); a2z_.push_back( a2.z() );
+			a3x_.push_back( a3.x() ); a3y_.push_back( a3.y() ); a3z_.push_back( a3.z() );
+			lx_.push_back( builder.xyz_local().x() ); ly_.push_back( builder.xyz_local().y() ); lz_.push_back( builder.xyz_local().z() );
+		}
+	}
+	info.record_stub_xyz( rsd );
+	info.derivs_current_ = false;
+}
+
+/// @details The arithmetic of kinematics::Stub( atom1, atom2, atom3 ).local2global( xyz_local ),
+/// operation for operation, for all queued waters.
+void
+WaterBatchBuilder::build()
+{
+	Size const n( dest_.size() );
+	wx_.resize( n ); wy_.resize( n ); wz_.resize( n );
+	degenerate_.resize( n );
+
+	Real const * const a1x( a1x_.data() ), * const a1y( a1y_.data() ), * const a1z( a1z_.data() );
+	Real const * const a2x( a2x_.data() ), * const a2y( a2y_.data() ), * const a2z( a2z_.data() );
+	Real const * const a3x( a3x_.data() ), * const a3y( a3y_.data() ), * const a3z( a3z_.data() );
+	Real const * const lx( lx_.data() ), * const ly( ly_.data() ), * const lz( lz_.data() );
+	Real * const wx( wx_.data() ), * const wy( wy_.data() ), * const wz( wz_.data() );
+	char * const degenerate( degenerate_.data() );
+
+	for ( Size ii = 0; ii < n; ++ii ) {
+		// e1: unit vector from atom2 to atom1
+		Real e1x( a1x[ ii ] - a2x[ ii ] ), e1y( a1y[ ii ] - a2y[ ii ] ), e1z( a1z[ ii ] - a2z[ ii ] );
+		Real const len1( std::sqrt( ( e1x * e1x ) + ( e1y * e1y ) + ( e1z * e1z ) ) );
+		Real const inv1( Real( 1 ) / len1 );
+		e1x *= inv1; e1y *= inv1; e1z *= inv1;
+
+		// e3: unit normal to the atom1-atom2-atom3 plane
+		Real const dx( a3x[ ii ] - a2x[ ii ] ), dy( a3y[ ii ] - a2y[ ii ] ), dz( a3z[ ii ] - a2z[ ii ] );
+		Real e3x( ( e1y * dz ) - ( e1z * dy ) ), e3y( ( e1z * dx ) - ( e1x * dz ) ), e3z( ( e1x * dy ) - ( e1y * dx ) );
+		Real const len3( std::sqrt( ( e3x * e3x ) + ( e3y * e3y ) + ( e3z * e3z ) ) );
+		Real const inv3( Real( 1 ) / len3 );
+		e3x *= inv3; e3y *= inv3; e3z *= inv3;
+
+		// e2 = e3 x e1
+		Real const e2x( ( e3y * e1z ) - ( e3z * e1y ) ), e2y( ( e3z * e1x ) - ( e3x * e1z ) ), e2z( ( e3x * e1y ) - ( e3y * e1x ) );
+
+		wx[ ii ] = e1x * lx[ ii ] + e2x * ly[ ii ] + e3x * lz[ ii ] + a1x[ ii ];
+		wy[ ii ] = e1y * lx[ ii ] + e2y * ly[ ii ] + e3y * lz[ ii ] + a1y[ ii ];
+		wz[ ii ] = e1z * lx[ ii ] + e2z * ly[ ii ] + e3z * lz[ ii ] + a1z[ ii ];
+		degenerate[ ii ] = ( len1 == Real( 0 ) ) || !( len3 > Real( 0 ) );
+	}
+
+	for ( Size ii = 1; ii <= n; ++ii ) {
+		if ( degenerate_[ ii ] ) {
+			*dest_[ ii ] = builder_[ ii ]->build( *rsd_[ ii ] );
+		} else {
+			dest_[ ii ]->assign( wx_[ ii ], wy_[ ii ], wz_[ ii ] );
+		}
+	}
+
+	dest_.clear(); builder_.clear(); rsd_.clear();
+	a1x_.clear(); a1y_.clear(); a1z_.clear();
+	a2x_.clear(); a2y_.clear(); a2z_.clear();
+	a3x_.clear(); a3y_.clear(); a3z_.clear();
+	lx_.clear(); ly_.clear(); lz_.clear();
+}
+
 
 }
 }
@@ -749,6 +874,7 @@ core::scoring::lkball::LKB_ResidueInfo::save( Archive & arc ) const {
 	arc( CEREAL_NVP( dwater_datom2_ ) );
 	arc( CEREAL_NVP( dwater_datom3_ ) );
 	arc( CEREAL_NVP( has_waters_ ) ); // _Bool
+	// EXEMPT stub_xyz_ derivs_current_
 }
 
 /// @brief Manually generated deserialization method:
@@ -84,6 +84,7 @@ public:
 	Size atom1() const { return atom1_; }
 	Size atom2() const { return atom2_; }
 	Size atom3() const { return atom3_; }
+	Vector const & xyz_local() const { return xyz_local_; }
 
 private:
 	Size atom1_;
@@ -117,12 +118,16 @@ public:
 	WaterBuildersList const & builders() const { return builders_; }
 	utility::vector1< AtomWeights > const & atom_weights() const { return atom_weights_; }
 
+	/// @brief The atoms the waters are built from, in increasing order
+	utility::vector1< Size > const & stub_atoms() const { return stub_atoms_; }
+
 private:
 	Size n_waters_;
 	utility::vector1< Size > n_waters_for_atom_;
 	utility::vector1< Size > water_offset_for_atom_;
 	WaterBuildersList builders_;
 	utility::vector1< AtomWeights > atom_weights_;
+	utility::vector1< Size > stub_atoms_;
 };
 
 typedef utility::pointer::shared_ptr< WaterBuilderForRestype > WaterBuilderForRestypeOP;
@@ -211,9 +216,15 @@ public:
 	basic::datacache::CacheableDataOP
 	clone() const;
 
+	/// @brief Place the waters (and, if compute_derivs, their derivatives with respect to the
+	/// atoms they are built from); does nothing if those atoms have not moved since the last call.
 	void
 	build_waters( conformation::Residue const & rsd, bool compute_derivs = false );
 
+	/// @brief Are the waters placed for the current coordinates of the atoms they are built from?
+	bool
+	waters_current( conformation::Residue const & rsd ) const;
+
 	// fpd const access to the water builders (to identify stub atoms)
 	WaterBuilders const &
 	get_water_builder( conformation::Residue const & rsd , Size heavyatom ) const;
@@ -274,6 +285,13 @@ public:
 	chemical::ResidueType const &
 	residue_type() const;
 
+private:
+	friend class WaterBatchBuilder;
+
+	/// @brief Remember the coordinates of the stub atoms that the waters were built from
+	void
+	record_stub_xyz( conformation::Residue const & rsd );
+
 private:
 	chemical::ResidueTypeCOP rsd_type_;
 	WaterBuilderForRestypeCOP water_builders_;
@@ -284,6 +302,11 @@ private:
 	utility::vector1< WaterDerivMatrix > dwater_datom3_;
 	bool has_waters_ = false;
 
+	// The version stamp of waters_: the coordinates of the stub atoms they were built from
+	utility::vector1< Vector > stub_xyz_;
+	// Were the dwater_datom arrays computed for these same coordinates?
+	bool derivs_current_ = false;
+
 #ifdef    SERIALIZATION
 public:
 	template< class Archive > void save( Archive & arc ) const;
@@ -295,6 +318,40 @@ public:
 typedef utility::pointer::shared_ptr< LKB_ResidueInfo > LKB_ResidueInfoOP;
 typedef utility::pointer::shared_ptr< const LKB_ResidueInfo > LKB_ResidueInfoCOP;
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Places the waters of many residues (e.g. all the rotamers of a RotamerSet) in one pass.
+///
+/// @details add() queues every water of a residue whose waters are not current; build() then
+/// constructs the stub frames and places all queued waters in one loop over flat arrays, which the
+/// compiler can vectorize, and writes them into the LKB_ResidueInfo objects.  The waters are the
+/// same, bit for bit, as those of WaterBuilder::build(), to which the rare degenerate
+/// (zero-length or colinear) stubs fall back.  Residues and infos must outlive the call to build().
+class WaterBatchBuilder {
+public:
+	WaterBatchBuilder();
+
+	void
+	add( LKB_ResidueInfo & info, conformation::Residue const & rsd );
+
+	void
+	build();
+
+	Size
+	n_waters() const { return dest_.size(); }
+
+private:
+	// per queued water
+	utility::vector1< Vector * > dest_;
+	utility::vector1< WaterBuilder const * > builder_;
+	utility::vector1< conformation::Residue const * > rsd_;
+	utility::vector1< Real > a1x_, a1y_, a1z_, a2x_, a2y_, a2z_, a3x_, a3y_, a3z_, lx_, ly_, lz_;
+	utility::vector1< Real > wx_, wy_, wz_;
+	utility::vector1< char > degenerate_;
+};
+
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -20,6 +20,7 @@
 // Project headers
 #include <numeric/fourier/kiss_fft.hh>
 #include <numeric/fourier/FFT.hh>
+#include <numeric/fourier/FFT3DPlan.hh>
 
 
 namespace numeric {
@@ -149,27 +150,16 @@ void ifft2(ObjexxFCL::FArray2D< std::complex<double> > &fX , ObjexxFCL::FArray2D
 //////////////////////////////////////////////////
 
 /// @brief 3D fft c->c double
-void fft3(ObjexxFCL::FArray3D< std::complex<double> > const &X , ObjexxFCL::FArray3D< std::complex<double> > &fX) {
-	kiss_fftnd_state fft_params;
-	std::vector< int > dims(3);
-	dims[0]=X.I3().size(); dims[1]=X.I2().size(); dims[2]=X.I1().size();  /// FArray dimensions in reverse order
-	fft_params.resize( dims, 0 );
+void fft3(ObjexxFCL::FArray3D< std::complex<double> > const &X , ObjexxFCL::FArray3D< std::complex<double> > &fX, FFTJobRunner const & runner) {
 	fX.dimension(X.I1().size(),X.I2().size(),X.I3().size());
-	kiss_fftnd(&fft_params, &X[0], &fX[0] );
+	fft3_plan( X.I1().size(), X.I2().size(), X.I3().size(), false )->transform( &X[0], &fX[0], 1.0, runner );
 }
 
 /// @brief 3D inverse fft c->c double
-void ifft3(ObjexxFCL::FArray3D< std::complex<double> > const &fX , ObjexxFCL::FArray3D< std::complex<double> > &X) {
-	kiss_fftnd_state ifft_params;
-	std::vector< int > dims(3);
-	dims[0]=fX.I3().size(); dims[1]=fX.I2().size(); dims[2]=fX.I1().size();  /// FArray dimensions in reverse order
-	ifft_params.resize( dims, 1 );
+void ifft3(ObjexxFCL::FArray3D< std::complex<double> > const &fX , ObjexxFCL::FArray3D< std::complex<double> > &X, FFTJobRunner const & runner) {
 	X.dimension(fX.I1().size(),fX.I2().size(),fX.I3().size());
-	kiss_fftnd(&ifft_params, &fX[0], &X[0] );
-
-	// rescale
 	int dimsProd = X.I1().size()*X.I2().size()*X.I3().size();
-	for ( int i=0; i<dimsProd; ++i ) X[i] /= (double)dimsProd;
+	fft3_plan( fX.I1().size(), fX.I2().size(), fX.I3().size(), true )->transform( &fX[0], &X[0], 1.0/dimsProd, runner );
 }
 
 /////////////////////////////////////
@@ -201,39 +191,29 @@ void ifft3_dynamic(ObjexxFCL::FArray3D< std::complex<double> > &fX , ObjexxFCL::
 //////////////////////////////////
 
 /// @brief 3D fft r->c double
-void fft3(ObjexxFCL::FArray3D< double > const &X , ObjexxFCL::FArray3D< std::complex<double> > &fX) {
-	ObjexxFCL::FArray3D< std::complex<double> > Xcpx;
-	Xcpx.dimension (X.I1().size(),X.I2().size(),X.I3().size());
-	int dimsProd = X.I1().size()*X.I2().size()*X.I3().size();
-	for ( int i=0; i<dimsProd; ++i ) Xcpx[i] = X[i];
-	fft3(Xcpx,fX);
+void fft3(ObjexxFCL::FArray3D< double > const &X , ObjexxFCL::FArray3D< std::complex<double> > &fX, FFTJobRunner const & runner) {
+	fX.dimension(X.I1().size(),X.I2().size(),X.I3().size());
+	fft3_plan( X.I1().size(), X.I2().size(), X.I3().size(), false )->transform( &X[0], &fX[0], runner );
 }
 
 /// @brief 3D inverse ifft c->r double
-void ifft3(ObjexxFCL::FArray3D< std::complex<double> > const &fX , ObjexxFCL::FArray3D< double > &X) {
-	ObjexxFCL::FArray3D< std::complex<double> > Xcpx;
-	ifft3( fX,Xcpx );
+void ifft3(ObjexxFCL::FArray3D< std::complex<double> > const &fX , ObjexxFCL::FArray3D< double > &X, FFTJobRunner const & runner) {
 	X.dimension(fX.I1().size(),fX.I2().size(),fX.I3().size());
-	int dimsProd = fX.I1().size()*fX.I2().size()*fX.I3().size();
-	for ( int i=0; i<dimsProd; ++i ) X[i] = (double) Xcpx[i].real();
+	int dimsProd = X.I1().size()*X.I2().size()*X.I3().size();
+	fft3_plan( fX.I1().size(), fX.I2().size(), fX.I3().size(), true )->transform( &fX[0], &X[0], 1.0/dimsProd, runner );
 }
 
 /// @brief 3D fft r->c float
-void fft3(ObjexxFCL::FArray3D< float > const &X , ObjexxFCL::FArray3D< std::complex<double> > &fX) {
-	ObjexxFCL::FArray3D< std::complex<double> > Xcpx;
-	Xcpx.dimension (X.I1().size(),X.I2().size(),X.I3().size());
-	int dimsProd = X.I1().size()*X.I2().size()*X.I3().size();
-	for ( int i=0; i<dimsProd; ++i ) Xcpx[i] = X[i];
-	fft3(Xcpx,fX);
+void fft3(ObjexxFCL::FArray3D< float > const &X , ObjexxFCL::FArray3D< std::complex<double> > &fX, FFTJobRunner const & runner) {
+	fX.dimension(X.I1().size(),X.I2().size(),X.I3().size());
+	fft3_plan( X.I1().size(), X.I2().size(), X.I3().size(), false )->transform( &X[0], &fX[0], runner );
 }
 
 /// @brief 3D inverse ifft c->r float
-void ifft3(ObjexxFCL::FArray3D< std::complex<double> > const &fX , ObjexxFCL::FArray3D< float > &X) {
-	ObjexxFCL::FArray3D< std::complex<double> > Xcpx;
-	ifft3( fX,Xcpx );
+void ifft3(ObjexxFCL::FArray3D< std::complex<double> > const &fX , ObjexxFCL::FArray3D< float > &X, FFTJobRunner const & runner) {
 	X.dimension(fX.I1().size(),fX.I2().size(),fX.I3().size());
-	int dimsProd = fX.I1().size()*fX.I2().size()*fX.I3().size();
-	for ( int i=0; i<dimsProd; ++i ) X[i] = (float) Xcpx[i].real();
+	int dimsProd = X.I1().size()*X.I2().size()*X.I3().size();
+	fft3_plan( fX.I1().size(), fX.I2().size(), fX.I3().size(), true )->transform( &fX[0], &X[0], 1.0/dimsProd, runner );
 }
 
 
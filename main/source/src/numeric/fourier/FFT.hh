@@ -15,6 +15,7 @@
 #define INCLUDED_numeric_fourier_FFT_hh
 
 // Package headers
+#include <numeric/fourier/FFT3DPlan.fwd.hh>
 
 // Project headers
 
@@ -68,23 +69,26 @@ void ifft2(ObjexxFCL::FArray2D< std::complex<double> >  &fX , ObjexxFCL::FArray2
 void ifft2(ObjexxFCL::FArray2D< std::complex<double> >  &fX , ObjexxFCL::FArray2D< double > &X);
 
 
+// The 3D transforms reuse cached plans (see FFT3DPlan).  Given an FFTJobRunner, they split their
+// slabs among jobs that the runner may run in parallel; without one, they run in the calling thread.
+
 /// @brief 3D fft c->c double
-void fft3(ObjexxFCL::FArray3D< std::complex<double> > const &X , ObjexxFCL::FArray3D< std::complex<double> > &fX);
+void fft3(ObjexxFCL::FArray3D< std::complex<double> > const &X , ObjexxFCL::FArray3D< std::complex<double> > &fX, FFTJobRunner const & runner = FFTJobRunner());
 
 /// @brief 3D inverse fft c->c double
-void ifft3(ObjexxFCL::FArray3D< std::complex<double> > const &fX , ObjexxFCL::FArray3D< std::complex<double> > &X);
+void ifft3(ObjexxFCL::FArray3D< std::complex<double> > const &fX , ObjexxFCL::FArray3D< std::complex<double> > &X, FFTJobRunner const & runner = FFTJobRunner());
 
 /// @brief 3D fft r->c float
-void fft3(ObjexxFCL::FArray3D< float >  const &X , ObjexxFCL::FArray3D< std::complex<double> > &fX);
+void fft3(ObjexxFCL::FArray3D< float >  const &X , ObjexxFCL::FArray3D< std::complex<double> > &fX, FFTJobRunner const & runner = FFTJobRunner());
 
 /// @brief 3D fft r->c double
-void fft3(ObjexxFCL::FArray3D< double >  const &X , ObjexxFCL::FArray3D< std::complex<double> > &fX);
+void fft3(ObjexxFCL::FArray3D< double >  const &X , ObjexxFCL::FArray3D< std::complex<double> > &fX, FFTJobRunner const & runner = FFTJobRunner());
 
 /// @brief 3D inverse ifft c->r float
-void ifft3(ObjexxFCL::FArray3D< std::complex<double> > const &fX , ObjexxFCL::FArray3D< float > &X);
+void ifft3(ObjexxFCL::FArray3D< std::complex<double> > const &fX , ObjexxFCL::FArray3D< float > &X, FFTJobRunner const & runner = FFTJobRunner());
 
 /// @brief 3D inverse ifft c->r double
-void ifft3(ObjexxFCL::FArray3D< std::complex<double> > const &fX , ObjexxFCL::FArray3D< double > &X);
+void ifft3(ObjexxFCL::FArray3D< std::complex<double> > const &fX , ObjexxFCL::FArray3D< double > &X, FFTJobRunner const & runner = FFTJobRunner());
 
 /// @brief 3D fft c->c double with no static
 void fft3_dynamic(ObjexxFCL::FArray3D< std::complex<double> > &X , ObjexxFCL::FArray3D< std::complex<double> > &fX);
@@ -0,0 +1,215 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   numeric/fourier/FFT3DPlan.cc
+/// @brief  A reusable 3D fft, done as 1D kiss-fft transforms along each axis, slab by slab
+
+// Unit headers
+#include <numeric/fourier/FFT3DPlan.hh>
+
+// Package headers
+#include <numeric/fourier/kiss_fft.hh>
+
+// Utility headers
+#include <utility/thread/backwards_thread_local.hh>
+#include <utility/vector1.hh>
+
+// C++ headers
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+namespace numeric {
+namespace fourier {
+
+namespace {
+
+/// @brief The most jobs a pass over the slabs of a map is split into
+int const MAX_SLAB_JOBS = 64;
+
+/// @brief The most plans kept by fft3_plan() in each thread
+std::size_t const MAX_CACHED_PLANS = 16;
+
+/// @brief Run body over [0,n): in the calling thread without a runner, else split into contiguous ranges
+void
+run_over_slabs( int const n, std::function< void ( int, int ) > const & body, FFTJobRunner const & runner ) {
+	if ( ! runner || n < 2 ) {
+		body( 0, n );
+		return;
+	}
+	int const n_jobs( std::min( n, MAX_SLAB_JOBS ) );
+	utility::vector1< std::function< void () > > jobs;
+	jobs.reserve( n_jobs );
+	for ( int ii = 0; ii < n_jobs; ++ii ) {
+		jobs.push_back( std::bind( body, n * ii / n_jobs, n * ( ii + 1 ) / n_jobs ) );
+	}
+	runner( jobs );
+}
+
+inline void store( std::complex< double > const & value, std::complex< double > & out ) { out = value; }
+inline void store( std::complex< double > const & value, double & out ) { out = value.real(); }
+inline void store( std::complex< double > const & value, float & out ) { out = (float) value.real(); }
+
+}
+
+FFT3DPlan::FFT3DPlan( int const n1, int const n2, int const n3, bool const inverse ) :
+	n1_( n1 ),
+	n2_( n2 ),
+	n3_( n3 ),
+	inverse_( inverse ),
+	row_state_( n1, inverse ),
+	column_state_( n2, inverse ),
+	stack_state_( n3, inverse )
+{}
+
+FFT3DPlan::~FFT3DPlan() = default;
+
+void
+FFT3DPlan::transform( Complex const * in, Complex * out, double const scale, FFTJobRunner const & runner ) const {
+	if ( size() == 0 ) return;
+	run_over_slabs( n3_, [&]( int const begin, int const end ) {
+		transform_xy_slabs( in, out, begin, end );
+	}, runner );
+	transform_stacks( out, out, scale, runner );
+}
+
+void
+FFT3DPlan::transform( double const * in, Complex * out, FFTJobRunner const & runner ) const {
+	if ( size() == 0 ) return;
+	run_over_slabs( n3_, [&]( int const begin, int const end ) {
+		transform_real_xy_slabs( in, out, begin, end );
+	}, runner );
+	transform_stacks( out, out, 1.0, runner );
+}
+
+void
+FFT3DPlan::transform( float const * in, Complex * out, FFTJobRunner const & runner ) const {
+	if ( size() == 0 ) return;
+	run_over_slabs( n3_, [&]( int const begin, int const end ) {
+		transform_real_xy_slabs( in, out, begin, end );
+	}, runner );
+	transform_stacks( out, out, 1.0, runner );
+}
+
+void
+FFT3DPlan::transform( Complex const * in, double * out, double const scale, FFTJobRunner const & runner ) const {
+	if ( size() == 0 ) return;
+	std::vector< Complex > work( size() );
+	run_over_slabs( n3_, [&]( int const begin, int const end ) {
+		transform_xy_slabs( in, &work[ 0 ], begin, end );
+	}, runner );
+	transform_stacks( &work[ 0 ], out, scale, runner );
+}
+
+void
+FFT3DPlan::transform( Complex const * in, float * out, double const scale, FFTJobRunner const & runner ) const {
+	if ( size() == 0 ) return;
+	std::vector< Complex > work( size() );
+	run_over_slabs( n3_, [&]( int const begin, int const end ) {
+		transform_xy_slabs( in, &work[ 0 ], begin, end );
+	}, runner );
+	transform_stacks( &work[ 0 ], out, scale, runner );
+}
+
+void
+FFT3DPlan::transform_xy_slabs( Complex const * in, Complex * out, int const begin, int const end ) const {
+	std::vector< Complex > column( n2_ );
+	for ( int i3 = begin; i3 < end; ++i3 ) {
+		int const slab( i3 * n1_ * n2_ );
+		for ( int i2 = 0; i2 < n2_; ++i2 ) {
+			kiss_fft( &row_state_, in + slab + i2 * n1_, out + slab + i2 * n1_ );
+		}
+		transform_columns( out + slab, column );
+	}
+}
+
+/// @details The rows a and b of a real map are transformed as the one complex row z = a + ib.  The
+/// transforms of real rows are hermitian, A[k] = conj(A[n-k]), so that A and B are recovered from Z as
+/// A[k] = ( Z[k] + conj(Z[n-k]) ) / 2 and B[k] = ( Z[k] - conj(Z[n-k]) ) / 2i; this holds in either
+/// direction.
+template< class T >
+void
+FFT3DPlan::transform_real_xy_slabs( T const * in, Complex * out, int const begin, int const end ) const {
+	std::vector< Complex > packed( n1_ ), packed_transform( n1_ ), column( n2_ );
+	for ( int i3 = begin; i3 < end; ++i3 ) {
+		int const slab( i3 * n1_ * n2_ );
+		for ( int i2 = 0; i2 < n2_; i2 += 2 ) {
+			T const * a( in + slab + i2 * n1_ );
+			Complex * A( out + slab + i2 * n1_ );
+			if ( i2 + 1 == n2_ ) {
+				// an odd row out
+				for ( int k = 0; k < n1_; ++k ) packed[ k ] = Complex( a[ k ], 0.0 );
+				kiss_fft( &row_state_, &packed[ 0 ], A );
+				continue;
+			}
+			T const * b( a + n1_ );
+			Complex * B( A + n1_ );
+			for ( int k = 0; k < n1_; ++k ) packed[ k ] = Complex( a[ k ], b[ k ] );
+			kiss_fft( &row_state_, &packed[ 0 ], &packed_transform[ 0 ] );
+			for ( int k = 0; k < n1_; ++k ) {
+				Complex const z( packed_transform[ k ] );
+				Complex const z_mirror( std::conj( packed_transform[ k == 0 ? 0 : n1_ - k ] ) );
+				A[ k ] = 0.5 * ( z + z_mirror );
+				B[ k ] = Complex( 0.0, -0.5 ) * ( z - z_mirror );
+			}
+		}
+		transform_columns( out + slab, column );
+	}
+}
+
+void
+FFT3DPlan::transform_columns( Complex * slab, std::vector< Complex > & column ) const {
+	for ( int i1 = 0; i1 < n1_; ++i1 ) {
+		kiss_fft_stride( &column_state_, slab + i1, &column[ 0 ], n1_ );
+		for ( int i2 = 0; i2 < n2_; ++i2 ) slab[ i1 + i2 * n1_ ] = column[ i2 ];
+	}
+}
+
+/// @details The n3 rows of an xz-slab are copied into a block, so that the stacks are transformed out of
+/// a small contiguous buffer rather than with a stride of the whole xy-plane.
+template< class T >
+void
+FFT3DPlan::transform_stacks( Complex * data, T * out, double const scale, FFTJobRunner const & runner ) const {
+	int const plane( n1_ * n2_ );
+	run_over_slabs( n2_, [&]( int const begin, int const end ) {
+		std::vector< Complex > block( n1_ * n3_ ), stack( n3_ );
+		for ( int i2 = begin; i2 < end; ++i2 ) {
+			Complex const * first_row( data + i2 * n1_ );
+			for ( int i3 = 0; i3 < n3_; ++i3 ) {
+				std::copy( first_row + i3 * plane, first_row + i3 * plane + n1_, &block[ i3 * n1_ ] );
+			}
+			for ( int i1 = 0; i1 < n1_; ++i1 ) {
+				kiss_fft_stride( &stack_state_, &block[ i1 ], &stack[ 0 ], n1_ );
+				for ( int i3 = 0; i3 < n3_; ++i3 ) block[ i1 + i3 * n1_ ] = scale * stack[ i3 ];
+			}
+			T * out_row( out + i2 * n1_ );
+			for ( int i3 = 0; i3 < n3_; ++i3 ) {
+				for ( int i1 = 0; i1 < n1_; ++i1 ) store( block[ i1 + i3 * n1_ ], out_row[ i1 + i3 * plane ] );
+			}
+		}
+	}, runner );
+}
+
+FFT3DPlanCOP
+fft3_plan( int const n1, int const n2, int const n3, bool const inverse ) {
+	typedef std::tuple< int, int, int, bool > PlanKey;
+	static THREAD_LOCAL std::map< PlanKey, FFT3DPlanCOP > plans;
+
+	PlanKey const key( n1, n2, n3, inverse );
+	auto const iter( plans.find( key ) );
+	if ( iter != plans.end() ) return iter->second;
+
+	if ( plans.size() >= MAX_CACHED_PLANS ) plans.clear();
+	FFT3DPlanCOP plan( utility::pointer::make_shared< FFT3DPlan >( n1, n2, n3, inverse ) );
+	plans[ key ] = plan;
+	return plan;
+}
+
+} // fourier
+} // numeric
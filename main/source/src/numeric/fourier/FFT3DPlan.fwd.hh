@@ -0,0 +1,35 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   numeric/fourier/FFT3DPlan.fwd.hh
+/// @brief  Forward declarations for FFT3DPlan
+
+#ifndef INCLUDED_numeric_fourier_FFT3DPlan_fwd_hh
+#define INCLUDED_numeric_fourier_FFT3DPlan_fwd_hh
+
+#include <utility/pointer/owning_ptr.hh>
+#include <utility/vector1.fwd.hh>
+
+#include <functional>
+
+namespace numeric {
+namespace fourier {
+
+class FFT3DPlan;
+typedef utility::pointer::shared_ptr< FFT3DPlan > FFT3DPlanOP;
+typedef utility::pointer::shared_ptr< FFT3DPlan const > FFT3DPlanCOP;
+
+/// @brief Runs a list of independent jobs, possibly in parallel, and returns once all of them are done.
+/// An empty FFTJobRunner means that the transform runs in the calling thread.
+typedef std::function< void ( utility::vector1< std::function< void () > > const & ) > FFTJobRunner;
+
+} // fourier
+} // numeric
+
+#endif
@@ -0,0 +1,119 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   numeric/fourier/FFT3DPlan.hh
+/// @brief  A reusable 3D fft, done as 1D kiss-fft transforms along each axis, slab by slab
+
+#ifndef INCLUDED_numeric_fourier_FFT3DPlan_hh
+#define INCLUDED_numeric_fourier_FFT3DPlan_hh
+
+// Unit headers
+#include <numeric/fourier/FFT3DPlan.fwd.hh>
+
+// Package headers
+#include <numeric/fourier/kiss_fft_state.hh>
+
+// Utility headers
+#include <utility/pointer/ReferenceCount.hh>
+
+// C++ headers
+#include <complex>
+#include <vector>
+
+namespace numeric {
+namespace fourier {
+
+/// @brief The 1D transforms that make up a 3D fft of a map of n1 x n2 x n3 points, stored with the
+/// first index fastest (as in an FArray3D).
+///
+/// @details The rows (axis 1) and columns (axis 2) of each xy-slab are transformed together, and then
+/// the stacks (axis 3) of each xz-slab, so that each job works on a contiguous slab of the map.  With
+/// an FFTJobRunner, the slabs are split among several jobs, which the runner may run in parallel.
+/// Real maps (double or float) are transformed two rows at a time, as the real and imaginary parts of
+/// one complex row, and are never copied into a complex map.  The inverse of a map that is known to
+/// be real can be written straight into a real map.
+///
+/// A plan holds only the twiddle factors of the three axes and is not changed by a transform, so one
+/// plan may be used by several threads at once.  Use fft3_plan() to reuse the plans of recent sizes.
+class FFT3DPlan : public utility::pointer::ReferenceCount
+{
+public:
+	typedef std::complex< double > Complex;
+
+public:
+	FFT3DPlan( int const n1, int const n2, int const n3, bool const inverse );
+	~FFT3DPlan() override;
+
+	int n1() const { return n1_; }
+	int n2() const { return n2_; }
+	int n3() const { return n3_; }
+	bool inverse() const { return inverse_; }
+
+	/// @brief The number of points of the map
+	int size() const { return n1_ * n2_ * n3_; }
+
+	/// @brief Transform a complex map into out, multiplying the result by scale; in may be out
+	void
+	transform( Complex const * in, Complex * out, double const scale, FFTJobRunner const & runner ) const;
+
+	/// @brief Transform a real map into its full (hermitian) complex spectrum
+	void
+	transform( double const * in, Complex * out, FFTJobRunner const & runner ) const;
+
+	/// @brief Transform a real map into its full (hermitian) complex spectrum
+	void
+	transform( float const * in, Complex * out, FFTJobRunner const & runner ) const;
+
+	/// @brief Transform a complex map and keep the real part of the result, multiplied by scale
+	void
+	transform( Complex const * in, double * out, double const scale, FFTJobRunner const & runner ) const;
+
+	/// @brief Transform a complex map and keep the real part of the result, multiplied by scale
+	void
+	transform( Complex const * in, float * out, double const scale, FFTJobRunner const & runner ) const;
+
+private:
+	/// @brief Transform the rows and then the columns of the xy-slabs [begin,end) of in into out
+	void
+	transform_xy_slabs( Complex const * in, Complex * out, int const begin, int const end ) const;
+
+	/// @brief Same for a real map, two rows at a time
+	template< class T >
+	void
+	transform_real_xy_slabs( T const * in, Complex * out, int const begin, int const end ) const;
+
+	/// @brief Transform the columns of an xy-slab in place
+	void
+	transform_columns( Complex * slab, std::vector< Complex > & column ) const;
+
+	/// @brief Transform the stacks of all xz-slabs of data, writing (the real part of) the result into out
+	template< class T >
+	void
+	transform_stacks( Complex * data, T * out, double const scale, FFTJobRunner const & runner ) const;
+
+private:
+	int n1_;
+	int n2_;
+	int n3_;
+	bool inverse_;
+
+	// kiss_fft() takes non-const states, but only reads them
+	mutable kiss_fft_state row_state_;
+	mutable kiss_fft_state column_state_;
+	mutable kiss_fft_state stack_state_;
+};
+
+/// @brief The plan of a 3D fft of an n1 x n2 x n3 map, from a cache (per thread) of recently used plans
+FFT3DPlanCOP
+fft3_plan( int const n1, int const n2, int const n3, bool const inverse );
+
+} // fourier
+} // numeric
+
+#endif
@@ -16,6 +16,7 @@
 //     for licensing info see external/kiss_fft_v1_2_8/COPYING
 
 #include <numeric/fourier/kiss_fft.hh>
+#include <utility/thread/backwards_thread_local.hh>
 #include <cstdlib> //g++ 4.3.2 requires for exit()
 //#include <string.h> //g++ 4.3.2 requires for memcpy()
 // tracer
@@ -30,9 +31,10 @@ namespace fourier {
 
 
 // replace the global variables with classes that protect access to buffer data
+// the buffers are per thread, so that several threads may transform at once
 kiss_fft_cpx* get_scratch_buff( size_t nbuf ) {
-	static kiss_fft_cpx *scratchbuf=nullptr;
-	static size_t nscratchbuf=0;
+	static THREAD_LOCAL kiss_fft_cpx *scratchbuf=nullptr;
+	static THREAD_LOCAL size_t nscratchbuf=0;
 	if ( nscratchbuf < nbuf ) {
 		delete [] scratchbuf;
 		scratchbuf = new kiss_fft_cpx[ nbuf ];
@@ -48,8 +50,8 @@ kiss_fft_cpx* get_scratch_buff( size_t nbuf ) {
 	return (scratchbuf);
 }
 kiss_fft_cpx* get_tmp_buff( size_t nbuf ) {
-	static kiss_fft_cpx *tmpbuf=nullptr;
-	static size_t ntmpbuf=0;
+	static THREAD_LOCAL kiss_fft_cpx *tmpbuf=nullptr;
+	static THREAD_LOCAL size_t ntmpbuf=0;
 	if ( ntmpbuf < nbuf ) {
 		delete [] tmpbuf;
 		tmpbuf = new kiss_fft_cpx[ nbuf ];
@@ -0,0 +1,204 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   protocols/cluster/CoordinateDistanceMatrix.cc
+/// @brief  All-vs-all superimposed RMSD over one contiguous coordinate array, computed in
+/// parallel tiles and stored as a single-precision upper triangle
+
+// Unit headers
+#include <protocols/cluster/CoordinateDistanceMatrix.hh>
+
+// Core headers
+#include <core/conformation/Residue.hh>
+#include <core/pose/Pose.hh>
+
+// Basic headers
+#include <basic/Tracer.hh>
+#include <basic/options/option.hh>
+#include <basic/options/keys/multithreading.OptionKeys.gen.hh>
+
+// Numeric headers
+#include <numeric/alignment/rmsd_calc.hh>
+#include <numeric/xyzVector.hh>
+
+// Utility headers
+#include <utility/exit.hh>
+#include <utility/file/file_sys_util.hh>
+
+#ifdef MULTI_THREADED
+#include <basic/thread_manager/RosettaThreadManager.hh>
+#include <utility/pointer/memory.hh>
+#include <functional>
+#endif
+
+// C++ headers
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace protocols {
+namespace cluster {
+
+static basic::Tracer TR( "protocols.cluster.CoordinateDistanceMatrix" );
+
+CoordinateDistanceMatrix::CoordinateDistanceMatrix() :
+	n_structures_( 0 ),
+	n_atoms_( 0 ),
+	block_size_( 64 ),
+	nthreads_( 0 ),
+	memory_limit_( platform::Size( 4096 ) * 1024 * 1024 ),
+	values_( nullptr )
+{}
+
+CoordinateDistanceMatrix::~CoordinateDistanceMatrix()
+{
+	release();
+}
+
+void
+CoordinateDistanceMatrix::set_coordinates(
+	std::vector< core::pose::Pose > const & poses,
+	utility::vector1< core::id::AtomID > const & atoms
+)
+{
+	release();
+	n_structures_ = poses.size();
+	n_atoms_ = atoms.size();
+	coordinates_ = ndarray::Array< float, 3, 3 >( n_structures_, n_atoms_, 3 );
+	for ( core::Size ii = 0; ii < n_structures_; ++ii ) {
+		for ( core::Size jj = 1; jj <= n_atoms_; ++jj ) {
+			numeric::xyzVector< core::Real > const & xyz( poses[ ii ].xyz( atoms[ jj ] ) );
+			coordinates_( ii, jj - 1, 0 ) = xyz.x();
+			coordinates_( ii, jj - 1, 1 ) = xyz.y();
+			coordinates_( ii, jj - 1, 2 ) = xyz.z();
+		}
+	}
+}
+
+/// @details Rows of blocks are handed out to threads in batches that fit in memory_limit():
+/// a single batch written straight into the in-memory triangle when the whole matrix fits,
+/// otherwise as many batches as needed, each appended to the scratch file before the next
+/// is computed.
+void
+CoordinateDistanceMatrix::compute()
+{
+	release();
+	if ( n_structures_ < 2 ) return;
+	if ( n_atoms_ == 0 ) utility_exit_with_message( "CoordinateDistanceMatrix: no atoms to compute the RMSD over" );
+	if ( block_size_ == 0 ) block_size_ = 1;
+
+	core::Size const n_blocks = ( n_structures_ + block_size_ - 1 ) / block_size_;
+	platform::Size const bytes = n_entries() * sizeof( float );
+
+	if ( bytes <= memory_limit_ ) {
+		TR << "Computing the " << n_structures_ << "x" << n_structures_ << " RMSD matrix over "
+			<< n_atoms_ << " atoms in memory (" << bytes / ( 1024 * 1024 ) << " MB)" << std::endl;
+		in_memory_values_.resize( n_entries() );
+		compute_row_blocks( 0, n_blocks, in_memory_values_.data() );
+		values_ = in_memory_values_.data();
+		return;
+	}
+
+	// Without a name from the caller, pick one no concurrent run in this directory can share.
+	scratch_path_ = scratch_file_.empty() ? utility::file::create_temp_filename( ".", "rms_matrix" ) : scratch_file_;
+	TR << "Computing the " << n_structures_ << "x" << n_structures_ << " RMSD matrix over "
+		<< n_atoms_ << " atoms into " << scratch_path_ << " (" << bytes / ( 1024 * 1024 ) << " MB)" << std::endl;
+	std::ofstream out( scratch_path_.c_str(), std::ios::binary | std::ios::trunc );
+	if ( ! out ) utility_exit_with_message( "CoordinateDistanceMatrix: unable to open scratch file " + scratch_path_ );
+
+	std::vector< float > buffer;
+	core::Size first = 0;
+	while ( first < n_blocks ) {
+		// Take at least one row of blocks, and more while they fit
+		platform::Size const batch_begin = row_offset( first * block_size_ );
+		core::Size last = first + 1;
+		while ( last < n_blocks && ( row_offset( std::min( ( last + 1 ) * block_size_, n_structures_ ) ) - batch_begin ) * sizeof( float ) <= memory_limit_ ) {
+			++last;
+		}
+		platform::Size const batch_end = last < n_blocks ? row_offset( last * block_size_ ) : n_entries();
+		buffer.resize( batch_end - batch_begin );
+		compute_row_blocks( first, last, buffer.data() );
+		out.write( reinterpret_cast< char const * >( buffer.data() ), buffer.size() * sizeof( float ) );
+		if ( ! out ) utility_exit_with_message( "CoordinateDistanceMatrix: error writing scratch file " + scratch_path_ );
+		TR.Debug << "Wrote rows " << first * block_size_ + 1 << " to " << std::min( last * block_size_, n_structures_ ) << std::endl;
+		first = last;
+	}
+	out.close();
+	std::vector< float >().swap( buffer );
+
+	if ( ! mapped_file_.open( scratch_path_ ) || mapped_file_.size() != bytes ) {
+		utility_exit_with_message( "CoordinateDistanceMatrix: unable to read back scratch file " + scratch_path_ );
+	}
+	if ( ! mapped_file_.is_mapped() ) {
+		TR.Warning << "Unable to memory-map " << scratch_path_ << "; the RMSD matrix was read into memory instead" << std::endl;
+	}
+	values_ = reinterpret_cast< float const * >( mapped_file_.data() );
+}
+
+void
+CoordinateDistanceMatrix::compute_row_blocks( core::Size first, core::Size last, float * rows ) const
+{
+	platform::Size const batch_begin = row_offset( first * block_size_ );
+
+#ifdef MULTI_THREADED
+	core::Size const nthreads( nthreads_ == 0 ? core::Size( basic::options::option[ basic::options::OptionKeys::multithreading::total_threads ]() ) : nthreads_ );
+	utility::vector1< basic::thread_manager::RosettaThreadFunctionOP > work_vector;
+	work_vector.reserve( last - first );
+	for ( core::Size block = first; block < last; ++block ) {
+		work_vector.push_back( utility::pointer::make_shared< basic::thread_manager::RosettaThreadFunction >(
+			std::bind( &CoordinateDistanceMatrix::compute_row_block, this, block, rows + ( row_offset( block * block_size_ ) - batch_begin ) ) ) );
+	}
+	basic::thread_manager::RosettaThreadManager::get_instance()->do_work_vector_in_threads( work_vector, nthreads );
+#else
+	for ( core::Size block = first; block < last; ++block ) {
+		compute_row_block( block, rows + ( row_offset( block * block_size_ ) - batch_begin ) );
+	}
+#endif
+}
+
+/// @details Each tile (block, later block) is one call to the broadcast kernel; the tile on
+/// the diagonal is computed in full and only its upper triangle kept.
+void
+CoordinateDistanceMatrix::compute_row_block( core::Size block, float * rows ) const
+{
+	core::Size const i_begin = block * block_size_;
+	core::Size const i_end = std::min( i_begin + block_size_, n_structures_ );
+	platform::Size const block_begin = row_offset( i_begin );
+
+	ndarray::Array< float, 3, 1 > const first_coordinates( coordinates_[ ndarray::view( i_begin, i_end ) ] );
+	ndarray::Array< float, 2, 2 > tile( i_end - i_begin, block_size_ );
+
+	for ( core::Size j_begin = i_begin; j_begin < n_structures_; j_begin += block_size_ ) {
+		core::Size const j_end = std::min( j_begin + block_size_, n_structures_ );
+		ndarray::Array< float, 3, 1 > const second_coordinates( coordinates_[ ndarray::view( j_begin, j_end ) ] );
+		ndarray::Array< float, 2 > tile_out( tile[ ndarray::view()( 0, j_end - j_begin ) ] );
+		numeric::alignment::coordinate_array_broadcast_rmsd( first_coordinates, second_coordinates, tile_out );
+
+		for ( core::Size ii = i_begin; ii < i_end; ++ii ) {
+			float * row = rows + ( row_offset( ii ) - block_begin );
+			for ( core::Size jj = std::max( j_begin, ii + 1 ); jj < j_end; ++jj ) {
+				row[ jj - ii - 1 ] = tile_out( ii - i_begin, jj - j_begin );
+			}
+		}
+	}
+}
+
+void
+CoordinateDistanceMatrix::release()
+{
+	values_ = nullptr;
+	std::vector< float >().swap( in_memory_values_ );
+	if ( mapped_file_.is_open() ) {
+		mapped_file_.close();
+		std::remove( scratch_path_.c_str() );
+	}
+}
+
+} // namespace cluster
+} // namespace protocols
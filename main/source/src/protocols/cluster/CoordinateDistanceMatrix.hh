@@ -0,0 +1,145 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   protocols/cluster/CoordinateDistanceMatrix.hh
+/// @brief  All-vs-all superimposed RMSD over one contiguous coordinate array, computed in
+/// parallel tiles and stored as a single-precision upper triangle
+
+#ifndef INCLUDED_protocols_cluster_CoordinateDistanceMatrix_hh
+#define INCLUDED_protocols_cluster_CoordinateDistanceMatrix_hh
+
+// Unit headers
+#include <protocols/cluster/CoordinateDistanceMatrix.fwd.hh>
+
+// Core headers
+#include <core/id/AtomID.hh>
+#include <core/pose/Pose.fwd.hh>
+#include <core/types.hh>
+
+// Utility headers
+#include <utility/io/MappedFile.hh>
+#include <utility/pointer/ReferenceCount.hh>
+#include <utility/vector1.hh>
+
+// External headers
+#include <ndarray.h>
+
+// C++ headers
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace protocols {
+namespace cluster {
+
+/// @brief The RMSD after optimal superposition between every pair of N structures.
+///
+/// @details The coordinates of the chosen atoms of every structure are copied into one
+/// [N, atoms, 3] float array, and the matrix is computed block by block with the batched
+/// QCP kernel, numeric::alignment::coordinate_array_broadcast_rmsd: the structures are
+/// split into blocks of block_size(), and the tiles of one row of blocks are the work of
+/// one thread.  Only the N(N-1)/2 entries above the diagonal are kept, as floats, row after
+/// row.  A matrix larger than memory_limit() bytes is computed a few rows of blocks at a
+/// time, appended to scratch_file(), and then memory-mapped, so that the operating system
+/// pages in only the rows being read.
+class CoordinateDistanceMatrix : public utility::pointer::ReferenceCount
+{
+public:
+	CoordinateDistanceMatrix();
+	~CoordinateDistanceMatrix() override;
+
+	/// @brief Copy the coordinates of the given atoms of every pose; the atoms must exist in
+	/// every pose.  Discards any computed matrix.
+	void set_coordinates( std::vector< core::pose::Pose > const & poses, utility::vector1< core::id::AtomID > const & atoms );
+
+	/// @brief The number of structures
+	core::Size size() const { return n_structures_; }
+
+	/// @brief The number of atoms per structure
+	core::Size natoms() const { return n_atoms_; }
+
+	void block_size( core::Size setting ) { block_size_ = setting; }
+	core::Size block_size() const { return block_size_; }
+
+	/// @brief The number of threads to compute with; 0 (the default) uses
+	/// -multithreading:total_threads.  Ignored in builds without threads.
+	void nthreads( core::Size setting ) { nthreads_ = setting; }
+	core::Size nthreads() const { return nthreads_; }
+
+	/// @brief The largest matrix, in bytes, to hold in memory
+	void memory_limit( platform::Size setting ) { memory_limit_ = setting; }
+	platform::Size memory_limit() const { return memory_limit_; }
+
+	/// @brief Where to write a matrix too large for memory; by default (empty), a uniquely
+	/// named file in the current directory, so that concurrent runs do not collide.  The
+	/// file is deleted when the matrix is discarded.
+	void scratch_file( std::string const & setting ) { scratch_file_ = setting; }
+	std::string const & scratch_file() const { return scratch_file_; }
+
+	/// @brief Compute every pairwise RMSD
+	void compute();
+
+	/// @brief Is the computed matrix in the scratch file (rather than in memory)?
+	bool on_disk() const { return mapped_file_.is_open(); }
+
+	/// @brief The scratch file holding the matrix, if on_disk()
+	std::string const & scratch_path() const { return scratch_path_; }
+
+	/// @brief The RMSD between structures i and j, 1-based; symmetric, and zero on the diagonal
+	inline
+	float
+	operator () ( core::Size i, core::Size j ) const
+	{
+		if ( i == j ) return 0.0f;
+		if ( i > j ) std::swap( i, j );
+		return values_[ row_offset( i - 1 ) + ( j - i - 1 ) ];
+	}
+
+	/// @brief The number of entries stored, N(N-1)/2
+	platform::Size n_entries() const { return platform::Size( n_structures_ ) * ( n_structures_ - 1 ) / 2; }
+
+private:
+	/// @brief Index of the first stored entry of 0-based row i: the entries (i, i+1 ... N-1)
+	inline
+	platform::Size
+	row_offset( core::Size i ) const
+	{
+		return platform::Size( i ) * ( 2 * n_structures_ - i - 1 ) / 2;
+	}
+
+	/// @brief Compute the entries of the rows of one block, writing them from rows, which
+	/// points at the block's first stored entry
+	void compute_row_block( core::Size block, float * rows ) const;
+
+	/// @brief Compute blocks [first, last) in threads into one contiguous buffer
+	void compute_row_blocks( core::Size first, core::Size last, float * rows ) const;
+
+	void release();
+
+private:
+	core::Size n_structures_;
+	core::Size n_atoms_;
+	ndarray::Array< float, 3, 3 > coordinates_;
+
+	core::Size block_size_;
+	core::Size nthreads_;
+	platform::Size memory_limit_;
+	std::string scratch_file_;
+	/// @brief The scratch file actually in use
+	std::string scratch_path_;
+
+	std::vector< float > in_memory_values_;
+	utility::io::MappedFile mapped_file_;
+	float const * values_;
+};
+
+} // namespace cluster
+} // namespace protocols
+
+#endif
@@ -0,0 +1,173 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   protocols/cluster/StreamingLeaderCluster.cc
+/// @brief  Leader clustering of a stream of structures by superimposed RMSD, with a metric
+/// index over the leaders so that most structure-leader distances are never computed
+
+// Unit headers
+#include <protocols/cluster/StreamingLeaderCluster.hh>
+
+// Core headers
+#include <core/pose/Pose.hh>
+
+// Basic headers
+#include <basic/Tracer.hh>
+
+// Numeric headers
+#include <numeric/alignment/QCPKernel.hh>
+#include <numeric/xyzVector.hh>
+
+// Utility headers
+#include <utility/exit.hh>
+
+// C++ headers
+#include <algorithm>
+#include <cmath>
+
+namespace protocols {
+namespace cluster {
+
+static basic::Tracer TR( "protocols.cluster.StreamingLeaderCluster" );
+
+/// @brief Leaders are discarded by a lower bound only if it exceeds the radius by this much,
+/// in Angstroms, so that rounding in the bounds can never discard a leader QCP would place
+/// within the radius.
+static float const bound_slack( 1e-3f );
+
+StreamingLeaderCluster::StreamingLeaderCluster( core::Real radius, core::Size n_atoms ) :
+	radius_( radius ),
+	n_atoms_( n_atoms ),
+	n_pivots_( 16 ),
+	use_index_( true ),
+	n_structures_( 0 ),
+	n_rmsd_evaluations_( 0 )
+{
+	if ( n_atoms_ == 0 ) utility_exit_with_message( "StreamingLeaderCluster: no atoms to compute the RMSD over" );
+}
+
+StreamingLeaderCluster::~StreamingLeaderCluster() = default;
+
+void
+StreamingLeaderCluster::n_pivots( core::Size setting )
+{
+	if ( n_leaders() != 0 ) utility_exit_with_message( "StreamingLeaderCluster: the number of pivots must be set before adding structures" );
+	if ( setting == 0 ) TR.Warning << "At least one pivot is needed; using 1 instead of 0" << std::endl;
+	n_pivots_ = std::max( setting, core::Size( 1 ) );
+}
+
+StreamingLeaderCluster::Assignment
+StreamingLeaderCluster::add( core::pose::Pose const & pose, utility::vector1< core::id::AtomID > const & atoms )
+{
+	debug_assert( atoms.size() == n_atoms_ );
+	std::vector< float > xyz( 3 * n_atoms_ );
+	for ( core::Size ii = 1; ii <= n_atoms_; ++ii ) {
+		numeric::xyzVector< core::Real > const & atom_xyz( pose.xyz( atoms[ ii ] ) );
+		xyz[ 3 * ( ii - 1 ) ] = atom_xyz.x();
+		xyz[ 3 * ( ii - 1 ) + 1 ] = atom_xyz.y();
+		xyz[ 3 * ( ii - 1 ) + 2 ] = atom_xyz.z();
+	}
+	return add( xyz.data() );
+}
+
+StreamingLeaderCluster::Assignment
+StreamingLeaderCluster::add( float const * xyz )
+{
+	++n_structures_;
+
+	// Center the structure, and take its radius of gyration
+	std::vector< float > centered( xyz, xyz + 3 * n_atoms_ );
+	double center[ 3 ] = { 0.0, 0.0, 0.0 };
+	for ( core::Size ii = 0; ii < n_atoms_; ++ii ) {
+		for ( core::Size kk = 0; kk < 3; ++kk ) center[ kk ] += centered[ 3 * ii + kk ];
+	}
+	double sum_sq( 0.0 );
+	for ( core::Size ii = 0; ii < n_atoms_; ++ii ) {
+		for ( core::Size kk = 0; kk < 3; ++kk ) {
+			centered[ 3 * ii + kk ] -= center[ kk ] / n_atoms_;
+			sum_sq += centered[ 3 * ii + kk ] * centered[ 3 * ii + kk ];
+		}
+	}
+	float const rg = std::sqrt( sum_sq / n_atoms_ );
+
+	core::Size best( 0 );
+	float best_distance( 0.0f );
+	auto consider = [&]( core::Size leader, float distance ) {
+		if ( distance < radius_ && ( best == 0 || distance < best_distance || ( distance == best_distance && leader < best ) ) ) {
+			best = leader;
+			best_distance = distance;
+		}
+	};
+
+	// The distances to the pivots are needed either way, to index a new leader
+	std::vector< float > to_pivots( n_pivots_, 0.0f );
+	core::Size const n_existing_pivots = std::min( n_pivots_, n_leaders() );
+	for ( core::Size pp = 1; pp <= n_existing_pivots; ++pp ) {
+		to_pivots[ pp - 1 ] = rmsd( centered.data(), leader_coordinates( pp ) );
+		consider( pp, to_pivots[ pp - 1 ] );
+	}
+
+	if ( ! use_index_ ) {
+		for ( core::Size ll = n_existing_pivots + 1; ll <= n_leaders(); ++ll ) {
+			consider( ll, rmsd( centered.data(), leader_coordinates( ll ) ) );
+		}
+	} else if ( n_leaders() > n_existing_pivots ) {
+		float const cutoff = radius_ + bound_slack;
+		auto const end = by_first_pivot_distance_.upper_bound( to_pivots[ 0 ] + cutoff );
+		for ( auto iter = by_first_pivot_distance_.lower_bound( to_pivots[ 0 ] - cutoff ); iter != end; ++iter ) {
+			core::Size const ll = iter->second;
+			if ( ll <= n_existing_pivots ) continue; // compared above
+			if ( std::abs( rg - rg_[ ll - 1 ] ) > cutoff ) continue;
+			bool bounded_out( false );
+			for ( core::Size pp = 2; pp <= n_existing_pivots && ! bounded_out; ++pp ) {
+				bounded_out = std::abs( to_pivots[ pp - 1 ] - pivot_distance( ll, pp ) ) > cutoff;
+			}
+			if ( bounded_out ) continue;
+			consider( ll, rmsd( centered.data(), leader_coordinates( ll ) ) );
+		}
+	}
+
+	if ( best != 0 ) {
+		++cluster_sizes_[ best ];
+		return Assignment{ best, best_distance, false };
+	}
+	return add_leader( centered, rg, to_pivots );
+}
+
+/// @details A leader among the first n_pivots() becomes a pivot itself; every earlier leader
+/// is then also a pivot, so its distances to them are already in to_pivots.
+StreamingLeaderCluster::Assignment
+StreamingLeaderCluster::add_leader( std::vector< float > const & centered, float rg, std::vector< float > const & to_pivots )
+{
+	core::Size const leader = n_leaders() + 1;
+	leader_coordinates_.insert( leader_coordinates_.end(), centered.begin(), centered.end() );
+	rg_.push_back( rg );
+	pivot_distances_.insert( pivot_distances_.end(), to_pivots.begin(), to_pivots.end() );
+	if ( leader <= n_pivots_ ) {
+		for ( core::Size ll = 1; ll < leader; ++ll ) {
+			pivot_distances_[ ( ll - 1 ) * n_pivots_ + leader - 1 ] = to_pivots[ ll - 1 ];
+		}
+	}
+	by_first_pivot_distance_.insert( std::make_pair( leader == 1 ? 0.0f : to_pivots[ 0 ], leader ) );
+	cluster_sizes_.push_back( 1 );
+	return Assignment{ leader, 0.0f, true };
+}
+
+float
+StreamingLeaderCluster::rmsd( float const * centered1, float const * centered2 )
+{
+	typedef Eigen::Map< Eigen::Matrix< float, 3, Eigen::Dynamic > const > CoordinateMap;
+	++n_rmsd_evaluations_;
+	Eigen::Matrix< float, 3, 1 > const origin( Eigen::Matrix< float, 3, 1 >::Zero() );
+	return numeric::alignment::QCPKernel< float >::calc_coordinate_rmsd(
+		CoordinateMap( centered1, 3, n_atoms_ ), origin, CoordinateMap( centered2, 3, n_atoms_ ), origin );
+}
+
+} // namespace cluster
+} // namespace protocols
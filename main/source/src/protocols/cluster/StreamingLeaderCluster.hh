@@ -0,0 +1,122 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   protocols/cluster/StreamingLeaderCluster.hh
+/// @brief  Leader clustering of a stream of structures by superimposed RMSD, with a metric
+/// index over the leaders so that most structure-leader distances are never computed
+
+#ifndef INCLUDED_protocols_cluster_StreamingLeaderCluster_hh
+#define INCLUDED_protocols_cluster_StreamingLeaderCluster_hh
+
+// Unit headers
+#include <protocols/cluster/StreamingLeaderCluster.fwd.hh>
+
+// Core headers
+#include <core/id/AtomID.hh>
+#include <core/pose/Pose.fwd.hh>
+#include <core/types.hh>
+
+// Utility headers
+#include <utility/pointer/ReferenceCount.hh>
+#include <utility/vector1.hh>
+
+// C++ headers
+#include <map>
+#include <vector>
+
+namespace protocols {
+namespace cluster {
+
+/// @brief Leader clustering at a fixed radius: each structure, in the order given, joins
+/// the cluster of the nearest existing leader closer than the radius (the earliest leader,
+/// on a tie), or else becomes the leader of a new cluster.
+///
+/// @details Only the leaders' coordinates are kept, so a stream of millions of structures
+/// is clustered in memory proportional to the number of clusters, and no distance matrix is
+/// formed.  Distances are RMSDs after optimal superposition (QCP) over a fixed set of atoms.
+/// To avoid comparing each structure with every leader, the first n_pivots() leaders serve
+/// as pivots: since the superimposed RMSD is a metric, |d(s,p) - d(l,p)| bounds d(s,l) from
+/// below for each pivot p, as does the difference in radii of gyration |Rg(s) - Rg(l)|.
+/// The leaders are kept sorted by distance to the first pivot, and only those within the
+/// radius by every bound are compared with QCP.  The bounds only discard leaders that
+/// cannot be within the radius, so the clustering is exactly that of comparing every
+/// structure with every leader (use_index( false )).
+class StreamingLeaderCluster : public utility::pointer::ReferenceCount
+{
+public:
+	/// @brief Where one structure went
+	struct Assignment {
+		core::Size leader; ///< 1-based index of the leader, i.e. of the cluster
+		float distance;    ///< RMSD to the leader; zero for a new leader
+		bool new_leader;
+	};
+
+public:
+	StreamingLeaderCluster( core::Real radius, core::Size n_atoms );
+	~StreamingLeaderCluster() override;
+
+	core::Real radius() const { return radius_; }
+	core::Size n_atoms() const { return n_atoms_; }
+
+	/// @brief The number of leaders used as pivots of the index; set before adding structures
+	void n_pivots( core::Size setting );
+	core::Size n_pivots() const { return n_pivots_; }
+
+	/// @brief Compare with every leader instead of consulting the index.  For reference.
+	void use_index( bool setting ) { use_index_ = setting; }
+	bool use_index() const { return use_index_; }
+
+	/// @brief Cluster one structure given as n_atoms() consecutive x,y,z triples
+	Assignment add( float const * xyz );
+
+	/// @brief Cluster the given atoms of a pose
+	Assignment add( core::pose::Pose const & pose, utility::vector1< core::id::AtomID > const & atoms );
+
+	/// @brief The number of leaders, i.e. of clusters
+	core::Size n_leaders() const { return rg_.size(); }
+
+	/// @brief The number of structures added
+	core::Size n_structures() const { return n_structures_; }
+
+	/// @brief The number of RMSDs computed with QCP, including those to the pivots
+	core::Size n_rmsd_evaluations() const { return n_rmsd_evaluations_; }
+
+	/// @brief The number of structures that joined each cluster, the leader included
+	core::Size cluster_size( core::Size leader ) const { return cluster_sizes_[ leader ]; }
+
+private:
+	/// @brief Superimposed RMSD between two centered coordinate sets
+	float rmsd( float const * centered1, float const * centered2 );
+
+	float const * leader_coordinates( core::Size leader ) const { return &leader_coordinates_[ ( leader - 1 ) * 3 * n_atoms_ ]; }
+
+	float pivot_distance( core::Size leader, core::Size pivot ) const { return pivot_distances_[ ( leader - 1 ) * n_pivots_ + pivot - 1 ]; }
+
+	Assignment add_leader( std::vector< float > const & centered, float rg, std::vector< float > const & to_pivots );
+
+private:
+	core::Real radius_;
+	core::Size n_atoms_;
+	core::Size n_pivots_;
+	bool use_index_;
+
+	std::vector< float > leader_coordinates_; ///< centered, leader after leader
+	std::vector< float > rg_;
+	std::vector< float > pivot_distances_;    ///< n_pivots() per leader; zero past the existing pivots
+	std::multimap< float, core::Size > by_first_pivot_distance_;
+	utility::vector1< core::Size > cluster_sizes_;
+
+	core::Size n_structures_;
+	core::Size n_rmsd_evaluations_;
+};
+
+} // namespace cluster
+} // namespace protocols
+
+#endif
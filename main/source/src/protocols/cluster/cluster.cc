@@ -25,6 +25,7 @@
 #include <core/scoring/rms_util.tmpl.hh>
 #include <core/scoring/ScoreFunction.hh>
 #include <protocols/cluster/cluster.hh>
+#include <protocols/cluster/CoordinateDistanceMatrix.hh>
 #include <protocols/idealize/IdealizeMover.hh>
 #include <protocols/jobdist/standard_mains.hh>
 #include <protocols/moves/Mover.hh>
@@ -48,6 +49,7 @@
 
 #include <basic/options/option.hh>
 #include <basic/options/keys/cluster.OptionKeys.gen.hh>
+#include <basic/options/keys/evaluation.OptionKeys.gen.hh>
 #include <basic/options/keys/out.OptionKeys.gen.hh>
 #include <basic/options/keys/symmetry.OptionKeys.gen.hh>
 
@@ -222,6 +224,50 @@ GatherPosesMover::get_distance_measure(
 
 } // native_CA_rmsd
 
+/// @details Mirrors get_distance_measure(): only the plain CA RMSD (optionally over the residues
+/// not in -cluster:exclude_res) and the protein-backbone RMSD, both after superposition, are
+/// computed over a fixed atom set; every other measure returns false.
+bool
+GatherPosesMover::coordinate_rmsd_atoms(
+	Pose const & pose,
+	utility::vector1< id::AtomID > & atoms
+) const {
+	using namespace basic::options;
+	using namespace basic::options::OptionKeys;
+
+	atoms.clear();
+	if ( option[ OptionKeys::cluster::hotspot_hash ]() || option[ OptionKeys::cluster::gdtmm ]() ) return false;
+	if ( option[ OptionKeys::cluster::skip_align ]() ) return false;
+	if ( option[ OptionKeys::symmetry::symmetric_rmsd ]() && core::pose::symmetry::is_symmetric( pose ) ) return false;
+	if ( pose.size() == 0 || pose.residue( 1 ).is_RNA() ) return false;
+	if ( option[ OptionKeys::evaluation::rms_type ]() == "RNP" ) return false;
+
+	if ( option[ OptionKeys::cluster::exclude_res ].user() ) {
+		core::scoring::ResidueSelection residues;
+		core::scoring::invert_exclude_residues( pose.size(), option[ OptionKeys::cluster::exclude_res ](), residues );
+		for ( Size const ii : residues ) {
+			if ( ii <= pose.size() && pose.residue( ii ).is_protein() && pose.residue( ii ).has( "CA" ) ) {
+				atoms.push_back( id::AtomID( pose.residue( ii ).atom_index( "CA" ), ii ) );
+			}
+		}
+		return ! atoms.empty();
+	}
+
+	if ( cluster_by_all_atom_ ) return false;
+	for ( Size ii = 1; ii <= pose.size(); ++ii ) {
+		conformation::Residue const & rsd( pose.residue( ii ) );
+		if ( cluster_by_protein_backbone_ ) {
+			// as scoring::is_protein_backbone
+			if ( rsd.has( "N" ) ) atoms.push_back( id::AtomID( rsd.atom_index( "N" ), ii ) );
+			if ( rsd.is_protein() && rsd.has( "CA" ) ) atoms.push_back( id::AtomID( rsd.atom_index( "CA" ), ii ) );
+			if ( rsd.has( "C" ) ) atoms.push_back( id::AtomID( rsd.atom_index( "C" ), ii ) );
+		} else if ( rsd.is_protein() && rsd.has( "CA" ) ) {
+			atoms.push_back( id::AtomID( rsd.atom_index( "CA" ), ii ) );
+		}
+	}
+	return ! atoms.empty();
+}
+
 
 void GatherPosesMover::set_score_function(  scoring::ScoreFunctionOP sfxn ) {
 	sfxn_ = sfxn;
@@ -333,7 +379,8 @@ Real ClusterBase::get_cluster_radius() {
 
 void ClusterBase::calculate_distance_matrix() {
 	FArray2D< Real > p1a, p2a;
-	distance_matrix = FArray2D< Real > ( poselist.size(), poselist.size(), 0.0 );
+	coordinate_distances_.reset();
+	distance_matrix = FArray2D< Real >();
 	int count = 0;
 	tr.Info << "Calculating RMS matrix: " << std::endl;
 
@@ -342,30 +389,41 @@ void ClusterBase::calculate_distance_matrix() {
 
 	std::vector<int> histcount(hist_size,0);
 
-	for ( Size i = 0; i < poselist.size(); i++ ) {
-		for ( Size j = i; j < poselist.size(); j++ ) {
-			// only do comparisons once
-			if ( i < j ) {
-				// get the similarity between structure with index i and with index j
-				Real dist  = get_distance_measure( poselist[i],poselist[j]);
-				distance_matrix( i+1, j+1 ) = dist;
-				distance_matrix( j+1, i+1 ) = dist;
-				//    tr.Info << "( " << i+1 << ";" << j+1 << " ) " << dist << std::endl;
-				auto histbin = int(dist/hist_resolution);
+	if ( option[ OptionKeys::cluster::coordinate_rmsd ]() && calculate_coordinate_distance_matrix() ) {
+		for ( Size i = 1; i <= poselist.size(); i++ ) {
+			for ( Size j = i + 1; j <= poselist.size(); j++ ) {
+				auto histbin = int( (*coordinate_distances_)( i, j ) / hist_resolution );
 				if ( histbin < hist_size ) histcount[histbin]+=1;
-
-				// print some stats of progress
-				count ++;
-				if ( count % 5000 == 0 ) {
-					Real const percent_done ( 200.0 * static_cast< Real > ( count ) / ( (poselist.size() - 1) * poselist.size()  ) );
-					tr.Info << count
-						<< "/" << ( poselist.size() - 1 )*( poselist.size() )/2
-						<< " ( " << F(8,1,percent_done) << "% )"
-						<< std::endl;
-				}
 			}
-		} // for it2
-	} // for it1
+		}
+	} else {
+		distance_matrix = FArray2D< Real > ( poselist.size(), poselist.size(), 0.0 );
+
+		for ( Size i = 0; i < poselist.size(); i++ ) {
+			for ( Size j = i; j < poselist.size(); j++ ) {
+				// only do comparisons once
+				if ( i < j ) {
+					// get the similarity between structure with index i and with index j
+					Real dist  = get_distance_measure( poselist[i],poselist[j]);
+					distance_matrix( i+1, j+1 ) = dist;
+					distance_matrix( j+1, i+1 ) = dist;
+					//    tr.Info << "( " << i+1 << ";" << j+1 << " ) " << dist << std::endl;
+					auto histbin = int(dist/hist_resolution);
+					if ( histbin < hist_size ) histcount[histbin]+=1;
+
+					// print some stats of progress
+					count ++;
+					if ( count % 5000 == 0 ) {
+						Real const percent_done ( 200.0 * static_cast< Real > ( count ) / ( (poselist.size() - 1) * poselist.size()  ) );
+						tr.Info << count
+							<< "/" << ( poselist.size() - 1 )*( poselist.size() )/2
+							<< " ( " << F(8,1,percent_done) << "% )"
+							<< std::endl;
+					}
+				}
+			} // for it2
+		} // for it1
+	}
 
 
 	tr.Info << "Histogram of pairwise similarity values for the initial clustering set" << std::endl;
@@ -384,6 +442,43 @@ void ClusterBase::calculate_distance_matrix() {
 
 } // calculate_distance_matrix
 
+bool ClusterBase::calculate_coordinate_distance_matrix() {
+	if ( poselist.size() < 2 ) return false;
+
+	utility::vector1< id::AtomID > atoms;
+	if ( ! coordinate_rmsd_atoms( poselist[ 0 ], atoms ) ) {
+		tr.Info << "The distance measure is not a plain superimposed RMSD; computing the RMS matrix pose by pose" << std::endl;
+		return false;
+	}
+	// The same atoms must exist, in the same residue types, in every structure
+	for ( Size i = 1; i < poselist.size(); i++ ) {
+		if ( poselist[ i ].size() != poselist[ 0 ].size() ) {
+			tr.Info << "Structures differ in length; computing the RMS matrix pose by pose" << std::endl;
+			return false;
+		}
+		for ( Size r = 1; r <= poselist[ 0 ].size(); r++ ) {
+			if ( &poselist[ i ].residue_type( r ) != &poselist[ 0 ].residue_type( r ) ) {
+				tr.Info << "Structures differ in residue types; computing the RMS matrix pose by pose" << std::endl;
+				return false;
+			}
+		}
+	}
+
+	coordinate_distances_ = utility::pointer::make_shared< CoordinateDistanceMatrix >();
+	coordinate_distances_->memory_limit( platform::Size( option[ OptionKeys::cluster::rms_matrix_memory_limit ]() * 1024 * 1024 ) );
+	if ( option[ OptionKeys::cluster::rms_matrix_file ].user() ) {
+		coordinate_distances_->scratch_file( option[ OptionKeys::cluster::rms_matrix_file ]() );
+	}
+	coordinate_distances_->set_coordinates( poselist, atoms );
+	coordinate_distances_->compute();
+	return true;
+}
+
+Real ClusterBase::distance( Size i, Size j ) const {
+	if ( coordinate_distances_ ) return (*coordinate_distances_)( i, j );
+	return distance_matrix( i, j );
+}
+
 // PostProcessing ---------------------------------------------------------
 void ClusterBase::add_structure( Pose & pose ) {
 
@@ -923,7 +1018,7 @@ void ClusterPhilStyle::do_clustering( Size max_total_cluster ) {
 			if ( clusternr[i]>=0 ) continue; // ignore ones already taken
 			for ( j=0; j<listsize; j++ ) {
 				if ( clusternr[j]>=0 ) continue; // ignore ones already taken
-				if ( distance_matrix( i+1, j+1 ) < get_cluster_radius() ) neighbors[i]++;
+				if ( distance( i+1, j+1 ) < get_cluster_radius() ) neighbors[i]++;
 			}
 		}
 
@@ -936,7 +1031,7 @@ void ClusterPhilStyle::do_clustering( Size max_total_cluster ) {
 
 		for ( i=0; i<listsize; i++ ) {
 			if ( clusternr[i]>=0 ) continue; // ignore ones already taken
-			if ( distance_matrix( i+1, mostneighbors+1 ) < get_cluster_radius() ) {
+			if ( distance( i+1, mostneighbors+1 ) < get_cluster_radius() ) {
 				clusternr[i] = mostneighbors;
 			}
 		}
@@ -983,7 +1078,7 @@ void ClusterPhilStyle::do_redistribution() {
 			Real lowrms=10000.0;
 			for ( int m=0; m<(int)clusterlist.size(); m++ ) {
 				Real rms;
-				rms = distance_matrix( clusterlist[i][j]+1,                    // current structure vs
+				rms = distance( clusterlist[i][j]+1,                    // current structure vs
 					clusterlist[m].get_cluster_center()+1); // clustercentre of cluster m
 
 				if ( rms < lowrms ) {
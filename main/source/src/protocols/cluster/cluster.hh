@@ -12,8 +12,10 @@
 #ifndef INCLUDED_protocols_cluster_cluster_hh
 #define INCLUDED_protocols_cluster_cluster_hh
 
+#include <core/id/AtomID.hh>
 #include <core/pose/Pose.hh>
 #include <core/scoring/ScoreFunction.hh>
+#include <protocols/cluster/CoordinateDistanceMatrix.fwd.hh>
 #include <protocols/moves/Mover.hh>
 #include <protocols/loops/Loops.hh>
 #include <protocols/rosetta_scripts/PosePropertyReporter.fwd.hh>
@@ -79,6 +81,15 @@ public:
 		const core::pose::Pose & pose2
 	) const;
 
+	/// @brief If get_distance_measure() is an RMSD after superposition over a fixed set of atoms,
+	/// fill atoms with that set for the given pose and return true; otherwise return false.
+	/// Lets the distance matrix be computed from a coordinate array instead of pose by pose.
+	virtual bool
+	coordinate_rmsd_atoms(
+		core::pose::Pose const & pose,
+		utility::vector1< core::id::AtomID > & atoms
+	) const;
+
 protected:
 	std::vector< core::pose::Pose > poselist;
 
@@ -236,8 +247,20 @@ public:
 
 	std::vector < Cluster >  const & get_cluster_list() const{ return clusterlist; }
 
+protected:
+	/// @brief The distance between structures i and j of the pose list, 1-based, from whichever
+	/// matrix calculate_distance_matrix() filled
+	core::Real distance( core::Size i, core::Size j ) const;
+
+private:
+	/// @brief Compute the matrix with the batched coordinate RMSD kernel; returns false, doing
+	/// nothing, if the distance measure or the poses don't allow it
+	bool calculate_coordinate_distance_matrix();
+
 protected:
 	ObjexxFCL::FArray2D< core::Real >    distance_matrix;
+	/// @brief Single-precision upper triangle used in place of distance_matrix with -cluster:coordinate_rmsd
+	CoordinateDistanceMatrixOP coordinate_distances_;
 	std::vector < Cluster >    clusterlist;
 
 	bool  export_only_low_;
@@ -281,6 +304,12 @@ public:
 		const core::pose::Pose & pose2
 	) const override;
 
+	bool
+	coordinate_rmsd_atoms(
+		core::pose::Pose const &,
+		utility::vector1< core::id::AtomID > &
+	) const override { return false; }
+
 private:
 	protocols::loops::Loops loop_def_;
 };
@@ -303,6 +332,12 @@ public:
 		const core::pose::Pose & pose2
 	) const override;
 
+	bool
+	coordinate_rmsd_atoms(
+		core::pose::Pose const &,
+		utility::vector1< core::id::AtomID > &
+	) const override { return false; }
+
 private:
 	protocols::rosetta_scripts::PosePropertyReporterOP reporter_;
 };
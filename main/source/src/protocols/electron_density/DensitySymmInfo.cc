@@ -18,6 +18,7 @@
 #include <utility/string_util.hh>
 
 #include <protocols/electron_density/util.hh>
+#include <core/scoring/electron_density/util.hh>
 
 #include <utility/tag/Tag.hh>
 
@@ -219,13 +220,13 @@ DensitySymmInfo::autocorrelate(
 	}
 
 	// FFT correlation
-	numeric::fourier::fft3(dens, Fdens);
-	numeric::fourier::fft3(rot, Frot);
+	numeric::fourier::fft3(dens, Fdens, core::scoring::electron_density::fft_job_runner());
+	numeric::fourier::fft3(rot, Frot, core::scoring::electron_density::fft_job_runner());
 	core::Size npoints = grid[0]*grid[1]*grid[2];
 	for ( int i=0; i<(int)npoints ; ++i ) {
 		Frot[i] = Fdens[i] * std::conj( Frot[i] );  // reuse Frot storage
 	}
-	numeric::fourier::ifft3(Frot, rot);
+	numeric::fourier::ifft3(Frot, rot, core::scoring::electron_density::fft_job_runner());
 
 	// parse results
 	core::Real maxcorrel=-1e30, dens2=0;
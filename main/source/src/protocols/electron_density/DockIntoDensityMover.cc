@@ -359,7 +359,7 @@ void
 DockIntoDensityMover::select_points( core::pose::Pose & pose ) {
 	ObjexxFCL::FArray3D< float > const & densdata = core::scoring::electron_density::getDensityMap().get_data();
 	ObjexxFCL::FArray3D< std::complex<double> > Fdens, Frot;
-	numeric::fourier::fft3(densdata, Fdens);
+	numeric::fourier::fft3(densdata, Fdens, core::scoring::electron_density::fft_job_runner());
 
 	// make rotationally averaged pose map
 	utility::vector1< core::Real > pose_1dspec;
@@ -371,14 +371,14 @@ DockIntoDensityMover::select_points( core::pose::Pose & pose ) {
 	ObjexxFCL::FArray3D< double > rot;
 	rot.dimension( densdata.u1(), densdata.u2(), densdata.u3() );
 	map_from_spectrum( pose_1dspec, rot );
-	numeric::fourier::fft3(rot, Frot);
+	numeric::fourier::fft3(rot, Frot, core::scoring::electron_density::fft_job_runner());
 
 	// FFT convolution
 	core::Size npts = densdata.u1()*densdata.u2()*densdata.u3();
 	for ( core::Size i=0; i< npts; ++i ) {
 		Frot[i] = Fdens[i] * std::conj( Frot[i] );  // reuse
 	}
-	numeric::fourier::ifft3(Frot, rot);
+	numeric::fourier::ifft3(Frot, rot, core::scoring::electron_density::fft_job_runner());
 
 	// mask asu
 	if ( symminfo_.enabled() ) {
@@ -106,8 +106,8 @@ void ReportFSC::apply(core::pose::Pose & pose) {
 	ObjexxFCL::FArray3D< double > rhoC, rhoMask;
 	ObjexxFCL::FArray3D< std::complex<double> > FrhoC, FrhoO;
 	core::scoring::electron_density::getDensityMap().calcRhoC( litePose, 0, rhoC, rhoMask );
-	numeric::fourier::fft3(rhoC, FrhoC);
-	numeric::fourier::fft3(core::scoring::electron_density::getDensityMap().get_data(), FrhoO);
+	numeric::fourier::fft3(rhoC, FrhoC, core::scoring::electron_density::fft_job_runner());
+	numeric::fourier::fft3(core::scoring::electron_density::getDensityMap().get_data(), FrhoO, core::scoring::electron_density::fft_job_runner());
 
 	utility::vector1< core::Size > resobin_counts;
 	utility::vector1< core::Real > resobins;
@@ -128,7 +128,7 @@ void ReportFSC::apply(core::pose::Pose & pose) {
 		testmap_->set_voxel_spacing( apix );
 		testmap_->setOrigin( origin );
 
-		numeric::fourier::fft3(testmap_->get_data(), FrhoO);
+		numeric::fourier::fft3(testmap_->get_data(), FrhoO, core::scoring::electron_density::fft_job_runner());
 		testmap_->getFSC( FrhoC, FrhoO, nresbins_, 1.0/res_low_, 1.0/res_high_, modelmap2FSC, bin_squared_ );
 		for ( Size i=1; i<=modelmap2FSC.size(); ++i ) {
 			fsc2 += resobin_counts[i] * modelmap2FSC[i];
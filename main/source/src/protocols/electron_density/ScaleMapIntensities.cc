@@ -123,7 +123,7 @@ void ScaleMapIntensities::apply(core::pose::Pose & pose) {
 		ObjexxFCL::FArray3D< double > rhoC, rhoMask;
 		ObjexxFCL::FArray3D< std::complex<double> > Frho;
 		core::scoring::electron_density::getDensityMap().calcRhoC( litePose, res_high_, rhoC, rhoMask );  // truncate mask at highres limit
-		numeric::fourier::fft3(rhoC, Frho);
+		numeric::fourier::fft3(rhoC, Frho, core::scoring::electron_density::fft_job_runner());
 
 		if ( outmap_name_.length()>0 ) {
 			core::scoring::electron_density::ElectronDensity tmp = core::scoring::electron_density::getDensityMap();
@@ -143,7 +143,7 @@ void ScaleMapIntensities::apply(core::pose::Pose & pose) {
 		} else {
 			for ( int i=0; i<rhoC.u1()*rhoC.u2()*rhoC.u3(); ++i ) rhoC[i] = core::scoring::electron_density::getDensityMap().get_data()[i];
 		}
-		numeric::fourier::fft3(rhoC, Frho);
+		numeric::fourier::fft3(rhoC, Frho, core::scoring::electron_density::fft_job_runner());
 		core::scoring::electron_density::getDensityMap().getIntensities( Frho, nresbins_, 0.0, 0.0, mapI, bin_squared_ );
 
 		for ( Size i=1; i<=nresbins_; ++i ) {
@@ -156,7 +156,7 @@ void ScaleMapIntensities::apply(core::pose::Pose & pose) {
 		//// bfactor sharpen
 		////
 		ObjexxFCL::FArray3D< std::complex<double> > Frho;
-		numeric::fourier::fft3(core::scoring::electron_density::getDensityMap().get_data(), Frho);
+		numeric::fourier::fft3(core::scoring::electron_density::getDensityMap().get_data(), Frho, core::scoring::electron_density::fft_job_runner());
 		core::scoring::electron_density::getDensityMap().getIntensities( Frho, nresbins_, 0.0, 0.0, mapI, bin_squared_);
 
 		for ( Size i=1; i<=nresbins_; ++i ) {
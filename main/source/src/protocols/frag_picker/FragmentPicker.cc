@@ -16,6 +16,7 @@
 
 #include <protocols/frag_picker/VallProvider.hh>
 #include <protocols/frag_picker/VallChunk.hh>
+#include <protocols/frag_picker/VallDatabase.hh>
 #include <protocols/frag_picker/VallResidue.hh>
 #include <protocols/frag_picker/VallChunkFilter.hh>
 #include <protocols/frag_picker/FragmentCandidate.hh>
@@ -94,7 +95,10 @@
 
 
 #if defined MULTI_THREADED
-#include <thread>
+#include <basic/options/keys/multithreading.OptionKeys.gen.hh>
+#include <basic/thread_manager/RosettaThreadManager.hh>
+#include <utility/pointer/memory.hh>
+#include <functional>
 #elif defined USE_BOOST_THREAD
 // Boost headers
 #include <boost/thread.hpp>
@@ -624,7 +628,7 @@ void FragmentPicker::nonlocal_pairs( core::Size const fragment_size, utility::ve
 #if defined MULTI_THREADED || defined USE_BOOST_THREAD
 
 #if defined MULTI_THREADED
-	utility::vector1<std::thread> threads;
+	utility::vector1< basic::thread_manager::RosettaThreadFunctionOP > work_vector;
 #elif defined USE_BOOST_THREAD
 	boost::thread_group threads;
 #endif
@@ -635,15 +639,9 @@ void FragmentPicker::nonlocal_pairs( core::Size const fragment_size, utility::ve
 			for ( core::Size pos = 1; pos <= qPosi_to_run[j].size(); ++pos ) std::cout << " " << qPosi_to_run[j][pos];
 			std::cout << std::endl;
 #if defined MULTI_THREADED
-			threads.push_back( std::thread( boost::bind(
-				&FragmentPicker::nonlocal_pairs_at_positions,
-				this,
-				boost::ref(qPosi_to_run[j]),
-				fragment_size,
-				boost::ref(skip_position),
-				boost::ref(fragment_set),
-				boost::ref(thread_pairs[j]))));
-			//&FragmentPicker::nonlocal_pairs_at_positions, this, qPosi_to_run[j], fragment_size, skip_position, fragment_set, thread_pairs[j]));
+			work_vector.push_back( utility::pointer::make_shared< basic::thread_manager::RosettaThreadFunction >(
+				std::bind( &FragmentPicker::nonlocal_pairs_at_positions, this, std::cref( qPosi_to_run[j] ), fragment_size,
+				std::cref( skip_position ), std::cref( fragment_set ), std::ref( thread_pairs[j] ) ) ) );
 #elif defined USE_BOOST_THREAD
 			threads.create_thread(boost::bind(&FragmentPicker::nonlocal_pairs_at_positions, this, boost::ref(qPosi_to_run[j]), fragment_size, boost::ref(skip_position),
 				boost::ref(fragment_set), boost::ref(thread_pairs[j])));
@@ -651,7 +649,7 @@ void FragmentPicker::nonlocal_pairs( core::Size const fragment_size, utility::ve
 		}
 	}
 #if defined MULTI_THREADED
-	for ( auto& th : threads ) th.join();
+	basic::thread_manager::RosettaThreadManager::get_instance()->do_work_vector_in_threads( work_vector, max_threads_ );
 #elif defined USE_BOOST_THREAD
 	threads.join_all();
 #endif
@@ -1005,6 +1003,7 @@ void FragmentPicker::pick_chunk_candidates(utility::vector1<VallChunkOP> const &
 			} // all query positions done
 		} // all fragment sizes done
 		scores_[index]->clean_up();
+		chunk->release_residues();
 	} // all chunks
 }
 
@@ -1020,23 +1019,27 @@ void FragmentPicker::pick_candidates() {
 #if defined MULTI_THREADED || defined USE_BOOST_THREAD
 
 	if ( max_threads_ > 1 ) {
-		utility::vector1<utility::vector1<VallChunkOP> > chunks_to_run( max_threads_ );
-		core::Size valid_chunks_cnt = 0;
+		// Each thread takes a contiguous range of the valid chunks, holding about the same number of
+		// residues, and scores it with its own score manager into its own collectors; the collectors
+		// are merged when the fragments are selected.
+		utility::vector1<VallChunkOP> valid_chunks;
+		core::Size n_residues = 0;
 		for ( core::Size i = 1; i <= chunks_->size(); ++i ) { // loop over provided chunks
 			VallChunkOP chunk = chunks_->at(i);
 			if ( !is_valid_chunk( chunk ) ) continue;
-			valid_chunks_cnt++;
+			valid_chunks.push_back( chunk );
+			n_residues += chunk->size();
 		}
-		const core::Size chunks_per_thread = valid_chunks_cnt/max_threads_;
+		utility::vector1<utility::vector1<VallChunkOP> > chunks_to_run( max_threads_ );
 		core::Size thread = 1;
-		for ( core::Size i = 1; i <= chunks_->size(); ++i ) { // loop over provided chunks
-			VallChunkOP chunk = chunks_->at(i);
-			if ( !is_valid_chunk( chunk ) ) continue;
-			chunks_to_run[thread].push_back( chunk );
-			if ( chunks_to_run[thread].size() >= chunks_per_thread && thread < max_threads_ ) ++thread;
+		core::Size n_assigned = 0;
+		for ( core::Size i = 1; i <= valid_chunks.size(); ++i ) {
+			chunks_to_run[thread].push_back( valid_chunks[i] );
+			n_assigned += valid_chunks[i]->size();
+			if ( n_assigned * max_threads_ >= thread * n_residues && thread < max_threads_ ) ++thread;
 		}
 #if defined MULTI_THREADED
-		utility::vector1<std::thread> threads;
+		utility::vector1< basic::thread_manager::RosettaThreadFunctionOP > work_vector;
 #elif defined USE_BOOST_THREAD
 		boost::thread_group threads;
 #endif
@@ -1045,14 +1048,15 @@ void FragmentPicker::pick_candidates() {
 			if ( chunks_to_run[j].size() > 0 ) {
 				std::cout << "thread: " << j << " - " << chunks_to_run[j].size() << " chunks" << std::endl;
 #if defined MULTI_THREADED
-				threads.push_back(std::thread(&FragmentPicker::pick_chunk_candidates,this,chunks_to_run[j],j));
+				work_vector.push_back( utility::pointer::make_shared< basic::thread_manager::RosettaThreadFunction >(
+					std::bind( &FragmentPicker::pick_chunk_candidates, this, std::cref( chunks_to_run[j] ), j ) ) );
 #elif defined USE_BOOST_THREAD
 				threads.create_thread(boost::bind(&FragmentPicker::pick_chunk_candidates, this, boost::ref(chunks_to_run[j]), j));
 #endif
 			}
 		}
 #if defined MULTI_THREADED
-		for ( auto& th : threads ) th.join();
+		basic::thread_manager::RosettaThreadManager::get_instance()->do_work_vector_in_threads( work_vector, max_threads_ );
 #elif defined USE_BOOST_THREAD
 		threads.join_all();
 #endif
@@ -1103,6 +1107,7 @@ void FragmentPicker::pick_candidates() {
 			} // all query positions done
 		} // all fragment sizes done
 		scores_[1]->clean_up();
+		chunk->release_residues(); // only affects chunks of a compiled Vall
 		tr.Trace << chunk->get_pdb_id() << " done" << std::endl;
 		if ( (i*100) % (chunks_->size()/100*100) == 0 ) {
 			tr.Info << (i*100) / chunks_->size()
@@ -1460,20 +1465,38 @@ core::Size FragmentPicker::get_n_candidates() const{
 	return n_candidates_;
 }
 
-// called in main
-void FragmentPicker::parse_command_line() {
-
+void FragmentPicker::set_max_threads( core::Size max_threads ) {
 #if defined MULTI_THREADED || defined USE_BOOST_THREAD
-	//## multi-threaded?
-	if ( option[ frags::j ].user() ) max_threads_ = option[ frags::j ]();
+	max_threads_ = std::max( max_threads, core::Size( 1 ) );
+#else
+	(void) max_threads;
 #endif
-	// score with multiple threads
-	while ( max_threads_ > scores_.size() )
-			scores_.push_back(utility::pointer::make_shared< scores::FragmentScoreManager >());
+	// one score manager and one set of collectors per thread
+	while ( max_threads_ > scores_.size() ) {
+		scores_.push_back(utility::pointer::make_shared< scores::FragmentScoreManager >());
+	}
 	while ( max_threads_ > candidates_sinks_.size() ) {
 		CandidatesSink storage;
 		candidates_sinks_.push_back(storage);
 	}
+}
+
+core::Size FragmentPicker::get_max_threads() const {
+	return max_threads_;
+}
+
+// called in main
+void FragmentPicker::parse_command_line() {
+
+	//## multi-threaded?
+	if ( option[ frags::j ].user() ) {
+		set_max_threads( option[ frags::j ]() );
+	}
+#if defined MULTI_THREADED
+	else {
+		set_max_threads( option[ multithreading::total_threads ]() );
+	}
+#endif
 
 	//## -------- setup query profile
 	if ( option[in::file::checkpoint].user() ) {
@@ -1554,6 +1577,9 @@ void FragmentPicker::parse_command_line() {
 	PROF_START( basic::FRAGMENTPICKING_READ_VALL );
 	if ( option[in::file::vall].user() ) {
 		read_vall(option[in::file::vall]());
+		if ( option[frags::write_compiled_vall].user() ) {
+			VallDatabase::write(option[frags::write_compiled_vall](), *chunks_);
+		}
 	}
 	PROF_STOP( basic::FRAGMENTPICKING_READ_VALL );
 
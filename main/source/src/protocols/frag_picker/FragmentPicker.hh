@@ -198,6 +198,15 @@ public:
 	/// @brief Gets n_candidates_
 	core::Size get_n_candidates() const;
 
+	/// @brief Sets the number of threads to pick with, adding a score manager and a set of
+	/// candidate collectors for each.  Call before the scoring methods and collectors are set up;
+	/// parse_command_line() does so from -frags:j (or -multithreading:total_threads).
+	/// @details Has no effect on builds without threads.
+	void set_max_threads( core::Size max_threads );
+
+	/// @brief Gets the number of threads to pick with
+	core::Size get_max_threads() const;
+
 	/// @brief Sets selector_
 	void set_selector( FragmentSelectingRuleOP selector ) {
 		selector_ = selector;
@@ -16,6 +16,7 @@
 #include <protocols/frag_picker/VallChunk.hh>
 
 // package headers
+#include <protocols/frag_picker/VallDatabase.hh>
 #include <protocols/frag_picker/VallResidue.hh>
 #include <protocols/frag_picker/VallProvider.hh>
 
@@ -34,23 +35,85 @@ namespace frag_picker {
 /// @details Auto-generated virtual destructor
 VallChunk::~VallChunk() = default;
 
-VallChunk::VallChunk(VallProviderAP provider) {
+VallChunk::VallChunk(VallProviderAP provider) :
+	vall_key_(0),
+	first_row_(0),
+	n_rows_(0),
+	first_key_(0)
+#ifdef MULTI_THREADED
+	, residues_created_(false)
+#endif
+{
 	sequence_ = "";
 	my_provider_ = provider;
 	has_key_ = false;
 }
 
+VallChunk::VallChunk(VallProviderAP provider, VallDatabaseCOP database, core::Size first_row, core::Size n_rows, core::Size first_key) :
+	vall_key_(0),
+	database_(database),
+	first_row_(first_row),
+	n_rows_(n_rows),
+	first_key_(first_key)
+#ifdef MULTI_THREADED
+	, residues_created_(false)
+#endif
+{
+	runtime_assert( n_rows > 0 && first_row + n_rows - 1 <= database->size() );
+	sequence_ = "";
+	my_provider_ = provider;
+	has_key_ = false;
+}
+
+void VallChunk::release_residues() {
+	if ( ! database_ ) return;
+	utility::vector1<VallResidueOP>().swap(residues_);
+#ifdef MULTI_THREADED
+	residues_created_ = false;
+#endif
+}
+
+std::string VallChunk::residue_id() const {
+	return database_ ? database_->id(first_row_) : at(1)->id();
+}
+
+/// @details The residues are created together, all from consecutive rows of the mapped file.
+utility::vector1<VallResidueOP> const & VallChunk::residues_from_database() const {
+#ifdef MULTI_THREADED
+	if ( residues_created_.load( std::memory_order_acquire ) ) return residues_;
+	std::lock_guard< std::mutex > lock( residues_mutex_ );
+	// Check again -- another thread may have created them while this one waited for the lock.
+	if ( residues_created_.load( std::memory_order_relaxed ) ) return residues_;
+#else
+	if ( ! residues_.empty() ) return residues_;
+#endif
+	utility::vector1<VallResidueOP> residues;
+	residues.reserve(n_rows_);
+	for ( core::Size i = 0; i < n_rows_; ++i ) {
+		residues.push_back( database_->residue( first_row_ + i, first_key_ + i ) );
+	}
+	residues_.swap(residues);
+#ifdef MULTI_THREADED
+	residues_created_.store( true, std::memory_order_release );
+#endif
+	return residues_;
+}
+
 
 void VallChunk::create_key() {
 
 	std::stringstream out;
-	out << get_pdb_id() << get_chain_id() << ':' << at(1)->resi();
+	out << get_pdb_id() << get_chain_id() << ':' << ( database_ ? database_->resi(first_row_) : at(1)->resi() );
 	chunk_key_ =  out.str();
 	has_key_ = true;
 }
 
 std::string& VallChunk::get_sequence() {
-	if ( sequence_.length() == 0 ) {
+	if ( sequence_.length() == 0 && database_ ) {
+		for ( core::Size i = 0; i < n_rows_; i++ ) {
+			sequence_ += database_->aa(first_row_ + i);
+		}
+	} else if ( sequence_.length() == 0 ) {
 		for ( core::Size i = 1; i <= residues_.size(); i++ ) {
 			char next = residues_.at(i)->aa();
 			sequence_ += next;
@@ -19,6 +19,7 @@
 #include <protocols/frag_picker/VallChunk.fwd.hh>
 
 // package headers
+#include <protocols/frag_picker/VallDatabase.fwd.hh>
 #include <protocols/frag_picker/VallProvider.fwd.hh>
 #include <protocols/frag_picker/VallResidue.hh>
 
@@ -29,11 +30,18 @@
 #include <utility/vector1.hh>
 #include <utility/exit.hh>
 
+#ifdef MULTI_THREADED
+#include <atomic>
+#include <mutex>
+#endif
+
 namespace protocols {
 namespace frag_picker {
 
 /// @brief  represents a chunk of residues extracted from a vall.
-/// @details VallChunk contains a vector of VallResidue objects and provides a basic ways to access them
+/// @details VallChunk contains a vector of VallResidue objects and provides a basic ways to access them.
+/// A chunk read from a compiled Vall (VallDatabase) creates its VallResidue objects from the
+/// mapped file the first time one is requested, and can drop them again with release_residues().
 class VallChunk: public utility::pointer::ReferenceCount, public utility::pointer::enable_shared_from_this< VallChunk >
 {
 public:
@@ -42,6 +50,10 @@ public:
 
 	VallChunk(VallProviderAP provider);
 
+	/// @brief a chunk holding rows [first_row, first_row + n_rows) of a compiled Vall;
+	/// the first residue's key is first_key and the others follow consecutively
+	VallChunk(VallProviderAP provider, VallDatabaseCOP database, core::Size first_row, core::Size n_rows, core::Size first_key);
+
 	inline VallChunkCOP get_self_ptr() const { return shared_from_this(); }
 	inline VallChunkOP  get_self_ptr() { return shared_from_this(); }
 	inline VallChunkCAP get_self_weak_ptr() const { return VallChunkCAP( shared_from_this() ); }
@@ -49,22 +61,22 @@ public:
 
 	/// @brief  returns a PDB id (a string of four letters, e.g. "4mba")
 	inline std::string get_pdb_id() const {
-		return at(1)->id().substr(0, 4);
+		return residue_id().substr(0, 4);
 	}
 
 	/// @brief  returns protein chain ID
 	inline char get_chain_id() const {
-		return at(1)->id()[4];
+		return residue_id()[4];
 	}
 
 	/// @brief  returns integer key of this chunk, which is the key of this chunk's first residue
 	inline core::Size key() const {
-		return at(1)->key();
+		return database_ ? first_key_ : at(1)->key();
 	}
 
 	/// @brief  returns the size of this chunk i.e. the number of residues stored in there
 	inline core::Size size() const {
-		return residues_.size();
+		return database_ ? n_rows_ : residues_.size();
 	}
 
 	inline core::Size vall_key() const {
@@ -77,16 +89,21 @@ public:
 
 	/// @brief  returns i-th residue form this chunk. The first residue has index 1
 	inline VallResidueOP at(core::Size index) const {
-		runtime_assert( index <= residues_.size() );
+		runtime_assert( index <= size() );
 		runtime_assert( index >= 1 );
-		return residues_.at(index);
+		return database_ ? residues_from_database().at(index) : residues_.at(index);
 	}
 
 	/// @brief  appends a residue to this chunk
 	inline void push_back(VallResidueOP what) {
+		runtime_assert( ! database_ );
 		residues_.push_back(what);
 	}
 
+	/// @brief  frees the residues created for a chunk of a compiled Vall; they are created
+	/// again if requested.  Must not be called while another thread uses this chunk.
+	void release_residues();
+
 	/// @brief  returns amino acid sequence of this chunk
 	std::string& get_sequence();
 
@@ -111,14 +128,30 @@ public:
 	std::string & chunk_key() { if ( !has_key_ ) { create_key(); } return chunk_key_; }
 
 private:
-	utility::vector1<VallResidueOP> residues_;
+	/// @brief  the id (PDB id and chain) of the first residue
+	std::string residue_id() const;
+
+	/// @brief  the residues of a chunk of a compiled Vall, created on first use
+	utility::vector1<VallResidueOP> const & residues_from_database() const;
+
+	void create_key();
+
+private:
+	mutable utility::vector1<VallResidueOP> residues_;
 	std::string sequence_;
 	VallProviderAP my_provider_;
 	std::string chunk_key_;
 	core::Size vall_key_;
 	bool has_key_;
 
-	void create_key();
+	VallDatabaseCOP database_;
+	core::Size first_row_;
+	core::Size n_rows_;
+	core::Size first_key_;
+#ifdef MULTI_THREADED
+	mutable std::atomic< bool > residues_created_;
+	mutable std::mutex residues_mutex_;
+#endif
 };
 
 } // frag_picker
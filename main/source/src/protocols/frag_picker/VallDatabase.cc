@@ -0,0 +1,337 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   protocols/frag_picker/VallDatabase.cc
+/// @brief  a compiled, memory-mapped Vall library stored as per-residue columns
+
+// unit headers
+#include <protocols/frag_picker/VallDatabase.hh>
+
+// package headers
+#include <protocols/frag_picker/VallChunk.hh>
+#include <protocols/frag_picker/VallProvider.hh>
+#include <protocols/frag_picker/VallResidue.hh>
+
+// project headers
+#include <basic/Tracer.hh>
+
+// utility headers
+#include <utility/exit.hh>
+#include <utility/io/MappedFile.hh>
+#include <utility/pointer/memory.hh>
+#include <utility/vector1.hh>
+
+// C++ headers
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+static basic::Tracer TR( "protocols.frag_picker.VallDatabase" );
+
+namespace protocols {
+namespace frag_picker {
+
+using core::Size;
+using core::Real;
+
+namespace {
+
+char const MAGIC[] = "RVALLDB1";
+Size const MAGIC_SIZE = 8;
+std::uint32_t const BYTE_ORDER_MARK = 0x01020304;
+std::uint32_t const FORMAT_VERSION = 1;
+Size const HEADER_SIZE = MAGIC_SIZE + 2 * sizeof( std::uint32_t ) + 2 * sizeof( std::uint64_t );
+Size const ID_SIZE = 5;
+Size const PROFILE_SIZE = 20;
+Size const N_SHIFTS = 12;
+
+/// @brief The real-valued columns, in file order; getters and setters must agree
+typedef Real ( VallResidue::*RealGetter )() const;
+typedef void ( VallResidue::*RealSetter )( Real const );
+
+RealGetter const REAL_GETTERS[] = {
+	&VallResidue::bF, &VallResidue::x, &VallResidue::y, &VallResidue::z,
+	&VallResidue::cbx, &VallResidue::cby, &VallResidue::cbz,
+	&VallResidue::cenx, &VallResidue::ceny, &VallResidue::cenz,
+	&VallResidue::phi, &VallResidue::psi, &VallResidue::omega,
+	&VallResidue::dssp_phi, &VallResidue::dssp_psi,
+	&VallResidue::sa, &VallResidue::sa_norm, &VallResidue::depth
+};
+
+RealSetter const REAL_SETTERS[] = {
+	&VallResidue::bF, &VallResidue::x, &VallResidue::y, &VallResidue::z,
+	&VallResidue::cbx, &VallResidue::cby, &VallResidue::cbz,
+	&VallResidue::cenx, &VallResidue::ceny, &VallResidue::cenz,
+	&VallResidue::phi, &VallResidue::psi, &VallResidue::omega,
+	&VallResidue::dssp_phi, &VallResidue::dssp_psi,
+	&VallResidue::sa, &VallResidue::sa_norm, &VallResidue::depth
+};
+
+Size const N_REAL_COLUMNS = sizeof( REAL_GETTERS ) / sizeof( RealGetter );
+
+Size padded( Size const nbytes ) { return ( nbytes + 7 ) / 8 * 8; }
+
+/// @brief Byte offsets of the columns in a file of the given numbers of residues and chunks
+struct ColumnOffsets {
+	ColumnOffsets( Size const n_residues, Size const n_chunks ) {
+		chunk_offsets = HEADER_SIZE;
+		ids = chunk_offsets + padded( ( n_chunks + 1 ) * sizeof( std::uint64_t ) );
+		aa = ids + padded( ID_SIZE * n_residues );
+		ss = aa + padded( n_residues );
+		ss_str = ss + padded( n_residues );
+		has_shifts = ss_str + padded( n_residues );
+		resi = has_shifts + padded( n_residues );
+		nali = resi + padded( n_residues * sizeof( std::uint32_t ) );
+		reals = nali + padded( n_residues * sizeof( std::uint32_t ) );
+		profile = reals + padded( N_REAL_COLUMNS * n_residues * sizeof( float ) );
+		profile_struct = profile + padded( PROFILE_SIZE * n_residues * sizeof( float ) );
+		shifts = profile_struct + padded( PROFILE_SIZE * n_residues * sizeof( float ) );
+		end = shifts + padded( N_SHIFTS * n_residues * sizeof( float ) );
+	}
+
+	Size chunk_offsets, ids, aa, ss, ss_str, has_shifts, resi, nali, reals, profile, profile_struct, shifts, end;
+};
+
+template < class T >
+void
+write_column( std::ostream & out, std::vector< T > const & values ) {
+	Size const nbytes( values.size() * sizeof( T ) );
+	out.write( reinterpret_cast< char const * >( values.data() ), nbytes );
+	char const zeros[ 8 ] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+	out.write( zeros, padded( nbytes ) - nbytes );
+}
+
+}
+
+VallDatabase::VallDatabase()
+{
+	clear();
+}
+
+VallDatabase::VallDatabase( std::string const & filename )
+{
+	clear();
+	open( filename );
+}
+
+VallDatabase::~VallDatabase() = default;
+
+bool
+VallDatabase::open( std::string const & filename ) {
+	clear();
+	filename_ = filename;
+	utility::io::MappedFileOP file( utility::pointer::make_shared< utility::io::MappedFile >( filename ) );
+	if ( ! file->is_open() || file->size() < HEADER_SIZE || std::memcmp( file->data(), MAGIC, MAGIC_SIZE ) != 0 ) {
+		TR.Error << filename << " is not a compiled Vall" << std::endl;
+		clear();
+		return false;
+	}
+
+	char const * const data( file->data() );
+	std::uint32_t byte_order, version;
+	std::uint64_t n_residues, n_chunks;
+	std::memcpy( &byte_order, data + MAGIC_SIZE, sizeof( byte_order ) );
+	std::memcpy( &version, data + MAGIC_SIZE + 4, sizeof( version ) );
+	std::memcpy( &n_residues, data + MAGIC_SIZE + 8, sizeof( n_residues ) );
+	std::memcpy( &n_chunks, data + MAGIC_SIZE + 16, sizeof( n_chunks ) );
+	if ( byte_order != BYTE_ORDER_MARK || version != FORMAT_VERSION ) {
+		TR.Error << filename << " was compiled with a different format version or byte order; "
+			<< "recompile it from the text Vall" << std::endl;
+		clear();
+		return false;
+	}
+
+	ColumnOffsets const offsets( n_residues, n_chunks );
+	if ( file->size() != offsets.end ) {
+		TR.Error << filename << " is truncated or corrupt: expected " << offsets.end
+			<< " bytes, found " << file->size() << std::endl;
+		clear();
+		return false;
+	}
+
+	chunk_offsets_ = reinterpret_cast< std::uint64_t const * >( data + offsets.chunk_offsets );
+	bool ordered( chunk_offsets_[ 0 ] == 0 && chunk_offsets_[ n_chunks ] == n_residues );
+	for ( Size ii = 1; ordered && ii <= n_chunks; ++ii ) {
+		ordered = chunk_offsets_[ ii - 1 ] < chunk_offsets_[ ii ];
+	}
+	if ( ! ordered ) {
+		TR.Error << filename << " has an invalid chunk table" << std::endl;
+		clear();
+		return false;
+	}
+
+	file_ = file;
+	n_residues_ = n_residues;
+	n_chunks_ = n_chunks;
+	ids_ = data + offsets.ids;
+	aa_ = data + offsets.aa;
+	ss_ = data + offsets.ss;
+	ss_str_ = data + offsets.ss_str;
+	has_shifts_ = data + offsets.has_shifts;
+	resi_ = reinterpret_cast< std::uint32_t const * >( data + offsets.resi );
+	nali_ = reinterpret_cast< std::uint32_t const * >( data + offsets.nali );
+	reals_ = reinterpret_cast< float const * >( data + offsets.reals );
+	profile_ = reinterpret_cast< float const * >( data + offsets.profile );
+	profile_struct_ = reinterpret_cast< float const * >( data + offsets.profile_struct );
+	shifts_ = reinterpret_cast< float const * >( data + offsets.shifts );
+	return true;
+}
+
+bool
+VallDatabase::is_open() const {
+	return file_ != nullptr;
+}
+
+std::string
+VallDatabase::id( Size const row ) const {
+	char const * const begin( ids_ + ID_SIZE * ( row - 1 ) );
+	Size length( 0 );
+	while ( length < ID_SIZE && begin[ length ] != '\0' ) ++length;
+	return std::string( begin, length );
+}
+
+VallResidueOP
+VallDatabase::residue( Size const row, Size const key ) const {
+	debug_assert( row >= 1 && row <= n_residues_ );
+	Size const index( row - 1 );
+
+	VallResidueOP residue( utility::pointer::make_shared< VallResidue >() );
+	residue->key( key );
+	residue->id( id( row ) );
+	residue->aa( aa_[ index ] );
+	residue->ss( ss_[ index ] );
+	residue->ss_str( ss_str_[ index ] );
+	residue->resi( resi_[ index ] );
+	residue->nali( nali_[ index ] );
+	for ( Size ii = 0; ii < N_REAL_COLUMNS; ++ii ) {
+		( ( *residue ).*REAL_SETTERS[ ii ] )( column( ii, row ) );
+	}
+
+	utility::vector1< Real > profile( PROFILE_SIZE );
+	for ( Size ii = 1; ii <= PROFILE_SIZE; ++ii ) profile[ ii ] = profile_[ PROFILE_SIZE * index + ii - 1 ];
+	residue->profile( profile );
+	for ( Size ii = 1; ii <= PROFILE_SIZE; ++ii ) profile[ ii ] = profile_struct_[ PROFILE_SIZE * index + ii - 1 ];
+	residue->profile_struct( profile );
+
+	if ( has_shifts_[ index ] ) {
+		utility::vector1< Real > shifts( N_SHIFTS );
+		for ( Size ii = 1; ii <= N_SHIFTS; ++ii ) shifts[ ii ] = shifts_[ N_SHIFTS * index + ii - 1 ];
+		residue->secondary_shifts( shifts );
+	}
+	return residue;
+}
+
+bool
+VallDatabase::is_vall_database( std::string const & filename ) {
+	std::ifstream in( filename.c_str(), std::ios::in | std::ios::binary );
+	if ( ! in.good() ) return false;
+	char magic[ MAGIC_SIZE ];
+	in.read( magic, MAGIC_SIZE );
+	return in.gcount() == std::streamsize( MAGIC_SIZE ) && std::memcmp( magic, MAGIC, MAGIC_SIZE ) == 0;
+}
+
+/// @details The columns are gathered and written one after another, so that beyond the
+/// provider itself only one column is held in memory at a time.
+void
+VallDatabase::write( std::string const & filename, VallProvider const & provider ) {
+	utility::vector1< VallResidueOP > rows;
+	std::vector< std::uint64_t > chunk_offsets( 1, 0 );
+	for ( Size ii = 1; ii <= provider.size(); ++ii ) {
+		VallChunkOP chunk( provider.at( ii ) );
+		if ( chunk->size() == 0 ) continue;
+		for ( Size jj = 1; jj <= chunk->size(); ++jj ) {
+			rows.push_back( chunk->at( jj ) );
+		}
+		chunk_offsets.push_back( rows.size() );
+	}
+	Size const n_residues( rows.size() );
+	Size const n_chunks( chunk_offsets.size() - 1 );
+
+	std::ofstream out( filename.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
+	if ( ! out.good() ) {
+		utility_exit_with_message( "Could not make " + filename );
+	}
+	TR.Info << "Compiling " << n_residues << " Vall residues in " << n_chunks << " chunks into " << filename << std::endl;
+
+	out.write( MAGIC, MAGIC_SIZE );
+	std::uint64_t const header[] = { n_residues, n_chunks };
+	out.write( reinterpret_cast< char const * >( &BYTE_ORDER_MARK ), sizeof( BYTE_ORDER_MARK ) );
+	out.write( reinterpret_cast< char const * >( &FORMAT_VERSION ), sizeof( FORMAT_VERSION ) );
+	out.write( reinterpret_cast< char const * >( header ), sizeof( header ) );
+	write_column( out, chunk_offsets );
+
+	std::vector< char > chars( ID_SIZE * n_residues, '\0' );
+	for ( Size ii = 1; ii <= n_residues; ++ii ) {
+		std::string const & id( rows[ ii ]->id() );
+		std::memcpy( &chars[ ID_SIZE * ( ii - 1 ) ], id.data(), std::min( id.size(), ID_SIZE ) );
+	}
+	write_column( out, chars );
+	chars.resize( n_residues );
+	for ( Size ii = 1; ii <= n_residues; ++ii ) chars[ ii - 1 ] = rows[ ii ]->aa();
+	write_column( out, chars );
+	for ( Size ii = 1; ii <= n_residues; ++ii ) chars[ ii - 1 ] = rows[ ii ]->ss();
+	write_column( out, chars );
+	for ( Size ii = 1; ii <= n_residues; ++ii ) chars[ ii - 1 ] = rows[ ii ]->ss_str();
+	write_column( out, chars );
+	for ( Size ii = 1; ii <= n_residues; ++ii ) chars[ ii - 1 ] = rows[ ii ]->has_chemical_shifts();
+	write_column( out, chars );
+
+	std::vector< std::uint32_t > integers( n_residues );
+	for ( Size ii = 1; ii <= n_residues; ++ii ) integers[ ii - 1 ] = rows[ ii ]->resi();
+	write_column( out, integers );
+	for ( Size ii = 1; ii <= n_residues; ++ii ) integers[ ii - 1 ] = rows[ ii ]->nali();
+	write_column( out, integers );
+
+	std::vector< float > reals( N_REAL_COLUMNS * n_residues );
+	for ( Size jj = 0; jj < N_REAL_COLUMNS; ++jj ) {
+		for ( Size ii = 1; ii <= n_residues; ++ii ) {
+			reals[ jj * n_residues + ii - 1 ] = ( ( *rows[ ii ] ).*REAL_GETTERS[ jj ] )();
+		}
+	}
+	write_column( out, reals );
+
+	reals.assign( PROFILE_SIZE * n_residues, 0.0f );
+	for ( Size ii = 1; ii <= n_residues; ++ii ) {
+		utility::vector1< Real > const & profile( rows[ ii ]->profile() );
+		for ( Size jj = 1; jj <= PROFILE_SIZE && jj <= profile.size(); ++jj ) reals[ PROFILE_SIZE * ( ii - 1 ) + jj - 1 ] = profile[ jj ];
+	}
+	write_column( out, reals );
+	reals.assign( PROFILE_SIZE * n_residues, 0.0f );
+	for ( Size ii = 1; ii <= n_residues; ++ii ) {
+		utility::vector1< Real > const & profile( rows[ ii ]->profile_struct() );
+		for ( Size jj = 1; jj <= PROFILE_SIZE && jj <= profile.size(); ++jj ) reals[ PROFILE_SIZE * ( ii - 1 ) + jj - 1 ] = profile[ jj ];
+	}
+	write_column( out, reals );
+	reals.assign( N_SHIFTS * n_residues, 0.0f );
+	for ( Size ii = 1; ii <= n_residues; ++ii ) {
+		utility::vector1< Real > const & shifts( rows[ ii ]->secondary_shifts() );
+		for ( Size jj = 1; jj <= N_SHIFTS && jj <= shifts.size(); ++jj ) reals[ N_SHIFTS * ( ii - 1 ) + jj - 1 ] = shifts[ jj ];
+	}
+	write_column( out, reals );
+
+	out.close();
+	if ( ! out ) {
+		utility_exit_with_message( "Error writing the compiled Vall " + filename );
+	}
+}
+
+void
+VallDatabase::clear() {
+	filename_.clear();
+	file_.reset();
+	n_residues_ = n_chunks_ = 0;
+	chunk_offsets_ = nullptr;
+	ids_ = aa_ = ss_ = ss_str_ = has_shifts_ = nullptr;
+	resi_ = nali_ = nullptr;
+	reals_ = profile_ = profile_struct_ = shifts_ = nullptr;
+}
+
+} // frag_picker
+} // protocols
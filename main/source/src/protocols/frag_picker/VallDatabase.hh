@@ -0,0 +1,138 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   protocols/frag_picker/VallDatabase.hh
+/// @brief  a compiled, memory-mapped Vall library stored as per-residue columns
+
+#ifndef INCLUDED_protocols_frag_picker_VallDatabase_hh
+#define INCLUDED_protocols_frag_picker_VallDatabase_hh
+
+// unit headers
+#include <protocols/frag_picker/VallDatabase.fwd.hh>
+
+// package headers
+#include <protocols/frag_picker/VallProvider.fwd.hh>
+#include <protocols/frag_picker/VallResidue.fwd.hh>
+
+// type headers
+#include <core/types.hh>
+
+// utility headers
+#include <utility/io/MappedFile.fwd.hh>
+#include <utility/pointer/ReferenceCount.hh>
+
+// C++ headers
+#include <cstdint>
+#include <string>
+
+namespace protocols {
+namespace frag_picker {
+
+/// @brief A Vall library compiled into a binary file of per-residue columns, which is
+/// memory-mapped rather than parsed.
+///
+/// @details Each row holds one residue line of the text Vall it was compiled from, in the
+/// same order, so row numbers play the role of line numbers (comment lines excluded).
+/// Layout, in the byte order of the machine that wrote it:
+///
+///   char[8]  "RVALLDB1"
+///   uint32   0x01020304 -- byte-order mark
+///   uint32   format version
+///   uint64   N residues, uint64 C chunks
+///   uint64   C+1 chunk offsets; chunk c holds rows [ offset[c], offset[c+1] )
+///   char     5N ids (PDB id and chain), N aa, N ss, N ss_str, N has-shifts flags
+///   uint32   N resi, N nali
+///   float    N each of bF, x, y, z, cbx, cby, cbz, cenx, ceny, cenz, phi, psi, omega,
+///            dssp_phi, dssp_psi, sa, sa_norm and depth
+///   float    20N profile, 20N structure profile, 12N secondary chemical shifts
+///
+/// Every column starts on an eight-byte boundary.  Real values are stored in single
+/// precision, well beyond the three decimals of the text format.  Since the file is
+/// mapped with MAP_SHARED, concurrent picker processes on a node share one copy of it in
+/// the page cache, and only the pages actually touched are read.
+class VallDatabase : public utility::pointer::ReferenceCount
+{
+public:
+	/// @brief Construct a closed %VallDatabase
+	VallDatabase();
+
+	/// @brief Construct and open; check is_open() for success
+	explicit VallDatabase( std::string const & filename );
+
+	~VallDatabase() override;
+
+	/// @brief Map a compiled Vall.  Returns false if the file cannot be read, is not a
+	/// compiled Vall, or was written by a different format version or byte order.
+	bool open( std::string const & filename );
+
+	bool is_open() const;
+
+	std::string const & filename() const { return filename_; }
+
+	/// @brief The number of residues (rows)
+	core::Size size() const { return n_residues_; }
+
+	/// @brief The number of chunks the rows were split into when compiled
+	core::Size n_chunks() const { return n_chunks_; }
+
+	/// @brief The first row (1-based) of the given chunk (1-based)
+	core::Size chunk_begin( core::Size chunk ) const { return chunk_offsets_[ chunk - 1 ] + 1; }
+
+	/// @brief One past the last row (1-based) of the given chunk (1-based)
+	core::Size chunk_end( core::Size chunk ) const { return chunk_offsets_[ chunk ] + 1; }
+
+	/// @brief PDB id and chain of a row, e.g. "4mbaA"
+	std::string id( core::Size row ) const;
+
+	char aa( core::Size row ) const { return aa_[ row - 1 ]; }
+
+	core::Size resi( core::Size row ) const { return resi_[ row - 1 ]; }
+
+	/// @brief A new VallResidue holding the data of a row, with the given key
+	VallResidueOP residue( core::Size row, core::Size key ) const;
+
+public:
+	/// @brief Does the file exist and start with the compiled-Vall magic?
+	static bool is_vall_database( std::string const & filename );
+
+	/// @brief Compile the chunks of a provider into a Vall database
+	static void write( std::string const & filename, VallProvider const & provider );
+
+private:
+	VallDatabase( VallDatabase const & ); // unimplemented -- not copyable
+	VallDatabase & operator = ( VallDatabase const & ); // unimplemented
+
+	void clear();
+
+	float column( core::Size column_index, core::Size row ) const { return reals_[ column_index * n_residues_ + row - 1 ]; }
+
+private:
+	std::string filename_;
+	utility::io::MappedFileOP file_;
+	core::Size n_residues_;
+	core::Size n_chunks_;
+
+	std::uint64_t const * chunk_offsets_;
+	char const * ids_;
+	char const * aa_;
+	char const * ss_;
+	char const * ss_str_;
+	char const * has_shifts_;
+	std::uint32_t const * resi_;
+	std::uint32_t const * nali_;
+	float const * reals_;
+	float const * profile_;
+	float const * profile_struct_;
+	float const * shifts_;
+};
+
+} // frag_picker
+} // protocols
+
+#endif /* INCLUDED_protocols_frag_picker_VallDatabase_hh */
@@ -20,6 +20,7 @@
 // package headers
 #include <protocols/frag_picker/VallResidue.hh>
 #include <protocols/frag_picker/VallChunk.hh>
+#include <protocols/frag_picker/VallDatabase.hh>
 
 // project headers
 #include <basic/Tracer.hh>
@@ -38,6 +39,7 @@
 #endif
 
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 
@@ -150,6 +152,14 @@ core::Size VallProvider::vallChunksFromLibraries(utility::vector1< std::string >
 	return 0;
 }
 core::Size VallProvider::vallNumLines(std::string const & filename) {
+	if ( VallDatabase::is_vall_database(filename) ) {
+		VallDatabase const database(filename);
+		if ( !database.is_open() ) {
+			utility_exit_with_message( "can't read compiled Vall: " + filename );
+		}
+		return database.size();
+	}
+
 	core::Size num_lines;
 	utility::io::izstream stream(filename);
 	if ( !stream ) {
@@ -171,6 +181,10 @@ core::Size VallProvider::vallChunksFromLibrary(std::string const & filename, cor
 
 	TR.Info << "vallChunksFromLibrary" << std::endl;
 
+	if ( VallDatabase::is_vall_database(filename) ) {
+		return vallChunksFromDatabase(filename, startline, endline);
+	}
+
 	utility::io::izstream stream(filename);
 	if ( !stream ) {
 		utility_exit_with_message( "can't open file: " + filename );
@@ -308,13 +322,69 @@ core::Size VallProvider::vallChunksFromLibrary(std::string const & filename, cor
 	TR.Info << "Total chunks: " << size() << std::endl;
 	TR.Info << "Largest chunk: " << largest_chunk_size_ << " aa" << std::endl;
 
-	// create cached pose
+	create_cached_pose();
+	TR.flush();
+	return n_lines;
+}
+
+/// @details Only the chunk table is read here; each chunk creates its VallResidue objects
+/// from the mapped columns when they are first needed.  The chunks, and the residue keys
+/// (row number plus the last key already known), are the same as those
+/// vallChunksFromLibrary() creates from the text Vall the database was compiled from.
+core::Size VallProvider::vallChunksFromDatabase(std::string const & filename, core::Size startline, core::Size endline) {
+
+	time_t time_start = time(nullptr);
+
+	VallDatabaseOP database( new VallDatabase(filename) );
+	if ( !database->is_open() ) {
+		utility_exit_with_message( "can't read compiled Vall: " + filename );
+	}
+	TR.Info << "Mapping compiled Vall library " << filename << " ... startline: " << startline << "  endline: " << endline << std::endl;
+
+	vall_keys_.push_back(filename);
+
+	core::Size last_key = 0;
+	if ( chunks_.size() > 0 ) {
+		VallChunkOP last_chunk = chunks_[ chunks_.size() ];
+		last_key = last_chunk->key() + last_chunk->size() - 1;
+	}
+	vall_last_residue_key_.push_back(last_key);
+
+	core::Size const first_row = std::max( startline, core::Size( 1 ) );
+	core::Size const end_row = ( endline == 0 || endline > database->size() ) ? database->size() + 1 : endline + 1;
+	core::Size n_rows = 0;
+	for ( core::Size i = 1; i <= database->n_chunks(); ++i ) {
+		core::Size const begin = std::max( database->chunk_begin(i), first_row );
+		core::Size const end = std::min( database->chunk_end(i), end_row );
+		if ( begin >= end ) continue;
+
+		VallChunkOP chunk( new VallChunk(get_self_weak_ptr(), database, begin, end - begin, begin + last_key) );
+		chunk->vall_key(vall_keys_.size());
+		push_back(chunk);
+		if ( chunk->size() > largest_chunk_size_ ) largest_chunk_size_ = chunk->size();
+		n_rows += chunk->size();
+	}
+	vall_start_line_.push_back(first_row);
+	vall_end_line_.push_back(first_row + n_rows - 1);
+
+	time_t time_end = time(nullptr);
+
+	TR.Info << "... done.  Mapped " << n_rows << " residues.  Time elapsed: "
+		<< (time_end - time_start) << " seconds." << std::endl;
+
+	TR.Info << "Total chunks: " << size() << std::endl;
+	TR.Info << "Largest chunk: " << largest_chunk_size_ << " aa" << std::endl;
+
+	create_cached_pose();
+	TR.flush();
+	return n_rows;
+}
+
+void VallProvider::create_cached_pose() {
 	for ( core::Size i = 1; i <= largest_chunk_size_; i++ ) poly_A_seq_ += "A";
 	cached_pose_ = utility::pointer::make_shared< core::pose::Pose >();
 	core::pose::make_pose_from_sequence(*cached_pose_, poly_A_seq_,
 		*(chemical::ChemicalManager::get_instance()->residue_type_set("fa_standard")));
-	TR.flush();
-	return n_lines;
 }
 
 } // frag_picker
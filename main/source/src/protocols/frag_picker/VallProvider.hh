@@ -52,20 +52,26 @@ public:
 
 	/// @brief Vall reader
 	/// THe defaults should ensure that the file is fully read if startline and endline ar not specified. endline = 0 means read to the end.
+	/// @details A compiled Vall (see VallDatabase) is recognized and mapped rather than parsed;
+	/// its rows then count as the lines.
 	core::Size vallChunksFromLibrary(std::string const & filename, core::Size startline = 1, core::Size endline = 0 );
 
+	/// @brief Maps a compiled Vall, creating chunks that read their residues from it on demand.
+	/// Takes rows startline to endline (0: to the end), as vallChunksFromLibrary() takes lines.
+	core::Size vallChunksFromDatabase(std::string const & filename, core::Size startline = 1, core::Size endline = 0 );
+
 	core::Size vallChunksFromLibraries( utility::vector1< std::string > const & fns );
 
 	/// @brief Runs through the Vall and stores number of lines
 	core::Size vallNumLines(std::string const & filename);
 
 	/// @brief says how many chunks do we have
-	inline core::Size size() {
+	inline core::Size size() const {
 		return chunks_.size();
 	}
 
 	/// @brief returns a certain chunk (starts from 1)
-	inline VallChunkOP at(core::Size index) {
+	inline VallChunkOP at(core::Size index) const {
 		return chunks_.at(index);
 	}
 
@@ -111,6 +117,10 @@ public:
 	/// @brief cache a pose for a given chunk
 	core::pose::PoseOP cache_pose(VallChunkOP source_chunk);
 
+private:
+	/// @brief (re)creates the poly-alanine pose that cache_pose() fills
+	void create_cached_pose();
+
 private:
 	utility::vector1<VallChunkOP> chunks_;
 	utility::vector1<std::string> vall_keys_;
@@ -231,6 +231,11 @@ public:
 		profile_struct_ = v;
 	}
 
+	/// @brief secondary chemical shifts
+	inline void secondary_shifts(utility::vector1<core::Real> const & v) {
+		sec_shift_data_ = v;
+	}
+
 
 public:
 	// mutators
@@ -365,6 +370,24 @@ public:
 		sa_ = val;
 	}
 
+	/// @brief solvent accessible area normalized by the amino acid's maximum
+	inline
+	void sa_norm(core::Real const val) {
+		sa_norm_ = val;
+	}
+
+	/// @brief phi backbone torsion in degrees from DSSP
+	inline
+	void dssp_phi(core::Real const val) {
+		dssp_phi_ = val;
+	}
+
+	/// @brief psi backbone torsion in degrees from DSSP
+	inline
+	void dssp_psi(core::Real const val) {
+		dssp_psi_ = val;
+	}
+
 	/// @brief number of alignments
 	inline
 	void nali(core::Size const val) {
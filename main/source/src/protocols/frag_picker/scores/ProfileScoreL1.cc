@@ -61,6 +61,7 @@ ProfileScoreL1::ProfileScoreL1(core::Size priority, core::Real lowest_acceptable
 		utility::vector1<core::Real> row(longest_vall_chunk);
 		scores_.push_back(row);
 	}
+	transpose_profile(query_profile->profile(),20,query_columns_);
 	create_cache(frag_sizes,query_profile->length(),longest_vall_chunk,cache_);
 	if ( trProfScoreL1.visible() ) {
 		trProfScoreL1 << "Created cache for fraglen:";
@@ -99,15 +100,11 @@ void ProfileScoreL1::do_caching_simple(VallChunkOP chunk) {
 
 	trProfScoreL1.Debug << "caching profile score for " << chunk->get_pdb_id()
 		<< " of size " << chunk->size() << std::endl;
-	for ( core::Size i = 1; i <= size_q; ++i ) {
-		utility::vector1<core::Real> query_prof_row = query_profile_->prof_row(i);
-		for ( core::Size j = 1; j <= chunk->size(); ++j ) {
-			utility::vector1<core::Real> tmplt_prof_row = chunk->at(j)->profile();
-			core::Real score = 0.0;
-			for ( core::Size k = 1; k <= 20; k++ ) {
-				score += std::abs(tmplt_prof_row[k] - query_prof_row[k]);
-			}
-			scores_[i][j] = score;
+	// one template row against all query positions at a time
+	for ( core::Size j = 1; j <= chunk->size(); ++j ) {
+		l1_profile_scores(query_columns_,size_q,chunk->at(j)->profile(),20,row_scores_);
+		for ( core::Size i = 1; i <= size_q; ++i ) {
+			scores_[i][j] = row_scores_[i];
 		}
 	}
 
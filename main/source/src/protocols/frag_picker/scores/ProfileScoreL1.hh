@@ -56,6 +56,9 @@ protected:
 
 private:
 	core::sequence::SequenceProfileOP query_profile_;
+	/// @brief the query profile, transposed for l1_profile_scores()
+	utility::vector1<core::Real> query_columns_;
+	utility::vector1<core::Real> row_scores_;
 	std::string cached_scores_id_;
 	void clear();
 };
@@ -57,6 +57,7 @@ ProfileScoreStructL1::ProfileScoreStructL1(core::Size priority, core::Real lowes
 		utility::vector1<core::Real> row(longest_vall_chunk);
 		scores_.push_back(row);
 	}
+	transpose_profile(query_profile->profile(),20,query_columns_);
 	create_cache(frag_sizes,query_profile->length(),longest_vall_chunk,cache_);
 	if ( trProfScoreL1.visible() ) {
 		trProfScoreL1 << "Created cache for fraglen:";
@@ -95,15 +96,11 @@ void ProfileScoreStructL1::do_caching_simple(VallChunkOP chunk) {
 
 	trProfScoreL1.Debug << "caching profile score for " << chunk->get_pdb_id()
 		<< " of size " << chunk->size() << std::endl;
-	for ( core::Size i = 1; i <= size_q; ++i ) {
-		utility::vector1<core::Real> query_prof_row = query_profile_->prof_row(i);
-		for ( core::Size j = 1; j <= chunk->size(); ++j ) {
-			utility::vector1<core::Real> tmplt_prof_row = chunk->at(j)->profile_struct();
-			core::Real score = 0.0;
-			for ( core::Size k = 1; k <= 20; k++ ) {
-				score += std::abs(tmplt_prof_row[k] - query_prof_row[k]);
-			}
-			scores_[i][j] = score;
+	// one template row against all query positions at a time
+	for ( core::Size j = 1; j <= chunk->size(); ++j ) {
+		l1_profile_scores(query_columns_,size_q,chunk->at(j)->profile_struct(),20,row_scores_);
+		for ( core::Size i = 1; i <= size_q; ++i ) {
+			scores_[i][j] = row_scores_[i];
 		}
 	}
 
@@ -15,6 +15,7 @@
 
 #include <utility/vector1.hh>
 
+#include <cmath>
 
 namespace protocols {
 namespace frag_picker {
@@ -40,6 +41,32 @@ void allocate_matrix(core::Size i_size,core::Size j_size,Matrix & dst) {
 	}
 }
 
+void transpose_profile(Matrix const & profile,core::Size n_columns,utility::vector1<core::Real> & columns) {
+
+	core::Size const len = profile.size();
+	columns.resize(len*n_columns);
+	for ( core::Size i = 1; i <= len; i++ ) {
+		for ( core::Size k = 1; k <= n_columns; k++ ) {
+			columns[(k-1)*len+i] = profile[i][k];
+		}
+	}
+}
+
+void l1_profile_scores(utility::vector1<core::Real> const & query_columns,core::Size query_len,
+	utility::vector1<core::Real> const & tmplt_row,core::Size n_columns,utility::vector1<core::Real> & scores) {
+
+	scores.resize(query_len);
+	core::Real * const out = scores.data();
+	std::fill(out,out+query_len,0.0);
+	for ( core::Size k = 1; k <= n_columns; k++ ) {
+		core::Real const t = tmplt_row[k];
+		core::Real const * const q = query_columns.data() + (k-1)*query_len;
+		for ( core::Size i = 0; i < query_len; i++ ) {
+			out[i] += std::abs(t - q[i]);
+		}
+	}
+}
+
 void do_one_line(core::Size start_i,core::Size start_j,Matrix & small_scores,core::Size frag_len,Matrix & frag_scores) {
 
 	core::Size stop_i = start_i + frag_len - 1;
@@ -32,6 +32,17 @@ void rolling_score(Matrix & small_scores,core::Size frag_len,Matrix & frag_score
 void create_cache(utility::vector1<core::Size> & frag_sizes,core::Size query_len,core::Size longest_vall_chunk,utility::vector1<Matrix> & cache);
 void allocate_matrix(core::Size i_size,core::Size j_size,Matrix & dst);
 
+/// @brief Stores the first n_columns columns of a profile column after column, so that
+/// column k of row i lands at columns[(k-1)*profile.size()+i]
+void transpose_profile(Matrix const & profile,core::Size n_columns,utility::vector1<core::Real> & columns);
+
+/// @brief L1 distances between a template profile row and every row of a query profile
+/// transposed by transpose_profile(); scores[i] is sum_k |tmplt_row[k] - query[i][k]|.
+/// @details The loop runs over query positions, which the compiler vectorizes, and adds
+/// the terms in the same order as a row-by-row loop over k would.
+void l1_profile_scores(utility::vector1<core::Real> const & query_columns,core::Size query_len,
+	utility::vector1<core::Real> const & tmplt_row,core::Size n_columns,utility::vector1<core::Real> & scores);
+
 
 } // scores
 } // frag_picker
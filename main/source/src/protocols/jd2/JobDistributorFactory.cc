@@ -27,6 +27,7 @@
 #include <protocols/jd2/archive/MPIArchiveJobDistributor.hh>
 
 #include <protocols/jd2/JobInputterFactory.hh>
+#include <protocols/jd2/PrefetchingJobInputter.hh>
 
 #include <protocols/jd2/JobOutputterFactory.hh>
 
@@ -133,7 +134,12 @@ JobDistributorFactory::create_job_distributor() {
 /// other stuff doesn't have to go home, but it can't live here ...
 JobInputterOP
 JobDistributorFactory::create_job_inputter() {
-	return protocols::jd2::JobInputterFactory::get_instance()->get_new_JobInputter();
+	JobInputterOP inputter( protocols::jd2::JobInputterFactory::get_instance()->get_new_JobInputter() );
+	core::Size const n_prefetch( basic::options::option[ basic::options::OptionKeys::jd2::prefetch_inputs ]() );
+	if ( n_prefetch > 0 && inputter && PrefetchingJobInputter::can_prefetch( *inputter ) ) {
+		return utility::pointer::make_shared< PrefetchingJobInputter >( inputter, n_prefetch );
+	}
+	return inputter;
 }
 
 /// @details this function handles the runtime + compiletime determination of
@@ -110,6 +110,9 @@ protected:
 
 	virtual core::Size get_nstruct() const;
 
+	/// @brief forwards get_nstruct() to the inputter it wraps
+	friend class PrefetchingJobInputter;
+
 }; // JobInputter
 
 
@@ -19,6 +19,7 @@
 #include <core/pose/Pose.hh>
 #include <core/pose/extra_pose_info_util.hh>
 #include <core/io/silent/SilentFileOptions.hh>
+#include <core/io/silent/IndexedSilentFile.hh>
 #include <basic/Tracer.hh>
 #include <basic/options/option.hh>
 #include <utility/file/FileName.hh>
@@ -59,20 +60,30 @@ protocols::jd2::LazySilentFileJobInputter::fill_jobs( JobsContainer & jobs ) {
 	utility::vector1< file::FileName > const silent_files( option[ OptionKeys::in::file::silent ]() );
 	utility::vector1<std::string> tags;
 
-	// This code appears to suggest that it will work for multiple files - alas
-	// it doesnt. It only saves the tag names not the file names so ALL the tags
-	// will be attempted to be read from the first file.
-	// I added this assert here to so that the user doesnt accidentally try
-	// feedign through multiple files.
-	runtime_assert( silent_files.size() <= 1 );
-
+	// Remember which file each tag came from, so that each job reads from its own file.
+	tag_files_.clear();
+	indexed_files_.clear();
 	for ( auto const & silent_file : silent_files ) {
 		utility::vector1< std::string > filetags;
-		//core::Size startindex = tags.size();
-		sfd_.read_tags_fast( silent_file, filetags );
+		if ( core::io::silent::IndexedSilentFile::is_indexed_silent_file( silent_file.name() ) ) {
+			core::io::silent::IndexedSilentFileOP indexed( utility::pointer::make_shared< core::io::silent::IndexedSilentFile >( silent_file.name() ) );
+			if ( !indexed->is_open() ) {
+				utility_exit_with_message( "Unable to read the index of silent file " + silent_file.name() );
+			}
+			indexed_files_[ silent_file.name() ] = indexed;
+			filetags = indexed->tags();
+		} else {
+			sfd_.read_tags_fast( silent_file, filetags );
+		}
 
 		for ( core::Size jj = 1; jj <= filetags.size(); jj++ ) {
-			tags.push_back( filetags[jj] );
+			if ( tag_files_.count( filetags[jj] ) ) {
+				tr.Warning << "Tag " << filetags[jj] << " appears in both " << tag_files_[ filetags[jj] ] << " and " << silent_file.name()
+					<< "; using the structure from " << silent_file.name() << std::endl;
+			} else {
+				tags.push_back( filetags[jj] );
+			}
+			tag_files_[ filetags[jj] ] = silent_file.name();
 		}
 	}
 
@@ -110,7 +121,15 @@ protocols::jd2::LazySilentFileJobInputter::struct_from_job( JobOP job ) {
 	utility::vector1<std::string> tag_to_read;
 	tag_to_read.push_back( job->inner_job()->input_tag());
 
-	if ( !sfd_.read_file( (option[ OptionKeys::in::file::silent ]()[1]).name(), tag_to_read ) ) {
+	auto const tag_file( tag_files_.find( tag_to_read[1] ) );
+	if ( tag_file == tag_files_.end() ) {
+		utility_exit_with_message( " job with input tag " + tag_to_read[1] + " is not in any input silent file " );
+	}
+	auto const indexed( indexed_files_.find( tag_file->second ) );
+	bool const found( indexed != indexed_files_.end() ?
+		indexed->second->read_structures( tag_to_read, sfd_, false ) :
+		sfd_.read_file( tag_file->second, tag_to_read ) );
+	if ( !found ) {
 		utility_exit_with_message(" job with input tag " + job->inner_job()->input_tag() +" can't find his input structure ");
 	}
 	return sfd_.get_structure( job->inner_job()->input_tag() );
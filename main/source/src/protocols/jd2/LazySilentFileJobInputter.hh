@@ -16,9 +16,13 @@
 #include <core/io/silent/SilentStruct.fwd.hh>
 #include <core/pose/Pose.fwd.hh>
 #include <core/io/silent/SilentFileData.hh>
+#include <core/io/silent/IndexedSilentFile.fwd.hh>
 
 #include <utility/vector1.hh>
 
+#include <map>
+#include <string>
+
 
 namespace protocols {
 namespace jd2 {
@@ -44,6 +48,13 @@ public:
 
 private:
 	core::io::silent::SilentFileData sfd_;
+
+	/// @brief The input file each tag is read from
+	std::map< std::string, std::string > tag_files_;
+
+	/// @brief One index per indexed input file, kept open across jobs so that each job
+	/// seeks straight to its structure instead of re-scanning the file.
+	std::map< std::string, core::io::silent::IndexedSilentFileOP > indexed_files_;
 };
 
 } //jd2
@@ -0,0 +1,248 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   protocols/jd2/PrefetchingJobInputter.cc
+/// @brief  a JobInputter that builds the starting poses of upcoming jobs on a background thread
+
+///Unit headers
+#include <protocols/jd2/PrefetchingJobInputter.hh>
+#include <protocols/jd2/Job.hh>
+#include <protocols/jd2/InnerJob.hh>
+#include <protocols/jd2/JobsContainer.hh>
+#include <protocols/jd2/PDBJobInputter.hh>
+#include <protocols/jd2/SilentFileJobInputter.hh>
+
+///Project headers
+#include <core/pose/Pose.hh>
+
+///Utility headers
+#include <basic/Tracer.hh>
+#include <basic/options/option.hh>
+#include <basic/options/keys/in.OptionKeys.gen.hh>
+#include <utility/exit.hh>
+
+///C++ headers
+#include <algorithm>
+#include <typeinfo>
+
+static basic::Tracer TR( "protocols.jd2.PrefetchingJobInputter" );
+
+namespace protocols {
+namespace jd2 {
+
+PrefetchingJobInputter::PrefetchingJobInputter( JobInputterOP inputter, core::Size n_prefetch ) :
+	inputter_( inputter ),
+	n_prefetch_( n_prefetch ),
+	n_prefetched_( 0 ),
+	last_index_( 0 ),
+	stride_( 1 )
+#ifdef MULTI_THREADED
+	,
+	stop_( false )
+#endif
+{
+	runtime_assert( inputter_ != nullptr );
+#ifdef MULTI_THREADED
+	if ( n_prefetch_ > 0 ) {
+		TR << "Building the starting poses of up to " << n_prefetch_ << " upcoming jobs in the background" << std::endl;
+		thread_ = std::thread( &PrefetchingJobInputter::prefetch_poses, this );
+	}
+#else
+	if ( n_prefetch_ > 0 ) {
+		TR.Warning << "Starting poses are only built in the background in multi-threaded builds" << std::endl;
+	}
+#endif
+}
+
+PrefetchingJobInputter::~PrefetchingJobInputter() {
+#ifdef MULTI_THREADED
+	{
+		std::lock_guard< std::mutex > lock( mutex_ );
+		stop_ = true;
+	}
+	queue_changed_.notify_all();
+	if ( thread_.joinable() ) thread_.join();
+#endif
+}
+
+void
+PrefetchingJobInputter::pose_from_job( core::pose::Pose & pose, JobOP job ) {
+#ifdef MULTI_THREADED
+	if ( n_prefetch_ > 0 ) {
+		PrefetchOP prefetch;
+		bool build_here( false );
+		{
+			std::unique_lock< std::mutex > lock( mutex_ );
+			auto const same_input = [&]( PrefetchOP const & p ) { return p->job->inner_job() == job->inner_job(); };
+			auto const queued( std::find_if( queue_.begin(), queue_.end(), same_input ) );
+			if ( queued != queue_.end() ) {
+				prefetch = *queued;
+				queue_.erase( queued );
+			}
+
+			auto const found( job_indices_.find( job.get() ) );
+			if ( found != job_indices_.end() ) {
+				if ( last_index_ != 0 && found->second > last_index_ ) stride_ = found->second - last_index_;
+				last_index_ = found->second;
+				queue_jobs_after( found->second, job );
+			}
+
+			if ( prefetch && ! prefetch->started ) {
+				// Not picked up yet: rather than wait, build it here.
+				prefetch->started = true;
+				build_here = true;
+			} else if ( prefetch ) {
+				queue_changed_.wait( lock, [&]{ return prefetch->done; } );
+			}
+		}
+		queue_changed_.notify_all();
+
+		if ( prefetch ) {
+			if ( build_here ) {
+				build( *prefetch );
+				prefetch->done = true;
+			}
+			if ( prefetch->error ) std::rethrow_exception( prefetch->error );
+
+			// Hand on the pose the wrapped inputter saved with its stand-in job, if it did
+			core::pose::PoseCOP const saved( prefetch->stand_in->inner_job()->get_pose() );
+			if ( saved && ! job->inner_job()->get_pose() ) load_pose_into_job( saved, job );
+			pose = *prefetch->pose;
+			++n_prefetched_;
+			TR.Debug << "filled pose of " << job->input_tag() << " from the prefetch queue" << std::endl;
+			return;
+		}
+	}
+#endif
+	inputter_->pose_from_job( pose, job );
+}
+
+void
+PrefetchingJobInputter::fill_jobs( JobsContainer & jobs ) {
+	inputter_->fill_jobs( jobs );
+	index_jobs( jobs );
+}
+
+void
+PrefetchingJobInputter::update_jobs_list( JobsContainerOP jobs ) {
+	inputter_->update_jobs_list( jobs );
+	index_jobs( *jobs );
+}
+
+bool
+PrefetchingJobInputter::updates_jobs_list() const {
+	return inputter_->updates_jobs_list();
+}
+
+JobInputterInputSource::Enum
+PrefetchingJobInputter::input_source() const {
+	return inputter_->input_source();
+}
+
+core::Size
+PrefetchingJobInputter::get_nstruct() const {
+	return inputter_->get_nstruct();
+}
+
+bool
+PrefetchingJobInputter::can_prefetch( JobInputter const & inputter ) {
+	using namespace basic::options;
+	using namespace basic::options::OptionKeys;
+
+	if ( typeid( inputter ) == typeid( SilentFileJobInputter ) ) return true;
+	if ( typeid( inputter ) == typeid( PDBJobInputter ) ) {
+		// The stepwise poses read from -s and -fasta together come from the whole command line
+		return ! ( option[ in::file::s ].user() && option[ in::file::fasta ].user() );
+	}
+	return false;
+}
+
+void
+PrefetchingJobInputter::index_jobs( JobsContainer & jobs ) {
+	utility::vector1< core::Size > indices;
+	jobs.get_loaded_job_indices( indices );
+
+#ifdef MULTI_THREADED
+	std::lock_guard< std::mutex > lock( mutex_ );
+#endif
+	jobs_.clear();
+	job_indices_.clear();
+	jobs_.resize( jobs.highest_job_index() );
+	for ( core::Size const index : indices ) {
+		if ( index > jobs_.size() ) jobs_.resize( index );
+		jobs_[ index ] = jobs[ index ];
+		job_indices_[ jobs_[ index ].get() ] = index;
+	}
+	last_index_ = 0;
+	stride_ = 1;
+	queue_.clear();
+}
+
+void
+PrefetchingJobInputter::queue_jobs_after( core::Size index, JobOP job ) {
+	// Forget the inputs of jobs that were passed over
+	queue_.remove_if( [&]( PrefetchOP const & p ) {
+		auto const found( job_indices_.find( p->job.get() ) );
+		return found == job_indices_.end() || found->second <= index;
+		} );
+
+	// The jobs of an input usually follow each other, so look as far as n_prefetch_ inputs ahead
+	core::Size const horizon( index + stride_ * n_prefetch_ * std::max< core::Size >( 1, job->inner_job()->nstruct_max() ) );
+	for ( core::Size next = index + stride_; next <= jobs_.size() && next <= horizon && queue_.size() < n_prefetch_; next += stride_ ) {
+		JobOP const & candidate( jobs_[ next ] );
+		if ( ! candidate ) continue;
+		InnerJobCOP const input( candidate->inner_job() );
+		if ( input == job->inner_job() || input->get_pose() ) continue;
+		if ( std::any_of( queue_.begin(), queue_.end(), [&]( PrefetchOP const & p ) { return p->job->inner_job() == input; } ) ) continue;
+
+		PrefetchOP prefetch( utility::pointer::make_shared< Prefetch >() );
+		prefetch->job = candidate;
+		prefetch->stand_in = utility::pointer::make_shared< Job >(
+			utility::pointer::make_shared< InnerJob >( input->input_tag(), input->nstruct_max() ), candidate->nstruct_index() );
+		queue_.push_back( prefetch );
+	}
+}
+
+void
+PrefetchingJobInputter::build( Prefetch & prefetch ) {
+	try {
+		core::pose::PoseOP pose( utility::pointer::make_shared< core::pose::Pose >() );
+		inputter_->pose_from_job( *pose, prefetch.stand_in );
+		prefetch.pose = pose;
+	} catch ( ... ) {
+		prefetch.error = std::current_exception();
+	}
+}
+
+void
+PrefetchingJobInputter::prefetch_poses() {
+#ifdef MULTI_THREADED
+	std::unique_lock< std::mutex > lock( mutex_ );
+	while ( true ) {
+		PrefetchOP next;
+		queue_changed_.wait( lock, [&]{
+			if ( stop_ ) return true;
+			auto const waiting( std::find_if( queue_.begin(), queue_.end(), []( PrefetchOP const & p ) { return ! p->started; } ) );
+			if ( waiting != queue_.end() ) next = *waiting;
+			return next != nullptr;
+			} );
+		if ( stop_ ) return;
+
+		next->started = true;
+		lock.unlock();
+		build( *next );
+		lock.lock();
+		next->done = true;
+		queue_changed_.notify_all();
+	}
+#endif
+}
+
+}//jd2
+}//protocols
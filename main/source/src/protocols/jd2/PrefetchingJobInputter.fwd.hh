@@ -0,0 +1,27 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   protocols/jd2/PrefetchingJobInputter.fwd.hh
+/// @brief  forward header for PrefetchingJobInputter
+
+#ifndef INCLUDED_protocols_jd2_PrefetchingJobInputter_fwd_hh
+#define INCLUDED_protocols_jd2_PrefetchingJobInputter_fwd_hh
+
+#include <utility/pointer/owning_ptr.hh>
+
+namespace protocols {
+namespace jd2 {
+
+class PrefetchingJobInputter;
+typedef utility::pointer::shared_ptr< PrefetchingJobInputter > PrefetchingJobInputterOP;
+
+}//jd2
+}//protocols
+
+#endif //INCLUDED_protocols_jd2_PrefetchingJobInputter_FWD_HH
@@ -0,0 +1,148 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   protocols/jd2/PrefetchingJobInputter.hh
+/// @brief  a JobInputter that builds the starting poses of upcoming jobs on a background thread
+
+
+#ifndef INCLUDED_protocols_jd2_PrefetchingJobInputter_hh
+#define INCLUDED_protocols_jd2_PrefetchingJobInputter_hh
+
+//unit headers
+#include <protocols/jd2/JobInputter.hh>
+#include <protocols/jd2/PrefetchingJobInputter.fwd.hh>
+#include <protocols/jd2/Job.fwd.hh>
+#include <protocols/jd2/JobsContainer.fwd.hh>
+
+//project headers
+#include <core/pose/Pose.fwd.hh>
+
+//utility headers
+#include <utility/vector1.hh>
+
+//C++ headers
+#include <exception>
+#include <list>
+#include <map>
+
+#ifdef MULTI_THREADED
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace protocols {
+namespace jd2 {
+
+/// @details Wraps another JobInputter.  Whenever a job asks for its starting pose, the wrapper
+/// predicts the next few jobs this process will run -- continuing the stride between the last
+/// two jobs it was asked for, so that it also follows the interleaved job ids handed out by the
+/// MPI work-pool distributors -- and has a background thread build their poses, up to
+/// n_prefetch of them, into a queue.  A job whose pose is in the queue gets it from there (waiting
+/// for it if it is still being built); any other job is passed on to the wrapped inputter.
+///
+/// The poses are built by calling pose_from_job() of the wrapped inputter on a stand-in job, so
+/// that inputter must be safe to call from two threads at once for different jobs; see
+/// can_prefetch().  An exception thrown while building a pose (e.g. for a bad input file) is
+/// thrown again, on the calling thread, to the job that asks for the pose.  Random numbers drawn
+/// while building a pose come from the background thread's generator.
+///
+/// Without MULTI_THREADED, this simply passes every call on to the wrapped inputter.
+class PrefetchingJobInputter : public protocols::jd2::JobInputter
+{
+public:
+
+	PrefetchingJobInputter( JobInputterOP inputter, core::Size n_prefetch );
+
+	/// @brief Stop the background thread, after the pose it is building, if any
+	~PrefetchingJobInputter() override;
+
+	/// @brief fill the pose from the prefetch queue if it holds the pose of the job's input,
+	/// otherwise from the wrapped inputter; then queue up the upcoming jobs
+	void pose_from_job( core::pose::Pose & pose, JobOP job ) override;
+
+	void fill_jobs( JobsContainer & jobs ) override;
+
+	void update_jobs_list( JobsContainerOP jobs ) override;
+
+	bool updates_jobs_list() const override;
+
+	JobInputterInputSource::Enum input_source() const override;
+
+	/// @brief The inputter this one wraps; code that looks for a particular kind of inputter
+	/// (e.g. with dynamic_pointer_cast) should look at this one too
+	JobInputterOP wrapped_inputter() const { return inputter_; }
+
+	core::Size n_prefetch() const { return n_prefetch_; }
+
+	/// @brief The number of poses handed out from the prefetch queue so far
+	core::Size n_prefetched() const { return n_prefetched_; }
+
+	/// @brief Can the poses of this inputter be built in the background?  True for the plain
+	/// PDBJobInputter (unless it builds stepwise poses from -fasta) and SilentFileJobInputter.
+	static bool can_prefetch( JobInputter const & inputter );
+
+protected:
+
+	core::Size get_nstruct() const override;
+
+private:
+	PrefetchingJobInputter( PrefetchingJobInputter const & ); // unimplemented -- not copyable
+	PrefetchingJobInputter & operator = ( PrefetchingJobInputter const & ); // unimplemented
+
+	/// @brief A starting pose, built or being built for a job
+	struct Prefetch {
+		JobOP job; ///< the job the pose was predicted for
+		JobOP stand_in; ///< the job the wrapped inputter builds the pose for
+		core::pose::PoseOP pose;
+		std::exception_ptr error;
+		bool started = false;
+		bool done = false;
+	};
+	typedef utility::pointer::shared_ptr< Prefetch > PrefetchOP;
+
+	/// @brief Remember the index of each job, to predict the jobs that follow
+	void index_jobs( JobsContainer & jobs );
+
+	/// @brief Drop prefetches for jobs before the one with the given index and queue up the
+	/// inputs of the jobs predicted to come after it.  Call with the lock held.
+	void queue_jobs_after( core::Size index, JobOP job );
+
+	/// @brief Build the pose of a prefetch; never throws
+	void build( Prefetch & prefetch );
+
+	/// @brief Build queued poses until stopped
+	void prefetch_poses();
+
+private:
+	JobInputterOP inputter_;
+	core::Size n_prefetch_;
+	core::Size n_prefetched_;
+
+	utility::vector1< JobOP > jobs_;
+	std::map< Job const *, core::Size > job_indices_;
+	core::Size last_index_;
+	core::Size stride_;
+
+	/// @brief prefetches in the order of the jobs they are for; at most n_prefetch_
+	std::list< PrefetchOP > queue_;
+
+#ifdef MULTI_THREADED
+	std::mutex mutex_;
+	std::condition_variable queue_changed_;
+	bool stop_;
+	std::thread thread_;
+#endif
+
+}; // PrefetchingJobInputter
+
+} // namespace jd2
+} // namespace protocols
+
+#endif //INCLUDED_protocols_jd2_PrefetchingJobInputter_HH
@@ -141,6 +141,11 @@ void SilentFileJobOutputter::set_defaults() {
 
 	//default is 1
 	n_to_buffer_ = option[ basic::options::OptionKeys::jd2::buffer_silent_output ]();
+	// each write to an indexed silent file adds an index segment, so unless told otherwise
+	// write them in blocks, to keep the number of segments small
+	if ( option[ out::file::silent_indexed ]() && ! option[ basic::options::OptionKeys::jd2::buffer_silent_output ].user() ) {
+		n_to_buffer_ = 100;
+	}
 	random_flush_frequency_ = option[ basic::options::OptionKeys::jd2::buffer_flush_frequency ]();
 
 	bWriteIntermediateFiles_ = (
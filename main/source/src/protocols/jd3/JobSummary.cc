@@ -26,9 +26,34 @@
 namespace protocols {
 namespace jd3 {
 
-JobSummary::JobSummary() = default;
+JobSummary::JobSummary() :
+	thread_index_( 0 ),
+	queue_depth_( 0 ),
+	stolen_( false ),
+	thread_steal_count_( 0 )
+{}
+
 JobSummary::~JobSummary() = default;
 
+void
+JobSummary::set_scheduling_statistics(
+	core::Size thread_index,
+	core::Size queue_depth,
+	bool stolen,
+	core::Size thread_steal_count
+)
+{
+	thread_index_ = thread_index;
+	queue_depth_ = queue_depth;
+	stolen_ = stolen;
+	thread_steal_count_ = thread_steal_count;
+}
+
+core::Size JobSummary::thread_index() const { return thread_index_; }
+core::Size JobSummary::queue_depth() const { return queue_depth_; }
+bool JobSummary::stolen() const { return stolen_; }
+core::Size JobSummary::thread_steal_count() const { return thread_steal_count_; }
+
 } // namespace jd3
 } // namespace protocols
 
@@ -38,12 +63,22 @@ JobSummary::~JobSummary() = default;
 /// @brief Automatically generated serialization method
 template< class Archive >
 void
-protocols::jd3::JobSummary::save( Archive & ) const {}
+protocols::jd3::JobSummary::save( Archive & arc ) const {
+	arc( CEREAL_NVP( thread_index_ ) ); // core::Size
+	arc( CEREAL_NVP( queue_depth_ ) ); // core::Size
+	arc( CEREAL_NVP( stolen_ ) ); // _Bool
+	arc( CEREAL_NVP( thread_steal_count_ ) ); // core::Size
+}
 
 /// @brief Automatically generated deserialization method
 template< class Archive >
 void
-protocols::jd3::JobSummary::load( Archive & ) {}
+protocols::jd3::JobSummary::load( Archive & arc ) {
+	arc( thread_index_ ); // core::Size
+	arc( queue_depth_ ); // core::Size
+	arc( stolen_ ); // _Bool
+	arc( thread_steal_count_ ); // core::Size
+}
 
 SAVE_AND_LOAD_SERIALIZABLE( protocols::jd3::JobSummary );
 CEREAL_REGISTER_TYPE( protocols::jd3::JobSummary )
@@ -50,6 +50,32 @@ public:
 	JobSummary();
 	virtual ~JobSummary();
 
+	/// @brief Record how the job was scheduled; set by JobDistributors that run jobs in
+	/// several threads, and left at zero otherwise.
+	void
+	set_scheduling_statistics(
+		core::Size thread_index,
+		core::Size queue_depth,
+		bool stolen,
+		core::Size thread_steal_count );
+
+	/// @brief The index of the thread that ran the job
+	core::Size thread_index() const;
+
+	/// @brief The number of jobs waiting to start when this job was queued
+	core::Size queue_depth() const;
+
+	/// @brief Was the job stolen from another thread's queue by an idle thread?
+	bool stolen() const;
+
+	/// @brief The number of jobs stolen by the running thread up to and including this one
+	core::Size thread_steal_count() const;
+
+private:
+	core::Size thread_index_;
+	core::Size queue_depth_;
+	bool stolen_;
+	core::Size thread_steal_count_;
 
 #ifdef    SERIALIZATION
 public:
@@ -21,6 +21,7 @@
 #include <protocols/jd3/JobDigraph.hh>
 #include <protocols/jd3/JobQueen.hh>
 #include <protocols/jd3/JobResult.hh>
+#include <protocols/jd3/JobSummary.hh>
 #include <protocols/jd3/LarvalJob.hh>
 #include <protocols/jd3/job_distributors/JobExtractor.hh>
 #include <protocols/jd3/output/OutputSpecification.hh>
@@ -49,9 +50,6 @@
 #include <string>
 #include <thread>
 
-// CTPL
-#include <CTPL/ctpl_stl.h>
-
 namespace protocols {
 namespace jd3 {
 namespace job_distributors {
@@ -72,11 +70,11 @@ MultiThreadedJobDistributor::MultiThreadedJobDistributor() :
 	}
 
 	nthreads_ = basic::options::option[ basic::options::OptionKeys::jd3::nthreads ]();
-	thread_pool_.reset( new ctpl::thread_pool( nthreads_ ) );
+	thread_pool_.reset( new WorkStealingThreadPool( nthreads_ ) );
 }
 
 MultiThreadedJobDistributor::~MultiThreadedJobDistributor() {
-	thread_pool_->stop( true );
+	thread_pool_->stop();
 }
 
 void
@@ -185,7 +183,10 @@ MultiThreadedJobDistributor::prepare_next_job( LarvalJobOP larval_job, core::Siz
 void
 MultiThreadedJobDistributor::process_completed_job( JobRunnerOP job_runner )
 {
-	TR << "Finished job " << job_runner->larval_job()->job_index() << " in thread " << job_runner->running_thread() << std::endl;
+	TaskSchedulingInfo const & scheduling = job_runner->scheduling_info();
+	TR << "Finished job " << job_runner->larval_job()->job_index() << " in thread " << scheduling.thread_index
+		<< ( scheduling.stolen ? " (stolen)" : "" ) << "; queue depth " << scheduling.queue_depth
+		<< "; " << thread_pool_->n_steals() << " steals so far" << std::endl;
 
 	LarvalJobOP larval_job = job_runner->larval_job();
 	CompletedJobOutput const & output = job_runner->job_output();
@@ -206,6 +207,10 @@ MultiThreadedJobDistributor::process_completed_job( JobRunnerOP job_runner )
 		Size job_index = larval_job->job_index();
 		job_queen_->note_job_completed_and_track( larval_job, output.status, output.job_results.size() );
 		for ( Size ii = 1; ii <= output.job_results.size(); ++ii ) {
+			if ( output.job_results[ ii ].first ) {
+				output.job_results[ ii ].first->set_scheduling_statistics( scheduling.thread_index,
+					scheduling.queue_depth, scheduling.stolen, scheduling.thread_steal_count );
+			}
 			job_queen_->completed_job_summary( larval_job, ii, output.job_results[ ii ].first );
 			job_results_[ { job_index, ii } ] = std::make_pair( larval_job, output.job_results[ ii ].second );
 		}
@@ -271,9 +276,10 @@ JobRunner::JobRunner( LarvalJobOP larval_job, JobOP mature_job, core::Size attem
 	complete_( false )
 {}
 
-void JobRunner::run( int thread_index )
+void JobRunner::run( TaskSchedulingInfo const & scheduling_info )
 {
-	running_thread_ = thread_index;
+	scheduling_info_ = scheduling_info;
+	int const thread_index( scheduling_info.thread_index );
 	// The RNG needs to be set up for the thread
 
 	basic::random::RandomGeneratorSettings rgs;
@@ -325,7 +331,9 @@ JobRunner::job_output() const { return job_result_; }
 
 bool JobRunner::complete() const { return complete_.load(); }
 
-int JobRunner::running_thread() const { return running_thread_; }
+int JobRunner::running_thread() const { return scheduling_info_.thread_index; }
+
+TaskSchedulingInfo const & JobRunner::scheduling_info() const { return scheduling_info_; }
 
 } // job_distributors
 } // jd3
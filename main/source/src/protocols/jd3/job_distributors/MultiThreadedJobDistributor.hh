@@ -31,6 +31,7 @@
 #include <protocols/jd3/JobSummary.fwd.hh>
 #include <protocols/jd3/LarvalJob.fwd.hh>
 #include <protocols/jd3/job_distributors/JobExtractor.fwd.hh>
+#include <protocols/jd3/job_distributors/WorkStealingThreadPool.hh>
 
 // Project headers
 #include <core/types.hh>
@@ -44,13 +45,17 @@
 #include <atomic>
 #include <map>
 
-// CTPL headers
-#include <CTPL/ctpl_stl.fwd.h>
-
 namespace protocols {
 namespace jd3 {
 namespace job_distributors {
 
+/// @brief Runs jd3 jobs on a WorkStealingThreadPool of -jd3::nthreads threads.
+///
+/// @details Only the running of jobs is parallel.  Jobs are matured -- their input poses,
+/// movers and ScoreFunctions built -- by the JobQueen on the master thread, one at a time,
+/// and there is no per-thread cache of input poses or ScoreFunctions; reuse of input poses
+/// is left to the JobQueen (e.g. -jd3::load_input_poses_only_once).  For very short jobs
+/// the master thread's maturation can therefore limit throughput however many threads run.
 class MultiThreadedJobDistributor : public JobDistributor {
 public:
 	typedef utility::vector1< LarvalJobOP > LarvalJobVector;
@@ -58,8 +63,6 @@ public:
 	typedef std::list< core::Size > SizeList;
 	typedef std::map< JobResultID, std::pair< LarvalJobOP, JobResultOP > > JobResultMap;
 
-	typedef utility::pointer::shared_ptr< ctpl::thread_pool > ThreadPoolOP;
-
 public:
 
 	MultiThreadedJobDistributor();
@@ -104,7 +107,7 @@ private:
 
 	Size default_retry_limit_;
 
-	ThreadPoolOP thread_pool_;
+	WorkStealingThreadPoolOP thread_pool_;
 
 };
 
@@ -113,7 +116,7 @@ public:
 	JobRunner( LarvalJobOP, JobOP, core::Size attempt_count, core::Size retry_limit );
 
 	/// @brief The main function for this unit of work.
-	void run( int thread_index );
+	void run( TaskSchedulingInfo const & scheduling_info );
 
 	bool exited_w_exception() const;
 	std::string const & exception_message() const;
@@ -124,10 +127,13 @@ public:
 	CompletedJobOutput const & job_output() const;
 	bool complete() const;
 	int running_thread() const;
+
+	/// @brief How the job was scheduled: its thread, the queue depth, and whether it was stolen
+	TaskSchedulingInfo const & scheduling_info() const;
 private:
 	core::Size attempt_count_;
 	core::Size retry_limit_;
-	int  running_thread_;
+	TaskSchedulingInfo scheduling_info_;
 
 	LarvalJobOP larval_job_;
 	JobOP       mature_job_;
@@ -0,0 +1,146 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   protocols/jd3/job_distributors/WorkStealingThreadPool.cc
+/// @brief  WorkStealingThreadPool class method definitions
+
+#ifdef MULTI_THREADED
+
+// Unit headers
+#include <protocols/jd3/job_distributors/WorkStealingThreadPool.hh>
+
+// Utility headers
+#include <utility/excn/Exceptions.hh>
+
+namespace protocols {
+namespace jd3 {
+namespace job_distributors {
+
+WorkStealingThreadPool::WorkStealingThreadPool( core::Size nthreads ) :
+	n_queued_( 0 ),
+	n_steals_( 0 ),
+	next_worker_( 0 ),
+	stopping_( false )
+{
+	if ( nthreads == 0 ) {
+		throw CREATE_EXCEPTION( utility::excn::Exception, "WorkStealingThreadPool requires at least one thread" );
+	}
+	for ( core::Size ii = 0; ii < nthreads; ++ii ) {
+		workers_.push_back( WorkerOP( new Worker ) );
+	}
+	for ( core::Size ii = 0; ii < nthreads; ++ii ) {
+		threads_.push_back( std::thread( &WorkStealingThreadPool::worker_loop, this, ii ) );
+	}
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+	stop();
+}
+
+core::Size
+WorkStealingThreadPool::push( Task task )
+{
+	core::Size depth( 0 );
+	{
+		// Counting the task before it is visible in any deque keeps n_queued_ from ever
+		// dropping below the true number of waiting tasks, and incrementing it while
+		// holding the idle mutex guarantees that a thread that has just found every deque
+		// empty cannot miss the notification below.
+		std::lock_guard< std::mutex > lock( idle_mutex_ );
+		depth = n_queued_++;
+	}
+	core::Size const target = next_worker_.fetch_add( 1 ) % workers_.size();
+	{
+		std::lock_guard< std::mutex > lock( workers_[ target ]->mutex );
+		workers_[ target ]->tasks.emplace_back( std::move( task ), depth );
+	}
+	idle_cv_.notify_one();
+	return depth;
+}
+
+core::Size WorkStealingThreadPool::nthreads() const { return workers_.size(); }
+
+core::Size WorkStealingThreadPool::n_queued() const { return n_queued_.load(); }
+
+core::Size WorkStealingThreadPool::n_steals() const { return n_steals_.load(); }
+
+void
+WorkStealingThreadPool::stop()
+{
+	{
+		std::lock_guard< std::mutex > lock( idle_mutex_ );
+		if ( stopping_ ) return;
+		stopping_ = true;
+	}
+	idle_cv_.notify_all();
+	for ( std::thread & thread : threads_ ) {
+		if ( thread.joinable() ) thread.join();
+	}
+}
+
+void
+WorkStealingThreadPool::worker_loop( core::Size thread_index )
+{
+	while ( true ) {
+		Task task;
+		TaskSchedulingInfo info;
+		if ( take_task( thread_index, task, info ) ) {
+			task( info );
+			continue;
+		}
+
+		std::unique_lock< std::mutex > lock( idle_mutex_ );
+		idle_cv_.wait( lock, [this] { return stopping_ || n_queued_.load() != 0; } );
+		if ( stopping_ && n_queued_.load() == 0 ) return;
+	}
+}
+
+bool
+WorkStealingThreadPool::take_task( core::Size thread_index, Task & task, TaskSchedulingInfo & info )
+{
+	info.thread_index = thread_index;
+	Worker & self( *workers_[ thread_index ] );
+
+	// Newest work first from our own deque ...
+	{
+		std::lock_guard< std::mutex > lock( self.mutex );
+		if ( ! self.tasks.empty() ) {
+			task = std::move( self.tasks.back().first );
+			info.queue_depth = self.tasks.back().second;
+			self.tasks.pop_back();
+			--n_queued_;
+			info.stolen = false;
+			info.thread_steal_count = self.n_steals;
+			return true;
+		}
+	}
+
+	// ... then the oldest work from everyone else's.
+	for ( core::Size offset = 1; offset < workers_.size(); ++offset ) {
+		Worker & victim( *workers_[ ( thread_index + offset ) % workers_.size() ] );
+		std::lock_guard< std::mutex > lock( victim.mutex );
+		if ( victim.tasks.empty() ) continue;
+		task = std::move( victim.tasks.front().first );
+		info.queue_depth = victim.tasks.front().second;
+		victim.tasks.pop_front();
+		--n_queued_;
+		++n_steals_;
+		info.stolen = true;
+		info.thread_steal_count = ++self.n_steals;
+		return true;
+	}
+	return false;
+}
+
+} // job_distributors
+} // jd3
+} // protocols
+
+#endif // MULTI_THREADED
@@ -0,0 +1,129 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   protocols/jd3/job_distributors/WorkStealingThreadPool.hh
+/// @brief  A fixed-size thread pool with one task deque per thread, where idle threads
+/// steal work from the deques of busy threads.
+
+#ifndef INCLUDED_protocols_jd3_job_distributors_WorkStealingThreadPool_HH
+#define INCLUDED_protocols_jd3_job_distributors_WorkStealingThreadPool_HH
+
+#ifdef MULTI_THREADED
+
+// Unit headers
+#include <protocols/jd3/job_distributors/WorkStealingThreadPool.fwd.hh>
+
+// Project headers
+#include <core/types.hh>
+
+// Utility headers
+#include <utility/vector0.hh>
+
+// C++ headers
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace protocols {
+namespace jd3 {
+namespace job_distributors {
+
+/// @brief Scheduling statistics for a single task, reported to the task when it starts
+struct TaskSchedulingInfo
+{
+	/// @brief The (0-based) index of the thread running the task
+	core::Size thread_index = 0;
+
+	/// @brief The number of tasks waiting in all of the deques when this task was pushed
+	core::Size queue_depth = 0;
+
+	/// @brief Was the task taken from the deque of some other thread?
+	bool stolen = false;
+
+	/// @brief The number of tasks the running thread has stolen so far, this one included
+	core::Size thread_steal_count = 0;
+};
+
+/// @brief The %WorkStealingThreadPool runs tasks on a fixed set of threads, each of which
+/// owns a deque of tasks.
+///
+/// @details Tasks are pushed onto the deques in round-robin order.  A thread takes work
+/// from the back of its own deque and, when that is empty, steals from the front of the
+/// deque of another thread, so no thread sits idle while any task is waiting, and a burst
+/// of short tasks does not funnel through a single shared queue.  Threads with nothing to
+/// do sleep on a condition variable rather than spinning.  Each deque has its own mutex;
+/// with jobs lasting milliseconds or more, the cost of that lock is negligible next to
+/// the cost of the contention on one global queue that it replaces.
+class WorkStealingThreadPool
+{
+public:
+	typedef std::function< void ( TaskSchedulingInfo const & ) > Task;
+
+public:
+	explicit WorkStealingThreadPool( core::Size nthreads );
+
+	/// @brief Finishes every task that has already been pushed and joins the threads
+	~WorkStealingThreadPool();
+
+	WorkStealingThreadPool( WorkStealingThreadPool const & ) = delete;
+	WorkStealingThreadPool & operator = ( WorkStealingThreadPool const & ) = delete;
+
+	/// @brief Queue a task; returns the number of tasks that were already waiting
+	core::Size push( Task task );
+
+	core::Size nthreads() const;
+
+	/// @brief The number of tasks waiting to be started
+	core::Size n_queued() const;
+
+	/// @brief The total number of tasks stolen by all threads
+	core::Size n_steals() const;
+
+	/// @brief Finish every task that has already been pushed and join the threads.
+	/// No tasks may be pushed afterwards.
+	void stop();
+
+private:
+	struct Worker
+	{
+		std::mutex mutex;
+		std::deque< std::pair< Task, core::Size > > tasks; // task, queue depth at push
+		core::Size n_steals = 0; // only touched by the owning thread
+	};
+
+	typedef std::unique_ptr< Worker > WorkerOP;
+
+	void worker_loop( core::Size thread_index );
+
+	bool take_task( core::Size thread_index, Task & task, TaskSchedulingInfo & info );
+
+private:
+	utility::vector0< WorkerOP > workers_;
+	utility::vector0< std::thread > threads_;
+
+	std::atomic< core::Size > n_queued_;
+	std::atomic< core::Size > n_steals_;
+	std::atomic< core::Size > next_worker_;
+
+	std::mutex idle_mutex_;
+	std::condition_variable idle_cv_;
+	bool stopping_;
+};
+
+} // job_distributors
+} // jd3
+} // protocols
+
+#endif // MULTI_THREADED
+
+#endif // INCLUDED_protocols_jd3_job_distributors_WorkStealingThreadPool_HH
@@ -156,7 +156,8 @@ LoopHashPerturber::get_random_backbone_segments(core::pose::Pose const&,
 	core::Size loop_size = loophash_fragment_end - loophash_fragment_start + 1;
 	LoopHashMap & hashmap = lh_library_->gethash(loop_size);
 
-	core::Size frag_index = numeric::random::random_range(0, hashmap.n_loops() - 1);
+	// With -lh:mmap_db the map holds every leap in the file, not just those loaded by this process
+	core::Size frag_index = hashmap.random_loaded_leap();
 
 	bb_segs_.clear();
 	bb_segs_.push_back(extract_fragment(frag_index, loop_size));
@@ -26,8 +26,10 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <cstring>
 
 #include <protocols/frag_picker/VallChunk.hh>
+#include <utility/io/MappedFile.hh>
 #include <utility/vector1.hh>
 
 
@@ -42,6 +44,26 @@ namespace loophash {
 
 static basic::Tracer TR( "BackboneDB" );
 
+namespace {
+
+/// @brief Leading block of a binary backbone database.  It is followed by the per-protein
+/// offset arrays (uint64, n_proteins + 1 each: angles, pdb ids, sequences, rotamers), then
+/// the rotamers (int32), the angles (int16), the pdb id characters and the sequence characters.
+struct BinaryBackboneDBHeader {
+	char magic[ 8 ];
+	boost::uint64_t byte_order;
+	boost::uint64_t n_proteins;
+	boost::uint64_t n_angles;
+	boost::uint64_t n_pdb_chars;
+	boost::uint64_t n_sequence_chars;
+	boost::uint64_t n_rotamers;
+};
+
+char const BINARY_BBDB_MAGIC[ 8 ] = { 'L', 'H', 'B', 'B', 'D', 'B', '0', '1' };
+boost::uint64_t const BINARY_DB_BYTE_ORDER = 0x0102030405060708ULL;
+
+}
+
 short RealAngleToShort( core::Real angle ){
 	while ( angle > 180.0 ) angle -= 360.0;
 	while ( angle <-180.0 ) angle += 360.0;
@@ -229,6 +251,12 @@ core::Real get_rmsd( const BackboneSegment &bs1, const BackboneSegment &bs2 ){
 core::Real
 BackboneDB::angle( core::Size index, core::Size offset ) const
 {
+	if ( mapped_ ) {
+		core::Size n_angles;
+		short const * angles = mapped_angles( index, n_angles );
+		if ( offset >= n_angles ) utility_exit_with_message( "Out of bounds error" );
+		return ShortToRealAngle( angles[ offset ] );
+	}
 	if ( index >= data_.size() ) utility_exit_with_message( "Out of bounds error" );
 	if ( offset >= data_[index].angles.size() ) utility_exit_with_message( "Out of bounds error" );
 
@@ -238,6 +266,7 @@ BackboneDB::angle( core::Size index, core::Size offset ) const
 void
 BackboneDB::add_pose( const core::pose::Pose &pose, core::Size nres, core::Size &index, protocols::frag_picker::VallChunkOP chunk )
 {
+	if ( mapped_ ) utility_exit_with_message( "Cannot add proteins to a memory-mapped BackboneDB" );
 	if ( ! extra_ ) extra_ = true;
 	index = data_.size(); // Index of protein
 	BBData new_protein;
@@ -264,19 +293,36 @@ BackboneDB::add_pose( const core::pose::Pose &pose, core::Size nres, core::Size
 
 // Maybe I should just overload the copy operator in the struct..
 void BackboneDB::get_protein( core::Size index, BBData & protein ) const {
+	if ( mapped_ ) {
+		core::Size n_angles;
+		short const * angles = mapped_angles( index, n_angles );
+		protein.extra_key = index;
+		protein.angles.assign( angles, angles + n_angles );
+		return;
+	}
 	protein.extra_key = data_[index].extra_key;
 	protein.angles = data_[index].angles;
 }
 
 void BackboneDB::get_extra_data( core::Size index, BBExtraData & extra ) const {
+	if ( mapped_ ) {
+		if ( index >= mapped_size_ ) utility_exit_with_message( "Out of bounds error" );
+		core::Size const protein = mapped_begin_ + index;
+		extra.pdb_id.assign( pdb_ids_ + pdb_offsets_[ protein ], pdb_ids_ + pdb_offsets_[ protein + 1 ] );
+		extra.sequence.assign( sequences_ + sequence_offsets_[ protein ], sequences_ + sequence_offsets_[ protein + 1 ] );
+		extra.rotamer_id.assign( rotamers_ + rotamer_offsets_[ protein ], rotamers_ + rotamer_offsets_[ protein + 1 ] );
+		return;
+	}
 	extra = extra_data_[index];
 }
 
 void BackboneDB::add_protein( BBData new_protein ) {
+	if ( mapped_ ) utility_exit_with_message( "Cannot add proteins to a memory-mapped BackboneDB" );
 	data_.push_back( new_protein );
 }
 
 void BackboneDB::add_extra_data( BBExtraData extra ) {
+	if ( mapped_ ) utility_exit_with_message( "Cannot add proteins to a memory-mapped BackboneDB" );
 	if ( ! extra_ ) extra_ = true;
 	extra_data_.push_back( extra );
 }
@@ -293,6 +339,18 @@ BackboneDB::get_backbone_segment(
 	std::vector<core::Real> psi;
 	std::vector<core::Real> omega;
 	core::Size pos = offset;
+	if ( mapped_ ) {
+		core::Size n_angles;
+		short const * angles = mapped_angles( index, n_angles );
+		if ( offset + 3 * len > n_angles ) utility_exit_with_message( "Out of bounds error" );
+		for ( core::Size i = 0; i < len; i++ ) {
+			phi.push_back( ShortToRealAngle( angles[pos] ) ); pos ++ ;
+			psi.push_back( ShortToRealAngle( angles[pos] ) ); pos ++ ;
+			omega.push_back( ShortToRealAngle( angles[pos] ) ); pos ++ ;
+		}
+		bs = BackboneSegment( phi, psi, omega );
+		return;
+	}
 	for ( core::Size i = 0; i < len; i++ ) {
 		phi.push_back( ShortToRealAngle(data_[index].angles[pos]) ); pos ++ ;
 		psi.push_back( ShortToRealAngle(data_[index].angles[pos]) ); pos ++ ;
@@ -448,6 +506,139 @@ BackboneDB::read_db( std::string filename, bool load_extra,
 	file.close();
 }
 
+void BackboneDB::write_binary_db( std::string const & filename ) const
+{
+	if ( mapped_ ) utility_exit_with_message( "BackboneDB was read from binary file " + mapped_->filename() + " already" );
+	if ( data_.size() != 0 && ! extra_ ) throw CREATE_EXCEPTION(EXCN_No_Extra_Data_To_Write, "");
+
+	core::Size const n = data_.size();
+	std::vector< boost::uint64_t > angle_offsets( 1, 0 ), pdb_offsets( 1, 0 ), sequence_offsets( 1, 0 ), rotamer_offsets( 1, 0 );
+	std::vector< boost::int32_t > rotamers;
+	std::vector< short > angles;
+	std::string pdb_ids, sequences;
+	for ( auto const & protein : data_ ) {
+		BBExtraData const & extra = extra_data_[ protein.extra_key ];
+		angles.insert( angles.end(), protein.angles.begin(), protein.angles.end() );
+		pdb_ids += extra.pdb_id;
+		sequences += extra.sequence;
+		rotamers.insert( rotamers.end(), extra.rotamer_id.begin(), extra.rotamer_id.end() );
+		angle_offsets.push_back( angles.size() );
+		pdb_offsets.push_back( pdb_ids.size() );
+		sequence_offsets.push_back( sequences.size() );
+		rotamer_offsets.push_back( rotamers.size() );
+	}
+
+	BinaryBackboneDBHeader header;
+	std::memcpy( header.magic, BINARY_BBDB_MAGIC, sizeof( header.magic ) );
+	header.byte_order = BINARY_DB_BYTE_ORDER;
+	header.n_proteins = n;
+	header.n_angles = angles.size();
+	header.n_pdb_chars = pdb_ids.size();
+	header.n_sequence_chars = sequences.size();
+	header.n_rotamers = rotamers.size();
+
+	std::ofstream file( filename.c_str(), std::ios::binary );
+	if ( !file ) throw CREATE_EXCEPTION(EXCN_DB_IO_Failed,  filename, "write" );
+	file.write( reinterpret_cast< char const * >( &header ), sizeof( header ) );
+	for ( std::vector< boost::uint64_t > const * offsets : { &angle_offsets, &pdb_offsets, &sequence_offsets, &rotamer_offsets } ) {
+		file.write( reinterpret_cast< char const * >( offsets->data() ), offsets->size() * sizeof( boost::uint64_t ) );
+	}
+	file.write( reinterpret_cast< char const * >( rotamers.data() ), rotamers.size() * sizeof( boost::int32_t ) );
+	file.write( reinterpret_cast< char const * >( angles.data() ), angles.size() * sizeof( short ) );
+	file.write( pdb_ids.data(), pdb_ids.size() );
+	file.write( sequences.data(), sequences.size() );
+	if ( !file ) throw CREATE_EXCEPTION(EXCN_DB_IO_Failed,  filename, "write" );
+	file.close();
+	TR.Info << "Wrote " << n << " proteins to " << filename << std::endl;
+}
+
+void
+BackboneDB::read_binary_db( std::string const & filename, bool /*load_extra*/,
+	core::Size num_partitions, core::Size assigned_num,
+	std::pair< core::Size, core::Size > & loopdb_range,
+	std::map< core::Size, bool > & homolog_index )
+{
+	utility::io::MappedFileOP file( new utility::io::MappedFile );
+	if ( !file->open( filename ) ) throw CREATE_EXCEPTION(EXCN_DB_IO_Failed,  filename, "read" );
+
+	BinaryBackboneDBHeader header;
+	if ( file->size() < sizeof( header ) ) throw CREATE_EXCEPTION(EXCN_Wrong_DB_Format,  filename );
+	std::memcpy( &header, file->data(), sizeof( header ) );
+	core::Size const n = header.n_proteins;
+	core::Size const offsets_size = 4 * ( n + 1 ) * sizeof( boost::uint64_t );
+	if ( std::memcmp( header.magic, BINARY_BBDB_MAGIC, sizeof( header.magic ) ) != 0
+			|| header.byte_order != BINARY_DB_BYTE_ORDER
+			|| file->size() != sizeof( header ) + offsets_size + header.n_rotamers * sizeof( boost::int32_t )
+			+ header.n_angles * sizeof( short ) + header.n_pdb_chars + header.n_sequence_chars ) {
+		throw CREATE_EXCEPTION(EXCN_Wrong_DB_Format,  filename );
+	}
+
+	char const * pos = file->data() + sizeof( header );
+	auto const * angle_offsets = reinterpret_cast< boost::uint64_t const * >( pos ); pos += ( n + 1 ) * sizeof( boost::uint64_t );
+	auto const * pdb_offsets = reinterpret_cast< boost::uint64_t const * >( pos ); pos += ( n + 1 ) * sizeof( boost::uint64_t );
+	auto const * sequence_offsets = reinterpret_cast< boost::uint64_t const * >( pos ); pos += ( n + 1 ) * sizeof( boost::uint64_t );
+	auto const * rotamer_offsets = reinterpret_cast< boost::uint64_t const * >( pos ); pos += ( n + 1 ) * sizeof( boost::uint64_t );
+	if ( angle_offsets[ n ] != header.n_angles || pdb_offsets[ n ] != header.n_pdb_chars
+			|| sequence_offsets[ n ] != header.n_sequence_chars || rotamer_offsets[ n ] != header.n_rotamers ) {
+		throw CREATE_EXCEPTION(EXCN_Wrong_DB_Format,  filename );
+	}
+
+	char const * pdb_ids = pos + header.n_rotamers * sizeof( boost::int32_t ) + header.n_angles * sizeof( short );
+
+	// the same partitioning as read_db, which counts four lines per protein
+	core::Size begin = assigned_num * n / num_partitions;
+	core::Size end = ( assigned_num + 1 ) * n / num_partitions;
+	loopdb_range.first = begin;
+	loopdb_range.second = end;
+	TR.Info << "Mapping proteins " << begin << " to " << end << " out of " << n << " , partition: "  << assigned_num+1 << "/"<< num_partitions << std::endl;
+
+	if ( option[ lh::exclude_homo ]() ) {
+		TR << "Reading in homolog file" << std::endl;
+		read_homologs();
+		for ( core::Size i = begin; i < end; ++i ) {
+			std::string pdb_id( pdb_ids + pdb_offsets[ i ], pdb_ids + pdb_offsets[ i + 1 ] );
+			if ( homologs_.find( pdb_id ) == homologs_.end() ) continue;
+			homolog_index[ i - begin ] = true;
+			TR << "Homolog " << pdb_id << " rejected." << std::endl;
+		}
+	}
+
+	data_.clear();
+	extra_data_.clear();
+	extra_ = true;
+	angle_offsets_ = angle_offsets;
+	pdb_offsets_ = pdb_offsets;
+	sequence_offsets_ = sequence_offsets;
+	rotamer_offsets_ = rotamer_offsets;
+	rotamers_ = reinterpret_cast< boost::int32_t const * >( pos );
+	angles_ = reinterpret_cast< short const * >( pos + header.n_rotamers * sizeof( boost::int32_t ) );
+	pdb_ids_ = pdb_ids;
+	sequences_ = pdb_ids + header.n_pdb_chars;
+	mapped_begin_ = begin;
+	mapped_size_ = end - begin;
+	mapped_homologs_ = homolog_index;
+	mapped_ = file;
+
+	TR.Info << ( file->is_mapped() ? "Mapped " : "Read " ) << n << " proteins from " << filename << std::endl;
+}
+
+short const *
+BackboneDB::mapped_angles( core::Size index, core::Size & n_angles ) const
+{
+	if ( index >= mapped_size_ ) utility_exit_with_message( "Out of bounds error" );
+	core::Size const protein = mapped_begin_ + index;
+	// homologs keep their index but have no angles, as in read_db
+	n_angles = mapped_homologs_.count( index ) ? 0 : angle_offsets_[ protein + 1 ] - angle_offsets_[ protein ];
+	return angles_ + angle_offsets_[ protein ];
+}
+
+core::Size
+BackboneDB::get_mem_foot_print() const
+{
+	if ( mapped_ ) return mapped_->size() + sizeof(BackboneDB);
+	return data_.size() * sizeof( BBData ) + data_.size() * sizeof( BBExtraData ) + sizeof(BackboneDB);
+}
+
 void BackboneDB::read_homologs()
 {
 	std::ifstream file( option[ lh::homo_file ]().c_str() );
@@ -26,6 +26,7 @@
 #include <protocols/frag_picker/VallChunk.hh>
 #include <utility/vector1.hh>
 #include <numeric/geometry/BoundingBox.fwd.hh>
+#include <utility/io/MappedFile.fwd.hh>
 
 //numeric headers
 #include <numeric/geometry/hashing/SixDHasher.fwd.hh>
@@ -104,6 +105,10 @@ private:
 core::Real get_rmsd( const BackboneSegment &bs1, const BackboneSegment &bs2 );
 
 
+/// @details The backbone database is either read from text into data_ and extra_data_, or
+/// (read_binary_db) mapped from a binary file and read in place.  A mapped database holds one
+/// partition of the proteins in the file, is indexed relative to the start of that partition
+/// like one read with read_db, and is read-only.
 class BackboneDB
 {
 public:
@@ -130,8 +135,10 @@ public:
 		BackboneSegment &bs
 	) const;
 
-	core::Size size() const { return data_.size(); }
-	core::Size extra_size() const { return extra_data_.size(); }
+	core::Size size() const { return mapped_ ? mapped_size_ : data_.size(); }
+	core::Size extra_size() const { return mapped_ ? mapped_size_ : extra_data_.size(); }
+
+	bool is_mapped() const { return mapped_ != nullptr; }
 
 	// Only supports writing to text, extra data is mandatory
 	void write_db( std::string filename ) const;
@@ -150,16 +157,29 @@ public:
 		read_db( filename, load_extra, 1, 0, range, homolog_index );
 	}
 
+	// Writes the proteins and their extra data to a binary file that read_binary_db maps
+	void write_binary_db( std::string const & filename ) const;
+
+	// Maps a file written by write_binary_db, with the same partitioning and homolog
+	// exclusion as read_db. Extra data is always available from the mapping.
+	void read_binary_db( std::string const & filename, bool load_extra,
+		core::Size num_partitions, core::Size assigned_num,
+		std::pair< core::Size, core::Size > & loop_range,
+		std::map< core::Size, bool > & homolog_index );
+
 	// For backwards compatability
 	void read_legacydb( std::string filename );
 
 	// Reads in homologs into homologs_
 	void read_homologs();
 
-	core::Size get_mem_foot_print() const { return data_.size() * sizeof( BBData ) + data_.size() * sizeof( BBExtraData ) + sizeof(BackboneDB); };
+	core::Size get_mem_foot_print() const;
 
 private:
 
+	/// @brief The angles of a mapped protein; none for a homolog
+	short const * mapped_angles( core::Size index, core::Size & n_angles ) const;
+
 	// Gonna change this to a vector of BBData structs, one for each protein
 	// This obviously introduces overhead, but minimal (~2MB), and it makes it easier to store
 	// other info as well as sort the database
@@ -176,6 +196,23 @@ private:
 	/// @brief Homology map, contains all homologs
 	std::map< std::string, bool >             homologs_;
 
+	/// @brief The binary file backing a mapped database, and the partition of it that is loaded
+	utility::io::MappedFileCOP mapped_;
+	core::Size mapped_begin_ = 0;
+	core::Size mapped_size_ = 0;
+	std::map< core::Size, bool > mapped_homologs_;
+
+	/// @brief Per-protein offsets into the flat arrays below, n_proteins + 1 each
+	boost::uint64_t const * angle_offsets_ = nullptr;
+	boost::uint64_t const * pdb_offsets_ = nullptr;
+	boost::uint64_t const * sequence_offsets_ = nullptr;
+	boost::uint64_t const * rotamer_offsets_ = nullptr;
+
+	boost::int32_t const * rotamers_ = nullptr;
+	short const * angles_ = nullptr;
+	char const * pdb_ids_ = nullptr;
+	char const * sequences_ = nullptr;
+
 };
 
 
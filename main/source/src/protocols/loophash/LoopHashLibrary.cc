@@ -219,20 +219,49 @@ LoopHashLibrary::load_mergeddb()
 	TR.Info << std::endl;
 	// Indices of homologs is returned in homolog_map
 	std::map< core::Size, bool > homolog_map;
-	std::string db_filename = db_path_ + "backbone.db";
+	// The binary database is mapped rather than read, so the processes on a node share one copy
+	bool const mmap_db = basic::options::option[ basic::options::OptionKeys::lh::mmap_db ]();
+	std::string const extension = mmap_db ? ".bin" : ".db";
+	std::string db_filename = db_path_ + "backbone" + extension;
 	TR.Info << "Reading " << db_filename << std::endl;
-	bbdb_.read_db( db_filename, extra_, num_partitions_, assigned_num_, loopdb_range_, homolog_map );
+	if ( mmap_db ) {
+		bbdb_.read_binary_db( db_filename, extra_, num_partitions_, assigned_num_, loopdb_range_, homolog_map );
+	} else {
+		bbdb_.read_db( db_filename, extra_, num_partitions_, assigned_num_, loopdb_range_, homolog_map );
+	}
 	for ( std::vector< core::Size >::const_iterator it = hash_sizes_.begin(); it != hash_sizes_.end(); ++it ) {
 		TR.Info << "Reading loopdb (LoopHashDatabase) " << assigned_string_ << " with loop size " << *it << std::endl;
 		// pass the range to the loophashmap so it knows which loops to read
 		// also pass the map of homologs
-		db_filename = db_path_ + "loopdb." + utility::to_string( *it ) + ".db";
-		hash_[ *it ].read_db(db_filename, loopdb_range_, homolog_map );
+		db_filename = db_path_ + "loopdb." + utility::to_string( *it ) + extension;
+		if ( mmap_db ) {
+			hash_[ *it ].read_binary_db( db_filename, loopdb_range_, homolog_map );
+		} else {
+			hash_[ *it ].read_db( db_filename, loopdb_range_, homolog_map );
+		}
 	}
 	long endtime = time(nullptr);
 	TR << "Read MergedLoopHash Library from disk: " << endtime - starttime << " seconds " << std::endl;
 }
 
+void
+LoopHashLibrary::save_binary_db() const
+{
+	// A partition, or a database with its homologs excluded, is missing proteins and loops
+	if ( num_partitions_ > 1 || basic::options::option[ basic::options::OptionKeys::lh::exclude_homo ]() ) {
+		utility_exit_with_message( "The binary loophash database must be written from the whole merged database: do not use -lh:num_partitions or -lh:exclude_homo" );
+	}
+	long starttime = time(nullptr);
+	TR.Info << "Saving bbdb_ (BackboneDatabase) in binary" << std::endl;
+	bbdb_.write_binary_db( db_path_ + "backbone.bin" );
+	for ( core::Size hash_size : hash_sizes_ ) {
+		TR.Info << "Saving loopdb (LoopHashDatabase) in binary with loop size " << hash_size << std::endl;
+		hash_.find( hash_size )->second.write_binary_db( db_path_ + "loopdb." + utility::to_string( hash_size ) + ".bin" );
+	}
+	long endtime = time(nullptr);
+	TR << "Save binary LoopHash Library: " << endtime - starttime << " seconds " << std::endl;
+}
+
 
 void
 LoopHashLibrary::merge(
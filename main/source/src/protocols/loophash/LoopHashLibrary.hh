@@ -111,10 +111,15 @@ public:
 	/// when created merged text db.
 	void load_db();
 
-	/// @details Only support reading from merged text.  Extra data is optional
-	/// and handled by extra_.
+	/// @details Reads from merged text, or with -lh:mmap_db maps the binary
+	/// files written by save_binary_db().  Extra data is optional and handled by
+	/// extra_.
 	void load_mergeddb();
 
+	/// @details Writes the merged database, loaded whole by load_mergeddb(), as
+	/// backbone.bin and loopdb.<size>.bin in db_path.
+	void save_binary_db() const;
+
 	// For backwards-compability
 	//void load_legacydb();
 
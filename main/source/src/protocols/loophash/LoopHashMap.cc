@@ -36,13 +36,19 @@
 #include <utility/excn/Exceptions.hh>
 #include <utility/exit.hh>
 #include <utility/fixedsizearray1.hh>
+#include <utility/io/MappedFile.hh>
 #include <utility/pointer/owning_ptr.hh>
+#include <utility/string_util.hh>
 
 #include <numeric/angle.functions.hh>
 #include <numeric/geometry/hashing/SixDHasher.hh>
+#include <numeric/random/random.hh>
 
 // C++ headers
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
+#include <limits>
 
 #include <iostream>
 #include <fstream>
@@ -74,6 +80,22 @@ namespace loophash {
 
 static basic::Tracer TR( "LoopHashMap" );
 
+namespace {
+
+/// @brief Leading block of a binary loop hash map.  It is followed by n_leaps sorted keys
+/// (uint64) and then n_leaps (index, offset) pairs (uint32).
+struct BinaryLoopDBHeader {
+	char magic[ 8 ];
+	boost::uint64_t byte_order;
+	boost::uint64_t loop_size;
+	boost::uint64_t n_leaps;
+};
+
+char const BINARY_LOOPDB_MAGIC[ 8 ] = { 'L', 'H', 'M', 'A', 'P', '0', '1', '\0' };
+boost::uint64_t const BINARY_DB_BYTE_ORDER = 0x0102030405060708ULL;
+
+}
+
 
 /// @brief This takes a pose and two residue positions and determines the rigid body transform of the Leap described by those two residues.
 ///        Returns true is successful or false if something went haywire and one should just ignore this loop (this can happen at the ends)
@@ -359,17 +381,29 @@ LoopHashMap & LoopHashMap::operator=(LoopHashMap const & other)
 		backbone_index_map_ = other.backbone_index_map_;
 		loopdb_ = other.loopdb_;
 		loop_size_ = other.loop_size_;
+		mapped_ = other.mapped_;
+		keys_ = other.keys_;
+		leaps_ = other.leaps_;
+		n_mapped_ = other.n_mapped_;
+		mapped_range_ = other.mapped_range_;
+		mapped_homologs_ = other.mapped_homologs_;
 	}
 	return *this;
 
 }
 
 void LoopHashMap::mem_foot_print() const {
+	if ( keys_ ) {
+		TR << "mapped leaps: " << n_mapped_ << " Size (shared): " << mapped_->size() << std::endl;
+		return;
+	}
 	TR << "loopdb_: " << loopdb_.size() << " Size: " << loopdb_.size() * sizeof( LeapIndex ) << std::endl;
 	TR << "BackboneIndexMap: " << backbone_index_map_.size() << " Size: " << backbone_index_map_.size() * (sizeof(boost::uint64_t) + sizeof(core::Size) ) << std::endl;
 }
 
 void LoopHashMap::sort() {
+	// mapped leaps are read-only, and stay sorted by key
+	if ( keys_ ) return;
 	std::sort( loopdb_.begin(), loopdb_.end(), [] (LeapIndex const & a, LeapIndex const & b) { return a.index < b.index; } );
 }
 
@@ -443,6 +477,7 @@ LoopHashMap::add_legacyleap( const LegacyLeapIndex & legacyleap_index)
 }
 
 void LoopHashMap::add_leap( const LeapIndex &leap_index, boost::uint64_t key ) {
+	if ( keys_ ) utility_exit_with_message( "Cannot add leaps to a memory-mapped LoopHashMap" );
 	core::Size cpindex = loopdb_.size();
 	loopdb_.push_back( leap_index );
 	// No check to see if it is in hash because this data is already processed
@@ -450,6 +485,7 @@ void LoopHashMap::add_leap( const LeapIndex &leap_index, boost::uint64_t key ) {
 }
 
 void LoopHashMap::add_leap( const LeapIndex &leap_index, numeric::geometry::hashing::Real6 & transform ){
+	if ( keys_ ) utility_exit_with_message( "Cannot add leaps to a memory-mapped LoopHashMap" );
 	core::Size cpindex = loopdb_.size();
 	loopdb_.push_back( leap_index );
 	numeric::geometry::hashing::Real6 rt_6;
@@ -491,6 +527,7 @@ LoopHashMap::bbdb_range(
 	std::pair< BackboneIndexMap::const_iterator, BackboneIndexMap::const_iterator > & range
 ) const
 {
+	if ( keys_ ) utility_exit_with_message( "bbdb_range() is not available for a memory-mapped LoopHashMap" );
 	range.first = backbone_index_map_.begin();
 	range.second = backbone_index_map_.end();
 }
@@ -512,6 +549,11 @@ LoopHashMap::lookup(
 	transform[5] = numeric::nonnegative_principal_angle_degrees(transform[5] );
 	boost::uint64_t bin_index = hash_->bin_index( transform );
 
+	if ( keys_ ) {
+		mapped_lookup( bin_index, result );
+		return;
+	}
+
 	// now get an iterator over that map entry
 
 	TR.Info << "backbone bucket size:  " << backbone_index_map_.bucket_count() << std::endl;
@@ -540,6 +582,11 @@ void LoopHashMap::radial_lookup(
 	//TR.Info << "center:  " << center[4] << " " << center[5] << std::endl;
 	std::vector< boost::uint64_t > bin_index_vec = hash_->radial_bin_index( radius, center );
 
+	if ( keys_ ) {
+		for ( boost::uint64_t bin : bin_index_vec ) mapped_lookup( bin, result );
+		return;
+	}
+
 	for ( auto & i : bin_index_vec ) {
 		//TR.Info << "bin_index_vec[i]:  " << bin_index_vec[i] << std::endl;
 		// now get an iterator over that map entry
@@ -558,6 +605,11 @@ Size LoopHashMap::radial_count( core::Size radius, numeric::geometry::hashing::R
 	center[5] = numeric::nonnegative_principal_angle_degrees(center[5] );
 	std::vector< boost::uint64_t > bin_index_vec = hash_->radial_bin_index( radius, center );
 	Size count = 0;
+	if ( keys_ ) {
+		std::vector< core::Size > positions;
+		for ( boost::uint64_t bin : bin_index_vec ) mapped_lookup( bin, positions );
+		return positions.size();
+	}
 	for ( auto & i : bin_index_vec ) {
 		count += backbone_index_map_.count( i );
 	}
@@ -570,6 +622,7 @@ LoopHashMap::lookup(
 	std::vector < core::Size > & result
 ) const
 {
+	if ( keys_ ) utility_exit_with_message( "Bucket lookups are not available for a memory-mapped LoopHashMap" );
 	if ( index > backbone_index_map_.bucket_count() ) {
 		//TR.Error << "OutofBOIUNDS! " << std::endl;
 		return;
@@ -605,6 +658,11 @@ LoopHashMap::radial_lookup_withkey(
 void
 LoopHashMap::lookup_withkey( boost::uint64_t key, std::vector < core::Size > & result ) const
 {
+	if ( keys_ ) {
+		mapped_lookup( key, result );
+		return;
+	}
+
 	std::pair<  BackboneIndexMap::const_iterator,
 		BackboneIndexMap::const_iterator> range = backbone_index_map_.equal_range( key );
 
@@ -676,6 +734,124 @@ LoopHashMap::read_db(
 	file.close();
 }
 
+void
+LoopHashMap::mapped_lookup( boost::uint64_t key, std::vector < core::Size > & result ) const
+{
+	std::pair< boost::uint64_t const *, boost::uint64_t const * > range =
+		std::equal_range( keys_, keys_ + n_mapped_, key );
+	for ( boost::uint64_t const * it = range.first; it != range.second; ++it ) {
+		core::Size position = it - keys_;
+		if ( mapped_leap_loaded( position ) ) result.push_back( position );
+	}
+}
+
+bool
+LoopHashMap::mapped_leap_loaded( core::Size position ) const
+{
+	core::Size index = leaps_[ 2 * position ];
+	if ( index < mapped_range_.first ) return false;
+	if ( index >= mapped_range_.second && mapped_range_.second != 0 ) return false;
+	return mapped_homologs_.empty() || mapped_homologs_.find( index - mapped_range_.first ) == mapped_homologs_.end();
+}
+
+/// @details Leaps are drawn uniformly from the whole file and redrawn until a loaded one comes up.
+/// When few are loaded (many partitions, say) that could take long, so after a bounded number of
+/// draws one is picked among the loaded leaps counted directly.
+core::Size
+LoopHashMap::random_loaded_leap() const
+{
+	if ( n_loops() == 0 ) utility_exit_with_message( "No leaps of loop size " + utility::to_string( loop_size_ ) + " to choose from" );
+	if ( ! keys_ ) return numeric::random::random_range( 0, loopdb_.size() - 1 );
+
+	core::Size const max_draws( 1000 );
+	for ( core::Size draw = 1; draw <= max_draws; ++draw ) {
+		core::Size const position( numeric::random::random_range( 0, n_mapped_ - 1 ) );
+		if ( mapped_leap_loaded( position ) ) return position;
+	}
+
+	std::vector< core::Size > loaded;
+	for ( core::Size position = 0; position < n_mapped_; ++position ) {
+		if ( mapped_leap_loaded( position ) ) loaded.push_back( position );
+	}
+	if ( loaded.empty() ) {
+		utility_exit_with_message( "None of the " + utility::to_string( n_mapped_ ) + " leaps of loop size " + utility::to_string( loop_size_ )
+			+ " in " + mapped_->filename() + " are in this process's partition of the backbone database" );
+	}
+	return loaded[ numeric::random::random_range( 0, loaded.size() - 1 ) ];
+}
+
+void
+LoopHashMap::write_binary_db( std::string const & filename ) const
+{
+	if ( keys_ ) utility_exit_with_message( "LoopHashMap was read from binary file " + mapped_->filename() + " already" );
+
+	// Only the hashed leaps can be looked up, so only those are written; sort them by key (then
+	// by position, so that equal keys keep the order read_db() would give them)
+	std::vector< std::pair< boost::uint64_t, core::Size > > hashed( backbone_index_map_.begin(), backbone_index_map_.end() );
+	std::sort( hashed.begin(), hashed.end() );
+
+	std::vector< boost::uint64_t > keys;
+	std::vector< boost::uint32_t > leaps;
+	keys.reserve( hashed.size() );
+	leaps.reserve( 2 * hashed.size() );
+	for ( auto const & entry : hashed ) {
+		LeapIndex const & leap_index = loopdb_[ entry.second ];
+		if ( leap_index.index > std::numeric_limits< boost::uint32_t >::max() || leap_index.offset > std::numeric_limits< boost::uint32_t >::max() ) {
+			utility_exit_with_message( "Leap index or offset too large for the binary loop hash format in " + filename );
+		}
+		keys.push_back( entry.first );
+		leaps.push_back( leap_index.index );
+		leaps.push_back( leap_index.offset );
+	}
+
+	BinaryLoopDBHeader header;
+	std::memcpy( header.magic, BINARY_LOOPDB_MAGIC, sizeof( header.magic ) );
+	header.byte_order = BINARY_DB_BYTE_ORDER;
+	header.loop_size = loop_size_;
+	header.n_leaps = keys.size();
+
+	std::ofstream file( filename.c_str(), std::ios::binary );
+	if ( !file ) throw CREATE_EXCEPTION(EXCN_DB_IO_Failed,  filename, "write" );
+	file.write( reinterpret_cast< char const * >( &header ), sizeof( header ) );
+	file.write( reinterpret_cast< char const * >( keys.data() ), keys.size() * sizeof( boost::uint64_t ) );
+	file.write( reinterpret_cast< char const * >( leaps.data() ), leaps.size() * sizeof( boost::uint32_t ) );
+	if ( !file ) throw CREATE_EXCEPTION(EXCN_DB_IO_Failed,  filename, "write" );
+	file.close();
+	TR.Info << "Wrote " << keys.size() << " leaps of loop size " << loop_size_ << " to " << filename << std::endl;
+}
+
+void
+LoopHashMap::read_binary_db(
+	std::string const & filename, std::pair< core::Size, core::Size > const & loopdb_range,
+	std::map< core::Size, bool > const & homolog_index
+)
+{
+	utility::io::MappedFileOP file( new utility::io::MappedFile );
+	if ( !file->open( filename ) ) throw CREATE_EXCEPTION(EXCN_DB_IO_Failed,  filename, "read" );
+
+	BinaryLoopDBHeader header;
+	if ( file->size() < sizeof( header ) ) throw CREATE_EXCEPTION(EXCN_Wrong_DB_Format,  filename );
+	std::memcpy( &header, file->data(), sizeof( header ) );
+	if ( std::memcmp( header.magic, BINARY_LOOPDB_MAGIC, sizeof( header.magic ) ) != 0
+			|| header.byte_order != BINARY_DB_BYTE_ORDER
+			|| header.loop_size != loop_size_
+			|| file->size() != sizeof( header ) + header.n_leaps * ( sizeof( boost::uint64_t ) + 2 * sizeof( boost::uint32_t ) ) ) {
+		throw CREATE_EXCEPTION(EXCN_Wrong_DB_Format,  filename );
+	}
+
+	backbone_index_map_.clear();
+	loopdb_.clear();
+	loopdb_.shrink_to_fit();
+	n_mapped_ = header.n_leaps;
+	keys_ = reinterpret_cast< boost::uint64_t const * >( file->data() + sizeof( header ) );
+	leaps_ = reinterpret_cast< boost::uint32_t const * >( file->data() + sizeof( header ) + n_mapped_ * sizeof( boost::uint64_t ) );
+	mapped_range_ = loopdb_range;
+	mapped_homologs_ = homolog_index;
+	mapped_ = file;
+
+	TR.Info << ( file->is_mapped() ? "Mapped " : "Read " ) << n_mapped_ << " leaps of loop size " << loop_size_ << " from " << filename << std::endl;
+}
+
 
 } // namespace loops
 } // namespace protocols
@@ -25,6 +25,8 @@
 
 #include <numeric/geometry/hashing/SixDHasher.hh>
 
+#include <utility/io/MappedFile.fwd.hh>
+
 #include <string>
 #include <vector>
 #include <map>
@@ -86,6 +88,9 @@ struct LegacyLeapIndex{
 };
 
 /// @brief the loop hash map stores LeapIndexes and a hashmap to access those LeapIndexes quickly by their 6D coordinates.
+/// @details A map filled by read_binary_db() keeps no LeapIndexes of its own: the keys and leaps
+/// are read in place from a memory-mapped file, sorted by key, and lookups binary search the key
+/// array.  Such a map is read-only.
 
 
 class LoopHashMap {
@@ -116,16 +121,35 @@ public:
 
 	/// @brief Obtain an index to a given peptide saved
 	inline
-	LeapIndex const &
+	LeapIndex
 	get_peptide( core::Size index ) const {
+		if ( keys_ ) {
+			runtime_assert( index < n_mapped_ );
+			LeapIndex leap_index;
+			leap_index.index = leaps_[ 2 * index ] - mapped_range_.first;
+			leap_index.offset = leaps_[ 2 * index + 1 ];
+			leap_index.key = keys_[ index ];
+			return leap_index;
+		}
 		runtime_assert( index < loopdb_.size() );
 		return loopdb_[ index ];
 	}
 
+	/// @brief The number of leaps; for a mapped map this counts every leap in the file,
+	/// including those outside this process's partition of the backbone database;
+	/// use random_loaded_leap() to pick one at random
 	inline core::Size n_loops() const {
-		return loopdb_.size();
+		return keys_ ? n_mapped_ : loopdb_.size();
 	}
 
+	/// @brief The index (for get_peptide()) of a leap chosen uniformly at random from those
+	/// loaded: for a mapped map, leaps outside this process's partition of the backbone database
+	/// and homologs are redrawn
+	core::Size random_loaded_leap() const;
+
+	/// @brief Was this map read from a memory-mapped binary file?
+	inline bool is_mapped() const { return keys_ != nullptr; }
+
 	/// @brief Return a vector of loops with equal keys  given a key
 	//  And any keys within a radius around the original key
 	void radial_lookup_withkey( boost::uint64_t key, core::Size radius, std::vector < core::Size > &result ) const;
@@ -173,6 +197,15 @@ public:
 		read_db( filename, range, homolog_index );
 	}
 
+	/// @brief Write the hashed leaps to a binary file that read_binary_db() maps
+	void write_binary_db( std::string const & filename ) const;
+
+	/// @brief Map a file written by write_binary_db().  The leaps are not copied; those whose
+	/// backbone index is outside loopdb_range or in homolog_index are skipped at lookup time,
+	/// as read_db() skips them while reading.
+	void read_binary_db( std::string const & filename, std::pair< core::Size, core::Size > const & loopdb_range,
+		std::map< core::Size, bool > const & homolog_index );
+
 	/// @brief Return the memory usage of this class
 	void mem_foot_print() const;
 
@@ -194,6 +227,27 @@ private:  // Private data
 	/// @brief The length of the the loops in number of residues
 	core::Size                                loop_size_;
 
+	/// @brief Append the (unskipped) positions of the mapped leaps with this key
+	void mapped_lookup( boost::uint64_t key, std::vector < core::Size > & result ) const;
+
+	/// @brief Is this mapped leap in the loaded partition and not a homolog?
+	bool mapped_leap_loaded( core::Size position ) const;
+
+	/// @brief The binary file backing a mapped map
+	utility::io::MappedFileCOP                mapped_;
+
+	/// @brief The sorted keys of the mapped leaps
+	boost::uint64_t const *                   keys_ = nullptr;
+
+	/// @brief The (index, offset) pair of each mapped leap
+	boost::uint32_t const *                   leaps_ = nullptr;
+
+	core::Size                                n_mapped_ = 0;
+
+	/// @brief The backbone database range and homologs the mapped leaps are filtered by
+	std::pair< core::Size, core::Size >       mapped_range_;
+	std::map< core::Size, bool >              mapped_homologs_;
+
 	///// @brief A functor for sort()
 	//struct by_index {
 	// bool operator()( LeapIndex const &a, LeapIndex const &b ) const {
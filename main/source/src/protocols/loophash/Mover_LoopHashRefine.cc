@@ -258,6 +258,13 @@ int loophash_main(){
 		return 0;
 	}
 
+	// Convert the merged text db to the binary form read with -lh:mmap_db
+	if ( option[lh::write_binary_db]() ) {
+		loop_hash_library->load_mergeddb();
+		loop_hash_library->save_binary_db();
+		return 0;
+	}
+
 	Mover_LoopHashRefineOP lh_sampler( new Mover_LoopHashRefine( loop_hash_library ) );
 
 	// Normal mode with external loophash library
@@ -221,6 +221,16 @@ file_size( std::string const & filename )
 }
 
 
+/// @brief Last modification time of a file, in seconds since the epoch
+long
+file_last_modified( std::string const & filename )
+{
+	struct stat buf;
+	if ( stat( filename.c_str(), &buf ) ) return -1; // stat() returns non-zero on failure
+	return static_cast< long >( buf.st_mtime );
+}
+
+
 /// @brief Create a blank file if it doesn't already exist
 bool
 create_blank_file( std::string const & blank_file )
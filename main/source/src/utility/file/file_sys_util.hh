@@ -55,6 +55,10 @@ file_basename( std::string const & filename );
 long
 file_size( std::string const & filename );
 
+/// @brief Last modification time of a file, in seconds since the epoch; -1 if it cannot be read
+long
+file_last_modified( std::string const & filename );
+
 /// @brief current working directory
 std::string
 cwd();
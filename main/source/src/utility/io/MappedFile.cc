@@ -0,0 +1,145 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   utility/io/MappedFile.cc
+/// @brief  Implementation of the MappedFile and MemoryStreamBuf classes
+
+// Unit headers
+#include <utility/io/MappedFile.hh>
+
+// C++ headers
+#include <fstream>
+
+#if !defined( WIN32 ) && !defined( __native_client__ )
+#define UTILITY_IO_MAPPED_FILE_USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace utility {
+namespace io {
+
+MappedFile::MappedFile() :
+	is_open_( false ),
+	mapped_( nullptr ),
+	data_( nullptr ),
+	size_( 0 )
+{}
+
+MappedFile::MappedFile( std::string const & filename ) :
+	is_open_( false ),
+	mapped_( nullptr ),
+	data_( nullptr ),
+	size_( 0 )
+{
+	open( filename );
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool
+MappedFile::open( std::string const & filename )
+{
+	close();
+	filename_ = filename;
+
+#ifdef UTILITY_IO_MAPPED_FILE_USE_MMAP
+	int const fd = ::open( filename.c_str(), O_RDONLY );
+	if ( fd < 0 ) return false;
+	struct stat st;
+	if ( ::fstat( fd, &st ) != 0 ) {
+		::close( fd );
+		return false;
+	}
+	size_ = static_cast< platform::Size >( st.st_size );
+	if ( size_ > 0 ) {
+		void * addr = ::mmap( nullptr, size_, PROT_READ, MAP_SHARED, fd, 0 );
+		if ( addr != MAP_FAILED ) {
+			mapped_ = addr;
+			data_ = static_cast< char const * >( addr );
+		}
+	}
+	// The mapping stays valid after the descriptor is closed.
+	::close( fd );
+	if ( size_ == 0 || mapped_ ) {
+		is_open_ = true;
+		return true;
+	}
+#endif
+
+	// Fall back on reading the whole file into memory.
+	std::ifstream in( filename.c_str(), std::ios::in | std::ios::binary );
+	if ( ! in ) return false;
+	in.seekg( 0, std::ios::end );
+	std::streamoff const nbytes = in.tellg();
+	if ( nbytes < 0 ) return false;
+	in.seekg( 0, std::ios::beg );
+	buffer_.resize( static_cast< platform::Size >( nbytes ) );
+	if ( nbytes > 0 && ! in.read( &buffer_[ 0 ], nbytes ) ) {
+		buffer_.clear();
+		return false;
+	}
+	size_ = buffer_.size();
+	data_ = size_ > 0 ? &buffer_[ 0 ] : nullptr;
+	is_open_ = true;
+	return true;
+}
+
+void
+MappedFile::close()
+{
+#ifdef UTILITY_IO_MAPPED_FILE_USE_MMAP
+	if ( mapped_ ) {
+		::munmap( mapped_, size_ );
+	}
+#endif
+	mapped_ = nullptr;
+	data_ = nullptr;
+	size_ = 0;
+	std::vector< char >().swap( buffer_ );
+	is_open_ = false;
+}
+
+MemoryStreamBuf::MemoryStreamBuf( char const * begin, platform::Size size )
+{
+	// std::streambuf only offers a non-const get area; nothing here ever writes through it.
+	char * b = const_cast< char * >( begin );
+	setg( b, b, b + size );
+}
+
+MemoryStreamBuf::pos_type
+MemoryStreamBuf::seekoff( off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which )
+{
+	if ( ! ( which & std::ios_base::in ) ) return pos_type( off_type( -1 ) );
+	char * target( nullptr );
+	if ( dir == std::ios_base::beg ) {
+		target = eback() + off;
+	} else if ( dir == std::ios_base::cur ) {
+		target = gptr() + off;
+	} else {
+		target = egptr() + off;
+	}
+	if ( target < eback() || target > egptr() ) return pos_type( off_type( -1 ) );
+	setg( eback(), target, egptr() );
+	return pos_type( off_type( target - eback() ) );
+}
+
+MemoryStreamBuf::pos_type
+MemoryStreamBuf::seekpos( pos_type pos, std::ios_base::openmode which )
+{
+	return seekoff( off_type( pos ), std::ios_base::beg, which );
+}
+
+} // namespace io
+} // namespace utility
@@ -0,0 +1,31 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   utility/io/MappedFile.fwd.hh
+/// @brief  forward declaration of a read-only memory-mapped file
+
+#ifndef INCLUDED_utility_io_MappedFile_fwd_hh
+#define INCLUDED_utility_io_MappedFile_fwd_hh
+
+// Utility headers
+#include <utility/pointer/owning_ptr.hh>
+
+namespace utility {
+namespace io {
+
+class MappedFile;
+typedef utility::pointer::shared_ptr< MappedFile > MappedFileOP;
+typedef utility::pointer::shared_ptr< MappedFile const > MappedFileCOP;
+
+class MemoryStreamBuf;
+
+}
+}
+
+#endif
@@ -0,0 +1,101 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   utility/io/MappedFile.hh
+/// @brief  A read-only view of a whole file, memory-mapped where the platform allows it.
+
+#ifndef INCLUDED_utility_io_MappedFile_hh
+#define INCLUDED_utility_io_MappedFile_hh
+
+// Unit headers
+#include <utility/io/MappedFile.fwd.hh>
+
+// Utility headers
+#include <utility/pointer/ReferenceCount.hh>
+
+// Platform headers
+#include <platform/types.hh>
+
+// C++ headers
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace utility {
+namespace io {
+
+/// @brief The %MappedFile gives read-only access to the bytes of a file on disk.
+/// On POSIX systems the file is mapped with mmap( PROT_READ, MAP_SHARED ), so the
+/// pages are faulted in only when they are touched and are shared through the page
+/// cache between all of the processes on a node that map the same file.  On other
+/// platforms (or if mmap fails) the file is read into a private buffer instead;
+/// callers see the same interface either way.
+///
+/// Binary files are read as they are stored; the caller is responsible for any
+/// byte-order or alignment assumptions in its format.
+class MappedFile : public utility::pointer::ReferenceCount
+{
+public:
+	/// @brief Construct a closed %MappedFile
+	MappedFile();
+
+	/// @brief Construct and open; check is_open() for success
+	explicit MappedFile( std::string const & filename );
+
+	~MappedFile() override;
+
+	/// @brief Map the named file, closing any previously-mapped one.  Returns false
+	/// if the file could not be opened or read.
+	bool open( std::string const & filename );
+
+	/// @brief Release the mapping
+	void close();
+
+	bool is_open() const { return is_open_; }
+
+	/// @brief Was the file mapped (true) or read into a private buffer (false)?
+	bool is_mapped() const { return mapped_ != nullptr; }
+
+	std::string const & filename() const { return filename_; }
+
+	/// @brief Pointer to the first byte of the file; null if not open or empty
+	char const * data() const { return data_; }
+
+	/// @brief The number of bytes in the file
+	platform::Size size() const { return size_; }
+
+	MappedFile( MappedFile const & ) = delete;
+	MappedFile & operator = ( MappedFile const & ) = delete;
+
+private:
+	std::string filename_;
+	bool is_open_;
+	void * mapped_;
+	char const * data_;
+	platform::Size size_;
+	std::vector< char > buffer_;
+};
+
+/// @brief A std::streambuf reading from a fixed range of memory (e.g. a region of
+/// a MappedFile) without copying it, so that code written against std::istream can
+/// deserialize directly from the mapping.  Supports seekg / tellg within the range.
+class MemoryStreamBuf : public std::streambuf
+{
+public:
+	MemoryStreamBuf( char const * begin, platform::Size size );
+
+protected:
+	pos_type seekoff( off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which ) override;
+	pos_type seekpos( pos_type pos, std::ios_base::openmode which ) override;
+};
+
+} // namespace io
+} // namespace utility
+
+#endif
@@ -0,0 +1,138 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/chemical/GlobalResidueTypeSetSnapshotTests.cxxtest.hh
+/// @brief  Tests for restoring a GlobalResidueTypeSet from a database snapshot (-chemical:residue_type_set_snapshot)
+
+// Test Headers
+#include <cxxtest/TestSuite.h>
+#include <test/core/init_util.hh>
+
+// Unit Headers
+#include <core/chemical/GlobalResidueTypeSet.hh>
+#include <core/chemical/ResidueType.hh>
+
+// Platform Headers
+#include <basic/Tracer.hh>
+#include <basic/database/open.hh>
+
+// Utility Headers
+#include <utility/file/file_sys_util.hh>
+#include <utility/string_util.hh>
+#include <utility/io/izstream.hh>
+
+// C++ Headers
+#include <fstream>
+#include <string>
+
+static basic::Tracer TR("core.chemical.GlobalResidueTypeSetSnapshotTests.cxxtest");
+
+using namespace core::chemical;
+
+class GlobalResidueTypeSetSnapshotTests : public CxxTest::TestSuite {
+
+	std::string scratch_dir_;
+	std::string database_dir_;
+	std::string cache_dir_;
+
+public:
+
+	void setUp() {
+#ifdef SERIALIZATION
+		scratch_dir_ = utility::file::create_temp_filename( ".", "rts_snapshot_test" ) + "/";
+		database_dir_ = scratch_dir_ + "database/";
+		cache_dir_ = scratch_dir_ + "cache/";
+		utility::file::create_directory_recursive( database_dir_ );
+		utility::file::create_directory_recursive( cache_dir_ );
+		core_init_with_additional_options( "-chemical:residue_type_set_snapshot -in:path:database_cache_dir " + cache_dir_ );
+
+		// A one-residue database, so that the params file can be edited.
+		std::ofstream residue_types( ( database_dir_ + "residue_types.txt" ).c_str() );
+		residue_types << "TYPE_SET_MODE full_atom\n" << "ATOM_TYPE_SET fa_standard\n" << "ELEMENT_SET default\n"
+			<< "MM_ATOM_TYPE_SET fa_standard\n" << "ORBITAL_TYPE_SET fa_standard\n" << "ALA.params\n";
+		std::ofstream patches( ( database_dir_ + "patches.txt" ).c_str() );
+		write_params( utility::file_contents( basic::database::full_name( "chemical/residue_type_sets/fa_standard/residue_types/l-caa/ALA.params" ) ) );
+#endif
+	}
+
+	void tearDown() {
+#ifdef SERIALIZATION
+		for ( std::string const & dir : { cache_dir_ + "chemical/residue_type_sets/", cache_dir_ + "chemical/", cache_dir_, database_dir_, scratch_dir_ } ) {
+			for ( std::string const & file : files_in( dir ) ) {
+				utility::file::file_delete( dir + file );
+			}
+			utility::file::file_delete( dir );
+		}
+		core_init();
+#endif
+	}
+
+	void write_params( std::string const & contents ) {
+		std::ofstream params( ( database_dir_ + "ALA.params" ).c_str() );
+		params << contents;
+	}
+
+	utility::vector1< std::string > files_in( std::string const & dir, std::string const & extension = "" ) {
+		utility::vector1< std::string > files, matching;
+		utility::file::list_dir( dir, files );
+		for ( std::string const & file : files ) {
+			if ( file == "." || file == ".." ) continue;
+			if ( extension.empty() || utility::endswith( file, extension ) ) matching.push_back( file );
+		}
+		return matching;
+	}
+
+	utility::vector1< std::string > snapshots() {
+		return files_in( cache_dir_ + "chemical/residue_type_sets/", ".rts.bin" );
+	}
+
+	void test_snapshot_round_trip() {
+#ifdef SERIALIZATION
+		GlobalResidueTypeSet const first( "snapshot_test", database_dir_ );
+		TS_ASSERT_EQUALS( snapshots().size(), 1 );
+
+		// The hashes of the database files are cached alongside the snapshot, with their sizes and times.
+		utility::vector1< std::string > const hash_caches( files_in( cache_dir_ + "chemical/residue_type_sets/", ".rts.hashes" ) );
+		TS_ASSERT_EQUALS( hash_caches.size(), 1 );
+		if ( hash_caches.size() == 1 ) {
+			std::string const cached( utility::file_contents( cache_dir_ + "chemical/residue_type_sets/" + hash_caches[1] ) );
+			std::string const params_hash( utility::string_to_sha1( utility::file_contents( database_dir_ + "ALA.params" ) ) );
+			TS_ASSERT( cached.find( params_hash + " " + database_dir_ + "ALA.params\n" ) != std::string::npos );
+		}
+
+		GlobalResidueTypeSet const second( "snapshot_test", database_dir_ );
+		TS_ASSERT_EQUALS( snapshots().size(), 1 );
+		TS_ASSERT_EQUALS( second.base_residue_types().size(), first.base_residue_types().size() );
+		TS_ASSERT( second.has_name( "ALA" ) );
+		TS_ASSERT_EQUALS( second.name_map( "ALA" ).natoms(), first.name_map( "ALA" ).natoms() );
+		TS_ASSERT_DELTA( second.name_map( "ALA" ).mass(), first.name_map( "ALA" ).mass(), 1e-6 );
+#endif
+	}
+
+	/// @brief An edit that leaves the params file the same size must not be served from the old snapshot.
+	void test_snapshot_invalidated_by_same_size_edit() {
+#ifdef SERIALIZATION
+		GlobalResidueTypeSet const first( "snapshot_test", database_dir_ );
+		TS_ASSERT( first.has_name( "ALA" ) );
+		TS_ASSERT_EQUALS( snapshots().size(), 1 );
+
+		std::string const params( utility::file_contents( database_dir_ + "ALA.params" ) );
+		std::string const edited( utility::replace_in( params, "NAME ALA", "NAME ALX" ) );
+		TS_ASSERT_DIFFERS( edited, params );
+		TS_ASSERT_EQUALS( edited.size(), params.size() );
+		write_params( edited );
+
+		GlobalResidueTypeSet const second( "snapshot_test", database_dir_ );
+		TS_ASSERT( second.has_name( "ALX" ) );
+		TS_ASSERT( ! second.has_name( "ALA" ) );
+		TS_ASSERT_EQUALS( snapshots().size(), 2 );
+#endif
+	}
+
+};
@@ -508,4 +508,48 @@ public:
 		TS_ASSERT_EQUALS( id4[5].atomno(), pose.residue(3).atom_index("CA") );
 	}
 
+	/// @brief In-place copies skip the residues whose stamps match, yet carry over every change
+	void test_in_place_copy_of_changed_residues() {
+		core::pose::Pose trial = create_trpcage_ideal_pose();
+		trial.residue( 1 ); // refold
+		core::pose::Pose accepted( trial );
+		TS_ASSERT_EQUALS( trial.conformation().residue_stamps_, accepted.conformation().residue_stamps_ );
+
+		trial.set_phi( 6, trial.phi( 6 ) + 25.0 );
+		trial.set_chi( 1, 3, trial.chi( 1, 3 ) - 40.0 );
+		trial.residue( 1 );
+		utility::vector1< Size > const & trial_stamps( trial.conformation().residue_stamps_ );
+		utility::vector1< Size > const & accepted_stamps( accepted.conformation().residue_stamps_ );
+		TS_ASSERT_EQUALS( trial_stamps.size(), trial.size() );
+		TS_ASSERT_EQUALS( trial_stamps[ 1 ], accepted_stamps[ 1 ] );
+		TS_ASSERT_DIFFERS( trial_stamps[ 3 ], accepted_stamps[ 3 ] );
+		TS_ASSERT_EQUALS( trial_stamps[ 4 ], accepted_stamps[ 4 ] );
+		for ( Size ii = 7; ii <= trial.size(); ++ii ) TS_ASSERT_DIFFERS( trial_stamps[ ii ], accepted_stamps[ ii ] );
+
+		accepted = trial; // accept
+		assert_same_residues( accepted, trial );
+		TS_ASSERT_EQUALS( accepted.conformation().residue_stamps_, trial.conformation().residue_stamps_ );
+
+		// a replaced residue and a moved atom, then rejected
+		core::conformation::ResidueOP rotamer( trial.residue( 10 ).clone() );
+		rotamer->set_chi( 1, rotamer->chi( 1 ) + 60.0 );
+		trial.replace_residue( 10, *rotamer, false );
+		trial.set_xyz( core::id::AtomID( 1, 15 ), trial.xyz( core::id::AtomID( 1, 15 ) ) + core::Vector( 0.1, 0.0, 0.0 ) );
+		trial.residue( 1 );
+		trial = accepted; // reject
+		assert_same_residues( trial, accepted );
+	}
+
+private:
+	void assert_same_residues( core::pose::Pose const & a, core::pose::Pose const & b ) {
+		TS_ASSERT_EQUALS( a.size(), b.size() );
+		for ( Size ii = 1; ii <= a.size() && ii <= b.size(); ++ii ) {
+			for ( Size jj = 1; jj <= a.residue( ii ).natoms(); ++jj ) {
+				TS_ASSERT_EQUALS( a.residue( ii ).xyz( jj ), b.residue( ii ).xyz( jj ) );
+			}
+			TS_ASSERT_EQUALS( a.residue( ii ).mainchain_torsions(), b.residue( ii ).mainchain_torsions() );
+			TS_ASSERT_EQUALS( a.residue( ii ).chi(), b.residue( ii ).chi() );
+		}
+	}
+
 };
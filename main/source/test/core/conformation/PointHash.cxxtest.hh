@@ -0,0 +1,102 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file    test/core/conformation/PointHash.cxxtest.hh
+/// @brief   Test suite for the persistent spatial hash used for incremental neighbor detection
+
+// Test Headers
+#include <cxxtest/TestSuite.h>
+#include <test/core/init_util.hh>
+
+// Unit Header
+#include <core/conformation/PointHash.hh>
+
+// Project Headers
+#include <core/types.hh>
+
+// Utility Header
+#include <utility/vector1.hh>
+
+// Basic Header
+#include <basic/Tracer.hh>
+
+// C++ headers
+#include <set>
+#include <utility>
+
+static basic::Tracer TR( "core.conformation.PointHash.cxxtest.hh" );
+
+using namespace core;
+using namespace core::conformation;
+
+class PointHashTests : public CxxTest::TestSuite {
+public:
+	void setUp()
+	{
+		core_init();
+	}
+
+	void tearDown()
+	{}
+
+	std::set< std::pair< Size, Size > >
+	naive_neighbors( utility::vector1< PointPosition > const & points, Real cutoff ) {
+		std::set< std::pair< Size, Size > > pairs;
+		for ( Size ii = 1; ii <= points.size(); ++ii ) {
+			for ( Size jj = ii + 1; jj <= points.size(); ++jj ) {
+				if ( points[ ii ].distance_squared( points[ jj ] ) <= cutoff * cutoff ) pairs.insert( std::make_pair( ii, jj ) );
+			}
+		}
+		return pairs;
+	}
+
+	std::set< std::pair< Size, Size > >
+	hash_neighbors( PointHash const & hash, Real cutoff ) {
+		std::set< std::pair< Size, Size > > pairs;
+		for ( Size ii = 1; ii <= hash.size(); ++ii ) {
+			hash.for_each_neighbor( hash.point( ii ), cutoff, ii, [&]( Size jj, Real ) {
+				if ( ii < jj ) pairs.insert( std::make_pair( ii, jj ) );
+			} );
+		}
+		return pairs;
+	}
+
+	void test_neighbors_match_naive_search_after_moves()
+	{
+		// A lattice of points straddling the origin, so that negative cube indices are exercised
+		utility::vector1< PointPosition > points;
+		for ( int ii = -3; ii <= 3; ++ii ) {
+			for ( int jj = -3; jj <= 3; ++jj ) {
+				points.push_back( PointPosition( 3.1 * ii, 2.7 * jj, 0.9 * ii * jj ) );
+			}
+		}
+
+		PointHash hash;
+		TS_ASSERT( hash.is_empty() );
+		hash.reset( points, 6.0 );
+		TS_ASSERT_EQUALS( hash.size(), points.size() );
+		TS_ASSERT( hash_neighbors( hash, 6.0 ) == naive_neighbors( points, 6.0 ) );
+		TS_ASSERT( hash_neighbors( hash, 4.0 ) == naive_neighbors( points, 4.0 ) );
+
+		// Move a few points, some within their cube and some across cube boundaries
+		points[ 1 ] = PointPosition( 0.5, 0.5, 0.5 );
+		points[ 7 ] += PointPosition( 0.1, 0.0, 0.0 );
+		points[ 20 ] = PointPosition( -14.0, 11.0, 3.0 );
+		points[ 21 ] = points[ 20 ] + PointPosition( 1.0, 1.0, 1.0 );
+		for ( Size const id : { 1, 7, 20, 21 } ) {
+			hash.move_point( id, points[ id ] );
+		}
+		TS_ASSERT( hash_neighbors( hash, 6.0 ) == naive_neighbors( points, 6.0 ) );
+		TS_ASSERT( hash.point( 20 ) == points[ 20 ] );
+
+		hash.clear();
+		TS_ASSERT( hash.is_empty() );
+	}
+
+};
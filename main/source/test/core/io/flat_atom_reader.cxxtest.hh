@@ -0,0 +1,128 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/io/flat_atom_reader.cxxtest.hh
+/// @brief  test suite for the single-pass .pdb and mmCIF atom readers
+
+// Test headers
+#include <cxxtest/TestSuite.h>
+#include <test/core/init_util.hh>
+
+#include <core/io/flat_atom_reader.hh>
+#include <core/io/StructFileRep.hh>
+#include <core/io/StructFileReaderOptions.hh>
+#include <core/io/mmcif/cif_reader.hh>
+#include <core/io/pdb/pdb_reader.hh>
+
+#include <core/conformation/Residue.hh>
+#include <core/import_pose/import_pose.hh>
+#include <core/pose/Pose.hh>
+
+#include <utility/io/izstream.hh>
+#include <utility/string_util.hh>
+
+#include <cifparse/CifFile.h>
+#include <cifparse/CifParserBase.h>
+
+using namespace core;
+using namespace core::io;
+
+class FlatAtomReaderTests : public CxxTest::TestSuite {
+public:
+
+	void setUp() {
+		core_init_with_additional_options( "-no_optH" );
+	}
+
+	void tearDown() {}
+
+	void test_pdb_atoms_match_regular_reader() {
+		std::string const contents( slurp( "core/io/test_in.pdb" ) );
+		StructFileReaderOptions options;
+		FlatAtoms atoms;
+		TS_ASSERT( ! is_cif_contents( contents.data(), contents.data() + contents.size() ) );
+		TS_ASSERT( read_flat_atoms_from_file_contents( contents.data(), contents.data() + contents.size(), options, atoms ) );
+		TS_ASSERT( ! atoms.atoms.empty() );
+
+		StructFileRep const regular( pdb::create_sfr_from_pdb_file_contents( contents, options ) );
+		assert_same_atoms( *create_sfr_from_flat_atoms( atoms ), regular );
+
+		// Only ATOM records
+		options.set_read_only_ATOM_entries( true );
+		TS_ASSERT( read_flat_atoms_from_pdb_contents( contents.data(), contents.data() + contents.size(), options, atoms ) );
+		assert_same_atoms( *create_sfr_from_flat_atoms( atoms ), pdb::create_sfr_from_pdb_file_contents( contents, options ) );
+	}
+
+	void test_cif_atoms_match_regular_reader() {
+		std::string const contents( slurp( "core/io/1QYS.cif" ) );
+		StructFileReaderOptions options;
+		FlatAtoms atoms;
+		TS_ASSERT( is_cif_contents( contents.data(), contents.data() + contents.size() ) );
+		TS_ASSERT( read_flat_atoms_from_file_contents( contents.data(), contents.data() + contents.size(), options, atoms ) );
+
+		std::string diagnostics;
+		utility::pointer::shared_ptr< CifFile > cif_file( new CifFile );
+		{
+			CifParser parser( cif_file.get() );
+			parser.ParseString( contents, diagnostics );
+		}
+		StructFileRepOP regular( mmcif::create_sfr_from_cif_file_op( cif_file, options ) );
+		assert_same_atoms( *create_sfr_from_flat_atoms( atoms ), *regular );
+	}
+
+	void test_pose_from_atom_records_file() {
+		pose::Pose regular, fast;
+		import_pose::pose_from_file( regular, "core/io/test_in.pdb", core::import_pose::PDB_file );
+		import_pose::pose_from_atom_records_file( fast, "core/io/test_in.pdb" );
+		TS_ASSERT_EQUALS( fast.size(), regular.size() );
+		TS_ASSERT_EQUALS( fast.sequence(), regular.sequence() );
+		for ( Size ii = 1; ii <= regular.size() && ii <= fast.size(); ++ii ) {
+			TS_ASSERT_EQUALS( fast.residue_type( ii ).name(), regular.residue_type( ii ).name() );
+			for ( Size jj = 1; jj <= regular.residue( ii ).natoms() && jj <= fast.residue( ii ).natoms(); ++jj ) {
+				TS_ASSERT_DELTA( fast.residue( ii ).xyz( jj ).distance( regular.residue( ii ).xyz( jj ) ), 0.0, 1e-6 );
+			}
+		}
+	}
+
+private:
+	std::string slurp( std::string const & filename ) {
+		utility::io::izstream file( filename );
+		std::string contents;
+		utility::slurp( file, contents );
+		return contents;
+	}
+
+	void assert_same_atoms( StructFileRep const & flat, StructFileRep const & regular ) {
+		TS_ASSERT_EQUALS( flat.modeltag(), regular.modeltag() );
+		TS_ASSERT_EQUALS( flat.chains().size(), regular.chains().size() );
+		for ( Size ii = 0; ii < flat.chains().size() && ii < regular.chains().size(); ++ii ) {
+			ChainAtoms const & a( flat.chains()[ ii ] ), & b( regular.chains()[ ii ] );
+			TS_ASSERT_EQUALS( a.size(), b.size() );
+			for ( Size jj = 0; jj < a.size() && jj < b.size(); ++jj ) {
+				TS_ASSERT_EQUALS( a[ jj ].isHet, b[ jj ].isHet );
+				TS_ASSERT_EQUALS( a[ jj ].serial, b[ jj ].serial );
+				TS_ASSERT_EQUALS( a[ jj ].name, b[ jj ].name );
+				TS_ASSERT_EQUALS( a[ jj ].altLoc, b[ jj ].altLoc );
+				TS_ASSERT_EQUALS( a[ jj ].resName, b[ jj ].resName );
+				TS_ASSERT_EQUALS( a[ jj ].chainID, b[ jj ].chainID );
+				TS_ASSERT_EQUALS( a[ jj ].resSeq, b[ jj ].resSeq );
+				TS_ASSERT_EQUALS( a[ jj ].iCode, b[ jj ].iCode );
+				TS_ASSERT_EQUALS( a[ jj ].x, b[ jj ].x );
+				TS_ASSERT_EQUALS( a[ jj ].y, b[ jj ].y );
+				TS_ASSERT_EQUALS( a[ jj ].z, b[ jj ].z );
+				TS_ASSERT_EQUALS( a[ jj ].occupancy, b[ jj ].occupancy );
+				TS_ASSERT_EQUALS( a[ jj ].temperature, b[ jj ].temperature );
+				TS_ASSERT_EQUALS( a[ jj ].segmentID, b[ jj ].segmentID );
+				TS_ASSERT_EQUALS( a[ jj ].element, b[ jj ].element );
+				TS_ASSERT_EQUALS( a[ jj ].terCount, b[ jj ].terCount );
+			}
+		}
+	}
+
+};
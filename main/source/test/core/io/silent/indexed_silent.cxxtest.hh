@@ -0,0 +1,154 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/io/silent/indexed_silent.cxxtest.hh
+/// @brief  test suite for the indexed silent-file container
+
+// Test headers
+#include <cxxtest/TestSuite.h>
+
+#include <test/core/init_util.hh>
+
+#include <basic/Tracer.hh>
+
+#include <core/chemical/ResidueTypeSet.hh>
+#include <core/chemical/ChemicalManager.hh>
+#include <core/import_pose/import_pose.hh>
+
+#include <core/io/silent/IndexedSilentFile.hh>
+#include <core/io/silent/SilentFileData.hh>
+#include <core/io/silent/SilentFileOptions.hh>
+#include <core/io/silent/BinarySilentStruct.hh>
+
+#include <core/pose/Pose.hh>
+#include <core/scoring/rms_util.hh>
+
+#include <utility/file/file_sys_util.hh>
+#include <utility/vector1.hh>
+
+#include <cmath>
+#include <fstream>
+
+static basic::Tracer TR("test.core.io.silent.indexed_silent");
+
+using namespace core;
+using namespace core::io::silent;
+
+class IndexedSilentTests : public CxxTest::TestSuite {
+
+public:
+	IndexedSilentTests() {};
+
+	void setUp() {
+		core_init_with_additional_options( "-mute core.io.pdb -mute core.conformation -in::file::fullatom" );
+		core::chemical::ResidueTypeSetCOP rsd( core::chemical::ChemicalManager::get_instance()->residue_type_set( core::chemical::FA_STANDARD ) );
+		core::import_pose::pose_from_file( pose_, *rsd, std::string( "core/io/bin_silentfile_test.pdb" ), core::import_pose::PDB_file );
+	}
+
+	void tearDown() {}
+
+	SilentStructOP make_struct( SilentFileOptions const & opts, std::string const & tag, Real const score ) {
+		SilentStructOP ss( new BinarySilentStruct( opts, pose_, tag ) );
+		ss->add_energy( "score", score );
+		ss->add_energy( "rms", score / 10 );
+		return ss;
+	}
+
+	void test_write_index_and_read_by_tag() {
+		std::string const filename( "core/io/silent/indexed_silent_test.out" );
+		utility::file::file_delete( filename );
+
+		SilentFileOptions opts;
+		opts.write_indexed( true );
+		SilentFileData sfd( opts );
+		sfd.add_structure( make_struct( opts, "first", -10 ) );
+		sfd.add_structure( make_struct( opts, "second", -20 ) );
+		sfd.write_all( filename );
+
+		// Appending to an existing indexed file needs no option; it is recognized by its magic.
+		SilentFileOptions plain_opts;
+		SilentFileData sfd2( plain_opts );
+		SilentStructOP third( make_struct( plain_opts, "third", -30 ) );
+		third->add_energy( "extra", 1.5 );
+		sfd2.write_silent_struct( *third, filename );
+
+		TS_ASSERT( IndexedSilentFile::is_indexed_silent_file( filename ) );
+		IndexedSilentFile indexed( filename );
+		TS_ASSERT( indexed.is_open() );
+		TS_ASSERT_EQUALS( indexed.size(), 3 );
+		TS_ASSERT( indexed.has_tag( "second" ) );
+		TS_ASSERT( !indexed.has_tag( "fourth" ) );
+
+		// Score-only access: one column value per record, NaN where a record lacks the score.
+		utility::vector1< Real > const & scores( indexed.score_column( "score" ) );
+		TS_ASSERT_EQUALS( scores.size(), 3 );
+		TS_ASSERT_DELTA( indexed.score( "second", "score" ), -20, 1e-3 );
+		TS_ASSERT_DELTA( indexed.score( "third", "rms" ), -3, 1e-3 );
+		TS_ASSERT_DELTA( indexed.score( "third", "extra" ), 1.5, 1e-3 );
+		TS_ASSERT( std::isnan( indexed.score( "first", "extra" ) ) );
+
+		SilentFileData tag_reader( plain_opts );
+		utility::vector1< std::string > tags_in_file( tag_reader.read_tags_fast( filename ) );
+		TS_ASSERT_EQUALS( tags_in_file.size(), 3 );
+
+		// Read one structure by tag through the ordinary SilentFileData interface.
+		SilentFileData reader( plain_opts );
+		utility::vector1< std::string > wanted( 1, "second" );
+		reader.read_file( filename, wanted );
+		TS_ASSERT_EQUALS( reader.size(), 1 );
+		TS_ASSERT( reader.has_tag( "second" ) );
+
+		pose::Pose restored;
+		reader.begin()->fill_pose( restored );
+		TS_ASSERT_EQUALS( restored.size(), pose_.size() );
+		TS_ASSERT( scoring::CA_rmsd( pose_, restored ) < 1e-2 );
+		TS_ASSERT_DELTA( reader.begin()->get_energy( "score" ), -20, 1e-3 );
+
+		utility::file::file_delete( filename );
+	}
+
+	/// @brief A writer that dies part way through an append must not lose the structures written before.
+	void test_incomplete_append_is_ignored() {
+		std::string const filename( "core/io/silent/indexed_silent_recovery_test.out" );
+		utility::file::file_delete( filename );
+
+		SilentFileOptions opts;
+		opts.write_indexed( true );
+		SilentFileData sfd( opts );
+		sfd.write_silent_struct( *make_struct( opts, "first", -10 ), filename );
+		sfd.write_silent_struct( *make_struct( opts, "second", -20 ), filename );
+		{
+			std::ofstream out( filename.c_str(), std::ios::out | std::ios::app | std::ios::binary );
+			out << "SCORE:     score      rms description\nSCORE:   -30.000   -3.000 third\nANNOTATED_SEQUENCE: ";
+		}
+
+		IndexedSilentFile damaged( filename );
+		TS_ASSERT( damaged.is_open() );
+		TS_ASSERT_EQUALS( damaged.size(), 2 );
+		TS_ASSERT_DELTA( damaged.score( "second", "score" ), -20, 1e-3 );
+
+		// Appending after the damage chains onto the last complete segment.
+		sfd.write_silent_struct( *make_struct( opts, "fourth", -40 ), filename );
+		IndexedSilentFile repaired( filename );
+		TS_ASSERT_EQUALS( repaired.size(), 3 );
+		TS_ASSERT( repaired.has_tag( "fourth" ) );
+		TS_ASSERT( !repaired.has_tag( "third" ) );
+		TS_ASSERT_EQUALS( repaired.score_column( "rms" ).size(), 3 );
+		TS_ASSERT_DELTA( repaired.score( "fourth", "rms" ), -4, 1e-3 );
+
+		SilentFileData reader( opts );
+		reader.read_file( filename, utility::vector1< std::string >( 1, "fourth" ) );
+		TS_ASSERT( reader.has_tag( "fourth" ) );
+
+		utility::file::file_delete( filename );
+	}
+
+private:
+	pose::Pose pose_;
+};
@@ -22,6 +22,9 @@
 
 // Project headers
 #include <core/types.hh>
+#include <core/conformation/Conformation.hh>
+#include <core/conformation/Residue.hh>
+#include <core/kinematics/FoldTree.hh>
 #include <core/pose/Pose.hh>
 #include <test/util/pose_funcs.hh>
 
@@ -95,5 +98,52 @@ public:
 
 	}
 
+	void test_refold_counters() {
+		core::pose::Pose trpcage = create_trpcage_ideal_pose();
+		AtomTree const & at( trpcage.atom_tree() );
+		trpcage.residue( 1 ); // refold anything pending
+
+		core::Size const n_refolds( at.n_refolds() ), n_atoms( at.n_atoms_refolded() );
+		trpcage.set_chi( 1, 6, trpcage.chi( 1, 6 ) + 30.0 );
+		trpcage.set_chi( 2, 6, trpcage.chi( 2, 6 ) - 30.0 );
+		trpcage.residue( 6 );
+		TS_ASSERT_EQUALS( at.n_refolds(), n_refolds + 1 );
+		core::Size const sidechain_atoms( at.n_atoms_last_refold() );
+		TS_ASSERT( sidechain_atoms > 0 );
+		TS_ASSERT( sidechain_atoms < trpcage.residue( 6 ).natoms() );
+
+		// refolds from the N-terminus place everything downstream, once
+		trpcage.set_psi( 2, trpcage.psi( 2 ) + 10.0 );
+		trpcage.set_phi( 8, trpcage.phi( 8 ) + 10.0 );
+		trpcage.residue( 20 );
+		TS_ASSERT_EQUALS( at.n_refolds(), n_refolds + 2 );
+		TS_ASSERT( at.n_atoms_last_refold() > 5 * sidechain_atoms );
+		TS_ASSERT_EQUALS( at.n_atoms_refolded(), n_atoms + sidechain_atoms + at.n_atoms_last_refold() );
+	}
+
+	/// @brief Refolding the subtrees below different jumps in threads gives the serial coordinates
+	void test_threaded_refold_matches_serial() {
+		core::pose::Pose serial = create_trpcage_ideal_pose();
+		core::kinematics::FoldTree fold_tree( serial.size() );
+		fold_tree.new_jump( 5, 15, 10 );
+		serial.fold_tree( fold_tree );
+		core::pose::Pose threaded( serial );
+		threaded.conformation().refold_threads( 4 );
+		TS_ASSERT_EQUALS( threaded.atom_tree().refold_threads(), 4u );
+
+		for ( core::pose::Pose * pose : { &serial, &threaded } ) {
+			pose->set_chi( 1, 3, pose->chi( 1, 3 ) + 40.0 );
+			pose->set_psi( 12, pose->psi( 12 ) - 15.0 );
+			pose->set_phi( 18, pose->phi( 18 ) + 20.0 );
+			pose->set_chi( 1, 16, pose->chi( 1, 16 ) - 60.0 );
+		}
+		for ( core::Size ii = 1; ii <= serial.size(); ++ii ) {
+			for ( core::Size jj = 1; jj <= serial.residue( ii ).natoms(); ++jj ) {
+				TS_ASSERT_EQUALS( threaded.residue( ii ).xyz( jj ), serial.residue( ii ).xyz( jj ) );
+			}
+		}
+		TS_ASSERT_EQUALS( threaded.atom_tree().n_atoms_last_refold(), serial.atom_tree().n_atoms_last_refold() );
+	}
+
 };
 
@@ -32,6 +32,8 @@
 #include <core/types.hh>
 
 #include <basic/Tracer.hh>
+#include <basic/options/option.hh>
+#include <basic/options/keys/multithreading.OptionKeys.gen.hh>
 
 //Auto Headers
 #include <core/id/AtomID_Mask.hh>
@@ -167,6 +169,35 @@ public:
 		return;
 	}
 
+	/// @brief Minimizing with the edge derivatives split over several threads should land on the same
+	/// score as the serial evaluation.  (Non-multithreaded builds ignore the option.)
+	void test_threaded_derivatives_match_serial()
+	{
+		using namespace optimization;
+		using namespace basic::options;
+
+		pose::Pose start_pose(create_test_in_pdb_pose());
+		kinematics::MoveMapOP mm( new kinematics::MoveMap );
+		for ( int i=30; i<= 35; ++i ) {
+			mm->set_bb ( i, true );
+			mm->set_chi( i, true );
+		}
+		scoring::ScoreFunctionOP scorefxn( core::scoring::get_score_function(true) );
+		AtomTreeMinimizer minimizer;
+		MinimizerOptionsOP min_options( new MinimizerOptions( "lbfgs_armijo_nonmonotone", 0.01, true, false, false ) );
+		min_options->max_iter( 20 );
+
+		pose::Pose serial_pose( start_pose );
+		minimizer.run( serial_pose, *mm, *scorefxn, *min_options );
+
+		option[ OptionKeys::multithreading::minimization_derivative_threads ].value( 3 );
+		pose::Pose threaded_pose( start_pose );
+		minimizer.run( threaded_pose, *mm, *scorefxn, *min_options );
+		option[ OptionKeys::multithreading::minimization_derivative_threads ].value( 1 );
+
+		TS_ASSERT_DELTA( (*scorefxn)( threaded_pose ), (*scorefxn)( serial_pose ), 1e-3 );
+	}
+
 
 	///////////////////////////////////////////////////////////////////////////////
 	// ------------------------------------------ //
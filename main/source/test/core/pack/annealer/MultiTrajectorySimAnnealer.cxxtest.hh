@@ -0,0 +1,210 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/pack/annealer/MultiTrajectorySimAnnealer.cxxtest.hh
+/// @brief  test suite for the multiple-trajectory annealer
+
+
+// Test framework headers
+#include <cxxtest/TestSuite.h>
+
+// Core Headers
+#include <core/pack/annealer/MultiTrajectorySimAnnealer.hh>
+#include <core/pack/interaction_graph/PDInteractionGraph.hh>
+#include <core/pack/interaction_graph/SurfaceInteractionGraph.hh>
+#include <core/pack/interaction_graph/HPatchInteractionGraph.hh>
+
+#include <core/chemical/AA.hh>
+
+#include <utility/graph/Graph.hh>
+
+#include <core/scoring/ScoreFunction.hh>
+#include <core/scoring/ScoreFunctionFactory.hh>
+
+#include <core/pack/packer_neighbors.hh>
+#include <core/pack/pack_rotamers.hh>
+#include <core/pack/rotamer_set/RotamerSets.hh>
+
+#include <core/pack/task/PackerTask.hh>
+#include <core/pack/task/TaskFactory.hh>
+
+
+#include <basic/random/init_random_generator.hh>
+
+// Test headers
+#include <test/core/init_util.hh>
+#include <test/util/pose_funcs.hh>
+
+//Auto Headers
+#include <utility/vector0.hh>
+#include <utility/vector1.hh>
+
+#include <algorithm>
+
+
+class MultiTrajectorySimAnnealerTests : public CxxTest::TestSuite {
+public:
+
+	void setUp() {
+		core_init();
+
+		using namespace core::chemical;
+		using namespace core::pack;
+		using namespace core::pack::interaction_graph;
+		using namespace core::pack::rotamer_set;
+		using namespace core::pack::task;
+		using namespace core::scoring;
+		using core::Size;
+
+		trpcage_ = create_trpcage_ideal_poseop();
+		task_ = TaskFactory::create_packer_task( *trpcage_ );
+
+		utility::vector1< bool > allowed_aas( num_canonical_aas, false );
+		allowed_aas[ aa_ala ] = allowed_aas[ aa_tyr ] = allowed_aas[ aa_phe ] = allowed_aas[ aa_leu ] = allowed_aas[ aa_trp ] = true;
+
+		for ( Size ii = 1; ii <= trpcage_->size(); ++ii ) {
+			if ( ii == 3 || ii == 4 || ii == 6 || ii == 7 ) {
+				task_->nonconst_residue_task( ii ).restrict_absent_canonical_aas( allowed_aas );
+			} else {
+				task_->nonconst_residue_task( ii ).prevent_repacking();
+			}
+		}
+
+		ScoreFunctionOP sfxn = get_score_function();
+		(*sfxn)( *trpcage_ );
+		sfxn->setup_for_packing( *trpcage_, task_->repacking_residues(), task_->designing_residues() );
+		utility::graph::GraphOP packer_neighbor_graph = create_packer_graph( *trpcage_, *sfxn, task_ );
+
+		rotsets_ = RotamerSetsOP( new RotamerSets() );
+		rotsets_->set_task( task_ );
+		rotsets_->build_rotamers( *trpcage_, *sfxn, packer_neighbor_graph );
+		rotsets_->prepare_sets_for_packing( *trpcage_, *sfxn );
+
+		ig_ = PDInteractionGraphOP( new PDInteractionGraph( rotsets_->nmoltenres() ) );
+		rotsets_->compute_energies( *trpcage_, *sfxn, packer_neighbor_graph, ig_ );
+	}
+
+	void check_assignments( core::pack::annealer::MultiTrajectorySimAnnealer const & annealer, core::Size const n_best ) {
+		using namespace core::pack::annealer;
+		using core::Size;
+
+		utility::vector1< MultiTrajectorySimAnnealer::Assignment > const & assignments( annealer.best_assignments() );
+		TS_ASSERT( ! assignments.empty() );
+		TS_ASSERT( assignments.size() <= n_best );
+
+		for ( Size ii = 1; ii <= assignments.size(); ++ii ) {
+			// Every molten residue is assigned, and the energy is the graph's own energy for the assignment
+			ObjexxFCL::FArray1D_int network_state( rotsets_->nmoltenres() );
+			for ( Size jj = 1; jj <= rotsets_->nmoltenres(); ++jj ) {
+				int const rot = assignments[ ii ].rotamer_at_seqpos( rotsets_->moltenres_2_resid( jj ) );
+				TS_ASSERT( rot > 0 );
+				TS_ASSERT_EQUALS( rotsets_->moltenres_for_rotamer( rot ), jj );
+				network_state( jj ) = rotsets_->rotid_on_moltenresidue( rot );
+			}
+			TS_ASSERT_DELTA( ig_->set_network_state( network_state ), assignments[ ii ].energy, 1e-3 );
+
+			if ( ii > 1 ) {
+				TS_ASSERT( assignments[ ii - 1 ].energy <= assignments[ ii ].energy );
+			}
+			for ( Size jj = 1; jj < ii; ++jj ) {
+				TS_ASSERT( !( assignments[ jj ].rotamer_at_seqpos == assignments[ ii ].rotamer_at_seqpos ) );
+			}
+		}
+	}
+
+	void test_independent_trajectories() {
+		using namespace core::pack::annealer;
+
+		ObjexxFCL::FArray1D_int bestrotamer_at_seqpos( trpcage_->size() );
+		core::PackerEnergy bestenergy( 0.0 );
+		ObjexxFCL::FArray1D_int current_rot_index( trpcage_->size(), 0 );
+		ObjexxFCL::FArray1D< core::PackerEnergy > rot_freq( ig_->get_num_total_states(), 0.0 );
+		utility::vector0< int > rot_to_pack;
+
+		MultiTrajectorySimAnnealer annealer( rot_to_pack, bestrotamer_at_seqpos, bestenergy, false,
+			ig_, rotsets_, current_rot_index, false, rot_freq );
+		annealer.n_trajectories( 6 );
+		annealer.n_best( 4 );
+		annealer.run();
+
+		check_assignments( annealer, 4 );
+		TS_ASSERT_EQUALS( annealer.n_exchanges(), 0 );
+		TS_ASSERT_DELTA( bestenergy, annealer.best_assignments()[ 1 ].energy, 1e-6 );
+		TS_ASSERT( bestrotamer_at_seqpos == annealer.best_assignments()[ 1 ].rotamer_at_seqpos );
+		// The graph is left in the best assignment
+		TS_ASSERT_DELTA( ig_->get_energy_current_state_assignment(), bestenergy, 1e-3 );
+	}
+
+	core::Size run_replica_exchange( utility::vector1< core::pack::annealer::MultiTrajectorySimAnnealer::Assignment > & assignments ) {
+		using namespace core::pack::annealer;
+
+		ObjexxFCL::FArray1D_int bestrotamer_at_seqpos( trpcage_->size() );
+		core::PackerEnergy bestenergy( 0.0 );
+		ObjexxFCL::FArray1D_int current_rot_index( trpcage_->size(), 0 );
+		ObjexxFCL::FArray1D< core::PackerEnergy > rot_freq( ig_->get_num_total_states(), 0.0 );
+		utility::vector0< int > rot_to_pack;
+
+		MultiTrajectorySimAnnealer annealer( rot_to_pack, bestrotamer_at_seqpos, bestenergy, false,
+			ig_, rotsets_, current_rot_index, false, rot_freq );
+		annealer.n_trajectories( 4 );
+		annealer.n_best( 4 );
+		annealer.replica_exchange( true );
+		annealer.run();
+
+		check_assignments( annealer, 4 );
+		assignments = annealer.best_assignments();
+		return annealer.n_exchanges();
+	}
+
+	void test_replica_exchange() {
+		using namespace core::pack::annealer;
+
+		// Every trajectory's generator, and the exchange generator, is seeded from the global
+		// RNG, so with a fixed seed the whole run -- exchanges included -- is reproducible.
+		utility::vector1< MultiTrajectorySimAnnealer::Assignment > first, second;
+		basic::random::init_random_generators( 1000, "mt19937" );
+		core::Size const first_exchanges( run_replica_exchange( first ) );
+		basic::random::init_random_generators( 1000, "mt19937" );
+		core::Size const second_exchanges( run_replica_exchange( second ) );
+
+		TS_ASSERT_EQUALS( first_exchanges, second_exchanges );
+		TS_ASSERT_EQUALS( first.size(), second.size() );
+		for ( core::Size ii = 1; ii <= std::min( first.size(), second.size() ); ++ii ) {
+			TS_ASSERT( first[ ii ].rotamer_at_seqpos == second[ ii ].rotamer_at_seqpos );
+			TS_ASSERT_DELTA( first[ ii ].energy, second[ ii ].energy, 1e-6 );
+		}
+		// With this seed the two hottest replicas swap
+		TS_ASSERT( first_exchanges > 0 );
+	}
+
+	void test_pack_rotamers_run_multiple_trajectories() {
+		utility::vector1< std::pair< core::PackerEnergy, ObjexxFCL::FArray1D_int > > results;
+		core::pack::pack_rotamers_run_multiple_trajectories( *trpcage_, task_, rotsets_, ig_, 5, 3, false, results );
+		TS_ASSERT( ! results.empty() );
+		TS_ASSERT( results.size() <= 3 );
+		for ( core::Size ii = 2; ii <= results.size(); ++ii ) {
+			TS_ASSERT( results[ ii - 1 ].first <= results[ ii ].first );
+		}
+	}
+
+	/// @brief Graphs that add non-pairwise energies to a PDInteractionGraph must not share one annealer
+	void test_non_pairwise_graphs_are_not_shared() {
+		using namespace core::pack::interaction_graph;
+		TS_ASSERT( core::pack::graph_supports_multiple_trajectory_annealer( *ig_ ) );
+		TS_ASSERT( ! core::pack::graph_supports_multiple_trajectory_annealer( PDSurfaceInteractionGraph( 4 ) ) );
+		TS_ASSERT( ! core::pack::graph_supports_multiple_trajectory_annealer( PDHPatchInteractionGraph( 4 ) ) );
+	}
+
+private:
+	core::pose::PoseOP trpcage_;
+	core::pack::task::PackerTaskOP task_;
+	core::pack::rotamer_set::RotamerSetsOP rotsets_;
+	core::pack::interaction_graph::PDInteractionGraphOP ig_;
+
+};
@@ -0,0 +1,250 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/pack/interaction_graph/CompactEnergyTable.cxxtest.hh
+/// @brief  test suite for the half-precision and fixed-point storage of two-body energies
+
+// Test framework headers
+#include <cxxtest/TestSuite.h>
+
+// Core Headers
+#include <core/pack/interaction_graph/CompactEnergyTable.hh>
+#include <core/pack/interaction_graph/PDInteractionGraph.hh>
+#include <core/pack/interaction_graph/DensePDInteractionGraph.hh>
+
+#include <core/chemical/AA.hh>
+
+#include <utility/graph/Graph.hh>
+
+#include <core/scoring/ScoreFunction.hh>
+#include <core/scoring/ScoreFunctionFactory.hh>
+
+#include <core/pack/packer_neighbors.hh>
+#include <core/pack/rotamer_set/RotamerSets.hh>
+
+#include <core/pack/task/PackerTask.hh>
+#include <core/pack/task/TaskFactory.hh>
+
+#include <numeric/random/random.hh>
+
+#include <ObjexxFCL/FArray1D.hh>
+#include <ObjexxFCL/FArray2D.hh>
+
+// Test headers
+#include <test/core/init_util.hh>
+#include <test/util/pose_funcs.hh>
+
+//Auto Headers
+#include <utility/vector0.hh>
+#include <utility/vector1.hh>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace core::pack::interaction_graph;
+
+class CompactEnergyTableTests : public CxxTest::TestSuite {
+public:
+
+	void setUp() {
+		core_init();
+	}
+
+	void test_storage_names() {
+		for ( int ii = 1; ii <= n_edge_energy_storages; ++ii ) {
+			EdgeEnergyStorage const storage = EdgeEnergyStorage( ii );
+			TS_ASSERT_EQUALS( edge_energy_storage_from_name( edge_energy_storage_name( storage ) ), storage );
+		}
+	}
+
+	void test_half_round_trip() {
+		ObjexxFCL::FArray1D< float > energies( 7 );
+		energies( 1 ) = 0.0f; energies( 2 ) = 1.0f; energies( 3 ) = -0.3333f; energies( 4 ) = 1e-6f;
+		energies( 5 ) = 123.456f; energies( 6 ) = -2.5e4f; energies( 7 ) = 1e6f;
+
+		CompactEnergyTable table;
+		table.encode( half_edge_storage, energies, 10.0f );
+		TS_ASSERT_EQUALS( table.size(), 7 );
+		TS_ASSERT_EQUALS( table.memory_in_bytes(), 7 * sizeof( std::int16_t ) );
+		TS_ASSERT_EQUALS( table( 1 ), 0.0f );
+		TS_ASSERT_EQUALS( table( 2 ), 1.0f );
+		// Ten bits of mantissa: a relative error of at most 2^-11; no clamp other than to the largest half
+		for ( int ii = 2; ii <= 6; ++ii ) {
+			TS_ASSERT_DELTA( table( ii ), energies( ii ), std::abs( energies( ii ) ) * 4.9e-4 + 6e-8 );
+		}
+		TS_ASSERT_EQUALS( table( 7 ), 65504.0f );
+
+		ObjexxFCL::FArray1D< float > decoded( 7 );
+		table.decode( decoded );
+		for ( int ii = 1; ii <= 7; ++ii ) TS_ASSERT_EQUALS( decoded( ii ), table( ii ) );
+
+		table.encode( float_edge_storage, energies, 10.0f );
+		TS_ASSERT( table.empty() );
+	}
+
+	void test_fixed_point_round_trip() {
+		ObjexxFCL::FArray2D< float > energies( 3, 4 );
+		for ( int jj = 1; jj <= 4; ++jj ) {
+			for ( int ii = 1; ii <= 3; ++ii ) {
+				energies( ii, jj ) = 0.37f * ii - 1.1f * jj;
+			}
+		}
+		energies( 2, 3 ) = 500.0f; // clamped
+
+		for ( EdgeEnergyStorage storage : { fixed16_edge_storage, fixed8_edge_storage } ) {
+			CompactEnergyTable table;
+			table.encode( storage, energies, 5.0f );
+			TS_ASSERT_EQUALS( table.size(), 12 );
+			TS_ASSERT_DELTA( table.max_magnitude(), 5.0f, 1e-5 );
+			for ( int jj = 1; jj <= 4; ++jj ) {
+				for ( int ii = 1; ii <= 3; ++ii ) {
+					float const expected = std::max( -5.0f, std::min( energies( ii, jj ), 5.0f ) );
+					TS_ASSERT_DELTA( table( ii, jj ), expected, 0.5f * table.step() + 1e-6 );
+				}
+			}
+
+			// Scaling a fixed-point table is exact
+			float const before = table( 3, 1 );
+			table.scale( 0.5f );
+			TS_ASSERT_EQUALS( table( 3, 1 ), 0.5f * before );
+		}
+
+		ObjexxFCL::FArray2D< float > zeros( 2, 2, 0.0f );
+		CompactEnergyTable table;
+		table.encode( fixed8_edge_storage, zeros, 5.0f );
+		TS_ASSERT_EQUALS( table( 2, 2 ), 0.0f );
+	}
+
+	/// @brief The sparse and dense graphs, storing their two-body energies in half precision or
+	/// in fixed point, read back every two-body energy of the 32-bit graph to within the storage's
+	/// precision, and use less memory doing so
+	void test_pd_graph_edge_energies() {
+		build_rotamers();
+		for ( bool dense : { false, true } ) {
+			PrecomputedPairEnergiesInteractionGraphOP float_ig = create_graph( dense, float_edge_storage );
+			for ( EdgeEnergyStorage storage : { half_edge_storage, fixed16_edge_storage, fixed8_edge_storage } ) {
+				PrecomputedPairEnergiesInteractionGraphOP ig = create_graph( dense, storage );
+				TS_ASSERT( ig->getTotalMemoryUsage() < float_ig->getTotalMemoryUsage() );
+
+				int const nnodes = ig->get_num_nodes();
+				for ( int ii = 1; ii <= nnodes; ++ii ) {
+					for ( int jj = ii + 1; jj <= nnodes; ++jj ) {
+						auto const * float_edge = dynamic_cast< PrecomputedPairEnergiesEdge const * >( float_ig->find_edge( ii, jj ) );
+						auto const * edge = dynamic_cast< PrecomputedPairEnergiesEdge const * >( ig->find_edge( ii, jj ) );
+						TS_ASSERT_EQUALS( float_edge == nullptr, edge == nullptr );
+						if ( ! float_edge || ! edge ) continue;
+
+						// The fixed-point step of an edge is its largest clamped magnitude over 32767 or 127
+						float max_abs( 0 );
+						for ( int si = 1; si <= ig->get_num_states_for_node( ii ); ++si ) {
+							for ( int sj = 1; sj <= ig->get_num_states_for_node( jj ); ++sj ) {
+								max_abs = std::max( max_abs, std::min( std::abs( float_edge->get_two_body_energy( si, sj ) ), clamp_ ) );
+							}
+						}
+						float const half_step = storage == fixed16_edge_storage ? 0.5f * max_abs / 32767 : 0.5f * max_abs / 127;
+						for ( int si = 1; si <= ig->get_num_states_for_node( ii ); ++si ) {
+							for ( int sj = 1; sj <= ig->get_num_states_for_node( jj ); ++sj ) {
+								float const energy = float_edge->get_two_body_energy( si, sj );
+								if ( storage == half_edge_storage ) {
+									TS_ASSERT_DELTA( edge->get_two_body_energy( si, sj ), energy, std::abs( energy ) * 4.9e-4 + 6e-8 );
+								} else {
+									float const clamped = std::max( -clamp_, std::min( energy, clamp_ ) );
+									TS_ASSERT_DELTA( edge->get_two_body_energy( si, sj ), clamped, half_step * 1.001 + 1e-6 );
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	/// @brief Annealing moves on a half-precision graph see the energies of the 32-bit graph
+	void test_pd_graph_half_storage_state_energies() {
+		build_rotamers();
+		for ( bool dense : { false, true } ) {
+			PrecomputedPairEnergiesInteractionGraphOP float_ig = create_graph( dense, float_edge_storage );
+			PrecomputedPairEnergiesInteractionGraphOP ig = create_graph( dense, half_edge_storage );
+
+			numeric::random::rg().set_seed( "mt19937", 1111 );
+			int const nnodes = ig->get_num_nodes();
+			ObjexxFCL::FArray1D_int network_state( nnodes );
+			for ( int trial = 1; trial <= 20; ++trial ) {
+				for ( int ii = 1; ii <= nnodes; ++ii ) {
+					network_state( ii ) = numeric::random::rg().random_range( 1, ig->get_num_states_for_node( ii ) );
+				}
+				core::PackerEnergy const expected = float_ig->set_network_state( network_state );
+				TS_ASSERT_DELTA( ig->set_network_state( network_state ), expected, 0.01 + 1e-3 * std::abs( expected ) );
+
+				int const node = numeric::random::rg().random_range( 1, nnodes );
+				int const state = numeric::random::rg().random_range( 1, ig->get_num_states_for_node( node ) );
+				core::PackerEnergy float_delta( 0 ), float_prev( 0 ), delta( 0 ), prev( 0 );
+				float_ig->consider_substitution( node, state, float_delta, float_prev );
+				ig->consider_substitution( node, state, delta, prev );
+				TS_ASSERT_DELTA( delta, float_delta, 0.01 + 1e-3 * std::abs( float_delta ) );
+			}
+		}
+	}
+
+private:
+	void build_rotamers() {
+		using namespace core::chemical;
+		using namespace core::pack;
+		using namespace core::pack::rotamer_set;
+		using namespace core::pack::task;
+		using namespace core::scoring;
+		using core::Size;
+
+		trpcage_ = create_trpcage_ideal_poseop();
+		PackerTaskOP task = TaskFactory::create_packer_task( *trpcage_ );
+
+		utility::vector1< bool > allowed_aas( num_canonical_aas, false );
+		allowed_aas[ aa_ala ] = allowed_aas[ aa_tyr ] = allowed_aas[ aa_phe ] = allowed_aas[ aa_leu ] = allowed_aas[ aa_trp ] = true;
+		for ( Size ii = 1; ii <= trpcage_->size(); ++ii ) {
+			if ( ii >= 2 && ii <= 9 ) {
+				task->nonconst_residue_task( ii ).restrict_absent_canonical_aas( allowed_aas );
+			} else {
+				task->nonconst_residue_task( ii ).prevent_repacking();
+			}
+		}
+
+		sfxn_ = get_score_function();
+		(*sfxn_)( *trpcage_ );
+		sfxn_->setup_for_packing( *trpcage_, task->repacking_residues(), task->designing_residues() );
+		packer_neighbor_graph_ = create_packer_graph( *trpcage_, *sfxn_, task );
+
+		rotsets_ = RotamerSetsOP( new RotamerSets() );
+		rotsets_->set_task( task );
+		rotsets_->build_rotamers( *trpcage_, *sfxn_, packer_neighbor_graph_ );
+		rotsets_->prepare_sets_for_packing( *trpcage_, *sfxn_ );
+	}
+
+	PrecomputedPairEnergiesInteractionGraphOP create_graph( bool dense, EdgeEnergyStorage storage ) {
+		PrecomputedPairEnergiesInteractionGraphOP ig;
+		if ( dense ) {
+			DensePDInteractionGraphOP dense_ig( new DensePDInteractionGraph( rotsets_->nmoltenres() ) );
+			dense_ig->set_edge_energy_storage( storage, clamp_ );
+			ig = dense_ig;
+		} else {
+			PDInteractionGraphOP pd_ig( new PDInteractionGraph( rotsets_->nmoltenres() ) );
+			pd_ig->set_edge_energy_storage( storage, clamp_ );
+			ig = pd_ig;
+		}
+		rotsets_->compute_energies( *trpcage_, *sfxn_, packer_neighbor_graph_, ig );
+		ig->prepare_for_simulated_annealing();
+		return ig;
+	}
+
+private:
+	core::pose::PoseOP trpcage_;
+	core::scoring::ScoreFunctionOP sfxn_;
+	utility::graph::GraphOP packer_neighbor_graph_;
+	core::pack::rotamer_set::RotamerSetsOP rotsets_;
+	float const clamp_ = 20.0f;
+};
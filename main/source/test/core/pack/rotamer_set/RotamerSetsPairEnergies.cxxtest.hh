@@ -0,0 +1,93 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/pack/rotamer_set/RotamerSetsPairEnergies.cxxtest.hh
+/// @brief  test that the rotamer pair energies precomputed in threads match those computed serially
+
+// Test headers
+#include <cxxtest/TestSuite.h>
+#include <test/core/init_util.hh>
+#include <test/util/pose_funcs.hh>
+
+// Unit headers
+#include <core/pack/rotamer_set/RotamerSets.hh>
+
+// Project headers
+#include <core/pack/pack_rotamers.hh>
+#include <core/pack/interaction_graph/AnnealableGraphBase.hh>
+#include <core/pack/interaction_graph/PrecomputedPairEnergiesInteractionGraph.hh>
+#include <core/pack/task/PackerTask.hh>
+#include <core/pack/task/TaskFactory.hh>
+#include <core/pose/Pose.hh>
+#include <core/scoring/ScoreFunction.hh>
+#include <core/scoring/ScoreFunctionFactory.hh>
+
+#include <basic/options/option.hh>
+#include <basic/options/keys/multithreading.OptionKeys.gen.hh>
+
+using namespace core;
+using namespace core::pack;
+using namespace core::pack::interaction_graph;
+
+class RotamerSetsPairEnergiesTests : public CxxTest::TestSuite
+{
+public:
+
+	void setUp() {
+		core_init_with_additional_options( "-multithreading:total_threads 4" );
+	}
+
+	void tearDown() {
+		basic::options::option[ basic::options::OptionKeys::multithreading::interaction_graph_threads ].value( 0 );
+	}
+
+	PrecomputedPairEnergiesInteractionGraphOP
+	precompute( pose::Pose & pose, Size const nthreads ) {
+		basic::options::option[ basic::options::OptionKeys::multithreading::interaction_graph_threads ].value( nthreads );
+		scoring::ScoreFunctionOP sfxn( scoring::get_score_function() );
+		(*sfxn)( pose );
+		task::PackerTaskOP task( task::TaskFactory::create_packer_task( pose ) );
+		task->restrict_to_repacking();
+		rotamer_set::RotamerSetsOP rotsets( new rotamer_set::RotamerSets );
+		AnnealableGraphBaseOP ig;
+		pack_rotamers_setup( pose, *sfxn, task, rotsets, ig );
+		return utility::pointer::dynamic_pointer_cast< PrecomputedPairEnergiesInteractionGraph >( ig );
+	}
+
+	/// @brief HBondEnergy and EtableEnergy keep per-pair state in mutable members, so the threads
+	/// must not share a ScoreFunction; the energies must not depend on the thread count.
+	void test_threaded_pair_energies_match_serial() {
+		pose::Pose pose( create_trpcage_ideal_pose() );
+		PrecomputedPairEnergiesInteractionGraphCOP serial( precompute( pose, 1 ) );
+		PrecomputedPairEnergiesInteractionGraphCOP threaded( precompute( pose, 4 ) );
+		TS_ASSERT( serial && threaded );
+		if ( ! serial || ! threaded ) return;
+
+		TS_ASSERT_EQUALS( serial->get_num_nodes(), threaded->get_num_nodes() );
+		TS_ASSERT_EQUALS( serial->get_num_edges(), threaded->get_num_edges() );
+		Size n_compared( 0 );
+		for ( int ii = 1; ii <= serial->get_num_nodes(); ++ii ) {
+			TS_ASSERT_EQUALS( serial->get_num_states_for_node( ii ), threaded->get_num_states_for_node( ii ) );
+			for ( int jj = ii + 1; jj <= serial->get_num_nodes(); ++jj ) {
+				TS_ASSERT_EQUALS( serial->get_edge_exists( ii, jj ), threaded->get_edge_exists( ii, jj ) );
+				if ( ! serial->get_edge_exists( ii, jj ) || ! threaded->get_edge_exists( ii, jj ) ) continue;
+				PrecomputedPairEnergiesEdge const & serial_edge( dynamic_cast< PrecomputedPairEnergiesEdge const & >( *serial->find_edge( ii, jj ) ) );
+				PrecomputedPairEnergiesEdge const & threaded_edge( dynamic_cast< PrecomputedPairEnergiesEdge const & >( *threaded->find_edge( ii, jj ) ) );
+				for ( int si = 1; si <= serial->get_num_states_for_node( ii ); ++si ) {
+					for ( int sj = 1; sj <= serial->get_num_states_for_node( jj ); ++sj ) {
+						TS_ASSERT_EQUALS( serial_edge.get_two_body_energy( si, sj ), threaded_edge.get_two_body_energy( si, sj ) );
+						++n_compared;
+					}
+				}
+			}
+		}
+		TS_ASSERT( n_compared > 0 );
+	}
+
+};
@@ -0,0 +1,109 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file    test/core/scoring/IncrementalNeighborUpdate.cxxtest.hh
+/// @brief   Test suite for Energies' incremental neighbor update (-score:incremental_neighbor_update)
+
+// Test Headers
+#include <cxxtest/TestSuite.h>
+#include <test/core/init_util.hh>
+#include <test/util/pose_funcs.hh>
+
+// Unit Headers
+#include <core/scoring/Energies.hh>
+
+// Project Headers
+#include <core/types.hh>
+#include <core/pose/Pose.hh>
+#include <core/scoring/EnergyGraph.hh>
+#include <core/scoring/ScoreFunction.hh>
+#include <core/scoring/ScoreFunctionFactory.hh>
+#include <core/scoring/TenANeighborGraph.hh>
+#include <core/scoring/solid_surface/SurfaceEnergies.hh>
+
+// Basic Header
+#include <basic/Tracer.hh>
+
+static basic::Tracer TR( "core.scoring.IncrementalNeighborUpdate.cxxtest.hh" );
+
+using namespace core;
+
+/// @brief Exposes whether an Energies class may take the incremental path
+class IncrementalSupport : public scoring::solid_surface::SurfaceEnergies {
+public:
+	static bool supported( scoring::Energies const & energies ) {
+		return ( energies.*( &IncrementalSupport::supports_incremental_neighbor_update ) )();
+	}
+};
+
+class IncrementalNeighborUpdateTests : public CxxTest::TestSuite {
+public:
+	void setUp()
+	{
+		core_init_with_additional_options( "-score:incremental_neighbor_update" );
+	}
+
+	void tearDown()
+	{}
+
+	void assert_same_neighbor_graphs( pose::Pose const & incremental, pose::Pose const & full ) {
+		scoring::EnergyGraph const & eg1( incremental.energies().energy_graph() ), & eg2( full.energies().energy_graph() );
+		scoring::TenANeighborGraph const & tg1( incremental.energies().tenA_neighbor_graph() ), & tg2( full.energies().tenA_neighbor_graph() );
+		TS_ASSERT_EQUALS( eg1.num_edges(), eg2.num_edges() );
+		TS_ASSERT_EQUALS( tg1.num_edges(), tg2.num_edges() );
+		for ( Size ii = 1; ii <= full.size(); ++ii ) {
+			for ( Size jj = ii + 1; jj <= full.size(); ++jj ) {
+				TS_ASSERT_EQUALS( eg1.get_edge_exists( ii, jj ), eg2.get_edge_exists( ii, jj ) );
+				TS_ASSERT_EQUALS( tg1.get_edge_exists( ii, jj ), tg2.get_edge_exists( ii, jj ) );
+			}
+		}
+		TS_ASSERT_DELTA( incremental.energies().total_energy(), full.energies().total_energy(), 1e-6 );
+	}
+
+	/// @brief Rescoring after a side-chain move and a backbone move (which moves one side of the
+	/// fold tree rigidly) goes through the incremental neighbor update; it must give the same
+	/// graphs as redetecting all neighbors.
+	void test_incremental_neighbor_update_matches_full_update()
+	{
+		pose::Pose pose( create_test_in_pdb_pose() );
+		scoring::ScoreFunctionOP sfxn( scoring::get_score_function() );
+		(*sfxn)( pose );
+		pose::Pose const start( pose );
+
+		pose.set_chi( 1, 10, pose.chi( 1, 10 ) + 120 );
+		pose.set_psi( 40, pose.psi( 40 ) + 25 );
+		(*sfxn)( pose );
+
+		pose::Pose full( pose );
+		full.energies().clear();
+		(*sfxn)( full );
+		assert_same_neighbor_graphs( pose, full );
+
+		// A rejected Monte Carlo move: go back to the starting pose and move something else.
+		pose = start;
+		pose.set_phi( 80, pose.phi( 80 ) - 30 );
+		(*sfxn)( pose );
+
+		full = pose;
+		full.energies().clear();
+		(*sfxn)( full );
+		assert_same_neighbor_graphs( pose, full );
+	}
+
+	/// @brief SurfaceEnergies detects neighbors through its own fill_point_graph(), which the
+	/// incremental path bypasses, so it must keep the full path.
+	void test_only_plain_energies_take_the_incremental_path()
+	{
+		scoring::Energies const plain;
+		scoring::solid_surface::SurfaceEnergies const surface;
+		TS_ASSERT( IncrementalSupport::supported( plain ) );
+		TS_ASSERT( ! IncrementalSupport::supported( surface ) );
+	}
+
+};
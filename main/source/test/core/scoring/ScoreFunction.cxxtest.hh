@@ -131,6 +131,28 @@ public:
 		TS_ASSERT_DELTA(sc_exc2, sc, .0000001);
 	}
 
+	/// @details In multithreaded builds, scoring with more than one thread distributes the residues'
+	/// two-body energies over the thread pool; the total must match serial scoring.  (In other
+	/// builds the setting is ignored and this checks that it is carried through clone()).
+	void test_threaded_twobody_scoring_matches_serial() {
+
+		ScoreFunction scfxn;
+		scfxn.set_weight(core::scoring::cart_bonded, 1); // long-range, context independent
+		TS_ASSERT_EQUALS( scfxn.scoring_threads(), 1 );
+
+		core::pose::Pose pose = create_trpcage_ideal_pose();
+		Real const serial_score( scfxn( pose ) );
+
+		ScoreFunctionOP threaded_scfxn( scfxn.clone() );
+		threaded_scfxn->set_scoring_threads( 0 );
+		TS_ASSERT_EQUALS( threaded_scfxn->clone()->scoring_threads(), 0 );
+
+		core::pose::Pose pose2 = create_trpcage_ideal_pose();
+		TS_ASSERT_DELTA( (*threaded_scfxn)( pose2 ), serial_score, 1e-6 );
+		// and again, now that the context-independent energies are cached on the graph
+		TS_ASSERT_DELTA( (*threaded_scfxn)( pose2 ), serial_score, 1e-6 );
+	}
+
 	void test_ScoreFunction_list_options_read_in_sync() {
 		using namespace utility::keys;
 		TS_ASSERT( true );
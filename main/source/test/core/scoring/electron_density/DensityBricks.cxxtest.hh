@@ -0,0 +1,133 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/scoring/electron_density/DensityBricks.cxxtest.hh
+/// @brief  Test that a map read brick by brick scores as the same map read whole
+
+// Test headers
+#include <cxxtest/TestSuite.h>
+#include <test/core/init_util.hh>
+#include <test/util/pose_funcs.hh>
+
+// Unit headers
+#include <core/scoring/electron_density/ElectronDensity.hh>
+
+// Project headers
+#include <core/pose/Pose.hh>
+#include <core/types.hh>
+#include <basic/options/option.hh>
+#include <basic/options/keys/edensity.OptionKeys.gen.hh>
+
+// Numeric headers
+#include <numeric/xyzVector.hh>
+
+// ObjexxFCL headers
+#include <ObjexxFCL/FArray3D.hh>
+
+// C++ headers
+#include <cmath>
+#include <cstdio>
+
+using namespace core;
+using core::scoring::electron_density::ElectronDensity;
+
+class DensityBricksTests : public CxxTest::TestSuite {
+
+public:
+	void setUp() {
+		core_init();
+	}
+
+	void tearDown() {
+		basic::options::option[ basic::options::OptionKeys::edensity::bricked_map ].value( false );
+		std::remove( mapfile_ );
+	}
+
+	/// @brief A map large enough that bricks are computed from boxes smaller than the map along some axes
+	void write_test_map() {
+		ObjexxFCL::FArray3D< float > map( 48, 40, 56 );
+		for ( int z = 1; z <= map.u3(); ++z ) {
+			for ( int y = 1; y <= map.u2(); ++y ) {
+				for ( int x = 1; x <= map.u1(); ++x ) {
+					map( x, y, z ) = std::sin( 0.4 * x ) * std::cos( 0.3 * y + 0.2 * z ) + 0.05 * ( ( x * 7 + y * 13 + z * 29 ) % 11 );
+				}
+			}
+		}
+		ElectronDensity( map, 1.5 ).writeMRC( mapfile_ );
+	}
+
+	void test_bricked_map_matches_whole_map() {
+		write_test_map();
+
+		ElectronDensity whole;
+		TS_ASSERT( whole.readMRCandResize( mapfile_, 4.0, 0.0 ) );
+		TS_ASSERT( ! whole.is_bricked() );
+
+		basic::options::option[ basic::options::OptionKeys::edensity::bricked_map ].value( true );
+		basic::options::option[ basic::options::OptionKeys::edensity::brick_size ].value( 8 );
+		ElectronDensity bricked;
+		TS_ASSERT( bricked.readMRCandResize( mapfile_, 4.0, 0.0 ) );
+		TS_ASSERT( bricked.is_bricked() );
+
+		TS_ASSERT_DELTA( whole.getMean(), bricked.getMean(), 1e-10 );
+		TS_ASSERT_DELTA( whole.getStdev(), bricked.getStdev(), 1e-10 );
+		for ( int z = 1; z <= 56; z += 5 ) {
+			for ( int y = 1; y <= 40; y += 3 ) {
+				for ( int x = 1; x <= 48; x += 7 ) {
+					TS_ASSERT_EQUALS( whole.get( x, y, z ), bricked.get( x, y, z ) );
+				}
+			}
+		}
+
+		for ( Size ii = 0; ii < 40; ++ii ) {
+			numeric::xyzVector< Real > X( 1.7 * ii, 80.0 - 1.9 * ii, 3.1 * ii - 20.0 ), whole_grad, bricked_grad;
+			TS_ASSERT_DELTA( whole.matchPointFast( X ), bricked.matchPointFast( X ), 1e-6 );
+			whole.dCCdx_PointFast( X, whole_grad );
+			bricked.dCCdx_PointFast( X, bricked_grad );
+			TS_ASSERT_DELTA( whole_grad.distance( bricked_grad ), 0.0, 1e-6 );
+			TS_ASSERT_DELTA( whole.get( X ), bricked.get( X ), 1e-6 );
+			TS_ASSERT_DELTA( whole.grad( X ).distance( bricked.grad( X ) ), 0.0, 1e-6 );
+		}
+
+		pose::Pose pose( create_test_in_pdb_pose() );
+		TS_ASSERT_DELTA( whole.matchPose( pose ), bricked.matchPose( pose ), 1e-10 );
+
+		// none of the above needed the whole map
+		TS_ASSERT( bricked.is_bricked() );
+	}
+
+	/// @brief get_data() reads a bricked map whole, through a const reference too, and scoring stays bricked
+	void test_get_data_of_bricked_map() {
+		write_test_map();
+
+		ElectronDensity whole;
+		TS_ASSERT( whole.readMRCandResize( mapfile_, 4.0, 0.0 ) );
+
+		basic::options::option[ basic::options::OptionKeys::edensity::bricked_map ].value( true );
+		basic::options::option[ basic::options::OptionKeys::edensity::brick_size ].value( 8 );
+		ElectronDensity bricked;
+		TS_ASSERT( bricked.readMRCandResize( mapfile_, 4.0, 0.0 ) );
+
+		ElectronDensity const & const_bricked( bricked );
+		ObjexxFCL::FArray3D< float > const & data( const_bricked.get_data() );
+		ObjexxFCL::FArray3D< float > const & whole_data( whole.get_data() );
+		TS_ASSERT_EQUALS( data.u1(), whole_data.u1() );
+		TS_ASSERT_EQUALS( data.u2(), whole_data.u2() );
+		TS_ASSERT_EQUALS( data.u3(), whole_data.u3() );
+		if ( data.size() == whole_data.size() ) {
+			for ( Size ii = 0; ii < data.size(); ++ii ) TS_ASSERT_EQUALS( data[ ii ], whole_data[ ii ] );
+		}
+		TS_ASSERT( bricked.is_bricked() );
+		TS_ASSERT_EQUALS( &bricked.get_data(), &data );
+	}
+
+private:
+	char const * mapfile_ = "core/scoring/electron_density/DensityBricks_test.mrc";
+
+};
@@ -47,6 +47,8 @@
 
 // Basic headers
 #include <basic/Tracer.hh>
+#include <basic/options/option.hh>
+#include <basic/options/keys/score.OptionKeys.gen.hh>
 
 // Utility headers
 #include <utility/vector1.hh>
@@ -150,6 +152,51 @@ public:
 		TS_ASSERT_DELTA( emap[ fa_sol ],  0.5689286245924211, 1e-12 );
 	}
 
+	/// @brief The structure-of-arrays residue-pair kernel must give exactly the energies of
+	/// the atom-by-atom loop for every residue pair, for both etable evaluators.
+	void test_soa_kernel_matches_atom_by_atom_evaluation()
+	{
+		using namespace core::pose;
+		using namespace core::scoring;
+		using namespace core::scoring::etable;
+		using namespace core::scoring::methods;
+
+		Pose pose = create_trpcage_ideal_pose();
+		EnergyMethodOptions table_options, analytic_options;
+		table_options.analytic_etable_evaluation( false );
+		analytic_options.analytic_etable_evaluation( true );
+		Etable const & etable( *( ScoringManager::get_instance()->etable( table_options.etable_type() ).lock() ) );
+
+		// The evaluators read -score:etable_soa_kernel on construction; restore it afterwards so
+		// that the later tests in this suite see the default.
+		basic::options::BooleanOptionKey const & soa_key( basic::options::OptionKeys::score::etable_soa_kernel );
+		bool const soa_default( basic::options::option[ soa_key ]() );
+		basic::options::option[ soa_key ].value( true );
+		TableLookupEtableEnergy table_soa( etable, table_options );
+		AnalyticEtableEnergy analytic_soa( etable, analytic_options );
+		basic::options::option[ soa_key ].value( false );
+		TableLookupEtableEnergy table_scalar( etable, table_options );
+		AnalyticEtableEnergy analytic_scalar( etable, analytic_options );
+		basic::options::option[ soa_key ].value( soa_default );
+
+		ScoreFunction sfxn;
+		for ( Size ii = 1; ii <= pose.size(); ++ii ) {
+			for ( Size jj = ii + 1; jj <= pose.size(); ++jj ) {
+				EnergyMap emap_table_soa, emap_table_scalar, emap_analytic_soa, emap_analytic_scalar;
+				table_soa.residue_pair_energy( pose.residue( ii ), pose.residue( jj ), pose, sfxn, emap_table_soa );
+				table_scalar.residue_pair_energy( pose.residue( ii ), pose.residue( jj ), pose, sfxn, emap_table_scalar );
+				analytic_soa.residue_pair_energy( pose.residue( ii ), pose.residue( jj ), pose, sfxn, emap_analytic_soa );
+				analytic_scalar.residue_pair_energy( pose.residue( ii ), pose.residue( jj ), pose, sfxn, emap_analytic_scalar );
+				TS_ASSERT_EQUALS( emap_table_soa[ fa_atr ], emap_table_scalar[ fa_atr ] );
+				TS_ASSERT_EQUALS( emap_table_soa[ fa_rep ], emap_table_scalar[ fa_rep ] );
+				TS_ASSERT_EQUALS( emap_table_soa[ fa_sol ], emap_table_scalar[ fa_sol ] );
+				TS_ASSERT_EQUALS( emap_analytic_soa[ fa_atr ], emap_analytic_scalar[ fa_atr ] );
+				TS_ASSERT_EQUALS( emap_analytic_soa[ fa_rep ], emap_analytic_scalar[ fa_rep ] );
+				TS_ASSERT_EQUALS( emap_analytic_soa[ fa_sol ], emap_analytic_scalar[ fa_sol ] );
+			}
+		}
+	}
+
 	void test_eval_residue_pair_energy_w_minimization_data()
 	{
 		using namespace core::pose;
@@ -0,0 +1,140 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   core/scoring/hbonds/HBondBatch.cxxtest.hh
+/// @brief  Test that the batched hbond evaluation matches the evaluation of one hbond at a time
+
+// Test headers
+#include <cxxtest/TestSuite.h>
+#include <test/core/init_util.hh>
+#include <test/util/pose_funcs.hh>
+
+// Package headers
+#include <core/scoring/hbonds/constants.hh>
+#include <core/scoring/hbonds/HBEvalParams.hh>
+#include <core/scoring/hbonds/HBondBatch.hh>
+#include <core/scoring/hbonds/HBondDatabase.hh>
+#include <core/scoring/hbonds/HBondOptions.hh>
+#include <core/scoring/hbonds/FadeInterval.hh>
+#include <core/scoring/hbonds/polynomial.hh>
+#include <core/scoring/hbonds/hbonds.hh>
+#include <core/scoring/hbonds/hbonds_geom.hh>
+#include <core/scoring/hbonds/types.hh>
+
+// Project headers
+#include <core/conformation/Residue.hh>
+#include <core/pose/Pose.hh>
+#include <core/types.hh>
+
+using namespace core;
+using core::scoring::DerivVectorPair;
+using namespace core::scoring::hbonds;
+
+/// @brief The batched kernel may round differently from the scalar one (e.g. once the compiler
+/// vectorizes or contracts it into fused multiply-adds), so compare to a tight tolerance
+static Real const TOL( 1e-9 );
+
+class HBondBatchTests : public CxxTest::TestSuite {
+
+public:
+	void setUp() {
+		core_init();
+	}
+
+	void tearDown() {}
+
+	void assert_same_fade( FadeIntervalCOP fade, HBFadeParams const & params, Real const lo, Real const hi ) {
+		for ( Size ii = 0; ii <= 400; ++ii ) {
+			Real const x( lo + ( hi - lo ) * ii / 400 );
+			double val, deriv, params_val, params_deriv;
+			fade->value_deriv( x, val, deriv );
+			params.value_deriv( x, params_val, params_deriv );
+			TS_ASSERT_DELTA( val, params_val, TOL );
+			TS_ASSERT_DELTA( deriv, params_deriv, TOL );
+		}
+	}
+
+	void assert_same_poly( Polynomial_1dCOP poly, HBPolyParams const & params ) {
+		Real const lo( poly->xmin() - 0.5 ), hi( poly->xmax() + 0.5 );
+		for ( Size ii = 0; ii <= 400; ++ii ) {
+			Real const x( lo + ( hi - lo ) * ii / 400 );
+			double val, deriv, params_val, params_deriv;
+			(*poly)( x, val, deriv );
+			params.value_deriv( x, params_val, params_deriv );
+			TS_ASSERT_DELTA( val, params_val, TOL );
+			TS_ASSERT_DELTA( deriv, params_deriv, TOL );
+		}
+	}
+
+	/// @brief The flattened parameters give the same values as the FadeIntervals and Polynomial_1ds they came from
+	void test_eval_params_match_database() {
+		HBondDatabaseCOP database( HBondDatabase::get_database() );
+		for ( Size hbe = 1; hbe <= HB_EVAL_TYPE_COUNT; ++hbe ) {
+			if ( ! database->AHdist_poly_lookup( hbe ) ) continue;
+			HBEvalParams const & params( database->eval_params_lookup( hbe ) );
+			assert_same_fade( database->AHdist_short_fade_lookup( hbe ), params.AHdist_short_fade, 1.0, 3.5 );
+			assert_same_fade( database->AHdist_long_fade_lookup( hbe ), params.AHdist_long_fade, 1.0, 3.5 );
+			assert_same_fade( database->cosBAH_fade_lookup( hbe ), params.cosBAH_fade, -1.0, 1.0 );
+			assert_same_fade( database->cosBAH2_fade_lookup( hbe ), params.cosBAH2_fade, -1.0, 1.0 );
+			assert_same_fade( database->cosAHD_fade_lookup( hbe ), params.cosAHD_fade, -1.0, 1.0 );
+			assert_same_poly( database->AHdist_poly_lookup( hbe ), params.AHdist_poly );
+			assert_same_poly( database->cosBAH_short_poly_lookup( hbe ), params.cosBAH_short_poly );
+			assert_same_poly( database->cosBAH_long_poly_lookup( hbe ), params.cosBAH_long_poly );
+			assert_same_poly( database->cosBAH2_poly_lookup( hbe ), params.cosBAH2_poly );
+			assert_same_poly( database->cosAHD_short_poly_lookup( hbe ), params.cosAHD_short_poly );
+			assert_same_poly( database->cosAHD_long_poly_lookup( hbe ), params.cosAHD_long_poly );
+		}
+	}
+
+	void assert_same_deriv( DerivVectorPair const & a, DerivVectorPair const & b ) {
+		TS_ASSERT_DELTA( a.f1().distance( b.f1() ), 0.0, TOL );
+		TS_ASSERT_DELTA( a.f2().distance( b.f2() ), 0.0, TOL );
+	}
+
+	/// @brief Every candidate pair of the test pose gets the energy and derivatives of hb_energy_deriv()
+	void test_batch_matches_hb_energy_deriv() {
+		pose::Pose pose( create_test_in_pdb_pose() );
+		HBondDatabaseCOP database( HBondDatabase::get_database() );
+		HBondOptions options;
+
+		HBondBatch batch;
+		Size n_hbonds( 0 );
+		for ( Size ii = 1; ii <= pose.size(); ++ii ) {
+			for ( Size jj = 1; jj <= pose.size(); ++jj ) {
+				if ( ii == jj ) continue;
+				conformation::Residue const & don_rsd( pose.residue( ii ) ), & acc_rsd( pose.residue( jj ) );
+				if ( don_rsd.nbr_atom_xyz().distance_squared( acc_rsd.nbr_atom_xyz() ) > 144 ) continue;
+
+				batch.clear();
+				add_hbond_candidates_1way( don_rsd, acc_rsd, false, false, false, false, batch );
+				batch.evaluate( *database, options, true );
+
+				for ( Size kk = 1; kk <= batch.size(); ++kk ) {
+					Size const hatm( batch.hatm( kk ) ), aatm( batch.aatm( kk ) );
+					Real energy;
+					HBondDerivs derivs;
+					hb_energy_deriv( *database, options, batch.hbt( kk ),
+						don_rsd.xyz( don_rsd.atom_base( hatm ) ), don_rsd.xyz( hatm ),
+						acc_rsd.xyz( aatm ), acc_rsd.xyz( acc_rsd.atom_base( aatm ) ), acc_rsd.xyz( acc_rsd.abase2( aatm ) ),
+						energy, true, derivs );
+					TS_ASSERT_DELTA( energy, batch.energy( kk ), TOL );
+					if ( energy >= MAX_HB_ENERGY || batch.energy( kk ) >= MAX_HB_ENERGY ) continue;
+					++n_hbonds;
+					assert_same_deriv( derivs.h_deriv, batch.derivs( kk ).h_deriv );
+					assert_same_deriv( derivs.don_deriv, batch.derivs( kk ).don_deriv );
+					assert_same_deriv( derivs.acc_deriv, batch.derivs( kk ).acc_deriv );
+					assert_same_deriv( derivs.abase_deriv, batch.derivs( kk ).abase_deriv );
+					assert_same_deriv( derivs.abase2_deriv, batch.derivs( kk ).abase2_deriv );
+				}
+			}
+		}
+		TS_ASSERT( n_hbonds > 0 );
+	}
+
+};
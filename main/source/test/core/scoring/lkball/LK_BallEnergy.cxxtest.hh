@@ -332,4 +332,58 @@ public:
 		adv.simple_deriv_check( true, 5e-3 );
 	}
 
+	/// @brief The waters placed in one pass for many residues are those placed one residue at a time
+	void test_batch_waters_match_build_waters()
+	{
+		core::pose::Pose pose = create_trpcage_ideal_pose();
+		utility::vector1< LKB_ResidueInfoOP > batch_infos;
+		WaterBatchBuilder waters;
+		for ( Size ii = 1; ii <= pose.size(); ++ii ) {
+			LKB_ResidueInfoOP info( new LKB_ResidueInfo );
+			info->initialize( pose.residue( ii ).type() );
+			waters.add( *info, pose.residue( ii ) );
+			batch_infos.push_back( info );
+		}
+		TS_ASSERT( waters.n_waters() > 0 );
+		waters.build();
+
+		for ( Size ii = 1; ii <= pose.size(); ++ii ) {
+			LKB_ResidueInfo info( pose.residue( ii ) );
+			TS_ASSERT( batch_infos[ ii ]->waters_current( pose.residue( ii ) ) );
+			TS_ASSERT_EQUALS( info.waters().size(), batch_infos[ ii ]->waters().size() );
+			for ( Size jj = 1; jj <= info.waters().size(); ++jj ) {
+				TS_ASSERT_EQUALS( info.waters()[ jj ], batch_infos[ ii ]->waters()[ jj ] );
+			}
+		}
+	}
+
+	/// @brief The waters are rebuilt when, and only when, the atoms they are built from move
+	void test_waters_rebuilt_when_stub_atoms_move()
+	{
+		core::pose::Pose pose = create_trpcage_ideal_pose();
+		conformation::Residue rsd( pose.residue( 6 ) );
+		LKB_ResidueInfo info( rsd, true );
+		TS_ASSERT( info.has_waters() );
+		TS_ASSERT( info.waters_current( rsd ) );
+
+		WaterBuilder const & builder( info.get_water_builder( rsd, 1 )[ 1 ] );
+		rsd.set_xyz( builder.atom2(), rsd.xyz( builder.atom2() ) + Vector( 0.1, -0.2, 0.3 ) );
+		TS_ASSERT( ! info.waters_current( rsd ) );
+
+		info.build_waters( rsd, false );
+		TS_ASSERT( info.waters_current( rsd ) );
+		LKB_ResidueInfo fresh( rsd, true );
+		for ( Size jj = 1; jj <= info.waters().size(); ++jj ) {
+			TS_ASSERT_EQUALS( info.waters()[ jj ], fresh.waters()[ jj ] );
+		}
+
+		// the derivatives were not computed for the moved atoms; asking for them recomputes them
+		info.build_waters( rsd, true );
+		for ( Size jj = 1; jj <= info.waters().size(); ++jj ) {
+			TS_ASSERT_EQUALS( info.atom1_derivs()[ jj ], fresh.atom1_derivs()[ jj ] );
+			TS_ASSERT_EQUALS( info.atom2_derivs()[ jj ], fresh.atom2_derivs()[ jj ] );
+			TS_ASSERT_EQUALS( info.atom3_derivs()[ jj ], fresh.atom3_derivs()[ jj ] );
+		}
+	}
+
 };
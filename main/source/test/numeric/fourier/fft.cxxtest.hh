@@ -19,11 +19,17 @@
 
 // Unit headers
 #include <numeric/fourier/FFT.hh>
+#include <numeric/fourier/kiss_fft.hh>
+#include <numeric/types.hh>
+#include <utility/vector1.hh>
 #include <ObjexxFCL/FArray1D.hh>
 #include <ObjexxFCL/FArray2D.hh>
 #include <ObjexxFCL/FArray3D.hh>
 
+#include <cmath>
 #include <complex>
+#include <functional>
+#include <vector>
 
 class FFTTests : public CxxTest::TestSuite {
 
@@ -123,6 +129,93 @@ class FFTTests : public CxxTest::TestSuite {
 		TS_ASSERT_DELTA( err, 0.0, 1e-6);
 	}
 
+	/// @brief fill an n1 x n2 x n3 map with some values
+	void fill_map( ObjexxFCL::FArray3D< double > & x, int n1, int n2, int n3 ) {
+		x.dimension(n1,n2,n3);
+		for (int i=0; i<n1*n2*n3; ++i) {
+			x[i] = std::sin( 0.37*i ) + 0.01*(i%11);
+		}
+	}
+
+	/// @brief the 3D transform agrees with the kiss-fft nd transform, for sizes that are odd and have a factor of 7
+	void test_3D_transform_matches_kiss_fftnd() {
+		int const n1=10, n2=7, n3=9, N=n1*n2*n3;
+		ObjexxFCL::FArray3D< double > xr;
+		fill_map( xr, n1, n2, n3 );
+		ObjexxFCL::FArray3D< std::complex< double > > x, fx;
+		x.dimension(n1,n2,n3);
+		for (int i=0; i<N; ++i) x[i] = std::complex< double >( xr[i], std::cos( 0.11*i ) );
+
+		numeric::fourier::kiss_fftnd_state state;
+		std::vector< int > dims(3);
+		dims[0]=n3; dims[1]=n2; dims[2]=n1;
+		state.resize( dims, 0 );
+		std::vector< std::complex< double > > reference( N );
+		kiss_fftnd( &state, &x[0], &reference[0] );
+
+		numeric::fourier::fft3( x, fx );
+		double err = 0.0;
+		for (int i=0; i<N; ++i) err += std::norm(fx[i]-reference[i]);
+		TS_ASSERT_DELTA( err, 0.0, 1e-12);
+	}
+
+	/// @brief real maps (double or float) transform to the same spectrum as their complex copies
+	void test_3D_real_transform() {
+		int const n1=12, n2=9, n3=5, N=n1*n2*n3;
+		ObjexxFCL::FArray3D< double > xr;
+		fill_map( xr, n1, n2, n3 );
+		ObjexxFCL::FArray3D< float > xf;
+		xf.dimension(n1,n2,n3);
+		ObjexxFCL::FArray3D< std::complex< double > > x, fx, fxr, fxf;
+		x.dimension(n1,n2,n3);
+		for (int i=0; i<N; ++i) {
+			x[i] = xr[i];
+			xf[i] = (float) xr[i];
+		}
+
+		numeric::fourier::fft3( x, fx );
+		numeric::fourier::fft3( xr, fxr );
+		numeric::fourier::fft3( xf, fxf );
+		double err = 0.0, err_float = 0.0;
+		for (int i=0; i<N; ++i) {
+			err += std::norm(fxr[i]-fx[i]);
+			err_float += std::norm(fxf[i]-fx[i]);
+		}
+		TS_ASSERT_DELTA( err, 0.0, 1e-12);
+		TS_ASSERT_DELTA( err_float, 0.0, 1e-6);
+
+		// and back
+		ObjexxFCL::FArray3D< double > yr;
+		numeric::fourier::ifft3( fxr, yr );
+		err = 0.0;
+		for (int i=0; i<N; ++i) err += (yr[i]-xr[i])*(yr[i]-xr[i]);
+		TS_ASSERT_DELTA( err, 0.0, 1e-12);
+	}
+
+	/// @brief splitting the transform into jobs gives the same result, whatever order the jobs run in
+	void test_3D_transform_with_runner() {
+		int const n1=8, n2=6, n3=15, N=n1*n2*n3;
+		ObjexxFCL::FArray3D< double > xr;
+		fill_map( xr, n1, n2, n3 );
+
+		numeric::Size n_jobs = 0;
+		numeric::fourier::FFTJobRunner runner = [&n_jobs]( utility::vector1< std::function< void () > > const & jobs ) {
+			for ( numeric::Size i=jobs.size(); i>=1; --i ) jobs[i]();
+			n_jobs += jobs.size();
+		};
+
+		ObjexxFCL::FArray3D< std::complex< double > > fx, fx_jobs;
+		numeric::fourier::fft3( xr, fx );
+		numeric::fourier::fft3( xr, fx_jobs, runner );
+		TS_ASSERT( n_jobs > 2 );
+		for (int i=0; i<N; ++i) TS_ASSERT_EQUALS( fx[i], fx_jobs[i] );
+
+		ObjexxFCL::FArray3D< double > y, y_jobs;
+		numeric::fourier::ifft3( fx, y );
+		numeric::fourier::ifft3( fx, y_jobs, runner );
+		for (int i=0; i<N; ++i) TS_ASSERT_EQUALS( y[i], y_jobs[i] );
+	}
+
 };
 
 
@@ -0,0 +1,129 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   protocols/cluster/CoordinateDistanceMatrix.cxxtest.hh
+/// @brief  test suite for the tiled all-vs-all coordinate RMSD matrix
+
+// Test headers
+#include <cxxtest/TestSuite.h>
+#include <test/core/init_util.hh>
+#include <test/util/pose_funcs.hh>
+
+#include <protocols/cluster/CoordinateDistanceMatrix.hh>
+
+#include <core/conformation/Residue.hh>
+#include <core/id/AtomID.hh>
+#include <core/pose/Pose.hh>
+#include <core/scoring/rms_util.hh>
+
+#include <utility/file/file_sys_util.hh>
+#include <utility/vector1.hh>
+
+#include <vector>
+
+using namespace protocols::cluster;
+using core::Size;
+
+class CoordinateDistanceMatrixTests : public CxxTest::TestSuite {
+
+public:
+
+	void setUp() {
+		core_init();
+
+		// Trp-cage with a different kink at each of a few positions
+		core::pose::Pose const trpcage = create_trpcage_ideal_pose();
+		poses_.clear();
+		for ( Size ii = 0; ii < 11; ++ii ) {
+			core::pose::Pose pose( trpcage );
+			pose.set_phi( 3 + ii, pose.phi( 3 + ii ) + 10.0 * ii );
+			pose.set_psi( 10, pose.psi( 10 ) - 7.0 * ii );
+			poses_.push_back( pose );
+		}
+
+		atoms_.clear();
+		for ( Size ii = 1; ii <= trpcage.size(); ++ii ) {
+			atoms_.push_back( core::id::AtomID( trpcage.residue( ii ).atom_index( "CA" ), ii ) );
+		}
+	}
+
+	void tearDown() {}
+
+	void test_matches_pose_rmsd() {
+		CoordinateDistanceMatrix matrix;
+		matrix.block_size( 4 ); // several tiles, the last ones partial
+		matrix.set_coordinates( poses_, atoms_ );
+		TS_ASSERT_EQUALS( matrix.size(), poses_.size() );
+		TS_ASSERT_EQUALS( matrix.natoms(), atoms_.size() );
+		matrix.compute();
+		TS_ASSERT( ! matrix.on_disk() );
+		TS_ASSERT_EQUALS( matrix.n_entries(), poses_.size() * ( poses_.size() - 1 ) / 2 );
+
+		for ( Size ii = 1; ii <= poses_.size(); ++ii ) {
+			TS_ASSERT_EQUALS( matrix( ii, ii ), 0.0f );
+			for ( Size jj = ii + 1; jj <= poses_.size(); ++jj ) {
+				TS_ASSERT_DELTA( matrix( ii, jj ), core::scoring::CA_rmsd( poses_[ ii - 1 ], poses_[ jj - 1 ] ), 1e-3 );
+				TS_ASSERT_EQUALS( matrix( ii, jj ), matrix( jj, ii ) );
+			}
+		}
+	}
+
+	void test_scratch_file() {
+		std::string const scratch( "CoordinateDistanceMatrix_test.bin" );
+
+		CoordinateDistanceMatrix in_memory;
+		in_memory.block_size( 3 );
+		in_memory.set_coordinates( poses_, atoms_ );
+		in_memory.compute();
+
+		{
+			CoordinateDistanceMatrix on_disk;
+			on_disk.block_size( 3 );
+			on_disk.memory_limit( 16 * sizeof( float ) ); // a row of blocks at a time
+			on_disk.scratch_file( scratch );
+			on_disk.set_coordinates( poses_, atoms_ );
+			on_disk.compute();
+			TS_ASSERT( on_disk.on_disk() );
+			TS_ASSERT( utility::file::file_exists( scratch ) );
+
+			for ( Size ii = 1; ii <= poses_.size(); ++ii ) {
+				for ( Size jj = 1; jj <= poses_.size(); ++jj ) {
+					TS_ASSERT_EQUALS( on_disk( ii, jj ), in_memory( ii, jj ) );
+				}
+			}
+		}
+		// The scratch file goes with the matrix
+		TS_ASSERT( ! utility::file::file_exists( scratch ) );
+	}
+
+	/// @brief Without a scratch_file(), each matrix gets a file of its own.
+	void test_default_scratch_files_are_unique() {
+		std::string first_path;
+		{
+			CoordinateDistanceMatrix first, second;
+			for ( CoordinateDistanceMatrix * matrix : { &first, &second } ) {
+				matrix->block_size( 3 );
+				matrix->memory_limit( 16 * sizeof( float ) );
+				matrix->set_coordinates( poses_, atoms_ );
+				matrix->compute();
+				TS_ASSERT( matrix->on_disk() );
+				TS_ASSERT( utility::file::file_exists( matrix->scratch_path() ) );
+			}
+			TS_ASSERT_DIFFERS( first.scratch_path(), second.scratch_path() );
+			TS_ASSERT_EQUALS( first( 2, 9 ), second( 2, 9 ) );
+			first_path = first.scratch_path();
+		}
+		TS_ASSERT( ! utility::file::file_exists( first_path ) );
+	}
+
+private:
+	std::vector< core::pose::Pose > poses_;
+	utility::vector1< core::id::AtomID > atoms_;
+
+};
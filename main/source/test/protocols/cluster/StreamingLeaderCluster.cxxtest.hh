@@ -0,0 +1,110 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   protocols/cluster/StreamingLeaderCluster.cxxtest.hh
+/// @brief  test suite for leader clustering with a metric index
+
+// Test headers
+#include <cxxtest/TestSuite.h>
+#include <test/core/init_util.hh>
+
+#include <protocols/cluster/StreamingLeaderCluster.hh>
+
+#include <numeric/random/random.hh>
+
+#include <cmath>
+#include <vector>
+
+using namespace protocols::cluster;
+using core::Size;
+
+class StreamingLeaderClusterTests : public CxxTest::TestSuite {
+
+public:
+
+	void setUp() {
+		core_init();
+	}
+
+	void tearDown() {}
+
+	void test_rigid_copies_join_their_leader() {
+		std::vector< float > const base = random_chain();
+		StreamingLeaderCluster clusters( 0.5, n_atoms_ );
+
+		StreamingLeaderCluster::Assignment const first = clusters.add( base.data() );
+		TS_ASSERT( first.new_leader );
+		TS_ASSERT_EQUALS( first.leader, 1u );
+
+		for ( Size ii = 1; ii <= 5; ++ii ) {
+			StreamingLeaderCluster::Assignment const copy = clusters.add( structure( base, 0.0f ).data() );
+			TS_ASSERT( ! copy.new_leader );
+			TS_ASSERT_EQUALS( copy.leader, 1u );
+			TS_ASSERT_DELTA( copy.distance, 0.0, 0.02 ); // single-precision QCP
+		}
+		TS_ASSERT_EQUALS( clusters.n_leaders(), 1u );
+		TS_ASSERT_EQUALS( clusters.cluster_size( 1 ), 6u );
+		TS_ASSERT_EQUALS( clusters.n_structures(), 6u );
+	}
+
+	/// @brief The index changes only which leaders are compared, never the clustering
+	void test_index_matches_exhaustive_leader_clustering() {
+		std::vector< std::vector< float > > bases;
+		for ( Size ii = 1; ii <= 12; ++ii ) bases.push_back( random_chain() );
+
+		StreamingLeaderCluster indexed( 1.5, n_atoms_ ), exhaustive( 1.5, n_atoms_ );
+		indexed.n_pivots( 4 );
+		exhaustive.use_index( false );
+		for ( Size ii = 0; ii < 600; ++ii ) {
+			std::vector< float > const xyz = structure( bases[ ii % bases.size() ], 0.2f + 0.15f * ( ii % 8 ) );
+			StreamingLeaderCluster::Assignment const a = indexed.add( xyz.data() );
+			StreamingLeaderCluster::Assignment const b = exhaustive.add( xyz.data() );
+			TS_ASSERT_EQUALS( a.leader, b.leader );
+			TS_ASSERT_EQUALS( a.new_leader, b.new_leader );
+			TS_ASSERT_EQUALS( a.distance, b.distance );
+			TS_ASSERT( a.distance < 1.5 );
+		}
+		TS_ASSERT_EQUALS( indexed.n_leaders(), exhaustive.n_leaders() );
+		for ( Size ii = 1; ii <= indexed.n_leaders(); ++ii ) {
+			TS_ASSERT_EQUALS( indexed.cluster_size( ii ), exhaustive.cluster_size( ii ) );
+		}
+		TS_ASSERT( indexed.n_leaders() > 12 );
+		TS_ASSERT( indexed.n_rmsd_evaluations() < exhaustive.n_rmsd_evaluations() );
+	}
+
+private:
+	/// @brief A copy of base, perturbed by noise, rotated about z and translated
+	std::vector< float > structure( std::vector< float > const & base, float noise ) {
+		std::vector< float > xyz( base );
+		float const angle = numeric::random::rg().uniform() * 6.28f;
+		float const c = std::cos( angle ), s = std::sin( angle );
+		for ( Size ii = 0; ii < n_atoms_; ++ii ) {
+			float const x = xyz[ 3 * ii ] + noise * numeric::random::rg().gaussian();
+			float const y = xyz[ 3 * ii + 1 ] + noise * numeric::random::rg().gaussian();
+			xyz[ 3 * ii ] = c * x - s * y + 10.0f;
+			xyz[ 3 * ii + 1 ] = s * x + c * y - 4.0f;
+			xyz[ 3 * ii + 2 ] += noise * numeric::random::rg().gaussian() + 1.0f;
+		}
+		return xyz;
+	}
+
+	std::vector< float > random_chain() {
+		std::vector< float > xyz( 3 * n_atoms_ );
+		for ( Size ii = 0; ii < n_atoms_; ++ii ) {
+			xyz[ 3 * ii ] = 3.8f * ii;
+			xyz[ 3 * ii + 1 ] = 4.0f * numeric::random::rg().gaussian();
+			xyz[ 3 * ii + 2 ] = 4.0f * numeric::random::rg().gaussian();
+		}
+		return xyz;
+	}
+
+private:
+	Size const n_atoms_ = 30;
+
+};
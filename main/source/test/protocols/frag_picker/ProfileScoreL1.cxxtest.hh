@@ -0,0 +1,125 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   protocols/frag_picker/ProfileScoreL1.cxxtest.hh
+/// @brief  test the L1 profile scores against sums computed by hand
+
+// Test headers
+#include <cxxtest/TestSuite.h>
+#include <test/core/init_util.hh>
+
+#include <protocols/frag_picker/FragmentCandidate.hh>
+#include <protocols/frag_picker/VallChunk.hh>
+#include <protocols/frag_picker/VallResidue.hh>
+#include <protocols/frag_picker/scores/FragmentScoreMap.hh>
+#include <protocols/frag_picker/scores/ProfileScoreL1.hh>
+#include <protocols/frag_picker/scores/ProfileScoreStructL1.hh>
+#include <protocols/frag_picker/scores/fragment_scoring_utilities.hh>
+
+#include <core/sequence/SequenceProfile.hh>
+#include <core/types.hh>
+
+#include <utility/vector1.hh>
+
+#include <cmath>
+#include <cstdio>
+
+using namespace core;
+using namespace protocols::frag_picker;
+using namespace protocols::frag_picker::scores;
+
+class ProfileScoreL1Tests : public CxxTest::TestSuite {
+public:
+
+	void setUp() {
+		core_init();
+	}
+
+	/// @brief three query positions, two columns: the last query position of a column sits next to
+	/// the first position of the following column in the transposed profile
+	void test_l1_profile_scores_by_hand() {
+		Matrix query( 3 );
+		query[1] = utility::vector1< Real >{ 0.1, 0.5 };
+		query[2] = utility::vector1< Real >{ 0.4, 0.2 };
+		query[3] = utility::vector1< Real >{ 0.0, 1.0 };
+		utility::vector1< Real > columns;
+		transpose_profile( query, 2, columns );
+		TS_ASSERT_EQUALS( columns.size(), 6u );
+		TS_ASSERT_EQUALS( columns[3], 0.0 );
+		TS_ASSERT_EQUALS( columns[4], 0.5 );
+
+		utility::vector1< Real > scores;
+		l1_profile_scores( columns, 3, utility::vector1< Real >{ 0.3, 0.3 }, 2, scores );
+		TS_ASSERT_EQUALS( scores.size(), 3u );
+		TS_ASSERT_DELTA( scores[1], 0.4, 1e-12 );
+		TS_ASSERT_DELTA( scores[2], 0.2, 1e-12 );
+		TS_ASSERT_DELTA( scores[3], 1.0, 1e-12 );
+	}
+
+	/// @brief cached and uncached scores of fragments at the first and last query and Vall positions
+	void test_profile_scores_match_hand_sums() {
+		Size const query_len( 7 ), chunk_len( 6 ), frag_len( 3 );
+
+		Matrix query( query_len );
+		for ( Size i = 1; i <= query_len; ++i ) {
+			for ( Size k = 1; k <= 20; ++k ) query[i].push_back( Real( ( i*7 + k*3 ) % 11 ) / 10.0 );
+		}
+		core::sequence::SequenceProfileOP query_profile( new core::sequence::SequenceProfile( query, "ACDEFGH", "query" ) );
+
+		VallChunkOP chunk( new VallChunk( VallProviderAP() ) );
+		for ( Size j = 1; j <= chunk_len; ++j ) {
+			char line[ 256 ];
+			std::snprintf( line, sizeof( line ), "1abcA A H %lu 0 0 0.000 0.000 0.000 -60.000 -40.000 180.000 0 0 0 0", (unsigned long) j );
+			std::string text( line );
+			for ( Size k = 1; k <= 20; ++k ) text += " 0.050";
+			VallResidueOP res( new VallResidue( text ) );
+			utility::vector1< Real > profile, profile_struct;
+			for ( Size k = 1; k <= 20; ++k ) {
+				profile.push_back( Real( ( j*5 + k ) % 13 ) / 12.0 );
+				profile_struct.push_back( Real( ( j + k*2 ) % 7 ) / 6.0 );
+			}
+			res->profile( profile );
+			res->profile_struct( profile_struct );
+			chunk->push_back( res );
+		}
+
+		utility::vector1< Size > frag_sizes( 1, frag_len );
+		ProfileScoreL1 l1( 1, 1000.0, false, query_profile, frag_sizes, chunk_len );
+		ProfileScoreStructL1 struct_l1( 1, 1000.0, false, query_profile, frag_sizes, chunk_len );
+		l1.set_id( 1 );
+		struct_l1.set_id( 1 );
+
+		utility::vector1< Size > const query_starts{ 1, query_len - frag_len + 1 };
+		utility::vector1< Size > const vall_starts{ 1, chunk_len - frag_len + 1 };
+		for ( Size const qi : query_starts ) {
+			for ( Size const vj : vall_starts ) {
+				Real sum( 0.0 ), struct_sum( 0.0 );
+				for ( Size p = 0; p < frag_len; ++p ) {
+					for ( Size k = 1; k <= 20; ++k ) {
+						sum += std::abs( chunk->at( vj + p )->profile()[ k ] - query[ qi + p ][ k ] );
+						struct_sum += std::abs( chunk->at( vj + p )->profile_struct()[ k ] - query[ qi + p ][ k ] );
+					}
+				}
+				FragmentCandidateOP f( new FragmentCandidate( qi, vj, chunk, frag_len ) );
+				assert_scores( l1, f, sum / frag_len );
+				assert_scores( struct_l1, f, struct_sum / frag_len );
+			}
+		}
+	}
+
+private:
+	void assert_scores( CachingScoringMethod & method, FragmentCandidateOP f, Real const expected ) {
+		FragmentScoreMapOP cached( new FragmentScoreMap( 1 ) ), uncached( new FragmentScoreMap( 1 ) );
+		method.cached_score( f, cached );
+		method.score( f, uncached );
+		TS_ASSERT_DELTA( cached->at( 1 ), expected, 1e-9 );
+		TS_ASSERT_DELTA( uncached->at( 1 ), expected, 1e-9 );
+	}
+
+};
@@ -0,0 +1,111 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   protocols/frag_picker/VallDatabase.cxxtest.hh
+/// @brief  test suite for the compiled, memory-mapped Vall
+
+// Test headers
+#include <cxxtest/TestSuite.h>
+#include <test/core/init_util.hh>
+
+#include <protocols/frag_picker/VallChunk.hh>
+#include <protocols/frag_picker/VallDatabase.hh>
+#include <protocols/frag_picker/VallProvider.hh>
+#include <protocols/frag_picker/VallResidue.hh>
+
+#include <core/types.hh>
+
+#include <utility/file/file_sys_util.hh>
+#include <utility/vector1.hh>
+
+using namespace core;
+using namespace protocols::frag_picker;
+
+class VallDatabaseTests : public CxxTest::TestSuite {
+public:
+
+	void setUp() {
+		core_init();
+	}
+
+	void tearDown() {
+		utility::file::file_delete( compiled_ );
+	}
+
+	void test_compiled_vall_matches_text() {
+		VallProviderOP text( new VallProvider() );
+		text->vallChunksFromLibrary( vall_ );
+		VallDatabase::write( compiled_, *text );
+		TS_ASSERT( VallDatabase::is_vall_database( compiled_ ) );
+		TS_ASSERT( ! VallDatabase::is_vall_database( vall_ ) );
+
+		VallProviderOP mapped( new VallProvider() );
+		mapped->vallChunksFromLibrary( compiled_ );
+		assert_same_chunks( *text, *mapped );
+		TS_ASSERT_EQUALS( mapped->get_largest_chunk_size(), text->get_largest_chunk_size() );
+		TS_ASSERT_EQUALS( mapped->vallNumLines( compiled_ ), text->vallNumLines( vall_ ) );
+
+		// Residues dropped after use are created again, unchanged
+		VallChunkOP chunk( mapped->at( mapped->size() / 2 ) );
+		Real const phi( chunk->at( chunk->size() )->phi() );
+		chunk->release_residues();
+		TS_ASSERT_EQUALS( chunk->at( chunk->size() )->phi(), phi );
+	}
+
+	/// @brief Rows of a compiled Vall count as the lines of the text Vall, also when appending
+	void test_line_range_and_append() {
+		VallProviderOP text( new VallProvider() );
+		text->vallChunksFromLibrary( vall_ );
+		VallDatabase::write( compiled_, *text );
+
+		VallProviderOP text_range( new VallProvider() ), mapped_range( new VallProvider() );
+		text_range->vallChunksFromLibrary( vall_ );
+		mapped_range->vallChunksFromLibrary( compiled_ );
+		text_range->vallChunksFromLibrary( vall_, 150, 1200 );
+		mapped_range->vallChunksFromLibrary( compiled_, 150, 1200 );
+		assert_same_chunks( *text_range, *mapped_range );
+		TS_ASSERT_EQUALS( mapped_range->get_vall_start_line_by_key( 2 ), text_range->get_vall_start_line_by_key( 2 ) );
+		TS_ASSERT_EQUALS( mapped_range->get_vall_end_line_by_key( 2 ), text_range->get_vall_end_line_by_key( 2 ) );
+		TS_ASSERT_EQUALS( mapped_range->get_vall_last_residue_key_by_key( 2 ), text_range->get_vall_last_residue_key_by_key( 2 ) );
+	}
+
+private:
+	void assert_same_chunks( VallProvider const & text, VallProvider const & mapped ) {
+		TS_ASSERT_EQUALS( mapped.size(), text.size() );
+		for ( Size ii = 1; ii <= text.size() && ii <= mapped.size(); ++ii ) {
+			VallChunkOP const a( text.at( ii ) ), b( mapped.at( ii ) );
+			TS_ASSERT_EQUALS( b->size(), a->size() );
+			TS_ASSERT_EQUALS( b->key(), a->key() );
+			TS_ASSERT_EQUALS( b->chunk_key(), a->chunk_key() );
+			TS_ASSERT_EQUALS( b->get_sequence(), a->get_sequence() );
+			TS_ASSERT_EQUALS( b->get_chain_id(), a->get_chain_id() );
+			for ( Size jj = 1; jj <= a->size() && jj <= b->size(); ++jj ) {
+				VallResidueOP const ra( a->at( jj ) ), rb( b->at( jj ) );
+				TS_ASSERT_EQUALS( rb->key(), ra->key() );
+				TS_ASSERT_EQUALS( rb->id(), ra->id() );
+				TS_ASSERT_EQUALS( rb->ss(), ra->ss() );
+				TS_ASSERT_EQUALS( rb->resi(), ra->resi() );
+				TS_ASSERT_DELTA( rb->x(), ra->x(), 1e-4 );
+				TS_ASSERT_DELTA( rb->phi(), ra->phi(), 1e-4 );
+				TS_ASSERT_DELTA( rb->psi(), ra->psi(), 1e-4 );
+				TS_ASSERT_DELTA( rb->omega(), ra->omega(), 1e-4 );
+				TS_ASSERT_EQUALS( rb->has_chemical_shifts(), ra->has_chemical_shifts() );
+				TS_ASSERT_EQUALS( rb->profile().size(), ra->profile().size() );
+				for ( Size kk = 1; kk <= ra->profile().size() && kk <= rb->profile().size(); ++kk ) {
+					TS_ASSERT_DELTA( rb->profile()[ kk ], ra->profile()[ kk ], 1e-6 );
+				}
+			}
+		}
+	}
+
+private:
+	std::string const vall_ = "protocols/frag_picker/1a32A-H1.vall";
+	std::string const compiled_ = "VallDatabase_test.bin";
+
+};
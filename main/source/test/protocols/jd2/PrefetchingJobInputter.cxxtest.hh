@@ -0,0 +1,137 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   protocols/jd2/PrefetchingJobInputter.cxxtest.hh
+/// @brief  test suite for building the starting poses of upcoming jobs in the background
+
+// Test headers
+#include <cxxtest/TestSuite.h>
+#include <test/protocols/init_util.hh>
+
+#include <protocols/jd2/PrefetchingJobInputter.hh>
+#include <protocols/jd2/InnerJob.hh>
+#include <protocols/jd2/Job.hh>
+#include <protocols/jd2/JobsContainer.hh>
+
+#include <core/pose/Pose.hh>
+#include <core/pose/annotated_sequence.hh>
+
+#include <utility/excn/Exceptions.hh>
+
+#include <atomic>
+
+using namespace protocols::jd2;
+using core::Size;
+
+/// @brief Builds a peptide named by the input tag, once per input; the input "bad" is bad
+class PeptideJobInputter : public JobInputter
+{
+public:
+	PeptideJobInputter() : n_built_( 0 ) {}
+
+	void pose_from_job( core::pose::Pose & pose, JobOP job ) override {
+		if ( job->inner_job()->get_pose() ) {
+			pose = *job->inner_job()->get_pose();
+			return;
+		}
+		if ( job->input_tag() == "bad" ) {
+			throw CREATE_EXCEPTION( utility::excn::BadInput, "no such peptide" );
+		}
+		core::pose::make_pose_from_sequence( pose, job->input_tag(), "fa_standard" );
+		++n_built_;
+		load_pose_into_job( pose, job );
+	}
+
+	void fill_jobs( JobsContainer & jobs ) override {
+		jobs.clear();
+		for ( std::string const & input : { "ACDE", "FGHIK", "LMN", "bad", "PQRST", "VWY" } ) {
+			InnerJobOP inner( new InnerJob( input, 2 ) );
+			for ( Size ii = 1; ii <= 2; ++ii ) jobs.push_back( utility::pointer::make_shared< Job >( inner, ii ) );
+		}
+	}
+
+	JobInputterInputSource::Enum input_source() const override { return JobInputterInputSource::UNKNOWN; }
+
+	bool updates_jobs_list() const override { return true; }
+
+	Size get_nstruct() const override { return 2; }
+
+	Size n_built() const { return n_built_; }
+
+private:
+	std::atomic< Size > n_built_;
+};
+
+/// @brief Exposes the nstruct the wrapper reports
+class NstructPrefetchingJobInputter : public PrefetchingJobInputter
+{
+public:
+	using PrefetchingJobInputter::PrefetchingJobInputter;
+	Size nstruct() const { return get_nstruct(); }
+};
+
+class PrefetchingJobInputterTests : public CxxTest::TestSuite {
+public:
+
+	void setUp() {
+		protocols_init();
+	}
+
+	void tearDown() {}
+
+	void test_poses_match_wrapped_inputter() {
+		utility::pointer::shared_ptr< PeptideJobInputter > peptides( new PeptideJobInputter );
+		PrefetchingJobInputter prefetching( peptides, 2 );
+		JobsContainer jobs;
+		prefetching.fill_jobs( jobs );
+		TS_ASSERT_EQUALS( jobs.size(), 12u );
+
+		for ( Size ii = 1; ii <= jobs.size(); ++ii ) {
+			core::pose::Pose pose;
+			if ( jobs[ ii ]->input_tag() == "bad" ) {
+				TS_ASSERT_THROWS( prefetching.pose_from_job( pose, jobs[ ii ] ), utility::excn::BadInput & );
+				continue;
+			}
+			prefetching.pose_from_job( pose, jobs[ ii ] );
+			TS_ASSERT_EQUALS( pose.sequence(), jobs[ ii ]->input_tag() );
+			TS_ASSERT( jobs[ ii ]->inner_job()->get_pose() != nullptr );
+		}
+		// Each good input is built once, whether ahead of time or not
+		TS_ASSERT_EQUALS( peptides->n_built(), 5u );
+#ifdef MULTI_THREADED
+		TS_ASSERT( prefetching.n_prefetched() > 0 );
+#endif
+	}
+
+	void test_calls_are_forwarded() {
+		utility::pointer::shared_ptr< PeptideJobInputter > peptides( new PeptideJobInputter );
+		NstructPrefetchingJobInputter prefetching( peptides, 2 );
+		TS_ASSERT_EQUALS( prefetching.wrapped_inputter(), peptides );
+		TS_ASSERT_EQUALS( prefetching.nstruct(), 2u );
+		TS_ASSERT( prefetching.updates_jobs_list() );
+		TS_ASSERT_EQUALS( prefetching.input_source(), JobInputterInputSource::UNKNOWN );
+	}
+
+	/// @brief Jobs handed out with a stride, as the work-pool distributors do to each process
+	void test_strided_jobs() {
+		utility::pointer::shared_ptr< PeptideJobInputter > peptides( new PeptideJobInputter );
+		PrefetchingJobInputter prefetching( peptides, 3 );
+		JobsContainer jobs;
+		prefetching.fill_jobs( jobs );
+
+		for ( Size ii = 2; ii <= jobs.size(); ii += 4 ) {
+			if ( jobs[ ii ]->input_tag() == "bad" ) continue;
+			core::pose::Pose pose;
+			prefetching.pose_from_job( pose, jobs[ ii ] );
+			TS_ASSERT_EQUALS( pose.sequence(), jobs[ ii ]->input_tag() );
+		}
+		TS_ASSERT( peptides->n_built() >= 2u );
+	}
+
+};
@@ -0,0 +1,97 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   test/protocols/jd3/job_distributors/WorkStealingThreadPool.cxxtest.hh
+/// @brief  test suite for protocols::jd3::job_distributors::WorkStealingThreadPool
+
+// Test headers
+#include <cxxtest/TestSuite.h>
+#include <test/core/init_util.hh>
+
+// Unit headers
+#include <protocols/jd3/job_distributors/WorkStealingThreadPool.hh>
+
+// Package headers
+#include <protocols/jd3/JobSummary.hh>
+
+// Basic headers
+#include <basic/Tracer.hh>
+
+// C++ headers
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+static basic::Tracer TR("test.protocols.jd3.job_distributors.WorkStealingThreadPool");
+
+class WorkStealingThreadPoolTests : public CxxTest::TestSuite
+{
+public:
+
+	void setUp() {
+		core_init();
+	}
+
+	void test_job_summary_scheduling_statistics() {
+		protocols::jd3::JobSummary summary;
+		TS_ASSERT_EQUALS( summary.queue_depth(), 0 );
+		TS_ASSERT( ! summary.stolen() );
+		summary.set_scheduling_statistics( 3, 17, true, 2 );
+		TS_ASSERT_EQUALS( summary.thread_index(), 3 );
+		TS_ASSERT_EQUALS( summary.queue_depth(), 17 );
+		TS_ASSERT( summary.stolen() );
+		TS_ASSERT_EQUALS( summary.thread_steal_count(), 2 );
+	}
+
+#ifdef MULTI_THREADED
+
+	void test_all_tasks_run_before_stop_returns() {
+		using namespace protocols::jd3::job_distributors;
+		std::atomic< core::Size > n_run( 0 );
+		WorkStealingThreadPool pool( 4 );
+		for ( core::Size ii = 1; ii <= 500; ++ii ) {
+			pool.push( [&n_run]( TaskSchedulingInfo const & ) { ++n_run; } );
+		}
+		pool.stop();
+		TS_ASSERT_EQUALS( n_run.load(), 500 );
+		TS_ASSERT_EQUALS( pool.n_queued(), 0 );
+	}
+
+	void test_idle_thread_steals_from_busy_thread() {
+		using namespace protocols::jd3::job_distributors;
+		// Once one thread is held up by the first task, about half of the tasks pushed
+		// round-robin land in its deque and can only finish if the other thread steals them.
+		std::atomic< bool > started( false ), release( false );
+		std::atomic< core::Size > n_stolen( 0 ), n_run( 0 );
+		WorkStealingThreadPool pool( 2 );
+		pool.push( [&]( TaskSchedulingInfo const & info ) {
+			if ( info.stolen ) ++n_stolen;
+			started.store( true );
+			while ( ! release.load() ) std::this_thread::yield();
+		} );
+		while ( ! started.load() ) std::this_thread::yield();
+		for ( core::Size ii = 1; ii <= 9; ++ii ) {
+			pool.push( [&]( TaskSchedulingInfo const & info ) {
+				if ( info.stolen ) ++n_stolen;
+				++n_run;
+			} );
+		}
+		for ( core::Size ii = 0; ii < 1000 && n_run.load() < 9; ++ii ) {
+			std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+		}
+		TS_ASSERT_EQUALS( n_run.load(), 9 );
+		TS_ASSERT( n_stolen.load() > 0 );
+		TS_ASSERT_EQUALS( pool.n_steals(), n_stolen.load() );
+		release.store( true );
+		pool.stop();
+	}
+
+#endif // MULTI_THREADED
+
+};
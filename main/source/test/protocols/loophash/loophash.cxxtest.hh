@@ -29,8 +29,13 @@
 
 //Auto Headers
 #include <utility/vector1.hh>
+#include <utility/string_util.hh>
 #include <numeric/random/random.hh>
 
+// C++ headers
+#include <cstdio>
+#include <set>
+
 static basic::Tracer TR("protocols.loophash.loophash.cxxtest");
 
 namespace {
@@ -90,6 +95,156 @@ public:
 
 	}
 
+	/// @brief The (index, offset) pairs of a set of lookup results
+	std::multiset< std::pair< Size, Size > > leaps( LoopHashMap const & hashmap, std::vector< Size > const & result ) {
+		std::multiset< std::pair< Size, Size > > leap_set;
+		for ( Size position : result ) {
+			LeapIndex cp = hashmap.get_peptide( position );
+			leap_set.insert( std::make_pair( cp.index, cp.offset ) );
+		}
+		return leap_set;
+	}
+
+	/// @brief Write six proteins of ten residues, and leaps into them hashed from made-up
+	/// transforms, to binary and text databases; return the keys of the leaps
+	std::vector< boost::uint64_t > write_databases( BackboneDB & bbdb, Size const loop_size, Size const n_proteins = 6 ) {
+		LoopHashMap hashmap( loop_size );
+		std::vector< boost::uint64_t > keys;
+		for ( Size ii = 0; ii < n_proteins; ++ii ) {
+			BBData protein;
+			for ( Size jj = 0; jj < 30; ++jj ) protein.angles.push_back( short( 1000 * ii + 37 * jj - 500 ) );
+			protein.extra_key = ii;
+			bbdb.add_protein( protein );
+			BBExtraData extra;
+			extra.pdb_id = "1ab" + utility::to_string( ii ) + "A";
+			extra.sequence = std::string( 10, char( 'A' + ii ) );
+			extra.rotamer_id.assign( ii, int( ii ) );
+			bbdb.add_extra_data( extra );
+
+			for ( Size offset = 0; offset + 3 * loop_size <= 30; offset += 3 ) {
+				numeric::geometry::hashing::Real6 transform;
+				transform[1] = 2.0 * ( offset % 4 ); transform[2] = -3.0 + ii; transform[3] = 1.5;
+				transform[4] = 40.0 * ( offset % 3 ); transform[5] = 90.0; transform[6] = 60.0 + 10.0 * ( ii % 2 );
+				LeapIndex leap_index;
+				leap_index.index = ii;
+				leap_index.offset = offset;
+				hashmap.add_leap( leap_index, transform );
+				keys.push_back( hashmap.get_peptide( hashmap.n_loops() - 1 ).key );
+			}
+		}
+
+		bbdb.write_binary_db( bbdb_bin_ );
+		hashmap.write_binary_db( loopdb_bin_ );
+		hashmap.write_db( loopdb_txt_ );
+		return keys;
+	}
+
+	void test_binary_database() {
+		Size const loop_size = 3;
+
+		BackboneDB bbdb;
+		std::vector< boost::uint64_t > const keys( write_databases( bbdb, loop_size ) );
+
+		// map the second of two partitions, and read the same partition of the text db to compare with
+		BackboneDB mapped_bbdb;
+		std::pair< Size, Size > range;
+		std::map< Size, bool > homologs;
+		mapped_bbdb.read_binary_db( bbdb_bin_, true, 2, 1, range, homologs );
+		TS_ASSERT( mapped_bbdb.is_mapped() );
+		TS_ASSERT_EQUALS( range.first, 3 );
+		TS_ASSERT_EQUALS( range.second, 6 );
+		TS_ASSERT_EQUALS( mapped_bbdb.size(), 3 );
+
+		LoopHashMap mapped_hashmap( loop_size );
+		mapped_hashmap.read_binary_db( loopdb_bin_, range, homologs );
+		TS_ASSERT( mapped_hashmap.is_mapped() );
+		LoopHashMap text_hashmap( loop_size );
+		text_hashmap.read_db( loopdb_txt_, range, homologs );
+
+		Size n_found = 0;
+		for ( boost::uint64_t key : keys ) {
+			std::vector< Size > mapped_result, text_result;
+			mapped_hashmap.lookup_withkey( key, mapped_result );
+			text_hashmap.lookup_withkey( key, text_result );
+			TS_ASSERT_EQUALS( leaps( mapped_hashmap, mapped_result ), leaps( text_hashmap, text_result ) );
+
+			mapped_result.clear(); text_result.clear();
+			mapped_hashmap.radial_lookup_withkey( key, 1, mapped_result );
+			text_hashmap.radial_lookup_withkey( key, 1, text_result );
+			TS_ASSERT_EQUALS( leaps( mapped_hashmap, mapped_result ), leaps( text_hashmap, text_result ) );
+			n_found += mapped_result.size();
+		}
+		TS_ASSERT( n_found > 0 );
+
+		// the mapped proteins are indexed from the start of the partition
+		for ( Size ii = 0; ii < mapped_bbdb.size(); ++ii ) {
+			BackboneSegment mapped_bs, bs;
+			mapped_bbdb.get_backbone_segment( ii, 3, loop_size, mapped_bs );
+			bbdb.get_backbone_segment( ii + range.first, 3, loop_size, bs );
+			TS_ASSERT_EQUALS( mapped_bs.phi(), bs.phi() );
+			TS_ASSERT_EQUALS( mapped_bs.psi(), bs.psi() );
+			TS_ASSERT_EQUALS( mapped_bs.omega(), bs.omega() );
+			TS_ASSERT_EQUALS( mapped_bbdb.angle( ii, 29 ), bbdb.angle( ii + range.first, 29 ) );
+
+			BBExtraData mapped_extra, extra;
+			mapped_bbdb.get_extra_data( ii, mapped_extra );
+			bbdb.get_extra_data( ii + range.first, extra );
+			TS_ASSERT_EQUALS( mapped_extra.pdb_id, extra.pdb_id );
+			TS_ASSERT_EQUALS( mapped_extra.sequence, extra.sequence );
+			TS_ASSERT_EQUALS( mapped_extra.rotamer_id, extra.rotamer_id );
+		}
+
+		std::remove( bbdb_bin_ );
+		std::remove( loopdb_bin_ );
+		std::remove( loopdb_txt_ );
+	}
+
+	/// @brief A mapped map holds every leap in the file; random picks must only return the leaps
+	/// of this partition that are not homologs, whose backbones the mapped database can supply.
+	void test_random_loaded_leap_in_partition() {
+		Size const loop_size = 3;
+
+		BackboneDB bbdb;
+		write_databases( bbdb, loop_size );
+
+		// the second of three partitions, with its second protein marked as a homolog
+		BackboneDB mapped_bbdb;
+		std::pair< Size, Size > range;
+		std::map< Size, bool > homologs;
+		mapped_bbdb.read_binary_db( bbdb_bin_, true, 3, 1, range, homologs );
+		TS_ASSERT_EQUALS( range.first, 2 );
+		TS_ASSERT_EQUALS( range.second, 4 );
+		homologs[ 1 ] = true;
+
+		LoopHashMap mapped_hashmap( loop_size );
+		mapped_hashmap.read_binary_db( loopdb_bin_, range, homologs );
+		TS_ASSERT_EQUALS( mapped_hashmap.n_loops(), 6 * 8 );
+
+		std::set< std::pair< Size, Size > > drawn;
+		for ( Size draw = 1; draw <= 500; ++draw ) {
+			LeapIndex cp = mapped_hashmap.get_peptide( mapped_hashmap.random_loaded_leap() );
+			TS_ASSERT_EQUALS( cp.index, 0 );
+			if ( cp.index != 0 ) break;
+			drawn.insert( std::make_pair( cp.index, cp.offset ) );
+
+			BackboneSegment mapped_bs, bs;
+			mapped_bbdb.get_backbone_segment( cp.index, cp.offset, loop_size, mapped_bs );
+			bbdb.get_backbone_segment( cp.index + range.first, cp.offset, loop_size, bs );
+			TS_ASSERT_EQUALS( mapped_bs.phi(), bs.phi() );
+		}
+		// all eight leaps of the one loaded protein come up
+		TS_ASSERT_EQUALS( drawn.size(), 8 );
+
+		std::remove( bbdb_bin_ );
+		std::remove( loopdb_bin_ );
+		std::remove( loopdb_txt_ );
+	}
+
+private:
+	char const * bbdb_bin_ = "protocols/loophash/loophash_test_backbone.bin";
+	char const * loopdb_bin_ = "protocols/loophash/loophash_test_loopdb.3.bin";
+	char const * loopdb_txt_ = "protocols/loophash/loophash_test_loopdb.3.db";
+
 };
 
 }  // anonymous namespace
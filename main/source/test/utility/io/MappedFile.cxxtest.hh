@@ -0,0 +1,62 @@
+// -*- mode:c++;tab-width:2;indent-tabs-mode:t;show-trailing-whitespace:t;rm-trailing-spaces:t -*-
+// vi: set ts=2 noet:
+//
+// (c) Copyright Rosetta Commons Member Institutions.
+// (c) This file is part of the Rosetta software suite and is made available under license.
+// (c) The Rosetta software is developed by the contributing members of the Rosetta Commons.
+// (c) For more information, see http://www.rosettacommons.org. Questions about this can be
+// (c) addressed to University of Washington CoMotion, email: license@uw.edu.
+
+/// @file   utility/io/MappedFile.cxxtest.hh
+/// @brief  MappedFile / MemoryStreamBuf unit test suite
+
+// Package headers
+#include <cxxtest/TestSuite.h>
+#include <utility/io/MappedFile.hh>
+
+// C++ headers
+#include <istream>
+#include <string>
+
+class MappedFileTests : public CxxTest::TestSuite {
+
+public:
+
+	void test_map_file_contents() {
+		utility::io::MappedFile mf( "utility/io/simple_input_file.txt" );
+		TS_ASSERT( mf.is_open() );
+		TS_ASSERT_EQUALS( mf.size(), 20 );
+		TS_ASSERT_EQUALS( std::string( mf.data(), mf.size() ), "Testing testing 123\n" );
+
+		mf.close();
+		TS_ASSERT( ! mf.is_open() );
+		TS_ASSERT_EQUALS( mf.size(), 0 );
+	}
+
+	void test_missing_file() {
+		utility::io::MappedFile mf( "utility/io/there_is_no_such_file.txt" );
+		TS_ASSERT( ! mf.is_open() );
+	}
+
+	void test_memory_stream_buf() {
+		utility::io::MappedFile mf( "utility/io/simple_input_file.txt" );
+		TS_ASSERT( mf.is_open() );
+
+		// a window onto "testing 123"
+		utility::io::MemoryStreamBuf buf( mf.data() + 8, 11 );
+		std::istream in( &buf );
+		std::string word;
+		in >> word;
+		TS_ASSERT_EQUALS( word, "testing" );
+		TS_ASSERT_EQUALS( in.tellg(), std::streampos( 7 ) );
+
+		in.seekg( 8 );
+		int number( 0 );
+		in >> number;
+		TS_ASSERT_EQUALS( number, 123 );
+
+		char c;
+		TS_ASSERT( ! in.get( c ) ); // nothing beyond the window
+	}
+
+};